@@ -132,6 +132,15 @@ void AGC(_apply_gain)(AGC() _q, TC * _y);                       \
 /* same as running push(), apply_gain() */                      \
 void AGC(_execute)(AGC() _q, TC _x, TC *_y);                    \
                                                                 \
+/* execute on block of _n samples; energy is estimated over */  \
+/* whole sub-blocks and the gain is interpolated between    */  \
+/* them, tracking per-sample mode to within about 0.5 dB;   */  \
+/* in-place operation (_x == _y) is permitted               */  \
+void AGC(_execute_block)(AGC()        _q,                       \
+                         TC *         _x,                       \
+                         unsigned int _n,                       \
+                         TC *         _y);                      \
+                                                                \
 /* Return signal level (linear) relative to unity energy */     \
 T AGC(_get_signal_level)(AGC() _q);                             \
                                                                 \
@@ -307,7 +316,16 @@ DOTPROD() DOTPROD(_recreate)(DOTPROD() _q,                      \
                              unsigned int _n);                  \
 void DOTPROD(_destroy)(DOTPROD() _q);                           \
 void DOTPROD(_print)(DOTPROD() _q);                             \
-void DOTPROD(_execute)(DOTPROD() _q, TI * _v, TO * _y);
+void DOTPROD(_execute)(DOTPROD() _q, TI * _v, TO * _y);         \
+                                                                \
+/* execute dot product over _n consecutive positions of a   */  \
+/* sliding input, _y[k] = sum{ h[i] * _v[k+i] }; the input  */  \
+/* array is of length _n + n - 1 where n is the dot product */  \
+/* length                                                   */  \
+void DOTPROD(_execute_block)(DOTPROD()    _q,                   \
+                             TI *         _v,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);
 
 LIQUID_DOTPROD_DEFINE_API(DOTPROD_MANGLE_RRRF,
                           float,
@@ -409,6 +427,26 @@ void EQLMS(_step)(EQLMS() _q,                                   \
                   T       _d,                                   \
                   T       _d_hat);                              \
                                                                 \
+/* execute equalizer on block of samples with current       */  \
+/* weights, retaining inputs/outputs for step_block()       */  \
+/*  _q      :   equalizer object                            */  \
+/*  _x      :   input samples  [size: _n x 1]               */  \
+/*  _n      :   number of input samples                     */  \
+/*  _y      :   output samples [size: _n x 1]               */  \
+void EQLMS(_execute_block)(EQLMS()      _q,                     \
+                           T *          _x,                     \
+                           unsigned int _n,                     \
+                           T *          _y);                    \
+                                                                \
+/* update weights once from block of desired outputs and    */  \
+/* the last call to execute_block() (block LMS)             */  \
+/*  _q      :   equalizer object                            */  \
+/*  _d      :   desired outputs [size: _n x 1]              */  \
+/*  _n      :   number of samples (at most last block size) */  \
+void EQLMS(_step_block)(EQLMS()      _q,                        \
+                        T *          _d,                        \
+                        unsigned int _n);                       \
+                                                                \
 /* reset equalizer object, clearing internal state          */  \
 void EQLMS(_get_weights)(EQLMS() _q,                            \
                          T *     _w);                           \
@@ -451,6 +489,20 @@ void EQRLS(_reset)(EQRLS() _eq);                                \
 void EQRLS(_push)(EQRLS() _eq, T _x);                           \
 void EQRLS(_execute)(EQRLS() _eq, T * _y);                      \
 void EQRLS(_step)(EQRLS() _eq, T _d, T _d_hat);                 \
+                                                                \
+/* execute equalizer on block of samples with current       */  \
+/* weights, retaining inputs for step_block()               */  \
+void EQRLS(_execute_block)(EQRLS()      _eq,                    \
+                           T *          _x,                     \
+                           unsigned int _n,                     \
+                           T *          _y);                    \
+                                                                \
+/* step through training cycle (one update per sample) for  */  \
+/* block of desired outputs and last execute_block() inputs */  \
+void EQRLS(_step_block)(EQRLS()      _eq,                       \
+                        T *          _d,                        \
+                        unsigned int _n);                       \
+                                                                \
 void EQRLS(_get_weights)(EQRLS() _eq, T * _w);                  \
 void EQRLS(_train)(EQRLS() _eq,                                 \
                    T * _w,                                      \
@@ -517,6 +569,29 @@ int crc_validate_message(crc_scheme _scheme,
                          unsigned int _n,
                          unsigned int _key);
 
+// incremental error-detection key computation for messages which
+// arrive in pieces; the key is the same as crc_generate_key() on the
+// concatenated message, e.g.
+//   unsigned int state = crc_init(scheme);
+//   state = crc_update(scheme, state, chunk0, n0);
+//   state = crc_update(scheme, state, chunk1, n1);
+//   key   = crc_finalize(scheme, state);
+unsigned int crc_init(crc_scheme _scheme);
+
+// update incremental key computation with next chunk of message
+//  _scheme     :   error-detection scheme
+//  _state      :   current state (see crc_init())
+//  _msg        :   next chunk of message, [size: _n x 1]
+//  _n          :   chunk size (may be zero)
+unsigned int crc_update(crc_scheme      _scheme,
+                        unsigned int    _state,
+                        unsigned char * _msg,
+                        unsigned int    _n);
+
+// compute error-detection key from incremental state
+unsigned int crc_finalize(crc_scheme   _scheme,
+                          unsigned int _state);
+
 
 // available FEC schemes
 #define LIQUID_FEC_NUM_SCHEMES  28
@@ -810,8 +885,15 @@ typedef enum {
     // modified discrete cosine transform
     LIQUID_FFT_MDCT     =  30,  // MDCT
     LIQUID_FFT_IMDCT    =  31,  // IMDCT
+
+    // real-to-complex/complex-to-real transforms
+    LIQUID_FFT_R2C      =  40,  // real one-dimensional FFT
+    LIQUID_FFT_C2R      =  41,  // real one-dimensional inverse FFT
 } liquid_fft_type;
 
+// fft plan flags
+#define LIQUID_FFT_MEASURE  (1<<0)  // time candidate methods, remember fastest
+
 #define LIQUID_FFT_MANGLE_FLOAT(name)   LIQUID_CONCAT(fft,name)
 
 // Macro    :   FFT
@@ -827,14 +909,64 @@ typedef struct FFT(plan_s) * FFT(plan);                         \
 /*  _x      :   pointer to input array  [size: _n x 1]      */  \
 /*  _y      :   pointer to output array [size: _n x 1]      */  \
 /*  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)         */  \
-/*  _flags  :   options, optimization                       */  \
+/*  _flags  :   options, optimization (LIQUID_FFT_MEASURE)  */  \
 FFT(plan) FFT(_create_plan)(unsigned int _n,                    \
                             TC *         _x,                    \
                             TC *         _y,                    \
                             int          _dir,                  \
                             int          _flags);               \
                                                                 \
-/* create real-to-real transform                            */  \
+/* create batch of regular complex one-dimensional          */  \
+/* transforms of equal size; element i of transform k is    */  \
+/* read from _x[k*_idist + i*_istride] and written to       */  \
+/* _y[k*_odist + i*_ostride]                                */  \
+/*  _n      :   transform size                              */  \
+/*  _howmany:   number of transforms                        */  \
+/*  _x      :   pointer to input array                      */  \
+/*  _istride:   input element stride                        */  \
+/*  _idist  :   input distance between transforms          */  \
+/*  _y      :   pointer to output array                     */  \
+/*  _ostride:   output element stride                       */  \
+/*  _odist  :   output distance between transforms         */  \
+/*  _dir    :   direction (e.g. LIQUID_FFT_FORWARD)         */  \
+/*  _flags  :   options, optimization (LIQUID_FFT_MEASURE)  */  \
+FFT(plan) FFT(_create_plan_many)(unsigned int _n,               \
+                                 unsigned int _howmany,         \
+                                 TC *         _x,               \
+                                 unsigned int _istride,         \
+                                 unsigned int _idist,           \
+                                 TC *         _y,               \
+                                 unsigned int _ostride,         \
+                                 unsigned int _odist,           \
+                                 int          _dir,             \
+                                 int          _flags);          \
+                                                                \
+/* create real-to-complex transform; only the non-redundant */  \
+/* half of the spectrum is computed                         */  \
+/*  _n      :   transform size                              */  \
+/*  _x      :   pointer to input array  [size: _n x 1]      */  \
+/*  _y      :   pointer to output array [size: _n/2+1 x 1]  */  \
+/*  _flags  :   options, optimization (LIQUID_FFT_MEASURE)  */  \
+FFT(plan) FFT(_create_plan_r2c)(unsigned int _n,                \
+                                T *          _x,                \
+                                TC *         _y,                \
+                                int          _flags);           \
+                                                                \
+/* create complex-to-real (inverse) transform from the      */  \
+/* non-redundant half of a Hermitian spectrum; the output   */  \
+/* is not normalized, viz. c2r(r2c(x)) = _n*x               */  \
+/*  _n      :   transform size                              */  \
+/*  _x      :   pointer to input array  [size: _n/2+1 x 1]  */  \
+/*  _y      :   pointer to output array [size: _n x 1]      */  \
+/*  _flags  :   options, optimization (LIQUID_FFT_MEASURE)  */  \
+FFT(plan) FFT(_create_plan_c2r)(unsigned int _n,                \
+                                TC *         _x,                \
+                                T *          _y,                \
+                                int          _flags);           \
+                                                                \
+/* create real-to-real transform; for LIQUID_FFT_MDCT the   */  \
+/* input has 2*_n samples, for LIQUID_FFT_IMDCT the output  */  \
+/* has 2*_n samples                                         */  \
 /*  _n      :   transform size                              */  \
 /*  _x      :   pointer to input array  [size: _n x 1]      */  \
 /*  _y      :   pointer to output array [size: _n x 1]      */  \
@@ -866,6 +998,16 @@ void FFT(_shift)(TC*_x, unsigned int _n);                       \
 
 LIQUID_FFT_DEFINE_API(LIQUID_FFT_MANGLE_FLOAT,float,liquid_float_complex)
 
+// free pre-computed plan data (twiddle factors, etc.) in the internal
+// fft cache which are not currently in use by any plan
+void liquid_fft_cache_clear();
+
+// get number of entries in internal fft cache
+unsigned int liquid_fft_cache_get_num_entries();
+
+// forget all fft methods measured with LIQUID_FFT_MEASURE
+void liquid_fft_wisdom_clear();
+
 // antiquated fft methods
 // FFT(plan) FFT(_create_plan_mdct)(unsigned int _n,
 //                                  T * _x,
@@ -1602,6 +1744,20 @@ void FIRFILT(_clear)(FIRFILT() _f);                             \
 void FIRFILT(_print)(FIRFILT() _f);                             \
 void FIRFILT(_push)(FIRFILT() _f, TI _x);                       \
 void FIRFILT(_execute)(FIRFILT() _f, TO *_y);                   \
+                                                                \
+/* execute the filter on a block of input samples; output   */  \
+/* matches calling _push() and _execute() on each sample to */  \
+/* within rounding (long filters use overlap-save fast      */  \
+/* convolution); in-place operation (_x == _y) is permitted */  \
+/*  _f      : filter object                                 */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _n      : number of input, output samples               */  \
+/*  _y      : output array [size: _n x 1]                   */  \
+void FIRFILT(_execute_block)(FIRFILT()    _f,                   \
+                             TI *         _x,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);                  \
+                                                                \
 unsigned int FIRFILT(_get_length)(FIRFILT() _f);                \
 void FIRFILT(_freqresponse)(FIRFILT() _f,                       \
                             float _fc,                          \
@@ -1623,6 +1779,69 @@ LIQUID_FIRFILT_DEFINE_API(FIRFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+//
+// FFT-based finite impulse response filter (overlap-save)
+//
+
+#define FFTFILT_MANGLE_RRRF(name)  LIQUID_CONCAT(fftfilt_rrrf,name)
+#define FFTFILT_MANGLE_CRCF(name)  LIQUID_CONCAT(fftfilt_crcf,name)
+#define FFTFILT_MANGLE_CCCF(name)  LIQUID_CONCAT(fftfilt_cccf,name)
+
+// Macro:
+//   FFTFILT : name-mangling macro
+//   TO      : output data type
+//   TC      : coefficients data type
+//   TI      : input data type
+#define LIQUID_FFTFILT_DEFINE_API(FFTFILT,TO,TC,TI)             \
+typedef struct FFTFILT(_s) * FFTFILT();                         \
+                                                                \
+/* create FFT-based FIR filter using external coefficients  */  \
+/*  _h      : filter coefficients [size: _h_len x 1]        */  \
+/*  _h_len  : filter length, _h_len > 0                     */  \
+/*  _n      : block size = nfft/2, _n >= _h_len-1           */  \
+FFTFILT() FFTFILT(_create)(TC *         _h,                     \
+                           unsigned int _h_len,                 \
+                           unsigned int _n);                    \
+                                                                \
+/* destroy filter object and free all internal memory       */  \
+void FFTFILT(_destroy)(FFTFILT() _q);                           \
+                                                                \
+/* reset filter object's internal buffer                    */  \
+void FFTFILT(_clear)(FFTFILT() _q);                             \
+                                                                \
+/* print filter object information                          */  \
+void FFTFILT(_print)(FFTFILT() _q);                             \
+                                                                \
+/* execute the filter on one block of input samples; the    */  \
+/* output is identical to firfilt with the same taps        */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _y      : output array [size: _n x 1]                   */  \
+void FFTFILT(_execute)(FFTFILT() _q,                            \
+                       TI *      _x,                            \
+                       TO *      _y);                           \
+                                                                \
+/* return length of filter object's internal coefficients   */  \
+unsigned int FFTFILT(_get_length)(FFTFILT() _q);                \
+                                                                \
+/* return block size, _n                                    */  \
+unsigned int FFTFILT(_get_block_size)(FFTFILT() _q);
+
+LIQUID_FFTFILT_DEFINE_API(FFTFILT_MANGLE_RRRF,
+                          float,
+                          float,
+                          float)
+
+LIQUID_FFTFILT_DEFINE_API(FFTFILT_MANGLE_CRCF,
+                          liquid_float_complex,
+                          float,
+                          liquid_float_complex)
+
+LIQUID_FFTFILT_DEFINE_API(FFTFILT_MANGLE_CCCF,
+                          liquid_float_complex,
+                          liquid_float_complex,
+                          liquid_float_complex)
+
 //
 // FIR Hilbert transform
 //  2:1 real-to-complex decimator
@@ -1710,6 +1929,15 @@ IIRFILT() IIRFILT(_create)(TC * _b,                             \
 IIRFILT() IIRFILT(_create_sos)(TC * _B,                         \
                                TC * _A,                         \
                                unsigned int _nsos);             \
+                                                                \
+/* create parallel-form filter from second-order sections   */  \
+/* by partial-fraction expansion (poles must be distinct)   */  \
+/*  _B      : numerator [size: _nsos x 3]                   */  \
+/*  _A      : denominator [size: _nsos x 3]                 */  \
+/*  _nsos   : number of second-order sections               */  \
+IIRFILT() IIRFILT(_create_parallel)(TC * _B,                    \
+                                    TC * _A,                    \
+                                    unsigned int _nsos);        \
 IIRFILT() IIRFILT(_create_prototype)(                           \
             liquid_iirdes_filtertype _ftype,                    \
             liquid_iirdes_bandtype   _btype,                    \
@@ -1741,6 +1969,17 @@ void IIRFILT(_destroy)(IIRFILT() _f);                           \
 void IIRFILT(_print)(IIRFILT() _f);                             \
 void IIRFILT(_clear)(IIRFILT() _f);                             \
 void IIRFILT(_execute)(IIRFILT() _f, TI _x, TO *_y);            \
+                                                                \
+/* execute filter on block of samples                       */  \
+/*  _f      : filter object                                 */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _n      : number of input, output samples               */  \
+/*  _y      : output array [size: _n x 1], may be _x        */  \
+void IIRFILT(_execute_block)(IIRFILT()    _f,                   \
+                             TI *         _x,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);                  \
+                                                                \
 unsigned int IIRFILT(_get_length)(IIRFILT() _f);                \
 void IIRFILT(_freqresponse)(IIRFILT() _f,                       \
                             float _fc,                          \
@@ -2165,6 +2404,26 @@ void RESAMP2(_decim_execute)(RESAMP2() _q,                      \
 void RESAMP2(_interp_execute)(RESAMP2() _q,                     \
                               TI        _x,                     \
                               TO *      _y);                    \
+                                                                \
+/* execute half-band decimator on a block of samples        */  \
+/*  _q      :   resamp2 object                              */  \
+/*  _x      :   input array  [size: 2*_n x 1]               */  \
+/*  _n      :   number of output samples                    */  \
+/*  _y      :   output array [size: _n x 1]                 */  \
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,             \
+                                   TI *         _x,             \
+                                   unsigned int _n,             \
+                                   TO *         _y);            \
+                                                                \
+/* execute half-band interpolator on a block of samples     */  \
+/*  _q      :   resamp2 object                              */  \
+/*  _x      :   input array  [size: _n x 1]                 */  \
+/*  _n      :   number of input samples                     */  \
+/*  _y      :   output array [size: 2*_n x 1]               */  \
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,            \
+                                    TI *         _x,            \
+                                    unsigned int _n,            \
+                                    TO *         _y);           \
 
 LIQUID_RESAMP2_DEFINE_API(RESAMP2_MANGLE_RRRF,
                           float,
@@ -2228,6 +2487,18 @@ void RESAMP(_execute)(RESAMP()       _q,                        \
                       TI             _x,                        \
                       TO *           _y,                        \
                       unsigned int * _num_written);             \
+                                                                \
+/* execute arbitrary resampler on a block of samples        */  \
+/*  _q      :   resamp object                               */  \
+/*  _x      :   input array [size: _nx x 1]                 */  \
+/*  _nx     :   input array size                            */  \
+/*  _y      :   output array [size: ceil(rate*_nx)+1]       */  \
+/*  _ny     :   number of samples written to _y             */  \
+void RESAMP(_execute_block)(RESAMP()       _q,                  \
+                            TI *           _x,                  \
+                            unsigned int   _nx,                 \
+                            TO *           _y,                  \
+                            unsigned int * _ny);                \
 
 LIQUID_RESAMP_DEFINE_API(RESAMP_MANGLE_RRRF,
                          float,
@@ -2284,6 +2555,20 @@ void MSRESAMP(_execute)(MSRESAMP()     _q,                      \
                         unsigned int   _nx,                     \
                         TO *           _y,                      \
                         unsigned int * _ny);                    \
+                                                                \
+/* execute multi-stage resampler on a block of samples,     */  \
+/* running each stage over the entire block (same output as */  \
+/* execute())                                               */  \
+/*  _q      :   msresamp object                             */  \
+/*  _x      :   input sample array  [size: _nx x 1]         */  \
+/*  _nx     :   input sample array size                     */  \
+/*  _y      :   output sample array [size: variable]        */  \
+/*  _ny     :   number of samples written to _y             */  \
+void MSRESAMP(_execute_block)(MSRESAMP()     _q,                \
+                              TI *           _x,                \
+                              unsigned int   _nx,               \
+                              TO *           _y,                \
+                              unsigned int * _ny);              \
 
 LIQUID_MSRESAMP_DEFINE_API(MSRESAMP_MANGLE_RRRF,
                            float,
@@ -2497,6 +2782,9 @@ void framesync64_print(framesync64 _q);
 // reset frame synchronizer internal state
 void framesync64_reset(framesync64 _q);
 
+// is frame synchronizer currently receiving a frame?
+int framesync64_is_frame_open(framesync64 _q);
+
 // push samples through frame synchronizer
 //  _q      :   frame synchronizer object
 //  _x      :   input samples [size: _n x 1]
@@ -2596,6 +2884,9 @@ void flexframesync_print(flexframesync _q);
 // reset frame synchronizer internal state
 void flexframesync_reset(flexframesync _q);
 
+// is frame synchronizer currently receiving a frame?
+int flexframesync_is_frame_open(flexframesync _q);
+
 // push samples through frame synchronizer
 //  _q      :   frame synchronizer object
 //  _x      :   input samples [size: _n x 1]
@@ -2617,6 +2908,55 @@ void flexframesync_set_csma_callbacks(flexframesync _fs,
                                       void * _csma_userdata);
 #endif
 
+//
+// Multi-channel frame synchronizer bank: channelizes the input with a
+// polyphase filterbank, searches all channels for the frame preamble
+// at once, and only runs a frame synchronizer on channels where a
+// preamble was found
+//
+
+#define LIQUID_FRAMESYNCBANK_FRAMESYNC64    0
+#define LIQUID_FRAMESYNCBANK_FLEXFRAMESYNC  1
+
+typedef struct framesyncbank_s * framesyncbank;
+
+// create multi-channel frame synchronizer bank
+//  _type           :   synchronizer type (e.g. LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+//  _num_channels   :   number of channels
+//  _m              :   channelizer prototype filter semi-length
+//  _As             :   channelizer prototype filter stop-band attenuation [dB]
+//  _callback       :   callback function invoked when frame is received
+//  _userdata       :   user data pointers passed to callback, one for
+//                      each channel [size: _num_channels x 1]
+framesyncbank framesyncbank_create(int                _type,
+                                   unsigned int       _num_channels,
+                                   unsigned int       _m,
+                                   float              _As,
+                                   framesync_callback _callback,
+                                   void **            _userdata);
+
+// destroy frame synchronizer bank
+void framesyncbank_destroy(framesyncbank _q);
+
+// print frame synchronizer bank internal properties
+void framesyncbank_print(framesyncbank _q);
+
+// reset frame synchronizer bank internal state
+void framesyncbank_reset(framesyncbank _q);
+
+// get number of channels with an active frame synchronizer
+unsigned int framesyncbank_get_num_active(framesyncbank _q);
+
+// push samples through frame synchronizer bank; channels are searched
+// for the preamble once a full block of channelized samples has been
+// accumulated
+//  _q      :   frame synchronizer bank object
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of input samples
+void framesyncbank_execute(framesyncbank          _q,
+                           liquid_float_complex * _x,
+                           unsigned int           _n);
+
 
 //
 // bpacket : binary packet suitable for data streaming
@@ -2851,6 +3191,26 @@ void ofdmflexframesync_execute(ofdmflexframesync _q,
                                liquid_float_complex * _x,
                                unsigned int _n);
 
+// set number of threads: 1 (default) runs all stages on the calling
+// thread; 2 moves payload recovery (transform, equalization and
+// demodulation) and decoding to a worker thread; 3 runs each of
+// these on its own worker.  Frames are delivered in order, with the
+// callback invoked from the last stage's thread.  Resets the receiver.
+void ofdmflexframesync_set_num_threads(ofdmflexframesync _q,
+                                       unsigned int      _num_threads);
+unsigned int ofdmflexframesync_get_num_threads(ofdmflexframesync _q);
+
+// wait until every frame received so far has been delivered
+void ofdmflexframesync_flush(ofdmflexframesync _q);
+
+// get latency [s] of most recently delivered frame in each stage:
+// acquisition, payload recovery and decoding; valid within the
+// callback or after ofdmflexframesync_flush()
+void ofdmflexframesync_get_latency(ofdmflexframesync _q,
+                                   float *           _sync,
+                                   float *           _demod,
+                                   float *           _decode);
+
 // query the received signal strength indication
 float ofdmflexframesync_get_rssi(ofdmflexframesync _q);
 
@@ -3004,6 +3364,25 @@ int detector_cccf_correlate(detector_cccf        _q,
                             float *              _dphi_hat,
                             float *              _gamma_hat);
 
+// Run block of samples through pre-demod detector's correlator
+// (FFT-based), stopping at the first detection. Equivalent to calling
+// detector_cccf_correlate() on each of the first *_num_read samples.
+// Returns '1' if signal was detected, '0' otherwise
+//  _q          :   pre-demod detector
+//  _x          :   input samples [size: _n x 1]
+//  _n          :   number of input samples
+//  _num_read   :   number of samples consumed (including detection sample)
+//  _tau_hat    :   fractional sample offset estimate (set when detected)
+//  _dphi_hat   :   carrier frequency offset estimate (set when detected)
+//  _gamma_hat  :   channel gain estimate (set when detected)
+int detector_cccf_correlate_block(detector_cccf          _q,
+                                  liquid_float_complex * _x,
+                                  unsigned int           _n,
+                                  unsigned int *         _num_read,
+                                  float *                _tau_hat,
+                                  float *                _dphi_hat,
+                                  float *                _gamma_hat);
+
 
 //
 // MODULE : math
@@ -3742,6 +4121,17 @@ void MODEM(_modulate)(MODEM() _q,                               \
                       unsigned int _s,                          \
                       TC *_y);                                  \
                                                                 \
+/* modulate a block of symbols packed into bytes, most-     */  \
+/* significant bit first, using the modem's symbol map      */  \
+/*  _q      :   modem object                                */  \
+/*  _bytes  :   input bits [size: ceil(_n*bps/8) x 1]       */  \
+/*  _n      :   number of output samples                    */  \
+/*  _y      :   output samples [size: _n x 1]               */  \
+void MODEM(_modulate_block)(MODEM() _q,                         \
+                            unsigned char * _bytes,             \
+                            unsigned int _n,                    \
+                            TC * _y);                           \
+                                                                \
 /* generic hard-decision demodulation function              */  \
 /*  _q  :   modem object                                    */  \
 /*  _x  :   input sample                                    */  \
@@ -3760,6 +4150,17 @@ void MODEM(_demodulate_soft)(MODEM() _q,                        \
                              unsigned int  * _s,                \
                              unsigned char * _soft_bits);       \
                                                                 \
+/* soft-decision demodulation of a block of samples; QAM    */  \
+/* uses max-log LLRs over the full constellation            */  \
+/*  _q          :   modem object                            */  \
+/*  _x          :   input samples [size: _n x 1]            */  \
+/*  _n          :   number of input samples                 */  \
+/*  _soft_bits  :   output soft bits [size: _n*bps x 1]     */  \
+void MODEM(_demodulate_soft_block)(MODEM() _q,                  \
+                                   TC * _x,                     \
+                                   unsigned int _n,             \
+                                   unsigned char * _soft_bits); \
+                                                                \
 /* get demodulator's estimated transmit sample */               \
 void MODEM(_get_demodulator_sample)(MODEM() _q,                 \
                                     TC * _x_hat);               \
@@ -3985,15 +4386,28 @@ void FIRPFBCH(_destroy)(FIRPFBCH() _q);                         \
 void FIRPFBCH(_clear)(FIRPFBCH() _q);                           \
 void FIRPFBCH(_print)(FIRPFBCH() _q);                           \
                                                                 \
+/* set number of threads used by execute_block() methods; */    \
+/* output is identical for any number of threads          */    \
+void FIRPFBCH(_set_num_threads)(FIRPFBCH() _q,                  \
+                                unsigned int _num_threads);     \
+                                                                \
 /* synthesizer */                                               \
 void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,              \
                                     TI * _x,                    \
                                     TO * _X);                   \
+void FIRPFBCH(_synthesizer_execute_block)(FIRPFBCH() _q,        \
+                                          TI * _x,              \
+                                          unsigned int _n,      \
+                                          TO * _X);             \
                                                                 \
 /* analyzer */                                                  \
 void FIRPFBCH(_analyzer_execute)(FIRPFBCH() _q,                 \
                                  TI * _x,                       \
                                  TO * _X);                      \
+void FIRPFBCH(_analyzer_execute_block)(FIRPFBCH() _q,           \
+                                       TI * _x,                 \
+                                       unsigned int _n,         \
+                                       TO * _X);                \
 void FIRPFBCH(_analyzer_push)(FIRPFBCH() _q, TI _x);            \
 void FIRPFBCH(_analyzer_run)(FIRPFBCH() _q,                     \
                              unsigned int _k,                   \
@@ -4055,6 +4469,11 @@ void FIRPFBCH2(_reset)(FIRPFBCH2() _q);                         \
 /* print firpfbch2 object internals                         */  \
 void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
                                                                 \
+/* set number of threads used by execute_block(); output is */  \
+/* identical for any number of threads                      */  \
+void FIRPFBCH2(_set_num_threads)(FIRPFBCH2() _q,                \
+                                 unsigned int _num_threads);    \
+                                                                \
 /* execute filterbank channelizer                           */  \
 /* LIQUID_ANALYZER:     input: M/2, output: M               */  \
 /* LIQUID_SYNTHESIZER:  input: M,   output: M/2             */  \
@@ -4063,6 +4482,12 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
 void FIRPFBCH2(_execute)(FIRPFBCH2() _q,                        \
                          TI *        _x,                        \
                          TO *        _y);                       \
+                                                                \
+/* execute filterbank channelizer on _n blocks of samples   */  \
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
 
 
 LIQUID_FIRPFBCH2_DEFINE_API(FIRPFBCH2_MANGLE_CRCF,
@@ -33,12 +33,9 @@
 #include "config.h"
 
 #include <complex.h>
+#include <stdint.h>
 #include "liquid.h"
 
-#if defined HAVE_FEC_H && defined HAVE_LIBFEC
-#  define LIBFEC_ENABLED 1
-#endif
-
 
 //
 // Debugging macros
@@ -63,7 +60,7 @@ void AGC(_limit_gain)(AGC() _q);                                \
                                                                 \
 /* squelch */                                                   \
 void AGC(_update_auto_squelch)(AGC() _q, T _rssi);              \
-void AGC(_execute_squelch)(AGC() _q);
+void AGC(_execute_squelch)(AGC() _q, unsigned int _n);
 
 LIQUID_AGC_DEFINE_INTERNAL_API(AGC_MANGLE_CRCF, float, liquid_float_complex)
 LIQUID_AGC_DEFINE_INTERNAL_API(AGC_MANGLE_RRRF, float, float)
@@ -103,6 +100,118 @@ LIQUID_BUFFER_DEFINE_INTERNAL_API(BUFFER_MANGLE_CFLOAT, float complex)
 // MODULE : dotprod
 //
 
+// SIMD dot product kernels, selected at run time on x86 hosts
+// (see liquid_cpu_get_simd_level()); coefficients are repeated
+// for complex inputs as in the SSE implementations, viz.
+//   crcf : _h  = { h[0], h[0], h[1], h[1], ... }
+//   cccf : _hi = { real(h[0]), real(h[0]), ... }
+//          _hq = { imag(h[0]), imag(h[0]), ... }
+// and must be aligned to 64 bytes
+void dotprod_rrrf_execute_avx2(float *      _h,
+                               float *      _x,
+                               unsigned int _n,
+                               float *      _y);
+void dotprod_rrrf_execute_avx512(float *      _h,
+                                 float *      _x,
+                                 unsigned int _n,
+                                 float *      _y);
+void dotprod_crcf_execute_avx2(float *         _h,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y);
+void dotprod_crcf_execute_avx512(float *         _h,
+                                 float complex * _x,
+                                 unsigned int    _n,
+                                 float complex * _y);
+void dotprod_cccf_execute_avx2(float *         _hi,
+                               float *         _hq,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y);
+void dotprod_cccf_execute_avx512(float *         _hi,
+                                 float *         _hq,
+                                 float complex * _x,
+                                 unsigned int    _n,
+                                 float complex * _y);
+
+// multi-output (sliding input) AVX2 kernels: compute _n dot products
+// of length _len against _x[k], k < _n, in groups, loading each
+// coefficient vector once per group; return the number of outputs
+// computed, with any remainder left to the caller
+unsigned int dotprod_rrrf_execute_block_avx2(float *      _h,
+                                             unsigned int _len,
+                                             float *      _x,
+                                             unsigned int _n,
+                                             float *      _y);
+unsigned int dotprod_crcf_execute_block_avx2(float *         _h,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y);
+unsigned int dotprod_cccf_execute_block_avx2(float *         _hi,
+                                             float *         _hq,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y);
+
+// sum of squares kernels, selected at run time on x86 hosts
+float liquid_sumsqf_sse(float * _v, unsigned int _n);
+float liquid_sumsqf_avx2(float * _v, unsigned int _n);
+float liquid_sumsqf_avx512(float * _v, unsigned int _n);
+
+
+//
+// MODULE : equalization
+//
+
+// SIMD kernels for eqlms_cccf/eqrls_cccf, selected at run time on x86
+// hosts; each returns the number of samples processed (k <= _n), the
+// caller completes the remainder
+//   dotprod_conj : *_y = sum{ conj(_h[i]) * _x[i] }, i < k
+//   dotprod      : *_y = sum{ _h[i] * _x[i] }, i < k
+//   axpy         : _y[i] += _c * _x[i]
+//   rotate       : _v[i] <- _c0*_v[i] + _s0*_s[i],
+//                  _s[i] <- _s1*_v[i] + _c1*_s[i]
+unsigned int equalizer_cccf_dotprod_conj_sse(float complex * _h,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y);
+unsigned int equalizer_cccf_dotprod_sse(float complex * _h,
+                                        float complex * _x,
+                                        unsigned int    _n,
+                                        float complex * _y);
+unsigned int equalizer_cccf_axpy_sse(float complex * _y,
+                                     float complex   _c,
+                                     float complex * _x,
+                                     unsigned int    _n);
+unsigned int equalizer_cccf_rotate_sse(float complex * _v,
+                                       float complex * _s,
+                                       float           _c0,
+                                       float complex   _s0,
+                                       float complex   _s1,
+                                       float           _c1,
+                                       unsigned int    _n);
+unsigned int equalizer_cccf_dotprod_conj_avx2(float complex * _h,
+                                              float complex * _x,
+                                              unsigned int    _n,
+                                              float complex * _y);
+unsigned int equalizer_cccf_dotprod_avx2(float complex * _h,
+                                         float complex * _x,
+                                         unsigned int    _n,
+                                         float complex * _y);
+unsigned int equalizer_cccf_axpy_avx2(float complex * _y,
+                                      float complex   _c,
+                                      float complex * _x,
+                                      unsigned int    _n);
+unsigned int equalizer_cccf_rotate_avx2(float complex * _v,
+                                        float complex * _s,
+                                        float           _c0,
+                                        float complex   _s0,
+                                        float complex   _s1,
+                                        float           _c1,
+                                        unsigned int    _n);
+
 
 //
 // MODULE : fec (forward error-correction)
@@ -121,6 +230,172 @@ unsigned int crc16_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc24_generate_key(unsigned char * _msg, unsigned int _msg_len);
 unsigned int crc32_generate_key(unsigned char * _msg, unsigned int _msg_len);
 
+// update reflected 32-bit CRC register _r with message _msg for CRC
+// engine _p (0:crc8, 1:crc16, 2:crc24, 3:crc32), using slicing-by-8
+// tables or carry-less multiply folding selected at run time
+uint32_t crc_reflected_update(unsigned int          _p,
+                              uint32_t              _r,
+                              const unsigned char * _msg,
+                              unsigned int          _n);
+
+// fold _n bytes of _msg (_n a non-zero multiple of 64) to a 128-bit
+// residue with PCLMULQDQ; _k holds constants x^(D+63), x^(D-1) mod p(x)
+// (reflected) for D = 512, 384, 256, 128
+void crc_fold_pclmul(const uint64_t *      _k,
+                     uint32_t              _state,
+                     const unsigned char * _msg,
+                     unsigned int          _n,
+                     unsigned char *       _residue);
+
+
+// fec_viterbi : soft-decision Viterbi decoder for rate 1/R binary
+// convolutional codes; path metrics are 16-bit integers and the
+// add-compare-select butterflies are vectorized (SSE2/AVX2) with the
+// kernel selected at run time
+typedef struct fec_viterbi_s * fec_viterbi;
+
+// create Viterbi decoder
+//  _K      :   constraint length, 3 <= _K <= 15
+//  _R      :   inverted rate (number of polynomials), 1 <= _R <= 6
+//  _poly   :   generator polynomials [size: _R x 1]; the first and
+//              last taps (bits 0 and _K-1) must be set
+//  _n      :   maximum number of decoded bits (excluding tail)
+fec_viterbi fec_viterbi_create(unsigned int _K,
+                               unsigned int _R,
+                               int *        _poly,
+                               unsigned int _n);
+
+// destroy Viterbi decoder object
+void fec_viterbi_destroy(fec_viterbi _q);
+
+// reset path metrics and trellis, starting in state _state
+void fec_viterbi_init(fec_viterbi  _q,
+                      unsigned int _state);
+
+// run decoder on block of soft symbols (LIQUID_SOFTBIT_0 : 0,
+// LIQUID_SOFTBIT_1 : 255, erasures : LIQUID_SOFTBIT_ERASURE)
+//  _q      :   decoder object
+//  _sym    :   soft symbols [size: _R*_nbits x 1]
+//  _nbits  :   number of trellis steps (decoded bits, including tail)
+void fec_viterbi_update_blk(fec_viterbi     _q,
+                            unsigned char * _sym,
+                            unsigned int    _nbits);
+
+// trace back through trellis and pack decoded bits (msb first)
+//  _q          :   decoder object
+//  _data       :   decoded bytes [size: ceil(_nbits/8) x 1]
+//  _nbits      :   number of decoded bits (excluding tail)
+//  _endstate   :   terminal encoder state (zero for tail-flushed codes)
+void fec_viterbi_chainback(fec_viterbi     _q,
+                           unsigned char * _data,
+                           unsigned int    _nbits,
+                           unsigned int    _endstate);
+
+// add-compare-select kernels: run _n trellis steps over all _S states
+//  _S      :   number of states, 2^(_K-1)
+//  _R      :   number of polynomials
+//  _branch :   branch symbols {0,255}, [size: _R x _S/2]
+//  _sym    :   received soft symbols [size: _R*_n x 1]
+//  _n      :   number of trellis steps
+//  _norm   :   minimum of path metrics (updated), subtracted from old
+//              path metrics at each step to keep them bounded
+//  _m0     :   old path metrics [size: _S x 1] (swapped with _m1
+//              after each step)
+//  _m1     :   new path metrics [size: _S x 1]
+//  _dec    :   decision bits (bit n is state n) [size: _n*_S/8 x 1]
+void fec_viterbi_acs_sse(unsigned int    _S,
+                         unsigned int    _R,
+                         int16_t *       _branch,
+                         unsigned char * _sym,
+                         unsigned int    _n,
+                         int16_t *       _norm,
+                         int16_t **      _m0,
+                         int16_t **      _m1,
+                         unsigned char * _dec);
+void fec_viterbi_acs_avx2(unsigned int    _S,
+                          unsigned int    _R,
+                          int16_t *       _branch,
+                          unsigned char * _sym,
+                          unsigned int    _n,
+                          int16_t *       _norm,
+                          int16_t **      _m0,
+                          int16_t **      _m1,
+                          unsigned char * _dec);
+
+// fec_rscodec : Reed-Solomon codec over GF(2^8), compatible with the
+// Karn/libfec "char" codec; syndromes and parity symbols are computed
+// with vectorized GF(2^8) multiplications (SSSE3/AVX2 nibble tables)
+// selected at run time, and errors are located and corrected with
+// Berlekamp-Massey, Chien search and Forney's algorithm
+typedef struct fec_rscodec_s * fec_rscodec;
+
+// create Reed-Solomon codec
+//  _gfpoly :   field generator polynomial, e.g. 0x11d
+//  _fcr    :   first consecutive root of code generator (index form)
+//  _prim   :   primitive element generating the roots (index form)
+//  _nroots :   number of parity symbols, 0 < _nroots < 255
+//  _pad    :   number of implicit leading zero (padding) symbols
+fec_rscodec fec_rscodec_create(unsigned int _gfpoly,
+                               unsigned int _fcr,
+                               unsigned int _prim,
+                               unsigned int _nroots,
+                               unsigned int _pad);
+
+// destroy Reed-Solomon codec object
+void fec_rscodec_destroy(fec_rscodec _q);
+
+// encode block, computing parity symbols
+//  _q      :   codec object
+//  _data   :   message symbols [size: 255-_nroots-_pad x 1]
+//  _parity :   parity symbols [size: _nroots x 1]
+void fec_rscodec_encode(fec_rscodec     _q,
+                        unsigned char * _data,
+                        unsigned char * _parity);
+
+// decode block in place, returning number of corrected symbols or -1
+// if the block could not be corrected
+//  _q      :   codec object
+//  _data   :   received block, message then parity symbols
+//              [size: 255-_pad x 1]
+int fec_rscodec_decode(fec_rscodec     _q,
+                       unsigned char * _data);
+
+// compute syndromes of block: _s[j] = r(alpha^((_fcr+j)*_prim))
+//  _tab    :   multiplication tables [size: _nroots x 32*(log2(W)+1)]
+//              for W=16 (sse) or W=32 (avx2), see fec_rscodec_create()
+//  _r      :   block with leading zeros, length multiple of W
+//  _n      :   length of _r
+//  _s      :   syndromes [size: _nroots x 1]
+void fec_rscodec_syndromes_sse(unsigned int    _nroots,
+                               unsigned char * _tab,
+                               unsigned char * _r,
+                               unsigned int    _n,
+                               unsigned char * _s);
+void fec_rscodec_syndromes_avx2(unsigned int    _nroots,
+                                unsigned char * _tab,
+                                unsigned char * _r,
+                                unsigned int    _n,
+                                unsigned char * _s);
+
+// compute parity symbols as sum of _data[i] * (x^(_nroots+_k-1-i) mod g(x))
+//  _nroots :   number of parity symbols, multiple of 16
+//  _mtab   :   nibble multiplication tables [size: 256 x 32]
+//  _rem    :   remainder nibbles [size: kk x 2*_nroots]
+//  _data   :   message symbols [size: _k x 1]
+//  _k      :   number of message symbols
+//  _parity :   parity symbols [size: _nroots x 1]
+void fec_rscodec_encode_sse(unsigned int    _nroots,
+                            unsigned char * _mtab,
+                            unsigned char * _rem,
+                            unsigned char * _data,
+                            unsigned int    _k,
+                            unsigned char * _parity);
+void fec_rscodec_encode_avx2(unsigned int    _nroots,
+                             unsigned char * _mtab,
+                             unsigned char * _rem,
+                             unsigned char * _data,
+                             unsigned int    _k,
+                             unsigned char * _parity);
 
 // fec : basic object
 struct fec_s {
@@ -136,21 +411,13 @@ struct fec_s {
 
     // convolutional : internal memory structure
     unsigned char * enc_bits;
-    void * vp;      // decoder object
+    fec_viterbi vp; // decoder object
     int * poly;     // polynomial
     unsigned int R; // primitive rate, inverted (e.g. R=3 for 1/3)
     unsigned int K; // constraint length
     unsigned int P; // puncturing rate (e.g. p=3 for 3/4)
     int * puncturing_matrix;
 
-    // viterbi decoder function pointers
-    void*(*create_viterbi)(int);
-    //void (*set_viterbi_polynomial)(int*);
-    int  (*init_viterbi)(void*,int);
-    int  (*update_viterbi_blk)(void*,unsigned char*,int);
-    int  (*chainback_viterbi)(void*,unsigned char*,unsigned int,unsigned int);
-    void (*delete_viterbi)(void*);
-
     // Reed-Solomon
     int symsize;    // symbol size (bits per symbol)
     int genpoly;    // generator polynomial
@@ -161,7 +428,7 @@ struct fec_s {
     unsigned int rspad; // number of implicit padded symbols
     int nn;         // 2^symsize - 1
     int kk;         // nn - nroots
-    void * rs;      // Reed-Solomon internal object
+    fec_rscodec rs; // Reed-Solomon internal object
 
     // Reed-Solomon decoder
     unsigned int num_blocks;    // number of blocks: ceil(dec_msg_len / nn)
@@ -170,9 +437,6 @@ struct fec_s {
     unsigned int res_block_len; // residual bytes in last block
     unsigned int pad;           // padding for each block
     unsigned char * tblock;     // decoder input sequence [size: 1 x n]
-    int * errlocs;              // error locations [size: 1 x n]
-    int * derrlocs;             // decoded error locations [size: 1 x n]
-    int erasures;               // number of erasures
 
     // encode function pointer
     void (*encode_func)(fec _q,
@@ -545,7 +809,7 @@ void fec_conv_decode(fec _q,
 void fec_conv_setlength(fec _q,
                         unsigned int _dec_msg_len);
 
-// internal initialization methods (sets r, K, viterbi methods)
+// internal initialization methods (sets r, K, polynomials)
 void fec_conv_init_v27(fec _q);
 void fec_conv_init_v29(fec _q);
 void fec_conv_init_v39(fec _q);
@@ -570,8 +834,8 @@ void fec_conv_punctured_decode_soft(fec _q,
 void fec_conv_punctured_setlength(fec _q,
                                   unsigned int _dec_msg_len);
 
-// internal initialization methods (sets r, K, viterbi methods,
-// and puncturing matrix)
+// internal initialization methods (sets r, K, polynomials, and
+// puncturing matrix)
 void fec_conv_init_v27p23(fec _q);
 void fec_conv_init_v27p34(fec _q);
 void fec_conv_init_v27p45(fec _q);
@@ -600,6 +864,7 @@ unsigned int fec_rs_get_enc_msg_len(unsigned int _dec_msg_len,
 
 
 fec fec_rs_create(fec_scheme _fs);
+void fec_rs_destroy(fec _q);
 void fec_rs_init_p8(fec _q);
 void fec_rs_setlength(fec _q,
                       unsigned int _dec_msg_len);
@@ -699,6 +964,8 @@ typedef enum {
     LIQUID_FFT_METHOD_RADER,        // Rader's method for FFTs of prime length
     LIQUID_FFT_METHOD_RADER2,       // Rader's method for FFTs of prime length (alternate)
     LIQUID_FFT_METHOD_DFT,          // regular discrete Fourier transform
+    LIQUID_FFT_METHOD_RADIX4,       // Radix-4 Stockham (self-sorting), SIMD
+    LIQUID_FFT_METHOD_BATCH,        // batch of transforms (fft_create_plan_many)
 } liquid_fft_method;
 
 // Macro    :   FFT (internal)
@@ -726,6 +993,7 @@ FFT(_create_t) FFT(_create_plan_radix2);                        \
 FFT(_create_t) FFT(_create_plan_mixed_radix);                   \
 FFT(_create_t) FFT(_create_plan_rader);                         \
 FFT(_create_t) FFT(_create_plan_rader2);                        \
+FFT(_create_t) FFT(_create_plan_radix4);                        \
                                                                 \
 /* FFT destroy methods */                                       \
 FFT(_destroy_t) FFT(_destroy_plan_dft);                         \
@@ -733,6 +1001,8 @@ FFT(_destroy_t) FFT(_destroy_plan_radix2);                      \
 FFT(_destroy_t) FFT(_destroy_plan_mixed_radix);                 \
 FFT(_destroy_t) FFT(_destroy_plan_rader);                       \
 FFT(_destroy_t) FFT(_destroy_plan_rader2);                      \
+FFT(_destroy_t) FFT(_destroy_plan_radix4);                      \
+FFT(_destroy_t) FFT(_destroy_plan_many);                        \
                                                                 \
 /* FFT execute methods */                                       \
 FFT(_execute_t) FFT(_execute_dft);                              \
@@ -740,6 +1010,21 @@ FFT(_execute_t) FFT(_execute_radix2);                           \
 FFT(_execute_t) FFT(_execute_mixed_radix);                      \
 FFT(_execute_t) FFT(_execute_rader);                            \
 FFT(_execute_t) FFT(_execute_rader2);                           \
+FFT(_execute_t) FFT(_execute_radix4);                           \
+FFT(_execute_t) FFT(_execute_many);                             \
+FFT(_execute_t) FFT(_execute_many_interleaved);                 \
+                                                                \
+/* portable radix-4/radix-2 Stockham stages (see fft_radix4.c) */\
+void FFT(_radix4_stage)(unsigned int _n,                        \
+                        unsigned int _s,                        \
+                        unsigned int _b,                        \
+                        int          _dir,                      \
+                        TC *         _x,                        \
+                        TC *         _y,                        \
+                        TC *         _twiddle);                 \
+void FFT(_radix2_stage)(unsigned int _s,                        \
+                        TC *         _x,                        \
+                        TC *         _y);                       \
                                                                 \
 /* specific codelets for small DFTs */                          \
 FFT(_execute_t) FFT(_execute_dft_2);                            \
@@ -751,6 +1036,28 @@ FFT(_execute_t) FFT(_execute_dft_7);                            \
 FFT(_execute_t) FFT(_execute_dft_8);                            \
 FFT(_execute_t) FFT(_execute_dft_16);                           \
                                                                 \
+/* create plan with specific method                         */  \
+FFT(plan) FFT(_create_plan_method)(unsigned int      _nfft,     \
+                                   TC *              _x,        \
+                                   TC *              _y,        \
+                                   int               _dir,      \
+                                   int               _flags,    \
+                                   liquid_fft_method _method);  \
+                                                                \
+/* time candidate methods for a given size, storing fastest  */ \
+liquid_fft_method FFT(_measure_method)(unsigned int _nfft,      \
+                                       int          _dir,       \
+                                       int          _flags);    \
+                                                                \
+/* get method used by plan */                                   \
+liquid_fft_method FFT(_get_method)(FFT(plan) _q);               \
+                                                                \
+/* get shared twiddle factors from fft cache                */  \
+TC * FFT(_cache_twiddle)(unsigned int _nfft, int _dir);         \
+                                                                \
+/* get shared Rader sequence from fft cache                 */  \
+unsigned int * FFT(_cache_rader_seq)(unsigned int _nfft);       \
+                                                                \
 /* additional methods */                                        \
 unsigned int FFT(_estimate_mixed_radix)(unsigned int _nfft);    \
                                                                 \
@@ -766,6 +1073,21 @@ void FFT(_execute_RODFT10)(FFT(plan) _q);   /* DST-II  */       \
 void FFT(_execute_RODFT01)(FFT(plan) _q);   /* DST-III */       \
 void FFT(_execute_RODFT11)(FFT(plan) _q);   /* DST-IV  */       \
                                                                 \
+/* modified discrete cosine transform (MDCT) prototypes */     \
+void FFT(_execute_MDCT)(FFT(plan) _q);                          \
+void FFT(_execute_IMDCT)(FFT(plan) _q);                         \
+                                                                \
+/* DCT-II/III/IV cores (n log n), see fft_r2r_1d.c */           \
+void FFT(_r2r_dct2)(FFT(plan) _q, T * _x, T * _y, int _sign);   \
+void FFT(_r2r_dct3)(FFT(plan) _q, T * _x, T * _y, int _sign);   \
+void FFT(_r2r_dct4)(FFT(plan) _q, T * _x, T * _y);              \
+                                                                \
+/* real-to-complex/complex-to-real plans (see fft_real.c) */    \
+void FFT(_create_plan_real)(FFT(plan) _q);                      \
+void FFT(_destroy_plan_real)(FFT(plan) _q);                     \
+FFT(_execute_t) FFT(_execute_r2c);                              \
+FFT(_execute_t) FFT(_execute_c2r);                              \
+                                                                \
 /* destroy real-to-real one-dimensional plan */                 \
 void FFT(_destroy_plan_r2r_1d)(FFT(plan) _q);                   \
                                                                 \
@@ -781,6 +1103,102 @@ int fft_is_radix2(unsigned int _n);
 // miscellaneous functions
 unsigned int fft_reverse_index(unsigned int _i, unsigned int _n);
 
+// SIMD radix-4 Stockham FFT stages, selected at run time on x86 hosts.
+// Stage transforms sub-sequences of length _n at stride _s from _x
+// into _y; twiddle factors are read from the full-size table
+// _twiddle[i] = exp(j*dir*2*pi*i/(_n*_s)).  Samples of _b independent
+// transforms may be interleaved (data stride _s*_b) to vectorize
+// across transforms.  The first stage (_s=1, _b=1)
+// reads twiddles packed in groups of four as
+//   { w^p, w^p+1, w^p+2, w^p+3, w^2p, ..., w^3p, ..., w^3(p+3) }
+// and requires _n to be a multiple of 16.
+void fft_radix4_stage1_sse(unsigned int    _n,
+                           int             _dir,
+                           float complex * _x,
+                           float complex * _y,
+                           float complex * _twiddle4);
+void fft_radix4_stage_sse(unsigned int    _n,
+                          unsigned int    _s,
+                          unsigned int    _b,
+                          int             _dir,
+                          float complex * _x,
+                          float complex * _y,
+                          float complex * _twiddle);
+void fft_radix2_stage_sse(unsigned int    _s,
+                          float complex * _x,
+                          float complex * _y);
+void fft_radix4_stage1_avx2(unsigned int    _n,
+                            int             _dir,
+                            float complex * _x,
+                            float complex * _y,
+                            float complex * _twiddle4);
+void fft_radix4_stage_avx2(unsigned int    _n,
+                           unsigned int    _s,
+                           unsigned int    _b,
+                           int             _dir,
+                           float complex * _x,
+                           float complex * _y,
+                           float complex * _twiddle);
+void fft_radix2_stage_avx2(unsigned int    _s,
+                           float complex * _x,
+                           float complex * _y);
+
+// SIMD spectrum split (r2c) and merge (c2r) for real transforms of
+// size 2*_m computed with a complex transform of size _m (see
+// fft_real.c), selected at run time on x86 hosts.  Bins [1,k) are
+// processed, where k is the returned value; the caller completes the
+// remaining bins.
+//  _twiddle :   twiddle factors exp(-j*2*pi*i/(2*_m))
+unsigned int fft_real_split_sse(unsigned int    _m,
+                                float complex * _Z,
+                                float complex * _twiddle,
+                                float complex * _y);
+unsigned int fft_real_merge_sse(unsigned int    _m,
+                                float complex * _x,
+                                float complex * _twiddle,
+                                float complex * _Z);
+unsigned int fft_real_split_avx2(unsigned int    _m,
+                                 float complex * _Z,
+                                 float complex * _twiddle,
+                                 float complex * _y);
+unsigned int fft_real_merge_avx2(unsigned int    _m,
+                                 float complex * _x,
+                                 float complex * _twiddle,
+                                 float complex * _Z);
+
+// type of pre-computed data shared between plans in fft cache
+typedef enum {
+    LIQUID_FFT_CACHE_TWIDDLE=0,     // twiddle factors exp(j*dir*2*pi*i/nfft)
+    LIQUID_FFT_CACHE_INDEX_REV,     // radix-2 bit-reversed indices
+    LIQUID_FFT_CACHE_RADER_SEQ,     // Rader transformation sequence
+    LIQUID_FFT_CACHE_RADER_R,       // Rader transformed sequence
+    LIQUID_FFT_CACHE_RADER2_R,      // Rader (alternate) transformed sequence
+    LIQUID_FFT_CACHE_RADIX4,        // radix-4 first-stage twiddles (packed)
+} liquid_fft_cache_tag;
+
+// look up shared data in fft cache, incrementing reference count;
+// returns NULL if not found
+void * liquid_fft_cache_acquire(unsigned int         _nfft,
+                                int                  _dir,
+                                liquid_fft_cache_tag _tag);
+
+// insert data (allocated with malloc) into fft cache and return
+// pointer to shared copy (input may be freed)
+void * liquid_fft_cache_insert(unsigned int         _nfft,
+                               int                  _dir,
+                               liquid_fft_cache_tag _tag,
+                               void *               _data);
+
+// release reference to shared data in fft cache
+void liquid_fft_cache_release(void * _data);
+
+// look up/store measured fft method ("wisdom")
+liquid_fft_method liquid_fft_wisdom_lookup(unsigned int _nfft,
+                                           int          _dir);
+void liquid_fft_wisdom_store(unsigned int      _nfft,
+                             int               _dir,
+                             liquid_fft_method _method);
+
 
 LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_complex)
 
@@ -790,6 +1208,10 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   include <fftw3.h>
 #   define FFT_PLAN             fftwf_plan
 #   define FFT_CREATE_PLAN      fftwf_plan_dft_1d
+#   define FFT_CREATE_PLAN_MANY(n,howmany,x,istride,idist,y,ostride,odist,dir,flags) \
+        fftwf_plan_many_dft(1,(int[]){(int)(n)},howmany,x,NULL,istride,idist,y,NULL,ostride,odist,dir,flags)
+#   define FFT_CREATE_PLAN_R2C  fftwf_plan_dft_r2c_1d
+#   define FFT_CREATE_PLAN_C2R  fftwf_plan_dft_c2r_1d
 #   define FFT_DESTROY_PLAN     fftwf_destroy_plan
 #   define FFT_EXECUTE          fftwf_execute
 #   define FFT_DIR_FORWARD      FFTW_FORWARD
@@ -798,6 +1220,9 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #else
 #   define FFT_PLAN             fftplan
 #   define FFT_CREATE_PLAN      fft_create_plan
+#   define FFT_CREATE_PLAN_MANY  fft_create_plan_many
+#   define FFT_CREATE_PLAN_R2C  fft_create_plan_r2c
+#   define FFT_CREATE_PLAN_C2R  fft_create_plan_c2r
 #   define FFT_DESTROY_PLAN     fft_destroy_plan
 #   define FFT_EXECUTE          fft_execute
 #   define FFT_DIR_FORWARD      LIQUID_FFT_FORWARD
@@ -825,6 +1250,79 @@ float estimate_req_filter_len_Kaiser(float _df,
 float estimate_req_filter_len_Herrmann(float _df,
                                        float _As);
 
+// fused symsync_crcf filter kernels, selected at run time on x86 hosts;
+// computes *_mf = sum{ _h[i]*_x[i] } and, unless _dh is NULL,
+// *_dmf = sum{ _dh[i]*_x[i] } in a single pass over the input and
+// returns the number of samples processed (k <= _n), the caller
+// completes the remainder
+unsigned int symsync_crcf_dotprod2_sse(float *         _h,
+                                       float *         _dh,
+                                       float complex * _x,
+                                       unsigned int    _n,
+                                       float complex * _mf,
+                                       float complex * _dmf);
+unsigned int symsync_crcf_dotprod2_avx2(float *         _h,
+                                        float *         _dh,
+                                        float complex * _x,
+                                        unsigned int    _n,
+                                        float complex * _mf,
+                                        float complex * _dmf);
+
+// iirfilt kernels, selected at run time on x86 hosts
+//   sos_block : run one second-order section over blocks of samples
+//               with look-ahead coefficients _t, updating its state
+//               _v = {w[-1], w[-2]}; returns number of samples
+//               processed (k <= _n), the caller completes the
+//               remainder; _x and _y may be the same array
+//   parallel  : accumulate output of parallel-form sections with
+//               coefficient rows b0, b1, a1, a2 [size: 4 x _np] into
+//               _y (complex inputs use coefficients repeated for
+//               each component), updating state rows _w [size: 2 x _np]
+unsigned int iirfilt_rrrf_sos_block_sse(float *      _t,
+                                        float *      _v,
+                                        float *      _x,
+                                        unsigned int _n,
+                                        float *      _y);
+unsigned int iirfilt_rrrf_sos_block_avx2(float *      _t,
+                                         float *      _v,
+                                         float *      _x,
+                                         unsigned int _n,
+                                         float *      _y);
+unsigned int iirfilt_crcf_sos_block_sse(float *         _t,
+                                        float complex * _v,
+                                        float complex * _x,
+                                        unsigned int    _n,
+                                        float complex * _y);
+unsigned int iirfilt_crcf_sos_block_avx2(float *         _t,
+                                         float complex * _v,
+                                         float complex * _x,
+                                         unsigned int    _n,
+                                         float complex * _y);
+void iirfilt_rrrf_parallel_sse(float *      _c,
+                               float *      _w,
+                               unsigned int _np,
+                               float *      _x,
+                               unsigned int _n,
+                               float *      _y);
+void iirfilt_rrrf_parallel_avx2(float *      _c,
+                                float *      _w,
+                                unsigned int _np,
+                                float *      _x,
+                                unsigned int _n,
+                                float *      _y);
+void iirfilt_crcf_parallel_sse(float *         _c,
+                               float complex * _w,
+                               unsigned int    _np,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y);
+void iirfilt_crcf_parallel_avx2(float *         _c,
+                                float complex * _w,
+                                unsigned int    _np,
+                                float complex * _x,
+                                unsigned int    _n,
+                                float complex * _y);
+
 
 // fir_farrow
 #define LIQUID_FIRFARROW_DEFINE_INTERNAL_API(FIRFARROW,TO,TC,TI)  \
@@ -1099,6 +1597,19 @@ void framegen64_byte_to_syms(unsigned char _byte,
 void framesync64_syms_to_byte(unsigned char * _syms,
                               unsigned char * _byte);
 
+// framesync64, flexframesync preamble length (samples)
+#define FRAMESYNC64_PREAMBLE_LEN    (128)
+#define FLEXFRAMESYNC_PREAMBLE_LEN  (128)
+
+// generate p/n preamble symbols and the matched-filter interpolated
+// samples the frame detector looks for
+//  _pn     :   p/n symbols [size: 64 x 1]
+//  _seq    :   preamble samples [size: *_PREAMBLE_LEN x 1]
+void framesync64_gen_preamble(float *         _pn,
+                              float complex * _seq);
+void flexframesync_gen_preamble(float *         _pn,
+                                float complex * _seq);
+
 //
 // bpacket
 //
@@ -1129,8 +1640,7 @@ void bpacketsync_reconfig(bpacketsync _q);
 // header description
 // NOTE: The flexframe header can be improved with crc24, secded7264, v29
 //       which also generates a 54-byte frame. Improves header decoding
-//       by about 1 dB (99% probability of decoding with SNR = -1 dB);
-//       however this requires that the 'libfec' libraries are installed.
+//       by about 1 dB (99% probability of decoding with SNR = -1 dB).
 #define FLEXFRAME_H_USER    (14)                    // user-defined array
 #define FLEXFRAME_H_DEC     (FLEXFRAME_H_USER+6)    // decoded length
 #define FLEXFRAME_H_CRC     (LIQUID_CRC_32)         // header CRC
@@ -1223,10 +1733,44 @@ void ofdmflexframesync_rxheader(ofdmflexframesync _q,
 // decode header
 void ofdmflexframesync_decode_header(ofdmflexframesync _q);
 
-// receive payload data
+// receive payload symbol (time domain if pipelined)
 void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                                 float complex * _X);
 
+// frame in flight (header, payload buffers, equalizer state)
+struct ofdmflexframesync_frame_s;
+
+// start frame for decoded header (acquisition stage)
+void ofdmflexframesync_open_frame(ofdmflexframesync _q);
+
+// close frame without (remaining) payload symbols: deliver it or,
+// if _abort is set, drop it
+void ofdmflexframesync_close_frame(ofdmflexframesync _q,
+                                   int               _abort);
+
+// demodulate payload symbol into frame, returning 1 when complete
+int ofdmflexframesync_demod_symbol(ofdmflexframesync                  _q,
+                                   struct ofdmflexframesync_frame_s * _f,
+                                   float complex *                    _X);
+
+// decode payload of frame and invoke callback
+void ofdmflexframesync_decode_frame(ofdmflexframesync                  _q,
+                                    struct ofdmflexframesync_frame_s * _f);
+
+// return frame to, or wait for frame at, acquisition stage
+void ofdmflexframesync_release_frame(ofdmflexframesync _q,
+                                     unsigned int      _frame);
+void ofdmflexframesync_wait_frame(ofdmflexframesync _q);
+
+// allocate/free frame descriptors
+void ofdmflexframesync_create_frames(ofdmflexframesync _q,
+                                     unsigned int      _num_frames);
+void ofdmflexframesync_destroy_frames(ofdmflexframesync _q);
+
+// start/stop worker threads (delivering all frames in flight)
+void ofdmflexframesync_start_pipeline(ofdmflexframesync _q);
+void ofdmflexframesync_stop_pipeline(ofdmflexframesync _q);
+
 
 //
 // MODULE : math
@@ -1362,6 +1906,18 @@ MODEM() MODEM(_create_arb64vt)(void);                           \
 /* Scale arbitrary modem energy to unity */                     \
 void MODEM(_arb_scale)(MODEM() _q);                             \
                                                                 \
+/* build/free grid index for nearest-point search over */       \
+/* arbitrary modem constellation                       */       \
+void MODEM(_arb_init_index)(MODEM() _q);                        \
+void MODEM(_arb_free_index)(MODEM() _q);                        \
+                                                                \
+/* find constellation point nearest to _x, returning   */       \
+/* symbol index and squared distance                   */       \
+void MODEM(_arb_search)(MODEM()        _q,                      \
+                        TC             _x,                      \
+                        unsigned int * _s,                      \
+                        T *            _d);                     \
+                                                                \
 /* Balance I/Q */                                               \
 void MODEM(_arb_balance_iq)(MODEM() _q);                        \
                                                                 \
@@ -1421,6 +1977,22 @@ void MODEM(_demodulate_soft_table)(MODEM()         _q,          \
                                    unsigned int *  _sym_out,    \
                                    unsigned char * _soft_bits); \
                                                                 \
+/* soft demodulation of a block of QAM samples (max-log)    */  \
+void MODEM(_demodulate_soft_block_qam)(MODEM()         _q,      \
+                                       TC *            _x,      \
+                                       unsigned int    _n,      \
+                                       unsigned char * _soft_bits); \
+                                                                \
+/* max-log soft demodulation of one Gray-coded QAM axis     */  \
+/*  _y          :   received value, normalized              */  \
+/*  _m          :   bits per axis                           */  \
+/*  _g          :   soft-bit scaling                        */  \
+/*  _soft_bits  :   output soft bits [size: _m x 1]         */  \
+void MODEM(_demodulate_soft_pam)(T               _y,            \
+                                 unsigned int    _m,            \
+                                 T               _g,            \
+                                 unsigned char * _soft_bits);   \
+                                                                \
 /* Demodulate a linear symbol constellation using dynamic   */  \
 /* threshold calculation                                    */  \
 /*  _v      :   input value             */                      \
@@ -1491,11 +2063,60 @@ extern const float complex modem_arb64opt[64];
 extern const float complex modem_arb128opt[128];
 extern const float complex modem_arb256opt[256];
 
+// SIMD kernels for modem_demodulate_soft_block_qam(), square QAM with
+// _m bits per axis; return the number of samples processed, k <= _n
+unsigned int modem_demodulate_soft_qam_sse(float complex * _x,
+                                           unsigned int    _n,
+                                           unsigned int    _m,
+                                           float           _alpha_inv,
+                                           float           _g,
+                                           unsigned char * _soft_bits);
+unsigned int modem_demodulate_soft_qam_avx2(float complex * _x,
+                                            unsigned int    _n,
+                                            unsigned int    _m,
+                                            float           _alpha_inv,
+                                            float           _g,
+                                            unsigned char * _soft_bits);
+
 
 //
 // MODULE : multichannel
 //
 
+// polyphase filterbank matrix-vector product (firpfbch, firpfbch2)
+//   _y[i] = sum_{t=0}^{_p-1} H[t][i] * _x[i - t*_xs],  i in [0,_n)
+// with H[t][i] at _hi[2*(t*_hs+i)] (repeated for real and imaginary
+// parts of the input) and _hq (NULL for real coefficients) holding
+// imaginary parts in the same layout; _simd is a liquid_simd_level
+void firpfbch_matvec(int               _simd,
+                     unsigned int      _p,
+                     unsigned int      _hs,
+                     unsigned int      _xs,
+                     float *           _hi,
+                     float *           _hq,
+                     float complex *   _x,
+                     float complex *   _y,
+                     unsigned int      _n);
+
+// SIMD kernels for firpfbch_matvec(), returning the number of outputs
+// computed, k <= _n
+unsigned int firpfbch_matvec_sse(unsigned int    _p,
+                                 unsigned int    _hs,
+                                 unsigned int    _xs,
+                                 float *         _hi,
+                                 float *         _hq,
+                                 float complex * _x,
+                                 float complex * _y,
+                                 unsigned int    _n);
+unsigned int firpfbch_matvec_avx2(unsigned int    _p,
+                                  unsigned int    _hs,
+                                  unsigned int    _xs,
+                                  float *         _hi,
+                                  float *         _hq,
+                                  float complex * _x,
+                                  float complex * _y,
+                                  unsigned int    _n);
+
 // ofdm frame (common)
 
 // generate short sequence symbols
@@ -1571,6 +2192,47 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 void ofdmframesync_rxsymbol(ofdmframesync _q);
 
+// defer recovery of received symbols: when enabled, the callback is
+// given each symbol in the time domain (cyclic prefix removed) to be
+// recovered later with ofdmframesync_rxsymbol_deferred(); cleared on
+// reset
+void ofdmframesync_set_defer(ofdmframesync _q,
+                             int           _defer);
+
+// copy equalizer state (gain, pilot phase tracking, pilot sequence)
+void ofdmframesync_copy_eqstate(ofdmframesync _dst,
+                                ofdmframesync _src);
+
+// recover deferred time-domain symbol _x [size: M x 1] into
+// subcarriers _X [size: M x 1] using equalizer state of _q
+void ofdmframesync_rxsymbol_deferred(ofdmframesync   _q,
+                                     float complex * _x,
+                                     float complex * _X);
+
+// apply equalizer gain and pilot phase correction to all subcarriers,
+//   X[i] <- X[i] R[i] exp{-j(_p0 + _p1 i)}
+// with subcarrier index i in [-M/2,M/2) (null subcarriers are zeroed)
+//  _q      :   ofdmframesync object
+//  _p0     :   phase offset
+//  _p1     :   phase slope
+void ofdmframesync_equalize(ofdmframesync _q,
+                            float         _p0,
+                            float         _p1);
+
+// SIMD kernels for ofdmframesync_equalize(): X[i] <- X[i] R[i] p[i%8]
+// with eight lane phasors _p advanced by _r every eight subcarriers;
+// return the number of subcarriers processed, k <= _n
+unsigned int ofdmframesync_equalize_sse(float complex * _p,
+                                        float complex   _r,
+                                        float complex * _R,
+                                        float complex * _X,
+                                        unsigned int    _n);
+unsigned int ofdmframesync_equalize_avx2(float complex * _p,
+                                         float complex   _r,
+                                         float complex * _R,
+                                         float complex * _X,
+                                         unsigned int    _n);
+
 // 
 // MODULE : nco (numerically-controlled oscillator)
 //
@@ -1579,9 +2241,10 @@ void ofdmframesync_rxsymbol(ofdmframesync _q);
 // Numerically-controlled oscillator, floating point phase precision
 #define LIQUID_NCO_DEFINE_INTERNAL_API(NCO,T,TC)                \
                                                                 \
-/* constrain phase/frequency to be in [-pi,pi)          */      \
-void NCO(_constrain_phase)(NCO() _q);                           \
-void NCO(_constrain_frequency)(NCO() _q);                       \
+/* convert between phase [radians] and fixed-point      */      \
+/* phase (2^64 = 2 pi)                                  */      \
+uint64_t NCO(_fixed_from_phase)(T _phi);                        \
+T        NCO(_phase_from_fixed)(uint64_t _theta);               \
                                                                 \
 /* compute trigonometric functions for nco/vco type     */      \
 void NCO(_compute_sincos_nco)(NCO() _q);                        \
@@ -1589,12 +2252,35 @@ void NCO(_compute_sincos_vco)(NCO() _q);                        \
                                                                 \
 /* reset internal phase-locked loop filter              */      \
 void NCO(_pll_reset)(NCO() _q);                                 \
+                                                                \
+/* mix block of samples with complex exponential of     */      \
+/* fixed-point phase _theta, frequency _d_theta         */      \
+void NCO(_mix_block)(NCO()        _q,                           \
+                     uint64_t     _theta,                       \
+                     uint64_t     _d_theta,                     \
+                     TC *         _x,                           \
+                     TC *         _y,                           \
+                     unsigned int _n);                          \
 
 // Define nco internal APIs
 LIQUID_NCO_DEFINE_INTERNAL_API(NCO_MANGLE_FLOAT,
                                float,
                                float complex)
 
+// SIMD kernels for nco_crcf_mix_block(): mix samples with eight lane
+// phasors _p, advancing them by _r every eight samples; return the
+// number of samples processed (a multiple of 8, k <= _n)
+unsigned int nco_mix_block_sse(float complex * _p,
+                               float complex   _r,
+                               float complex * _x,
+                               float complex * _y,
+                               unsigned int    _n);
+unsigned int nco_mix_block_avx2(float complex * _p,
+                                float complex   _r,
+                                float complex * _x,
+                                float complex * _y,
+                                unsigned int    _n);
+
 // 
 // MODULE : optim (non-linear optimization)
 //
@@ -1798,6 +2484,94 @@ extern struct msequence_s msequence_default[16];
 // MODULE : utility
 //
 
+// x86 host with gcc-style function target attributes; SIMD kernels
+// for these hosts are compiled without special flags and selected at
+// run time with liquid_cpu_get_simd_level()
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#  define LIQUID_CPU_X86 1
+#else
+#  define LIQUID_CPU_X86 0
+#endif
+
+// run-time processor features (x86 cpuid; operating system support
+// for extended register state is verified with xgetbv)
+#define LIQUID_CPU_SSE2         (1<< 0)
+#define LIQUID_CPU_SSE3         (1<< 1)
+#define LIQUID_CPU_SSSE3        (1<< 2)
+#define LIQUID_CPU_SSE41        (1<< 3)
+#define LIQUID_CPU_SSE42        (1<< 4)
+#define LIQUID_CPU_PCLMUL       (1<< 5)
+#define LIQUID_CPU_AVX          (1<< 6)
+#define LIQUID_CPU_FMA          (1<< 7)
+#define LIQUID_CPU_AVX2         (1<< 8)
+#define LIQUID_CPU_AVX512F      (1<< 9)
+#define LIQUID_CPU_AVX512BW     (1<<10)
+
+// get processor features supported by host (detected once on first
+// use), restricted by liquid_cpu_set_mask()
+unsigned int liquid_cpu_get_features(void);
+
+// restrict run-time processor features to _mask, e.g. to test or
+// benchmark fall-back kernels; objects which select their kernel at
+// creation are unaffected until they are re-created
+void liquid_cpu_set_mask(unsigned int _mask);
+
+// print processor features to stdout
+void liquid_cpu_print_features(void);
+
+// widest usable floating-point SIMD extension
+typedef enum {
+    LIQUID_SIMD_NONE=0, // portable C
+    LIQUID_SIMD_SSE,    // SSE/SSE2/SSE3, 128-bit
+    LIQUID_SIMD_AVX2,   // AVX2 and FMA, 256-bit
+    LIQUID_SIMD_AVX512, // AVX-512F, 512-bit
+} liquid_simd_level;
+
+// get widest usable floating-point SIMD extension
+liquid_simd_level liquid_cpu_get_simd_level(void);
+
+// fork-join thread pool for splitting work of a single object across
+// threads (see threadpool.c)
+typedef struct liquid_threadpool_s * liquid_threadpool;
+
+// task function: _arg is user data, _task is the task index, and
+// _worker in [0,num_threads) identifies the executing worker
+typedef void (*liquid_threadpool_task)(void *       _arg,
+                                       unsigned int _task,
+                                       unsigned int _worker);
+
+// create thread pool with _num_threads workers (including the
+// calling thread); without thread support only one worker is created
+liquid_threadpool liquid_threadpool_create(unsigned int _num_threads);
+void liquid_threadpool_destroy(liquid_threadpool _q);
+unsigned int liquid_threadpool_get_num_threads(liquid_threadpool _q);
+
+// execute _func(_arg, task, worker) for every task in [0,_num_tasks)
+// on the pool's workers, returning once all tasks are complete
+void liquid_threadpool_execute(liquid_threadpool      _q,
+                               liquid_threadpool_task _func,
+                               void *                 _arg,
+                               unsigned int           _num_tasks);
+
+// single-producer, single-consumer queue of fixed-size slots for
+// passing work between two threads (see spscqueue.c); slots are
+// filled and drained in place, and each side blocks while the queue
+// is full (write_begin) or empty (read_begin)
+typedef struct liquid_spscqueue_s * liquid_spscqueue;
+
+// create queue of at least _num_slots slots of _slot_size bytes each
+liquid_spscqueue liquid_spscqueue_create(unsigned int _num_slots,
+                                         unsigned int _slot_size);
+void liquid_spscqueue_destroy(liquid_spscqueue _q);
+
+// producer: obtain next free slot, then hand it to the consumer
+void * liquid_spscqueue_write_begin(liquid_spscqueue _q);
+void   liquid_spscqueue_write_end(liquid_spscqueue _q);
+
+// consumer: obtain oldest slot, then return it to the producer
+void * liquid_spscqueue_read_begin(liquid_spscqueue _q);
+void   liquid_spscqueue_read_end(liquid_spscqueue _q);
+
 // number of ones in a byte
 //  0   0000 0000   :   0
 //  1   0000 0001   :   1
@@ -77,3 +77,49 @@ void benchmark_agc_crcf                 AGC_CRCF_BENCHMARK_API(0, 0)
 void benchmark_agc_crcf_squelch         AGC_CRCF_BENCHMARK_API(1, 0)
 void benchmark_agc_crcf_locked          AGC_CRCF_BENCHMARK_API(0, 1)
 
+
+// helper function for block execution
+void agc_crcf_block_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _n,
+                          int                 _squelch)
+{
+    // normalize number of iterations
+    *_num_iterations /= _n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned int i;
+
+    // initialize AGC object
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q,0.05f);
+
+    // squelch?
+    if (_squelch) agc_crcf_squelch_activate(q);
+    else          agc_crcf_squelch_deactivate(q);
+
+    float complex x[_n];        // input block
+    float complex y[_n];        // output block
+    for (i=0; i<_n; i++)
+        x[i] = 1e-3f * cexpf(_Complex_I*0.1f*i);
+
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        agc_crcf_execute_block(q, x, _n, y);
+    getrusage(RUSAGE_SELF, _finish);
+
+    *_num_iterations *= _n;
+
+    // destroy object
+    agc_crcf_destroy(q);
+}
+
+#define AGC_CRCF_BLOCK_BENCHMARK_API(N,SQUELCH) \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ agc_crcf_block_bench(_start, _finish, _num_iterations, N, SQUELCH); }
+
+void benchmark_agc_crcf_block_256           AGC_CRCF_BLOCK_BENCHMARK_API(256, 0)
+void benchmark_agc_crcf_block_256_squelch   AGC_CRCF_BLOCK_BENCHMARK_API(256, 1)
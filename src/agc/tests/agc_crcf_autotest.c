@@ -167,3 +167,210 @@ void autotest_agc_crcf_rssi_noise()
 
 
 
+
+// 
+// Test DC gain control, block mode
+//
+void autotest_agc_crcf_dc_gain_control_block()
+{
+    // set paramaters
+    float gamma = 0.1f;             // nominal signal level
+    float bt = 0.01f;               // bandwidth-time product
+    float tol = 0.001f;             // error tolerance
+
+    // create AGC object and initialize
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q, bt);
+
+    // run block of odd length to exercise remainder
+    unsigned int n = 250;
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = gamma;
+    agc_crcf_execute_block(q, x, n, y);
+    
+    // Check results
+    CONTEND_DELTA( crealf(y[n-1]), 1.0f, tol );
+    CONTEND_DELTA( cimagf(y[n-1]), 0.0f, tol );
+    CONTEND_DELTA( agc_crcf_get_gain(q), 1.0f/gamma, tol );
+
+    // destroy AGC object
+    agc_crcf_destroy(q);
+}
+
+// 
+// Test block mode tracks per-sample mode within 0.5 dB on
+// a signal with a step change in level
+//
+void autotest_agc_crcf_block_vs_sample()
+{
+    float bt   = 0.02f;             // bandwidth-time product
+    float tol  = 0.5f;              // error tolerance [dB]
+    unsigned int n = 64;            // block size
+    unsigned int num_blocks = 32;   // number of blocks
+
+    // create AGC objects and initialize
+    agc_crcf q0 = agc_crcf_create();
+    agc_crcf q1 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q0, bt);
+    agc_crcf_set_bandwidth(q1, bt);
+
+    float complex x[n];
+    float complex y0[n];
+    float complex y1[n];
+    unsigned int i;
+    unsigned int b;
+    for (b=0; b<num_blocks; b++) {
+        // signal level steps up by 20 dB half way through
+        float gamma = b < num_blocks/2 ? 0.05f : 0.5f;
+        for (i=0; i<n; i++)
+            x[i] = gamma * cexpf(_Complex_I*0.1f*(b*n+i));
+
+        for (i=0; i<n; i++)
+            agc_crcf_execute(q0, x[i], &y0[i]);
+        agc_crcf_execute_block(q1, x, n, y1);
+
+        // compare after loop has settled from each transition
+        if (b == num_blocks/2 - 1 || b == num_blocks - 1) {
+            float rssi0 = agc_crcf_get_rssi(q0);
+            float rssi1 = agc_crcf_get_rssi(q1);
+            if (liquid_autotest_verbose)
+                printf("  block %3u : rssi %8.3f / %8.3f dB\n", b, rssi0, rssi1);
+            CONTEND_DELTA( rssi1, rssi0, tol );
+            CONTEND_DELTA( cabsf(y1[n-1]), cabsf(y0[n-1]), 0.06f );
+        }
+    }
+
+    // destroy AGC objects
+    agc_crcf_destroy(q0);
+    agc_crcf_destroy(q1);
+}
+
+// 
+// Test locked block mode applies fixed gain
+//
+void autotest_agc_crcf_block_locked()
+{
+    agc_crcf q = agc_crcf_create();
+    agc_crcf_set_bandwidth(q, 0.1f);
+
+    unsigned int n = 37;
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    for (i=0; i<n; i++)
+        x[i] = 0.2f * cexpf(_Complex_I*0.3f*i);
+
+    // settle, then lock
+    agc_crcf_execute_block(q, x, n, y);
+    agc_crcf_execute_block(q, x, n, y);
+    agc_crcf_lock(q);
+    float g = agc_crcf_get_gain(q);
+
+    agc_crcf_execute_block(q, x, n, y);
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( cabsf(y[i]), cabsf(x[i])*g, 1e-6f );
+    CONTEND_EQUALITY( agc_crcf_get_gain(q), g );
+
+    agc_crcf_destroy(q);
+}
+
+// 
+// Test in-place block mode matches out-of-place block mode
+//
+void autotest_agc_crcf_block_in_place()
+{
+    float bt = 0.05f;               // bandwidth-time product
+    unsigned int n = 250;           // block size (not a multiple of window)
+    unsigned int num_blocks = 8;    // number of blocks
+
+    // create AGC objects and initialize
+    agc_crcf q0 = agc_crcf_create();
+    agc_crcf q1 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q0, bt);
+    agc_crcf_set_bandwidth(q1, bt);
+
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    unsigned int b;
+    for (b=0; b<num_blocks; b++) {
+        // signal level steps down by 40 dB half way through
+        float gamma = b < num_blocks/2 ? 0.5f : 0.005f;
+        for (i=0; i<n; i++)
+            x[i] = gamma * cexpf(_Complex_I*0.1f*(b*n+i));
+
+        // out of place, then in place
+        agc_crcf_execute_block(q0, x, n, y);
+        agc_crcf_execute_block(q1, x, n, x);
+
+        for (i=0; i<n; i++) {
+            CONTEND_EQUALITY( crealf(x[i]), crealf(y[i]) );
+            CONTEND_EQUALITY( cimagf(x[i]), cimagf(y[i]) );
+        }
+        CONTEND_EQUALITY( agc_crcf_get_rssi(q1), agc_crcf_get_rssi(q0) );
+    }
+
+    // output level is restored after the step
+    CONTEND_DELTA( cabsf(y[n-1]), 1.0f, 0.01f );
+
+    // destroy AGC objects
+    agc_crcf_destroy(q0);
+    agc_crcf_destroy(q1);
+}
+
+// 
+// Test squelch state in block mode follows per-sample mode
+// through signal, noise floor (with timeout), and signal
+//
+void autotest_agc_crcf_block_squelch()
+{
+    float bt = 0.05f;               // bandwidth-time product
+    unsigned int n = 64;            // block size
+    unsigned int num_blocks = 60;   // number of blocks
+
+    // create AGC objects and initialize
+    agc_crcf q0 = agc_crcf_create();
+    agc_crcf q1 = agc_crcf_create();
+    agc_crcf_set_bandwidth(q0, bt);
+    agc_crcf_set_bandwidth(q1, bt);
+    agc_crcf_squelch_activate(q0);
+    agc_crcf_squelch_activate(q1);
+    agc_crcf_squelch_set_threshold(q0, -50.0f);
+    agc_crcf_squelch_set_threshold(q1, -50.0f);
+    agc_crcf_squelch_set_timeout(q0, 100);
+    agc_crcf_squelch_set_timeout(q1, 100);
+
+    float complex x[n];
+    float complex y[n];
+    unsigned int i;
+    unsigned int b;
+    for (b=0; b<num_blocks; b++) {
+        // signal (-20 dB), noise floor (-80 dB), signal (-20 dB)
+        float gamma = (b < num_blocks/3 || b >= 2*num_blocks/3) ? 0.1f : 1e-4f;
+        for (i=0; i<n; i++)
+            x[i] = gamma * cexpf(_Complex_I*0.2f*(b*n+i));
+
+        for (i=0; i<n; i++)
+            agc_crcf_execute(q0, x[i], &y[i]);
+        agc_crcf_execute_block(q1, x, n, y);
+
+        // check state once settled in each segment
+        if (b == num_blocks/3 - 1 || b == 2*num_blocks/3 - 1 || b == num_blocks - 1) {
+            int status0 = agc_crcf_squelch_get_status(q0);
+            int status1 = agc_crcf_squelch_get_status(q1);
+            if (liquid_autotest_verbose)
+                printf("  block %3u : squelch status %d / %d\n", b, status0, status1);
+            CONTEND_EQUALITY( status1, status0 );
+            CONTEND_EQUALITY( status1, b == 2*num_blocks/3 - 1 ?
+                                       LIQUID_AGC_SQUELCH_ENABLED :
+                                       LIQUID_AGC_SQUELCH_SIGNALHI );
+        }
+    }
+
+    // destroy AGC objects
+    agc_crcf_destroy(q0);
+    agc_crcf_destroy(q1);
+}
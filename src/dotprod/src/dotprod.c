@@ -163,3 +163,18 @@ void DOTPROD(_execute)(DOTPROD() _q,
     DOTPROD(_run4)(_q->h, _x, _q->n, _y);
 }
 
+
+// execute structured dot product over sliding input
+//  _q      :   dot product object
+//  _x      :   input array [size: 1 x (_n + q->n - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+void DOTPROD(_execute_block)(DOTPROD()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        DOTPROD(_run4)(_q->h, &_x[i], _q->n, &_y[i]);
+}
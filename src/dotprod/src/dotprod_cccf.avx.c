@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// 
+// Floating-point dot product, complex input, complex coefficients
+// (AVX2/FMA, AVX-512)
+//
+// (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
+//
+// The products of the input against the repeated real (hi) and imaginary
+// (hq) coefficients are accumulated separately; the quadrature sum is
+// swapped pair-wise and combined with alternating sign once at the end.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>
+
+// use AVX2/FMA extensions
+//  _hi     :   repeated real coefficients, 32-byte aligned [size: 2 x _n]
+//  _hq     :   repeated imag coefficients, 32-byte aligned [size: 2 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   dot product length
+//  _y      :   output dot product
+__attribute__((target("avx2,fma")))
+void dotprod_cccf_execute_avx2(float *         _hi,
+                               float *         _hq,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m256 sumi0 = _mm256_setzero_ps();
+    __m256 sumi1 = _mm256_setzero_ps();
+    __m256 sumq0 = _mm256_setzero_ps();
+    __m256 sumq1 = _mm256_setzero_ps();
+
+    // r = 16*floor(n/16), t = 8*floor(n/8)
+    unsigned int r = (n >> 4) << 4;
+    unsigned int t = (n >> 3) << 3;
+
+    __m256 v0, v1;
+    unsigned int i;
+    for (i=0; i<r; i+=16) {
+        v0 = _mm256_loadu_ps(&x[i  ]);
+        v1 = _mm256_loadu_ps(&x[i+8]);
+        sumi0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hi[i  ]), sumi0);
+        sumi1 = _mm256_fmadd_ps(v1, _mm256_load_ps(&_hi[i+8]), sumi1);
+        sumq0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hq[i  ]), sumq0);
+        sumq1 = _mm256_fmadd_ps(v1, _mm256_load_ps(&_hq[i+8]), sumq1);
+    }
+
+    // remaining group of 8
+    for ( ; i<t; i+=8) {
+        v0 = _mm256_loadu_ps(&x[i]);
+        sumi0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hi[i]), sumi0);
+        sumq0 = _mm256_fmadd_ps(v0, _mm256_load_ps(&_hq[i]), sumq0);
+    }
+
+    // fold down
+    sumi0 = _mm256_add_ps(sumi0, sumi1);
+    sumq0 = _mm256_add_ps(sumq0, sumq1);
+
+    // swap quadrature pairs and combine: { re, im, re, im, ... }
+    sumq0 = _mm256_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+    sumi0 = _mm256_addsub_ps(sumi0, sumq0);
+
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sumi0),
+                          _mm256_extractf128_ps(sumi0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+
+    // aligned output array
+    float w[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, s);
+    float complex total = w[0] + _Complex_I*w[1];
+
+    // cleanup
+    for (i=t/2; i<_n; i++)
+        total += _x[i] * ( _hi[2*i] + _hq[2*i]*_Complex_I );
+
+    // set return value
+    *_y = total;
+}
+
+// use AVX-512 extensions
+//  _hi     :   repeated real coefficients, 64-byte aligned [size: 2 x _n]
+//  _hq     :   repeated imag coefficients, 64-byte aligned [size: 2 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   dot product length
+//  _y      :   output dot product
+__attribute__((target("avx512f")))
+void dotprod_cccf_execute_avx512(float *         _hi,
+                                 float *         _hq,
+                                 float complex * _x,
+                                 unsigned int    _n,
+                                 float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m512 sumi0 = _mm512_setzero_ps();
+    __m512 sumi1 = _mm512_setzero_ps();
+    __m512 sumq0 = _mm512_setzero_ps();
+    __m512 sumq1 = _mm512_setzero_ps();
+
+    // r = 32*floor(n/32), t = 16*floor(n/16)
+    unsigned int r = (n >> 5) << 5;
+    unsigned int t = (n >> 4) << 4;
+
+    __m512 v0, v1;
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        v0 = _mm512_loadu_ps(&x[i   ]);
+        v1 = _mm512_loadu_ps(&x[i+16]);
+        sumi0 = _mm512_fmadd_ps(v0, _mm512_load_ps(&_hi[i   ]), sumi0);
+        sumi1 = _mm512_fmadd_ps(v1, _mm512_load_ps(&_hi[i+16]), sumi1);
+        sumq0 = _mm512_fmadd_ps(v0, _mm512_load_ps(&_hq[i   ]), sumq0);
+        sumq1 = _mm512_fmadd_ps(v1, _mm512_load_ps(&_hq[i+16]), sumq1);
+    }
+
+    // remaining group of 16
+    for ( ; i<t; i+=16) {
+        v0 = _mm512_loadu_ps(&x[i]);
+        sumi0 = _mm512_fmadd_ps(v0, _mm512_load_ps(&_hi[i]), sumi0);
+        sumq0 = _mm512_fmadd_ps(v0, _mm512_load_ps(&_hq[i]), sumq0);
+    }
+
+    // cleanup using masked loads; i is even so lane parity is preserved
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1U << (n - i)) - 1);
+        v0 = _mm512_maskz_loadu_ps(m, &x[i]);
+        sumi1 = _mm512_fmadd_ps(v0, _mm512_maskz_loadu_ps(m, &_hi[i]), sumi1);
+        sumq1 = _mm512_fmadd_ps(v0, _mm512_maskz_loadu_ps(m, &_hq[i]), sumq1);
+    }
+
+    // fold down
+    sumi0 = _mm512_add_ps(sumi0, sumi1);
+    sumq0 = _mm512_add_ps(sumq0, sumq1);
+
+    // swap quadrature pairs and combine: subtract in even (real) lanes,
+    // add in odd (imaginary) lanes
+    sumq0 = _mm512_permute_ps(sumq0, _MM_SHUFFLE(2,3,0,1));
+    __m512 s = _mm512_add_ps(sumi0, sumq0);
+    s = _mm512_mask_sub_ps(s, 0x5555, sumi0, sumq0);
+
+    float yi = _mm512_mask_reduce_add_ps(0x5555, s);
+    float yq = _mm512_mask_reduce_add_ps(0xaaaa, s);
+
+    // set return value
+    *_y = yi + _Complex_I*yq;
+}
+
+// fold a pair of accumulators, each holding { re, im, re, im, ... },
+// into { re(a), im(a), re(b), im(b) }
+__attribute__((target("avx2,fma")))
+static inline __m128 dotprod_cccf_fold2_avx2(__m256 _a, __m256 _b)
+{
+    __m128 a = _mm_add_ps(_mm256_castps256_ps128(_a), _mm256_extractf128_ps(_a, 1));
+    __m128 b = _mm_add_ps(_mm256_castps256_ps128(_b), _mm256_extractf128_ps(_b, 1));
+    return _mm_add_ps(_mm_movelh_ps(a, b), _mm_movehl_ps(b, a));
+}
+
+// use AVX2/FMA extensions, four outputs at a time; each coefficient
+// vector is loaded once and applied to four consecutive inputs
+//  _hi     :   repeated real coefficients, 32-byte aligned [size: 2 x _len]
+//  _hq     :   repeated imag coefficients, 32-byte aligned [size: 2 x _len]
+//  _len    :   dot product length
+//  _x      :   input array [size: 1 x (_n + _len - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+// returns number of outputs computed (multiple of 4)
+__attribute__((target("avx2,fma")))
+unsigned int dotprod_cccf_execute_block_avx2(float *         _hi,
+                                             float *         _hq,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y)
+{
+    // double effective length, t = 8*floor(n/8)
+    unsigned int n = 2*_len;
+    unsigned int t = (n >> 3) << 3;
+
+    // mask for remaining coefficients (masked loads do not fault)
+    __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - t)),
+                                   _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+
+    unsigned int i, k;
+    for (k=0; k+4<=_n; k+=4) {
+        // type cast input as floating point array
+        float * x = (float*) &_x[k];
+
+        // accumulators (v * hi, v * hq) for each output
+        __m256 si0 = _mm256_setzero_ps(), sq0 = _mm256_setzero_ps();
+        __m256 si1 = _mm256_setzero_ps(), sq1 = _mm256_setzero_ps();
+        __m256 si2 = _mm256_setzero_ps(), sq2 = _mm256_setzero_ps();
+        __m256 si3 = _mm256_setzero_ps(), sq3 = _mm256_setzero_ps();
+        __m256 hi, hq, v;
+        for (i=0; i<t; i+=8) {
+            hi = _mm256_load_ps(&_hi[i]);
+            hq = _mm256_load_ps(&_hq[i]);
+            v   = _mm256_loadu_ps(&x[i  ]);
+            si0 = _mm256_fmadd_ps(v, hi, si0);
+            sq0 = _mm256_fmadd_ps(v, hq, sq0);
+            v   = _mm256_loadu_ps(&x[i+2]);
+            si1 = _mm256_fmadd_ps(v, hi, si1);
+            sq1 = _mm256_fmadd_ps(v, hq, sq1);
+            v   = _mm256_loadu_ps(&x[i+4]);
+            si2 = _mm256_fmadd_ps(v, hi, si2);
+            sq2 = _mm256_fmadd_ps(v, hq, sq2);
+            v   = _mm256_loadu_ps(&x[i+6]);
+            si3 = _mm256_fmadd_ps(v, hi, si3);
+            sq3 = _mm256_fmadd_ps(v, hq, sq3);
+        }
+
+        // remaining coefficients
+        if (t < n) {
+            hi = _mm256_maskload_ps(&_hi[t], m);
+            hq = _mm256_maskload_ps(&_hq[t], m);
+            v   = _mm256_maskload_ps(&x[t  ], m);
+            si0 = _mm256_fmadd_ps(v, hi, si0);
+            sq0 = _mm256_fmadd_ps(v, hq, sq0);
+            v   = _mm256_maskload_ps(&x[t+2], m);
+            si1 = _mm256_fmadd_ps(v, hi, si1);
+            sq1 = _mm256_fmadd_ps(v, hq, sq1);
+            v   = _mm256_maskload_ps(&x[t+4], m);
+            si2 = _mm256_fmadd_ps(v, hi, si2);
+            sq2 = _mm256_fmadd_ps(v, hq, sq2);
+            v   = _mm256_maskload_ps(&x[t+6], m);
+            si3 = _mm256_fmadd_ps(v, hi, si3);
+            sq3 = _mm256_fmadd_ps(v, hq, sq3);
+        }
+
+        // swap quadrature pairs and combine: { re, im, re, im, ... }
+        si0 = _mm256_addsub_ps(si0, _mm256_permute_ps(sq0, _MM_SHUFFLE(2,3,0,1)));
+        si1 = _mm256_addsub_ps(si1, _mm256_permute_ps(sq1, _MM_SHUFFLE(2,3,0,1)));
+        si2 = _mm256_addsub_ps(si2, _mm256_permute_ps(sq2, _MM_SHUFFLE(2,3,0,1)));
+        si3 = _mm256_addsub_ps(si3, _mm256_permute_ps(sq3, _MM_SHUFFLE(2,3,0,1)));
+
+        // fold down and store pairs of outputs
+        float * y = (float*) &_y[k];
+        _mm_storeu_ps(&y[0], dotprod_cccf_fold2_avx2(si0, si1));
+        _mm_storeu_ps(&y[4], dotprod_cccf_fold2_avx2(si2, si3));
+    }
+
+    return k;
+}
@@ -57,6 +57,13 @@ void dotprod_cccf_execute_mmx4(dotprod_cccf    _q,
                                float complex * _x,
                                float complex * _y);
 
+unsigned int dotprod_cccf_execute_block_mmx4(float *         _hi,
+                                             float *         _hq,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y);
+
 // basic dot product (ordinal calculation)
 void dotprod_cccf_run(float complex * _h,
                       float complex * _x,
@@ -106,6 +113,7 @@ struct dotprod_cccf_s {
     unsigned int n;     // length
     float * hi;         // in-phase
     float * hq;         // quadrature
+    liquid_simd_level simd; // SIMD kernel, chosen at run time
 };
 
 dotprod_cccf dotprod_cccf_create(float complex * _h,
@@ -114,9 +122,15 @@ dotprod_cccf dotprod_cccf_create(float complex * _h,
     dotprod_cccf q = (dotprod_cccf)malloc(sizeof(struct dotprod_cccf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
-    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // allocate memory for coefficients, 64-byte aligned (AVX-512)
+    q->hi = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
+    q->hq = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
+
+    // select kernel from processor features detected at run time; the
+    // wider AVX-512 kernel only pays off for long dot products
+    q->simd = liquid_cpu_get_simd_level();
+    if (q->simd == LIQUID_SIMD_AVX512 && q->n < 128)
+        q->simd = LIQUID_SIMD_AVX2;
 
     // set coefficients, repeated
     //  hi = { crealf(_h[0]), crealf(_h[0]), ... crealf(_h[n-1]), crealf(_h[n-1])}
@@ -154,7 +168,10 @@ void dotprod_cccf_destroy(dotprod_cccf _q)
 
 void dotprod_cccf_print(dotprod_cccf _q)
 {
-    printf("dotprod_cccf [mmx, %u coefficients]\n", _q->n);
+    printf("dotprod_cccf [%s, %u coefficients]\n",
+            _q->simd == LIQUID_SIMD_AVX512 ? "avx512" :
+            _q->simd == LIQUID_SIMD_AVX2   ? "avx2"   : "mmx",
+            _q->n);
     unsigned int i;
     for (i=0; i<_q->n; i++)
         printf("  %3u : %12.9f +j%12.9f\n", i, _q->hi[i], _q->hq[i]);
@@ -168,6 +185,15 @@ void dotprod_cccf_execute(dotprod_cccf    _q,
                           float complex * _x,
                           float complex * _y)
 {
+    // wide kernels selected at run time
+    if (_q->simd == LIQUID_SIMD_AVX512) {
+        dotprod_cccf_execute_avx512(_q->hi, _q->hq, _x, _q->n, _y);
+        return;
+    } else if (_q->simd == LIQUID_SIMD_AVX2) {
+        dotprod_cccf_execute_avx2(_q->hi, _q->hq, _x, _q->n, _y);
+        return;
+    }
+
     // switch based on size
     if (_q->n < 32) {
         dotprod_cccf_execute_mmx(_q, _x, _y);
@@ -176,6 +202,30 @@ void dotprod_cccf_execute(dotprod_cccf    _q,
     }
 }
 
+// execute structured dot product over sliding input; outputs are
+// computed in groups so each coefficient vector is loaded once per
+// group rather than once per output
+//  _q      :   dot product object
+//  _x      :   input array [size: 1 x (_n + q->n - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+void dotprod_cccf_execute_block(dotprod_cccf    _q,
+                                float complex * _x,
+                                unsigned int    _n,
+                                float complex * _y)
+{
+    // wide kernels selected at run time
+    unsigned int i;
+    if (_q->simd >= LIQUID_SIMD_AVX2)
+        i = dotprod_cccf_execute_block_avx2(_q->hi, _q->hq, _q->n, _x, _n, _y);
+    else
+        i = dotprod_cccf_execute_block_mmx4(_q->hi, _q->hq, _q->n, _x, _n, _y);
+
+    // remaining outputs
+    for ( ; i<_n; i++)
+        dotprod_cccf_execute(_q, &_x[i], &_y[i]);
+}
+
 // use MMX/SSE extensions
 //
 // (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
@@ -377,3 +427,78 @@ void dotprod_cccf_execute_mmx4(dotprod_cccf    _q,
     *_y = total;
 }
 
+// use MMX/SSE extensions, four outputs at a time
+//  _hi     :   repeated real coefficients, 16-byte aligned [size: 2 x _len]
+//  _hq     :   repeated imag coefficients, 16-byte aligned [size: 2 x _len]
+//  _len    :   dot product length
+//  _x      :   input array [size: 1 x (_n + _len - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+// returns number of outputs computed (multiple of 4)
+unsigned int dotprod_cccf_execute_block_mmx4(float *         _hi,
+                                             float *         _hq,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y)
+{
+    // double effective length, t = 4*(floor(2*_len/4))
+    unsigned int n = 2*_len;
+    unsigned int t = (n >> 2) << 2;
+
+    // negate real part: { -0, 0, -0, 0 }
+    const __m128 neg = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+
+    unsigned int i, k;
+    for (k=0; k+4<=_n; k+=4) {
+        // type cast input as floating point array
+        float * x = (float*) &_x[k];
+
+        // accumulators (v * hi, v * hq) for each output
+        __m128 si0 = _mm_setzero_ps(), sq0 = _mm_setzero_ps();
+        __m128 si1 = _mm_setzero_ps(), sq1 = _mm_setzero_ps();
+        __m128 si2 = _mm_setzero_ps(), sq2 = _mm_setzero_ps();
+        __m128 si3 = _mm_setzero_ps(), sq3 = _mm_setzero_ps();
+        __m128 v;
+        for (i=0; i<t; i+=4) {
+            __m128 hi = _mm_load_ps(&_hi[i]);
+            __m128 hq = _mm_load_ps(&_hq[i]);
+            v = _mm_loadu_ps(&x[i  ]);
+            si0 = _mm_add_ps(si0, _mm_mul_ps(v, hi));
+            sq0 = _mm_add_ps(sq0, _mm_mul_ps(v, hq));
+            v = _mm_loadu_ps(&x[i+2]);
+            si1 = _mm_add_ps(si1, _mm_mul_ps(v, hi));
+            sq1 = _mm_add_ps(sq1, _mm_mul_ps(v, hq));
+            v = _mm_loadu_ps(&x[i+4]);
+            si2 = _mm_add_ps(si2, _mm_mul_ps(v, hi));
+            sq2 = _mm_add_ps(sq2, _mm_mul_ps(v, hq));
+            v = _mm_loadu_ps(&x[i+6]);
+            si3 = _mm_add_ps(si3, _mm_mul_ps(v, hi));
+            sq3 = _mm_add_ps(sq3, _mm_mul_ps(v, hq));
+        }
+
+        // swap quadrature pairs and combine: { re, im, re, im }
+        si0 = _mm_add_ps(si0, _mm_xor_ps(_mm_shuffle_ps(sq0, sq0, _MM_SHUFFLE(2,3,0,1)), neg));
+        si1 = _mm_add_ps(si1, _mm_xor_ps(_mm_shuffle_ps(sq1, sq1, _MM_SHUFFLE(2,3,0,1)), neg));
+        si2 = _mm_add_ps(si2, _mm_xor_ps(_mm_shuffle_ps(sq2, sq2, _MM_SHUFFLE(2,3,0,1)), neg));
+        si3 = _mm_add_ps(si3, _mm_xor_ps(_mm_shuffle_ps(sq3, sq3, _MM_SHUFFLE(2,3,0,1)), neg));
+
+        // fold down pairs of outputs: { re(0), im(0), re(1), im(1) }
+        si0 = _mm_add_ps(_mm_movelh_ps(si0, si1), _mm_movehl_ps(si1, si0));
+        si2 = _mm_add_ps(_mm_movelh_ps(si2, si3), _mm_movehl_ps(si3, si2));
+        _mm_storeu_ps((float*)&_y[k  ], si0);
+        _mm_storeu_ps((float*)&_y[k+2], si2);
+
+        // cleanup (at most one coefficient)
+        for (i=t/2; i<_len; i++) {
+            float complex h = _hi[2*i] + _hq[2*i]*_Complex_I;
+            _y[k  ] += h * _x[k+i  ];
+            _y[k+1] += h * _x[k+i+1];
+            _y[k+2] += h * _x[k+i+2];
+            _y[k+3] += h * _x[k+i+3];
+        }
+    }
+
+    return k;
+}
+
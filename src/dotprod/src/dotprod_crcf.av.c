@@ -204,3 +204,18 @@ void dotprod_crcf_execute(dotprod_crcf    _q,
     *_r = (s.w[0] + s.w[2]) + (s.w[1] + s.w[3]) * _Complex_I;
 }
 
+
+// execute structured dot product over sliding input
+//  _q      :   dot product object
+//  _x      :   input array [size: 1 x (_n + q->n - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+void dotprod_crcf_execute_block(dotprod_crcf    _q,
+                                float complex * _x,
+                                unsigned int    _n,
+                                float complex * _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        dotprod_crcf_execute(_q, &_x[i], &_y[i]);
+}
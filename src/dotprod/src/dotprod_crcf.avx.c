@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// 
+// Floating-point dot product, complex input, real coefficients
+// (AVX2/FMA, AVX-512)
+//
+// The input is treated as an interleaved array of 2*_n floats against
+// repeated coefficients, so even lanes accumulate the in-phase and odd
+// lanes the quadrature component.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>
+
+// use AVX2/FMA extensions
+//  _h      :   repeated coefficients, 32-byte aligned [size: 2 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   dot product length
+//  _y      :   output dot product
+__attribute__((target("avx2,fma")))
+void dotprod_crcf_execute_avx2(float *         _h,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 32*floor(n/32), t = 8*floor(n/8)
+    unsigned int r = (n >> 5) << 5;
+    unsigned int t = (n >> 3) << 3;
+
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i   ]), _mm256_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 8]), _mm256_load_ps(&_h[i+ 8]), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+16]), _mm256_load_ps(&_h[i+16]), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+24]), _mm256_load_ps(&_h[i+24]), sum3);
+    }
+
+    // remaining groups of 8
+    for ( ; i<t; i+=8)
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i]), _mm256_load_ps(&_h[i]), sum0);
+
+    // fold down
+    sum0 = _mm256_add_ps(sum0, sum1);
+    sum2 = _mm256_add_ps(sum2, sum3);
+    sum0 = _mm256_add_ps(sum0, sum2);
+
+    // { re, im, re, im } -> { re, im, x, x }
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum0),
+                          _mm256_extractf128_ps(sum0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+
+    // aligned output array
+    float w[4] __attribute__((aligned(16)));
+    _mm_store_ps(w, s);
+
+    // cleanup (note: n _must_ be even)
+    for ( ; i<n; i+=2) {
+        w[0] += x[i  ] * _h[i  ];
+        w[1] += x[i+1] * _h[i+1];
+    }
+
+    // set return value
+    *_y = w[0] + _Complex_I*w[1];
+}
+
+// use AVX-512 extensions
+//  _h      :   repeated coefficients, 64-byte aligned [size: 2 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   dot product length
+//  _y      :   output dot product
+__attribute__((target("avx512f")))
+void dotprod_crcf_execute_avx512(float *         _h,
+                                 float complex * _x,
+                                 unsigned int    _n,
+                                 float complex * _y)
+{
+    // type cast input as floating point array
+    float * x = (float*) _x;
+
+    // double effective length
+    unsigned int n = 2*_n;
+
+    // load zeros into sum registers
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    __m512 sum3 = _mm512_setzero_ps();
+
+    // r = 64*floor(n/64), t = 16*floor(n/16)
+    unsigned int r = (n >> 6) << 6;
+    unsigned int t = (n >> 4) << 4;
+
+    unsigned int i;
+    for (i=0; i<r; i+=64) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i   ]), _mm512_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+16]), _mm512_load_ps(&_h[i+16]), sum1);
+        sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+32]), _mm512_load_ps(&_h[i+32]), sum2);
+        sum3 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i+48]), _mm512_load_ps(&_h[i+48]), sum3);
+    }
+
+    // remaining groups of 16
+    for ( ; i<t; i+=16)
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&x[i]), _mm512_load_ps(&_h[i]), sum0);
+
+    // cleanup using masked loads; i is even so lane parity is preserved
+    if (i < n) {
+        __mmask16 m = (__mmask16)((1U << (n - i)) - 1);
+        sum1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &x[i]),
+                               _mm512_maskz_loadu_ps(m, &_h[i]), sum1);
+    }
+
+    // fold down
+    sum0 = _mm512_add_ps(sum0, sum1);
+    sum2 = _mm512_add_ps(sum2, sum3);
+    sum0 = _mm512_add_ps(sum0, sum2);
+
+    // sum even (in-phase) and odd (quadrature) lanes separately
+    float yi = _mm512_mask_reduce_add_ps(0x5555, sum0);
+    float yq = _mm512_mask_reduce_add_ps(0xaaaa, sum0);
+
+    // set return value
+    *_y = yi + _Complex_I*yq;
+}
+
+// fold a pair of accumulators, each holding { re, im, re, im, ... },
+// into { re(a), im(a), re(b), im(b) }
+__attribute__((target("avx2,fma")))
+static inline __m128 dotprod_crcf_fold2_avx2(__m256 _a, __m256 _b)
+{
+    __m128 a = _mm_add_ps(_mm256_castps256_ps128(_a), _mm256_extractf128_ps(_a, 1));
+    __m128 b = _mm_add_ps(_mm256_castps256_ps128(_b), _mm256_extractf128_ps(_b, 1));
+    return _mm_add_ps(_mm_movelh_ps(a, b), _mm_movehl_ps(b, a));
+}
+
+// use AVX2/FMA extensions, eight outputs at a time; each coefficient
+// vector is loaded once and applied to eight consecutive inputs
+//  _h      :   repeated coefficients, 32-byte aligned [size: 2 x _len]
+//  _len    :   dot product length
+//  _x      :   input array [size: 1 x (_n + _len - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+// returns number of outputs computed (multiple of 8)
+__attribute__((target("avx2,fma")))
+unsigned int dotprod_crcf_execute_block_avx2(float *         _h,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y)
+{
+    // double effective length, t = 8*floor(n/8)
+    unsigned int n = 2*_len;
+    unsigned int t = (n >> 3) << 3;
+
+    // mask for remaining coefficients (masked loads do not fault)
+    __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - t)),
+                                   _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+
+    unsigned int i, k;
+    for (k=0; k+8<=_n; k+=8) {
+        // type cast input as floating point array
+        float * x = (float*) &_x[k];
+
+        // one accumulator for each output
+        __m256 s0 = _mm256_setzero_ps();
+        __m256 s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps();
+        __m256 s3 = _mm256_setzero_ps();
+        __m256 s4 = _mm256_setzero_ps();
+        __m256 s5 = _mm256_setzero_ps();
+        __m256 s6 = _mm256_setzero_ps();
+        __m256 s7 = _mm256_setzero_ps();
+        __m256 h;
+        for (i=0; i<t; i+=8) {
+            h  = _mm256_load_ps(&_h[i]);
+            s0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i   ]), h, s0);
+            s1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 2]), h, s1);
+            s2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 4]), h, s2);
+            s3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 6]), h, s3);
+            s4 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+ 8]), h, s4);
+            s5 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+10]), h, s5);
+            s6 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+12]), h, s6);
+            s7 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+14]), h, s7);
+        }
+
+        // remaining coefficients
+        if (t < n) {
+            h  = _mm256_maskload_ps(&_h[t], m);
+            s0 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t   ], m), h, s0);
+            s1 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+ 2], m), h, s1);
+            s2 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+ 4], m), h, s2);
+            s3 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+ 6], m), h, s3);
+            s4 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+ 8], m), h, s4);
+            s5 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+10], m), h, s5);
+            s6 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+12], m), h, s6);
+            s7 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+14], m), h, s7);
+        }
+
+        // fold down and store pairs of outputs
+        float * y = (float*) &_y[k];
+        _mm_storeu_ps(&y[ 0], dotprod_crcf_fold2_avx2(s0, s1));
+        _mm_storeu_ps(&y[ 4], dotprod_crcf_fold2_avx2(s2, s3));
+        _mm_storeu_ps(&y[ 8], dotprod_crcf_fold2_avx2(s4, s5));
+        _mm_storeu_ps(&y[12], dotprod_crcf_fold2_avx2(s6, s7));
+    }
+
+    return k;
+}
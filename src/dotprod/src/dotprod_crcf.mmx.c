@@ -38,6 +38,11 @@ void dotprod_crcf_execute_mmx(dotprod_crcf    _q,
 void dotprod_crcf_execute_mmx4(dotprod_crcf    _q,
                                float complex * _x,
                                float complex * _y);
+unsigned int dotprod_crcf_execute_block_mmx4(float *         _h,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y);
 
 // basic dot product (ordinal calculation)
 void dotprod_crcf_run(float *         _h,
@@ -87,6 +92,7 @@ void dotprod_crcf_run4(float *         _h,
 struct dotprod_crcf_s {
     unsigned int n;     // length
     float * h;          // coefficients array
+    liquid_simd_level simd; // SIMD kernel, chosen at run time
 };
 
 dotprod_crcf dotprod_crcf_create(float *      _h,
@@ -95,8 +101,14 @@ dotprod_crcf dotprod_crcf_create(float *      _h,
     dotprod_crcf q = (dotprod_crcf)malloc(sizeof(struct dotprod_crcf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( 2*q->n*sizeof(float), 16 );
+    // allocate memory for coefficients, 64-byte aligned (AVX-512)
+    q->h = (float*) _mm_malloc( 2*q->n*sizeof(float), 64 );
+
+    // select kernel from processor features detected at run time; the
+    // wider AVX-512 kernel only pays off for long dot products
+    q->simd = liquid_cpu_get_simd_level();
+    if (q->simd == LIQUID_SIMD_AVX512 && q->n < 128)
+        q->simd = LIQUID_SIMD_AVX2;
 
     // set coefficients, repeated
     //  h = { _h[0], _h[0], _h[1], _h[1], ... _h[n-1], _h[n-1]}
@@ -131,7 +143,10 @@ void dotprod_crcf_print(dotprod_crcf _q)
 {
     // print coefficients to screen, skipping odd entries (due
     // to repeated coefficients)
-    printf("dotprod_crcf [mmx, %u coefficients]\n", _q->n);
+    printf("dotprod_crcf [%s, %u coefficients]\n",
+            _q->simd == LIQUID_SIMD_AVX512 ? "avx512" :
+            _q->simd == LIQUID_SIMD_AVX2   ? "avx2"   : "mmx",
+            _q->n);
     unsigned int i;
     for (i=0; i<_q->n; i++)
         printf("  %3u : %12.9f\n", i, _q->h[2*i]);
@@ -142,6 +157,15 @@ void dotprod_crcf_execute(dotprod_crcf    _q,
                           float complex * _x,
                           float complex * _y)
 {
+    // wide kernels selected at run time
+    if (_q->simd == LIQUID_SIMD_AVX512) {
+        dotprod_crcf_execute_avx512(_q->h, _x, _q->n, _y);
+        return;
+    } else if (_q->simd == LIQUID_SIMD_AVX2) {
+        dotprod_crcf_execute_avx2(_q->h, _x, _q->n, _y);
+        return;
+    }
+
     // switch based on size
     if (_q->n < 32) {
         dotprod_crcf_execute_mmx(_q, _x, _y);
@@ -150,6 +174,30 @@ void dotprod_crcf_execute(dotprod_crcf    _q,
     }
 }
 
+// execute structured dot product over sliding input; outputs are
+// computed in groups so each coefficient vector is loaded once per
+// group rather than once per output
+//  _q      :   dot product object
+//  _x      :   input array [size: 1 x (_n + q->n - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+void dotprod_crcf_execute_block(dotprod_crcf    _q,
+                                float complex * _x,
+                                unsigned int    _n,
+                                float complex * _y)
+{
+    // wide kernels selected at run time
+    unsigned int i;
+    if (_q->simd >= LIQUID_SIMD_AVX2)
+        i = dotprod_crcf_execute_block_avx2(_q->h, _q->n, _x, _n, _y);
+    else
+        i = dotprod_crcf_execute_block_mmx4(_q->h, _q->n, _x, _n, _y);
+
+    // remaining outputs
+    for ( ; i<_n; i++)
+        dotprod_crcf_execute(_q, &_x[i], &_y[i]);
+}
+
 // use MMX/SSE extensions
 void dotprod_crcf_execute_mmx(dotprod_crcf    _q,
                               float complex * _x,
@@ -282,3 +330,56 @@ void dotprod_crcf_execute_mmx4(dotprod_crcf    _q,
     *_y = w[0] + w[1]*_Complex_I;
 }
 
+// use MMX/SSE extensions, four outputs at a time
+//  _h      :   repeated coefficients, 16-byte aligned [size: 2 x _len]
+//  _len    :   dot product length
+//  _x      :   input array [size: 1 x (_n + _len - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+// returns number of outputs computed (multiple of 4)
+unsigned int dotprod_crcf_execute_block_mmx4(float *         _h,
+                                             unsigned int    _len,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y)
+{
+    // double effective length, t = 4*(floor(2*_len/4))
+    unsigned int n = 2*_len;
+    unsigned int t = (n >> 2) << 2;
+
+    unsigned int i, k;
+    for (k=0; k+4<=_n; k+=4) {
+        // type cast input as floating point array
+        float * x = (float*) &_x[k];
+
+        // one accumulator for each output
+        __m128 s0 = _mm_setzero_ps();
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 s3 = _mm_setzero_ps();
+        for (i=0; i<t; i+=4) {
+            __m128 h = _mm_load_ps(&_h[i]);
+            s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(&x[i  ]), h));
+            s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(&x[i+2]), h));
+            s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_loadu_ps(&x[i+4]), h));
+            s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_loadu_ps(&x[i+6]), h));
+        }
+
+        // fold down pairs of outputs: { re(0), im(0), re(1), im(1) }
+        s0 = _mm_add_ps(_mm_movelh_ps(s0, s1), _mm_movehl_ps(s1, s0));
+        s2 = _mm_add_ps(_mm_movelh_ps(s2, s3), _mm_movehl_ps(s3, s2));
+        _mm_storeu_ps((float*)&_y[k  ], s0);
+        _mm_storeu_ps((float*)&_y[k+2], s2);
+
+        // cleanup (at most one coefficient)
+        for (i=t/2; i<_len; i++) {
+            _y[k  ] += _h[2*i] * _x[k+i  ];
+            _y[k+1] += _h[2*i] * _x[k+i+1];
+            _y[k+2] += _h[2*i] * _x[k+i+2];
+            _y[k+3] += _h[2*i] * _x[k+i+3];
+        }
+    }
+
+    return k;
+}
+
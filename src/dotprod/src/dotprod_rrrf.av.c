@@ -197,3 +197,18 @@ void dotprod_rrrf_execute(dotprod_rrrf _q,
     *_r = s.w[0] + s.w[1] + s.w[2] + s.w[3];
 }
 
+
+// execute structured dot product over sliding input
+//  _q      :   dot product object
+//  _x      :   input array [size: 1 x (_n + q->n - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+void dotprod_rrrf_execute_block(dotprod_rrrf _q,
+                                float *      _x,
+                                unsigned int _n,
+                                float *      _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        dotprod_rrrf_execute(_q, &_x[i], &_y[i]);
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// 
+// Floating-point dot product (AVX2/FMA, AVX-512)
+//
+// Kernels are compiled with function-level target attributes so that
+// the library itself does not require these extensions; they are only
+// invoked when liquid_cpu_get_simd_level() reports host support.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#include <immintrin.h>
+
+// use AVX2/FMA extensions
+//  _h      :   coefficients array, 32-byte aligned [size: 1 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   dot product length
+//  _y      :   output dot product
+__attribute__((target("avx2,fma")))
+void dotprod_rrrf_execute_avx2(float *      _h,
+                               float *      _x,
+                               unsigned int _n,
+                               float *      _y)
+{
+    // load zeros into sum registers
+    __m256 sum0 = _mm256_setzero_ps();
+    __m256 sum1 = _mm256_setzero_ps();
+    __m256 sum2 = _mm256_setzero_ps();
+    __m256 sum3 = _mm256_setzero_ps();
+
+    // r = 32*floor(n/32), t = 8*floor(n/8)
+    unsigned int r = (_n >> 5) << 5;
+    unsigned int t = (_n >> 3) << 3;
+
+    // compute dotprod in groups of 32 using 4 independent accumulators
+    unsigned int i;
+    for (i=0; i<r; i+=32) {
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i   ]), _mm256_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+ 8]), _mm256_load_ps(&_h[i+ 8]), sum1);
+        sum2 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+16]), _mm256_load_ps(&_h[i+16]), sum2);
+        sum3 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i+24]), _mm256_load_ps(&_h[i+24]), sum3);
+    }
+
+    // remaining groups of 8
+    for ( ; i<t; i+=8)
+        sum0 = _mm256_fmadd_ps(_mm256_loadu_ps(&_x[i]), _mm256_load_ps(&_h[i]), sum0);
+
+    // fold down
+    sum0 = _mm256_add_ps(sum0, sum1);
+    sum2 = _mm256_add_ps(sum2, sum3);
+    sum0 = _mm256_add_ps(sum0, sum2);
+
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(sum0),
+                          _mm256_extractf128_ps(sum0, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1,1,1,1)));
+    float total = _mm_cvtss_f32(s);
+
+    // cleanup
+    for ( ; i<_n; i++)
+        total += _x[i] * _h[i];
+
+    // set return value
+    *_y = total;
+}
+
+// use AVX-512 extensions
+//  _h      :   coefficients array, 64-byte aligned [size: 1 x _n]
+//  _x      :   input array [size: 1 x _n]
+//  _n      :   dot product length
+//  _y      :   output dot product
+__attribute__((target("avx512f")))
+void dotprod_rrrf_execute_avx512(float *      _h,
+                                 float *      _x,
+                                 unsigned int _n,
+                                 float *      _y)
+{
+    // load zeros into sum registers
+    __m512 sum0 = _mm512_setzero_ps();
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    __m512 sum3 = _mm512_setzero_ps();
+
+    // r = 64*floor(n/64), t = 16*floor(n/16)
+    unsigned int r = (_n >> 6) << 6;
+    unsigned int t = (_n >> 4) << 4;
+
+    // compute dotprod in groups of 64 using 4 independent accumulators
+    unsigned int i;
+    for (i=0; i<r; i+=64) {
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i   ]), _mm512_load_ps(&_h[i   ]), sum0);
+        sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i+16]), _mm512_load_ps(&_h[i+16]), sum1);
+        sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i+32]), _mm512_load_ps(&_h[i+32]), sum2);
+        sum3 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i+48]), _mm512_load_ps(&_h[i+48]), sum3);
+    }
+
+    // remaining groups of 16
+    for ( ; i<t; i+=16)
+        sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(&_x[i]), _mm512_load_ps(&_h[i]), sum0);
+
+    // cleanup using masked loads (no scalar loop)
+    if (i < _n) {
+        __mmask16 m = (__mmask16)((1U << (_n - i)) - 1);
+        sum1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, &_x[i]),
+                               _mm512_maskz_loadu_ps(m, &_h[i]), sum1);
+    }
+
+    // fold down
+    sum0 = _mm512_add_ps(sum0, sum1);
+    sum2 = _mm512_add_ps(sum2, sum3);
+    sum0 = _mm512_add_ps(sum0, sum2);
+
+    // set return value
+    *_y = _mm512_reduce_add_ps(sum0);
+}
+
+// use AVX2/FMA extensions, eight outputs at a time; each coefficient
+// vector is loaded once and applied to eight consecutive inputs
+//  _h      :   coefficients array, 32-byte aligned [size: 1 x _len]
+//  _len    :   dot product length
+//  _x      :   input array [size: 1 x (_n + _len - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+// returns number of outputs computed (multiple of 8)
+__attribute__((target("avx2,fma")))
+unsigned int dotprod_rrrf_execute_block_avx2(float *      _h,
+                                             unsigned int _len,
+                                             float *      _x,
+                                             unsigned int _n,
+                                             float *      _y)
+{
+    // t = 8*floor(_len/8)
+    unsigned int t = (_len >> 3) << 3;
+
+    // mask for remaining coefficients (masked loads do not fault)
+    __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(_len - t)),
+                                   _mm256_setr_epi32(0,1,2,3,4,5,6,7));
+
+    unsigned int i, k;
+    for (k=0; k+8<=_n; k+=8) {
+        float * x = &_x[k];
+
+        // one accumulator for each output
+        __m256 s0 = _mm256_setzero_ps();
+        __m256 s1 = _mm256_setzero_ps();
+        __m256 s2 = _mm256_setzero_ps();
+        __m256 s3 = _mm256_setzero_ps();
+        __m256 s4 = _mm256_setzero_ps();
+        __m256 s5 = _mm256_setzero_ps();
+        __m256 s6 = _mm256_setzero_ps();
+        __m256 s7 = _mm256_setzero_ps();
+        __m256 h;
+        for (i=0; i<t; i+=8) {
+            h  = _mm256_load_ps(&_h[i]);
+            s0 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i  ]), h, s0);
+            s1 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+1]), h, s1);
+            s2 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+2]), h, s2);
+            s3 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+3]), h, s3);
+            s4 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+4]), h, s4);
+            s5 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+5]), h, s5);
+            s6 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+6]), h, s6);
+            s7 = _mm256_fmadd_ps(_mm256_loadu_ps(&x[i+7]), h, s7);
+        }
+
+        // remaining coefficients
+        if (t < _len) {
+            h  = _mm256_maskload_ps(&_h[t], m);
+            s0 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t  ], m), h, s0);
+            s1 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+1], m), h, s1);
+            s2 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+2], m), h, s2);
+            s3 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+3], m), h, s3);
+            s4 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+4], m), h, s4);
+            s5 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+5], m), h, s5);
+            s6 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+6], m), h, s6);
+            s7 = _mm256_fmadd_ps(_mm256_maskload_ps(&x[t+7], m), h, s7);
+        }
+
+        // fold down: after two horizontal adds each 128-bit lane holds
+        // partial sums { s0, s1, s2, s3 } (resp. { s4, s5, s6, s7 })
+        s0 = _mm256_hadd_ps(_mm256_hadd_ps(s0, s1), _mm256_hadd_ps(s2, s3));
+        s4 = _mm256_hadd_ps(_mm256_hadd_ps(s4, s5), _mm256_hadd_ps(s6, s7));
+        s0 = _mm256_add_ps(_mm256_permute2f128_ps(s0, s4, 0x20),
+                           _mm256_permute2f128_ps(s0, s4, 0x31));
+        _mm256_storeu_ps(&_y[k], s0);
+    }
+
+    return k;
+}
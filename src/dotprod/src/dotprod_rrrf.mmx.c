@@ -56,6 +56,11 @@ void dotprod_rrrf_execute_mmx(dotprod_rrrf _q,
 void dotprod_rrrf_execute_mmx4(dotprod_rrrf _q,
                                float *      _x,
                                float *      _y);
+unsigned int dotprod_rrrf_execute_block_mmx4(float *      _h,
+                                             unsigned int _len,
+                                             float *      _x,
+                                             unsigned int _n,
+                                             float *      _y);
 
 // basic dot product (ordinal calculation)
 void dotprod_rrrf_run(float *      _h,
@@ -105,6 +110,7 @@ void dotprod_rrrf_run4(float *      _h,
 struct dotprod_rrrf_s {
     unsigned int n;     // length
     float * h;          // coefficients array
+    liquid_simd_level simd; // SIMD kernel, chosen at run time
 };
 
 dotprod_rrrf dotprod_rrrf_create(float *      _h,
@@ -113,8 +119,14 @@ dotprod_rrrf dotprod_rrrf_create(float *      _h,
     dotprod_rrrf q = (dotprod_rrrf)malloc(sizeof(struct dotprod_rrrf_s));
     q->n = _n;
 
-    // allocate memory for coefficients, 16-byte aligned
-    q->h = (float*) _mm_malloc( q->n*sizeof(float), 16);
+    // allocate memory for coefficients, 64-byte aligned (AVX-512)
+    q->h = (float*) _mm_malloc( q->n*sizeof(float), 64);
+
+    // select kernel from processor features detected at run time; the
+    // wider AVX-512 kernel only pays off for long dot products
+    q->simd = liquid_cpu_get_simd_level();
+    if (q->simd == LIQUID_SIMD_AVX512 && q->n < 256)
+        q->simd = LIQUID_SIMD_AVX2;
 
     // set coefficients
     memmove(q->h, _h, _n*sizeof(float));
@@ -142,7 +154,10 @@ void dotprod_rrrf_destroy(dotprod_rrrf _q)
 
 void dotprod_rrrf_print(dotprod_rrrf _q)
 {
-    printf("dotprod_rrrf [mmx, %u coefficients]\n", _q->n);
+    printf("dotprod_rrrf [%s, %u coefficients]\n",
+            _q->simd == LIQUID_SIMD_AVX512 ? "avx512" :
+            _q->simd == LIQUID_SIMD_AVX2   ? "avx2"   : "mmx",
+            _q->n);
     unsigned int i;
     for (i=0; i<_q->n; i++)
         printf("%3u : %12.9f\n", i, _q->h[i]);
@@ -153,6 +168,15 @@ void dotprod_rrrf_execute(dotprod_rrrf _q,
                           float *      _x,
                           float *      _y)
 {
+    // wide kernels selected at run time
+    if (_q->simd == LIQUID_SIMD_AVX512) {
+        dotprod_rrrf_execute_avx512(_q->h, _x, _q->n, _y);
+        return;
+    } else if (_q->simd == LIQUID_SIMD_AVX2) {
+        dotprod_rrrf_execute_avx2(_q->h, _x, _q->n, _y);
+        return;
+    }
+
     // switch based on size
     if (_q->n < 16) {
         dotprod_rrrf_execute_mmx(_q, _x, _y);
@@ -161,6 +185,30 @@ void dotprod_rrrf_execute(dotprod_rrrf _q,
     }
 }
 
+// execute structured dot product over sliding input; outputs are
+// computed in groups so each coefficient vector is loaded once per
+// group rather than once per output
+//  _q      :   dot product object
+//  _x      :   input array [size: 1 x (_n + q->n - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+void dotprod_rrrf_execute_block(dotprod_rrrf _q,
+                                float *      _x,
+                                unsigned int _n,
+                                float *      _y)
+{
+    // wide kernels selected at run time
+    unsigned int i;
+    if (_q->simd >= LIQUID_SIMD_AVX2)
+        i = dotprod_rrrf_execute_block_avx2(_q->h, _q->n, _x, _n, _y);
+    else
+        i = dotprod_rrrf_execute_block_mmx4(_q->h, _q->n, _x, _n, _y);
+
+    // remaining outputs
+    for ( ; i<_n; i++)
+        dotprod_rrrf_execute(_q, &_x[i], &_y[i]);
+}
+
 // use MMX/SSE extensions
 void dotprod_rrrf_execute_mmx(dotprod_rrrf _q,
                               float *      _x,
@@ -296,3 +344,53 @@ void dotprod_rrrf_execute_mmx4(dotprod_rrrf _q,
     *_y = total;
 }
 
+// use MMX/SSE extensions, four outputs at a time
+//  _h      :   coefficients array, 16-byte aligned [size: 1 x _len]
+//  _len    :   dot product length
+//  _x      :   input array [size: 1 x (_n + _len - 1)]
+//  _n      :   number of outputs
+//  _y      :   output dot products [size: 1 x _n]
+// returns number of outputs computed (multiple of 4)
+unsigned int dotprod_rrrf_execute_block_mmx4(float *      _h,
+                                             unsigned int _len,
+                                             float *      _x,
+                                             unsigned int _n,
+                                             float *      _y)
+{
+    // t = 4*(floor(_len/4))
+    unsigned int t = (_len >> 2) << 2;
+
+    unsigned int i, k;
+    for (k=0; k+4<=_n; k+=4) {
+        float * x = &_x[k];
+
+        // one accumulator for each output
+        __m128 s0 = _mm_setzero_ps();
+        __m128 s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps();
+        __m128 s3 = _mm_setzero_ps();
+        for (i=0; i<t; i+=4) {
+            __m128 h = _mm_load_ps(&_h[i]);
+            s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(&x[i  ]), h));
+            s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(&x[i+1]), h));
+            s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_loadu_ps(&x[i+2]), h));
+            s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_loadu_ps(&x[i+3]), h));
+        }
+
+        // fold down: transpose and sum so lane j holds output j
+        _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+        s0 = _mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3));
+        _mm_storeu_ps(&_y[k], s0);
+
+        // cleanup
+        for (i=t; i<_len; i++) {
+            _y[k  ] += _h[i] * x[i  ];
+            _y[k+1] += _h[i] * x[i+1];
+            _y[k+2] += _h[i] * x[i+2];
+            _y[k+3] += _h[i] * x[i+3];
+        }
+    }
+
+    return k;
+}
+
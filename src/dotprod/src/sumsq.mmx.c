@@ -46,11 +46,28 @@
 #include <pmmintrin.h>  // SSE3
 #endif
 
-// sum squares, basic loop
+// sum squares, selecting kernel from processor features
 //  _v      :   input array [size: 1 x _n]
 //  _n      :   input length
 float liquid_sumsqf(float *      _v,
                     unsigned int _n)
+{
+    switch (liquid_cpu_get_simd_level()) {
+    case LIQUID_SIMD_AVX512:
+        // wider kernel only pays off for long inputs
+        return _n < 256 ? liquid_sumsqf_avx2(_v, _n) : liquid_sumsqf_avx512(_v, _n);
+    case LIQUID_SIMD_AVX2:
+        return liquid_sumsqf_avx2(_v, _n);
+    default:
+        return liquid_sumsqf_sse(_v, _n);
+    }
+}
+
+// sum squares, MMX/SSE extensions
+//  _v      :   input array [size: 1 x _n]
+//  _n      :   input length
+float liquid_sumsqf_sse(float *      _v,
+                        unsigned int _n)
 {
     // first cut: ...
     __m128 v;   // input vector
@@ -217,3 +217,84 @@ void autotest_dotprod_cccf_struct_vs_ordinal()
         runtest_dotprod_cccf(i);
 }
 
+
+// compare structured object to ordinal computation, restricting the
+// processor features so that each run-time selected kernel is tested
+void autotest_dotprod_cccf_struct_vs_ordinal_simd()
+{
+    unsigned int masks[3] = {
+        ~(LIQUID_CPU_AVX512F),                  // AVX2/FMA
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    unsigned int i, k;
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        for (i=1; i<=512; i++)
+            runtest_dotprod_cccf(i);
+    }
+
+    // restore processor features
+    liquid_cpu_set_mask(~0U);
+}
+
+// compare block (sliding input) execution to ordinal computation
+//  _len    :   dot product length
+//  _n      :   number of outputs
+void runtest_dotprod_cccf_block(unsigned int _len,
+                                unsigned int _n)
+{
+    float tol = 1e-4;
+    float complex h[_len];
+    float complex x[_n + _len - 1];
+    float complex y[_n];
+
+    // generate random coefficients and input
+    unsigned int i;
+    for (i=0; i<_len; i++)
+        h[i] = randnf() + randnf() * _Complex_I;
+    for (i=0; i<_n + _len - 1; i++)
+        x[i] = randnf() + randnf() * _Complex_I;
+
+    // run block execution
+    dotprod_cccf dp = dotprod_cccf_create(h,_len);
+    dotprod_cccf_execute_block(dp, x, _n, y);
+    dotprod_cccf_destroy(dp);
+
+    // compare each output to ordinal computation
+    unsigned int k;
+    for (k=0; k<_n; k++) {
+        float complex y_test;
+        dotprod_cccf_run(h, &x[k], _len, &y_test);
+        CONTEND_DELTA(crealf(y[k]), crealf(y_test), tol);
+        CONTEND_DELTA(cimagf(y[k]), cimagf(y_test), tol);
+    }
+}
+
+// block execution for each run-time selected kernel, with lengths
+// and output counts which exercise every remainder path
+void autotest_dotprod_cccf_block_simd()
+{
+    unsigned int masks[4] = {
+        ~0U,                                    // all extensions
+        ~(LIQUID_CPU_AVX512F),                  // AVX2/FMA
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+    unsigned int lengths[5] = {64, 127, 129, 255, 300};
+
+    unsigned int i, k, n;
+    for (k=0; k<4; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        for (n=1; n<=19; n++) {
+            for (i=1; i<=40; i++)
+                runtest_dotprod_cccf_block(i, n);
+            for (i=0; i<5; i++)
+                runtest_dotprod_cccf_block(lengths[i], n);
+        }
+    }
+
+    // restore processor features
+    liquid_cpu_set_mask(~0U);
+}
@@ -52,6 +52,37 @@ void autotest_sumsqf_8()    {   sumsqf_runtest( sumsqf_test_x8,  8,  sumsqf_test
 void autotest_sumsqf_15()   {   sumsqf_runtest( sumsqf_test_x15, 15, sumsqf_test_y15 ); }
 void autotest_sumsqf_16()   {   sumsqf_runtest( sumsqf_test_x16, 16, sumsqf_test_y16 ); }
 
+// compare each run-time selected kernel against ordinal computation
+void autotest_sumsqf_simd()
+{
+    float tol = 1e-4;   // error tolerance
+    unsigned int masks[3] = {
+        ~(LIQUID_CPU_AVX512F),                  // AVX2/FMA
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        ~0U,                                    // all extensions
+    };
+
+    float x[300];
+    unsigned int i, k, n;
+    for (i=0; i<300; i++)
+        x[i] = randnf();
+
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        for (n=1; n<=300; n++) {
+            // compute expected value (ordinal computation)
+            float y_test = 0.0f;
+            for (i=0; i<n; i++)
+                y_test += x[i]*x[i];
+
+            CONTEND_DELTA( liquid_sumsqf(x, n), y_test, tol*n );
+        }
+    }
+
+    // restore processor features
+    liquid_cpu_set_mask(~0U);
+}
+
 float sumsqf_test_x3[3] = {
   -0.4546496371984978f,
    0.4451201395218938f,
@@ -82,3 +82,55 @@ void benchmark_eqlms_cccf_n16   EQLMS_CCCF_TRAIN_BENCH_API(16)
 void benchmark_eqlms_cccf_n32   EQLMS_CCCF_TRAIN_BENCH_API(32)
 void benchmark_eqlms_cccf_n64   EQLMS_CCCF_TRAIN_BENCH_API(64)
 
+
+#define EQLMS_CCCF_BLOCK_BENCH_API(N)   \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ eqlms_cccf_block_bench(_start, _finish, _num_iterations, N); }
+
+// Helper function for block execution (64 symbols per call)
+void eqlms_cccf_block_bench(struct rusage *_start,
+                            struct rusage *_finish,
+                            unsigned long int *_num_iterations,
+                            unsigned int _h_len)
+{
+    // scale number of iterations as for per-sample trials
+    // log(cycles/trial) ~ 5.63 + 0.767*log(_h_len)
+    *_num_iterations *= 3200;
+    *_num_iterations /= (unsigned int) expf(5.63f + 0.767f*logf(_h_len));
+    *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
+    unsigned long int n = 64;
+    *_num_iterations = (*_num_iterations + n - 1) / n;
+
+    eqlms_cccf eq = eqlms_cccf_create(NULL,_h_len);
+    
+    unsigned long int i;
+
+    // set up arrays to 'randomize' inputs/outputs
+    float complex x[n];
+    float complex d[n];
+    float complex y[n];
+    for (i=0; i<n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        d[i] = randnf() + _Complex_I*randnf();
+    }
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        eqlms_cccf_execute_block(eq, x, n, y); // compute equalizer output
+        eqlms_cccf_step_block(eq, d, n);       // step equalizer internals
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    eqlms_cccf_destroy(eq);
+}
+
+// 
+void benchmark_eqlms_cccf_block_n4    EQLMS_CCCF_BLOCK_BENCH_API(4)
+void benchmark_eqlms_cccf_block_n8    EQLMS_CCCF_BLOCK_BENCH_API(8)
+void benchmark_eqlms_cccf_block_n16   EQLMS_CCCF_BLOCK_BENCH_API(16)
+void benchmark_eqlms_cccf_block_n32   EQLMS_CCCF_BLOCK_BENCH_API(32)
+void benchmark_eqlms_cccf_block_n64   EQLMS_CCCF_BLOCK_BENCH_API(64)
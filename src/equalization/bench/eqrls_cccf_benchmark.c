@@ -36,9 +36,9 @@ void eqrls_cccf_train_bench(struct rusage *_start,
                             unsigned int _h_len)
 {
     // scale number of iterations appropriately
-    // log(cycles/trial) ~ 5.57 + 2.74*log(_h_len)
+    // log(cycles/trial) ~ 5.05 + 1.07*log(_h_len)
     *_num_iterations *= 2400;
-    *_num_iterations /= (unsigned int) expf(5.57f + 2.64f*logf(_h_len));
+    *_num_iterations /= (unsigned int) expf(5.05f + 1.07f*logf(_h_len));
     *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
 
     eqrls_cccf eq = eqrls_cccf_create(NULL,_h_len);
@@ -82,3 +82,55 @@ void benchmark_eqrls_cccf_n16   EQRLS_CCCF_TRAIN_BENCH_API(16)
 void benchmark_eqrls_cccf_n32   EQRLS_CCCF_TRAIN_BENCH_API(32)
 void benchmark_eqrls_cccf_n64   EQRLS_CCCF_TRAIN_BENCH_API(64)
 
+
+#define EQRLS_CCCF_BLOCK_BENCH_API(N)   \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ eqrls_cccf_block_bench(_start, _finish, _num_iterations, N); }
+
+// Helper function for block execution (64 symbols per call)
+void eqrls_cccf_block_bench(struct rusage *_start,
+                            struct rusage *_finish,
+                            unsigned long int *_num_iterations,
+                            unsigned int _h_len)
+{
+    // scale number of iterations as for per-sample trials
+    // log(cycles/trial) ~ 5.05 + 1.07*log(_h_len)
+    *_num_iterations *= 2400;
+    *_num_iterations /= (unsigned int) expf(5.05f + 1.07f*logf(_h_len));
+    *_num_iterations = (*_num_iterations < 4) ? 4 : *_num_iterations;
+    unsigned long int n = 64;
+    *_num_iterations = (*_num_iterations + n - 1) / n;
+
+    eqrls_cccf eq = eqrls_cccf_create(NULL,_h_len);
+    
+    unsigned long int i;
+
+    // set up arrays to 'randomize' inputs/outputs
+    float complex x[n];
+    float complex d[n];
+    float complex y[n];
+    for (i=0; i<n; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        d[i] = randnf() + _Complex_I*randnf();
+    }
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        eqrls_cccf_execute_block(eq, x, n, y); // compute equalizer output
+        eqrls_cccf_step_block(eq, d, n);       // step equalizer internals
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    eqrls_cccf_destroy(eq);
+}
+
+// 
+void benchmark_eqrls_cccf_block_n4    EQRLS_CCCF_BLOCK_BENCH_API(4)
+void benchmark_eqrls_cccf_block_n8    EQRLS_CCCF_BLOCK_BENCH_API(8)
+void benchmark_eqrls_cccf_block_n16   EQRLS_CCCF_BLOCK_BENCH_API(16)
+void benchmark_eqrls_cccf_block_n32   EQRLS_CCCF_BLOCK_BENCH_API(32)
+void benchmark_eqrls_cccf_block_n64   EQRLS_CCCF_BLOCK_BENCH_API(64)
@@ -27,23 +27,46 @@
 
 //#define DEBUG
 
+// filters shorter than this are run one tap at a time across the
+// whole block in EQLMS(_execute_block)(), longer filters one output
+// at a time
+#define EQLMS_BLOCK_TAPS_MAX (32)
+
 struct EQLMS(_s) {
     unsigned int p;     // filter order
     float mu;           // LMS step size
 
     // internal matrices
     T * h0;             // initial coefficients
-    T * w0, * w1;       // weights [px1]
+    T * w0;             // weights [px1]
 
     unsigned int n;     // input counter
     WINDOW() buffer;    // input buffer
     wdelayf x2;         // buffer of |x|^2 values
     float x2_sum;       // sum{ |x|^2 }
+
+    // block processing
+    T * xb;             // input history and block [(p-1+nb_max) x 1]
+    T * yb;             // block outputs [nb_max x 1]
+    float * x2b;        // sum{ |x|^2 } for each block output [nb_max x 1]
+    unsigned int nb;    // number of samples in last block
+    unsigned int nb_max;// allocated block length
+
+    liquid_simd_level simd; // SIMD kernels, chosen at run time
 };
 
 // update sum{|x|^2}
 void EQLMS(_update_sumsq)(EQLMS() _eq, T _x);
 
+// compute conjugate dot product, sum{ conj(_h[i]) * _x[i] }
+void EQLMS(_dotprod)(EQLMS() _eq, T * _h, T * _x, unsigned int _n, T * _y);
+
+// scaled vector addition, _y[i] += _c * _x[i]
+void EQLMS(_axpy)(EQLMS() _eq, T * _y, T _c, T * _x, unsigned int _n);
+
+// ensure block buffers can hold _n samples
+void EQLMS(_reserve_block)(EQLMS() _eq, unsigned int _n);
+
 // create least mean-squares (LMS) equalizer object
 //  _h      :   initial coefficients [size: _p x 1], default if NULL
 //  _p      :   equalizer length (number of taps)
@@ -58,10 +81,18 @@ EQLMS() EQLMS(_create)(T *          _h,
 
     eq->h0 = (T*) malloc((eq->p)*sizeof(T));
     eq->w0 = (T*) malloc((eq->p)*sizeof(T));
-    eq->w1 = (T*) malloc((eq->p)*sizeof(T));
     eq->buffer = WINDOW(_create)(eq->p);
     eq->x2     = wdelayf_create(eq->p);
 
+    // block buffers (allocated on first use)
+    eq->xb     = NULL;
+    eq->yb     = NULL;
+    eq->x2b    = NULL;
+    eq->nb     = 0;
+    eq->nb_max = 0;
+
+    eq->simd = liquid_cpu_get_simd_level();
+
     // copy coefficients (if not NULL)
     if (_h == NULL) {
         // initial coefficients with delta at first index
@@ -152,7 +183,9 @@ void EQLMS(_destroy)(EQLMS() _eq)
 {
     free(_eq->h0);
     free(_eq->w0);
-    free(_eq->w1);
+    free(_eq->xb);
+    free(_eq->yb);
+    free(_eq->x2b);
 
     WINDOW(_destroy)(_eq->buffer);
     wdelayf_destroy(_eq->x2);
@@ -197,7 +230,9 @@ void EQLMS(_reset)(EQLMS() _eq)
 
     WINDOW(_clear)(_eq->buffer);
     wdelayf_clear(_eq->x2);
+    _eq->x2_sum = 0.0f;
     _eq->n=0;
+    _eq->nb=0;
 }
 
 // push sample into equalizer internal buffer
@@ -219,20 +254,11 @@ void EQLMS(_push)(EQLMS() _eq,
 void EQLMS(_execute)(EQLMS() _eq,
                      T * _y)
 {
-    T y = 0;    // temporary accumulator
     T * r;      // read buffer
     WINDOW(_read)(_eq->buffer, &r);
 
     // compute conjugate vector dot product
-    //DOTPROD(_run)(_eq->w0, r, _eq->p, &y);
-    unsigned int i;
-    for (i=0; i<_eq->p; i++) {
-        T sum = conj(_eq->w0[i])*r[i];
-        y += sum;
-    }
-
-    // set output
-    *_y = y;
+    EQLMS(_dotprod)(_eq, _eq->w0, r, _eq->p, _y);
 }
 
 // step through one cycle of equalizer training
@@ -243,9 +269,6 @@ void EQLMS(_step)(EQLMS() _eq,
                   T _d,
                   T _d_hat)
 {
-    unsigned int i;
-    unsigned int p=_eq->p;
-
     // compute error (a priori)
     T alpha = _d - _d_hat;
 
@@ -255,24 +278,104 @@ void EQLMS(_step)(EQLMS() _eq,
 
     // update weighting vector
     // w[n+1] = w[n] + mu*conj(d-d_hat)*x[n]/(x[n]' * conj(x[n]))
-    for (i=0; i<p; i++)
-        _eq->w1[i] = _eq->w0[i] + (_eq->mu)*conj(alpha)*r[i]/_eq->x2_sum;
+    EQLMS(_axpy)(_eq, _eq->w0, (_eq->mu)*conj(alpha)/_eq->x2_sum, r, _eq->p);
 
 #ifdef DEBUG
-    printf("w0: \n");
-    for (i=0; i<p; i++) {
+    unsigned int i;
+    printf("w: \n");
+    for (i=0; i<_eq->p; i++) {
         PRINTVAL(_eq->w0[i]);
         printf("\n");
     }
-    printf("w1: \n");
-    for (i=0; i<p; i++) {
-        PRINTVAL(_eq->w1[i]);
-        printf("\n");
-    }
 #endif
+}
+
+// execute equalizer on block of samples with current weights,
+// retaining inputs and outputs for EQLMS(_step_block)()
+//  _eq     :   equalizer object
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   output samples [size: _n x 1]
+void EQLMS(_execute_block)(EQLMS()      _eq,
+                           T *          _x,
+                           unsigned int _n,
+                           T *          _y)
+{
+    unsigned int i;
+    unsigned int p = _eq->p;
+    EQLMS(_reserve_block)(_eq, _n);
+
+    // linear buffer: last p-1 samples in window followed by block
+    T * r;
+    WINDOW(_read)(_eq->buffer, &r);
+    memmove(_eq->xb,     r+1, (p-1)*sizeof(T));
+    memmove(_eq->xb+p-1, _x,  _n*sizeof(T));
+
+    // update sum{|x|^2} for each output, retaining values for step
+    float x2_0;
+    wdelayf_read(_eq->x2, &x2_0);
+    for (i=0; i<_n; i++) {
+        T x_n = _eq->xb[p-1+i];
+        float x2_n = crealf(x_n * conjf(x_n));
+        if (i > 0) {
+            T x_0 = _eq->xb[i-1];
+            x2_0 = crealf(x_0 * conjf(x_0));
+        }
+        _eq->x2_sum = _eq->x2_sum + x2_n - x2_0;
+        _eq->x2b[i] = _eq->x2_sum;
+    }
+
+    // compute outputs with current weights, y[i] = sum{ conj(w[j]) * x[i+j] };
+    // short filters are run one tap at a time across the block
+    if (p < EQLMS_BLOCK_TAPS_MAX) {
+        memset(_eq->yb, 0x00, _n*sizeof(T));
+        for (i=0; i<p; i++)
+            EQLMS(_axpy)(_eq, _eq->yb, conj(_eq->w0[i]), _eq->xb + i, _n);
+    } else {
+        for (i=0; i<_n; i++)
+            EQLMS(_dotprod)(_eq, _eq->w0, _eq->xb + i, p, &_eq->yb[i]);
+    }
+
+    // keep sample windows consistent with per-sample methods
+    unsigned int m = _n < p ? _n : p;
+    WINDOW(_write)(_eq->buffer, _eq->xb + p-1 + _n - m, m);
+    for (i=_n-m; i<_n; i++) {
+        T x_n = _eq->xb[p-1+i];
+        wdelayf_push(_eq->x2, crealf(x_n * conjf(x_n)));
+    }
+
+    memmove(_y, _eq->yb, _n*sizeof(T));
+    _eq->nb = _n;
+}
+
+// update weights once from block of desired outputs (block LMS),
+// using inputs and outputs of last call to EQLMS(_execute_block)()
+//  _eq     :   equalizer object
+//  _d      :   desired outputs [size: _n x 1]
+//  _n      :   number of samples, _n <= length of last block
+void EQLMS(_step_block)(EQLMS()      _eq,
+                        T *          _d,
+                        unsigned int _n)
+{
+    if (_n > _eq->nb) {
+        fprintf(stderr,"error: eqlms_%s_step_block(), block length exceeds that of last execute_block()\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // normalized, scaled errors (over-writing outputs)
+    //  e[i] = (mu/n) (d[i]-y[i]) / (x[i]' * conj(x[i]))
+    float g = _eq->mu / (float)_n;
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _eq->yb[i] = g * (_d[i] - _eq->yb[i]) / _eq->x2b[i];
 
-    // copy old values
-    memmove(_eq->w0, _eq->w1,   p*sizeof(T));
+    // w[j] += sum{ conj(e[i]) * x[i+j] }
+    T dw;
+    for (i=0; i<_eq->p; i++) {
+        EQLMS(_dotprod)(_eq, _eq->yb, _eq->xb + i, _n, &dw);
+        _eq->w0[i] += dw;
+    }
+    _eq->nb = 0;
 }
 
 // retrieve internal filter coefficients
@@ -330,6 +433,71 @@ void EQLMS(_train)(EQLMS() _eq,
 // internal methods
 //
 
+// compute conjugate dot product
+//  _eq     :   equalizer object
+//  _h      :   coefficients [size: _n x 1]
+//  _x      :   input vector [size: _n x 1]
+//  _n      :   vector length
+//  _y      :   output sample, sum{ conj(_h[i]) * _x[i] }
+void EQLMS(_dotprod)(EQLMS()      _eq,
+                     T *          _h,
+                     T *          _x,
+                     unsigned int _n,
+                     T *          _y)
+{
+    T y = 0;    // temporary accumulator
+    unsigned int i = 0;
+#if T_COMPLEX && LIQUID_CPU_X86
+    if (_eq->simd >= LIQUID_SIMD_AVX2)
+        i = equalizer_cccf_dotprod_conj_avx2(_h, _x, _n, &y);
+    else if (_eq->simd == LIQUID_SIMD_SSE)
+        i = equalizer_cccf_dotprod_conj_sse(_h, _x, _n, &y);
+#endif
+    for ( ; i<_n; i++) {
+        T sum = conj(_h[i])*_x[i];
+        y += sum;
+    }
+
+    // set output
+    *_y = y;
+}
+
+// scaled vector addition
+//  _eq     :   equalizer object
+//  _y      :   input/output vector [size: _n x 1]
+//  _c      :   scaling factor
+//  _x      :   input vector [size: _n x 1]
+//  _n      :   vector length
+void EQLMS(_axpy)(EQLMS()      _eq,
+                  T *          _y,
+                  T            _c,
+                  T *          _x,
+                  unsigned int _n)
+{
+    unsigned int i = 0;
+#if T_COMPLEX && LIQUID_CPU_X86
+    if (_eq->simd >= LIQUID_SIMD_AVX2)
+        i = equalizer_cccf_axpy_avx2(_y, _c, _x, _n);
+    else if (_eq->simd == LIQUID_SIMD_SSE)
+        i = equalizer_cccf_axpy_sse(_y, _c, _x, _n);
+#endif
+    for ( ; i<_n; i++)
+        _y[i] += _c*_x[i];
+}
+
+// ensure block buffers can hold _n samples
+void EQLMS(_reserve_block)(EQLMS()      _eq,
+                           unsigned int _n)
+{
+    if (_n <= _eq->nb_max)
+        return;
+
+    _eq->nb_max = _n;
+    _eq->xb  = (T*)     realloc(_eq->xb,  (_eq->p - 1 + _n)*sizeof(T));
+    _eq->yb  = (T*)     realloc(_eq->yb,  _n*sizeof(T));
+    _eq->x2b = (float*) realloc(_eq->x2b, _n*sizeof(float));
+}
+
 // update sum{|x|^2}
 void EQLMS(_update_sumsq)(EQLMS() _eq, T _x)
 {
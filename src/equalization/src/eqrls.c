@@ -20,10 +20,18 @@
 //
 // Recursive least-squares (RLS) equalizer
 //
+// The inverse QR-RLS algorithm propagates a lower-triangular square
+// root S of the recursion matrix P = S*S' with a sequence of Givens
+// rotations rather than updating P directly; this is O(p^2) per step
+// and keeps P positive definite in single precision.
+//
+//  S.Haykin, "Adaptive Filter Theory," 4th ed., section 14.7
+//
 
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include <math.h>
 
 //#define DEBUG
 
@@ -34,21 +42,36 @@ struct EQRLS(_s) {
 
     // internal matrices
     T * h0;             // initial coefficients
-    T * w0, * w1;       // weights [px1]
-    T * P0, * P1;       // recursion matrix [pxp]
-    T * g;              // gain vector [px1]
-
-    // temporary matrices
-    T * xP0;            // [1xp]
-    T zeta;             // constant
-
-    T * gxl;            // [pxp]
-    T * gxlP0;          // [pxp]
+    T * w0;             // weights [px1]
+    T * S;              // square root of recursion matrix, lower
+                        // triangular, stored by column [pxp]
+    T * g;              // (scaled) gain vector [px1]
+    T * a;              // transformed input, x.'*S/sqrt(lambda) [1xp]
 
     unsigned int n;     // input counter
     WINDOW() buffer;    // input buffer
+
+    // block processing
+    T * xb;             // input history and block [(p-1+nb_max) x 1]
+    unsigned int nb;    // number of samples in last block
+    unsigned int nb_max;// allocated block length
+
+    liquid_simd_level simd; // SIMD kernels, chosen at run time
 };
 
+// compute dot product, sum{ _h[i] * _x[i] }
+void EQRLS(_dotprod)(EQRLS() _eq, T * _h, T * _x, unsigned int _n, T * _y);
+
+// scaled vector addition, _y[i] += _c * _x[i]
+void EQRLS(_axpy)(EQRLS() _eq, T * _y, T _c, T * _x, unsigned int _n);
+
+// update weights and recursion matrix from input vector _x and
+// a priori error _alpha
+void EQRLS(_update)(EQRLS() _eq, T * _x, T _alpha);
+
+// ensure block buffer can hold _n samples
+void EQRLS(_reserve_block)(EQRLS() _eq, unsigned int _n);
+
 
 // create recursive least-squares (RLS) equalizer object
 //  _h      :   initial coefficients [size: _p x 1], default if NULL
@@ -67,17 +90,19 @@ EQRLS() EQRLS(_create)(T * _h,
     // allocate memory for matrices
     eq->h0 =    (T*) malloc((eq->p)*sizeof(T));
     eq->w0 =    (T*) malloc((eq->p)*sizeof(T));
-    eq->w1 =    (T*) malloc((eq->p)*sizeof(T));
-    eq->P0 =    (T*) malloc((eq->p)*(eq->p)*sizeof(T));
-    eq->P1 =    (T*) malloc((eq->p)*(eq->p)*sizeof(T));
+    eq->S =     (T*) malloc((eq->p)*(eq->p)*sizeof(T));
     eq->g =     (T*) malloc((eq->p)*sizeof(T));
-
-    eq->xP0 =   (T*) malloc((eq->p)*sizeof(T));
-    eq->gxl =   (T*) malloc((eq->p)*(eq->p)*sizeof(T));
-    eq->gxlP0 = (T*) malloc((eq->p)*(eq->p)*sizeof(T));
+    eq->a =     (T*) malloc((eq->p)*sizeof(T));
 
     eq->buffer = WINDOW(_create)(eq->p);
 
+    // block buffer (allocated on first use)
+    eq->xb     = NULL;
+    eq->nb     = 0;
+    eq->nb_max = 0;
+
+    eq->simd = liquid_cpu_get_simd_level();
+
     // copy coefficients (if not NULL)
     if (_h == NULL) {
         // initial coefficients with delta at first index
@@ -124,14 +149,10 @@ void EQRLS(_destroy)(EQRLS() _eq)
 {
     free(_eq->h0);
     free(_eq->w0);
-    free(_eq->w1);
-    free(_eq->P0);
-    free(_eq->P1);
+    free(_eq->S);
     free(_eq->g);
-
-    free(_eq->xP0);
-    free(_eq->gxl);
-    free(_eq->gxlP0);
+    free(_eq->a);
+    free(_eq->xb);
 
     WINDOW(_destroy)(_eq->buffer);
     free(_eq);
@@ -145,26 +166,10 @@ void EQRLS(_print)(EQRLS() _eq)
 
 #ifdef DEBUG
     unsigned int r,c,p=_eq->p;
-    printf("P0:\n");
+    printf("S:\n");
     for (r=0; r<p; r++) {
         for (c=0; c<p; c++) {
-            PRINTVAL(matrix_access(_eq->P0,p,p,r,c));
-        }
-        printf("\n");
-    }
-
-    printf("P1:\n");
-    for (r=0; r<p; r++) {
-        for (c=0; c<p; c++) {
-            PRINTVAL(matrix_access(_eq->P1,p,p,r,c));
-        }
-        printf("\n");
-    }
-
-    printf("gxl:\n");
-    for (r=0; r<p; r++) {
-        for (c=0; c<p; c++) {
-            PRINTVAL(matrix_access(_eq->gxl,p,p,r,c));
+            PRINTVAL(matrix_access(_eq->S,p,p,c,r));
         }
         printf("\n");
     }
@@ -195,11 +200,11 @@ float EQRLS(_get_bw)(EQRLS() _eq)
 void EQRLS(_reset)(EQRLS() _eq)
 {
     unsigned int i, j;
-    // initialize...
+    // initialize P = I/delta, S = I/sqrt(delta)
     for (i=0; i<_eq->p; i++) {
         for (j=0; j<_eq->p; j++) {
-            if (i==j)   _eq->P0[(_eq->p)*i + j] = 1 / (_eq->delta);
-            else        _eq->P0[(_eq->p)*i + j] = 0;
+            if (i==j)   _eq->S[(_eq->p)*i + j] = 1 / sqrtf(_eq->delta);
+            else        _eq->S[(_eq->p)*i + j] = 0;
         }
     }
 
@@ -207,6 +212,7 @@ void EQRLS(_reset)(EQRLS() _eq)
     memmove(_eq->w0, _eq->h0, (_eq->p)*sizeof(T));
 
     WINDOW(_clear)(_eq->buffer);
+    _eq->nb = 0;
 }
 
 // push sample into equalizer internal buffer
@@ -228,21 +234,17 @@ void EQRLS(_execute)(EQRLS() _eq,
     // compute vector dot product
     T * r;      // read buffer
     WINDOW(_read)(_eq->buffer, &r);
-    DOTPROD(_run)(_eq->w0, r, _eq->p, _y);
+    EQRLS(_dotprod)(_eq, _eq->w0, r, _eq->p, _y);
 }
 
 // execute cycle of equalizer, filtering output
 //  _eq     :   equalizer object
-//  _x      :   received sample
 //  _d      :   desired output
 //  _d_hat  :   filtered output
 void EQRLS(_step)(EQRLS() _eq,
                  T _d,
                  T _d_hat)
 {
-    unsigned int i,r,c;
-    unsigned int p=_eq->p;
-
     // compute error (a priori)
     T alpha = _d - _d_hat;
 
@@ -250,97 +252,72 @@ void EQRLS(_step)(EQRLS() _eq,
     T * x;
     WINDOW(_read)(_eq->buffer, &x);
 
-    // compute gain vector
-    for (c=0; c<p; c++) {
-        _eq->xP0[c] = 0;
-        for (r=0; r<p; r++) {
-            _eq->xP0[c] += x[r] * matrix_access(_eq->P0,p,p,r,c);
-        }
-    }
-
 #ifdef DEBUG
-    printf("x: ");
-    for (i=0; i<p; i++)
-        PRINTVAL(x[i]);
-    printf("\n");
-
     DEBUG_PRINTF_CFLOAT(stdout,"    d",0,_d);
     DEBUG_PRINTF_CFLOAT(stdout,"_d_hat",0,_d_hat);
     DEBUG_PRINTF_CFLOAT(stdout,"error",0,alpha);
-
-    printf("xP0: ");
-    for (c=0; c<p; c++)
-        PRINTVAL(_eq->xP0[c]);
-    printf("\n");
-#endif
-    // zeta = lambda + [x.']*[P0]*[conj(x)]
-    _eq->zeta = 0;
-    for (c=0; c<p; c++) {
-        T sum = _eq->xP0[c] * conj(x[c]);
-        _eq->zeta += sum;
-    }
-    _eq->zeta += _eq->lambda;
-#ifdef DEBUG
-    printf("zeta : ");
-    PRINTVAL(_eq->zeta);
-    printf("\n");
-#endif
-    for (r=0; r<p; r++) {
-        _eq->g[r] = 0;
-        for (c=0; c<p; c++) {
-            T sum = matrix_access(_eq->P0,p,p,r,c) * conj(x[c]);
-            _eq->g[r] += sum;
-        }
-        _eq->g[r] /= _eq->zeta;
-    }
-#ifdef DEBUG
-    printf("g: ");
-    for (i=0; i<p; i++)
-        PRINTVAL(_eq->g[i]);
-        //printf("%6.3f ", _eq->g[i]);
-    printf("\n");
 #endif
 
-    // update recursion matrix
-    for (r=0; r<p; r++) {
-        for (c=0; c<p; c++) {
-            // gxl = [g] * [x.'] / lambda
-            matrix_access(_eq->gxl,p,p,r,c) = _eq->g[r] * x[c] / _eq->lambda;
-        }
-    }
-    // multiply two [pxp] matrices: gxlP0 = gxl * P0
-    MATRIX(_mul)(_eq->gxl,  p,p,
-                 _eq->P0,   p,p,
-                 _eq->gxlP0,p,p);
+    EQRLS(_update)(_eq, x, alpha);
+}
 
-    for (i=0; i<p*p; i++)
-        _eq->P1[i] = _eq->P0[i] / _eq->lambda - _eq->gxlP0[i];
+// execute equalizer on block of samples with current weights,
+// retaining inputs for EQRLS(_step_block)()
+//  _eq     :   equalizer object
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   output samples [size: _n x 1]
+void EQRLS(_execute_block)(EQRLS()      _eq,
+                           T *          _x,
+                           unsigned int _n,
+                           T *          _y)
+{
+    unsigned int p = _eq->p;
+    EQRLS(_reserve_block)(_eq, _n);
 
-    // update weighting vector
-    for (i=0; i<p; i++)
-        _eq->w1[i] = _eq->w0[i] + alpha*(_eq->g[i]);
+    // linear buffer: last p-1 samples in window followed by block
+    T * r;
+    WINDOW(_read)(_eq->buffer, &r);
+    memmove(_eq->xb,     r+1, (p-1)*sizeof(T));
+    memmove(_eq->xb+p-1, _x,  _n*sizeof(T));
 
-#ifdef DEBUG
-    printf("w0: \n");
-    for (i=0; i<p; i++) {
-        PRINTVAL(_eq->w0[i]);
-        printf("\n");
-    }
-    printf("w1: \n");
-    for (i=0; i<p; i++) {
-        PRINTVAL(_eq->w1[i]);
-        printf("\n");
-    EQRLS(_print)(_eq);
-    }
-    //if (_eq->n == 7)
-    //    exit(0);
+    // keep sample window consistent with per-sample methods
+    unsigned int m = _n < p ? _n : p;
+    WINDOW(_write)(_eq->buffer, _eq->xb + p-1 + _n - m, m);
 
-#endif
+    // compute outputs with current weights, one tap at a time across
+    // the block: y[i] = sum{ w[j] * x[i+j] }
+    unsigned int i;
+    memset(_y, 0x00, _n*sizeof(T));
+    for (i=0; i<p; i++)
+        EQRLS(_axpy)(_eq, _y, _eq->w0[i], _eq->xb + i, _n);
 
-    // copy old values
-    memmove(_eq->w0, _eq->w1,   p*sizeof(T));
-    memmove(_eq->P0, _eq->P1, p*p*sizeof(T));
+    _eq->nb = _n;
+}
 
+// step through training cycle for block of desired outputs, using
+// inputs of last call to EQRLS(_execute_block)(); the weights are
+// updated after every sample, with the a priori output re-computed
+// from the updated weights
+//  _eq     :   equalizer object
+//  _d      :   desired outputs [size: _n x 1]
+//  _n      :   number of samples, _n <= length of last block
+void EQRLS(_step_block)(EQRLS()      _eq,
+                        T *          _d,
+                        unsigned int _n)
+{
+    if (_n > _eq->nb) {
+        fprintf(stderr,"error: eqrls_%s_step_block(), block length exceeds that of last execute_block()\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    unsigned int i;
+    T d_hat;
+    for (i=0; i<_n; i++) {
+        EQRLS(_dotprod)(_eq, _eq->w0, _eq->xb + i, _eq->p, &d_hat);
+        EQRLS(_update)(_eq, _eq->xb + i, _d[i] - d_hat);
+    }
+    _eq->nb = 0;
 }
 
 // retrieve internal filter coefficients
@@ -349,7 +326,7 @@ void EQRLS(_get_weights)(EQRLS() _eq, T * _w)
     // copy output weight vector
     unsigned int i, p=_eq->p;
     for (i=0; i<p; i++)
-        _w[i] = _eq->w1[p-i-1];
+        _w[i] = _eq->w0[p-i-1];
 }
 
 // train equalizer object
@@ -392,3 +369,137 @@ void EQRLS(_train)(EQRLS() _eq,
     // copy output weight vector
     EQRLS(_get_weights)(_eq, _w);
 }
+
+// 
+// internal methods
+//
+
+// compute dot product
+//  _eq     :   equalizer object
+//  _h      :   coefficients [size: _n x 1]
+//  _x      :   input vector [size: _n x 1]
+//  _n      :   vector length
+//  _y      :   output sample
+void EQRLS(_dotprod)(EQRLS()      _eq,
+                     T *          _h,
+                     T *          _x,
+                     unsigned int _n,
+                     T *          _y)
+{
+    T y = 0;
+    unsigned int i = 0;
+#if T_COMPLEX && LIQUID_CPU_X86
+    if (_eq->simd >= LIQUID_SIMD_AVX2)
+        i = equalizer_cccf_dotprod_avx2(_h, _x, _n, &y);
+    else if (_eq->simd == LIQUID_SIMD_SSE)
+        i = equalizer_cccf_dotprod_sse(_h, _x, _n, &y);
+#endif
+    for ( ; i<_n; i++)
+        y += _h[i]*_x[i];
+    *_y = y;
+}
+
+// scaled vector addition
+//  _eq     :   equalizer object
+//  _y      :   input/output vector [size: _n x 1]
+//  _c      :   scaling factor
+//  _x      :   input vector [size: _n x 1]
+//  _n      :   vector length
+void EQRLS(_axpy)(EQRLS()      _eq,
+                  T *          _y,
+                  T            _c,
+                  T *          _x,
+                  unsigned int _n)
+{
+    unsigned int i = 0;
+#if T_COMPLEX && LIQUID_CPU_X86
+    if (_eq->simd >= LIQUID_SIMD_AVX2)
+        i = equalizer_cccf_axpy_avx2(_y, _c, _x, _n);
+    else if (_eq->simd == LIQUID_SIMD_SSE)
+        i = equalizer_cccf_axpy_sse(_y, _c, _x, _n);
+#endif
+    for ( ; i<_n; i++)
+        _y[i] += _c*_x[i];
+}
+
+// update weights and recursion matrix (inverse QR-RLS)
+//  _eq     :   equalizer object
+//  _x      :   input vector [size: p x 1]
+//  _alpha  :   a priori error, d - w.'*x
+//
+// The pre-array
+//      [ 1   x.'*S/sqrt(lambda) ]
+//      [ 0     S/sqrt(lambda)   ]
+// is rotated to annihilate its upper-right row, giving
+//      [ gamma^-1/2          0  ]
+//      [ g*gamma^-1/2        S' ]
+// where g = P*conj(x)/(lambda + x.'*P*conj(x)) is the gain vector and
+// S' the updated square root of P. Columns are rotated from last to
+// first so that S remains lower triangular.
+void EQRLS(_update)(EQRLS() _eq,
+                    T *     _x,
+                    T       _alpha)
+{
+    unsigned int i, j;
+    unsigned int p = _eq->p;
+    float sigma = 1.0f / sqrtf(_eq->lambda);
+
+    // transformed input, a = x.'*S/sqrt(lambda)
+    for (j=0; j<p; j++) {
+        EQRLS(_dotprod)(_eq, _eq->S + j*p + j, _x + j, p - j, &_eq->a[j]);
+        _eq->a[j] *= sigma;
+    }
+
+    // annihilate transformed input, one column at a time
+    memset(_eq->g, 0x00, p*sizeof(T));
+    float t = 1.0f;     // upper-left element of post-array
+    for (j=p; j>0; j--) {
+        T aj = _eq->a[j-1];
+        float r = sqrtf(t*t + crealf(aj*conj(aj)));
+        float c = t / r;
+        T     s = aj / r;
+
+        // [g S(:,j)] <- [g sigma*S(:,j)] * [c -s; conj(s) c]
+        T * v  = _eq->g + (j-1);
+        T * sj = _eq->S + (j-1)*p + (j-1);
+        unsigned int n = p - (j-1);
+        T s0 = conj(s)*sigma;
+        T s1 = -s;
+        float c1 = c*sigma;
+        i = 0;
+#if T_COMPLEX && LIQUID_CPU_X86
+        if (_eq->simd >= LIQUID_SIMD_AVX2)
+            i = equalizer_cccf_rotate_avx2(v, sj, c, s0, s1, c1, n);
+        else if (_eq->simd == LIQUID_SIMD_SSE)
+            i = equalizer_cccf_rotate_sse(v, sj, c, s0, s1, c1, n);
+#endif
+        for ( ; i<n; i++) {
+            T vi = v[i];
+            v[i]  = c*vi + s0*sj[i];
+            sj[i] = s1*vi + c1*sj[i];
+        }
+        t = r;
+    }
+
+    // update weighting vector, w += alpha * g
+    EQRLS(_axpy)(_eq, _eq->w0, _alpha / t, _eq->g, p);
+
+#ifdef DEBUG
+    printf("g: ");
+    for (i=0; i<p; i++)
+        PRINTVAL(_eq->g[i] / t);
+    printf("\n");
+    EQRLS(_print)(_eq);
+#endif
+}
+
+// ensure block buffer can hold _n samples
+void EQRLS(_reserve_block)(EQRLS()      _eq,
+                           unsigned int _n)
+{
+    if (_n <= _eq->nb_max)
+        return;
+
+    _eq->nb_max = _n;
+    _eq->xb = (T*) realloc(_eq->xb, (_eq->p - 1 + _n)*sizeof(T));
+}
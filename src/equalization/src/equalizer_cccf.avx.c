@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// equalizer_cccf.avx.c : equalizer vector kernels (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// complex multiply of four interleaved pairs by scalar with real and
+// imaginary parts _br and _bi
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 eq_cmul_avx2(__m256 _a,
+                                  __m256 _br,
+                                  __m256 _bi)
+{
+    __m256 as = _mm256_permute_ps(_a, _MM_SHUFFLE(2,3,0,1));
+    return _mm256_fmaddsub_ps(_a, _br, _mm256_mul_ps(as, _bi));
+}
+
+// horizontal sum of even and odd lanes: {sum(even), sum(odd)}
+__attribute__((target("avx2,fma"), always_inline))
+static inline void eq_hsum_avx2(__m256 _v,
+                                float * _even,
+                                float * _odd)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    *_even = _mm_cvtss_f32(s);
+    *_odd  = _mm_cvtss_f32(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1,1,1,1)));
+}
+
+// accumulate products of interleaved _h and _x into direct terms
+// _a = {hr*xr, hi*xi, ...} and cross terms _b = {hr*xi, hi*xr, ...};
+// return number of samples processed (multiple of 4)
+__attribute__((target("avx2,fma"), always_inline))
+static inline unsigned int eq_dotprod_avx2(float complex * _h,
+                                           float complex * _x,
+                                           unsigned int    _n,
+                                           __m256 *        _a,
+                                           __m256 *        _b)
+{
+    __m256 a0 = _mm256_setzero_ps();
+    __m256 b0 = _mm256_setzero_ps();
+    __m256 a1 = _mm256_setzero_ps();
+    __m256 b1 = _mm256_setzero_ps();
+
+    // two sets of accumulators to hide latency
+    unsigned int i;
+    for (i=0; i+8 <= _n; i+=8) {
+        __m256 h0 = _mm256_loadu_ps((float*)(_h + i));
+        __m256 x0 = _mm256_loadu_ps((float*)(_x + i));
+        __m256 h1 = _mm256_loadu_ps((float*)(_h + i + 4));
+        __m256 x1 = _mm256_loadu_ps((float*)(_x + i + 4));
+        a0 = _mm256_fmadd_ps(h0, x0, a0);
+        b0 = _mm256_fmadd_ps(h0, _mm256_permute_ps(x0, _MM_SHUFFLE(2,3,0,1)), b0);
+        a1 = _mm256_fmadd_ps(h1, x1, a1);
+        b1 = _mm256_fmadd_ps(h1, _mm256_permute_ps(x1, _MM_SHUFFLE(2,3,0,1)), b1);
+    }
+    for ( ; i+4 <= _n; i+=4) {
+        __m256 h0 = _mm256_loadu_ps((float*)(_h + i));
+        __m256 x0 = _mm256_loadu_ps((float*)(_x + i));
+        a0 = _mm256_fmadd_ps(h0, x0, a0);
+        b0 = _mm256_fmadd_ps(h0, _mm256_permute_ps(x0, _MM_SHUFFLE(2,3,0,1)), b0);
+    }
+    *_a = _mm256_add_ps(a0, a1);
+    *_b = _mm256_add_ps(b0, b1);
+    return i;
+}
+
+// conjugate dot product; see equalizer_cccf_dotprod_conj_sse()
+__attribute__((target("avx2,fma")))
+unsigned int equalizer_cccf_dotprod_conj_avx2(float complex * _h,
+                                              float complex * _x,
+                                              unsigned int    _n,
+                                              float complex * _y)
+{
+    __m256 a, b;
+    unsigned int i = eq_dotprod_avx2(_h, _x, _n, &a, &b);
+    float a0, a1, b0, b1;
+    eq_hsum_avx2(a, &a0, &a1);
+    eq_hsum_avx2(b, &b0, &b1);
+    *_y = (a0 + a1) + _Complex_I*(b0 - b1);
+    return i;
+}
+
+// update weights; see equalizer_cccf_axpy_sse()
+__attribute__((target("avx2,fma")))
+unsigned int equalizer_cccf_axpy_avx2(float complex * _y,
+                                      float complex   _c,
+                                      float complex * _x,
+                                      unsigned int    _n)
+{
+    __m256 cr = _mm256_set1_ps(crealf(_c));
+    __m256 ci = _mm256_set1_ps(cimagf(_c));
+
+    unsigned int i;
+    for (i=0; i+4 <= _n; i+=4) {
+        float * y = (float*)(_y + i);
+        __m256 x = _mm256_loadu_ps((float*)(_x + i));
+        _mm256_storeu_ps(y, _mm256_add_ps(_mm256_loadu_ps(y), eq_cmul_avx2(x, cr, ci)));
+    }
+    return i;
+}
+
+// dot product; see equalizer_cccf_dotprod_sse()
+__attribute__((target("avx2,fma")))
+unsigned int equalizer_cccf_dotprod_avx2(float complex * _h,
+                                         float complex * _x,
+                                         unsigned int    _n,
+                                         float complex * _y)
+{
+    __m256 a, b;
+    unsigned int i = eq_dotprod_avx2(_h, _x, _n, &a, &b);
+    float a0, a1, b0, b1;
+    eq_hsum_avx2(a, &a0, &a1);
+    eq_hsum_avx2(b, &b0, &b1);
+    *_y = (a0 - a1) + _Complex_I*(b0 + b1);
+    return i;
+}
+
+// apply rotation to column pair; see equalizer_cccf_rotate_sse()
+__attribute__((target("avx2,fma")))
+unsigned int equalizer_cccf_rotate_avx2(float complex * _v,
+                                        float complex * _s,
+                                        float           _c0,
+                                        float complex   _s0,
+                                        float complex   _s1,
+                                        float           _c1,
+                                        unsigned int    _n)
+{
+    __m256 c0  = _mm256_set1_ps(_c0);
+    __m256 c1  = _mm256_set1_ps(_c1);
+    __m256 s0r = _mm256_set1_ps(crealf(_s0));
+    __m256 s0i = _mm256_set1_ps(cimagf(_s0));
+    __m256 s1r = _mm256_set1_ps(crealf(_s1));
+    __m256 s1i = _mm256_set1_ps(cimagf(_s1));
+
+    unsigned int i;
+    for (i=0; i+4 <= _n; i+=4) {
+        float * v = (float*)(_v + i);
+        float * s = (float*)(_s + i);
+        __m256 vi = _mm256_loadu_ps(v);
+        __m256 si = _mm256_loadu_ps(s);
+        _mm256_storeu_ps(v, _mm256_fmadd_ps(c0, vi, eq_cmul_avx2(si, s0r, s0i)));
+        _mm256_storeu_ps(s, _mm256_fmadd_ps(c1, si, eq_cmul_avx2(vi, s1r, s1i)));
+    }
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
@@ -37,6 +37,7 @@
 #define MATRIX(name)    LIQUID_CONCAT(matrixcf,name)
 
 #define T               float complex
+#define T_COMPLEX       1
 
 #define PRINTVAL(V)     printf("%5.2f+j%5.2f ", crealf(V), cimagf(V));
 
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// equalizer_cccf.mmx.c : equalizer vector kernels (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// complex multiply of two interleaved pairs by scalar with real and
+// imaginary parts _br and _bi
+__attribute__((target("sse2"), always_inline))
+static inline __m128 eq_cmul_sse(__m128 _a,
+                                 __m128 _br,
+                                 __m128 _bi)
+{
+    const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));
+    return _mm_add_ps(_mm_mul_ps(_a, _br),
+                      _mm_xor_ps(_mm_mul_ps(as, _bi), sign));
+}
+
+// accumulate products of interleaved _h and _x into direct terms
+// _a = {hr*xr, hi*xi, ...} and cross terms _b = {hr*xi, hi*xr, ...};
+// return number of samples processed (multiple of 2)
+__attribute__((target("sse2"), always_inline))
+static inline unsigned int eq_dotprod_sse(float complex * _h,
+                                          float complex * _x,
+                                          unsigned int    _n,
+                                          float *         _a,
+                                          float *         _b)
+{
+    __m128 a = _mm_setzero_ps();
+    __m128 b = _mm_setzero_ps();
+
+    unsigned int i;
+    for (i=0; i+2 <= _n; i+=2) {
+        __m128 h = _mm_loadu_ps((float*)(_h + i));
+        __m128 x = _mm_loadu_ps((float*)(_x + i));
+        a = _mm_add_ps(a, _mm_mul_ps(h, x));
+        b = _mm_add_ps(b, _mm_mul_ps(h, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2,3,0,1))));
+    }
+    _mm_storeu_ps(_a, a);
+    _mm_storeu_ps(_b, b);
+    return i;
+}
+
+// conjugate dot product, sum{ conj(_h[i]) * _x[i] }
+__attribute__((target("sse2")))
+unsigned int equalizer_cccf_dotprod_conj_sse(float complex * _h,
+                                             float complex * _x,
+                                             unsigned int    _n,
+                                             float complex * _y)
+{
+    float a[4], b[4];
+    unsigned int i = eq_dotprod_sse(_h, _x, _n, a, b);
+    *_y = (a[0] + a[1] + a[2] + a[3]) + _Complex_I*(b[0] - b[1] + b[2] - b[3]);
+    return i;
+}
+
+// scaled vector addition, _y[i] += _c * _x[i]
+__attribute__((target("sse2")))
+unsigned int equalizer_cccf_axpy_sse(float complex * _y,
+                                     float complex   _c,
+                                     float complex * _x,
+                                     unsigned int    _n)
+{
+    __m128 cr = _mm_set1_ps(crealf(_c));
+    __m128 ci = _mm_set1_ps(cimagf(_c));
+
+    unsigned int i;
+    for (i=0; i+2 <= _n; i+=2) {
+        float * y = (float*)(_y + i);
+        __m128 x = _mm_loadu_ps((float*)(_x + i));
+        _mm_storeu_ps(y, _mm_add_ps(_mm_loadu_ps(y), eq_cmul_sse(x, cr, ci)));
+    }
+    return i;
+}
+
+// dot product, sum{ _h[i] * _x[i] }
+__attribute__((target("sse2")))
+unsigned int equalizer_cccf_dotprod_sse(float complex * _h,
+                                        float complex * _x,
+                                        unsigned int    _n,
+                                        float complex * _y)
+{
+    float a[4], b[4];
+    unsigned int i = eq_dotprod_sse(_h, _x, _n, a, b);
+    *_y = (a[0] - a[1] + a[2] - a[3]) + _Complex_I*(b[0] + b[1] + b[2] + b[3]);
+    return i;
+}
+
+// apply rotation to column pair,
+//  _v[i] <- _c0*_v[i] + _s0*_s[i]
+//  _s[i] <- _s1*_v[i] + _c1*_s[i]
+__attribute__((target("sse2")))
+unsigned int equalizer_cccf_rotate_sse(float complex * _v,
+                                       float complex * _s,
+                                       float           _c0,
+                                       float complex   _s0,
+                                       float complex   _s1,
+                                       float           _c1,
+                                       unsigned int    _n)
+{
+    __m128 c0  = _mm_set1_ps(_c0);
+    __m128 c1  = _mm_set1_ps(_c1);
+    __m128 s0r = _mm_set1_ps(crealf(_s0));
+    __m128 s0i = _mm_set1_ps(cimagf(_s0));
+    __m128 s1r = _mm_set1_ps(crealf(_s1));
+    __m128 s1i = _mm_set1_ps(cimagf(_s1));
+
+    unsigned int i;
+    for (i=0; i+2 <= _n; i+=2) {
+        float * v = (float*)(_v + i);
+        float * s = (float*)(_s + i);
+        __m128 vi = _mm_loadu_ps(v);
+        __m128 si = _mm_loadu_ps(s);
+        _mm_storeu_ps(v, _mm_add_ps(_mm_mul_ps(c0, vi), eq_cmul_sse(si, s0r, s0i)));
+        _mm_storeu_ps(s, _mm_add_ps(eq_cmul_sse(vi, s1r, s1i), _mm_mul_ps(c1, si)));
+    }
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
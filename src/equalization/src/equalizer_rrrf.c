@@ -37,6 +37,7 @@
 #define MATRIX(name)    LIQUID_CONCAT(matrixf,name)
 
 #define T               float
+#define T_COMPLEX       0
 
 #define PRINTVAL(V)     printf("%5.2f ", V);
 
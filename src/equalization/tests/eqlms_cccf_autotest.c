@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// generate QPSK symbols _d and channel output _x
+void eqlms_cccf_autotest_gen(float complex * _d,
+                             float complex * _x,
+                             unsigned int    _n)
+{
+    float complex h[4] = {1.0f, 0.3f+0.2f*_Complex_I, -0.1f, 0.05f*_Complex_I};
+    unsigned int i, j;
+    for (i=0; i<_n; i++)
+        _d[i] = ((rand() & 1) ? M_SQRT1_2 : -M_SQRT1_2) +
+                ((rand() & 1) ? M_SQRT1_2 : -M_SQRT1_2)*_Complex_I;
+    for (i=0; i<_n; i++) {
+        _x[i] = 0;
+        for (j=0; j<4 && j<=i; j++)
+            _x[i] += h[j]*_d[i-j];
+    }
+}
+
+// 
+// AUTOTEST: block execution matches per-sample execution with
+// fixed weights, for each run-time selected kernel
+//
+void autotest_eqlms_cccf_execute_block()
+{
+    float tol = 1e-5f;
+    unsigned int p = 13;
+    unsigned int n = 100;
+    unsigned int masks[3] = {
+        ~(LIQUID_CPU_AVX512F),                  // AVX2/FMA
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    float complex d[n], x[n], y0[n], y1[n];
+    eqlms_cccf_autotest_gen(d, x, n);
+
+    // non-trivial weights
+    float complex w[p];
+    unsigned int i, k;
+    for (i=0; i<p; i++)
+        w[i] = cexpf(_Complex_I*0.7f*i) / (float)(i+1);
+
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        eqlms_cccf q0 = eqlms_cccf_create(w, p);
+        eqlms_cccf q1 = eqlms_cccf_create(w, p);
+
+        for (i=0; i<n; i++) {
+            eqlms_cccf_push(q0, x[i]);
+            eqlms_cccf_execute(q0, &y0[i]);
+        }
+
+        // run as several blocks of uneven length
+        eqlms_cccf_execute_block(q1, x,     7,     y1);
+        eqlms_cccf_execute_block(q1, x+7,   50,    y1+7);
+        eqlms_cccf_execute_block(q1, x+57,  n-57,  y1+57);
+
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+            CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+        }
+
+        // per-sample execution continues from block state
+        float complex z0, z1;
+        eqlms_cccf_push(q0, x[0]); eqlms_cccf_execute(q0, &z0);
+        eqlms_cccf_push(q1, x[0]); eqlms_cccf_execute(q1, &z1);
+        CONTEND_DELTA( crealf(z1), crealf(z0), tol );
+        CONTEND_DELTA( cimagf(z1), cimagf(z0), tol );
+
+        eqlms_cccf_destroy(q0);
+        eqlms_cccf_destroy(q1);
+    }
+
+    // restore processor features
+    liquid_cpu_set_mask(~0U);
+}
+
+// 
+// AUTOTEST: per-sample training gives same weights for each kernel
+//
+void autotest_eqlms_cccf_train_simd()
+{
+    float tol = 1e-4f;
+    unsigned int p = 11;
+    unsigned int n = 400;
+    unsigned int masks[3] = {
+        ~0U,                                    // all extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    float complex d[n], x[n];
+    eqlms_cccf_autotest_gen(d, x, n);
+
+    float complex w[3][p];
+    unsigned int i, k;
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        eqlms_cccf q = eqlms_cccf_create(NULL, p);
+        eqlms_cccf_set_bw(q, 0.1f);
+        for (i=0; i<p; i++)
+            w[k][i] = 0;
+        eqlms_cccf_train(q, w[k], x, d, n);
+        eqlms_cccf_destroy(q);
+    }
+    liquid_cpu_set_mask(~0U);
+
+    for (k=1; k<3; k++) {
+        for (i=0; i<p; i++) {
+            CONTEND_DELTA( crealf(w[k][i]), crealf(w[0][i]), tol );
+            CONTEND_DELTA( cimagf(w[k][i]), cimagf(w[0][i]), tol );
+        }
+    }
+}
+
+// 
+// AUTOTEST: block LMS converges, equalizing channel
+//
+void autotest_eqlms_cccf_step_block()
+{
+    unsigned int p = 11;
+    unsigned int nb = 32;               // block length
+    unsigned int num_blocks = 100;
+    unsigned int n = nb*num_blocks;
+
+    float complex * d = (float complex*) malloc(n*sizeof(float complex));
+    float complex * x = (float complex*) malloc(n*sizeof(float complex));
+    float complex y[nb];
+    eqlms_cccf_autotest_gen(d, x, n);
+
+    eqlms_cccf q = eqlms_cccf_create(NULL, p);
+    eqlms_cccf_set_bw(q, 1.0f);
+
+    // train with known symbols
+    unsigned int b, i;
+    float mse = 0.0f;
+    for (b=0; b<num_blocks; b++) {
+        eqlms_cccf_execute_block(q, x + b*nb, nb, y);
+        eqlms_cccf_step_block(q, d + b*nb, nb);
+
+        // measure error over last few blocks
+        if (b >= num_blocks - 10) {
+            for (i=0; i<nb; i++)
+                mse += crealf((y[i]-d[b*nb+i])*conjf(y[i]-d[b*nb+i]));
+        }
+    }
+    mse /= 10*nb;
+
+    if (liquid_autotest_verbose)
+        printf("  block lms mse : %8.2f dB\n", 10*log10f(mse));
+
+    CONTEND_LESS_THAN( 10*log10f(mse), -25.0f );
+
+    eqlms_cccf_destroy(q);
+    free(d);
+    free(x);
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// generate QPSK symbols _d and channel output _x
+void eqrls_cccf_autotest_gen(float complex * _d,
+                             float complex * _x,
+                             unsigned int    _n)
+{
+    float complex h[4] = {1.0f, 0.3f+0.2f*_Complex_I, -0.1f, 0.05f*_Complex_I};
+    unsigned int i, j;
+    for (i=0; i<_n; i++)
+        _d[i] = ((rand() & 1) ? M_SQRT1_2 : -M_SQRT1_2) +
+                ((rand() & 1) ? M_SQRT1_2 : -M_SQRT1_2)*_Complex_I;
+    for (i=0; i<_n; i++) {
+        _x[i] = 0;
+        for (j=0; j<4 && j<=i; j++)
+            _x[i] += h[j]*_d[i-j];
+    }
+}
+
+// 
+// AUTOTEST: channel inversion for each run-time selected kernel;
+// the weights converge to the truncated inverse of the channel
+//
+void autotest_eqrls_cccf_train_simd()
+{
+    float tol = 1e-3f;
+    unsigned int p = 12;
+    unsigned int n = 200;
+    unsigned int masks[3] = {
+        ~0U,                                    // all extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    float complex d[n], x[n];
+    eqrls_cccf_autotest_gen(d, x, n);
+
+    // inverse of channel, 1/h(z)
+    float complex h[4] = {1.0f, 0.3f+0.2f*_Complex_I, -0.1f, 0.05f*_Complex_I};
+    float complex g[p];
+    unsigned int i, j, k;
+    for (i=0; i<p; i++) {
+        g[i] = (i==0) ? 1.0f : 0.0f;
+        for (j=1; j<4 && j<=i; j++)
+            g[i] -= h[j]*g[i-j];
+    }
+
+    float complex w[p];
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        eqrls_cccf q = eqrls_cccf_create(NULL, p);
+        for (i=0; i<p; i++)
+            w[i] = 0;
+        eqrls_cccf_train(q, w, x, d, n);
+        eqrls_cccf_destroy(q);
+
+        for (i=0; i<p; i++) {
+            CONTEND_DELTA( crealf(w[i]), crealf(g[i]), tol );
+            CONTEND_DELTA( cimagf(w[i]), cimagf(g[i]), tol );
+        }
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+// 
+// AUTOTEST: block execute/step matches per-sample training
+//
+void autotest_eqrls_cccf_step_block()
+{
+    float tol = 1e-5f;
+    unsigned int p  = 9;
+    unsigned int nb = 20;               // block length
+    unsigned int num_blocks = 10;
+    unsigned int n = nb*num_blocks;
+
+    float complex d[n], x[n], y0[n], y1[n];
+    eqrls_cccf_autotest_gen(d, x, n);
+
+    eqrls_cccf q0 = eqrls_cccf_create(NULL, p);
+    eqrls_cccf q1 = eqrls_cccf_create(NULL, p);
+    eqrls_cccf_set_bw(q0, 0.95f);
+    eqrls_cccf_set_bw(q1, 0.95f);
+
+    unsigned int b, i;
+    for (b=0; b<num_blocks; b++) {
+        // per-sample
+        for (i=0; i<nb; i++) {
+            eqrls_cccf_push(q0, x[b*nb+i]);
+            eqrls_cccf_execute(q0, &y0[b*nb+i]);
+            eqrls_cccf_step(q0, d[b*nb+i], y0[b*nb+i]);
+        }
+
+        // block (outputs computed with weights at start of block)
+        eqrls_cccf_execute_block(q1, x + b*nb, nb, y1 + b*nb);
+        eqrls_cccf_step_block(q1, d + b*nb, nb);
+    }
+
+    // compare weights
+    float complex w0[p], w1[p];
+    eqrls_cccf_get_weights(q0, w0);
+    eqrls_cccf_get_weights(q1, w1);
+    for (i=0; i<p; i++) {
+        CONTEND_DELTA( crealf(w1[i]), crealf(w0[i]), tol );
+        CONTEND_DELTA( cimagf(w1[i]), cimagf(w0[i]), tol );
+    }
+
+    // first output of each block is a priori in both cases
+    for (b=0; b<num_blocks; b++) {
+        CONTEND_DELTA( crealf(y1[b*nb]), crealf(y0[b*nb]), tol );
+        CONTEND_DELTA( cimagf(y1[b*nb]), cimagf(y0[b*nb]), tol );
+    }
+
+    eqrls_cccf_destroy(q0);
+    eqrls_cccf_destroy(q1);
+}
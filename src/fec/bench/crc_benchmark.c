@@ -29,14 +29,22 @@
 (   struct rusage *_start,                  \
     struct rusage *_finish,                 \
     unsigned long int *_num_iterations)     \
-{ crc_bench(_start, _finish, _num_iterations, CRC, N); }
+{ crc_bench(_start, _finish, _num_iterations, CRC, N, ~0U); }
+
+// table-driven method only (no carry-less multiply folding)
+#define CRC_BENCH_TABLE_API(CRC,N)          \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ crc_bench(_start, _finish, _num_iterations, CRC, N, 0); }
 
 // Helper function to keep code base small
 void crc_bench(struct rusage *_start,
                struct rusage *_finish,
                unsigned long int *_num_iterations,
                crc_scheme _crc,
-               unsigned int _n)
+               unsigned int _n,
+               unsigned int _cpu_mask)
 {
     // normalize number of iterations
     if (_crc != LIQUID_CRC_CHECKSUM)
@@ -52,6 +60,8 @@ void crc_bench(struct rusage *_start,
     for (i=0; i<_n; i++)
         msg[i] = rand() & 0xff;
 
+    liquid_cpu_set_mask(_cpu_mask);
+
     // start trials
     getrusage(RUSAGE_SELF, _start);
     for (i=0; i<(*_num_iterations); i++) {
@@ -62,6 +72,8 @@ void crc_bench(struct rusage *_start,
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
+
+    liquid_cpu_set_mask(~0U);
 }
 
 //
@@ -74,3 +86,10 @@ void benchmark_crc_crc16_n256       CRC_BENCH_API(LIQUID_CRC_16,        256)
 void benchmark_crc_crc24_n256       CRC_BENCH_API(LIQUID_CRC_24,        256)
 void benchmark_crc_crc32_n256       CRC_BENCH_API(LIQUID_CRC_32,        256)
 
+void benchmark_crc_crc16_n4096      CRC_BENCH_API(LIQUID_CRC_16,        4096)
+void benchmark_crc_crc24_n4096      CRC_BENCH_API(LIQUID_CRC_24,        4096)
+void benchmark_crc_crc32_n4096      CRC_BENCH_API(LIQUID_CRC_32,        4096)
+
+void benchmark_crc_crc32_table_n256     CRC_BENCH_TABLE_API(LIQUID_CRC_32,  256)
+void benchmark_crc_crc32_table_n4096    CRC_BENCH_TABLE_API(LIQUID_CRC_32,  4096)
+
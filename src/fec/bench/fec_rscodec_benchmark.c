@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_rscodec_benchmark.c : Reed-Solomon (255,223) codec speed
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#include "liquid.internal.h"
+
+#define FEC_RSCODEC_BENCH_API(NUM_ERRORS,MASK)  \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ fec_rscodec_bench(_start, _finish, _num_iterations, NUM_ERRORS, MASK); }
+
+// helper function to keep code base small
+//  _num_errors :   number of symbol errors per block (-1 : encode only)
+//  _mask       :   run-time processor feature mask (kernel selection)
+void fec_rscodec_bench(struct rusage *     _start,
+                       struct rusage *     _finish,
+                       unsigned long int * _num_iterations,
+                       int                 _num_errors,
+                       unsigned int        _mask)
+{
+    *_num_iterations /= 20;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned char msg[223];
+    unsigned char block[255];
+    unsigned char rec[255];
+    unsigned long int i;
+    for (i=0; i<223; i++)
+        msg[i] = rand() & 0xff;
+
+    liquid_cpu_set_mask(_mask);
+    fec_rscodec q = fec_rscodec_create(0x11d, 1, 1, 32, 0);
+    liquid_cpu_set_mask(~0U);
+
+    memmove(block, msg, 223);
+    fec_rscodec_encode(q, msg, block+223);
+    for (i=0; i<(unsigned int)(_num_errors > 0 ? _num_errors : 0); i++)
+        block[(37*i) % 255] ^= 0x33;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    if (_num_errors < 0) {
+        for (i=0; i<(*_num_iterations); i++)
+            fec_rscodec_encode(q, msg, block+223);
+    } else {
+        for (i=0; i<(*_num_iterations); i++) {
+            memmove(rec, block, 255);
+            fec_rscodec_decode(q, rec);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    fec_rscodec_destroy(q);
+}
+
+#define MASK_AVX2   (~0U)
+#define MASK_SSE    (~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2))
+#define MASK_NONE   (0)
+
+void benchmark_fec_rscodec_encode       FEC_RSCODEC_BENCH_API(-1, MASK_AVX2)
+void benchmark_fec_rscodec_encode_sse   FEC_RSCODEC_BENCH_API(-1, MASK_SSE)
+void benchmark_fec_rscodec_encode_c     FEC_RSCODEC_BENCH_API(-1, MASK_NONE)
+void benchmark_fec_rscodec_decode_e0    FEC_RSCODEC_BENCH_API( 0, MASK_AVX2)
+void benchmark_fec_rscodec_decode_e0_sse FEC_RSCODEC_BENCH_API( 0, MASK_SSE)
+void benchmark_fec_rscodec_decode_e0_c  FEC_RSCODEC_BENCH_API( 0, MASK_NONE)
+void benchmark_fec_rscodec_decode_e8    FEC_RSCODEC_BENCH_API( 8, MASK_AVX2)
+void benchmark_fec_rscodec_decode_e8_c  FEC_RSCODEC_BENCH_API( 8, MASK_NONE)
+void benchmark_fec_rscodec_decode_e16   FEC_RSCODEC_BENCH_API(16, MASK_AVX2)
+
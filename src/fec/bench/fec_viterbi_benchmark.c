@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_viterbi_benchmark.c : native Viterbi decoder throughput
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+
+#include "liquid.internal.h"
+
+#define FEC_VITERBI_BENCH_API(K,R,POLY,MASK)    \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ fec_viterbi_bench(_start, _finish, _num_iterations, K, R, POLY, MASK); }
+
+// helper function to keep code base small
+//  _K      :   constraint length
+//  _R      :   number of polynomials
+//  _poly   :   generator polynomials
+//  _mask   :   run-time processor feature mask (kernel selection)
+void fec_viterbi_bench(struct rusage *     _start,
+                       struct rusage *     _finish,
+                       unsigned long int * _num_iterations,
+                       unsigned int        _K,
+                       unsigned int        _R,
+                       int *               _poly,
+                       unsigned int        _mask)
+{
+    // decode 1024 bits per iteration; scale by number of states
+    unsigned int n = 1024;
+    unsigned int num_steps = n + _K - 1;
+    *_num_iterations = *_num_iterations * 16 / (1 << (_K-1)) / 4;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned char sym[_R*num_steps];
+    unsigned char dec[n/8];
+    unsigned long int i;
+    for (i=0; i<_R*num_steps; i++)
+        sym[i] = rand() & 0xff;
+
+    liquid_cpu_set_mask(_mask);
+    fec_viterbi q = fec_viterbi_create(_K, _R, _poly, n);
+    liquid_cpu_set_mask(~0U);
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        fec_viterbi_init(q, 0);
+        fec_viterbi_update_blk(q, sym, num_steps);
+        fec_viterbi_chainback(q, dec, n, 0);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    fec_viterbi_destroy(q);
+}
+
+#define MASK_AVX2   (~0U)
+#define MASK_SSE    (~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2))
+#define MASK_NONE   (0)
+
+void benchmark_fec_viterbi_v27       FEC_VITERBI_BENCH_API( 7, 2, fec_conv27_poly,  MASK_AVX2)
+void benchmark_fec_viterbi_v27_sse   FEC_VITERBI_BENCH_API( 7, 2, fec_conv27_poly,  MASK_SSE)
+void benchmark_fec_viterbi_v27_c     FEC_VITERBI_BENCH_API( 7, 2, fec_conv27_poly,  MASK_NONE)
+void benchmark_fec_viterbi_v29       FEC_VITERBI_BENCH_API( 9, 2, fec_conv29_poly,  MASK_AVX2)
+void benchmark_fec_viterbi_v29_sse   FEC_VITERBI_BENCH_API( 9, 2, fec_conv29_poly,  MASK_SSE)
+void benchmark_fec_viterbi_v29_c     FEC_VITERBI_BENCH_API( 9, 2, fec_conv29_poly,  MASK_NONE)
+void benchmark_fec_viterbi_v39       FEC_VITERBI_BENCH_API( 9, 3, fec_conv39_poly,  MASK_AVX2)
+void benchmark_fec_viterbi_v615      FEC_VITERBI_BENCH_API(15, 6, fec_conv615_poly, MASK_AVX2)
+void benchmark_fec_viterbi_v615_sse  FEC_VITERBI_BENCH_API(15, 6, fec_conv615_poly, MASK_SSE)
+void benchmark_fec_viterbi_v615_c    FEC_VITERBI_BENCH_API(15, 6, fec_conv615_poly, MASK_NONE)
+
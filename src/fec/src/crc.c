@@ -148,6 +148,90 @@ int crc_validate_message(crc_scheme _scheme,
 }
 
 
+//
+// incremental computation
+//
+
+// initial state of incremental key computation
+unsigned int crc_init(crc_scheme _scheme)
+{
+    switch (_scheme) {
+    case LIQUID_CRC_UNKNOWN:
+        fprintf(stderr,"error: crc_init(), cannot generate key with CRC type \"UNKNOWN\"\n");
+        exit(-1);
+    case LIQUID_CRC_NONE:      return 0;
+    case LIQUID_CRC_CHECKSUM:  return 0;
+    case LIQUID_CRC_8:
+    case LIQUID_CRC_16:
+    case LIQUID_CRC_24:
+    case LIQUID_CRC_32:        return 0xffffffff;
+    default:
+        fprintf(stderr,"error: crc_init(), unknown/unsupported scheme: %d\n", _scheme);
+        exit(1);
+    }
+
+    return 0;
+}
+
+// update incremental key computation with next chunk of message
+//
+//  _scheme     :   error-detection scheme
+//  _state      :   current state (see crc_init())
+//  _msg        :   next chunk of message, [size: _n x 1]
+//  _n          :   chunk size (may be zero)
+unsigned int crc_update(crc_scheme      _scheme,
+                        unsigned int    _state,
+                        unsigned char * _msg,
+                        unsigned int    _n)
+{
+    unsigned int i;
+    switch (_scheme) {
+    case LIQUID_CRC_UNKNOWN:
+        fprintf(stderr,"error: crc_update(), cannot generate key with CRC type \"UNKNOWN\"\n");
+        exit(-1);
+    case LIQUID_CRC_NONE:
+        return 0;
+    case LIQUID_CRC_CHECKSUM:
+        // running sum of bytes, modulo 256
+        for (i=0; i<_n; i++)
+            _state += _msg[i];
+        return _state & 0xff;
+    case LIQUID_CRC_8:
+    case LIQUID_CRC_16:
+    case LIQUID_CRC_24:
+    case LIQUID_CRC_32:
+        return crc_reflected_update(_scheme - LIQUID_CRC_8, _state, _msg, _n);
+    default:
+        fprintf(stderr,"error: crc_update(), unknown/unsupported scheme: %d\n", _scheme);
+        exit(1);
+    }
+
+    return 0;
+}
+
+// compute error-detection key from state of incremental computation
+unsigned int crc_finalize(crc_scheme   _scheme,
+                          unsigned int _state)
+{
+    switch (_scheme) {
+    case LIQUID_CRC_UNKNOWN:
+        fprintf(stderr,"error: crc_finalize(), cannot generate key with CRC type \"UNKNOWN\"\n");
+        exit(-1);
+    case LIQUID_CRC_NONE:      return 0;
+    case LIQUID_CRC_CHECKSUM:  return (~_state + 1) & 0xff;   // 2's complement
+    case LIQUID_CRC_8:         return (~_state) & 0xff;
+    case LIQUID_CRC_16:        return (~_state) & 0xffff;
+    case LIQUID_CRC_24:        return (~_state) & 0xffffff;
+    case LIQUID_CRC_32:        return (~_state) & 0xffffffff;
+    default:
+        fprintf(stderr,"error: crc_finalize(), unknown/unsupported scheme: %d\n", _scheme);
+        exit(1);
+    }
+
+    return 0;
+}
+
+
 //
 // Checksum
 //
@@ -172,31 +256,153 @@ unsigned int checksum_generate_key(unsigned char *_data,
 }
 
 
+//
+// CRC engine
+//
+// All CRCs are reflected (least-significant bit first) with an initial
+// register value of ~0 and a complemented output.  The register is
+// always 32 bits wide: shorter CRCs simply carry their (reflected)
+// polynomial in the low bits, which is equivalent to a 32-bit CRC
+// with polynomial p(x)*x^(32-w).  This lets one table-driven engine
+// and one carry-less multiply folding kernel serve every width.
+//
+// Slicing-by-8 tables consume eight bytes per step; messages of at
+// least CRC_FOLD_MIN bytes are folded 64 bytes at a time with
+// PCLMULQDQ (when available) down to a 128-bit residue which is
+// congruent to the message, and finished with the tables.
+//
+
+#define CRC_NUM_ENGINES (4)     // crc8, crc16, crc24, crc32
+#define CRC_FOLD_MIN    (128)   // minimum message size for folding
+
+struct crc_engine_s {
+    uint32_t poly;              // reflected polynomial
+    uint32_t tab[8][256];       // slicing-by-8 tables
+    uint64_t k[8];              // folding constants, see crc_fold_pclmul()
+};
+
+static struct crc_engine_s crc_engine[CRC_NUM_ENGINES];
+
+// multiply (reflected) polynomial by x^_k modulo (reflected) _poly
+static uint32_t crc_reflected_mulxk(uint32_t     _r,
+                                    uint32_t     _poly,
+                                    unsigned int _k)
+{
+    unsigned int i;
+    for (i=0; i<_k; i++)
+        _r = (_r >> 1) ^ (_poly & -(_r & 1));
+    return _r;
+}
+
+// compute tables and folding constants for all engines
+static void crc_engine_init(void)
+{
+    unsigned int p, i, j;
+    crc_engine[0].poly = liquid_reverse_byte_gentab[CRC8_POLY];
+    crc_engine[1].poly = liquid_reverse_uint16(CRC16_POLY);
+    crc_engine[2].poly = liquid_reverse_uint24(CRC24_POLY);
+    crc_engine[3].poly = liquid_reverse_uint32(CRC32_POLY);
+
+    for (p=0; p<CRC_NUM_ENGINES; p++) {
+        struct crc_engine_s * e = &crc_engine[p];
+
+        // byte-wise table
+        for (i=0; i<256; i++)
+            e->tab[0][i] = crc_reflected_mulxk(i, e->poly, 8);
+
+        // table j advances a byte followed by j zero bytes
+        for (j=1; j<8; j++) {
+            for (i=0; i<256; i++)
+                e->tab[j][i] = (e->tab[j-1][i] >> 8) ^ e->tab[0][e->tab[j-1][i] & 0xff];
+        }
+
+        // folding constants x^(D+63), x^(D-1) mod p(x) for fold
+        // distances D = 512, 384, 256, 128 bits; x^0 is the
+        // most-significant bit of the reflected register, and the
+        // reflected 64-bit operand holds it in the upper half
+        unsigned int d[4] = {512, 384, 256, 128};
+        for (i=0; i<4; i++) {
+            e->k[2*i+0] = (uint64_t)crc_reflected_mulxk(0x80000000, e->poly, d[i]+63) << 32;
+            e->k[2*i+1] = (uint64_t)crc_reflected_mulxk(0x80000000, e->poly, d[i]- 1) << 32;
+        }
+    }
+}
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#   include <pthread.h>
+static pthread_once_t crc_engine_once = PTHREAD_ONCE_INIT;
+#   define CRC_ENGINE_INIT() pthread_once(&crc_engine_once, crc_engine_init)
+#else
+static int crc_engine_initialized = 0;
+#   define CRC_ENGINE_INIT() do {                   \
+        if (!crc_engine_initialized) {              \
+            crc_engine_init();                      \
+            crc_engine_initialized = 1;             \
+        }                                           \
+    } while (0)
+#endif
+
+// update 32-bit reflected CRC register with slicing-by-8 tables
+static uint32_t crc_reflected_update_tab(struct crc_engine_s * _e,
+                                         uint32_t              _r,
+                                         const unsigned char * _msg,
+                                         unsigned int          _n)
+{
+    const uint32_t (*t)[256] = _e->tab;
+    unsigned int i = 0;
+    for ( ; i + 8 <= _n; i += 8) {
+        uint32_t lo = _r ^ ( (uint32_t)_msg[i+0]        | ((uint32_t)_msg[i+1] <<  8) |
+                            ((uint32_t)_msg[i+2] << 16) | ((uint32_t)_msg[i+3] << 24) );
+        _r = t[7][ lo        & 0xff] ^ t[6][(lo >>  8) & 0xff] ^
+             t[5][(lo >> 16) & 0xff] ^ t[4][ lo >> 24        ] ^
+             t[3][_msg[i+4]]         ^ t[2][_msg[i+5]]         ^
+             t[1][_msg[i+6]]         ^ t[0][_msg[i+7]];
+    }
+    for ( ; i < _n; i++)
+        _r = (_r >> 8) ^ t[0][(_r ^ _msg[i]) & 0xff];
+    return _r;
+}
+
+// update 32-bit reflected CRC register for engine _p (0:crc8, 1:crc16,
+// 2:crc24, 3:crc32), selecting the fastest method available
+uint32_t crc_reflected_update(unsigned int          _p,
+                              uint32_t              _r,
+                              const unsigned char * _msg,
+                              unsigned int          _n)
+{
+    CRC_ENGINE_INIT();
+    struct crc_engine_s * e = &crc_engine[_p];
+
+#if LIQUID_CPU_X86
+    unsigned int f = liquid_cpu_get_features();
+    if (_n >= CRC_FOLD_MIN && (f & LIQUID_CPU_PCLMUL)) {
+        // fold blocks of 64 bytes to 128-bit residue, then finish
+        // with the tables starting from a zero register
+        unsigned int nfold = _n & ~63u;
+        unsigned char residue[16];
+        crc_fold_pclmul(e->k, _r, _msg, nfold, residue);
+        _r = crc_reflected_update_tab(e, 0, residue, 16);
+        _msg += nfold;
+        _n   -= nfold;
+    }
+#endif
+
+    return crc_reflected_update_tab(e, _r, _msg, _n);
+}
+
+
 // 
 // CRC-8
 //
 
 // generate 8-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc8_generate_key(unsigned char *_msg,
                                unsigned int _n)
 {
-    unsigned int i, j, b, mask, key8=~0;
-    unsigned int poly = liquid_reverse_byte_gentab[CRC8_POLY];
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key8 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key8 & 1);
-            key8 = (key8>>1) ^ (poly & mask);
-        }
-    }
-    return (~key8) & 0xff;
+    return (~crc_reflected_update(0, 0xffffffff, _msg, _n)) & 0xff;
 }
 
 
@@ -206,25 +412,12 @@ unsigned int crc8_generate_key(unsigned char *_msg,
 
 // generate 16-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc16_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key16=~0;
-    unsigned int poly = liquid_reverse_uint16(CRC16_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key16 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key16 & 1);
-            key16 = (key16>>1) ^ (poly & mask);
-        }
-    }
-    return (~key16) & 0xffff;
+    return (~crc_reflected_update(1, 0xffffffff, _msg, _n)) & 0xffff;
 }
 
 
@@ -234,25 +427,12 @@ unsigned int crc16_generate_key(unsigned char *_msg,
 
 // generate 24-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc24_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key24=~0;
-    unsigned int poly = liquid_reverse_uint24(CRC24_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key24 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key24 & 1);
-            key24 = (key24>>1) ^ (poly & mask);
-        }
-    }
-    return (~key24) & 0xffffff;
+    return (~crc_reflected_update(2, 0xffffffff, _msg, _n)) & 0xffffff;
 }
 
 
@@ -262,37 +442,11 @@ unsigned int crc24_generate_key(unsigned char *_msg,
 
 // generate 32-bit cyclic redundancy check key.
 //
-// slow method, operates one bit at a time
-// algorithm from: http://www.hackersdelight.org/crc.pdf
-//
 //  _msg    :   input data message [size: _n x 1]
 //  _n      :   input data message size
 unsigned int crc32_generate_key(unsigned char *_msg,
                                 unsigned int _n)
 {
-    unsigned int i, j, b, mask, key32=~0;
-    unsigned int poly = liquid_reverse_uint32(CRC32_POLY);
-    for (i=0; i<_n; i++) {
-        b = _msg[i];
-        key32 ^= b;
-        for (j=0; j<8; j++) {
-            mask = -(key32 & 1);
-            key32 = (key32>>1) ^ (poly & mask);
-        }
-    }
-    return (~key32) & 0xffffffff;
+    return (~crc_reflected_update(3, 0xffffffff, _msg, _n)) & 0xffffffff;
 }
 
-#if 0
-void crc32_generate_key(unsigned char *_msg,
-                        unsigned int _n,
-                        unsigned char *_key)
-{
-    unsigned int key32 = crc32_generate_key32(_msg,_n);
-    _key[0] = (key32 & 0xFF000000) >> 24;
-    _key[1] = (key32 & 0x00FF0000) >> 16;
-    _key[2] = (key32 & 0x0000FF00) >> 8;
-    _key[3] = (key32 & 0x000000FF);
-}
-#endif
-
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// crc.mmx.c : carry-less multiply CRC folding (PCLMULQDQ)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+// fold 128-bit accumulator _x forward by distance with constants _k
+// and add _y; the low (first) quadword of _x holds the high-order
+// coefficients and is multiplied by the low quadword of _k
+__attribute__((target("sse2,pclmul"), always_inline))
+static inline __m128i crc_fold_sse(__m128i _x,
+                                   __m128i _k,
+                                   __m128i _y)
+{
+    __m128i h = _mm_clmulepi64_si128(_x, _k, 0x00);
+    __m128i l = _mm_clmulepi64_si128(_x, _k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(h, l), _y);
+}
+
+// fold reflected 32-bit CRC over _n bytes (_n a non-zero multiple of
+// 64) with the register _state xor'd into the first four, writing a
+// 128-bit residue congruent (mod p(x)) to the message; its CRC from a
+// zero register equals the CRC of the message from _state
+__attribute__((target("sse2,pclmul")))
+void crc_fold_pclmul(const uint64_t *      _k,
+                     uint32_t              _state,
+                     const unsigned char * _msg,
+                     unsigned int          _n,
+                     unsigned char *       _residue)
+{
+    const __m128i * m = (const __m128i*) _msg;
+    __m128i k512 = _mm_loadu_si128((const __m128i*)(_k + 0));
+    __m128i k384 = _mm_loadu_si128((const __m128i*)(_k + 2));
+    __m128i k256 = _mm_loadu_si128((const __m128i*)(_k + 4));
+    __m128i k128 = _mm_loadu_si128((const __m128i*)(_k + 6));
+
+    // four independent accumulators, 64 bytes per iteration
+    __m128i x0 = _mm_xor_si128(_mm_loadu_si128(m+0), _mm_cvtsi32_si128((int)_state));
+    __m128i x1 = _mm_loadu_si128(m+1);
+    __m128i x2 = _mm_loadu_si128(m+2);
+    __m128i x3 = _mm_loadu_si128(m+3);
+    unsigned int i;
+    for (i=4; i<_n/16; i+=4) {
+        x0 = crc_fold_sse(x0, k512, _mm_loadu_si128(m+i+0));
+        x1 = crc_fold_sse(x1, k512, _mm_loadu_si128(m+i+1));
+        x2 = crc_fold_sse(x2, k512, _mm_loadu_si128(m+i+2));
+        x3 = crc_fold_sse(x3, k512, _mm_loadu_si128(m+i+3));
+    }
+
+    // combine accumulators
+    x3 = crc_fold_sse(x0, k384, x3);
+    x3 = crc_fold_sse(x1, k256, x3);
+    x3 = crc_fold_sse(x2, k128, x3);
+    _mm_storeu_si128((__m128i*)_residue, x3);
+}
+
+#endif // LIQUID_CPU_X86
+
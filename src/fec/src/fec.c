@@ -72,10 +72,6 @@ void liquid_print_fec_schemes()
     // print all available MOD schemes
     printf("          ");
     for (i=0; i<LIQUID_FEC_NUM_SCHEMES; i++) {
-#if !LIBFEC_ENABLED
-        if ( fec_scheme_is_convolutional(i) || fec_scheme_is_reedsolomon(i) )
-            continue;
-#endif
         printf("%s", fec_scheme_str[i][0]);
 
         if (i != LIQUID_FEC_NUM_SCHEMES-1)
@@ -219,7 +215,6 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
     case LIQUID_FEC_SECDED3932:     return _msg_len + _msg_len/4 + ((_msg_len%4) ? 1 : 0);
     case LIQUID_FEC_SECDED7264:     return _msg_len + _msg_len/8 + ((_msg_len%8) ? 1 : 0);
 
-#if LIBFEC_ENABLED
     // convolutional codes
     case LIQUID_FEC_CONV_V27:       return 2*_msg_len + 2;  // (K-1)/r=12, round up to 2 bytes
     case LIQUID_FEC_CONV_V29:       return 2*_msg_len + 2;  // (K-1)/r=16, 2 bytes
@@ -241,32 +236,6 @@ unsigned int fec_get_enc_msg_length(fec_scheme _scheme,
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:          return fec_rs_get_enc_msg_len(_msg_len,32,255,223);
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr, "error: fec_get_enc_msg_length(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
     default:
         printf("error: fec_get_enc_msg_length(), unknown/unsupported scheme: %d\n", _scheme);
         exit(-1);
@@ -414,7 +383,6 @@ float fec_get_rate(fec_scheme _scheme)
     case LIQUID_FEC_SECDED7264:     return 8./9.;
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:       return 1./2.;
     case LIQUID_FEC_CONV_V29:       return 1./2.;
     case LIQUID_FEC_CONV_V39:       return 1./3.;
@@ -434,32 +402,6 @@ float fec_get_rate(fec_scheme _scheme)
 
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:          return 223./255.;
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_get_rate(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_get_rate(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
 
     default:
         printf("error: fec_get_rate(), unknown/unsupported scheme: %d\n", _scheme);
@@ -502,7 +444,6 @@ fec fec_create(fec_scheme _scheme, void *_opts)
         return fec_secded7264_create(_opts);
 
     // convolutional codes
-#if LIBFEC_ENABLED
     case LIQUID_FEC_CONV_V27:
     case LIQUID_FEC_CONV_V29:
     case LIQUID_FEC_CONV_V39:
@@ -528,32 +469,6 @@ fec fec_create(fec_scheme _scheme, void *_opts)
     // Reed-Solomon codes
     case LIQUID_FEC_RS_M8:
         return fec_rs_create(_scheme);
-#else
-    case LIQUID_FEC_CONV_V27:
-    case LIQUID_FEC_CONV_V29:
-    case LIQUID_FEC_CONV_V39:
-    case LIQUID_FEC_CONV_V615:
-
-    case LIQUID_FEC_CONV_V27P23:
-    case LIQUID_FEC_CONV_V27P34:
-    case LIQUID_FEC_CONV_V27P45:
-    case LIQUID_FEC_CONV_V27P56:
-    case LIQUID_FEC_CONV_V27P67:
-    case LIQUID_FEC_CONV_V27P78:
-
-    case LIQUID_FEC_CONV_V29P23:
-    case LIQUID_FEC_CONV_V29P34:
-    case LIQUID_FEC_CONV_V29P45:
-    case LIQUID_FEC_CONV_V29P56:
-    case LIQUID_FEC_CONV_V29P67:
-    case LIQUID_FEC_CONV_V29P78:
-        fprintf(stderr,"error: fec_create(), convolutional codes unavailable (install libfec)\n");
-        exit(-1);
-
-    case LIQUID_FEC_RS_M8:
-        fprintf(stderr,"error: fec_create(), Reed-Solomon codes unavailable (install libfec)\n");
-        exit(-1);
-#endif
 
     default:
         printf("error: fec_create(), unknown/unsupported scheme: %d\n", _scheme);
@@ -586,7 +501,16 @@ fec fec_recreate(fec _q,
 // destroy fec object
 void fec_destroy(fec _q)
 {
-    free(_q);
+    // convolutional and Reed-Solomon codes own a decoder object and
+    // buffers
+    if (fec_scheme_is_punctured(_q->scheme))
+        fec_conv_punctured_destroy(_q);
+    else if (fec_scheme_is_convolutional(_q->scheme))
+        fec_conv_destroy(_q);
+    else if (fec_scheme_is_reedsolomon(_q->scheme))
+        fec_rs_destroy(_q);
+    else
+        free(_q);
 }
 
 // print basic fec object internals
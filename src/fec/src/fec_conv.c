@@ -30,9 +30,6 @@
 
 #define VERBOSE_FEC_CONV    0
 
-#if LIBFEC_ENABLED
-#include "fec.h"
-
 fec fec_conv_create(fec_scheme _fs)
 {
     fec q = (fec) malloc(sizeof(struct fec_s));
@@ -66,8 +63,9 @@ void fec_conv_destroy(fec _q)
 {
     // delete viterbi decoder
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        fec_viterbi_destroy(_q->vp);
 
+    free(_q->enc_bits);
     free(_q);
 }
 
@@ -95,7 +93,7 @@ void fec_conv_encode(fec _q,
 
             // compute parity bits for each polynomial
             for (r=0; r<_q->R; r++) {
-                byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+                byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
                 _msg_enc[n/8] = byte_out;
                 n++;
             }
@@ -109,7 +107,7 @@ void fec_conv_encode(fec _q,
 
         // compute parity bits for each polynomial
         for (r=0; r<_q->R; r++) {
-            byte_out = (byte_out<<1) | parity(sr & _q->poly[r]);
+            byte_out = (byte_out<<1) | liquid_count_ones_mod2(sr & _q->poly[r]);
             _msg_enc[n/8] = byte_out;
             n++;
         }
@@ -186,9 +184,9 @@ void fec_conv_decode(fec _q,
                      unsigned char *_msg_dec)
 {
     // run decoder
-    _q->init_viterbi(_q->vp,0);
-    _q->update_viterbi_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
-    _q->chainback_viterbi(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
+    fec_viterbi_init(_q->vp, 0);
+    fec_viterbi_update_blk(_q->vp, _q->enc_bits, 8*_q->num_dec_bytes+_q->K-1);
+    fec_viterbi_chainback(_q->vp, _msg_dec, 8*_q->num_dec_bytes, 0);
 
 #if VERBOSE_FEC_CONV
     for (i=0; i<_dec_msg_len; i++)
@@ -217,10 +215,10 @@ void fec_conv_setlength(fec _q, unsigned int _dec_msg_len)
 
     // delete old decoder if necessary
     if (_q->vp != NULL)
-        _q->delete_viterbi(_q->vp);
+        fec_viterbi_destroy(_q->vp);
 
     // re-create / re-allocate memory buffers
-    _q->vp = _q->create_viterbi(8*_q->num_dec_bytes);
+    _q->vp = fec_viterbi_create(_q->K, _q->R, _q->poly, 8*_q->num_dec_bytes);
     _q->enc_bits = (unsigned char*) realloc(_q->enc_bits,
                                             _q->num_enc_bytes*8*sizeof(unsigned char));
 }
@@ -234,11 +232,6 @@ void fec_conv_init_v27(fec _q)
     _q->R=2;
     _q->K=7;
     _q->poly = fec_conv27_poly;
-    _q->create_viterbi = create_viterbi27;
-    _q->init_viterbi = init_viterbi27;
-    _q->update_viterbi_blk = update_viterbi27_blk;
-    _q->chainback_viterbi = chainback_viterbi27;
-    _q->delete_viterbi = delete_viterbi27;
 }
 
 void fec_conv_init_v29(fec _q)
@@ -246,11 +239,6 @@ void fec_conv_init_v29(fec _q)
     _q->R=2;
     _q->K=9;
     _q->poly = fec_conv29_poly;
-    _q->create_viterbi = create_viterbi29;
-    _q->init_viterbi = init_viterbi29;
-    _q->update_viterbi_blk = update_viterbi29_blk;
-    _q->chainback_viterbi = chainback_viterbi29;
-    _q->delete_viterbi = delete_viterbi29;
 }
 
 void fec_conv_init_v39(fec _q)
@@ -258,11 +246,6 @@ void fec_conv_init_v39(fec _q)
     _q->R=3;
     _q->K=9;
     _q->poly = fec_conv39_poly;
-    _q->create_viterbi = create_viterbi39;
-    _q->init_viterbi = init_viterbi39;
-    _q->update_viterbi_blk = update_viterbi39_blk;
-    _q->chainback_viterbi = chainback_viterbi39;
-    _q->delete_viterbi = delete_viterbi39;
 }
 
 void fec_conv_init_v615(fec _q)
@@ -270,25 +253,5 @@ void fec_conv_init_v615(fec _q)
     _q->R=6;
     _q->K=15;
     _q->poly = fec_conv615_poly;
-    _q->create_viterbi = create_viterbi615;
-    _q->init_viterbi = init_viterbi615;
-    _q->update_viterbi_blk = update_viterbi615_blk;
-    _q->chainback_viterbi = chainback_viterbi615;
-    _q->delete_viterbi = delete_viterbi615;
 }
 
-
-
-#else   // LIBFEC_ENABLED
-
-fec fec_conv_create(fec_scheme _fs)
-{
-    return NULL;
-}
-
-void fec_conv_destroy(fec _q)
-{
-}
-
-#endif  // LIBFEC_ENABLED
-
@@ -24,32 +24,22 @@
 
 #include "liquid.internal.h"
 
-#if LIBFEC_ENABLED
-#include <fec.h>
-
-int fec_conv27_poly[2]  = {V27POLYA,
-                           V27POLYB};
-
-int fec_conv29_poly[2]  = {V29POLYA,
-                           V29POLYB};
-
-int fec_conv39_poly[3]  = {V39POLYA,
-                           V39POLYB,
-                           V39POLYC};
-
-int fec_conv615_poly[6] = {V615POLYA,
-                           V615POLYB,
-                           V615POLYC,
-                           V615POLYD,
-                           V615POLYE,
-                           V615POLYF};
-
-#else
-
-int fec_conv27_poly[2]  = {0,0};
-int fec_conv29_poly[2]  = {0,0};
-int fec_conv39_poly[3]  = {0,0,0};
-int fec_conv615_poly[6] = {0,0,0,0,0,0};
-
-#endif
+// generator polynomials (compatible with libfec); the newest input
+// bit is the least-significant bit of the shift register
+int fec_conv27_poly[2]  = {0x4f,    // V27POLYA
+                           0x6d};   // V27POLYB
+
+int fec_conv29_poly[2]  = {0x1af,   // V29POLYA
+                           0x11d};  // V29POLYB
+
+int fec_conv39_poly[3]  = {0x1ed,   // V39POLYA
+                           0x19b,   // V39POLYB
+                           0x127};  // V39POLYC
+
+int fec_conv615_poly[6] = {042631,  // V615POLYA
+                           047245,  // V615POLYB
+                           056507,  // V615POLYC
+                           073363,  // V615POLYD
+                           077267,  // V615POLYE
+                           064537}; // V615POLYF
 
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_rscodec.avx.c : Reed-Solomon syndromes and parity (AVX2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// multiply each byte of _x by the constant whose nibble product tables
+// are _tlo, _thi (repeated in both lanes)
+__attribute__((target("avx2"), always_inline))
+static inline __m256i fec_rscodec_mul_avx2(__m256i _x,
+                                           __m256i _tlo,
+                                           __m256i _thi)
+{
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(_x, mask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(_x, 4), mask);
+    return _mm256_xor_si256(_mm256_shuffle_epi8(_tlo, lo),
+                            _mm256_shuffle_epi8(_thi, hi));
+}
+
+// 128-bit version for folding
+__attribute__((target("avx2"), always_inline))
+static inline __m128i fec_rscodec_mul_avx2_128(__m128i _x,
+                                               __m128i _tlo,
+                                               __m128i _thi)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i lo = _mm_and_si128(_x, mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(_x, 4), mask);
+    return _mm_xor_si128(_mm_shuffle_epi8(_tlo, lo),
+                         _mm_shuffle_epi8(_thi, hi));
+}
+
+// load 16-byte table into both lanes
+__attribute__((target("avx2"), always_inline))
+static inline __m256i fec_rscodec_bcast_avx2(unsigned char * _t)
+{
+    return _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)_t));
+}
+
+// compute syndromes with blocked Horner's rule (W=32)
+__attribute__((target("avx2")))
+void fec_rscodec_syndromes_avx2(unsigned int    _nroots,
+                                unsigned char * _tab,
+                                unsigned char * _r,
+                                unsigned int    _n,
+                                unsigned char * _s)
+{
+    unsigned int i, j;
+    for (j=0; j<_nroots; j++) {
+        unsigned char * t = _tab + 32*6*j;
+
+        // accumulate every 32nd symbol: acc <- acc*beta^32 + r
+        __m256i tlo = fec_rscodec_bcast_avx2(t);
+        __m256i thi = fec_rscodec_bcast_avx2(t + 16);
+        __m256i acc = _mm256_setzero_si256();
+        for (i=0; i<_n; i+=32) {
+            __m256i r = _mm256_loadu_si256((__m256i*)(_r + i));
+            acc = _mm256_xor_si256(fec_rscodec_mul_avx2(acc, tlo, thi), r);
+        }
+
+        // fold lanes l, l+16 with beta^16; l, l+8 with beta^8; ...
+        __m128i v = _mm_xor_si128(fec_rscodec_mul_avx2_128(_mm256_castsi256_si128(acc),
+                                                           _mm_loadu_si128((__m128i*)(t+32)),
+                                                           _mm_loadu_si128((__m128i*)(t+48))),
+                                  _mm256_extracti128_si256(acc, 1));
+        v = _mm_xor_si128(fec_rscodec_mul_avx2_128(v, _mm_loadu_si128((__m128i*)(t+ 64)), _mm_loadu_si128((__m128i*)(t+ 80))),
+                          _mm_srli_si128(v, 8));
+        v = _mm_xor_si128(fec_rscodec_mul_avx2_128(v, _mm_loadu_si128((__m128i*)(t+ 96)), _mm_loadu_si128((__m128i*)(t+112))),
+                          _mm_srli_si128(v, 4));
+        v = _mm_xor_si128(fec_rscodec_mul_avx2_128(v, _mm_loadu_si128((__m128i*)(t+128)), _mm_loadu_si128((__m128i*)(t+144))),
+                          _mm_srli_si128(v, 2));
+        v = _mm_xor_si128(fec_rscodec_mul_avx2_128(v, _mm_loadu_si128((__m128i*)(t+160)), _mm_loadu_si128((__m128i*)(t+176))),
+                          _mm_srli_si128(v, 1));
+        _s[j] = _mm_cvtsi128_si32(v) & 0xff;
+    }
+}
+
+// compute parity symbols, 32 at a time
+__attribute__((target("avx2")))
+void fec_rscodec_encode_avx2(unsigned int    _nroots,
+                             unsigned char * _mtab,
+                             unsigned char * _rem,
+                             unsigned char * _data,
+                             unsigned int    _k,
+                             unsigned char * _parity)
+{
+    unsigned int i, c;
+    for (c=0; c<_nroots; c+=32) {
+        __m256i acc0 = _mm256_setzero_si256();
+        __m256i acc1 = _mm256_setzero_si256();
+        unsigned char * rem = _rem + (_k-1)*2*_nroots + c;
+        for (i=0; i<_k; i++) {
+            unsigned char * t = _mtab + 32*_data[i];
+            __m256i rlo = _mm256_loadu_si256((__m256i*)(rem));
+            __m256i rhi = _mm256_loadu_si256((__m256i*)(rem + _nroots));
+            acc0 = _mm256_xor_si256(acc0, _mm256_shuffle_epi8(fec_rscodec_bcast_avx2(t),    rlo));
+            acc1 = _mm256_xor_si256(acc1, _mm256_shuffle_epi8(fec_rscodec_bcast_avx2(t+16), rhi));
+            rem -= 2*_nroots;
+        }
+        _mm256_storeu_si256((__m256i*)(_parity + c), _mm256_xor_si256(acc0, acc1));
+    }
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -0,0 +1,497 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_rscodec.c : Reed-Solomon codec over GF(2^8)
+//
+// Code words are compatible with the Karn/libfec "char" codec: the
+// message occupies the highest-degree coefficients followed by the
+// parity symbols, and shortened codes are described by a number of
+// implicit leading zero (padding) symbols.
+//
+// Syndromes are evaluated with a blocked Horner scheme: lane l of a
+// W-wide vector accumulates every W-th received symbol, so each step
+// multiplies all lanes by the same constant beta^W, and the lanes are
+// then folded pairwise with constants beta^(W/2), ..., beta. Parity
+// symbols are the sum of message symbols times precomputed remainders
+// x^(nroots+m) mod g(x). Multiplication by a scalar uses 16-entry
+// nibble product tables (pshufb).
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#define DEBUG_FEC_RSCODEC 0
+
+#define RS_NN   (255)       // code word length (symbols)
+#define RS_A0   (RS_NN)     // log of zero (index form)
+
+struct fec_rscodec_s {
+    unsigned int nroots;        // number of parity symbols
+    unsigned int fcr;           // first consecutive root (index form)
+    unsigned int prim;          // primitive element (index form)
+    unsigned int iprim;         // prim-th root of 1 (index form)
+    unsigned int pad;           // padding symbols
+    unsigned int kk;            // message symbols (unshortened)
+
+    unsigned char alpha_to[256];// antilog table
+    unsigned char index_of[256];// log table
+    unsigned char * genpoly;    // generator polynomial (index form)
+
+    // vectorized syndromes/encoding
+    liquid_simd_level simd;     // syndrome kernel
+    liquid_simd_level simd_enc; // encoding kernel
+    unsigned int W;             // syndrome vector width
+    unsigned char * stab;       // syndrome constant tables
+    unsigned char * mtab;       // nibble product tables [256 x 32]
+    unsigned char * rem;        // remainder nibbles [kk x 2*nroots]
+    unsigned char * buf;        // zero-padded received block
+
+    // decoder scratch
+    unsigned char * s;          // syndromes
+    int * lambda;               // error locator polynomial
+    int * b;
+    int * t;
+    int * omega;                // error evaluator polynomial
+    int * reg;
+    int * root;                 // roots of error locator
+    int * loc;                  // error locations
+};
+
+// reduce x modulo 255
+static inline unsigned int fec_rscodec_modnn(unsigned int _x)
+{
+    while (_x >= RS_NN) {
+        _x -= RS_NN;
+        _x = (_x >> 8) + (_x & RS_NN);
+    }
+    return _x;
+}
+
+// multiply in GF(2^8)
+static unsigned char fec_rscodec_mul(fec_rscodec   _q,
+                                     unsigned char _a,
+                                     unsigned char _b)
+{
+    if (_a == 0 || _b == 0)
+        return 0;
+    return _q->alpha_to[fec_rscodec_modnn(_q->index_of[_a] + _q->index_of[_b])];
+}
+
+// alpha^_e for any non-negative exponent
+static unsigned char fec_rscodec_pow(fec_rscodec  _q,
+                                     unsigned int _e)
+{
+    return _q->alpha_to[_e % RS_NN];
+}
+
+// nibble product tables for multiplying by _c: [_c*n, _c*(n<<4)]
+static void fec_rscodec_nibble_tables(fec_rscodec     _q,
+                                      unsigned char   _c,
+                                      unsigned char * _tab)
+{
+    unsigned int n;
+    for (n=0; n<16; n++) {
+        _tab[n   ] = fec_rscodec_mul(_q, _c, n);
+        _tab[n+16] = fec_rscodec_mul(_q, _c, n << 4);
+    }
+}
+
+// create Reed-Solomon codec
+//  _gfpoly :   field generator polynomial, e.g. 0x11d
+//  _fcr    :   first consecutive root of code generator (index form)
+//  _prim   :   primitive element generating the roots (index form)
+//  _nroots :   number of parity symbols, 0 < _nroots < 255
+//  _pad    :   number of implicit leading zero (padding) symbols
+fec_rscodec fec_rscodec_create(unsigned int _gfpoly,
+                               unsigned int _fcr,
+                               unsigned int _prim,
+                               unsigned int _nroots,
+                               unsigned int _pad)
+{
+    // validate input
+    if (_fcr >= 256 || _prim == 0 || _prim >= 256) {
+        fprintf(stderr,"error: fec_rscodec_create(), invalid first root/primitive element\n");
+        exit(1);
+    } else if (_nroots == 0 || _nroots >= RS_NN) {
+        fprintf(stderr,"error: fec_rscodec_create(), number of roots must be in [1,254]\n");
+        exit(1);
+    } else if (_pad >= RS_NN - _nroots) {
+        fprintf(stderr,"error: fec_rscodec_create(), too much padding\n");
+        exit(1);
+    }
+
+    fec_rscodec q = (fec_rscodec) malloc(sizeof(struct fec_rscodec_s));
+    q->nroots = _nroots;
+    q->fcr    = _fcr;
+    q->prim   = _prim;
+    q->pad    = _pad;
+    q->kk     = RS_NN - _nroots;
+
+    // generate Galois field lookup tables
+    unsigned int i, j, sr = 1;
+    q->index_of[0] = RS_A0;
+    q->alpha_to[RS_A0] = 0;
+    for (i=0; i<RS_NN; i++) {
+        q->index_of[sr] = i;
+        q->alpha_to[i] = sr;
+        sr <<= 1;
+        if (sr & 0x100)
+            sr ^= _gfpoly;
+        sr &= 0xff;
+    }
+    if (sr != 1) {
+        fprintf(stderr,"error: fec_rscodec_create(), field generator polynomial 0x%x is not primitive\n", _gfpoly);
+        exit(1);
+    }
+
+    // find prim-th root of 1, used in decoding
+    for (q->iprim=1; (q->iprim % _prim) != 0; q->iprim += RS_NN)
+        ;
+    q->iprim /= _prim;
+
+    // form generator polynomial from its roots (polynomial form, then
+    // convert to index form)
+    unsigned char g[_nroots+1];
+    unsigned int root;
+    g[0] = 1;
+    for (i=0, root=_fcr*_prim; i<_nroots; i++, root+=_prim) {
+        g[i+1] = 1;
+        for (j=i; j>0; j--)
+            g[j] = g[j-1] ^ fec_rscodec_mul(q, g[j], fec_rscodec_pow(q,root));
+        g[0] = fec_rscodec_mul(q, g[0], fec_rscodec_pow(q,root));
+    }
+    q->genpoly = (unsigned char*) malloc((_nroots+1)*sizeof(unsigned char));
+    for (i=0; i<=_nroots; i++)
+        q->genpoly[i] = q->index_of[g[i]];
+
+    // select kernels; vector kernels need pshufb (SSSE3)
+    unsigned int features = liquid_cpu_get_features();
+    q->simd = liquid_cpu_get_simd_level();
+    if (q->simd >= LIQUID_SIMD_AVX2)
+        q->simd = LIQUID_SIMD_AVX2;
+    else if (features & LIQUID_CPU_SSSE3)
+        q->simd = LIQUID_SIMD_SSE;
+    else
+        q->simd = LIQUID_SIMD_NONE;
+    q->simd_enc = q->simd;
+    if (q->simd_enc == LIQUID_SIMD_AVX2 && (_nroots % 32) != 0)
+        q->simd_enc = LIQUID_SIMD_SSE;
+    if (q->simd_enc == LIQUID_SIMD_SSE && (_nroots % 16) != 0)
+        q->simd_enc = LIQUID_SIMD_NONE;
+
+    // syndrome tables: for each root beta, constants beta^W,
+    // beta^(W/2), ..., beta
+    q->W = q->simd == LIQUID_SIMD_AVX2 ? 32 : 16;
+    unsigned int log2W = q->W == 32 ? 5 : 4;
+    q->stab = NULL;
+    if (q->simd != LIQUID_SIMD_NONE) {
+        q->stab = (unsigned char*) malloc(_nroots*32*(log2W+1)*sizeof(unsigned char));
+        for (i=0; i<_nroots; i++) {
+            unsigned int e = ((_fcr + i)*_prim) % RS_NN;
+            for (j=0; j<=log2W; j++)
+                fec_rscodec_nibble_tables(q, fec_rscodec_pow(q, e*(q->W >> j)), &q->stab[32*((log2W+1)*i + j)]);
+        }
+    }
+
+    // encoding tables: nibble products for every symbol value, and
+    // remainders x^(nroots+m) mod g(x) split into nibbles (lane k is
+    // the coefficient of x^(nroots-1-k))
+    q->mtab = NULL;
+    q->rem  = NULL;
+    if (q->simd_enc != LIQUID_SIMD_NONE) {
+        q->mtab = (unsigned char*) malloc(256*32*sizeof(unsigned char));
+        for (i=0; i<256; i++)
+            fec_rscodec_nibble_tables(q, i, &q->mtab[32*i]);
+
+        q->rem = (unsigned char*) malloc(q->kk*2*_nroots*sizeof(unsigned char));
+        unsigned char r[_nroots];   // r[k] : coefficient of x^k
+        memmove(r, g, _nroots*sizeof(unsigned char));
+        unsigned int m;
+        for (m=0; m<q->kk; m++) {
+            for (j=0; j<_nroots; j++) {
+                unsigned char c = r[_nroots-1-j];
+                q->rem[m*2*_nroots +           j] = c & 0x0f;
+                q->rem[m*2*_nroots + _nroots + j] = c >> 4;
+            }
+
+            // multiply by x and reduce
+            unsigned char c = r[_nroots-1];
+            for (j=_nroots-1; j>0; j--)
+                r[j] = r[j-1] ^ fec_rscodec_mul(q, c, g[j]);
+            r[0] = fec_rscodec_mul(q, c, g[0]);
+        }
+    }
+
+    q->buf    = (unsigned char*) malloc(256*sizeof(unsigned char));
+    q->s      = (unsigned char*) malloc(_nroots*sizeof(unsigned char));
+    q->lambda = (int*) malloc((_nroots+1)*sizeof(int));
+    q->b      = (int*) malloc((_nroots+1)*sizeof(int));
+    q->t      = (int*) malloc((_nroots+1)*sizeof(int));
+    q->omega  = (int*) malloc((_nroots+1)*sizeof(int));
+    q->reg    = (int*) malloc((_nroots+1)*sizeof(int));
+    q->root   = (int*) malloc(_nroots*sizeof(int));
+    q->loc    = (int*) malloc(_nroots*sizeof(int));
+    return q;
+}
+
+// destroy Reed-Solomon codec object
+void fec_rscodec_destroy(fec_rscodec _q)
+{
+    free(_q->genpoly);
+    free(_q->stab);
+    free(_q->mtab);
+    free(_q->rem);
+    free(_q->buf);
+    free(_q->s);
+    free(_q->lambda);
+    free(_q->b);
+    free(_q->t);
+    free(_q->omega);
+    free(_q->reg);
+    free(_q->root);
+    free(_q->loc);
+    free(_q);
+}
+
+// encode block, computing parity symbols
+//  _q      :   codec object
+//  _data   :   message symbols [size: 255-_nroots-_pad x 1]
+//  _parity :   parity symbols [size: _nroots x 1]
+void fec_rscodec_encode(fec_rscodec     _q,
+                        unsigned char * _data,
+                        unsigned char * _parity)
+{
+    unsigned int k = _q->kk - _q->pad;
+
+    switch (_q->simd_enc) {
+#if LIQUID_CPU_X86
+    case LIQUID_SIMD_AVX2:
+        fec_rscodec_encode_avx2(_q->nroots, _q->mtab, _q->rem, _data, k, _parity);
+        return;
+    case LIQUID_SIMD_SSE:
+        fec_rscodec_encode_sse(_q->nroots, _q->mtab, _q->rem, _data, k, _parity);
+        return;
+#endif
+    default:;
+    }
+
+    // linear-feedback shift register
+    unsigned int nroots = _q->nroots;
+    unsigned int i, j;
+    memset(_parity, 0x00, nroots*sizeof(unsigned char));
+    for (i=0; i<k; i++) {
+        unsigned int feedback = _q->index_of[_data[i] ^ _parity[0]];
+        if (feedback != RS_A0) {
+            for (j=1; j<nroots; j++)
+                _parity[j] ^= _q->alpha_to[fec_rscodec_modnn(feedback + _q->genpoly[nroots-j])];
+        }
+        memmove(&_parity[0], &_parity[1], (nroots-1)*sizeof(unsigned char));
+        _parity[nroots-1] = feedback != RS_A0 ?
+            _q->alpha_to[fec_rscodec_modnn(feedback + _q->genpoly[0])] : 0;
+    }
+}
+
+// compute syndromes (polynomial form) of received block
+static void fec_rscodec_syndromes(fec_rscodec     _q,
+                                  unsigned char * _data)
+{
+    unsigned int n = RS_NN - _q->pad;
+    unsigned int i, j;
+
+    if (_q->simd != LIQUID_SIMD_NONE) {
+        // prepend zeros to a multiple of the vector width
+        unsigned int np = ((n + _q->W - 1) / _q->W) * _q->W;
+        memset(_q->buf, 0x00, (np-n)*sizeof(unsigned char));
+        memmove(&_q->buf[np-n], _data, n*sizeof(unsigned char));
+
+        switch (_q->simd) {
+#if LIQUID_CPU_X86
+        case LIQUID_SIMD_AVX2:
+            fec_rscodec_syndromes_avx2(_q->nroots, _q->stab, _q->buf, np, _q->s);
+            return;
+        case LIQUID_SIMD_SSE:
+            fec_rscodec_syndromes_sse(_q->nroots, _q->stab, _q->buf, np, _q->s);
+            return;
+#endif
+        default:;
+        }
+    }
+
+    // Horner's rule
+    for (i=0; i<_q->nroots; i++) {
+        unsigned int e = fec_rscodec_modnn((_q->fcr + i)*_q->prim);
+        unsigned char s = _data[0];
+        for (j=1; j<n; j++)
+            s = _data[j] ^ (s == 0 ? 0 : _q->alpha_to[fec_rscodec_modnn(_q->index_of[s] + e)]);
+        _q->s[i] = s;
+    }
+}
+
+// decode block in place, returning number of corrected symbols or -1
+// if the block could not be corrected
+//  _q      :   codec object
+//  _data   :   received block, message then parity symbols
+//              [size: 255-_pad x 1]
+int fec_rscodec_decode(fec_rscodec     _q,
+                       unsigned char * _data)
+{
+    unsigned int nroots = _q->nroots;
+    int * lambda = _q->lambda;
+    int * b      = _q->b;
+    int * t      = _q->t;
+    int * omega  = _q->omega;
+    int * reg    = _q->reg;
+    int * root   = _q->root;
+    int * loc    = _q->loc;
+    int i, j, r, k;
+
+    // compute syndromes; done if all are zero
+    fec_rscodec_syndromes(_q, _data);
+    int syn_error = 0;
+    for (i=0; i<(int)nroots; i++)
+        syn_error |= _q->s[i];
+    if (!syn_error)
+        return 0;
+
+    // syndromes to index form
+    int s[nroots];
+    for (i=0; i<(int)nroots; i++)
+        s[i] = _q->index_of[_q->s[i]];
+
+    // Berlekamp-Massey: find error locator polynomial lambda(x)
+    memset(lambda, 0x00, (nroots+1)*sizeof(int));
+    lambda[0] = 1;
+    for (i=0; i<=(int)nroots; i++)
+        b[i] = _q->index_of[lambda[i]];
+
+    int el = 0;
+    for (r=1; r<=(int)nroots; r++) {
+        // discrepancy at step r (polynomial form)
+        int discr_r = 0;
+        for (i=0; i<r; i++) {
+            if (lambda[i] != 0 && s[r-i-1] != RS_A0)
+                discr_r ^= _q->alpha_to[fec_rscodec_modnn(_q->index_of[lambda[i]] + s[r-i-1])];
+        }
+        discr_r = _q->index_of[discr_r];
+
+        if (discr_r == RS_A0) {
+            // b(x) <- x*b(x)
+            memmove(&b[1], b, nroots*sizeof(int));
+            b[0] = RS_A0;
+        } else {
+            // t(x) <- lambda(x) - discr_r*x*b(x)
+            t[0] = lambda[0];
+            for (i=0; i<(int)nroots; i++) {
+                t[i+1] = b[i] != RS_A0 ?
+                    lambda[i+1] ^ _q->alpha_to[fec_rscodec_modnn(discr_r + b[i])] :
+                    lambda[i+1];
+            }
+            if (2*el <= r-1) {
+                el = r - el;
+                // b(x) <- inv(discr_r) * lambda(x)
+                for (i=0; i<=(int)nroots; i++) {
+                    b[i] = lambda[i] == 0 ? RS_A0 :
+                        (int)fec_rscodec_modnn(_q->index_of[lambda[i]] - discr_r + RS_NN);
+                }
+            } else {
+                memmove(&b[1], b, nroots*sizeof(int));
+                b[0] = RS_A0;
+            }
+            memmove(lambda, t, (nroots+1)*sizeof(int));
+        }
+    }
+
+    // convert lambda to index form and compute its degree
+    int deg_lambda = 0;
+    for (i=0; i<=(int)nroots; i++) {
+        lambda[i] = _q->index_of[lambda[i]];
+        if (lambda[i] != RS_A0)
+            deg_lambda = i;
+    }
+
+    // Chien search: find roots of error locator polynomial
+    memmove(&reg[1], &lambda[1], nroots*sizeof(int));
+    int count = 0;
+    for (i=1, k=_q->iprim-1; i<=RS_NN; i++, k=fec_rscodec_modnn(k+_q->iprim)) {
+        int v = 1;  // lambda[0] is always 1
+        for (j=deg_lambda; j>0; j--) {
+            if (reg[j] != RS_A0) {
+                reg[j] = fec_rscodec_modnn(reg[j] + j);
+                v ^= _q->alpha_to[reg[j]];
+            }
+        }
+        if (v != 0)
+            continue;
+
+        // store root (index form) and error location
+        root[count] = i;
+        loc[count]  = k;
+        if (++count == deg_lambda)
+            break;
+    }
+    if (deg_lambda != count) {
+        // number of roots differs from degree: uncorrectable
+#if DEBUG_FEC_RSCODEC
+        printf("fec_rscodec_decode(), uncorrectable (deg(lambda)=%d, roots=%d)\n", deg_lambda, count);
+#endif
+        return -1;
+    }
+
+    // error evaluator omega(x) = s(x)*lambda(x) mod x^nroots (index form)
+    int deg_omega = deg_lambda - 1;
+    for (i=0; i<=deg_omega; i++) {
+        int tmp = 0;
+        for (j=i; j>=0; j--) {
+            if (s[i-j] != RS_A0 && lambda[j] != RS_A0)
+                tmp ^= _q->alpha_to[fec_rscodec_modnn(s[i-j] + lambda[j])];
+        }
+        omega[i] = _q->index_of[tmp];
+    }
+
+    // Forney: error values are omega(1/X)*X^(1-fcr) / lambda'(1/X)
+    for (j=count-1; j>=0; j--) {
+        int num1 = 0;
+        for (i=deg_omega; i>=0; i--) {
+            if (omega[i] != RS_A0)
+                num1 ^= _q->alpha_to[fec_rscodec_modnn(omega[i] + i*root[j])];
+        }
+        int num2 = _q->alpha_to[fec_rscodec_modnn(root[j]*(_q->fcr + RS_NN - 1) + RS_NN)];
+
+        // lambda'(x) has only odd-power terms of lambda
+        int den = 0;
+        int imax = deg_lambda < (int)nroots-1 ? deg_lambda : (int)nroots-1;
+        for (i=imax & ~1; i>=0; i-=2) {
+            if (lambda[i+1] != RS_A0)
+                den ^= _q->alpha_to[fec_rscodec_modnn(lambda[i+1] + i*root[j])];
+        }
+        if (den == 0 || loc[j] < (int)_q->pad)
+            return -1;
+
+        if (num1 != 0) {
+            _data[loc[j] - _q->pad] ^= _q->alpha_to[fec_rscodec_modnn(
+                _q->index_of[num1] + _q->index_of[num2] + RS_NN - _q->index_of[den])];
+        }
+    }
+    return count;
+}
+
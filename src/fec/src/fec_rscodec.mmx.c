@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_rscodec.mmx.c : Reed-Solomon syndromes and parity (SSSE3)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <tmmintrin.h>
+
+// multiply each byte of _x by the constant whose nibble product tables
+// are _tlo, _thi
+__attribute__((target("ssse3"), always_inline))
+static inline __m128i fec_rscodec_mul_sse(__m128i _x,
+                                          __m128i _tlo,
+                                          __m128i _thi)
+{
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i lo = _mm_and_si128(_x, mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(_x, 4), mask);
+    return _mm_xor_si128(_mm_shuffle_epi8(_tlo, lo),
+                         _mm_shuffle_epi8(_thi, hi));
+}
+
+// compute syndromes with blocked Horner's rule (W=16)
+__attribute__((target("ssse3")))
+void fec_rscodec_syndromes_sse(unsigned int    _nroots,
+                               unsigned char * _tab,
+                               unsigned char * _r,
+                               unsigned int    _n,
+                               unsigned char * _s)
+{
+    unsigned int i, j;
+    for (j=0; j<_nroots; j++) {
+        __m128i * t = (__m128i*)(_tab + 32*5*j);
+
+        // accumulate every 16th symbol: acc <- acc*beta^16 + r
+        __m128i tlo = _mm_loadu_si128(t+0);
+        __m128i thi = _mm_loadu_si128(t+1);
+        __m128i acc = _mm_setzero_si128();
+        for (i=0; i<_n; i+=16) {
+            __m128i r = _mm_loadu_si128((__m128i*)(_r + i));
+            acc = _mm_xor_si128(fec_rscodec_mul_sse(acc, tlo, thi), r);
+        }
+
+        // fold lanes l, l+8 with beta^8; l, l+4 with beta^4; ...
+        acc = _mm_xor_si128(fec_rscodec_mul_sse(acc, _mm_loadu_si128(t+2), _mm_loadu_si128(t+3)),
+                            _mm_srli_si128(acc, 8));
+        acc = _mm_xor_si128(fec_rscodec_mul_sse(acc, _mm_loadu_si128(t+4), _mm_loadu_si128(t+5)),
+                            _mm_srli_si128(acc, 4));
+        acc = _mm_xor_si128(fec_rscodec_mul_sse(acc, _mm_loadu_si128(t+6), _mm_loadu_si128(t+7)),
+                            _mm_srli_si128(acc, 2));
+        acc = _mm_xor_si128(fec_rscodec_mul_sse(acc, _mm_loadu_si128(t+8), _mm_loadu_si128(t+9)),
+                            _mm_srli_si128(acc, 1));
+        _s[j] = _mm_cvtsi128_si32(acc) & 0xff;
+    }
+}
+
+// compute parity symbols, 16 at a time
+__attribute__((target("ssse3")))
+void fec_rscodec_encode_sse(unsigned int    _nroots,
+                            unsigned char * _mtab,
+                            unsigned char * _rem,
+                            unsigned char * _data,
+                            unsigned int    _k,
+                            unsigned char * _parity)
+{
+    unsigned int i, c;
+    for (c=0; c<_nroots; c+=16) {
+        __m128i acc = _mm_setzero_si128();
+        unsigned char * rem = _rem + (_k-1)*2*_nroots + c;
+        for (i=0; i<_k; i++) {
+            __m128i * t = (__m128i*)(_mtab + 32*_data[i]);
+            __m128i rlo = _mm_loadu_si128((__m128i*)(rem));
+            __m128i rhi = _mm_loadu_si128((__m128i*)(rem + _nroots));
+            acc = _mm_xor_si128(acc, _mm_shuffle_epi8(_mm_loadu_si128(t+0), rlo));
+            acc = _mm_xor_si128(acc, _mm_shuffle_epi8(_mm_loadu_si128(t+1), rhi));
+            rem -= 2*_nroots;
+        }
+        _mm_storeu_si128((__m128i*)(_parity + c), acc);
+    }
+}
+
+#endif // LIQUID_CPU_X86
+
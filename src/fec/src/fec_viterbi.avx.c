@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_viterbi.avx.c : Viterbi decoder add-compare-select (AVX2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// add-compare-select: one trellis step over all _S states, sixteen
+// butterflies at a time; returns minimum of new path metrics
+__attribute__((target("avx2"), always_inline))
+static inline int16_t fec_viterbi_acs_step_avx2(unsigned int    _S,
+                                                unsigned int    _R,
+                                                int16_t *       _branch,
+                                                unsigned char * _sym,
+                                                int16_t         _norm,
+                                                int16_t *       _m0,
+                                                int16_t *       _m1,
+                                                unsigned char * _dec)
+{
+    unsigned int h = _S/2;
+    unsigned int i, r;
+
+    __m256i sym[6];
+    for (r=0; r<_R; r++)
+        sym[r] = _mm256_set1_epi16(_sym[r]);
+    __m256i mmax = _mm256_set1_epi16(255*_R);
+    __m256i norm = _mm256_set1_epi16(_norm);
+    __m256i vmin = _mm256_set1_epi16(0x7fff);
+
+    for (i=0; i<h; i+=16) {
+        // branch metrics
+        __m256i m = _mm256_setzero_si256();
+        for (r=0; r<_R; r++) {
+            __m256i e = _mm256_loadu_si256((__m256i*)(_branch + r*h + i));
+            m = _mm256_add_epi16(m, _mm256_xor_si256(sym[r], e));
+        }
+        __m256i mc = _mm256_sub_epi16(mmax, m);
+
+        // old path metrics
+        __m256i a = _mm256_sub_epi16(_mm256_loadu_si256((__m256i*)(_m0 + i    )), norm);
+        __m256i b = _mm256_sub_epi16(_mm256_loadu_si256((__m256i*)(_m0 + i + h)), norm);
+
+        // butterflies
+        __m256i a0 = _mm256_add_epi16(a, m);
+        __m256i b0 = _mm256_add_epi16(b, mc);
+        __m256i a1 = _mm256_add_epi16(a, mc);
+        __m256i b1 = _mm256_add_epi16(b, m);
+        __m256i d0 = _mm256_cmpgt_epi16(a0, b0);
+        __m256i d1 = _mm256_cmpgt_epi16(a1, b1);
+        __m256i n0 = _mm256_min_epi16(a0, b0);
+        __m256i n1 = _mm256_min_epi16(a1, b1);
+
+        // interleave even/odd states (unpack operates within 128-bit
+        // lanes, so lanes are reordered afterwards)
+        __m256i lo = _mm256_unpacklo_epi16(n0, n1);
+        __m256i hi = _mm256_unpackhi_epi16(n0, n1);
+        _mm256_storeu_si256((__m256i*)(_m1 + 2*i     ), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256((__m256i*)(_m1 + 2*i + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+        vmin = _mm256_min_epi16(vmin, _mm256_min_epi16(n0, n1));
+
+        // decision bits for states 2i, ..., 2i+31 (packing within
+        // lanes restores state order)
+        __m256i d = _mm256_packs_epi16(_mm256_unpacklo_epi16(d0, d1),
+                                       _mm256_unpackhi_epi16(d0, d1));
+        unsigned int mask = (unsigned int) _mm256_movemask_epi8(d);
+        _dec[i/4 + 0] = (mask      ) & 0xff;
+        _dec[i/4 + 1] = (mask >>  8) & 0xff;
+        _dec[i/4 + 2] = (mask >> 16) & 0xff;
+        _dec[i/4 + 3] = (mask >> 24) & 0xff;
+    }
+
+    // horizontal minimum
+    __m128i v = _mm_min_epi16(_mm256_castsi256_si128(vmin),
+                              _mm256_extracti128_si256(vmin, 1));
+    v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1,0,3,2)));
+    v = _mm_min_epi16(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2,3,0,1)));
+    v = _mm_min_epi16(v, _mm_shufflelo_epi16(v, _MM_SHUFFLE(2,3,0,1)));
+    return (int16_t) _mm_extract_epi16(v, 0);
+}
+
+// add-compare-select: run _n trellis steps, swapping path metric
+// buffers after each step
+__attribute__((target("avx2")))
+void fec_viterbi_acs_avx2(unsigned int    _S,
+                          unsigned int    _R,
+                          int16_t *       _branch,
+                          unsigned char * _sym,
+                          unsigned int    _n,
+                          int16_t *       _norm,
+                          int16_t **      _m0,
+                          int16_t **      _m1,
+                          unsigned char * _dec)
+{
+    unsigned int dec_len = _S/8;
+    int16_t norm = *_norm;
+    int16_t * m0 = *_m0;
+    int16_t * m1 = *_m1;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // specialize rate 1/2 so the branch metric loop is unrolled
+        if (_R == 2)
+            norm = fec_viterbi_acs_step_avx2(_S, 2, _branch, _sym + 2*i, norm, m0, m1, _dec + i*dec_len);
+        else
+            norm = fec_viterbi_acs_step_avx2(_S, _R, _branch, _sym + _R*i, norm, m0, m1, _dec + i*dec_len);
+
+        int16_t * tmp = m0;
+        m0 = m1;
+        m1 = tmp;
+    }
+    *_norm = norm;
+    *_m0 = m0;
+    *_m1 = m1;
+}
+
+#endif // LIQUID_CPU_X86
+
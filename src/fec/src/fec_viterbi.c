@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_viterbi.c : soft-decision Viterbi decoder for convolutional codes
+//
+// The decoder keeps 16-bit path metrics for all S=2^(K-1) states and
+// one decision bit per state and trellis step. Every polynomial has its
+// first and last taps set, so the two branches entering a pair of
+// states carry complementary symbols and each trellis step reduces to
+// S/2 butterflies with a single branch metric each. Path metrics are
+// normalized by the previous step's minimum which bounds their spread
+// to K*255*R.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#define DEBUG_FEC_VITERBI 0
+
+struct fec_viterbi_s {
+    unsigned int K;             // constraint length
+    unsigned int R;             // number of polynomials (inverted rate)
+    unsigned int S;             // number of states, 2^(K-1)
+    unsigned int num_steps;     // maximum number of trellis steps
+    unsigned int step;          // current trellis step
+
+    int16_t * branch;           // branch symbols [size: R x S/2]
+    int16_t * m0;               // path metrics (current)
+    int16_t * m1;               // path metrics (next)
+    int16_t norm;               // minimum of current path metrics
+    unsigned int dec_len;       // decision bytes per trellis step
+    unsigned char * dec;        // decision bits [size: num_steps x dec_len]
+
+    liquid_simd_level simd;     // add-compare-select kernel
+};
+
+// portable add-compare-select: one trellis step over all _S states;
+// returns minimum of new path metrics
+static int16_t fec_viterbi_acs_portable(unsigned int    _S,
+                                        unsigned int    _R,
+                                        int16_t *       _branch,
+                                        unsigned char * _sym,
+                                        int16_t         _norm,
+                                        int16_t *       _m0,
+                                        int16_t *       _m1,
+                                        unsigned char * _dec)
+{
+    unsigned int h = _S/2;
+    int mmax = 255*_R;
+    int vmin = 0x7fff;
+    unsigned int i, r;
+
+    memset(_dec, 0x00, _S < 8 ? 1 : _S/8);
+    for (i=0; i<h; i++) {
+        // branch metric from state i to state 2i
+        int m = 0;
+        for (r=0; r<_R; r++)
+            m += _sym[r] ^ _branch[r*h + i];
+
+        int a = _m0[i]   - _norm;
+        int b = _m0[i+h] - _norm;
+
+        // butterfly: states i, i+S/2 -> 2i, 2i+1
+        int a0 = a + m, b0 = b + mmax - m;
+        int a1 = a + mmax - m, b1 = b + m;
+        int d0 = b0 < a0;
+        int d1 = b1 < a1;
+        _m1[2*i+0] = d0 ? b0 : a0;
+        _m1[2*i+1] = d1 ? b1 : a1;
+        _dec[(2*i) >> 3] |= (d0 | (d1 << 1)) << ((2*i) & 7);
+
+        if (_m1[2*i+0] < vmin) vmin = _m1[2*i+0];
+        if (_m1[2*i+1] < vmin) vmin = _m1[2*i+1];
+    }
+    return vmin;
+}
+
+// create Viterbi decoder
+//  _K      :   constraint length, 3 <= _K <= 15
+//  _R      :   inverted rate (number of polynomials), 1 <= _R <= 6
+//  _poly   :   generator polynomials [size: _R x 1]
+//  _n      :   maximum number of decoded bits (excluding tail)
+fec_viterbi fec_viterbi_create(unsigned int _K,
+                               unsigned int _R,
+                               int *        _poly,
+                               unsigned int _n)
+{
+    // validate input
+    if (_K < 3 || _K > 15) {
+        fprintf(stderr,"error: fec_viterbi_create(), constraint length must be in [3,15]\n");
+        exit(1);
+    } else if (_R < 1 || _R > 6) {
+        fprintf(stderr,"error: fec_viterbi_create(), number of polynomials must be in [1,6]\n");
+        exit(1);
+    }
+
+    unsigned int i, r;
+    for (r=0; r<_R; r++) {
+        if ( (_poly[r] & 1) == 0 || ((_poly[r] >> (_K-1)) & 1) == 0 ||
+             (_poly[r] >> _K) != 0 )
+        {
+            fprintf(stderr,"error: fec_viterbi_create(), polynomial 0x%x invalid for K=%u\n", _poly[r], _K);
+            exit(1);
+        }
+    }
+
+    fec_viterbi q = (fec_viterbi) malloc(sizeof(struct fec_viterbi_s));
+    q->K = _K;
+    q->R = _R;
+    q->S = 1 << (_K-1);
+    q->num_steps = _n + _K - 1;
+
+    // branch symbols for transition from state i (register 2i)
+    unsigned int h = q->S/2;
+    q->branch = (int16_t*) malloc(_R*h*sizeof(int16_t));
+    for (r=0; r<_R; r++) {
+        for (i=0; i<h; i++)
+            q->branch[r*h + i] = liquid_count_ones_mod2((2*i) & _poly[r]) ? 255 : 0;
+    }
+
+    q->m0 = (int16_t*) malloc(q->S*sizeof(int16_t));
+    q->m1 = (int16_t*) malloc(q->S*sizeof(int16_t));
+    q->dec_len = q->S < 8 ? 1 : q->S/8;
+    q->dec = (unsigned char*) malloc(q->num_steps*q->dec_len*sizeof(unsigned char));
+
+    // select add-compare-select kernel; vector kernels need at least
+    // one full register of butterflies
+    q->simd = liquid_cpu_get_simd_level();
+    if (q->simd >= LIQUID_SIMD_AVX2 && h >= 16)
+        q->simd = LIQUID_SIMD_AVX2;
+    else if (q->simd >= LIQUID_SIMD_SSE && h >= 8)
+        q->simd = LIQUID_SIMD_SSE;
+    else
+        q->simd = LIQUID_SIMD_NONE;
+
+    fec_viterbi_init(q, 0);
+    return q;
+}
+
+// destroy Viterbi decoder object
+void fec_viterbi_destroy(fec_viterbi _q)
+{
+    free(_q->branch);
+    free(_q->m0);
+    free(_q->m1);
+    free(_q->dec);
+    free(_q);
+}
+
+// reset path metrics and trellis, starting in state _state
+void fec_viterbi_init(fec_viterbi  _q,
+                      unsigned int _state)
+{
+    // penalize all but the initial state by one full branch metric
+    unsigned int i;
+    for (i=0; i<_q->S; i++)
+        _q->m0[i] = 255*_q->R;
+    _q->m0[_state & (_q->S-1)] = 0;
+
+    _q->norm = 0;
+    _q->step = 0;
+}
+
+// run decoder on block of soft symbols
+//  _q      :   decoder object
+//  _sym    :   soft symbols [size: _R*_nbits x 1]
+//  _nbits  :   number of trellis steps (decoded bits, including tail)
+void fec_viterbi_update_blk(fec_viterbi     _q,
+                            unsigned char * _sym,
+                            unsigned int    _nbits)
+{
+    if (_q->step + _nbits > _q->num_steps) {
+        fprintf(stderr,"error: fec_viterbi_update_blk(), trellis length exceeded\n");
+        exit(1);
+    }
+
+    unsigned char * dec = _q->dec + _q->step*_q->dec_len;
+    switch (_q->simd) {
+#if LIQUID_CPU_X86
+    case LIQUID_SIMD_AVX2:
+        fec_viterbi_acs_avx2(_q->S, _q->R, _q->branch, _sym, _nbits,
+                             &_q->norm, &_q->m0, &_q->m1, dec);
+        break;
+    case LIQUID_SIMD_SSE:
+        fec_viterbi_acs_sse(_q->S, _q->R, _q->branch, _sym, _nbits,
+                            &_q->norm, &_q->m0, &_q->m1, dec);
+        break;
+#endif
+    default:;
+        unsigned int i;
+        for (i=0; i<_nbits; i++) {
+            _q->norm = fec_viterbi_acs_portable(_q->S, _q->R, _q->branch,
+                                                _sym + i*_q->R, _q->norm,
+                                                _q->m0, _q->m1,
+                                                dec + i*_q->dec_len);
+
+            // swap path metrics
+            int16_t * tmp = _q->m0;
+            _q->m0 = _q->m1;
+            _q->m1 = tmp;
+        }
+    }
+    _q->step += _nbits;
+}
+
+// trace back through trellis and pack decoded bits (msb first)
+//  _q          :   decoder object
+//  _data       :   decoded bytes [size: ceil(_nbits/8) x 1]
+//  _nbits      :   number of decoded bits (excluding tail)
+//  _endstate   :   terminal encoder state
+void fec_viterbi_chainback(fec_viterbi     _q,
+                           unsigned char * _data,
+                           unsigned int    _nbits,
+                           unsigned int    _endstate)
+{
+    if (_nbits > _q->step) {
+        fprintf(stderr,"error: fec_viterbi_chainback(), only %u trellis steps available\n", _q->step);
+        exit(1);
+    }
+
+    memset(_data, 0x00, (_nbits+7)/8);
+
+    unsigned int n = _endstate & (_q->S-1);
+    unsigned int t;
+    for (t=_q->step; t>0; t--) {
+        unsigned char * dec = _q->dec + (t-1)*_q->dec_len;
+        unsigned int d = (dec[n >> 3] >> (n & 7)) & 1;
+
+        // input bit at step t-1 is lsb of state
+        if (t <= _nbits)
+            _data[(t-1) >> 3] |= (n & 1) << (7 - ((t-1) & 7));
+
+        n = (n >> 1) | (d << (_q->K-2));
+    }
+
+#if DEBUG_FEC_VITERBI
+    printf("fec_viterbi_chainback(), minimum path metric: %d\n", _q->norm);
+#endif
+}
+
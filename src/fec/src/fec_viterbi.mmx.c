@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_viterbi.mmx.c : Viterbi decoder add-compare-select (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// add-compare-select: one trellis step over all _S states, eight
+// butterflies at a time; returns minimum of new path metrics
+__attribute__((target("sse2"), always_inline))
+static inline int16_t fec_viterbi_acs_step_sse(unsigned int    _S,
+                                               unsigned int    _R,
+                                               int16_t *       _branch,
+                                               unsigned char * _sym,
+                                               int16_t         _norm,
+                                               int16_t *       _m0,
+                                               int16_t *       _m1,
+                                               unsigned char * _dec)
+{
+    unsigned int h = _S/2;
+    unsigned int i, r;
+
+    __m128i sym[6];
+    for (r=0; r<_R; r++)
+        sym[r] = _mm_set1_epi16(_sym[r]);
+    __m128i mmax = _mm_set1_epi16(255*_R);
+    __m128i norm = _mm_set1_epi16(_norm);
+    __m128i vmin = _mm_set1_epi16(0x7fff);
+
+    for (i=0; i<h; i+=8) {
+        // branch metrics
+        __m128i m = _mm_setzero_si128();
+        for (r=0; r<_R; r++) {
+            __m128i e = _mm_loadu_si128((__m128i*)(_branch + r*h + i));
+            m = _mm_add_epi16(m, _mm_xor_si128(sym[r], e));
+        }
+        __m128i mc = _mm_sub_epi16(mmax, m);
+
+        // old path metrics
+        __m128i a = _mm_sub_epi16(_mm_loadu_si128((__m128i*)(_m0 + i    )), norm);
+        __m128i b = _mm_sub_epi16(_mm_loadu_si128((__m128i*)(_m0 + i + h)), norm);
+
+        // butterflies
+        __m128i a0 = _mm_add_epi16(a, m);
+        __m128i b0 = _mm_add_epi16(b, mc);
+        __m128i a1 = _mm_add_epi16(a, mc);
+        __m128i b1 = _mm_add_epi16(b, m);
+        __m128i d0 = _mm_cmpgt_epi16(a0, b0);
+        __m128i d1 = _mm_cmpgt_epi16(a1, b1);
+        __m128i n0 = _mm_min_epi16(a0, b0);
+        __m128i n1 = _mm_min_epi16(a1, b1);
+
+        // interleave even/odd states
+        __m128i lo = _mm_unpacklo_epi16(n0, n1);
+        __m128i hi = _mm_unpackhi_epi16(n0, n1);
+        _mm_storeu_si128((__m128i*)(_m1 + 2*i    ), lo);
+        _mm_storeu_si128((__m128i*)(_m1 + 2*i + 8), hi);
+        vmin = _mm_min_epi16(vmin, _mm_min_epi16(n0, n1));
+
+        // decision bits for states 2i, ..., 2i+15
+        __m128i d = _mm_packs_epi16(_mm_unpacklo_epi16(d0, d1),
+                                    _mm_unpackhi_epi16(d0, d1));
+        unsigned int mask = _mm_movemask_epi8(d);
+        _dec[i/4 + 0] = mask & 0xff;
+        _dec[i/4 + 1] = (mask >> 8) & 0xff;
+    }
+
+    // horizontal minimum
+    vmin = _mm_min_epi16(vmin, _mm_shuffle_epi32(vmin, _MM_SHUFFLE(1,0,3,2)));
+    vmin = _mm_min_epi16(vmin, _mm_shuffle_epi32(vmin, _MM_SHUFFLE(2,3,0,1)));
+    vmin = _mm_min_epi16(vmin, _mm_shufflelo_epi16(vmin, _MM_SHUFFLE(2,3,0,1)));
+    return (int16_t) _mm_extract_epi16(vmin, 0);
+}
+
+// add-compare-select: run _n trellis steps, swapping path metric
+// buffers after each step
+__attribute__((target("sse2")))
+void fec_viterbi_acs_sse(unsigned int    _S,
+                         unsigned int    _R,
+                         int16_t *       _branch,
+                         unsigned char * _sym,
+                         unsigned int    _n,
+                         int16_t *       _norm,
+                         int16_t **      _m0,
+                         int16_t **      _m1,
+                         unsigned char * _dec)
+{
+    unsigned int dec_len = _S/8;
+    int16_t norm = *_norm;
+    int16_t * m0 = *_m0;
+    int16_t * m1 = *_m1;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        // specialize rate 1/2 so the branch metric loop is unrolled
+        if (_R == 2)
+            norm = fec_viterbi_acs_step_sse(_S, 2, _branch, _sym + 2*i, norm, m0, m1, _dec + i*dec_len);
+        else
+            norm = fec_viterbi_acs_step_sse(_S, _R, _branch, _sym + _R*i, norm, m0, m1, _dec + i*dec_len);
+
+        int16_t * tmp = m0;
+        m0 = m1;
+        m1 = tmp;
+    }
+    *_norm = norm;
+    *_m0 = m0;
+    *_m1 = m1;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -17,10 +17,11 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
 #include <string.h>
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 //
 // AUTOTEST: reverse byte
@@ -117,3 +118,93 @@ void autotest_crc24()    { validate_crc(LIQUID_CRC_24,          64); }
 void autotest_crc32()    { validate_crc(LIQUID_CRC_32,          64); }
 
 
+
+// bit-wise reference CRC (reflected, initial register ~0,
+// complemented output)
+static unsigned int crc_reference(unsigned int    _poly,
+                                  unsigned int    _mask,
+                                  unsigned char * _msg,
+                                  unsigned int    _n)
+{
+    unsigned int i, j, key=~0;
+    for (i=0; i<_n; i++) {
+        key ^= _msg[i];
+        for (j=0; j<8; j++)
+            key = (key>>1) ^ (_poly & -(key & 1));
+    }
+    return (~key) & _mask;
+}
+
+// compare table-driven and folding methods against the bit-wise
+// reference for message lengths around the folding block sizes
+void crc_test_methods(crc_scheme   _check,
+                      unsigned int _poly,
+                      unsigned int _mask,
+                      unsigned int _cpu_mask)
+{
+    unsigned int i, n;
+    unsigned char msg[1100];
+    for (i=0; i<1100; i++)
+        msg[i] = rand() & 0xff;
+
+    liquid_cpu_set_mask(_cpu_mask);
+    for (n=0; n<1100; n += (n < 300) ? 1 : 37) {
+        unsigned int key = crc_generate_key(_check, msg, n);
+        CONTEND_EQUALITY(key, crc_reference(_poly, _mask, msg, n));
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+// AUTOTEST : table-driven (portable) CRC
+void autotest_crc_methods_table()
+{
+    crc_test_methods(LIQUID_CRC_8,  liquid_reverse_byte(CRC8_POLY),       0xff,       0);
+    crc_test_methods(LIQUID_CRC_16, liquid_reverse_uint16(CRC16_POLY),    0xffff,     0);
+    crc_test_methods(LIQUID_CRC_24, liquid_reverse_uint24(CRC24_POLY),    0xffffff,   0);
+    crc_test_methods(LIQUID_CRC_32, liquid_reverse_uint32(CRC32_POLY),    0xffffffff, 0);
+}
+
+// AUTOTEST : carry-less multiply folding (when supported by host)
+void autotest_crc_methods_fold()
+{
+    if ( !(liquid_cpu_get_features() & LIQUID_CPU_PCLMUL) ) {
+        AUTOTEST_WARN("crc_methods_fold: PCLMULQDQ not supported by host");
+        return;
+    }
+    crc_test_methods(LIQUID_CRC_8,  liquid_reverse_byte(CRC8_POLY),       0xff,       ~0U);
+    crc_test_methods(LIQUID_CRC_16, liquid_reverse_uint16(CRC16_POLY),    0xffff,     ~0U);
+    crc_test_methods(LIQUID_CRC_24, liquid_reverse_uint24(CRC24_POLY),    0xffffff,   ~0U);
+    crc_test_methods(LIQUID_CRC_32, liquid_reverse_uint32(CRC32_POLY),    0xffffffff, ~0U);
+}
+
+// incremental key computation over irregular chunks matches one-shot key
+void crc_test_update(crc_scheme _check)
+{
+    unsigned int i;
+    unsigned int n = 2000;
+    unsigned char msg[n];
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    unsigned int chunks[] = {0, 1, 7, 3, 64, 0, 129, 200, 13, 511, 1, 1000};
+    unsigned int state = crc_init(_check);
+    unsigned int num_read = 0;
+    for (i=0; i<sizeof(chunks)/sizeof(chunks[0]); i++) {
+        unsigned int k = chunks[i] < n-num_read ? chunks[i] : n-num_read;
+        state = crc_update(_check, state, msg + num_read, k);
+        num_read += k;
+    }
+    state = crc_update(_check, state, msg + num_read, n - num_read);
+
+    unsigned int key = crc_finalize(_check, state);
+    CONTEND_EQUALITY(key, crc_generate_key(_check, msg, n));
+    CONTEND_EXPRESSION(crc_validate_message(_check, msg, n, key));
+}
+
+// AUTOTESTS : incremental key computation
+void autotest_crc_update_checksum() { crc_test_update(LIQUID_CRC_CHECKSUM); }
+void autotest_crc_update_crc8()     { crc_test_update(LIQUID_CRC_8);        }
+void autotest_crc_update_crc16()    { crc_test_update(LIQUID_CRC_16);       }
+void autotest_crc_update_crc24()    { crc_test_update(LIQUID_CRC_24);       }
+void autotest_crc_update_crc32()    { crc_test_update(LIQUID_CRC_32);       }
+
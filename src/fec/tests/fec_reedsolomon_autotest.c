@@ -30,11 +30,6 @@
 //
 void autotest_reedsolomon_223_255()
 {
-#if !LIBFEC_ENABLED
-    printf("warning: Reed-Solomon codes unavailable\n");
-    return;
-#endif
-
     unsigned int dec_msg_len = 223;
 
     // compute and test encoded message length
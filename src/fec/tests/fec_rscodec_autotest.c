@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_rscodec_autotest.c : test native Reed-Solomon codec
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// helper function: encode random message, corrupt _num_errors
+// symbols and decode with each run-time kernel
+//  _nroots     :   number of parity symbols
+//  _pad        :   number of padding symbols (shortened code)
+//  _num_errors :   number of symbol errors, _num_errors <= _nroots/2
+void fec_rscodec_test(unsigned int _nroots,
+                      unsigned int _pad,
+                      unsigned int _num_errors)
+{
+    unsigned int k = 255 - _nroots - _pad;
+    unsigned int n = k + _nroots;
+    unsigned char msg[k];
+    unsigned char parity_test[_nroots];
+    unsigned char parity[_nroots];
+    unsigned char block[n];
+    unsigned char rec[n];
+
+    unsigned int i;
+    for (i=0; i<k; i++)
+        msg[i] = rand() & 0xff;
+
+    // corrupt distinct symbols
+    memset(rec, 0x00, n);
+    for (i=0; i<_num_errors; i++) {
+        unsigned int idx;
+        do {
+            idx = rand() % n;
+        } while (rec[idx] != 0);
+        rec[idx] = 1 + (rand() % 255);
+    }
+
+    // portable, SSSE3, AVX2
+    unsigned int masks[3] = {0, ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2), ~0U};
+    unsigned int m;
+    for (m=0; m<3; m++) {
+        liquid_cpu_set_mask(masks[m]);
+        fec_rscodec q = fec_rscodec_create(0x11d, 1, 1, _nroots, _pad);
+
+        // encode and compare parity with portable version
+        fec_rscodec_encode(q, msg, parity);
+        if (m == 0)
+            memmove(parity_test, parity, _nroots);
+        else
+            CONTEND_SAME_DATA(parity, parity_test, _nroots);
+
+        // code word has zero syndromes
+        memmove(block, msg, k);
+        memmove(block+k, parity, _nroots);
+        CONTEND_EQUALITY(fec_rscodec_decode(q, block), 0);
+
+        // add errors and decode
+        for (i=0; i<n; i++)
+            block[i] ^= rec[i];
+        CONTEND_EQUALITY(fec_rscodec_decode(q, block), (int)_num_errors);
+        CONTEND_SAME_DATA(block,   msg,    k);
+        CONTEND_SAME_DATA(block+k, parity, _nroots);
+
+        fec_rscodec_destroy(q);
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+void autotest_fec_rscodec_n32_e0()          { fec_rscodec_test(32,   0,  0); }
+void autotest_fec_rscodec_n32_e1()          { fec_rscodec_test(32,   0,  1); }
+void autotest_fec_rscodec_n32_e16()         { fec_rscodec_test(32,   0, 16); }
+void autotest_fec_rscodec_n32_pad18_e9()    { fec_rscodec_test(32,  18,  9); }
+void autotest_fec_rscodec_n32_pad200_e16()  { fec_rscodec_test(32, 200, 16); }
+void autotest_fec_rscodec_n16_e8()          { fec_rscodec_test(16,   0,  8); }
+void autotest_fec_rscodec_n10_pad50_e5()    { fec_rscodec_test(10,  50,  5); }
+
+// shortened multi-block messages through the fec interface, with the
+// maximum number of correctable errors in every block
+void autotest_fec_rscodec_blocks()
+{
+    unsigned int n = 1024;
+    unsigned int n_enc = fec_get_enc_msg_length(LIQUID_FEC_RS_M8, n);
+    CONTEND_EQUALITY(n_enc, 1185);
+
+    unsigned char msg[n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_dec[n];
+    unsigned int i, j;
+    for (i=0; i<n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(LIQUID_FEC_RS_M8, NULL);
+    fec_encode(q, n, msg, msg_enc);
+
+    // 5 blocks of 237 symbols; corrupt 16 symbols in each
+    for (i=0; i<5; i++) {
+        for (j=0; j<16; j++)
+            msg_enc[237*i + 14*j + (i % 3)] ^= 0x5a + j;
+    }
+
+    fec_decode(q, n, msg_enc, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, n);
+    fec_destroy(q);
+}
+
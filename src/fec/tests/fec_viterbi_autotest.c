@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fec_viterbi_autotest.c : test native Viterbi decoder
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// helper function: decode noisy soft symbols with each run-time kernel
+// and compare decoded outputs
+//  _K      :   constraint length
+//  _R      :   number of polynomials
+//  _poly   :   generator polynomials [size: _R x 1]
+//  _n      :   number of decoded bits
+void fec_viterbi_test_simd(unsigned int _K,
+                           unsigned int _R,
+                           int *        _poly,
+                           unsigned int _n)
+{
+    unsigned int num_steps = _n + _K - 1;
+    unsigned int num_bytes = (_n + 7) / 8;
+    unsigned char sym[_R*num_steps];
+    unsigned char dec[num_bytes];
+    unsigned char dec_test[num_bytes];
+
+    // random soft symbols; path metrics are then dominated by noise
+    // which exercises normalization and the full range of metrics
+    unsigned int i;
+    for (i=0; i<_R*num_steps; i++)
+        sym[i] = rand() & 0xff;
+
+    // portable reference
+    liquid_cpu_set_mask(0);
+    fec_viterbi q = fec_viterbi_create(_K, _R, _poly, _n);
+    fec_viterbi_update_blk(q, sym, num_steps);
+    fec_viterbi_chainback(q, dec_test, _n, 0);
+    fec_viterbi_destroy(q);
+
+    // SSE2, AVX2
+    unsigned int masks[2] = {~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2), ~0U};
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        q = fec_viterbi_create(_K, _R, _poly, _n);
+        fec_viterbi_update_blk(q, sym, num_steps);
+        fec_viterbi_chainback(q, dec, _n, 0);
+        fec_viterbi_destroy(q);
+        CONTEND_SAME_DATA(dec, dec_test, num_bytes);
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+// helper function: encode, add noise to soft bits, and decode with
+// the fec interface
+//  _fs     :   convolutional scheme
+//  _n      :   message length [bytes]
+//  _sigma  :   noise standard deviation (soft-bit scale)
+void fec_viterbi_test_noise(fec_scheme   _fs,
+                            unsigned int _n,
+                            float        _sigma)
+{
+    unsigned int n_enc = fec_get_enc_msg_length(_fs,_n);
+    unsigned char msg[_n];
+    unsigned char msg_enc[n_enc];
+    unsigned char msg_soft[8*n_enc];
+    unsigned char msg_dec[_n];
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        msg[i] = rand() & 0xff;
+
+    fec q = fec_create(_fs, NULL);
+    fec_encode(q, _n, msg, msg_enc);
+
+    // soft bits centered on 64/191 with additive noise
+    for (i=0; i<8*n_enc; i++) {
+        unsigned int bit = (msg_enc[i/8] >> (7-(i%8))) & 1;
+        float v = (bit ? 191.0f : 64.0f) + _sigma*randnf();
+        msg_soft[i] = v < 0.0f ? 0 : (v > 255.0f ? 255 : (unsigned char)v);
+    }
+
+    fec_decode_soft(q, _n, msg_soft, msg_dec);
+    CONTEND_SAME_DATA(msg, msg_dec, _n);
+    fec_destroy(q);
+}
+
+// compare SIMD add-compare-select kernels to portable version
+void autotest_fec_viterbi_simd_v27()  { fec_viterbi_test_simd( 7, 2, fec_conv27_poly,  1000); }
+void autotest_fec_viterbi_simd_v29()  { fec_viterbi_test_simd( 9, 2, fec_conv29_poly,  1000); }
+void autotest_fec_viterbi_simd_v39()  { fec_viterbi_test_simd( 9, 3, fec_conv39_poly,  1000); }
+void autotest_fec_viterbi_simd_v615() { fec_viterbi_test_simd(15, 6, fec_conv615_poly,  200); }
+
+// decode in the presence of noise
+void autotest_fec_viterbi_noise_v27()    { fec_viterbi_test_noise(LIQUID_FEC_CONV_V27,    256, 40.0f); }
+void autotest_fec_viterbi_noise_v29()    { fec_viterbi_test_noise(LIQUID_FEC_CONV_V29,    256, 40.0f); }
+void autotest_fec_viterbi_noise_v39()    { fec_viterbi_test_noise(LIQUID_FEC_CONV_V39,    256, 50.0f); }
+void autotest_fec_viterbi_noise_v615()   { fec_viterbi_test_noise(LIQUID_FEC_CONV_V615,    64, 70.0f); }
+void autotest_fec_viterbi_noise_v27p34() { fec_viterbi_test_noise(LIQUID_FEC_CONV_V27P34, 256, 25.0f); }
+void autotest_fec_viterbi_noise_v29p78() { fec_viterbi_test_noise(LIQUID_FEC_CONV_V29P78, 256, 15.0f); }
+
+// decoder object is reusable and can decode a shorter message
+void autotest_fec_viterbi_reuse()
+{
+    unsigned int n = 100;
+    unsigned int m = 60;
+    unsigned int num_steps = n + 6;
+    unsigned char msg[(n+7)/8];
+    unsigned char msg_enc[2*num_steps];
+    unsigned char dec[(n+7)/8];
+    unsigned int i, r;
+    for (i=0; i<(n+7)/8; i++)
+        msg[i] = rand() & 0xff;
+
+    // encode bit by bit (soft output)
+    unsigned int sr = 0;
+    for (i=0; i<num_steps; i++) {
+        unsigned int bit = i < n ? (msg[i/8] >> (7-(i%8))) & 1 : 0;
+        sr = (sr << 1) | bit;
+        for (r=0; r<2; r++)
+            msg_enc[2*i+r] = liquid_count_ones_mod2(sr & fec_conv27_poly[r]) ? LIQUID_SOFTBIT_1 : LIQUID_SOFTBIT_0;
+    }
+
+    fec_viterbi q = fec_viterbi_create(7, 2, fec_conv27_poly, n);
+    for (r=0; r<2; r++) {
+        // full message, fed in two blocks
+        memset(dec, 0x00, sizeof(dec));
+        fec_viterbi_init(q, 0);
+        fec_viterbi_update_blk(q, msg_enc,      40);
+        fec_viterbi_update_blk(q, msg_enc + 80, num_steps - 40);
+        fec_viterbi_chainback(q, dec, n, 0);
+        CONTEND_SAME_DATA(dec, msg, n/8);
+        CONTEND_EQUALITY(dec[n/8] & 0xf0, msg[n/8] & 0xf0);
+    }
+
+    // prefix of message, terminated in the encoder state after m bits
+    unsigned int state = 0;
+    for (i=0; i<m; i++)
+        state = ((state << 1) | ((msg[i/8] >> (7-(i%8))) & 1)) & 0x3f;
+    fec_viterbi_init(q, 0);
+    fec_viterbi_update_blk(q, msg_enc, m);
+    fec_viterbi_chainback(q, dec, m, state);
+    CONTEND_SAME_DATA(dec, msg, m/8);
+    CONTEND_EQUALITY(dec[m/8] & 0xf0, msg[m/8] & 0xf0);
+    fec_viterbi_destroy(q);
+}
+
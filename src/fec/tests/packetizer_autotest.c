@@ -63,3 +63,7 @@ void autotest_packetizer_n16_0_0()  { packetizer_test_codec(16, LIQUID_CRC_32, L
 void autotest_packetizer_n16_0_1()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_REP3);       }
 void autotest_packetizer_n16_0_2()  { packetizer_test_codec(16, LIQUID_CRC_32, LIQUID_FEC_NONE, LIQUID_FEC_HAMMING74);  }
 
+
+// concatenated Reed-Solomon and convolutional codes
+void autotest_packetizer_n1024_rs8_v27()    { packetizer_test_codec(1024, LIQUID_CRC_32, LIQUID_FEC_RS_M8, LIQUID_FEC_CONV_V27);    }
+void autotest_packetizer_n1024_rs8_v29p45() { packetizer_test_codec(1024, LIQUID_CRC_32, LIQUID_FEC_RS_M8, LIQUID_FEC_CONV_V29P45); }
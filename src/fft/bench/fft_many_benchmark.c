@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_many_benchmark.c : benchmark batches of transforms
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function: run batch of transforms
+//  _nfft       :   fft size
+//  _howmany    :   number of transforms in batch
+//  _interleave :   transforms interleaved in memory (stride _howmany,
+//                  distance 1) rather than stored contiguously?
+void fft_many_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _nfft,
+                    unsigned int        _howmany,
+                    int                 _interleave)
+{
+    // initialize arrays, plan
+    unsigned int n = _nfft*_howmany;
+    float complex * x = (float complex *) malloc(n*sizeof(float complex));
+    float complex * y = (float complex *) malloc(n*sizeof(float complex));
+    unsigned int stride = _interleave ? _howmany : 1;
+    unsigned int dist   = _interleave ? 1 : _nfft;
+    fftplan q = fft_create_plan_many(_nfft, _howmany, x, stride, dist, y, stride, dist,
+                                     LIQUID_FFT_FORWARD, 0);
+
+    unsigned long int i;
+
+    // initialize input with random values
+    for (i=0; i<n; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // report per transform
+    *_num_iterations *= 4*_howmany;
+
+    fft_destroy_plan(q);
+    free(x);
+    free(y);
+}
+
+#define FFT_MANY_BENCHMARK_API(NFFT,HOWMANY,INTERLEAVE) \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ fft_many_bench(_start, _finish, _num_iterations, NFFT, HOWMANY, INTERLEAVE); }
+
+// transforms stored contiguously
+void benchmark_fft_many_16x16       FFT_MANY_BENCHMARK_API(  16, 16, 0)
+void benchmark_fft_many_64x16       FFT_MANY_BENCHMARK_API(  64, 16, 0)
+void benchmark_fft_many_256x8       FFT_MANY_BENCHMARK_API( 256,  8, 0)
+void benchmark_fft_many_1024x16     FFT_MANY_BENCHMARK_API(1024, 16, 0)
+void benchmark_fft_many_120x16      FFT_MANY_BENCHMARK_API( 120, 16, 0)
+
+// transforms interleaved in memory (vectorized across transforms)
+void benchmark_fft_many_16x16i      FFT_MANY_BENCHMARK_API(  16, 16, 1)
+void benchmark_fft_many_64x16i      FFT_MANY_BENCHMARK_API(  64, 16, 1)
+void benchmark_fft_many_256x8i      FFT_MANY_BENCHMARK_API( 256,  8, 1)
+void benchmark_fft_many_1024x16i    FFT_MANY_BENCHMARK_API(1024, 16, 1)
+void benchmark_fft_many_120x16i     FFT_MANY_BENCHMARK_API( 120, 16, 1)
+
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_plan_benchmark.c : benchmark FFT plan creation
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function: create and destroy plans
+//  _nfft   :   fft size
+//  _cold   :   clear plan cache before each creation?
+void fft_plan_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _nfft,
+                    int                 _cold)
+{
+    float complex * x = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y = (float complex *) malloc(_nfft*sizeof(float complex));
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= 10*_nfft;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // populate cache
+    liquid_fft_cache_clear();
+    fftplan q = fft_create_plan(_nfft, x, y, LIQUID_FFT_FORWARD, 0);
+    fft_destroy_plan(q);
+
+    unsigned long int i;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_cold)
+            liquid_fft_cache_clear();
+        q = fft_create_plan(_nfft, x, y, LIQUID_FFT_FORWARD, 0);
+        fft_destroy_plan(q);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    free(x);
+    free(y);
+}
+
+#define FFT_PLAN_BENCHMARK_API(NFFT,COLD)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ fft_plan_bench(_start, _finish, _num_iterations, NFFT, COLD); }
+
+// cached plan data
+void benchmark_fft_plan_64          FFT_PLAN_BENCHMARK_API(  64, 0)
+void benchmark_fft_plan_157         FFT_PLAN_BENCHMARK_API( 157, 0)
+void benchmark_fft_plan_960         FFT_PLAN_BENCHMARK_API( 960, 0)
+void benchmark_fft_plan_1024        FFT_PLAN_BENCHMARK_API(1024, 0)
+
+// plan data computed on every creation
+void benchmark_fft_plan_64_cold     FFT_PLAN_BENCHMARK_API(  64, 1)
+void benchmark_fft_plan_157_cold    FFT_PLAN_BENCHMARK_API( 157, 1)
+void benchmark_fft_plan_960_cold    FFT_PLAN_BENCHMARK_API( 960, 1)
+void benchmark_fft_plan_1024_cold   FFT_PLAN_BENCHMARK_API(1024, 1)
+
@@ -20,7 +20,7 @@
 //
 // fft_r2r_benchmark.h
 //
-// Real even/odd FFT benchmarks (discrete cosine/sine transforms)
+// Real even/odd FFT benchmarks (discrete cosine/sine transforms, MDCT)
 //
 
 #include <sys/resource.h>
@@ -39,21 +39,20 @@ void fft_r2r_bench(struct rusage *_start,
                    unsigned int _n,
                    int _kind)
 {
-    // initialize arrays, plan
-    float x[_n], y[_n];
+    // initialize arrays, plan (MDCT input/IMDCT output is 2*_n)
+    float x[2*_n], y[2*_n];
     int _flags = 0;
     fftplan p = fft_create_plan_r2r_1d(_n, x, y, _kind, _flags);
     
     unsigned long int i;
 
     // initialize input with random values
-    for (i=0; i<_n; i++)
+    for (i=0; i<2*_n; i++)
         x[i] = randnf();
 
     // scale number of iterations to keep execution time
     // relatively linear
-    *_num_iterations /= _n * _n;
-    *_num_iterations *= 10;
+    *_num_iterations /= _n;
     *_num_iterations += 1;
 
     // start trials
@@ -95,3 +94,16 @@ void benchmark_fft_RODFT01_127  LIQUID_FFT_R2R_BENCH_API(127,  LIQUID_FFT_RODFT0
 void benchmark_fft_RODFT10_127  LIQUID_FFT_R2R_BENCH_API(127,  LIQUID_FFT_RODFT10)
 void benchmark_fft_RODFT11_127  LIQUID_FFT_R2R_BENCH_API(127,  LIQUID_FFT_RODFT11)
 
+// larger transforms
+
+void benchmark_fft_REDFT10_1024 LIQUID_FFT_R2R_BENCH_API(1024, LIQUID_FFT_REDFT10)
+void benchmark_fft_REDFT01_1024 LIQUID_FFT_R2R_BENCH_API(1024, LIQUID_FFT_REDFT01)
+void benchmark_fft_REDFT11_1024 LIQUID_FFT_R2R_BENCH_API(1024, LIQUID_FFT_REDFT11)
+void benchmark_fft_RODFT11_1024 LIQUID_FFT_R2R_BENCH_API(1024, LIQUID_FFT_RODFT11)
+
+
+// modified discrete cosine transform
+
+void benchmark_fft_MDCT_256     LIQUID_FFT_R2R_BENCH_API(256,  LIQUID_FFT_MDCT)
+void benchmark_fft_IMDCT_256    LIQUID_FFT_R2R_BENCH_API(256,  LIQUID_FFT_IMDCT)
+
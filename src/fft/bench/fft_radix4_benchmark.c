@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_radix4_benchmark.c : benchmark radix-4 (Stockham) FFTs of length 2^m
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include "liquid.internal.h"
+
+// helper function: run radix-4 transform
+//  _nfft   :   fft size
+//  _mask   :   processor features mask (see liquid_cpu_set_mask())
+void fft_radix4_bench(struct rusage *     _start,
+                      struct rusage *     _finish,
+                      unsigned long int * _num_iterations,
+                      unsigned int        _nfft,
+                      unsigned int        _mask)
+{
+    // initialize arrays, plan
+    float complex * x = (float complex *) malloc(_nfft*sizeof(float complex));
+    float complex * y = (float complex *) malloc(_nfft*sizeof(float complex));
+    liquid_cpu_set_mask(_mask);
+    fftplan q = fft_create_plan_method(_nfft, x, y, LIQUID_FFT_FORWARD, 0, LIQUID_FFT_METHOD_RADIX4);
+    liquid_cpu_set_mask(~0U);
+
+    unsigned long int i;
+
+    // initialize input with random values
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= _nfft;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    fft_destroy_plan(q);
+    free(x);
+    free(y);
+}
+
+#define FFT_RADIX4_BENCHMARK_API(NFFT,MASK) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ fft_radix4_bench(_start, _finish, _num_iterations, NFFT, MASK); }
+
+// power-of-two transforms, best available SIMD extensions
+void benchmark_fft_radix4_16        FFT_RADIX4_BENCHMARK_API(16,    ~0U)
+void benchmark_fft_radix4_32        FFT_RADIX4_BENCHMARK_API(32,    ~0U)
+void benchmark_fft_radix4_64        FFT_RADIX4_BENCHMARK_API(64,    ~0U)
+void benchmark_fft_radix4_128       FFT_RADIX4_BENCHMARK_API(128,   ~0U)
+void benchmark_fft_radix4_256       FFT_RADIX4_BENCHMARK_API(256,   ~0U)
+void benchmark_fft_radix4_512       FFT_RADIX4_BENCHMARK_API(512,   ~0U)
+void benchmark_fft_radix4_1024      FFT_RADIX4_BENCHMARK_API(1024,  ~0U)
+void benchmark_fft_radix4_2048      FFT_RADIX4_BENCHMARK_API(2048,  ~0U)
+void benchmark_fft_radix4_4096      FFT_RADIX4_BENCHMARK_API(4096,  ~0U)
+void benchmark_fft_radix4_8192      FFT_RADIX4_BENCHMARK_API(8192,  ~0U)
+void benchmark_fft_radix4_16384     FFT_RADIX4_BENCHMARK_API(16384, ~0U)
+void benchmark_fft_radix4_32768     FFT_RADIX4_BENCHMARK_API(32768, ~0U)
+
+// SSE2 only
+void benchmark_fft_radix4_sse_64    FFT_RADIX4_BENCHMARK_API(64,    LIQUID_CPU_SSE2)
+void benchmark_fft_radix4_sse_1024  FFT_RADIX4_BENCHMARK_API(1024,  LIQUID_CPU_SSE2)
+
+// portable C
+void benchmark_fft_radix4_port_64   FFT_RADIX4_BENCHMARK_API(64,    0)
+void benchmark_fft_radix4_port_1024 FFT_RADIX4_BENCHMARK_API(1024,  0)
+
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_real_benchmark.c : real-to-complex/complex-to-real transforms
+//
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// helper function: run real transform
+//  _nfft   :   fft size
+//  _type   :   LIQUID_FFT_R2C or LIQUID_FFT_C2R
+void fft_real_bench(struct rusage *     _start,
+                    struct rusage *     _finish,
+                    unsigned long int * _num_iterations,
+                    unsigned int        _nfft,
+                    int                 _type)
+{
+    // initialize arrays, plan
+    float *         x = (float *)         malloc(_nfft*sizeof(float));
+    float complex * X = (float complex *) malloc((_nfft/2+1)*sizeof(float complex));
+    unsigned long int i;
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf();
+    for (i=0; i<_nfft/2+1; i++)
+        X[i] = randnf() + _Complex_I*randnf();
+
+    fftplan q = (_type == LIQUID_FFT_R2C) ? fft_create_plan_r2c(_nfft, x, X, 0) :
+                                            fft_create_plan_c2r(_nfft, X, x, 0);
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= _nfft;
+    *_num_iterations += 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+        fft_execute(q);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    fft_destroy_plan(q);
+    free(x);
+    free(X);
+}
+
+#define FFT_REAL_BENCHMARK_API(NFFT,TYPE)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ fft_real_bench(_start, _finish, _num_iterations, NFFT, TYPE); }
+
+void benchmark_fft_r2c_64       FFT_REAL_BENCHMARK_API(  64, LIQUID_FFT_R2C)
+void benchmark_fft_r2c_256      FFT_REAL_BENCHMARK_API( 256, LIQUID_FFT_R2C)
+void benchmark_fft_r2c_1024     FFT_REAL_BENCHMARK_API(1024, LIQUID_FFT_R2C)
+void benchmark_fft_r2c_4096     FFT_REAL_BENCHMARK_API(4096, LIQUID_FFT_R2C)
+void benchmark_fft_r2c_1000     FFT_REAL_BENCHMARK_API(1000, LIQUID_FFT_R2C)
+
+void benchmark_fft_c2r_64       FFT_REAL_BENCHMARK_API(  64, LIQUID_FFT_C2R)
+void benchmark_fft_c2r_256      FFT_REAL_BENCHMARK_API( 256, LIQUID_FFT_C2R)
+void benchmark_fft_c2r_1024     FFT_REAL_BENCHMARK_API(1024, LIQUID_FFT_C2R)
+void benchmark_fft_c2r_4096     FFT_REAL_BENCHMARK_API(4096, LIQUID_FFT_C2R)
+void benchmark_fft_c2r_1000     FFT_REAL_BENCHMARK_API(1000, LIQUID_FFT_C2R)
+
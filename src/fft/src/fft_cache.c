@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_cache.c : process-wide cache of pre-computed FFT plan data
+//               (twiddle factors, index tables, Rader sequences) and
+//               measured FFT method "wisdom"
+//
+// Plans of the same size, direction, and method share identical
+// read-only tables; computing these (particularly the transformed
+// Rader sequences, which require running a sub-transform) dominates
+// plan creation time.  Entries are reference counted and persist
+// after their last user releases them so that objects which create
+// and destroy plans repeatedly (e.g. per burst) only pay the cost
+// once.  Call liquid_fft_cache_clear() to release unused memory.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#   include <pthread.h>
+static pthread_mutex_t liquid_fft_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#   define LIQUID_FFT_CACHE_LOCK()   pthread_mutex_lock(&liquid_fft_cache_mutex)
+#   define LIQUID_FFT_CACHE_UNLOCK() pthread_mutex_unlock(&liquid_fft_cache_mutex)
+#else
+#   define LIQUID_FFT_CACHE_LOCK()
+#   define LIQUID_FFT_CACHE_UNLOCK()
+#endif
+
+// cache entry
+struct liquid_fft_cache_entry_s {
+    unsigned int nfft;          // transform size
+    int direction;              // transform direction
+    liquid_fft_cache_tag tag;   // type of data stored
+    void * data;                // pointer to shared data
+    unsigned int num_refs;      // number of plans using this entry
+    struct liquid_fft_cache_entry_s * next;
+};
+
+// wisdom entry: fastest measured method for a given size/direction
+struct liquid_fft_wisdom_entry_s {
+    unsigned int nfft;          // transform size
+    int direction;              // transform direction
+    liquid_fft_method method;   // measured method
+    struct liquid_fft_wisdom_entry_s * next;
+};
+
+static struct liquid_fft_cache_entry_s  * liquid_fft_cache  = NULL;
+static struct liquid_fft_wisdom_entry_s * liquid_fft_wisdom = NULL;
+
+// look up shared data in cache, incrementing its reference count
+//  _nfft   :   transform size
+//  _dir    :   transform direction
+//  _tag    :   type of data
+// returns NULL if data are not found
+void * liquid_fft_cache_acquire(unsigned int         _nfft,
+                                int                  _dir,
+                                liquid_fft_cache_tag _tag)
+{
+    void * data = NULL;
+
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_cache_entry_s * e;
+    for (e=liquid_fft_cache; e!=NULL; e=e->next) {
+        if (e->nfft == _nfft && e->direction == _dir && e->tag == _tag) {
+            e->num_refs++;
+            data = e->data;
+            break;
+        }
+    }
+    LIQUID_FFT_CACHE_UNLOCK();
+
+    return data;
+}
+
+// insert newly-computed data into cache with a reference count of one;
+// if another thread has inserted the same entry in the meantime, the
+// input is freed and the existing data are returned instead
+//  _nfft   :   transform size
+//  _dir    :   transform direction
+//  _tag    :   type of data
+//  _data   :   data allocated with malloc(), owned by cache afterwards
+void * liquid_fft_cache_insert(unsigned int         _nfft,
+                               int                  _dir,
+                               liquid_fft_cache_tag _tag,
+                               void *               _data)
+{
+    void * data = _data;
+
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_cache_entry_s * e;
+    for (e=liquid_fft_cache; e!=NULL; e=e->next) {
+        if (e->nfft == _nfft && e->direction == _dir && e->tag == _tag)
+            break;
+    }
+
+    if (e != NULL) {
+        // lost race; use existing entry
+        e->num_refs++;
+        data = e->data;
+        free(_data);
+    } else {
+        // add new entry to front of list
+        e = (struct liquid_fft_cache_entry_s *) malloc(sizeof(struct liquid_fft_cache_entry_s));
+        e->nfft      = _nfft;
+        e->direction = _dir;
+        e->tag       = _tag;
+        e->data      = _data;
+        e->num_refs  = 1;
+        e->next      = liquid_fft_cache;
+        liquid_fft_cache = e;
+    }
+    LIQUID_FFT_CACHE_UNLOCK();
+
+    return data;
+}
+
+// release reference to shared data (data are retained in cache)
+void liquid_fft_cache_release(void * _data)
+{
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_cache_entry_s * e;
+    for (e=liquid_fft_cache; e!=NULL; e=e->next) {
+        if (e->data == _data) {
+            if (e->num_refs == 0) {
+                fprintf(stderr,"warning: liquid_fft_cache_release(), entry has no references\n");
+            } else {
+                e->num_refs--;
+            }
+            break;
+        }
+    }
+    LIQUID_FFT_CACHE_UNLOCK();
+
+    if (e == NULL) {
+        fprintf(stderr,"error: liquid_fft_cache_release(), data not found in cache\n");
+        exit(1);
+    }
+}
+
+// free all cached plan data not currently used by any plan
+void liquid_fft_cache_clear()
+{
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_cache_entry_s ** p = &liquid_fft_cache;
+    while (*p != NULL) {
+        struct liquid_fft_cache_entry_s * e = *p;
+        if (e->num_refs == 0) {
+            *p = e->next;
+            free(e->data);
+            free(e);
+        } else {
+            p = &e->next;
+        }
+    }
+    LIQUID_FFT_CACHE_UNLOCK();
+}
+
+// get number of entries in plan cache
+unsigned int liquid_fft_cache_get_num_entries()
+{
+    unsigned int n = 0;
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_cache_entry_s * e;
+    for (e=liquid_fft_cache; e!=NULL; e=e->next)
+        n++;
+    LIQUID_FFT_CACHE_UNLOCK();
+    return n;
+}
+
+// look up measured method for transform of a given size and direction,
+// returning LIQUID_FFT_METHOD_UNKNOWN if no wisdom exists
+liquid_fft_method liquid_fft_wisdom_lookup(unsigned int _nfft,
+                                           int          _dir)
+{
+    liquid_fft_method method = LIQUID_FFT_METHOD_UNKNOWN;
+
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_wisdom_entry_s * e;
+    for (e=liquid_fft_wisdom; e!=NULL; e=e->next) {
+        if (e->nfft == _nfft && e->direction == _dir) {
+            method = e->method;
+            break;
+        }
+    }
+    LIQUID_FFT_CACHE_UNLOCK();
+
+    return method;
+}
+
+// store measured method for transform of a given size and direction
+void liquid_fft_wisdom_store(unsigned int      _nfft,
+                             int               _dir,
+                             liquid_fft_method _method)
+{
+    LIQUID_FFT_CACHE_LOCK();
+    struct liquid_fft_wisdom_entry_s * e;
+    for (e=liquid_fft_wisdom; e!=NULL; e=e->next) {
+        if (e->nfft == _nfft && e->direction == _dir)
+            break;
+    }
+
+    if (e == NULL) {
+        e = (struct liquid_fft_wisdom_entry_s *) malloc(sizeof(struct liquid_fft_wisdom_entry_s));
+        e->nfft      = _nfft;
+        e->direction = _dir;
+        e->next      = liquid_fft_wisdom;
+        liquid_fft_wisdom = e;
+    }
+    e->method = _method;
+    LIQUID_FFT_CACHE_UNLOCK();
+}
+
+// forget all measured methods
+void liquid_fft_wisdom_clear()
+{
+    LIQUID_FFT_CACHE_LOCK();
+    while (liquid_fft_wisdom != NULL) {
+        struct liquid_fft_wisdom_entry_s * e = liquid_fft_wisdom;
+        liquid_fft_wisdom = e->next;
+        free(e);
+    }
+    LIQUID_FFT_CACHE_UNLOCK();
+}
+
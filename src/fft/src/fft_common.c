@@ -23,6 +23,8 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
+#include <math.h>
 #include "liquid.internal.h"
 
 struct FFT(plan_s)
@@ -58,6 +60,31 @@ struct FFT(plan_s)
             TC * twiddle;               // twiddle factors
         } radix2;
 
+        // radix-4 (self-sorting Stockham) transform data
+        struct {
+            unsigned int m;             // log2(nfft)
+            TC * twiddle;               // twiddle factors
+            TC * twiddle4;              // first-stage twiddles (packed)
+            TC * buf;                   // intermediate stage buffer
+            liquid_simd_level simd;     // SIMD extensions in use
+        } radix4;
+
+        // batch of independent transforms of equal size
+        struct {
+            unsigned int howmany;       // number of transforms
+            unsigned int istride;       // input element stride
+            unsigned int idist;         // input transform distance
+            unsigned int ostride;       // output element stride
+            unsigned int odist;         // output transform distance
+            TC * x;                     // contiguous input buffer
+            TC * y;                     // contiguous output buffer
+            FFT(plan) fft;              // single transform (x -> y)
+            unsigned int m;             // log2(nfft) if interleaved, else 0
+            TC * buf0;                  // interleaved stage buffer
+            TC * twiddle;               // twiddle factors (interleaved)
+            liquid_simd_level simd;     // SIMD extensions in use
+        } many;
+
         // recursive mixed-radix transform data:
         //  - compute 'Q' FFTs of size 'P'
         //  - apply twiddle factors
@@ -94,6 +121,26 @@ struct FFT(plan_s)
             FFT(plan) fft;      // sub-FFT of size nfft_prime
             FFT(plan) ifft;     // sub-IFFT of size nfft_prime
         } rader2;
+
+        // real-to-complex/complex-to-real transforms
+        struct {
+            TC * z;             // complex time-domain buffer
+            TC * Z;             // complex freq-domain buffer
+            TC * twiddle;       // twiddle factors exp(-j*2*pi*k/nfft) (even nfft)
+            FFT(plan) fft;      // complex transform of size nfft/2 (nfft if odd)
+            liquid_simd_level simd; // SIMD extensions in use
+        } real;
+
+        // real-to-real transforms (DCT/DST/MDCT)
+        struct {
+            unsigned int n;     // size of internal transform
+            T * buf;            // real buffer (reversed input, folding)
+            T * v;              // internal real transform buffer
+            TC * z;             // internal complex transform input
+            TC * Z;             // internal complex transform output
+            TC * twiddle;       // pre/post rotation factors
+            FFT(plan) fft;      // internal transform (r2c, c2r or complex)
+        } r2r;
     } data;
 };
 
@@ -102,19 +149,44 @@ struct FFT(plan_s)
 //  _x      :   input array [size: _nfft x 1]
 //  _y      :   output array [size: _nfft x 1]
 //  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
-//  _method :   fft method
+//  _flags  :   fft flags (e.g. LIQUID_FFT_MEASURE)
 FFT(plan) FFT(_create_plan)(unsigned int _nfft,
                             TC *         _x,
                             TC *         _y,
                             int          _dir,
                             int          _flags)
 {
-    // determine best method for execution
-    // TODO : check flags and allow user override
-    liquid_fft_method method = liquid_fft_estimate_method(_nfft);
+    int dir = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+
+    // use previously-measured method if available, otherwise
+    // measure (if requested) or estimate best method
+    liquid_fft_method method = liquid_fft_wisdom_lookup(_nfft, dir);
+    if (method == LIQUID_FFT_METHOD_UNKNOWN) {
+        if (_flags & LIQUID_FFT_MEASURE)
+            method = FFT(_measure_method)(_nfft, dir, _flags);
+        else
+            method = liquid_fft_estimate_method(_nfft);
+    }
+
+    return FFT(_create_plan_method)(_nfft, _x, _y, _dir, _flags, method);
+}
 
+// create FFT plan using specific method
+//  _nfft   :   FFT size
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags
+//  _method :   fft method
+FFT(plan) FFT(_create_plan_method)(unsigned int      _nfft,
+                                   TC *              _x,
+                                   TC *              _y,
+                                   int               _dir,
+                                   int               _flags,
+                                   liquid_fft_method _method)
+{
     // initialize fft based on method
-    switch (method) {
+    switch (_method) {
     case LIQUID_FFT_METHOD_RADIX2:
         // use radix-2 decimation-in-time method
         return FFT(_create_plan_radix2)(_nfft, _x, _y, _dir, _flags);
@@ -131,6 +203,10 @@ FFT(plan) FFT(_create_plan)(unsigned int _nfft,
         // use Rader's algorithm for FFTs of prime length
         return FFT(_create_plan_rader2)(_nfft, _x, _y, _dir, _flags);
 
+    case LIQUID_FFT_METHOD_RADIX4:
+        // use radix-4 Stockham (self-sorting) method
+        return FFT(_create_plan_radix4)(_nfft, _x, _y, _dir, _flags);
+
     case LIQUID_FFT_METHOD_DFT:
         // use slow DFT
         return FFT(_create_plan_dft)(_nfft, _x, _y, _dir, _flags);
@@ -144,6 +220,121 @@ FFT(plan) FFT(_create_plan)(unsigned int _nfft,
     return NULL;
 }
 
+// time candidate methods for transform of a given size and store the
+// fastest as wisdom for subsequent plans
+//  _nfft   :   FFT size
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags (passed to sub-transforms)
+liquid_fft_method FFT(_measure_method)(unsigned int _nfft,
+                                       int          _dir,
+                                       int          _flags)
+{
+    liquid_fft_method method = liquid_fft_estimate_method(_nfft);
+    if (method == LIQUID_FFT_METHOD_UNKNOWN)
+        return method;
+
+    // build list of candidate methods valid for this size
+    liquid_fft_method candidates[5];
+    unsigned int num_candidates = 0;
+    if (_nfft <= 32)
+        candidates[num_candidates++] = LIQUID_FFT_METHOD_DFT;
+    if (_nfft >= 4 && fft_is_radix2(_nfft)) {
+        candidates[num_candidates++] = LIQUID_FFT_METHOD_RADIX2;
+        candidates[num_candidates++] = LIQUID_FFT_METHOD_RADIX4;
+    }
+    if (_nfft > 3 && liquid_is_prime(_nfft)) {
+        candidates[num_candidates++] = LIQUID_FFT_METHOD_RADER;
+        candidates[num_candidates++] = LIQUID_FFT_METHOD_RADER2;
+    } else if (_nfft > 3 && FFT(_estimate_mixed_radix)(_nfft) < _nfft) {
+        candidates[num_candidates++] = LIQUID_FFT_METHOD_MIXED_RADIX;
+    }
+
+    TC * x = (TC*) malloc(_nfft*sizeof(TC));
+    TC * y = (TC*) malloc(_nfft*sizeof(TC));
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        x[i] = 1.0f / (T)(i+1);
+
+    // time each candidate, doubling the number of trials until the
+    // measurement spans at least a few clock ticks
+    double t_min = 0.0;
+    unsigned int k;
+    for (k=0; k<num_candidates; k++) {
+        FFT(plan) q = FFT(_create_plan_method)(_nfft, x, y, _dir, _flags, candidates[k]);
+
+        unsigned long int n, num_trials = 1;
+        clock_t elapsed;
+        while (1) {
+            clock_t t0 = clock();
+            for (n=0; n<num_trials; n++)
+                FFT(_execute)(q);
+            elapsed = clock() - t0;
+            if (elapsed >= CLOCKS_PER_SEC/500 || num_trials >= (1UL<<24))
+                break;
+            num_trials <<= 1;
+        }
+        double t = (double)elapsed / (double)num_trials;
+
+        FFT(_destroy_plan)(q);
+
+        if (k==0 || t < t_min) {
+            t_min  = t;
+            method = candidates[k];
+        }
+    }
+
+    free(x);
+    free(y);
+
+    liquid_fft_wisdom_store(_nfft, _dir, method);
+    return method;
+}
+
+// get shared twiddle factors exp(j*dir*2*pi*i/nfft), i in [0,nfft),
+// computing and storing them in the fft cache if necessary; release
+// with liquid_fft_cache_release()
+TC * FFT(_cache_twiddle)(unsigned int _nfft,
+                         int          _dir)
+{
+    TC * twiddle = (TC*) liquid_fft_cache_acquire(_nfft, _dir, LIQUID_FFT_CACHE_TWIDDLE);
+    if (twiddle != NULL)
+        return twiddle;
+
+    twiddle = (TC *) malloc(_nfft * sizeof(TC));
+    T d = (_dir == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+    unsigned int i;
+    for (i=0; i<_nfft; i++)
+        twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(_nfft));
+
+    return (TC*) liquid_fft_cache_insert(_nfft, _dir, LIQUID_FFT_CACHE_TWIDDLE, twiddle);
+}
+
+// get shared Rader transformation sequence g^(i+1) mod nfft for prime
+// nfft, i in [0,nfft-1), where g is the primitive root of nfft; release
+// with liquid_fft_cache_release()
+unsigned int * FFT(_cache_rader_seq)(unsigned int _nfft)
+{
+    unsigned int * seq = (unsigned int*) liquid_fft_cache_acquire(_nfft, 0, LIQUID_FFT_CACHE_RADER_SEQ);
+    if (seq != NULL)
+        return seq;
+
+    // compute primitive root of nfft
+    unsigned int g = liquid_primitive_root_prime(_nfft);
+
+    seq = (unsigned int *) malloc((_nfft-1)*sizeof(unsigned int));
+    unsigned int i;
+    for (i=0; i<_nfft-1; i++)
+        seq[i] = liquid_modpow(g, i+1, _nfft);
+
+    return (unsigned int*) liquid_fft_cache_insert(_nfft, 0, LIQUID_FFT_CACHE_RADER_SEQ, seq);
+}
+
+// get method used by plan
+liquid_fft_method FFT(_get_method)(FFT(plan) _q)
+{
+    return _q->method;
+}
+
 // destroy FFT plan
 void FFT(_destroy_plan)(FFT(plan) _q)
 {
@@ -157,6 +348,8 @@ void FFT(_destroy_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: FFT(_destroy_plan_mixed_radix)(_q); return;
         case LIQUID_FFT_METHOD_RADER:       FFT(_destroy_plan_rader)(_q);       return;
         case LIQUID_FFT_METHOD_RADER2:      FFT(_destroy_plan_rader2)(_q);      return;
+        case LIQUID_FFT_METHOD_RADIX4:      FFT(_destroy_plan_radix4)(_q);      return;
+        case LIQUID_FFT_METHOD_BATCH:       FFT(_destroy_plan_many)(_q);        return;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -173,12 +366,17 @@ void FFT(_destroy_plan)(FFT(plan) _q)
     case LIQUID_FFT_RODFT10:
     case LIQUID_FFT_RODFT01:
     case LIQUID_FFT_RODFT11:
+    // modified discrete cosine transform
+    case LIQUID_FFT_MDCT:
+    case LIQUID_FFT_IMDCT:
         FFT(_destroy_plan_r2r_1d)(_q);
         break;
 
-    // modified discrete cosine transform
-    case LIQUID_FFT_MDCT:   break;
-    case LIQUID_FFT_IMDCT:  break;
+    // real-to-complex/complex-to-real transforms
+    case LIQUID_FFT_R2C:
+    case LIQUID_FFT_C2R:
+        FFT(_destroy_plan_real)(_q);
+        break;
 
     case LIQUID_FFT_UNKNOWN:
     default:
@@ -203,6 +401,8 @@ void FFT(_print_plan)(FFT(plan) _q)
         case LIQUID_FFT_METHOD_MIXED_RADIX: printf("Cooley-Tukey\n");       break;
         case LIQUID_FFT_METHOD_RADER:       printf("Rader (Type I)\n");     break;
         case LIQUID_FFT_METHOD_RADER2:      printf("Rader (Type II)\n");    break;
+        case LIQUID_FFT_METHOD_RADIX4:      printf("Radix-4\n");            break;
+        case LIQUID_FFT_METHOD_BATCH:       printf("batch of %u\n", _q->data.many.howmany); break;
         case LIQUID_FFT_METHOD_UNKNOWN:
         default:
             fprintf(stderr,"error: fft_destroy_plan(), unknown/invalid fft method\n");
@@ -221,12 +421,20 @@ void FFT(_print_plan)(FFT(plan) _q)
     case LIQUID_FFT_RODFT10:
     case LIQUID_FFT_RODFT01:
     case LIQUID_FFT_RODFT11:
-        FFT(_print_plan)(_q);
+    // modified discrete cosine transform
+    case LIQUID_FFT_MDCT:
+    case LIQUID_FFT_IMDCT:
+        FFT(_print_plan_r2r_1d)(_q);
         break;
 
-    // modified discrete cosine transform
-    case LIQUID_FFT_MDCT:   break;
-    case LIQUID_FFT_IMDCT:  break;
+    // real-to-complex/complex-to-real transforms
+    case LIQUID_FFT_R2C:
+    case LIQUID_FFT_C2R:
+        printf("fft plan [%s], n=%u\n",
+                _q->type == LIQUID_FFT_R2C ? "real-to-complex" : "complex-to-real",
+                _q->nfft);
+        FFT(_print_plan_recursive)(_q, 0);
+        break;
 
     case LIQUID_FFT_UNKNOWN:
     default:
@@ -245,6 +453,13 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
         printf("  ");
     printf("%u, ", _q->nfft);
 
+    // real transforms compute complex transform internally
+    if (_q->type == LIQUID_FFT_R2C || _q->type == LIQUID_FFT_C2R) {
+        printf("real (%s)\n", _q->nfft % 2 ? "full-size" : "half-size");
+        FFT(_print_plan_recursive)(_q->data.real.fft, _level+1);
+        return;
+    }
+
     switch (_q->method) {
     case LIQUID_FFT_METHOD_DFT:
         printf("DFT\n");
@@ -254,6 +469,12 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
         printf("Radix-2\n");
         break;
 
+    case LIQUID_FFT_METHOD_RADIX4:
+        printf("Radix-4 Stockham (%s)\n",
+                _q->data.radix4.simd >= LIQUID_SIMD_AVX2 ? "avx2" :
+                _q->data.radix4.simd == LIQUID_SIMD_SSE  ? "sse2" : "portable");
+        break;
+
     case LIQUID_FFT_METHOD_MIXED_RADIX:
         // two internal transforms
         printf("Cooley-Tukey mixed radix, Q=%u, P=%u\n",
@@ -263,6 +484,12 @@ void FFT(_print_plan_recursive)(FFT(plan)    _q,
         FFT(_print_plan_recursive)(_q->data.mixedradix.fft_P, _level+1);
         break;
 
+    case LIQUID_FFT_METHOD_BATCH:
+        printf("batch of %u transforms%s\n", _q->data.many.howmany,
+                _q->data.many.m > 0 ? " (interleaved)" : "");
+        FFT(_print_plan_recursive)(_q->data.many.fft, _level+1);
+        break;
+
     case LIQUID_FFT_METHOD_RADER:
         printf("Rader (Type-II), nfft-prime=%u\n", _q->nfft-1);
         FFT(_print_plan_recursive)(_q->data.rader.fft, _level+1);
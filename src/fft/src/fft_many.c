@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_many.c : batches of independent transforms of equal size
+//
+// When the transforms are interleaved in memory (element stride equal
+// to the number of transforms, unit distance) and of power-of-two
+// length, radix-4 stages are run over the whole batch at once so that
+// every stage is vectorized across transforms without any data
+// re-ordering.  Otherwise each transform is computed with a single
+// plan, directly on contiguous data or through internal buffers.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "liquid.internal.h"
+
+// create batch of FFT plans
+//  _nfft   :   FFT size
+//  _howmany:   number of transforms
+//  _x      :   input array
+//  _istride:   input element stride
+//  _idist  :   input distance between transforms
+//  _y      :   output array
+//  _ostride:   output element stride
+//  _odist  :   output distance between transforms
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_many)(unsigned int _nfft,
+                                 unsigned int _howmany,
+                                 TC *         _x,
+                                 unsigned int _istride,
+                                 unsigned int _idist,
+                                 TC *         _y,
+                                 unsigned int _ostride,
+                                 unsigned int _odist,
+                                 int          _dir,
+                                 int          _flags)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), fft size must be greater than zero\n");
+        exit(1);
+    } else if (_howmany == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), number of transforms must be greater than zero\n");
+        exit(1);
+    } else if (_istride == 0 || _ostride == 0) {
+        fprintf(stderr,"error: fft_create_plan_many(), strides must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = _x;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_BATCH;
+
+    q->execute   = FFT(_execute_many);
+
+    q->data.many.howmany = _howmany;
+    q->data.many.istride = _istride;
+    q->data.many.idist   = _idist;
+    q->data.many.ostride = _ostride;
+    q->data.many.odist   = _odist;
+
+    // single-transform plan operating on contiguous buffers
+    q->data.many.x   = (TC *) malloc(q->nfft * sizeof(TC));
+    q->data.many.y   = (TC *) malloc(q->nfft * sizeof(TC));
+    q->data.many.fft = FFT(_create_plan)(q->nfft,
+                                         q->data.many.x,
+                                         q->data.many.y,
+                                         q->direction,
+                                         q->flags);
+
+    // run power-of-two transforms interleaved in memory as a single
+    // batch across all stages
+    q->data.many.m       = 0;
+    q->data.many.buf0    = NULL;
+    q->data.many.twiddle = NULL;
+    q->data.many.simd    = liquid_cpu_get_simd_level();
+    if (q->nfft >= 2 && fft_is_radix2(q->nfft) && _howmany > 1 &&
+        _istride == _howmany && _idist == 1 &&
+        _ostride == _howmany && _odist == 1)
+    {
+        q->data.many.m       = liquid_msb_index(q->nfft) - 1;
+        q->data.many.buf0    = (TC *) malloc(q->nfft * _howmany * sizeof(TC));
+        q->data.many.twiddle = FFT(_cache_twiddle)(q->nfft, q->direction);
+    }
+
+    return q;
+}
+
+// destroy batch of FFT plans
+void FFT(_destroy_plan_many)(FFT(plan) _q)
+{
+    FFT(_destroy_plan)(_q->data.many.fft);
+    free(_q->data.many.x);
+    free(_q->data.many.y);
+
+    if (_q->data.many.m > 0) {
+        free(_q->data.many.buf0);
+        liquid_fft_cache_release(_q->data.many.twiddle);
+    }
+
+    // free main object memory
+    free(_q);
+}
+
+// execute batch of power-of-two transforms interleaved in memory
+void FFT(_execute_many_interleaved)(FFT(plan) _q)
+{
+    unsigned int b = _q->data.many.howmany;
+    unsigned int m = _q->data.many.m;
+    TC * twiddle = _q->data.many.twiddle;
+#if LIQUID_CPU_X86
+    liquid_simd_level simd = _q->data.many.simd;
+#endif
+
+    // alternate stage outputs between internal buffer and output
+    // such that the final stage writes to output
+    unsigned int num_stages = m/2 + (m%2);
+    TC * x = _q->x;
+    TC * y = (num_stages % 2) ? _q->y : _q->data.many.buf0;
+    if (x == y) {
+        // in-place transform: first stage cannot write to its input
+        memmove(_q->data.many.buf0, x, _q->nfft*b*sizeof(TC));
+        x = _q->data.many.buf0;
+    }
+
+    unsigned int n = _q->nfft;  // sub-transform length
+    unsigned int s = 1;         // stride
+    unsigned int k;
+    for (k=0; k<num_stages; k++) {
+        if (n >= 4) {
+#if LIQUID_CPU_X86
+            if (simd >= LIQUID_SIMD_AVX2 && (s*b % 4)==0)
+                fft_radix4_stage_avx2(n, s, b, _q->direction, x, y, twiddle);
+            else if (simd >= LIQUID_SIMD_SSE && (s*b % 2)==0)
+                fft_radix4_stage_sse(n, s, b, _q->direction, x, y, twiddle);
+            else
+#endif
+                FFT(_radix4_stage)(n, s, b, _q->direction, x, y, twiddle);
+            n >>= 2;
+            s <<= 2;
+        } else {
+            // final radix-2 stage
+#if LIQUID_CPU_X86
+            if (simd >= LIQUID_SIMD_AVX2 && (s*b % 4)==0)
+                fft_radix2_stage_avx2(s*b, x, y);
+            else if (simd >= LIQUID_SIMD_SSE && (s*b % 2)==0)
+                fft_radix2_stage_sse(s*b, x, y);
+            else
+#endif
+                FFT(_radix2_stage)(s*b, x, y);
+        }
+
+        // swap buffers
+        x = y;
+        y = (y == _q->y) ? _q->data.many.buf0 : _q->y;
+    }
+}
+
+// execute batch of FFT plans
+void FFT(_execute_many)(FFT(plan) _q)
+{
+    if (_q->data.many.m > 0) {
+        FFT(_execute_many_interleaved)(_q);
+        return;
+    }
+
+    unsigned int nfft    = _q->nfft;
+    unsigned int howmany = _q->data.many.howmany;
+    unsigned int istride = _q->data.many.istride;
+    unsigned int idist   = _q->data.many.idist;
+    unsigned int ostride = _q->data.many.ostride;
+    unsigned int odist   = _q->data.many.odist;
+    unsigned int i, k;
+
+    // one transform at a time
+    FFT(plan) fft = _q->data.many.fft;
+    for (k=0; k<howmany; k++) {
+        TC * x = _q->x + k*idist;
+        TC * y = _q->y + k*odist;
+        if (istride == 1 && ostride == 1 && _q->x != _q->y) {
+            // operate directly on contiguous input/output
+            fft->x = x;
+            fft->y = y;
+            FFT(_execute)(fft);
+        } else {
+            fft->x = _q->data.many.x;
+            fft->y = _q->data.many.y;
+            for (i=0; i<nfft; i++)
+                fft->x[i] = x[i*istride];
+            FFT(_execute)(fft);
+            for (i=0; i<nfft; i++)
+                y[i*ostride] = fft->y[i];
+        }
+    }
+}
+
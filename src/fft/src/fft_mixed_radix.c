@@ -56,7 +56,6 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
     q->execute   = FFT(_execute_mixed_radix);
 
     // find first 'prime' factor of _nfft
-    unsigned int i;
     unsigned int Q = FFT(_estimate_mixed_radix)(_nfft);
     if (Q==0) {
         fprintf(stderr,"error: fft_create_plan_mixed_radix(), _nfft=%u is prime\n", _nfft);
@@ -93,13 +92,8 @@ FFT(plan) FFT(_create_plan_mixed_radix)(unsigned int _nfft,
                                                  q->direction,
                                                  q->flags);
 
-    // initialize twiddle factors, indices for mixed-radix transforms
-    // TODO : only allocate necessary twiddle factors
-    q->data.mixedradix.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.mixedradix.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // initialize twiddle factors for mixed-radix transforms (shared)
+    q->data.mixedradix.twiddle = FFT(_cache_twiddle)(q->nfft, q->direction);
 
     return q;
 }
@@ -115,7 +109,7 @@ void FFT(_destroy_plan_mixed_radix)(FFT(plan) _q)
     free(_q->data.mixedradix.t0);
     free(_q->data.mixedradix.t1);
     free(_q->data.mixedradix.x);
-    free(_q->data.mixedradix.twiddle);
+    liquid_fft_cache_release(_q->data.mixedradix.twiddle);
 
     // free main object memory
     free(_q);
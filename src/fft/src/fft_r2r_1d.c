@@ -18,18 +18,40 @@
  */
 
 //
-// fft_r2r_1d.c : real-to-real methods (DCT/DST)
+// fft_r2r_1d.c : real-to-real methods (DCT/DST/MDCT)
+//
+// All transforms are computed in O(n log n) time on top of the
+// real-to-complex/complex-to-real transforms (see fft_real.c) or a
+// half-size complex transform:
+//  - DCT-I/DST-I : real transform of the even/odd extension of the
+//                  input (size 2(n-1) and 2(n+1), respectively)
+//  - DCT-II/III  : real transform of size n of the re-ordered
+//                  sequence with a pre/post rotation [Makhoul:1980]
+//  - DCT-IV      : complex transform of size n/2 with pre/post
+//                  rotations (size 2n if n is odd)
+//  - DST-II/III/IV : DCT of the same kind with the input reversed or
+//                  sign-alternated
+//  - MDCT/IMDCT  : DCT-IV of size n with input folding/output
+//                  unfolding (n even)
+// Scaling follows the conventions of FFTW, viz. each transform is
+// twice the corresponding sum of products.
+//
+// References:
+//  [Makhoul:1980] J. Makhoul, "A Fast Cosine Transform in One and Two
+//      Dimensions," IEEE Transactions on Acoustics, Speech, and
+//      Signal Processing, vol. ASSP-28, no. 1, pp. 27--34, 1980
 //
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 #include "liquid.internal.h"
 
-// create DCT/DST plan
+// create DCT/DST/MDCT plan
 //  _nfft   :   FFT size
-//  _x      :   input array [size: _nfft x 1]
-//  _y      :   output array [size: _nfft x 1]
+//  _x      :   input array [size: _nfft x 1, 2*_nfft x 1 for MDCT]
+//  _y      :   output array [size: _nfft x 1, 2*_nfft x 1 for IMDCT]
 //  _type   :   type (e.g. LIQUID_FFT_REDFT00)
 //  _method :   fft method
 FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _nfft,
@@ -38,17 +60,101 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _nfft,
                                    int          _type,
                                    int          _flags)
 {
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: fft_create_plan_r2r_1d(), fft size must be > 0\n");
+        exit(1);
+    } else if (_type == LIQUID_FFT_REDFT00 && _nfft < 2) {
+        fprintf(stderr,"error: fft_create_plan_r2r_1d(), DCT-I size must be at least 2\n");
+        exit(1);
+    } else if ((_type == LIQUID_FFT_MDCT || _type == LIQUID_FFT_IMDCT) && (_nfft % 2)) {
+        fprintf(stderr,"error: fft_create_plan_r2r_1d(), MDCT size must be even\n");
+        exit(1);
+    }
+
     // allocate plan and initialize all internal arrays to NULL
     FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
 
     q->nfft   = _nfft;
+    q->x      = NULL;
+    q->y      = NULL;
     q->xr     = _x;
     q->yr     = _y;
     q->type   = _type;
     q->flags  = _flags;
+    q->method = LIQUID_FFT_METHOD_UNKNOWN;
+
+    q->data.r2r.buf     = NULL;
+    q->data.r2r.v       = NULL;
+    q->data.r2r.z       = NULL;
+    q->data.r2r.Z       = NULL;
+    q->data.r2r.twiddle = NULL;
+    q->data.r2r.fft     = NULL;
+
+    unsigned int n = q->nfft;
+    unsigned int i;
+    switch (q->type) {
+    case LIQUID_FFT_REDFT00:    // DCT-I
+    case LIQUID_FFT_RODFT00:    // DST-I
+        // real transform of even/odd extension
+        q->data.r2r.n = (q->type == LIQUID_FFT_REDFT00) ? 2*(n-1) : 2*(n+1);
+        q->data.r2r.v = (T *)  malloc(q->data.r2r.n * sizeof(T));
+        q->data.r2r.Z = (TC *) malloc((q->data.r2r.n/2+1) * sizeof(TC));
+        q->data.r2r.fft = FFT(_create_plan_r2c)(q->data.r2r.n, q->data.r2r.v, q->data.r2r.Z, q->flags);
+        break;
 
-    // TODO : use separate 'method' for real-to-real types
-    //q->method = LIQUID_FFT_METHOD_NONE;
+    case LIQUID_FFT_REDFT10:    // DCT-II
+    case LIQUID_FFT_RODFT10:    // DST-II
+    case LIQUID_FFT_REDFT01:    // DCT-III
+    case LIQUID_FFT_RODFT01:    // DST-III
+        // real transform of re-ordered sequence, rotation exp(-j*pi*k/(2n))
+        q->data.r2r.n = n;
+        q->data.r2r.v = (T *)  malloc(n * sizeof(T));
+        q->data.r2r.Z = (TC *) malloc((n/2+1) * sizeof(TC));
+        if (q->type == LIQUID_FFT_REDFT10 || q->type == LIQUID_FFT_RODFT10)
+            q->data.r2r.fft = FFT(_create_plan_r2c)(n, q->data.r2r.v, q->data.r2r.Z, q->flags);
+        else
+            q->data.r2r.fft = FFT(_create_plan_c2r)(n, q->data.r2r.Z, q->data.r2r.v, q->flags);
+        q->data.r2r.twiddle = (TC *) malloc(n * sizeof(TC));
+        for (i=0; i<n; i++)
+            q->data.r2r.twiddle[i] = cexpf(-_Complex_I*M_PI*(T)i / (T)(2*n));
+        if (q->type == LIQUID_FFT_RODFT10 || q->type == LIQUID_FFT_RODFT01)
+            q->data.r2r.buf = (T *) malloc(n * sizeof(T));
+        break;
+
+    case LIQUID_FFT_REDFT11:    // DCT-IV
+    case LIQUID_FFT_RODFT11:    // DST-IV
+    case LIQUID_FFT_MDCT:       // MDCT
+    case LIQUID_FFT_IMDCT:      // IMDCT
+        // complex transform of size n/2 with pre/post rotations, or
+        // of zero-padded sequence of size 2n if n is odd
+        q->data.r2r.n = (n % 2) ? 2*n : n/2;
+        q->data.r2r.z = (TC *) malloc(q->data.r2r.n * sizeof(TC));
+        q->data.r2r.Z = (TC *) malloc(q->data.r2r.n * sizeof(TC));
+        q->data.r2r.fft = FFT(_create_plan)(q->data.r2r.n, q->data.r2r.z, q->data.r2r.Z, LIQUID_FFT_FORWARD, q->flags);
+        if (n % 2) {
+            // pre: exp(-j*pi*i/(2n)), post: exp(-j*pi*(k+1/2)/(2n))
+            q->data.r2r.twiddle = (TC *) malloc(2 * n * sizeof(TC));
+            for (i=0; i<n; i++) {
+                q->data.r2r.twiddle[  i] = cexpf(-_Complex_I*M_PI*(T)i / (T)(2*n));
+                q->data.r2r.twiddle[n+i] = cexpf(-_Complex_I*M_PI*((T)i+0.5f) / (T)(2*n));
+            }
+        } else {
+            // pre: exp(-j*pi*(4i+1)/(4n)), post: exp(-j*pi*k/n)
+            q->data.r2r.twiddle = (TC *) malloc(n * sizeof(TC));
+            for (i=0; i<n/2; i++) {
+                q->data.r2r.twiddle[    i] = cexpf(-_Complex_I*M_PI*(T)(4*i+1) / (T)(4*n));
+                q->data.r2r.twiddle[n/2+i] = cexpf(-_Complex_I*M_PI*(T)i / (T)n);
+            }
+        }
+        if (q->type != LIQUID_FFT_REDFT11)
+            q->data.r2r.buf = (T *) malloc(n * sizeof(T));
+        break;
+
+    default:
+        fprintf(stderr,"error: fft_create_plan_r2r_1d(), invalid type, %d\n", q->type);
+        exit(1);
+    }
 
     switch (q->type) {
     case LIQUID_FFT_REDFT00:  q->execute = &FFT(_execute_REDFT00);  break;  // DCT-I
@@ -60,9 +166,10 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _nfft,
     case LIQUID_FFT_RODFT10:  q->execute = &FFT(_execute_RODFT10);  break;  // DST-II
     case LIQUID_FFT_RODFT01:  q->execute = &FFT(_execute_RODFT01);  break;  // DST-III
     case LIQUID_FFT_RODFT11:  q->execute = &FFT(_execute_RODFT11);  break;  // DST-IV
-    default:
-        fprintf(stderr,"error: fft_create_plan_r2r_1d(), invalid type, %d\n", q->type);
-        exit(1);
+
+    case LIQUID_FFT_MDCT:     q->execute = &FFT(_execute_MDCT);     break;  // MDCT
+    case LIQUID_FFT_IMDCT:    q->execute = &FFT(_execute_IMDCT);    break;  // IMDCT
+    default:;
     }
 
     return q;
@@ -71,6 +178,14 @@ FFT(plan) FFT(_create_plan_r2r_1d)(unsigned int _nfft,
 // destroy real-to-real transform plan
 void FFT(_destroy_plan_r2r_1d)(FFT(plan) _q)
 {
+    // destroy internal transform and free buffers
+    FFT(_destroy_plan)(_q->data.r2r.fft);
+    free(_q->data.r2r.buf);
+    free(_q->data.r2r.v);
+    free(_q->data.r2r.z);
+    free(_q->data.r2r.Z);
+    free(_q->data.r2r.twiddle);
+
     // free main object memory
     free(_q);
 }
@@ -78,8 +193,133 @@ void FFT(_destroy_plan_r2r_1d)(FFT(plan) _q)
 // print real-to-real transform plan
 void FFT(_print_plan_r2r_1d)(FFT(plan) _q)
 {
-    printf("real-to-real transform...\n");
-    // TODO: print actual transform type
+    printf("real-to-real transform, n=%u, ", _q->nfft);
+    switch (_q->type) {
+    case LIQUID_FFT_REDFT00:  printf("DCT-I\n");    break;
+    case LIQUID_FFT_REDFT10:  printf("DCT-II\n");   break;
+    case LIQUID_FFT_REDFT01:  printf("DCT-III\n");  break;
+    case LIQUID_FFT_REDFT11:  printf("DCT-IV\n");   break;
+    case LIQUID_FFT_RODFT00:  printf("DST-I\n");    break;
+    case LIQUID_FFT_RODFT10:  printf("DST-II\n");   break;
+    case LIQUID_FFT_RODFT01:  printf("DST-III\n");  break;
+    case LIQUID_FFT_RODFT11:  printf("DST-IV\n");   break;
+    case LIQUID_FFT_MDCT:     printf("MDCT\n");     break;
+    case LIQUID_FFT_IMDCT:    printf("IMDCT\n");    break;
+    default:                  printf("(unknown)\n");
+    }
+    FFT(_print_plan_recursive)(_q->data.r2r.fft, 1);
+}
+
+//
+// internal methods
+//
+
+// DCT-II core: _y[k] = 2 sum_i _x[i] cos(pi/n (i+1/2) k)
+//  _x      :   input array [size: n x 1]
+//  _y      :   output array [size: n x 1], may alias _x
+//  _sign   :   negate odd-indexed inputs (for DST-II)
+void FFT(_r2r_dct2)(FFT(plan) _q,
+                    T *       _x,
+                    T *       _y,
+                    int       _sign)
+{
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    T * v = _q->data.r2r.v;
+    T s = _sign ? -1.0f : 1.0f;
+
+    // re-order: even samples ascending, odd samples descending
+    for (i=0; 2*i<n; i++)
+        v[i] = _x[2*i];
+    for (i=0; 2*i+1<n; i++)
+        v[n-1-i] = s*_x[2*i+1];
+
+    // real transform, then rotate by exp(-j*pi*k/(2n)) using
+    // Hermitian symmetry for upper half of spectrum
+    FFT(_execute)(_q->data.r2r.fft);
+    TC * V = _q->data.r2r.Z;
+    TC * twiddle = _q->data.r2r.twiddle;
+    for (i=0; i<=n/2; i++)
+        _y[i] = 2.0f*(crealf(V[i])*crealf(twiddle[i]) - cimagf(V[i])*cimagf(twiddle[i]));
+    for (i=n/2+1; i<n; i++)
+        _y[i] = 2.0f*(crealf(V[n-i])*crealf(twiddle[i]) + cimagf(V[n-i])*cimagf(twiddle[i]));
+}
+
+// DCT-III core: _y[i] = _x[0] + 2 sum_{k>0} _x[k] cos(pi/n k (i+1/2))
+//  _x      :   input array [size: n x 1]
+//  _y      :   output array [size: n x 1], may alias _x
+//  _sign   :   negate odd-indexed outputs (for DST-III)
+void FFT(_r2r_dct3)(FFT(plan) _q,
+                    T *       _x,
+                    T *       _y,
+                    int       _sign)
+{
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    TC * V = _q->data.r2r.Z;
+    TC * twiddle = _q->data.r2r.twiddle;
+
+    // Hermitian spectrum of re-ordered output:
+    //  V[k] = exp(j*pi*k/(2n)) * (_x[k] - j*_x[n-k]), V[0] = _x[0]
+    V[0] = _x[0];
+    for (i=1; i<=n/2; i++) {
+        T wr = crealf(twiddle[i]), wi = cimagf(twiddle[i]);
+        V[i] = (wr*_x[i] - wi*_x[n-i]) - _Complex_I*(wr*_x[n-i] + wi*_x[i]);
+    }
+
+    // inverse real transform and restore order
+    FFT(_execute)(_q->data.r2r.fft);
+    T * v = _q->data.r2r.v;
+    T s = _sign ? -1.0f : 1.0f;
+    for (i=0; 2*i<n; i++)
+        _y[2*i] = v[i];
+    for (i=0; 2*i+1<n; i++)
+        _y[2*i+1] = s*v[n-1-i];
+}
+
+// DCT-IV core: _y[k] = 2 sum_i _x[i] cos(pi/n (i+1/2) (k+1/2))
+//  _x      :   input array [size: n x 1]
+//  _y      :   output array [size: n x 1], may alias _x
+void FFT(_r2r_dct4)(FFT(plan) _q,
+                    T *       _x,
+                    T *       _y)
+{
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    TC * z = _q->data.r2r.z;
+    TC * Z = _q->data.r2r.Z;
+    TC * twiddle = _q->data.r2r.twiddle;
+
+    if (n % 2) {
+        // odd length: zero-padded transform of size 2n
+        for (i=0; i<n; i++) {
+            z[i]   = _x[i]*crealf(twiddle[i]) + _Complex_I*_x[i]*cimagf(twiddle[i]);
+            z[n+i] = 0.0f;
+        }
+        FFT(_execute)(_q->data.r2r.fft);
+        for (i=0; i<n; i++)
+            _y[i] = 2.0f*(crealf(Z[i])*crealf(twiddle[n+i]) - cimagf(Z[i])*cimagf(twiddle[n+i]));
+        return;
+    }
+
+    // pack samples from both ends into complex sequence of size n/2
+    // and pre-rotate
+    unsigned int m = n/2;
+    for (i=0; i<m; i++) {
+        T a  = _x[2*i], b = _x[n-1-2*i];
+        T wr = crealf(twiddle[i]), wi = cimagf(twiddle[i]);
+        z[i] = (a*wr - b*wi) + _Complex_I*(a*wi + b*wr);
+    }
+
+    // complex transform and post-rotate; real and imaginary parts hold
+    // even outputs (ascending) and odd outputs (descending)
+    FFT(_execute)(_q->data.r2r.fft);
+    for (i=0; i<m; i++) {
+        T zr = crealf(Z[i]),         zi = cimagf(Z[i]);
+        T wr = crealf(twiddle[m+i]), wi = cimagf(twiddle[m+i]);
+        _y[2*i]     =  2.0f*(zr*wr - zi*wi);
+        _y[n-1-2*i] = -2.0f*(zr*wi + zi*wr);
+    }
 }
 
 //
@@ -89,79 +329,36 @@ void FFT(_print_plan_r2r_1d)(FFT(plan) _q)
 // DCT-I
 void FFT(_execute_REDFT00)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft-1);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        T x0 = _q->xr[0];       // first element
-        T xn = _q->xr[_q->nfft-1]; // last element
-        _q->yr[i] = 0.5f*( x0 + (i%2 ? -xn : xn));
-        for (k=1; k<_q->nfft-1; k++) {
-            phi = M_PI*n_inv*((float)k)*((float)i);
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
+    // real transform of even extension of size 2(n-1)
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    T * v = _q->data.r2r.v;
+    for (i=0; i<n; i++)
+        v[i] = _q->xr[i];
+    for (i=1; i<n-1; i++)
+        v[2*(n-1)-i] = _q->xr[i];
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    FFT(_execute)(_q->data.r2r.fft);
+    for (i=0; i<n; i++)
+        _q->yr[i] = crealf(_q->data.r2r.Z[i]);
 }
 
 // DCT-II (regular 'dct')
 void FFT(_execute_REDFT10)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)_q->nfft;
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k + 0.5f)*i;
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    FFT(_r2r_dct2)(_q, _q->xr, _q->yr, 0);
 }
 
 // DCT-III (regular 'idct')
 void FFT(_execute_REDFT01)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)_q->nfft;
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = _q->xr[0]*0.5f;
-        for (k=1; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)i + 0.5f)*k;
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    FFT(_r2r_dct3)(_q, _q->xr, _q->yr, 0);
 }
 
 // DCT-IV
 void FFT(_execute_REDFT11)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k+0.5f)*((float)i+0.5f);
-            _q->yr[i] += _q->xr[k]*cosf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    FFT(_r2r_dct4)(_q, _q->xr, _q->yr);
 }
 
 //
@@ -171,76 +368,94 @@ void FFT(_execute_REDFT11)(FFT(plan) _q)
 // DST-I
 void FFT(_execute_RODFT00)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft+1);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*(float)((k+1)*(i+1));
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+    // real transform of odd extension of size 2(n+1)
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    T * v = _q->data.r2r.v;
+    v[0]   = 0.0f;
+    v[n+1] = 0.0f;
+    for (i=0; i<n; i++) {
+        v[i+1]       =  _q->xr[i];
+        v[2*n+1-i]   = -_q->xr[i];
     }
+
+    FFT(_execute)(_q->data.r2r.fft);
+    for (i=0; i<n; i++)
+        _q->yr[i] = -cimagf(_q->data.r2r.Z[i+1]);
 }
 
 // DST-II
 void FFT(_execute_RODFT10)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k+0.5f)*(i+1);
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    // DCT-II of sign-alternated input, reversed
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    T * buf = _q->data.r2r.buf;
+    FFT(_r2r_dct2)(_q, _q->xr, buf, 1);
+    for (i=0; i<n; i++)
+        _q->yr[i] = buf[n-1-i];
 }
 
 // DST-III
 void FFT(_execute_RODFT01)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = ((i%2)==0 ? 0.5f : -0.5f) * _q->xr[_q->nfft-1];
-        for (k=0; k<_q->nfft-1; k++) {
-            phi = M_PI*n_inv*((float)k+1)*((float)i+0.5f);
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
-
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
-    }
+    // DCT-III of reversed input, sign-alternated
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    T * buf = _q->data.r2r.buf;
+    for (i=0; i<n; i++)
+        buf[i] = _q->xr[n-1-i];
+    FFT(_r2r_dct3)(_q, buf, _q->yr, 1);
 }
 
 // DST-IV
 void FFT(_execute_RODFT11)(FFT(plan) _q)
 {
-    // ugly, slow method
-    unsigned int i,k;
-    float n_inv = 1.0f / (float)(_q->nfft);
-    float phi;
-    for (i=0; i<_q->nfft; i++) {
-        _q->yr[i] = 0.0f;
-        for (k=0; k<_q->nfft; k++) {
-            phi = M_PI*n_inv*((float)k+0.5f)*((float)i+0.5f);
-            _q->yr[i] += _q->xr[k]*sinf(phi);
-        }
+    // DCT-IV of reversed input, sign-alternated
+    unsigned int n = _q->nfft;
+    unsigned int i;
+    T * buf = _q->data.r2r.buf;
+    for (i=0; i<n; i++)
+        buf[i] = _q->xr[n-1-i];
+    FFT(_r2r_dct4)(_q, buf, _q->yr);
+    for (i=1; i<n; i+=2)
+        _q->yr[i] = -_q->yr[i];
+}
 
-        // compensate for discrepancy
-        _q->yr[i] *= 2.0f;
+//
+// MDCT : Modified Discrete Cosine Transform
+//
+
+// MDCT: _y[k] = 2 sum_{i<2n} _x[i] cos(pi/n (i + 1/2 + n/2) (k+1/2))
+void FFT(_execute_MDCT)(FFT(plan) _q)
+{
+    // fold 2n inputs into n using (anti-)symmetry of the basis
+    // functions, then compute DCT-IV
+    unsigned int h = _q->nfft/2;
+    unsigned int i;
+    T * u = _q->data.r2r.buf;
+    T * x = _q->xr;
+    for (i=0; i<h; i++) {
+        u[i]   = -x[3*h-1-i] - x[3*h+i];
+        u[h+i] =  x[i]       - x[2*h-1-i];
+    }
+    FFT(_r2r_dct4)(_q, u, _q->yr);
+}
+
+// IMDCT: _y[i] = 2 sum_{k<n} _x[k] cos(pi/n (i + 1/2 + n/2) (k+1/2))
+void FFT(_execute_IMDCT)(FFT(plan) _q)
+{
+    // compute DCT-IV, then unfold n outputs into 2n
+    unsigned int h = _q->nfft/2;
+    unsigned int i;
+    T * v = _q->data.r2r.buf;
+    T * y = _q->yr;
+    FFT(_r2r_dct4)(_q, _q->xr, v);
+    for (i=0; i<h; i++) {
+        y[    i] =  v[h+i];
+        y[  h+i] = -v[2*h-1-i];
+        y[2*h+i] = -v[h-1-i];
+        y[3*h+i] = -v[i];
     }
 }
 
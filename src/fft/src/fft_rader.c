@@ -78,26 +78,26 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
                                            LIQUID_FFT_BACKWARD,
                                            q->flags);
 
-    // compute primitive root of nfft
-    unsigned int g = liquid_primitive_root_prime(q->nfft);
-
-    // create and initialize sequence
-    q->data.rader.seq = (unsigned int *)malloc((q->nfft-1)*sizeof(unsigned int));
-    unsigned int i;
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader.seq[i] = liquid_modpow(g, i+1, q->nfft);
-    
-    // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft-1
-    // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
-    // (use newly-created FFT plan of length nfft-1)
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader.seq[i]/(T)(q->nfft));
-    FFT(_execute)(q->data.rader.fft);
-
-    // copy result to R
-    q->data.rader.R = (TC*)malloc((q->nfft-1)*sizeof(TC));
-    memmove(q->data.rader.R, q->data.rader.X_prime, (q->nfft-1)*sizeof(TC));
+    // create and initialize sequence (shared, independent of direction)
+    q->data.rader.seq = FFT(_cache_rader_seq)(q->nfft);
+
+    // look up DFT of sequence in cache
+    q->data.rader.R = (TC*) liquid_fft_cache_acquire(q->nfft, q->direction, LIQUID_FFT_CACHE_RADER_R);
+    if (q->data.rader.R == NULL) {
+        // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft-1
+        // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
+        // (use newly-created FFT plan of length nfft-1)
+        unsigned int i;
+        T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+        for (i=0; i<q->nfft-1; i++)
+            q->data.rader.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader.seq[i]/(T)(q->nfft));
+        FFT(_execute)(q->data.rader.fft);
+
+        // copy result to R
+        TC * R = (TC*)malloc((q->nfft-1)*sizeof(TC));
+        memmove(R, q->data.rader.X_prime, (q->nfft-1)*sizeof(TC));
+        q->data.rader.R = (TC*) liquid_fft_cache_insert(q->nfft, q->direction, LIQUID_FFT_CACHE_RADER_R, R);
+    }
     
     // return main object
     return q;
@@ -107,8 +107,8 @@ FFT(plan) FFT(_create_plan_rader)(unsigned int _nfft,
 void FFT(_destroy_plan_rader)(FFT(plan) _q)
 {
     // free data specific to Rader's algorithm
-    free(_q->data.rader.seq);       // sequence
-    free(_q->data.rader.R);         // pre-computed transform of exp(j*2*pi*seq)
+    liquid_fft_cache_release(_q->data.rader.seq);   // sequence
+    liquid_fft_cache_release(_q->data.rader.R);     // pre-computed transform of exp(j*2*pi*seq)
     free(_q->data.rader.x_prime);   // sub-transform input array
     free(_q->data.rader.X_prime);   // sub-transform output array
 
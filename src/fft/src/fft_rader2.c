@@ -61,13 +61,8 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
 
     unsigned int i;
 
-    // compute primitive root of nfft
-    unsigned int g = liquid_primitive_root_prime(q->nfft);
-
-    // create and initialize sequence
-    q->data.rader2.seq = (unsigned int *)malloc((q->nfft-1)*sizeof(unsigned int));
-    for (i=0; i<q->nfft-1; i++)
-        q->data.rader2.seq[i] = liquid_modpow(g, i+1, q->nfft);
+    // create and initialize sequence (shared, independent of direction)
+    q->data.rader2.seq = FFT(_cache_rader_seq)(q->nfft);
 
 #if 0
     // compute larger FFT length greater than 2*nfft-4
@@ -143,17 +138,22 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
                                             LIQUID_FFT_BACKWARD,
                                             q->flags);
 
-    // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft_prime
-    // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
-    // (use newly-created FFT plan of length nfft_prime)
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->data.rader2.nfft_prime; i++)
-        q->data.rader2.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader2.seq[i%(q->nfft-1)]/(T)(q->nfft));
-    FFT(_execute)(q->data.rader2.fft);
-    
-    // copy result to R
-    q->data.rader2.R = (TC*)malloc(q->data.rader2.nfft_prime*sizeof(TC));
-    memmove(q->data.rader2.R, q->data.rader2.X_prime, q->data.rader2.nfft_prime*sizeof(TC));
+    // look up DFT of sequence in cache
+    q->data.rader2.R = (TC*) liquid_fft_cache_acquire(q->nfft, q->direction, LIQUID_FFT_CACHE_RADER2_R);
+    if (q->data.rader2.R == NULL) {
+        // compute DFT of sequence { exp(-j*2*pi*g^i/nfft }, size: nfft_prime
+        // NOTE: R[0] = -1, |R[k]| = sqrt(nfft) for k != 0
+        // (use newly-created FFT plan of length nfft_prime)
+        T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
+        for (i=0; i<q->data.rader2.nfft_prime; i++)
+            q->data.rader2.x_prime[i] = cexpf(_Complex_I*d*2*M_PI*q->data.rader2.seq[i%(q->nfft-1)]/(T)(q->nfft));
+        FFT(_execute)(q->data.rader2.fft);
+
+        // copy result to R
+        TC * R = (TC*)malloc(q->data.rader2.nfft_prime*sizeof(TC));
+        memmove(R, q->data.rader2.X_prime, q->data.rader2.nfft_prime*sizeof(TC));
+        q->data.rader2.R = (TC*) liquid_fft_cache_insert(q->nfft, q->direction, LIQUID_FFT_CACHE_RADER2_R, R);
+    }
 
     // return main object
     return q;
@@ -163,8 +163,8 @@ FFT(plan) FFT(_create_plan_rader2)(unsigned int _nfft,
 void FFT(_destroy_plan_rader2)(FFT(plan) _q)
 {
     // free data specific to Rader's algorithm
-    free(_q->data.rader2.seq);      // sequence
-    free(_q->data.rader2.R);        // pre-computed transform of exp(j*2*pi*seq)
+    liquid_fft_cache_release(_q->data.rader2.seq);  // sequence
+    liquid_fft_cache_release(_q->data.rader2.R);    // pre-computed transform of exp(j*2*pi*seq)
 
     free(_q->data.rader2.x_prime);   // sub-transform input array
     free(_q->data.rader2.X_prime);   // sub-transform output array
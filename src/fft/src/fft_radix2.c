@@ -54,17 +54,18 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
     // initialize twiddle factors, indices for radix-2 transforms
     q->data.radix2.m = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
     
-    q->data.radix2.index_rev = (unsigned int *) malloc((q->nfft)*sizeof(unsigned int));
-    unsigned int i;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.index_rev[i] = fft_reverse_index(i,q->data.radix2.m);
+    // NOTE: reversed indices are independent of direction
+    q->data.radix2.index_rev = (unsigned int *) liquid_fft_cache_acquire(q->nfft, 0, LIQUID_FFT_CACHE_INDEX_REV);
+    if (q->data.radix2.index_rev == NULL) {
+        unsigned int * index_rev = (unsigned int *) malloc((q->nfft)*sizeof(unsigned int));
+        unsigned int i;
+        for (i=0; i<q->nfft; i++)
+            index_rev[i] = fft_reverse_index(i,q->data.radix2.m);
+        q->data.radix2.index_rev = (unsigned int *) liquid_fft_cache_insert(q->nfft, 0, LIQUID_FFT_CACHE_INDEX_REV, index_rev);
+    }
 
-    // initialize twiddle factors
-    q->data.radix2.twiddle = (TC *) malloc(q->nfft * sizeof(TC));
-    
-    T d = (q->direction == LIQUID_FFT_FORWARD) ? -1.0 : 1.0;
-    for (i=0; i<q->nfft; i++)
-        q->data.radix2.twiddle[i] = cexpf(_Complex_I*d*2*M_PI*(T)i / (T)(q->nfft));
+    // initialize twiddle factors (shared)
+    q->data.radix2.twiddle = FFT(_cache_twiddle)(q->nfft, q->direction);
 
     return q;
 }
@@ -73,8 +74,8 @@ FFT(plan) FFT(_create_plan_radix2)(unsigned int _nfft,
 void FFT(_destroy_plan_radix2)(FFT(plan) _q)
 {
     // free data specific to radix-2 transforms
-    free(_q->data.radix2.index_rev);
-    free(_q->data.radix2.twiddle);
+    liquid_fft_cache_release(_q->data.radix2.index_rev);
+    liquid_fft_cache_release(_q->data.radix2.twiddle);
 
     // free main object memory
     free(_q);
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_radix4.avx.c : radix-4 Stockham FFT stages (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// multiply interleaved complex values: a*w
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 fft_cmul_avx2(__m256 _a, __m256 _w)
+{
+    __m256 wr = _mm256_moveldup_ps(_w);         // { wr, wr, ... }
+    __m256 wi = _mm256_movehdup_ps(_w);         // { wi, wi, ... }
+    __m256 as = _mm256_permute_ps(_a, 0xb1);    // { ai, ar, ... }
+    return _mm256_fmaddsub_ps(_a, wr, _mm256_mul_ps(as, wi));
+}
+
+// multiply interleaved complex values by j (_dir forward) or -j
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 fft_jmul_avx2(__m256 _a, __m256 _sign)
+{
+    return _mm256_xor_ps(_mm256_permute_ps(_a, 0xb1), _sign);
+}
+
+// sign mask for multiplication by +/- j
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 fft_jsign_avx2(int _dir)
+{
+    return (_dir == LIQUID_FFT_FORWARD) ?
+        _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f) :
+        _mm256_setr_ps( 0.0f,-0.0f,  0.0f,-0.0f,  0.0f,-0.0f,  0.0f,-0.0f);
+}
+
+// first radix-4 stage (stride 1), vectorized across butterflies
+__attribute__((target("avx2,fma")))
+void fft_radix4_stage1_avx2(unsigned int    _n,
+                            int             _dir,
+                            float complex * _x,
+                            float complex * _y,
+                            float complex * _twiddle4)
+{
+    __m256 sign = fft_jsign_avx2(_dir);
+    unsigned int n1 = _n / 4;
+    float * x  = (float*) _x;
+    float * y  = (float*) _y;
+    float * tw = (float*) _twiddle4;
+
+    unsigned int p;
+    for (p=0; p<n1; p+=4) {
+        __m256 a  = _mm256_loadu_ps(x + 2*(p     ));
+        __m256 b  = _mm256_loadu_ps(x + 2*(p+  n1));
+        __m256 c  = _mm256_loadu_ps(x + 2*(p+2*n1));
+        __m256 d  = _mm256_loadu_ps(x + 2*(p+3*n1));
+        __m256 w1 = _mm256_loadu_ps(tw + 6*p     );
+        __m256 w2 = _mm256_loadu_ps(tw + 6*p +  8);
+        __m256 w3 = _mm256_loadu_ps(tw + 6*p + 16);
+
+        __m256 apc  = _mm256_add_ps(a, c);
+        __m256 amc  = _mm256_sub_ps(a, c);
+        __m256 bpd  = _mm256_add_ps(b, d);
+        __m256 jbmd = fft_jmul_avx2(_mm256_sub_ps(b, d), sign);
+
+        __m256d y0 = _mm256_castps_pd(_mm256_add_ps(apc, bpd));
+        __m256d y1 = _mm256_castps_pd(fft_cmul_avx2(_mm256_sub_ps(amc, jbmd), w1));
+        __m256d y2 = _mm256_castps_pd(fft_cmul_avx2(_mm256_sub_ps(apc, bpd),  w2));
+        __m256d y3 = _mm256_castps_pd(fft_cmul_avx2(_mm256_add_ps(amc, jbmd), w3));
+
+        // transpose 4x4 block of complex values so that outputs of
+        // each butterfly are contiguous
+        __m256d t0 = _mm256_unpacklo_pd(y0, y1);
+        __m256d t1 = _mm256_unpackhi_pd(y0, y1);
+        __m256d t2 = _mm256_unpacklo_pd(y2, y3);
+        __m256d t3 = _mm256_unpackhi_pd(y2, y3);
+        _mm256_storeu_pd((double*)(y + 8*p     ), _mm256_permute2f128_pd(t0, t2, 0x20));
+        _mm256_storeu_pd((double*)(y + 8*p +  8), _mm256_permute2f128_pd(t1, t3, 0x20));
+        _mm256_storeu_pd((double*)(y + 8*p + 16), _mm256_permute2f128_pd(t0, t2, 0x31));
+        _mm256_storeu_pd((double*)(y + 8*p + 24), _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+}
+
+// radix-4 stage with twiddle stride _s and data stride _s*_b (multiple
+// of four), vectorized across stride
+__attribute__((target("avx2,fma")))
+void fft_radix4_stage_avx2(unsigned int    _n,
+                           unsigned int    _s,
+                           unsigned int    _b,
+                           int             _dir,
+                           float complex * _x,
+                           float complex * _y,
+                           float complex * _twiddle)
+{
+    __m256 sign = fft_jsign_avx2(_dir);
+    unsigned int n1 = _n / 4;
+    unsigned int sb = _s * _b;  // data stride
+
+    unsigned int p, q;
+    for (p=0; p<n1; p++) {
+        __m256 w1 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_twiddle[  p*_s]));
+        __m256 w2 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_twiddle[2*p*_s]));
+        __m256 w3 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)&_twiddle[3*p*_s]));
+
+        float * x = (float*)(_x + p*sb);
+        float * y = (float*)(_y + 4*p*sb);
+        for (q=0; q<2*sb; q+=8) {
+            __m256 a = _mm256_loadu_ps(x + q           );
+            __m256 b = _mm256_loadu_ps(x + q + 2*  n1*sb);
+            __m256 c = _mm256_loadu_ps(x + q + 4*  n1*sb);
+            __m256 d = _mm256_loadu_ps(x + q + 6*  n1*sb);
+
+            __m256 apc  = _mm256_add_ps(a, c);
+            __m256 amc  = _mm256_sub_ps(a, c);
+            __m256 bpd  = _mm256_add_ps(b, d);
+            __m256 jbmd = fft_jmul_avx2(_mm256_sub_ps(b, d), sign);
+
+            _mm256_storeu_ps(y + q       , _mm256_add_ps(apc, bpd));
+            _mm256_storeu_ps(y + q + 2*sb, fft_cmul_avx2(_mm256_sub_ps(amc, jbmd), w1));
+            _mm256_storeu_ps(y + q + 4*sb, fft_cmul_avx2(_mm256_sub_ps(apc, bpd),  w2));
+            _mm256_storeu_ps(y + q + 6*sb, fft_cmul_avx2(_mm256_add_ps(amc, jbmd), w3));
+        }
+    }
+}
+
+// final radix-2 stage with stride _s (multiple of four)
+__attribute__((target("avx2,fma")))
+void fft_radix2_stage_avx2(unsigned int    _s,
+                           float complex * _x,
+                           float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    unsigned int q;
+    for (q=0; q<2*_s; q+=8) {
+        __m256 a = _mm256_loadu_ps(x + q);
+        __m256 b = _mm256_loadu_ps(x + q + 2*_s);
+        _mm256_storeu_ps(y + q,        _mm256_add_ps(a, b));
+        _mm256_storeu_ps(y + q + 2*_s, _mm256_sub_ps(a, b));
+    }
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_radix4.c : definitions for transforms of the form 2^m using a
+//                self-sorting (Stockham) radix-4 algorithm
+//
+// Each stage reads one buffer and writes the other so that no
+// bit-reversal permutation is needed; when m is odd a final radix-2
+// stage completes the transform.  Stages are vectorized with SSE2 or
+// AVX2/FMA when available (selected at run time, see
+// fft_radix4.mmx.c and fft_radix4.avx.c).
+//
+// References:
+//  [Stockham:1966] T. G. Stockham, "High-speed convolution and
+//      correlation," Proc. AFIPS Spring Joint Computer Conference,
+//      vol. 28, pp. 229--233, 1966
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create FFT plan for radix-4 transform
+//  _nfft   :   FFT size (power of two)
+//  _x      :   input array [size: _nfft x 1]
+//  _y      :   output array [size: _nfft x 1]
+//  _dir    :   fft direction: {LIQUID_FFT_FORWARD, LIQUID_FFT_BACKWARD}
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_radix4)(unsigned int _nfft,
+                                   TC *         _x,
+                                   TC *         _y,
+                                   int          _dir,
+                                   int          _flags)
+{
+    // validate input
+    if (_nfft < 2 || !fft_is_radix2(_nfft)) {
+        fprintf(stderr,"error: fft_create_plan_radix4(), _nfft=%u is not a power of two\n", _nfft);
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->x         = _x;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->direction = (_dir == LIQUID_FFT_FORWARD) ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_RADIX4;
+
+    q->execute   = FFT(_execute_radix4);
+
+    q->data.radix4.m    = liquid_msb_index(q->nfft) - 1;  // m = log2(nfft)
+    q->data.radix4.buf  = (TC *) malloc(q->nfft * sizeof(TC));
+    q->data.radix4.simd = liquid_cpu_get_simd_level();
+
+    // initialize twiddle factors (shared)
+    q->data.radix4.twiddle = FFT(_cache_twiddle)(q->nfft, q->direction);
+
+    // first-stage twiddles packed in groups of four for SIMD
+    // kernels, viz. {w^p, ..., w^(p+3), w^2p, ..., w^3(p+3)}
+    q->data.radix4.twiddle4 = NULL;
+    if ( (q->nfft % 16) == 0 ) {
+        q->data.radix4.twiddle4 = (TC*) liquid_fft_cache_acquire(q->nfft, q->direction, LIQUID_FFT_CACHE_RADIX4);
+        if (q->data.radix4.twiddle4 == NULL) {
+            unsigned int n1 = q->nfft / 4;
+            TC * twiddle4 = (TC *) malloc(3 * n1 * sizeof(TC));
+            unsigned int p;
+            for (p=0; p<n1; p++) {
+                unsigned int i = 3*(p & ~3u) + (p & 3u);
+                twiddle4[i  ] = q->data.radix4.twiddle[  p];
+                twiddle4[i+4] = q->data.radix4.twiddle[2*p];
+                twiddle4[i+8] = q->data.radix4.twiddle[3*p];
+            }
+            q->data.radix4.twiddle4 = (TC*) liquid_fft_cache_insert(q->nfft, q->direction, LIQUID_FFT_CACHE_RADIX4, twiddle4);
+        }
+    }
+
+    return q;
+}
+
+// destroy FFT plan
+void FFT(_destroy_plan_radix4)(FFT(plan) _q)
+{
+    // release shared data
+    liquid_fft_cache_release(_q->data.radix4.twiddle);
+    if (_q->data.radix4.twiddle4 != NULL)
+        liquid_fft_cache_release(_q->data.radix4.twiddle4);
+
+    // free data specific to radix-4 transforms
+    free(_q->data.radix4.buf);
+
+    // free main object memory
+    free(_q);
+}
+
+// execute radix-4 FFT
+void FFT(_execute_radix4)(FFT(plan) _q)
+{
+    unsigned int m = _q->data.radix4.m;
+    unsigned int num_stages = m/2 + (m%2);
+    int dir = _q->direction;
+    TC * twiddle = _q->data.radix4.twiddle;
+#if LIQUID_CPU_X86
+    liquid_simd_level simd = _q->data.radix4.simd;
+#endif
+
+    // alternate stage outputs between internal buffer and output
+    // such that the final stage writes to output
+    TC * x = _q->x;
+    TC * y = (num_stages % 2) ? _q->y : _q->data.radix4.buf;
+    if (x == y) {
+        // in-place transform: first stage cannot write to its input
+        memmove(_q->data.radix4.buf, x, _q->nfft*sizeof(TC));
+        x = _q->data.radix4.buf;
+    }
+
+    unsigned int n = _q->nfft;  // sub-transform length
+    unsigned int s = 1;         // stride
+    unsigned int k;
+    for (k=0; k<num_stages; k++) {
+        if (n >= 4) {
+#if LIQUID_CPU_X86
+            if (s == 1 && _q->data.radix4.twiddle4 != NULL) {
+                if (simd >= LIQUID_SIMD_AVX2)
+                    fft_radix4_stage1_avx2(n, dir, x, y, _q->data.radix4.twiddle4);
+                else if (simd == LIQUID_SIMD_SSE)
+                    fft_radix4_stage1_sse(n, dir, x, y, _q->data.radix4.twiddle4);
+                else
+                    FFT(_radix4_stage)(n, s, 1, dir, x, y, twiddle);
+            } else if (s >= 4 && simd >= LIQUID_SIMD_AVX2) {
+                fft_radix4_stage_avx2(n, s, 1, dir, x, y, twiddle);
+            } else if (s >= 4 && simd == LIQUID_SIMD_SSE) {
+                fft_radix4_stage_sse(n, s, 1, dir, x, y, twiddle);
+            } else
+#endif
+            {
+                FFT(_radix4_stage)(n, s, 1, dir, x, y, twiddle);
+            }
+            n >>= 2;
+            s <<= 2;
+        } else {
+            // final radix-2 stage
+#if LIQUID_CPU_X86
+            if (s >= 4 && simd >= LIQUID_SIMD_AVX2)
+                fft_radix2_stage_avx2(s, x, y);
+            else if (s >= 2 && simd == LIQUID_SIMD_SSE)
+                fft_radix2_stage_sse(s, x, y);
+            else
+#endif
+                FFT(_radix2_stage)(s, x, y);
+        }
+
+        // swap buffers
+        x = y;
+        y = (y == _q->y) ? _q->data.radix4.buf : _q->y;
+    }
+
+    // single-point transform
+    if (num_stages == 0)
+        _q->y[0] = _q->x[0];
+}
+
+// radix-4 Stockham stage (portable)
+//  _n      :   sub-transform length
+//  _s      :   stride
+//  _b      :   number of interleaved transforms (data stride is _s*_b)
+//  _dir    :   fft direction
+//  _x      :   input buffer [size: _n*_s*_b x 1]
+//  _y      :   output buffer [size: _n*_s*_b x 1]
+//  _twiddle:   twiddle factors [size: _n*_s x 1]
+void FFT(_radix4_stage)(unsigned int _n,
+                        unsigned int _s,
+                        unsigned int _b,
+                        int          _dir,
+                        TC *         _x,
+                        TC *         _y,
+                        TC *         _twiddle)
+{
+    unsigned int n1 = _n / 4;
+    unsigned int sb = _s * _b;
+    unsigned int p, q;
+    for (p=0; p<n1; p++) {
+        TC w1 = _twiddle[  p*_s];
+        TC w2 = _twiddle[2*p*_s];
+        TC w3 = _twiddle[3*p*_s];
+
+        TC * x = _x + p*sb;
+        TC * y = _y + 4*p*sb;
+        for (q=0; q<sb; q++) {
+            TC a = x[q         ];
+            TC b = x[q +   n1*sb];
+            TC c = x[q + 2*n1*sb];
+            TC d = x[q + 3*n1*sb];
+
+            TC apc = a + c;
+            TC amc = a - c;
+            TC bpd = b + d;
+            TC bmd = b - d;
+
+            // multiply by j (forward) or -j (backward)
+            TC jbmd = (_dir == LIQUID_FFT_FORWARD) ?
+                -cimagf(bmd) + _Complex_I*crealf(bmd) :
+                 cimagf(bmd) - _Complex_I*crealf(bmd);
+
+            y[q       ] =      apc + bpd;
+            y[q +   sb] = w1*(amc - jbmd);
+            y[q + 2*sb] = w2*(apc - bpd);
+            y[q + 3*sb] = w3*(amc + jbmd);
+        }
+    }
+}
+
+// radix-2 Stockham stage (portable), final stage only
+//  _s      :   stride
+//  _x      :   input buffer [size: 2*_s x 1]
+//  _y      :   output buffer [size: 2*_s x 1]
+void FFT(_radix2_stage)(unsigned int _s,
+                        TC *         _x,
+                        TC *         _y)
+{
+    unsigned int q;
+    for (q=0; q<_s; q++) {
+        TC a = _x[q];
+        TC b = _x[q+_s];
+        _y[q   ] = a + b;
+        _y[q+_s] = a - b;
+    }
+}
+
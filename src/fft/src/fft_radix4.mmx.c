@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_radix4.mmx.c : radix-4 Stockham FFT stages (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// multiply interleaved complex values: a*w
+__attribute__((target("sse2"), always_inline))
+static inline __m128 fft_cmul_sse(__m128 _a, __m128 _w)
+{
+    const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    __m128 wr = _mm_shuffle_ps(_w, _w, _MM_SHUFFLE(2,2,0,0));   // { wr, wr, ... }
+    __m128 wi = _mm_shuffle_ps(_w, _w, _MM_SHUFFLE(3,3,1,1));   // { wi, wi, ... }
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));   // { ai, ar, ... }
+    return _mm_add_ps(_mm_mul_ps(_a, wr), _mm_xor_ps(_mm_mul_ps(as, wi), sign));
+}
+
+// multiply interleaved complex values by j (_dir forward) or -j
+__attribute__((target("sse2"), always_inline))
+static inline __m128 fft_jmul_sse(__m128 _a, __m128 _sign)
+{
+    return _mm_xor_ps(_mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1)), _sign);
+}
+
+// sign mask for multiplication by +/- j
+__attribute__((target("sse2"), always_inline))
+static inline __m128 fft_jsign_sse(int _dir)
+{
+    return (_dir == LIQUID_FFT_FORWARD) ?
+        _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f) :
+        _mm_setr_ps( 0.0f,-0.0f,  0.0f,-0.0f);
+}
+
+// first radix-4 stage (stride 1), vectorized across butterflies
+__attribute__((target("sse2")))
+void fft_radix4_stage1_sse(unsigned int    _n,
+                           int             _dir,
+                           float complex * _x,
+                           float complex * _y,
+                           float complex * _twiddle4)
+{
+    __m128 sign = fft_jsign_sse(_dir);
+    unsigned int n1 = _n / 4;
+    float * x  = (float*) _x;
+    float * y  = (float*) _y;
+    float * tw = (float*) _twiddle4;
+
+    unsigned int p;
+    for (p=0; p<n1; p+=2) {
+        // twiddles are packed in groups of four butterflies
+        unsigned int i = 3*(p & ~3u) + (p & 3u);
+
+        __m128 a  = _mm_loadu_ps(x + 2*(p     ));
+        __m128 b  = _mm_loadu_ps(x + 2*(p+  n1));
+        __m128 c  = _mm_loadu_ps(x + 2*(p+2*n1));
+        __m128 d  = _mm_loadu_ps(x + 2*(p+3*n1));
+        __m128 w1 = _mm_loadu_ps(tw + 2*(i    ));
+        __m128 w2 = _mm_loadu_ps(tw + 2*(i + 4));
+        __m128 w3 = _mm_loadu_ps(tw + 2*(i + 8));
+
+        __m128 apc  = _mm_add_ps(a, c);
+        __m128 amc  = _mm_sub_ps(a, c);
+        __m128 bpd  = _mm_add_ps(b, d);
+        __m128 jbmd = fft_jmul_sse(_mm_sub_ps(b, d), sign);
+
+        __m128 y0 = _mm_add_ps(apc, bpd);
+        __m128 y1 = fft_cmul_sse(_mm_sub_ps(amc, jbmd), w1);
+        __m128 y2 = fft_cmul_sse(_mm_sub_ps(apc, bpd),  w2);
+        __m128 y3 = fft_cmul_sse(_mm_add_ps(amc, jbmd), w3);
+
+        // transpose so that outputs of each butterfly are contiguous
+        _mm_storeu_ps(y + 8*p     , _mm_movelh_ps(y0, y1));
+        _mm_storeu_ps(y + 8*p +  4, _mm_movelh_ps(y2, y3));
+        _mm_storeu_ps(y + 8*p +  8, _mm_movehl_ps(y1, y0));
+        _mm_storeu_ps(y + 8*p + 12, _mm_movehl_ps(y3, y2));
+    }
+}
+
+// radix-4 stage with twiddle stride _s and data stride _s*_b (multiple
+// of two), vectorized across stride
+__attribute__((target("sse2")))
+void fft_radix4_stage_sse(unsigned int    _n,
+                          unsigned int    _s,
+                          unsigned int    _b,
+                          int             _dir,
+                          float complex * _x,
+                          float complex * _y,
+                          float complex * _twiddle)
+{
+    __m128 sign = fft_jsign_sse(_dir);
+    unsigned int n1 = _n / 4;
+    unsigned int sb = _s * _b;  // data stride
+
+    unsigned int p, q;
+    for (p=0; p<n1; p++) {
+        __m128 w1 = _mm_castpd_ps(_mm_load1_pd((double*)&_twiddle[  p*_s]));
+        __m128 w2 = _mm_castpd_ps(_mm_load1_pd((double*)&_twiddle[2*p*_s]));
+        __m128 w3 = _mm_castpd_ps(_mm_load1_pd((double*)&_twiddle[3*p*_s]));
+
+        float * x = (float*)(_x + p*sb);
+        float * y = (float*)(_y + 4*p*sb);
+        for (q=0; q<2*sb; q+=4) {
+            __m128 a = _mm_loadu_ps(x + q           );
+            __m128 b = _mm_loadu_ps(x + q + 2*  n1*sb);
+            __m128 c = _mm_loadu_ps(x + q + 4*  n1*sb);
+            __m128 d = _mm_loadu_ps(x + q + 6*  n1*sb);
+
+            __m128 apc  = _mm_add_ps(a, c);
+            __m128 amc  = _mm_sub_ps(a, c);
+            __m128 bpd  = _mm_add_ps(b, d);
+            __m128 jbmd = fft_jmul_sse(_mm_sub_ps(b, d), sign);
+
+            _mm_storeu_ps(y + q       , _mm_add_ps(apc, bpd));
+            _mm_storeu_ps(y + q + 2*sb, fft_cmul_sse(_mm_sub_ps(amc, jbmd), w1));
+            _mm_storeu_ps(y + q + 4*sb, fft_cmul_sse(_mm_sub_ps(apc, bpd),  w2));
+            _mm_storeu_ps(y + q + 6*sb, fft_cmul_sse(_mm_add_ps(amc, jbmd), w3));
+        }
+    }
+}
+
+// final radix-2 stage with stride _s (multiple of two)
+__attribute__((target("sse2")))
+void fft_radix2_stage_sse(unsigned int    _s,
+                          float complex * _x,
+                          float complex * _y)
+{
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    unsigned int q;
+    for (q=0; q<2*_s; q+=4) {
+        __m128 a = _mm_loadu_ps(x + q);
+        __m128 b = _mm_loadu_ps(x + q + 2*_s);
+        _mm_storeu_ps(y + q,        _mm_add_ps(a, b));
+        _mm_storeu_ps(y + q + 2*_s, _mm_sub_ps(a, b));
+    }
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_real.avx.c : real-to-complex/complex-to-real transform spectrum
+//                  split/merge (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// multiply interleaved complex values: a*w
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 fft_real_cmul_avx2(__m256 _a, __m256 _w)
+{
+    __m256 wr = _mm256_moveldup_ps(_w);         // { wr, wr, ... }
+    __m256 wi = _mm256_movehdup_ps(_w);         // { wi, wi, ... }
+    __m256 as = _mm256_permute_ps(_a, 0xb1);    // { ai, ar, ... }
+    return _mm256_fmaddsub_ps(_a, wr, _mm256_mul_ps(as, wi));
+}
+
+// load four complex values _x[_i-3], ..., _x[_i] in reverse order and
+// conjugate
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 fft_real_load_rconj_avx2(float complex * _x,
+                                              unsigned int    _i)
+{
+    const __m256 conj = _mm256_setr_ps(0.0f,-0.0f, 0.0f,-0.0f, 0.0f,-0.0f, 0.0f,-0.0f);
+    __m256 v = _mm256_loadu_ps((float*)(_x + _i - 3));
+    v = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(v), _MM_SHUFFLE(0,1,2,3)));
+    return _mm256_xor_ps(v, conj);
+}
+
+// separate spectra of even/odd samples (r2c), bins [1,k) for the
+// returned k, four bins at a time
+__attribute__((target("avx2,fma")))
+unsigned int fft_real_split_avx2(unsigned int    _m,
+                                 float complex * _Z,
+                                 float complex * _twiddle,
+                                 float complex * _y)
+{
+    const __m256 half = _mm256_set1_ps(0.5f);
+    const __m256 conj = _mm256_setr_ps(0.0f,-0.0f, 0.0f,-0.0f, 0.0f,-0.0f, 0.0f,-0.0f);
+
+    unsigned int k;
+    for (k=1; k+4 <= _m; k+=4) {
+        __m256 a = _mm256_loadu_ps((float*)(_Z + k));
+        __m256 b = fft_real_load_rconj_avx2(_Z, _m-k);
+        __m256 w = _mm256_loadu_ps((float*)(_twiddle + k));
+
+        // E = (a + b)/2, O = (a - b)/2j = -j*(a - b)/2
+        __m256 e = _mm256_mul_ps(half, _mm256_add_ps(a, b));
+        __m256 d = _mm256_mul_ps(half, _mm256_sub_ps(a, b));
+        __m256 o = _mm256_xor_ps(_mm256_permute_ps(d, 0xb1), conj);
+
+        _mm256_storeu_ps((float*)(_y + k), _mm256_add_ps(e, fft_real_cmul_avx2(o, w)));
+    }
+    return k;
+}
+
+// merge Hermitian spectrum into spectrum of packed even/odd samples
+// (c2r), bins [1,k) for the returned k, four bins at a time
+__attribute__((target("avx2,fma")))
+unsigned int fft_real_merge_avx2(unsigned int    _m,
+                                 float complex * _x,
+                                 float complex * _twiddle,
+                                 float complex * _Z)
+{
+    unsigned int k;
+    for (k=1; k+4 <= _m; k+=4) {
+        __m256 a = _mm256_loadu_ps((float*)(_x + k));
+        __m256 b = fft_real_load_rconj_avx2(_x, _m-k);
+        __m256 w = _mm256_loadu_ps((float*)(_twiddle + k));
+
+        // Z = (a + b) + j*conj(w)*(a - b), j*conj(w) = wi + j*wr
+        __m256 jw = _mm256_permute_ps(w, 0xb1);
+        __m256 p  = fft_real_cmul_avx2(_mm256_sub_ps(a, b), jw);
+
+        _mm256_storeu_ps((float*)(_Z + k), _mm256_add_ps(_mm256_add_ps(a, b), p));
+    }
+    return k;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_real.c : real-to-complex (r2c) and complex-to-real (c2r)
+//              one-dimensional transforms
+//
+// Transforms of even length n pack the real sequence into a complex
+// sequence of length n/2, compute a half-size complex transform, and
+// separate the even/odd spectra with a single pass of twiddle
+// factors.  Transforms of odd length fall back to a full-size complex
+// transform.  The split/merge pass is vectorized with SSE2 or AVX2/FMA
+// when available (selected at run time, see fft_real.mmx.c and
+// fft_real.avx.c).  Only the non-redundant half of the spectrum, bins
+// [0,n/2], is read/written; the inverse (c2r) is not normalized, i.e.
+// c2r(r2c(x)) = n*x.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "liquid.internal.h"
+
+// create real-to-complex transform plan
+//  _nfft   :   FFT size
+//  _x      :   input array (real) [size: _nfft x 1]
+//  _y      :   output array (complex) [size: _nfft/2+1 x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_r2c)(unsigned int _nfft,
+                                T *          _x,
+                                TC *         _y,
+                                int          _flags)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: fft_create_plan_r2c(), fft size must be > 0\n");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->xr        = _x;
+    q->yr        = NULL;
+    q->x         = NULL;
+    q->y         = _y;
+    q->flags     = _flags;
+    q->type      = LIQUID_FFT_R2C;
+    q->direction = LIQUID_FFT_FORWARD;
+    q->method    = LIQUID_FFT_METHOD_UNKNOWN;
+    q->execute   = FFT(_execute_r2c);
+
+    FFT(_create_plan_real)(q);
+    return q;
+}
+
+// create complex-to-real transform plan
+//  _nfft   :   FFT size
+//  _x      :   input array (complex) [size: _nfft/2+1 x 1]
+//  _y      :   output array (real) [size: _nfft x 1]
+//  _flags  :   fft flags
+FFT(plan) FFT(_create_plan_c2r)(unsigned int _nfft,
+                                TC *         _x,
+                                T *          _y,
+                                int          _flags)
+{
+    // validate input
+    if (_nfft == 0) {
+        fprintf(stderr,"error: fft_create_plan_c2r(), fft size must be > 0\n");
+        exit(1);
+    }
+
+    // allocate plan and initialize all internal arrays to NULL
+    FFT(plan) q = (FFT(plan)) malloc(sizeof(struct FFT(plan_s)));
+
+    q->nfft      = _nfft;
+    q->xr        = NULL;
+    q->yr        = _y;
+    q->x         = _x;
+    q->y         = NULL;
+    q->flags     = _flags;
+    q->type      = LIQUID_FFT_C2R;
+    q->direction = LIQUID_FFT_BACKWARD;
+    q->method    = LIQUID_FFT_METHOD_UNKNOWN;
+    q->execute   = FFT(_execute_c2r);
+
+    FFT(_create_plan_real)(q);
+    return q;
+}
+
+// initialize internal buffers and complex transform for real plans
+void FFT(_create_plan_real)(FFT(plan) _q)
+{
+    // internal complex transform is half size for even lengths
+    unsigned int n = (_q->nfft % 2) ? _q->nfft : _q->nfft / 2;
+    _q->data.real.z   = (TC *) malloc(n * sizeof(TC));
+    _q->data.real.Z   = (TC *) malloc(n * sizeof(TC));
+    _q->data.real.fft = (_q->type == LIQUID_FFT_R2C) ?
+        FFT(_create_plan)(n, _q->data.real.z, _q->data.real.Z, LIQUID_FFT_FORWARD,  _q->flags) :
+        FFT(_create_plan)(n, _q->data.real.Z, _q->data.real.z, LIQUID_FFT_BACKWARD, _q->flags);
+
+    // twiddle factors exp(-j*2*pi*k/nfft) (shared)
+    _q->data.real.twiddle = (_q->nfft % 2) ? NULL :
+        FFT(_cache_twiddle)(_q->nfft, LIQUID_FFT_FORWARD);
+
+    _q->data.real.simd = liquid_cpu_get_simd_level();
+}
+
+// destroy real-to-complex/complex-to-real transform plan
+void FFT(_destroy_plan_real)(FFT(plan) _q)
+{
+    // release shared data
+    if (_q->data.real.twiddle != NULL)
+        liquid_fft_cache_release(_q->data.real.twiddle);
+
+    // destroy internal transform and free buffers
+    FFT(_destroy_plan)(_q->data.real.fft);
+    free(_q->data.real.z);
+    free(_q->data.real.Z);
+
+    // free main object memory
+    free(_q);
+}
+
+// execute real-to-complex transform
+void FFT(_execute_r2c)(FFT(plan) _q)
+{
+    unsigned int i;
+    TC * z = _q->data.real.z;
+    TC * Z = _q->data.real.Z;
+
+    if (_q->nfft % 2) {
+        // odd length: full complex transform
+        for (i=0; i<_q->nfft; i++)
+            z[i] = _q->xr[i];
+        FFT(_execute)(_q->data.real.fft);
+        memmove(_q->y, Z, (_q->nfft/2+1)*sizeof(TC));
+        return;
+    }
+
+    // pack even/odd samples into real/imaginary components (identical
+    // memory layout) and run half-size complex transform:
+    // Z[k] = E[k] + j*O[k]
+    unsigned int m = _q->nfft / 2;
+    memmove(z, _q->xr, _q->nfft*sizeof(T));
+    FFT(_execute)(_q->data.real.fft);
+
+    // separate spectra of even and odd samples and combine:
+    //  Y[k] = E[k] + exp(-j*2*pi*k/nfft)*O[k]
+    // with E[k] = (Z[k] + conj(Z[m-k]))/2, O[k] = (Z[k] - conj(Z[m-k]))/2j;
+    // written out in real arithmetic so the loop vectorizes
+    TC * twiddle = _q->data.real.twiddle;
+    T z0r = crealf(Z[0]);
+    T z0i = cimagf(Z[0]);
+    i = 1;
+#if LIQUID_CPU_X86
+    if (_q->data.real.simd >= LIQUID_SIMD_AVX2)
+        i = fft_real_split_avx2(m, Z, twiddle, _q->y);
+    else if (_q->data.real.simd == LIQUID_SIMD_SSE)
+        i = fft_real_split_sse(m, Z, twiddle, _q->y);
+#endif
+    for ( ; i<m; i++) {
+        T ar =  crealf(Z[i]),   ai = cimagf(Z[i]);
+        T br =  crealf(Z[m-i]), bi = cimagf(Z[m-i]);
+        T er = 0.5f*(ar + br),  ei = 0.5f*(ai - bi);
+        T or = 0.5f*(ai + bi),  oi = 0.5f*(br - ar);
+        T wr = crealf(twiddle[i]), wi = cimagf(twiddle[i]);
+        _q->y[i] = (er + wr*or - wi*oi) + _Complex_I*(ei + wr*oi + wi*or);
+    }
+    _q->y[0] = z0r + z0i;
+    _q->y[m] = z0r - z0i;
+}
+
+// execute complex-to-real transform
+void FFT(_execute_c2r)(FFT(plan) _q)
+{
+    unsigned int i;
+    TC * z = _q->data.real.z;
+    TC * Z = _q->data.real.Z;
+
+    if (_q->nfft % 2) {
+        // odd length: extend Hermitian-symmetric spectrum and run full
+        // complex transform
+        Z[0] = crealf(_q->x[0]);
+        for (i=1; i<=_q->nfft/2; i++) {
+            Z[i]            = _q->x[i];
+            Z[_q->nfft - i] = conjf(_q->x[i]);
+        }
+        FFT(_execute)(_q->data.real.fft);
+        for (i=0; i<_q->nfft; i++)
+            _q->yr[i] = crealf(z[i]);
+        return;
+    }
+
+    // recombine into spectrum of packed even/odd samples:
+    //  Z[k] = 2*(E[k] + j*O[k])
+    unsigned int m = _q->nfft / 2;
+    TC * twiddle = _q->data.real.twiddle;
+    T x0 = crealf(_q->x[0]);
+    T xm = crealf(_q->x[m]);
+    Z[0] = (x0 + xm) + _Complex_I*(x0 - xm);
+    i = 1;
+#if LIQUID_CPU_X86
+    if (_q->data.real.simd >= LIQUID_SIMD_AVX2)
+        i = fft_real_merge_avx2(m, _q->x, twiddle, Z);
+    else if (_q->data.real.simd == LIQUID_SIMD_SSE)
+        i = fft_real_merge_sse(m, _q->x, twiddle, Z);
+#endif
+    for ( ; i<m; i++) {
+        // Z[k] = (a + b) + j*conj(w)*(a - b), a = X[k], b = conj(X[m-k])
+        T ar = crealf(_q->x[i]),   ai =  cimagf(_q->x[i]);
+        T br = crealf(_q->x[m-i]), bi = -cimagf(_q->x[m-i]);
+        T dr = ar - br,            di = ai - bi;
+        T wr = crealf(twiddle[i]), wi = cimagf(twiddle[i]);
+        // j*conj(w) = wi + j*wr
+        Z[i] = (ar + br + wi*dr - wr*di) + _Complex_I*(ai + bi + wr*dr + wi*di);
+    }
+
+    // run half-size inverse transform and unpack even/odd samples
+    // from real/imaginary components (identical memory layout)
+    FFT(_execute)(_q->data.real.fft);
+    memmove(_q->yr, z, _q->nfft*sizeof(T));
+}
+
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_real.mmx.c : real-to-complex/complex-to-real transform spectrum
+//                  split/merge (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// multiply interleaved complex values: a*w
+__attribute__((target("sse2"), always_inline))
+static inline __m128 fft_real_cmul_sse(__m128 _a, __m128 _w)
+{
+    const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    __m128 wr = _mm_shuffle_ps(_w, _w, _MM_SHUFFLE(2,2,0,0));   // { wr, wr, ... }
+    __m128 wi = _mm_shuffle_ps(_w, _w, _MM_SHUFFLE(3,3,1,1));   // { wi, wi, ... }
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));   // { ai, ar, ... }
+    return _mm_add_ps(_mm_mul_ps(_a, wr), _mm_xor_ps(_mm_mul_ps(as, wi), sign));
+}
+
+// load two complex values _x[_i-1], _x[_i] in reverse order and
+// conjugate
+__attribute__((target("sse2"), always_inline))
+static inline __m128 fft_real_load_rconj_sse(float complex * _x,
+                                             unsigned int    _i)
+{
+    const __m128 conj = _mm_setr_ps(0.0f,-0.0f, 0.0f,-0.0f);
+    __m128 v = _mm_loadu_ps((float*)(_x + _i - 1));
+    return _mm_xor_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1,0,3,2)), conj);
+}
+
+// separate spectra of even/odd samples (r2c), bins [1,k) for the
+// returned k, two bins at a time
+__attribute__((target("sse2")))
+unsigned int fft_real_split_sse(unsigned int    _m,
+                                float complex * _Z,
+                                float complex * _twiddle,
+                                float complex * _y)
+{
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 conj = _mm_setr_ps(0.0f,-0.0f, 0.0f,-0.0f);
+
+    unsigned int k;
+    for (k=1; k+2 <= _m; k+=2) {
+        __m128 a = _mm_loadu_ps((float*)(_Z + k));
+        __m128 b = fft_real_load_rconj_sse(_Z, _m-k);
+        __m128 w = _mm_loadu_ps((float*)(_twiddle + k));
+
+        // E = (a + b)/2, O = (a - b)/2j = -j*(a - b)/2
+        __m128 e = _mm_mul_ps(half, _mm_add_ps(a, b));
+        __m128 d = _mm_mul_ps(half, _mm_sub_ps(a, b));
+        __m128 o = _mm_xor_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2,3,0,1)), conj);
+
+        _mm_storeu_ps((float*)(_y + k), _mm_add_ps(e, fft_real_cmul_sse(o, w)));
+    }
+    return k;
+}
+
+// merge Hermitian spectrum into spectrum of packed even/odd samples
+// (c2r), bins [1,k) for the returned k, two bins at a time
+__attribute__((target("sse2")))
+unsigned int fft_real_merge_sse(unsigned int    _m,
+                                float complex * _x,
+                                float complex * _twiddle,
+                                float complex * _Z)
+{
+    unsigned int k;
+    for (k=1; k+2 <= _m; k+=2) {
+        __m128 a = _mm_loadu_ps((float*)(_x + k));
+        __m128 b = fft_real_load_rconj_sse(_x, _m-k);
+        __m128 w = _mm_loadu_ps((float*)(_twiddle + k));
+
+        // Z = (a + b) + j*conj(w)*(a - b), j*conj(w) = wi + j*wr
+        __m128 jw = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2,3,0,1));
+        __m128 p  = fft_real_cmul_sse(_mm_sub_ps(a, b), jw);
+
+        _mm_storeu_ps((float*)(_Z + k), _mm_add_ps(_mm_add_ps(a, b), p));
+    }
+    return k;
+}
+
+#endif // LIQUID_CPU_X86
+
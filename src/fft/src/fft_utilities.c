@@ -36,19 +36,14 @@ liquid_fft_method liquid_fft_estimate_method(unsigned int _nfft)
         fprintf(stderr,"error: liquid_fft_estimate_method(), fft size must be > 0\n");
         return LIQUID_FFT_METHOD_UNKNOWN;
 
-    } else if (_nfft <= 8 || _nfft==11 || _nfft==13 || _nfft==16 || _nfft==17) {
+    } else if (_nfft <= 8 || _nfft==11 || _nfft==13 || _nfft==17) {
         // use simple DFT
         return LIQUID_FFT_METHOD_DFT;
 
     } else if (fft_is_radix2(_nfft)) {
-        // transform is of the form 2^m
-#if 0
-        // use radix-2 algorithm
-        return LIQUID_FFT_METHOD_RADIX2;
-#else
-        // acutally, prefer Cooley-Tukey algorithm
-        return LIQUID_FFT_METHOD_MIXED_RADIX;
-#endif
+        // transform is of the form 2^m: use self-sorting radix-4
+        // algorithm (vectorized where possible)
+        return LIQUID_FFT_METHOD_RADIX4;
 
     } else if (liquid_is_prime(_nfft)) {
         // prefer Rader's alternate method (using radix-2 transform)
@@ -40,8 +40,22 @@ struct spgram_s {
     float complex * X;          // output fft (allocated)
     float *         w;          // tapering window [size: window_len x 1]
     FFT_PLAN fft;               // fft plan
+
+    // batched transforms for spgram_estimate_psd(), interleaved in
+    // memory: sample i of transform k is stored at [i*batch_size + k]
+    unsigned int    batch_size; // number of transforms per batch
+    float complex * xb;         // batch input  [size: nfft*batch_size x 1]
+    float complex * Xb;         // batch output [size: nfft*batch_size x 1]
+    FFT_PLAN        fft_batch;  // batch fft plan
 };
 
+// maximum number of transforms and samples per spgram_estimate_psd()
+// batch; interleaved batches are only faster than individual
+// transforms when they fit in the L1 cache and fill a SIMD register
+#define SPGRAM_BATCH_MAX        (16)
+#define SPGRAM_BATCH_MIN        (4)
+#define SPGRAM_BATCH_SAMPLES    (2048)
+
 // create spgram object
 //  _nfft       :   FFT size
 //  _window_len :   window length
@@ -73,6 +87,17 @@ spgram spgram_create(unsigned int _nfft,
     q->X = (float complex*) malloc((q->nfft)*sizeof(float complex));
     q->fft = FFT_CREATE_PLAN(q->nfft, q->x, q->X, FFT_DIR_FORWARD, FFT_METHOD);
 
+    // create batch FFT arrays, object
+    q->batch_size = SPGRAM_BATCH_SAMPLES / q->nfft;
+    if (q->batch_size > SPGRAM_BATCH_MAX) q->batch_size = SPGRAM_BATCH_MAX;
+    if (q->batch_size < SPGRAM_BATCH_MIN) q->batch_size = 1;
+    q->xb = (float complex*) malloc((q->nfft*q->batch_size)*sizeof(float complex));
+    q->Xb = (float complex*) malloc((q->nfft*q->batch_size)*sizeof(float complex));
+    q->fft_batch = FFT_CREATE_PLAN_MANY(q->nfft, q->batch_size,
+                                        q->xb, q->batch_size, 1,
+                                        q->Xb, q->batch_size, 1,
+                                        FFT_DIR_FORWARD, FFT_METHOD);
+
     // create buffer
     q->buffer = windowcf_create(q->window_len);
 
@@ -144,6 +169,9 @@ void spgram_destroy(spgram _q)
     free(_q->w);
     windowcf_destroy(_q->buffer);
     FFT_DESTROY_PLAN(_q->fft);
+    free(_q->xb);
+    free(_q->Xb);
+    FFT_DESTROY_PLAN(_q->fft_batch);
 
     // free main object
     free(_q);
@@ -222,28 +250,68 @@ void spgram_estimate_psd(spgram                 _q,
     if (_n == 0)
         return;
 
-    // keep track of how many transforms have been taken
-    unsigned int num_transforms = 0;
+    // Transforms are taken periodically (every 'delay' samples and
+    // after the last sample) over the most recent 'window_len'
+    // samples.  Rather than pushing one sample at a time, prepend the
+    // current buffer contents to the input so that every transform
+    // window is a contiguous segment, and compute transforms in
+    // batches.
+    unsigned int wlen = _q->window_len;
+    float complex * rc;
+    windowcf_read(_q->buffer, &rc);
+    float complex * xe = (float complex*) malloc((wlen + _n)*sizeof(float complex));
+    memmove(xe,       rc, wlen*sizeof(float complex));
+    memmove(xe+wlen,  _x, _n  *sizeof(float complex));
+
+    // number of transforms: one after every 'delay' samples, and one
+    // after the last sample if not already taken
+    unsigned int num_transforms = _n / delay + ((_n % delay) ? 1 : 0);
+
+    // clear zero-padded portion of batch input
+    unsigned int b = _q->batch_size;
+    for (i=wlen*b; i<_q->nfft*b; i++)
+        _q->xb[i] = 0.0f;
+
+    unsigned int t = 0; // transform index
+    while (t < num_transforms) {
+        // number of transforms in this batch
+        unsigned int nb = num_transforms - t;
+        if (nb > _q->batch_size)
+            nb = _q->batch_size;
+
+        // fill batch input, applying window; transform t ends with
+        // input sample min((t+1)*delay, _n)-1, i.e. window starts at
+        // index min((t+1)*delay, _n) in extended input
+        for (k=0; k<nb; k++) {
+            unsigned int n0 = (t+k+1)*delay;
+            if (n0 > _n) n0 = _n;
+            float complex * r = xe + n0;
+            for (i=0; i<wlen; i++)
+                _q->xb[i*b + k] = r[i] * _q->w[i];
+        }
 
-    // temporary array for output
-    float complex * X = (float complex*) malloc(_q->nfft * sizeof(float complex));
+        if (nb == b) {
+            // execute batch fft
+            FFT_EXECUTE(_q->fft_batch);
+        } else {
+            // execute remaining transforms individually
+            for (k=0; k<nb; k++) {
+                for (i=0; i<wlen; i++)
+                    _q->x[i] = _q->xb[i*b + k];
+                FFT_EXECUTE(_q->fft);
+                for (i=0; i<_q->nfft; i++)
+                    _q->Xb[i*b + k] = _q->X[i];
+            }
+        }
 
-    //
-    for (i=0; i<_n; i++) {
-        // push signal into periodogram object one sample
-        // at a time
-        spgram_push(_q, &_x[i], 1);
-
-        // take transform periodically, ensuring all samples
-        // are taken into account
-        if ( ((i+1)%delay)==0 || (i==_n-1)) {
-            spgram_execute(_q, X);
-            for (k=0; k<_q->nfft; k++)
-                _psd[k] += crealf(X[k] * conjf(X[k]));
-
-            //
-            num_transforms++;
+        // accumulate power spectral density
+        for (i=0; i<_q->nfft; i++) {
+            float complex * X = _q->Xb + i*b;
+            for (k=0; k<nb; k++)
+                _psd[i] += crealf(X[k] * conjf(X[k]));
         }
+
+        t += nb;
     }
 
     // at least one transform should have been taken
@@ -253,7 +321,9 @@ void spgram_estimate_psd(spgram                 _q,
     for (i=0; i<_q->nfft; i++)
         _psd[i] /= (float)(num_transforms);
 
+    // push samples into buffer to retain state
+    windowcf_write(_q->buffer, _x, _n);
+
     // free allocated memory
-    free(X);
+    free(xe);
 }
-
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_many_autotest.c : test batches of transforms
+//
+
+#include <string.h>
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// helper function: compare batch of transforms against individual plans
+//  _nfft       :   fft size
+//  _howmany    :   number of transforms
+//  _interleave :   interleave transforms (stride _howmany, distance 1)
+//                  rather than storing them contiguously?
+//  _inplace    :   run transform in place?
+void fft_many_test(unsigned int _nfft,
+                   unsigned int _howmany,
+                   int          _interleave,
+                   int          _inplace)
+{
+    float tol = 1e-5f * _nfft;
+    unsigned int num_samples = _nfft * _howmany;
+    unsigned int stride = _interleave ? _howmany : 1;
+    unsigned int dist   = _interleave ? 1 : _nfft;
+
+    float complex x[num_samples];
+    float complex y[num_samples];
+    float complex y_test[num_samples];
+    float complex buf_x[_nfft];
+    float complex buf_y[_nfft];
+    unsigned int i, k;
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // compute reference one transform at a time
+    fftplan q = fft_create_plan(_nfft, buf_x, buf_y, LIQUID_FFT_FORWARD, 0);
+    for (k=0; k<_howmany; k++) {
+        for (i=0; i<_nfft; i++)
+            buf_x[i] = x[k*dist + i*stride];
+        fft_execute(q);
+        for (i=0; i<_nfft; i++)
+            y_test[k*dist + i*stride] = buf_y[i];
+    }
+    fft_destroy_plan(q);
+
+    // compute batch
+    float complex * yb = y;
+    if (_inplace) {
+        memmove(y, x, num_samples*sizeof(float complex));
+        q = fft_create_plan_many(_nfft, _howmany, y, stride, dist, y, stride, dist, LIQUID_FFT_FORWARD, 0);
+    } else {
+        q = fft_create_plan_many(_nfft, _howmany, x, stride, dist, y, stride, dist, LIQUID_FFT_FORWARD, 0);
+    }
+    fft_execute(q);
+    fft_destroy_plan(q);
+
+    for (i=0; i<num_samples; i++)
+        CONTEND_DELTA( cabsf(yb[i] - y_test[i]), 0, tol );
+}
+
+// power-of-two (interleaved SIMD), composite and prime sizes
+void autotest_fft_many_contiguous()
+{
+    unsigned int n;
+    for (n=1; n<=9; n++) {
+        fft_many_test(  64, n, 0, 0);
+        fft_many_test( 128, n, 0, 0);
+        fft_many_test(  30, n, 0, 0);
+        fft_many_test(  17, n, 0, 0);
+    }
+}
+
+// transforms interleaved in input/output arrays
+void autotest_fft_many_strided()
+{
+    unsigned int n;
+    for (n=1; n<=9; n++) {
+        fft_many_test(  64, n, 1, 0);
+        fft_many_test(  30, n, 1, 0);
+    }
+}
+
+// in-place batch
+void autotest_fft_many_inplace()
+{
+    unsigned int n;
+    for (n=1; n<=9; n++) {
+        fft_many_test(  32, n, 0, 1);
+        fft_many_test(  32, n, 1, 1);
+        fft_many_test(  30, n, 0, 1);
+    }
+}
+
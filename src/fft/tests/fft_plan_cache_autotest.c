@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_plan_cache_autotest.c : test fft plan cache and measured wisdom
+//
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// autotest data definitions
+#include "src/fft/tests/fft_runtest.h"
+
+// helper function: create plan with given flags, validate output
+// against expected result, and return method used
+//  _x      :   fft input array
+//  _test   :   expected fft output
+//  _n      :   fft size
+//  _flags  :   fft plan flags
+liquid_fft_method fft_plan_cache_test(float complex * _x,
+                                      float complex * _test,
+                                      unsigned int    _n,
+                                      int             _flags)
+{
+    float tol = 2e-4f;
+    float complex y[_n];
+
+    fftplan q = fft_create_plan(_n, _x, y, LIQUID_FFT_FORWARD, _flags);
+    fft_execute(q);
+    liquid_fft_method method = fft_get_method(q);
+    fft_destroy_plan(q);
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        CONTEND_DELTA( cabsf(y[i] - _test[i]), 0, tol);
+
+    return method;
+}
+
+// plans of the same size re-use cached data rather than adding entries,
+// and unused entries are freed only when the cache is cleared
+void autotest_fft_plan_cache()
+{
+    unsigned int sizes[4] = {30, 64, 157, 317};
+    float complex * x[4]  = {fft_test_x30, fft_test_x64, fft_test_x157, fft_test_x317};
+    float complex * y[4]  = {fft_test_y30, fft_test_y64, fft_test_y157, fft_test_y317};
+
+    liquid_fft_cache_clear();
+    unsigned int n0 = liquid_fft_cache_get_num_entries();
+
+    // first pass populates cache
+    unsigned int i;
+    for (i=0; i<4; i++)
+        fft_plan_cache_test(x[i], y[i], sizes[i], 0);
+    unsigned int n1 = liquid_fft_cache_get_num_entries();
+    CONTEND_GREATER_THAN(n1, n0);
+
+    // second pass must not create any new entries, and results
+    // computed from cached data must still be correct
+    for (i=0; i<4; i++)
+        fft_plan_cache_test(x[i], y[i], sizes[i], 0);
+    CONTEND_EQUALITY(liquid_fft_cache_get_num_entries(), n1);
+
+    // entries in use by a live plan survive clearing
+    float complex buf_x[157], buf_y[157];
+    fftplan q = fft_create_plan(157, buf_x, buf_y, LIQUID_FFT_FORWARD, 0);
+    liquid_fft_cache_clear();
+    unsigned int n2 = liquid_fft_cache_get_num_entries();
+    CONTEND_GREATER_THAN(n2, 0);
+    CONTEND_LESS_THAN(n2, n1);
+    fft_plan_cache_test(fft_test_x157, fft_test_y157, 157, 0);
+    fft_destroy_plan(q);
+
+    // all entries now unused
+    liquid_fft_cache_clear();
+    CONTEND_EQUALITY(liquid_fft_cache_get_num_entries(), n0);
+}
+
+// measured plans store wisdom which is re-used by subsequent plans
+void autotest_fft_plan_wisdom()
+{
+    unsigned int sizes[5] = {17, 30, 64, 157, 192};
+    float complex * x[5]  = {fft_test_x17, fft_test_x30, fft_test_x64, fft_test_x157, fft_test_x192};
+    float complex * y[5]  = {fft_test_y17, fft_test_y30, fft_test_y64, fft_test_y157, fft_test_y192};
+
+    liquid_fft_wisdom_clear();
+
+    unsigned int i;
+    for (i=0; i<5; i++) {
+        CONTEND_EQUALITY(liquid_fft_wisdom_lookup(sizes[i], LIQUID_FFT_FORWARD),
+                         LIQUID_FFT_METHOD_UNKNOWN);
+
+        // measure
+        liquid_fft_method m0 = fft_plan_cache_test(x[i], y[i], sizes[i], LIQUID_FFT_MEASURE);
+        CONTEND_EQUALITY(liquid_fft_wisdom_lookup(sizes[i], LIQUID_FFT_FORWARD), m0);
+
+        // wisdom is used even without measure flag
+        liquid_fft_method m1 = fft_plan_cache_test(x[i], y[i], sizes[i], 0);
+        CONTEND_EQUALITY(m0, m1);
+    }
+
+    // forget wisdom; plans revert to estimated method
+    liquid_fft_wisdom_clear();
+    for (i=0; i<5; i++) {
+        CONTEND_EQUALITY(liquid_fft_wisdom_lookup(sizes[i], LIQUID_FFT_FORWARD),
+                         LIQUID_FFT_METHOD_UNKNOWN);
+        CONTEND_EQUALITY(fft_plan_cache_test(x[i], y[i], sizes[i], 0),
+                         liquid_fft_estimate_method(sizes[i]));
+    }
+}
+
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_radix4_autotest.c : test radix-4 (Stockham) power-of-two transforms
+//
+
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// helper function: compare radix-4 transform against double-precision
+// DFT for both directions, out-of-place and in-place
+//  _nfft   :   fft size
+void fft_radix4_test(unsigned int _nfft)
+{
+    float tol = 2e-5f * _nfft;
+
+    float complex x[_nfft];
+    float complex y[_nfft];
+    float complex y_test[_nfft];
+    unsigned int i, k;
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    int d;
+    for (d=0; d<2; d++) {
+        int dir = d==0 ? LIQUID_FFT_FORWARD : LIQUID_FFT_BACKWARD;
+
+        // reference
+        for (k=0; k<_nfft; k++) {
+            double yi = 0.0, yq = 0.0;
+            for (i=0; i<_nfft; i++) {
+                double theta = (dir == LIQUID_FFT_FORWARD ? -2 : 2) * M_PI * (double)((i*k) % _nfft) / (double)_nfft;
+                yi += crealf(x[i])*cos(theta) - cimagf(x[i])*sin(theta);
+                yq += crealf(x[i])*sin(theta) + cimagf(x[i])*cos(theta);
+            }
+            y_test[k] = yi + _Complex_I*yq;
+        }
+
+        // out-of-place
+        fftplan q = fft_create_plan_method(_nfft, x, y, dir, 0, LIQUID_FFT_METHOD_RADIX4);
+        fft_execute(q);
+        fft_destroy_plan(q);
+        for (k=0; k<_nfft; k++)
+            CONTEND_DELTA( cabsf(y[k] - y_test[k]), 0, tol );
+
+        // in-place
+        memmove(y, x, _nfft*sizeof(float complex));
+        q = fft_create_plan_method(_nfft, y, y, dir, 0, LIQUID_FFT_METHOD_RADIX4);
+        fft_execute(q);
+        fft_destroy_plan(q);
+        for (k=0; k<_nfft; k++)
+            CONTEND_DELTA( cabsf(y[k] - y_test[k]), 0, tol );
+    }
+}
+
+// run all power-of-two sizes with each set of SIMD extensions
+void autotest_fft_radix4()
+{
+    unsigned int masks[3] = {~0U, ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2), 0};
+
+    unsigned int i, m;
+    for (i=0; i<3; i++) {
+        liquid_cpu_set_mask(masks[i]);
+        for (m=1; m<=12; m++)
+            fft_radix4_test(1<<m);
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
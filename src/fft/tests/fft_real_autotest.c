@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fft_real_autotest.c : test real-to-complex/complex-to-real transforms
+//                       and fast real-to-real (DCT/DST/MDCT) transforms
+//
+
+#include <string.h>
+#include <math.h>
+
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// helper function: compare real-to-complex and complex-to-real
+// transforms against double-precision DFT
+//  _nfft   :   fft size
+void fft_real_test(unsigned int _nfft)
+{
+    float tol = 1e-5f * (_nfft + 10);
+    unsigned int nbins = _nfft/2 + 1;
+
+    float         x[_nfft];
+    float complex X[nbins];
+    float complex X_test[nbins];
+    float         y[_nfft];
+    unsigned int i, k;
+    for (i=0; i<_nfft; i++)
+        x[i] = randnf();
+
+    // reference
+    for (k=0; k<nbins; k++) {
+        double yi = 0.0, yq = 0.0;
+        for (i=0; i<_nfft; i++) {
+            double theta = -2 * M_PI * (double)((i*k) % _nfft) / (double)_nfft;
+            yi += x[i]*cos(theta);
+            yq += x[i]*sin(theta);
+        }
+        X_test[k] = yi + _Complex_I*yq;
+    }
+
+    // forward transform
+    fftplan q = fft_create_plan_r2c(_nfft, x, X, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+    for (k=0; k<nbins; k++)
+        CONTEND_DELTA( cabsf(X[k] - X_test[k]), 0, tol );
+
+    // inverse transform (not normalized)
+    q = fft_create_plan_c2r(_nfft, X, y, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+    for (i=0; i<_nfft; i++)
+        CONTEND_DELTA( y[i], x[i]*_nfft, tol );
+}
+
+// helper function: compare real-to-real transform against direct
+// double-precision evaluation
+//  _n      :   transform size
+//  _type   :   transform type (e.g. LIQUID_FFT_REDFT10)
+void fft_real_r2r_test(unsigned int _n,
+                       int          _type)
+{
+    float tol = 1e-5f * (_n + 10);
+    unsigned int nx = _type == LIQUID_FFT_MDCT  ? 2*_n : _n;
+    unsigned int ny = _type == LIQUID_FFT_IMDCT ? 2*_n : _n;
+
+    float x[nx];
+    float y[ny];
+    float y_test[ny];
+    unsigned int i, k;
+    for (i=0; i<nx; i++)
+        x[i] = randnf();
+
+    // reference
+    double N = (double)_n;
+    for (k=0; k<ny; k++) {
+        double v = 0.0;
+        for (i=0; i<nx; i++) {
+            switch (_type) {
+            case LIQUID_FFT_REDFT00:
+                v += (i==0 || i==_n-1) ? 0.5*x[i]*cos(M_PI*i*k/(N-1)) : x[i]*cos(M_PI*i*k/(N-1));
+                break;
+            case LIQUID_FFT_REDFT10: v += x[i]*cos(M_PI*(i+0.5)*k/N);                break;
+            case LIQUID_FFT_REDFT01: v += (i==0 ? 0.5 : 1.0)*x[i]*cos(M_PI*i*(k+0.5)/N); break;
+            case LIQUID_FFT_REDFT11: v += x[i]*cos(M_PI*(i+0.5)*(k+0.5)/N);          break;
+            case LIQUID_FFT_RODFT00: v += x[i]*sin(M_PI*(i+1)*(k+1)/(N+1));          break;
+            case LIQUID_FFT_RODFT10: v += x[i]*sin(M_PI*(i+0.5)*(k+1)/N);            break;
+            case LIQUID_FFT_RODFT01: v += (i==_n-1 ? 0.5 : 1.0)*x[i]*sin(M_PI*(i+1)*(k+0.5)/N); break;
+            case LIQUID_FFT_RODFT11: v += x[i]*sin(M_PI*(i+0.5)*(k+0.5)/N);          break;
+            case LIQUID_FFT_MDCT:    v += x[i]*cos(M_PI/N*(i+0.5+N/2)*(k+0.5));      break;
+            case LIQUID_FFT_IMDCT:   v += x[i]*cos(M_PI/N*(k+0.5+N/2)*(i+0.5));      break;
+            default:;
+            }
+        }
+        y_test[k] = 2.0*v;
+    }
+
+    fftplan q = fft_create_plan_r2r_1d(_n, x, y, _type, 0);
+    fft_execute(q);
+    fft_destroy_plan(q);
+
+    if (liquid_autotest_verbose) {
+        printf("type %d, n=%u\n", _type, _n);
+        for (k=0; k<ny; k++)
+            printf("  %3u : %12.8f %12.8f\n", k, y[k], y_test[k]);
+    }
+
+    for (k=0; k<ny; k++)
+        CONTEND_DELTA( y[k], y_test[k], tol );
+}
+
+// real-to-complex/complex-to-real transforms, even and odd sizes,
+// with each set of SIMD extensions
+void autotest_fft_real()
+{
+    unsigned int masks[3] = {~0U, ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2), 0};
+    unsigned int sizes[] = {1, 2, 3, 4, 5, 6, 8, 10, 15, 16, 18, 30, 64, 100, 127, 256, 1024};
+    unsigned int i, m;
+    for (m=0; m<3; m++) {
+        liquid_cpu_set_mask(masks[m]);
+        for (i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+            fft_real_test(sizes[i]);
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+// all real-to-real transform types, even and odd sizes
+void autotest_fft_real_r2r()
+{
+    int types[] = {LIQUID_FFT_REDFT00, LIQUID_FFT_REDFT10, LIQUID_FFT_REDFT01, LIQUID_FFT_REDFT11,
+                   LIQUID_FFT_RODFT00, LIQUID_FFT_RODFT10, LIQUID_FFT_RODFT01, LIQUID_FFT_RODFT11};
+    unsigned int sizes[] = {2, 3, 4, 5, 7, 8, 12, 17, 32, 60, 128, 255};
+    unsigned int t, i;
+    for (t=0; t<sizeof(types)/sizeof(types[0]); t++) {
+        for (i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++)
+            fft_real_r2r_test(sizes[i], types[t]);
+    }
+}
+
+// modified discrete cosine transform (even sizes only)
+void autotest_fft_real_mdct()
+{
+    unsigned int sizes[] = {2, 4, 6, 16, 30, 64, 256};
+    unsigned int i;
+    for (i=0; i<sizeof(sizes)/sizeof(sizes[0]); i++) {
+        fft_real_r2r_test(sizes[i], LIQUID_FFT_MDCT);
+        fft_real_r2r_test(sizes[i], LIQUID_FFT_IMDCT);
+    }
+}
+
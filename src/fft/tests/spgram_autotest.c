@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// spgram_autotest.c : test spectral periodogram
+//
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// helper function: compare spgram_estimate_psd() against spectra
+// computed by pushing samples one at a time and executing
+// periodically
+//  _nfft       :   fft size
+//  _window_len :   window length
+//  _n          :   number of input samples
+void spgram_psd_test(unsigned int _nfft,
+                     unsigned int _window_len,
+                     unsigned int _n)
+{
+    float tol = 1e-4f;
+
+    float complex x[_n];
+    unsigned int i, k;
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    spgram q0 = spgram_create_kaiser(_nfft, _window_len, 10.0f);
+    spgram q1 = spgram_create_kaiser(_nfft, _window_len, 10.0f);
+
+    // run twice to verify internal buffer state is retained
+    unsigned int r;
+    for (r=0; r<2; r++) {
+        float psd[_nfft];
+        spgram_estimate_psd(q0, x, _n, psd);
+
+        // reference
+        unsigned int delay = _nfft/4 > 0 ? _nfft/4 : 1;
+        unsigned int num_transforms = 0;
+        float psd_test[_nfft];
+        float complex X[_nfft];
+        for (k=0; k<_nfft; k++)
+            psd_test[k] = 0.0f;
+        for (i=0; i<_n; i++) {
+            spgram_push(q1, &x[i], 1);
+            if ( ((i+1)%delay)==0 || (i==_n-1)) {
+                spgram_execute(q1, X);
+                for (k=0; k<_nfft; k++)
+                    psd_test[k] += crealf(X[k]*conjf(X[k]));
+                num_transforms++;
+            }
+        }
+
+        for (k=0; k<_nfft; k++)
+            CONTEND_DELTA( psd[k], psd_test[k] / (float)num_transforms, tol );
+    }
+
+    spgram_destroy(q0);
+    spgram_destroy(q1);
+}
+
+void autotest_spgram_psd_n64_w51()    { spgram_psd_test(  64,  51, 1000); }
+void autotest_spgram_psd_n256_w200()  { spgram_psd_test( 256, 200,  997); }
+void autotest_spgram_psd_n30_w30()    { spgram_psd_test(  30,  30,  301); }
+void autotest_spgram_psd_n4096_w4000(){ spgram_psd_test(4096,4000,10000); }
+
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _h_len  :   filter length
+//  _n      :   block size
+void fftfilt_crcf_bench(struct rusage *_start,
+                        struct rusage *_finish,
+                        unsigned long int *_num_iterations,
+                        unsigned int _h_len,
+                        unsigned int _n)
+{
+    // adjust number of iterations: one trial per block of _n samples
+    *_num_iterations *= 20;
+    *_num_iterations /= _n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // generate coefficients
+    float h[_h_len];
+    unsigned long int i;
+    for (i=0; i<_h_len; i++)
+        h[i] = randnf();
+
+    // create filter object
+    fftfilt_crcf q = fftfilt_crcf_create(h,_h_len,_n);
+
+    // generate input vector
+    float complex x[_n];
+    for (i=0; i<_n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // output vector
+    float complex y[_n];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        fftfilt_crcf_execute(q, x, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _n;
+
+    fftfilt_crcf_destroy(q);
+}
+
+#define FFTFILT_CRCF_BENCHMARK_API(H_LEN,N) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ fftfilt_crcf_bench(_start, _finish, _num_iterations, H_LEN, N); }
+
+void benchmark_fftfilt_crcf_64      FFTFILT_CRCF_BENCHMARK_API(64,   64)
+void benchmark_fftfilt_crcf_256     FFTFILT_CRCF_BENCHMARK_API(256,  256)
+void benchmark_fftfilt_crcf_1024    FFTFILT_CRCF_BENCHMARK_API(1024, 1024)
+void benchmark_fftfilt_crcf_1024x4k FFTFILT_CRCF_BENCHMARK_API(1024, 4096)
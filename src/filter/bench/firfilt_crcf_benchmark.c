@@ -76,3 +76,57 @@ void benchmark_firfilt_crcf_16   FIRFILT_CRCF_BENCHMARK_API(16)
 void benchmark_firfilt_crcf_32   FIRFILT_CRCF_BENCHMARK_API(32)
 void benchmark_firfilt_crcf_64   FIRFILT_CRCF_BENCHMARK_API(64)
 
+
+// Helper function: block execution
+void firfilt_crcf_block_bench(struct rusage *_start,
+                              struct rusage *_finish,
+                              unsigned long int *_num_iterations,
+                              unsigned int _n)
+{
+    // adjust number of iterations (block of 1024 samples per trial)
+    *_num_iterations *= 1000;
+    *_num_iterations /= (unsigned int)(107+4.3*_n);
+    *_num_iterations /= 1024;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // generate coefficients
+    float h[_n];
+    unsigned long int i;
+    for (i=0; i<_n; i++)
+        h[i] = randnf();
+
+    // create filter object
+    firfilt_crcf f = firfilt_crcf_create(h,_n);
+
+    // generate input vector
+    float complex x[1024];
+    for (i=0; i<1024; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // output vector
+    float complex y[1024];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firfilt_crcf_execute_block(f, x, 1024, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 1024;
+
+    firfilt_crcf_destroy(f);
+}
+
+#define FIRFILT_CRCF_BLOCK_BENCHMARK_API(N) \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ firfilt_crcf_block_bench(_start, _finish, _num_iterations, N); }
+
+void benchmark_firfilt_crcf_block_4    FIRFILT_CRCF_BLOCK_BENCHMARK_API(4)
+void benchmark_firfilt_crcf_block_8    FIRFILT_CRCF_BLOCK_BENCHMARK_API(8)
+void benchmark_firfilt_crcf_block_16   FIRFILT_CRCF_BLOCK_BENCHMARK_API(16)
+void benchmark_firfilt_crcf_block_32   FIRFILT_CRCF_BLOCK_BENCHMARK_API(32)
+void benchmark_firfilt_crcf_block_64   FIRFILT_CRCF_BLOCK_BENCHMARK_API(64)
+void benchmark_firfilt_crcf_block_128  FIRFILT_CRCF_BLOCK_BENCHMARK_API(128)
+void benchmark_firfilt_crcf_block_256  FIRFILT_CRCF_BLOCK_BENCHMARK_API(256)
+void benchmark_firfilt_crcf_block_1024 FIRFILT_CRCF_BLOCK_BENCHMARK_API(1024)
@@ -92,3 +92,61 @@ void benchmark_iirfilt_crcf_sos_16   IIRFILT_CRCF_BENCHMARK_API(16,   LIQUID_IIR
 void benchmark_iirfilt_crcf_sos_32   IIRFILT_CRCF_BENCHMARK_API(32,   LIQUID_IIRDES_SOS)
 void benchmark_iirfilt_crcf_sos_64   IIRFILT_CRCF_BENCHMARK_API(64,   LIQUID_IIRDES_SOS)
 
+
+// Helper function for block execution
+//  _parallel   :   use parallel form instead of cascaded sections
+void iirfilt_crcf_bench_block(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations,
+                              unsigned int        _order,
+                              int                 _parallel)
+{
+    unsigned int i;
+
+    // design filter in second-order sections form
+    float fc    =  0.2f;    // filter cut-off frequency
+    float f0    =  0.0f;    // filter center frequency (band-pass, band-stop)
+    float Ap    =  0.1f;    // filter pass-band ripple
+    float As    = 60.0f;    // filter stop-band attenuation
+    unsigned int nsos = (_order + 1) / 2;
+    float B[3*nsos];
+    float A[3*nsos];
+    liquid_iirdes(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS,
+                  _order, fc, f0, Ap, As, B, A);
+    iirfilt_crcf q = _parallel ? iirfilt_crcf_create_parallel(B, A, nsos) :
+                                 iirfilt_crcf_create_sos(B, A, nsos);
+
+    // initialize input/output
+    unsigned int num_samples = 256;
+    float complex x[num_samples];
+    float complex y[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+    *_num_iterations /= num_samples;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        iirfilt_crcf_execute_block(q, x, num_samples, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_samples;
+
+    // destroy filter object
+    iirfilt_crcf_destroy(q);
+}
+
+#define IIRFILT_CRCF_BLOCK_BENCHMARK_API(N,P)   \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ iirfilt_crcf_bench_block(_start, _finish, _num_iterations, N, P); }
+
+// benchmark block execution, second-order sections form
+void benchmark_iirfilt_crcf_block_sos_4      IIRFILT_CRCF_BLOCK_BENCHMARK_API(4,  0)
+void benchmark_iirfilt_crcf_block_sos_8      IIRFILT_CRCF_BLOCK_BENCHMARK_API(8,  0)
+void benchmark_iirfilt_crcf_block_sos_16     IIRFILT_CRCF_BLOCK_BENCHMARK_API(16, 0)
+
+// benchmark block execution, parallel form
+void benchmark_iirfilt_crcf_block_parallel_4  IIRFILT_CRCF_BLOCK_BENCHMARK_API(4,  1)
+void benchmark_iirfilt_crcf_block_parallel_8  IIRFILT_CRCF_BLOCK_BENCHMARK_API(8,  1)
+void benchmark_iirfilt_crcf_block_parallel_16 IIRFILT_CRCF_BLOCK_BENCHMARK_API(16, 1)
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+void msresamp_crcf_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         float               _r,
+                         unsigned int        _block_len)
+{
+    unsigned long int i;
+    unsigned int j;
+    msresamp_crcf q = msresamp_crcf_create(_r, 60.0f);
+
+    // input block and output buffer
+    unsigned int n = 1024;
+    float complex x[n];
+    float complex y[(unsigned int)(_r*n) + 64];
+    for (j=0; j<n; j++)
+        x[j] = (j % 3) == 0 ? 1.0f : -0.5f;
+
+    unsigned int num_written;
+
+    // start trials
+    *_num_iterations /= n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        for (j=0; j<n; j+=_block_len)
+            msresamp_crcf_execute_block(q, &x[j], _block_len, y, &num_written);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    msresamp_crcf_destroy(q);
+}
+
+#define MSRESAMP_CRCF_BENCHMARK_API(R,B)    \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ msresamp_crcf_bench(_start, _finish, _num_iterations, R, B); }
+
+// one input sample per call
+void benchmark_msresamp_crcf_decim_0p013    MSRESAMP_CRCF_BENCHMARK_API(0.013f, 1)
+void benchmark_msresamp_crcf_arb_0p79       MSRESAMP_CRCF_BENCHMARK_API(0.79f,  1)
+void benchmark_msresamp_crcf_interp_9p1     MSRESAMP_CRCF_BENCHMARK_API(9.1f,   1)
+
+// blocks of 1024 input samples
+void benchmark_msresamp_crcf_decim_0p013_block  MSRESAMP_CRCF_BENCHMARK_API(0.013f, 1024)
+void benchmark_msresamp_crcf_arb_0p79_block     MSRESAMP_CRCF_BENCHMARK_API(0.79f,  1024)
+void benchmark_msresamp_crcf_interp_9p1_block   MSRESAMP_CRCF_BENCHMARK_API(9.1f,   1024)
+
@@ -23,7 +23,9 @@
 
 typedef enum {
     RESAMP2_DECIM,
-    RESAMP2_INTERP
+    RESAMP2_INTERP,
+    RESAMP2_DECIM_BLOCK,
+    RESAMP2_INTERP_BLOCK
 } resamp2_type;
 
 // Helper function to keep code base small
@@ -43,8 +45,10 @@ void resamp2_crcf_bench(struct rusage *_start,
 
     resamp2_crcf q = resamp2_crcf_create(_m,0.0f,60.0f);
 
-    float complex x[] = {1.0f, -1.0f};
-    float complex y[] = {1.0f, -1.0f};
+    float complex x[512];
+    float complex y[512];
+    for (i=0; i<512; i++)
+        x[i] = (i % 2) ? -1.0f : 1.0f;
 
     // start trials
     getrusage(RUSAGE_SELF, _start);
@@ -57,7 +61,7 @@ void resamp2_crcf_bench(struct rusage *_start,
             resamp2_crcf_decim_execute(q,x,y);
             resamp2_crcf_decim_execute(q,x,y);
         }
-    } else {
+    } else if (_type == RESAMP2_INTERP) {
 
         // run interpolator
         for (i=0; i<(*_num_iterations); i++) {
@@ -66,6 +70,17 @@ void resamp2_crcf_bench(struct rusage *_start,
             resamp2_crcf_interp_execute(q,x[0],y);
             resamp2_crcf_interp_execute(q,x[0],y);
         }
+    } else {
+
+        // run decimator/interpolator on blocks of 4*64 samples
+        *_num_iterations /= 64;
+        for (i=0; i<(*_num_iterations); i++) {
+            if (_type == RESAMP2_DECIM_BLOCK)
+                resamp2_crcf_decim_execute_block(q,x,256,y);
+            else
+                resamp2_crcf_interp_execute_block(q,x,256,y);
+        }
+        *_num_iterations *= 64;
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -95,3 +110,11 @@ void benchmark_resamp2_crcf_interp_m4   RESAMP2_CRCF_BENCHMARK_API( 4,RESAMP2_IN
 void benchmark_resamp2_crcf_interp_m8   RESAMP2_CRCF_BENCHMARK_API( 8,RESAMP2_INTERP) // n=33
 void benchmark_resamp2_crcf_interp_m16  RESAMP2_CRCF_BENCHMARK_API(16,RESAMP2_INTERP) // n=65
 
+// 
+// Block decimators/interpolators
+//
+void benchmark_resamp2_crcf_decim_block_m4  RESAMP2_CRCF_BENCHMARK_API( 4,RESAMP2_DECIM_BLOCK)
+void benchmark_resamp2_crcf_decim_block_m16 RESAMP2_CRCF_BENCHMARK_API(16,RESAMP2_DECIM_BLOCK)
+void benchmark_resamp2_crcf_interp_block_m4 RESAMP2_CRCF_BENCHMARK_API( 4,RESAMP2_INTERP_BLOCK)
+void benchmark_resamp2_crcf_interp_block_m16 RESAMP2_CRCF_BENCHMARK_API(16,RESAMP2_INTERP_BLOCK)
+
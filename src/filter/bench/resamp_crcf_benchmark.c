@@ -24,7 +24,8 @@
 void resamp_crcf_bench(struct rusage *     _start,
                        struct rusage *     _finish,
                        unsigned long int * _num_iterations,
-                       unsigned int        _m)
+                       unsigned int        _m,
+                       int                 _block)
 {
     unsigned long int i;
     float r = 1.03f;        // resampling rate
@@ -35,17 +36,28 @@ void resamp_crcf_bench(struct rusage *     _start,
 
     resamp_crcf q = resamp_crcf_create(r,m,bw,As,npfb);
 
-    float complex y[4];
+    float complex x[256];
+    float complex y[300];
+    for (i=0; i<256; i++)
+        x[i] = (i % 4) == 1 ? 1.1f : ((i % 4) == 2 ? 0.9f : 1.0f);
 
     unsigned int num_written;
 
     // start trials
     getrusage(RUSAGE_SELF, _start);
-    for (i=0; i<(*_num_iterations); i++) {
-        resamp_crcf_execute(q, 1.0f, y, &num_written);
-        resamp_crcf_execute(q, 1.1f, y, &num_written);
-        resamp_crcf_execute(q, 0.9f, y, &num_written);
-        resamp_crcf_execute(q, 1.0f, y, &num_written);
+    if (_block) {
+        // run on blocks of 256 samples
+        *_num_iterations /= 64;
+        for (i=0; i<(*_num_iterations); i++)
+            resamp_crcf_execute_block(q, x, 256, y, &num_written);
+        *_num_iterations *= 64;
+    } else {
+        for (i=0; i<(*_num_iterations); i++) {
+            resamp_crcf_execute(q, 1.0f, y, &num_written);
+            resamp_crcf_execute(q, 1.1f, y, &num_written);
+            resamp_crcf_execute(q, 0.9f, y, &num_written);
+            resamp_crcf_execute(q, 1.0f, y, &num_written);
+        }
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -53,19 +65,24 @@ void resamp_crcf_bench(struct rusage *     _start,
     resamp_crcf_destroy(q);
 }
 
-#define RESAMP_CRCF_BENCHMARK_API(M)    \
-(   struct rusage *_start,              \
-    struct rusage *_finish,             \
-    unsigned long int *_num_iterations) \
-{ resamp_crcf_bench(_start, _finish, _num_iterations, M); }
+#define RESAMP_CRCF_BENCHMARK_API(M,BLOCK)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ resamp_crcf_bench(_start, _finish, _num_iterations, M, BLOCK); }
 
 //
 // Resampler benchmark prototypes
 //
-void benchmark_resamp_crcf_m4    RESAMP_CRCF_BENCHMARK_API(4)
-void benchmark_resamp_crcf_m8    RESAMP_CRCF_BENCHMARK_API(8)
-void benchmark_resamp_crcf_m16   RESAMP_CRCF_BENCHMARK_API(16)
-void benchmark_resamp_crcf_m32   RESAMP_CRCF_BENCHMARK_API(32)
-void benchmark_resamp_crcf_m64   RESAMP_CRCF_BENCHMARK_API(64)
-void benchmark_resamp_crcf_m128  RESAMP_CRCF_BENCHMARK_API(128)
+void benchmark_resamp_crcf_m4    RESAMP_CRCF_BENCHMARK_API(4,0)
+void benchmark_resamp_crcf_m8    RESAMP_CRCF_BENCHMARK_API(8,0)
+void benchmark_resamp_crcf_m16   RESAMP_CRCF_BENCHMARK_API(16,0)
+void benchmark_resamp_crcf_m32   RESAMP_CRCF_BENCHMARK_API(32,0)
+void benchmark_resamp_crcf_m64   RESAMP_CRCF_BENCHMARK_API(64,0)
+void benchmark_resamp_crcf_m128  RESAMP_CRCF_BENCHMARK_API(128,0)
+
+// block execution
+void benchmark_resamp_crcf_block_m4    RESAMP_CRCF_BENCHMARK_API(4,1)
+void benchmark_resamp_crcf_block_m16   RESAMP_CRCF_BENCHMARK_API(16,1)
+void benchmark_resamp_crcf_block_m64   RESAMP_CRCF_BENCHMARK_API(64,1)
 
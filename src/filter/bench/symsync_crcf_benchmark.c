@@ -78,4 +78,6 @@ void benchmark_symsync_crcf_k2_m2   SYMSYNC_CRCF_BENCHMARK_API(2, 2)
 void benchmark_symsync_crcf_k2_m4   SYMSYNC_CRCF_BENCHMARK_API(2, 4)
 void benchmark_symsync_crcf_k2_m8   SYMSYNC_CRCF_BENCHMARK_API(2, 8)
 void benchmark_symsync_crcf_k2_m16  SYMSYNC_CRCF_BENCHMARK_API(2, 16)
-
+void benchmark_symsync_crcf_k8_m2   SYMSYNC_CRCF_BENCHMARK_API(8, 2)
+void benchmark_symsync_crcf_k8_m4   SYMSYNC_CRCF_BENCHMARK_API(8, 4)
+void benchmark_symsync_crcf_k8_m8   SYMSYNC_CRCF_BENCHMARK_API(8, 8)
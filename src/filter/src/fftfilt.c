@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fftfilt : finite impulse response (FIR) filter using fast Fourier
+//           transforms (overlap-save block convolution)
+//
+// Each call to execute() takes a block of _n new input samples. These
+// are appended to the previous _n samples to form a transform of size
+// nfft = 2*_n, which is multiplied by the (pre-computed) transform of
+// the zero-padded filter coefficients. The first _n samples of the
+// inverse transform are corrupted by circular wrap-around and are
+// discarded; the last _n are the valid filter output. This requires
+// the filter length to be no greater than _n+1.
+//
+// When the input, output and coefficients are all real the transforms
+// are real-to-complex/complex-to-real, computing only the
+// non-redundant half of the spectrum (nfft/2+1 bins).
+//
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// defined:
+//  FFTFILT()       name-mangling macro
+//  TO              output type
+//  TC              coefficients type
+//  TI              input type
+//  PRINTVAL()      print macro
+
+// use real-to-complex transforms for real signals and filters
+#define FFTFILT_REAL (!TO_COMPLEX && !TC_COMPLEX && !TI_COMPLEX)
+
+#if FFTFILT_REAL
+#  define TB float          // time-domain buffer type
+#else
+#  define TB float complex  // time-domain buffer type
+#endif
+
+// fftfilt object structure
+struct FFTFILT(_s) {
+    TC * h;                 // filter coefficients array [size; h_len x 1]
+    unsigned int h_len;     // filter length
+    unsigned int n;         // block size
+    unsigned int nfft;      // transform size (2*n)
+    unsigned int nbins;     // number of frequency bins computed
+
+    TB * time_buf;              // time-domain buffer (overlapping blocks)
+    float complex * freq_buf;   // frequency-domain buffer
+    TB * out_buf;               // inverse transform output
+    float complex * H;          // filter frequency response, scaled by 1/nfft
+
+    FFT_PLAN fft;               // forward transform (time_buf -> freq_buf)
+    FFT_PLAN ifft;              // inverse transform (freq_buf -> out_buf)
+};
+
+// create FFT-based FIR filter using external coefficients
+//  _h      :   filter coefficients [size: _h_len x 1]
+//  _h_len  :   filter length, _h_len > 0
+//  _n      :   block size = nfft/2, _n >= _h_len-1
+FFTFILT() FFTFILT(_create)(TC *         _h,
+                           unsigned int _h_len,
+                           unsigned int _n)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: fftfilt_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_n == 0) {
+        fprintf(stderr,"error: fftfilt_%s_create(), block size must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_h_len > _n+1) {
+        fprintf(stderr,"error: fftfilt_%s_create(), block size must be at least filter length - 1 (%u)\n", EXTENSION_FULL, _h_len-1);
+        exit(1);
+    }
+
+    // create filter object and initialize
+    FFTFILT() q = (FFTFILT()) malloc(sizeof(struct FFTFILT(_s)));
+    q->h_len = _h_len;
+    q->n     = _n;
+    q->nfft  = 2*_n;
+    q->nbins = FFTFILT_REAL ? q->n + 1 : q->nfft;
+
+    // copy filter coefficients
+    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    memmove(q->h, _h, (q->h_len)*sizeof(TC));
+
+    // allocate memory for buffers
+    q->time_buf = (TB *) malloc((q->nfft)*sizeof(TB));
+    q->freq_buf = (float complex*) malloc((q->nbins)*sizeof(float complex));
+    q->out_buf  = (TB *) malloc((q->nfft)*sizeof(TB));
+    q->H        = (float complex*) malloc((q->nbins)*sizeof(float complex));
+
+    // create transforms
+#if FFTFILT_REAL
+    q->fft  = FFT_CREATE_PLAN_R2C(q->nfft, q->time_buf, q->freq_buf, FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN_C2R(q->nfft, q->freq_buf, q->out_buf,  FFT_METHOD);
+#else
+    q->fft  = FFT_CREATE_PLAN(q->nfft, q->time_buf, q->freq_buf, FFT_DIR_FORWARD,  FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN(q->nfft, q->freq_buf, q->out_buf,  FFT_DIR_BACKWARD, FFT_METHOD);
+#endif
+
+    // compute frequency response of zero-padded filter, folding
+    // inverse transform scaling into coefficients
+    unsigned int i;
+    for (i=0; i<q->nfft; i++)
+        q->time_buf[i] = (i < q->h_len) ? q->h[i] / (float)(q->nfft) : 0.0f;
+    FFT_EXECUTE(q->fft);
+    memmove(q->H, q->freq_buf, (q->nbins)*sizeof(float complex));
+
+    // reset filter state (clear buffer)
+    FFTFILT(_clear)(q);
+
+    return q;
+}
+
+// destroy filter object and free all internal memory
+void FFTFILT(_destroy)(FFTFILT() _q)
+{
+    // destroy transforms
+    FFT_DESTROY_PLAN(_q->fft);
+    FFT_DESTROY_PLAN(_q->ifft);
+
+    // free internal memory
+    free(_q->h);
+    free(_q->time_buf);
+    free(_q->freq_buf);
+    free(_q->out_buf);
+    free(_q->H);
+    free(_q);
+}
+
+// reset internal state of filter object
+void FFTFILT(_clear)(FFTFILT() _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++)
+        _q->time_buf[i] = 0.0f;
+}
+
+// print filter object internals
+void FFTFILT(_print)(FFTFILT() _q)
+{
+    printf("fftfilt_%s: [%u taps, block size %u, nfft %u]\n",
+            EXTENSION_FULL, _q->h_len, _q->n, _q->nfft);
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++) {
+        printf("  h(%3u) = ", i+1);
+        PRINTVAL_TC(_q->h[i],%12.8f);
+        printf("\n");
+    }
+}
+
+// execute the filter on one block of input samples
+//  _q      :   filter object
+//  _x      :   input array [size: _n x 1]
+//  _y      :   output array [size: _n x 1]
+void FFTFILT(_execute)(FFTFILT() _q,
+                       TI *      _x,
+                       TO *      _y)
+{
+    unsigned int i;
+    unsigned int n = _q->n;
+
+    // append new block to previous block
+    for (i=0; i<n; i++)
+        _q->time_buf[n+i] = _x[i];
+
+    // run forward transform
+    FFT_EXECUTE(_q->fft);
+
+    // apply filter response
+    for (i=0; i<_q->nbins; i++)
+        _q->freq_buf[i] *= _q->H[i];
+
+    // run inverse transform
+    FFT_EXECUTE(_q->ifft);
+
+    // retain new block as history for next call
+    memmove(_q->time_buf, &_q->time_buf[n], n*sizeof(TB));
+
+    // last half of inverse transform is valid (linear) convolution
+    for (i=0; i<n; i++) {
+#if TO_COMPLEX || FFTFILT_REAL
+        _y[i] = _q->out_buf[n+i];
+#else
+        _y[i] = crealf(_q->out_buf[n+i]);
+#endif
+    }
+}
+
+// get filter length
+unsigned int FFTFILT(_get_length)(FFTFILT() _q)
+{
+    return _q->h_len;
+}
+
+// get block size
+unsigned int FFTFILT(_get_block_size)(FFTFILT() _q)
+{
+    return _q->n;
+}
+
+#undef FFTFILT_REAL
+#undef TB
@@ -34,6 +34,10 @@
 
 #define LIQUID_FIRFILT_USE_WINDOW   (0)
 
+// minimum filter length for which execute_block() filters whole
+// blocks of input with an overlap-save (fftfilt) transform
+#define FIRFILT_BLOCK_FFT_MIN_LEN   (256)
+
 // firfilt object structure
 struct FIRFILT(_s) {
     TC * h;             // filter coefficients array [size; h_len x 1]
@@ -48,10 +52,30 @@ struct FIRFILT(_s) {
     unsigned int w_len;     // window length
     unsigned int w_mask;    // window index mask
     unsigned int w_index;   // window read index
+
+    // overlap-save filter for execute_block() with long filters
+    // (created on first use)
+    FFTFILT() ft;       // fft-based filter object
+    TI * ft_buf;        // history block for priming transform
+    TO * ft_out;        // discarded output of priming transform
 #endif
     DOTPROD() dp;       // dot product object
 };
 
+#if !LIQUID_FIRFILT_USE_WINDOW
+// destroy overlap-save filter used by execute_block(), if created
+void FIRFILT(_destroy_fft)(FIRFILT() _q)
+{
+    if (_q->ft == NULL)
+        return;
+
+    FFTFILT(_destroy)(_q->ft);
+    free(_q->ft_buf);
+    free(_q->ft_out);
+    _q->ft = NULL;
+}
+#endif
+
 // create firfilt object
 //  _h      :   coefficients (filter taps) [size: _n x 1]
 //  _n      :   filter length
@@ -78,6 +102,7 @@ FIRFILT() FIRFILT(_create)(TC * _h,
     q->w_mask  = q->w_len - 1;
     q->w       = (TI *) malloc((q->w_len + q->h_len + 1)*sizeof(TI));
     q->w_index = 0;
+    q->ft      = NULL;
 #endif
 
     // load filter in reverse order
@@ -194,6 +219,11 @@ FIRFILT() FIRFILT(_recreate)(FIRFILT() _q,
 #endif
     }
 
+#if !LIQUID_FIRFILT_USE_WINDOW
+    // overlap-save filter is re-created on next use
+    FIRFILT(_destroy_fft)(_q);
+#endif
+
     // load filter in reverse order
     for (i=_n; i>0; i--)
         _q->h[i-1] = _h[_n-i];
@@ -212,12 +242,14 @@ void FIRFILT(_destroy)(FIRFILT() _q)
     WINDOW(_destroy)(_q->w);
 #else
     free(_q->w);
+    FIRFILT(_destroy_fft)(_q);
 #endif
     DOTPROD(_destroy)(_q->dp);
     free(_q->h);
     free(_q);
 }
 
+
 // reset internal state of filter object
 void FIRFILT(_clear)(FIRFILT() _q)
 {
@@ -290,6 +322,97 @@ void FIRFILT(_execute)(FIRFILT() _q,
     DOTPROD(_execute)(_q->dp, r, _y);
 }
 
+// execute the filter on a block of input samples; the input is
+// copied into the internal buffer in contiguous runs (overlapping
+// the previous h_len-1 samples) and all outputs of a run are
+// computed from that linear buffer with the multi-output dot
+// product, which loads each coefficient vector once per group of
+// outputs. Long filters instead filter whole blocks of w_len input
+// samples by overlap-save (fftfilt), primed with the most recent
+// h_len-1 inputs; the remainder uses the direct method.
+//  _q      :   filter object
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _y      :   output array [size: _n x 1]
+void FIRFILT(_execute_block)(FIRFILT()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+#if LIQUID_FIRFILT_USE_WINDOW
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        FIRFILT(_push)(_q, _x[i]);
+        FIRFILT(_execute)(_q, &_y[i]);
+    }
+#else
+    // long filters: overlap-save over whole blocks of input
+    unsigned int nb = _q->w_len;
+    if (_q->h_len >= FIRFILT_BLOCK_FFT_MIN_LEN && _n >= 2*nb) {
+        unsigned int i;
+
+        // create overlap-save filter on first use (coefficients are
+        // stored in reverse order)
+        if (_q->ft == NULL) {
+            TC h[_q->h_len];
+            for (i=0; i<_q->h_len; i++)
+                h[i] = _q->h[_q->h_len-i-1];
+            _q->ft     = FFTFILT(_create)(h, _q->h_len, nb);
+            _q->ft_buf = (TI *) malloc(nb*sizeof(TI));
+            _q->ft_out = (TO *) malloc(nb*sizeof(TO));
+        }
+
+        // prime transform history with the most recent h_len-1 inputs
+        unsigned int p = _q->h_len - 1;
+        memset(_q->ft_buf, 0x00, (nb-p)*sizeof(TI));
+        memmove(_q->ft_buf + nb - p, _q->w + _q->w_index + 1, p*sizeof(TI));
+        FFTFILT(_execute)(_q->ft, _q->ft_buf, _q->ft_out);
+
+        // retain the last h_len inputs as the window before any
+        // output is written (in-place is permitted)
+        unsigned int m = (_n / nb) * nb;
+        memmove(_q->w, _x + m - _q->h_len, _q->h_len*sizeof(TI));
+        _q->w_index = 0;
+
+        for (i=0; i<m; i+=nb)
+            FFTFILT(_execute)(_q->ft, _x + i, _y + i);
+
+        _x += m;
+        _y += m;
+        _n -= m;
+    }
+
+    while (_n > 0) {
+        // start of window after next push
+        unsigned int b = _q->w_index + 1;
+
+        // wrap around: move most recent h_len-1 samples to start of buffer
+        if (b == _q->w_len) {
+            memmove(_q->w, _q->w + _q->w_len, (_q->h_len-1)*sizeof(TI));
+            b = 0;
+        }
+
+        // number of samples which fit before the buffer must wrap again
+        unsigned int m = _q->w_len - b;
+        if (m > _n)
+            m = _n;
+
+        // append run of inputs to contiguous buffer and compute all of
+        // its outputs with the multi-output dot product; inputs are
+        // copied before any output is written (in-place is permitted)
+        TI * w = _q->w + b;
+        memmove(w + _q->h_len - 1, _x, m*sizeof(TI));
+        DOTPROD(_execute_block)(_q->dp, w, m, _y);
+
+        // update state
+        _q->w_index = b + m - 1;
+        _x += m;
+        _y += m;
+        _n -= m;
+    }
+#endif
+}
+
 // get filter length
 unsigned int FIRFILT(_get_length)(FIRFILT() _q)
 {
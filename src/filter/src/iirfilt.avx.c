@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// iirfilt.avx.c : infinite impulse response filter kernels (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// run second-order section over blocks of four samples using its
+// look-ahead coefficients; outputs and state share one register,
+// {y[0], y[1], y[2], y[3], w[3], w[2], 0, 0}
+__attribute__((target("avx2,fma")))
+unsigned int iirfilt_rrrf_sos_block_avx2(float *      _t,
+                                         float *      _v,
+                                         float *      _x,
+                                         unsigned int _n,
+                                         float *      _y)
+{
+    const __m256i i1 = _mm256_set1_epi32(4);
+    const __m256i i2 = _mm256_set1_epi32(5);
+    __m256 c0 = _mm256_loadu_ps(_t +  0);
+    __m256 c1 = _mm256_loadu_ps(_t +  8);
+    __m256 c2 = _mm256_loadu_ps(_t + 16);
+    __m256 c3 = _mm256_loadu_ps(_t + 24);
+    __m256 c4 = _mm256_loadu_ps(_t + 32);
+    __m256 c5 = _mm256_loadu_ps(_t + 40);
+
+    __m256 s1 = _mm256_set1_ps(_v[0]);
+    __m256 s2 = _mm256_set1_ps(_v[1]);
+    __m256 r  = _mm256_setzero_ps();
+
+    unsigned int i;
+    for (i=0; i+4 <= _n; i+=4) {
+        // input contribution
+        __m256 u = _mm256_fmadd_ps(c1, _mm256_broadcast_ss(_x+i+1),
+                                   _mm256_mul_ps(c0, _mm256_broadcast_ss(_x+i+0)));
+        __m256 v = _mm256_fmadd_ps(c3, _mm256_broadcast_ss(_x+i+3),
+                                   _mm256_mul_ps(c2, _mm256_broadcast_ss(_x+i+2)));
+
+        // state contribution
+        r = _mm256_fmadd_ps(c4, s1, _mm256_fmadd_ps(c5, s2, _mm256_add_ps(u, v)));
+        s1 = _mm256_permutevar8x32_ps(r, i1);
+        s2 = _mm256_permutevar8x32_ps(r, i2);
+
+        _mm_storeu_ps(_y + i, _mm256_castps256_ps128(r));
+    }
+
+    _v[0] = _mm256_cvtss_f32(s1);
+    _v[1] = _mm256_cvtss_f32(s2);
+    return i;
+}
+
+// run second-order section over blocks of two complex samples;
+// register holds {y[0], y[1], w[1], w[0]} as complex pairs
+__attribute__((target("avx2,fma")))
+unsigned int iirfilt_crcf_sos_block_avx2(float *         _t,
+                                         float complex * _v,
+                                         float complex * _x,
+                                         unsigned int    _n,
+                                         float complex * _y)
+{
+    const __m256i i1 = _mm256_setr_epi32(4,5,4,5,4,5,4,5);
+    const __m256i i2 = _mm256_setr_epi32(6,7,6,7,6,7,6,7);
+    __m256 c0 = _mm256_loadu_ps(_t +  0);
+    __m256 c1 = _mm256_loadu_ps(_t +  8);
+    __m256 c2 = _mm256_loadu_ps(_t + 16);
+    __m256 c3 = _mm256_loadu_ps(_t + 24);
+
+    __m256 s1 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)(_v + 0)));
+    __m256 s2 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)(_v + 1)));
+    __m256 r;
+
+    unsigned int i;
+    for (i=0; i+2 <= _n; i+=2) {
+        __m256 x0 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)(_x + i + 0)));
+        __m256 x1 = _mm256_castpd_ps(_mm256_broadcast_sd((double*)(_x + i + 1)));
+        __m256 u  = _mm256_fmadd_ps(c1, x1, _mm256_mul_ps(c0, x0));
+
+        r  = _mm256_fmadd_ps(c2, s1, _mm256_fmadd_ps(c3, s2, u));
+        s1 = _mm256_permutevar8x32_ps(r, i1);
+        s2 = _mm256_permutevar8x32_ps(r, i2);
+
+        _mm_storeu_ps((float*)(_y + i), _mm256_castps256_ps128(r));
+    }
+
+    _mm_storel_pi((__m64*)(_v + 0), _mm256_castps256_ps128(s1));
+    _mm_storel_pi((__m64*)(_v + 1), _mm256_castps256_ps128(s2));
+    return i;
+}
+
+// accumulate output of parallel-form sections, eight at a time,
+// into _y; _np a multiple of 8
+__attribute__((target("avx2,fma")))
+void iirfilt_rrrf_parallel_avx2(float *      _c,
+                                float *      _w,
+                                unsigned int _np,
+                                float *      _x,
+                                unsigned int _n,
+                                float *      _y)
+{
+    unsigned int g, i;
+    for (g=0; g<_np; g+=8) {
+        __m256 b0 = _mm256_loadu_ps(_c +       g);
+        __m256 b1 = _mm256_loadu_ps(_c +   _np+g);
+        __m256 a1 = _mm256_loadu_ps(_c + 2*_np+g);
+        __m256 a2 = _mm256_loadu_ps(_c + 3*_np+g);
+        __m256 w1 = _mm256_loadu_ps(_w +       g);
+        __m256 w2 = _mm256_loadu_ps(_w +   _np+g);
+        for (i=0; i<_n; i++) {
+            __m256 x  = _mm256_broadcast_ss(_x + i);
+            __m256 w0 = _mm256_fnmadd_ps(a1, w1, _mm256_fnmadd_ps(a2, w2, x));
+            __m256 t  = _mm256_fmadd_ps(b0, w0, _mm256_mul_ps(b1, w1));
+            w2 = w1;
+            w1 = w0;
+
+            // horizontal sum
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(t), _mm256_extractf128_ps(t, 1));
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1,1,1,1)));
+            _y[i] += _mm_cvtss_f32(s);
+        }
+        _mm256_storeu_ps(_w +     g, w1);
+        _mm256_storeu_ps(_w + _np+g, w2);
+    }
+}
+
+// accumulate output of parallel-form sections, four at a time, into
+// _y; coefficients repeated for real and imaginary channels
+__attribute__((target("avx2,fma")))
+void iirfilt_crcf_parallel_avx2(float *         _c,
+                                float complex * _w,
+                                unsigned int    _np,
+                                float complex * _x,
+                                unsigned int    _n,
+                                float complex * _y)
+{
+    unsigned int g, i;
+    for (g=0; g<_np; g+=4) {
+        __m256 b0 = _mm256_loadu_ps(_c +       2*g);
+        __m256 b1 = _mm256_loadu_ps(_c + 2*_np+2*g);
+        __m256 a1 = _mm256_loadu_ps(_c + 4*_np+2*g);
+        __m256 a2 = _mm256_loadu_ps(_c + 6*_np+2*g);
+        __m256 w1 = _mm256_loadu_ps((float*)(_w +     g));
+        __m256 w2 = _mm256_loadu_ps((float*)(_w + _np+g));
+        for (i=0; i<_n; i++) {
+            __m256 x  = _mm256_castpd_ps(_mm256_broadcast_sd((double*)(_x + i)));
+            __m256 w0 = _mm256_fnmadd_ps(a1, w1, _mm256_fnmadd_ps(a2, w2, x));
+            __m256 t  = _mm256_fmadd_ps(b0, w0, _mm256_mul_ps(b1, w1));
+            w2 = w1;
+            w1 = w0;
+
+            // sum sections, accumulate complex output
+            __m128 s = _mm_add_ps(_mm256_castps256_ps128(t), _mm256_extractf128_ps(t, 1));
+            s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+            float * y = (float*)(_y + i);
+            _mm_storel_pi((__m64*)y, _mm_add_ps(s, _mm_loadl_pi(_mm_setzero_ps(), (__m64*)y)));
+        }
+        _mm256_storeu_ps((float*)(_w +     g), w1);
+        _mm256_storeu_ps((float*)(_w + _np+g), w2);
+    }
+}
+
+#endif // LIQUID_CPU_X86
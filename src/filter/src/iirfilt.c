@@ -30,6 +30,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <complex.h>
 
 // defined:
 //  IIRFILT()       name-mangling macro
@@ -43,10 +44,28 @@
 // use structured dot product? 0:no, 1:yes
 #define LIQUID_IIRFILT_USE_DOTPROD   (0)
 
+// run-time SIMD kernels are available for real coefficients on x86
+#define IIRFILT_USE_SIMD            (LIQUID_CPU_X86 && !TC_COMPLEX)
+
+// number of interleaved channels of each input sample seen by the
+// SIMD kernels (complex inputs are two independent real channels)
+#define IIRFILT_SIMD_CHANNELS       (TI_COMPLEX ? 2 : 1)
+
+// look-ahead coefficients per second-order section: 8 lanes for each
+// of the (4/channels) inputs and two state variables
+#define IIRFILT_SOS_BLOCK_LEN       (8*(4/IIRFILT_SIMD_CHANNELS + 2))
+
+// parallel-form sections are padded to a multiple of this value
+#define IIRFILT_PARALLEL_PAD        (8)
+
+// parallel-form input samples processed per SIMD kernel call
+#define IIRFILT_PARALLEL_CHUNK      (64)
+
 struct IIRFILT(_s) {
     TC * b;             // numerator (feed-forward coefficients)
     TC * a;             // denominator (feed-back coefficients)
     TI * v;             // internal filter state (buffer)
+    unsigned int v_len; // internal filter state length
     unsigned int n;     // filter length (order+1)
 
     unsigned int nb;    // numerator length
@@ -55,7 +74,8 @@ struct IIRFILT(_s) {
     // filter structure type
     enum {
         IIRFILT_TYPE_NORM=0,
-        IIRFILT_TYPE_SOS
+        IIRFILT_TYPE_SOS,
+        IIRFILT_TYPE_PARALLEL
     } type;
 
 #if LIQUID_IIRFILT_USE_DOTPROD
@@ -63,11 +83,47 @@ struct IIRFILT(_s) {
     DOTPROD() dpa;      // denominator dot product
 #endif
 
-    // second-order sections 
-    IIRFILTSOS() * qsos;    // second-order sections filters
+    // second-order sections; coefficients are held in b and a
+    // [size: 3 x nsos], normalized to a0 = 1, and the direct form II
+    // state of section i is v[2*i+0], v[2*i+1]
     unsigned int nsos;      // number of second-order sections
+    float * t;              // look-ahead block coefficients for SIMD
+                            // kernels [size: IIRFILT_SOS_BLOCK_LEN x nsos]
+
+    // parallel form: sum of sections (b0 + b1 z^-1)/(1 + a1 z^-1 + a2 z^-2)
+    // and a direct (FIR) path; state v holds w[n-1] [size: np], w[n-2]
+    // [size: np] and the input history [size: nd]
+    unsigned int npar;      // number of parallel sections
+    unsigned int np;        // number of sections, padded
+    TC * c;                 // section coefficients, rows b0, b1, a1, a2
+                            // [size: 4 x np]
+    float * cd;             // coefficients repeated for each channel
+                            // for SIMD kernels [size: 4 x np x channels]
+    TC * d;                 // direct path coefficients [size: nd x 1]
+    unsigned int nd;        // direct path length
+
+    liquid_simd_level simd; // SIMD kernels, chosen at run time
 };
 
+// allocate object and initialize common fields
+IIRFILT() IIRFILT(_alloc)(void)
+{
+    IIRFILT() q = (IIRFILT()) malloc(sizeof(struct IIRFILT(_s)));
+    q->b    = NULL;
+    q->a    = NULL;
+    q->v    = NULL;
+    q->t    = NULL;
+    q->c    = NULL;
+    q->cd   = NULL;
+    q->d    = NULL;
+    q->nsos = 0;
+    q->npar = 0;
+    q->np   = 0;
+    q->nd   = 0;
+    q->simd = liquid_cpu_get_simd_level();
+    return q;
+}
+
 // create iirfilt (infinite impulse response filter) object
 //  _b      :   numerator, feed-forward coefficients [size: _nb x 1]
 //  _nb     :   length of numerator
@@ -88,15 +144,15 @@ IIRFILT() IIRFILT(_create)(TC * _b,
     }
 
     // create structure and initialize
-    IIRFILT() q = (IIRFILT()) malloc(sizeof(struct IIRFILT(_s)));
+    IIRFILT() q = IIRFILT(_alloc)();
     q->nb = _nb;
     q->na = _na;
     q->n = (q->na > q->nb) ? q->na : q->nb;
     q->type = IIRFILT_TYPE_NORM;
 
     // allocate memory for numerator, denominator
-    q->b = (TC *) malloc((q->na)*sizeof(TC));
-    q->a = (TC *) malloc((q->nb)*sizeof(TC));
+    q->b = (TC *) malloc((q->nb)*sizeof(TC));
+    q->a = (TC *) malloc((q->na)*sizeof(TC));
 
     // normalize coefficients to _a[0]
     TC a0 = _a[0];
@@ -118,7 +174,8 @@ IIRFILT() IIRFILT(_create)(TC * _b,
 #endif
 
     // create buffer and initialize
-    q->v = (TI *) malloc((q->n)*sizeof(TI));
+    q->v_len = q->n;
+    q->v = (TI *) malloc((q->v_len)*sizeof(TI));
 
 #if LIQUID_IIRFILT_USE_DOTPROD
     q->dpa = DOTPROD(_create)(q->a+1, q->na-1);
@@ -127,11 +184,58 @@ IIRFILT() IIRFILT(_create)(TC * _b,
 
     // reset internal state
     IIRFILT(_clear)(q);
-    
+
     // return iirfilt object
     return q;
 }
 
+#if IIRFILT_USE_SIMD
+// compute look-ahead coefficients of a second-order section for a
+// block of L = 4/channels samples; with direct form II state w[-1],
+// w[-2], each output lane of the block is a linear combination of
+// the inputs x[0..L-1] and the state:
+//
+//   out = sum_j _t[8*j:8*j+7] * in[j],  in = {x[0], ..., x[L-1], w[-1], w[-2]}
+//   out = {y[0], ..., y[L-1], w[L-1], w[L-2]}
+//
+// with each value repeated for each channel; the outputs of the block
+// depend on the state only through two products, which allows the
+// samples of the block to be computed in parallel
+//  _b      :   feed-forward coefficients (normalized) [size: 3 x 1]
+//  _a      :   feed-back coefficients (normalized) [size: 3 x 1]
+//  _t      :   output coefficients [size: IIRFILT_SOS_BLOCK_LEN x 1]
+void IIRFILT(_sos_block_coefficients)(TC *    _b,
+                                      TC *    _a,
+                                      float * _t)
+{
+    unsigned int c = IIRFILT_SIMD_CHANNELS;
+    unsigned int L = 4 / c;
+    unsigned int i, j, k;
+    for (i=0; i<IIRFILT_SOS_BLOCK_LEN; i++)
+        _t[i] = 0.0f;
+
+    // response to each input in turn (impulse and initial conditions)
+    for (j=0; j<L+2; j++) {
+        float * col = _t + 8*j;
+        float w1 = (j == L)   ? 1.0f : 0.0f;
+        float w2 = (j == L+1) ? 1.0f : 0.0f;
+        for (k=0; k<L; k++) {
+            float x  = (j == k) ? 1.0f : 0.0f;
+            float w0 = x - _a[1]*w1 - _a[2]*w2;
+            float y  = _b[0]*w0 + _b[1]*w1 + _b[2]*w2;
+            w2 = w1;
+            w1 = w0;
+            for (i=0; i<c; i++)
+                col[c*k + i] = y;
+        }
+        for (i=0; i<c; i++) {
+            col[c*L     + i] = w1;
+            col[c*L + c + i] = w2;
+        }
+    }
+}
+#endif
+
 // create iirfilt (infinite impulse response filter) object based
 // on second-order sections form
 //  _B      :   numerator, feed-forward coefficients [size: _nsos x 3]
@@ -154,29 +258,194 @@ IIRFILT() IIRFILT(_create_sos)(TC * _B,
     }
 
     // create structure and initialize
-    IIRFILT() q = (IIRFILT()) malloc(sizeof(struct IIRFILT(_s)));
+    IIRFILT() q = IIRFILT(_alloc)();
     q->type = IIRFILT_TYPE_SOS;
     q->nsos = _nsos;
-    q->qsos = (IIRFILTSOS()*) malloc( (q->nsos)*sizeof(IIRFILTSOS()) );
     q->n = _nsos * 2;
 
-    // create coefficients array and copy over
+    // create coefficients array and copy over, normalizing each
+    // section to its a0 coefficient
     q->b = (TC *) malloc(3*(q->nsos)*sizeof(TC));
     q->a = (TC *) malloc(3*(q->nsos)*sizeof(TC));
-    memmove(q->b, _B, 3*(q->nsos)*sizeof(TC));
-    memmove(q->a, _A, 3*(q->nsos)*sizeof(TC));
-
-    TC at[3];
-    TC bt[3];
     unsigned int i,k;
     for (i=0; i<q->nsos; i++) {
+        TC a0 = _A[3*i+0];
         for (k=0; k<3; k++) {
-            at[k] = q->a[3*i+k];
-            bt[k] = q->b[3*i+k];
+            q->b[3*i+k] = _B[3*i+k] / a0;
+            q->a[3*i+k] = _A[3*i+k] / a0;
         }
-        q->qsos[i] = IIRFILTSOS(_create)(bt,at);
-        //q->qsos[i] = IIRFILT(_create)(q->b+3*i,3,q->a+3*i,3);
     }
+
+    // state of all sections is held in a single array
+    q->v_len = 2*q->nsos;
+    q->v = (TI *) malloc((q->v_len)*sizeof(TI));
+
+#if IIRFILT_USE_SIMD
+    // look-ahead coefficients for block execution
+    q->t = (float*) malloc(IIRFILT_SOS_BLOCK_LEN*(q->nsos)*sizeof(float));
+    for (i=0; i<q->nsos; i++)
+        IIRFILT(_sos_block_coefficients)(q->b+3*i, q->a+3*i, q->t + IIRFILT_SOS_BLOCK_LEN*i);
+#endif
+
+    IIRFILT(_clear)(q);
+    return q;
+}
+
+// create iirfilt object in parallel form from second-order sections
+// by partial-fraction expansion of the cascaded transfer function,
+//
+//   H(z) = sum_k d[k] z^-k + sum_i (b0_i + b1_i z^-1)/(1 + a1_i z^-1 + a2_i z^-2)
+//
+// where the poles of each cascaded section become a parallel section;
+// sections are independent, so they are evaluated side by side.  The
+// poles must be distinct (as they are for Butterworth, Chebyshev and
+// elliptic designs).
+//  _B      :   numerator, feed-forward coefficients [size: _nsos x 3]
+//  _A      :   denominator, feed-back coefficients [size: _nsos x 3]
+//  _nsos   :   number of second-order sections
+IIRFILT() IIRFILT(_create_parallel)(TC * _B,
+                                    TC * _A,
+                                    unsigned int _nsos)
+{
+    // validate input
+    if (_nsos == 0) {
+        fprintf(stderr,"error: iirfilt_%s_create_parallel(), filter must have at least one 2nd-order section\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create cascaded form to retain coefficients for frequency
+    // response and group delay computations
+    IIRFILT() q = IIRFILT(_create_sos)(_B, _A, _nsos);
+    q->type = IIRFILT_TYPE_PARALLEL;
+    free(q->t);
+    q->t = NULL;
+
+    // expand numerator (polynomial in z^-1) and compute poles
+    unsigned int i, j, k;
+    double complex N[2*_nsos+1];    // numerator
+    double complex p[2*_nsos];      // poles
+    unsigned int pn[_nsos];         // number of poles in each section
+    unsigned int nn = 0;            // numerator degree
+    unsigned int M  = 0;            // number of poles (denominator degree)
+    N[0] = 1.0;
+    for (i=0; i<_nsos; i++) {
+        TC * b = q->b + 3*i;
+        TC * a = q->a + 3*i;
+
+        // multiply numerator by section numerator
+        unsigned int nb = b[2] != 0 ? 2 : (b[1] != 0 ? 1 : 0);
+        double complex t[nn+nb+1];
+        for (j=0; j<nn+nb+1; j++)
+            t[j] = 0.0;
+        for (j=0; j<=nn; j++) {
+            for (k=0; k<=nb; k++)
+                t[j+k] += N[j] * (double complex)b[k];
+        }
+        nn += nb;
+        memmove(N, t, (nn+1)*sizeof(double complex));
+
+        // poles: 1 + a1 z^-1 + a2 z^-2 = (1 - p0 z^-1)(1 - p1 z^-1)
+        double complex a1 = a[1];
+        double complex a2 = a[2];
+        if (a2 != 0) {
+            double complex s = csqrt(a1*a1 - 4*a2);
+            double complex r = -0.5*(a1 + (creal(conj(a1)*s) >= 0 ? s : -s));
+            p[M++] = r;
+            p[M++] = a2 / r;
+            pn[i] = 2;
+        } else if (a1 != 0) {
+            p[M++] = -a1;
+            pn[i] = 1;
+        } else {
+            pn[i] = 0;
+        }
+    }
+
+    // validate poles are distinct
+    for (i=0; i<M; i++) {
+        for (j=i+1; j<M; j++) {
+            if (cabs(p[i] - p[j]) < 1e-6) {
+                fprintf(stderr,"error: iirfilt_%s_create_parallel(), filter poles must be distinct\n", EXTENSION_FULL);
+                exit(1);
+            }
+        }
+    }
+
+    // denominator D(z^-1) = prod(1 - p_i z^-1)
+    double complex D[M+1];
+    D[0] = 1.0;
+    for (i=0; i<M; i++) {
+        D[i+1] = 0.0;
+        for (j=i+1; j>0; j--)
+            D[j] -= p[i] * D[j-1];
+    }
+
+    // divide numerator by denominator: N = Qd*D + R, deg(R) < M
+    q->nd = nn >= M ? nn - M + 1 : 0;
+    double complex Qd[q->nd + 1];
+    for (k=q->nd; k>0; k--) {
+        double complex g = N[k-1+M] / D[M];
+        Qd[k-1] = g;
+        for (j=0; j<=M; j++)
+            N[k-1+j] -= g*D[j];
+    }
+
+    // residues: r_i = R(1/p_i) / prod_{j!=i}(1 - p_j/p_i)
+    double complex r[M];
+    for (i=0; i<M; i++) {
+        double complex u = 1.0 / p[i];
+        double complex Ru = 0.0;
+        for (j=M; j>0; j--)
+            Ru = Ru*u + N[j-1];
+        double complex g = 1.0;
+        for (j=0; j<M; j++)
+            g *= (j == i) ? 1.0 : 1.0 - p[j]*u;
+        r[i] = Ru / g;
+    }
+
+    // combine pole pairs of each cascaded section into one section
+    for (i=0; i<_nsos; i++)
+        q->npar += pn[i] > 0 ? 1 : 0;
+    q->np = IIRFILT_PARALLEL_PAD*((q->npar + IIRFILT_PARALLEL_PAD - 1)/IIRFILT_PARALLEL_PAD);
+    if (q->np == 0) q->np = IIRFILT_PARALLEL_PAD;
+    q->c = (TC*) malloc(4*(q->np)*sizeof(TC));
+    for (i=0; i<4*q->np; i++)
+        q->c[i] = 0;
+    for (i=0, j=0, k=0; i<_nsos; i++) {
+        if (pn[i] == 2) {
+            q->c[         k] = r[j] + r[j+1];
+            q->c[  q->np+k] = -(r[j]*p[j+1] + r[j+1]*p[j]);
+            q->c[2*q->np+k] = -(p[j] + p[j+1]);
+            q->c[3*q->np+k] = p[j]*p[j+1];
+        } else if (pn[i] == 1) {
+            q->c[         k] = r[j];
+            q->c[2*q->np+k] = -p[j];
+        } else {
+            continue;
+        }
+        j += pn[i];
+        k++;
+    }
+
+    // direct path
+    q->d = (TC*) malloc((q->nd > 0 ? q->nd : 1)*sizeof(TC));
+    for (i=0; i<q->nd; i++)
+        q->d[i] = Qd[i];
+
+#if IIRFILT_USE_SIMD && TI_COMPLEX
+    // repeat coefficients for real and imaginary channels
+    q->cd = (float*) malloc(8*(q->np)*sizeof(float));
+    for (i=0; i<4*q->np; i++) {
+        q->cd[2*i+0] = q->c[i];
+        q->cd[2*i+1] = q->c[i];
+    }
+#endif
+
+    // state: section delays and input history
+    free(q->v);
+    q->v_len = 2*q->np + q->nd;
+    q->v = (TI *) malloc((q->v_len)*sizeof(TI));
+    IIRFILT(_clear)(q);
     return q;
 }
 
@@ -350,9 +619,11 @@ IIRFILT() IIRFILT(_create_dc_blocker)(float _alpha)
     float af[2] = {1.0f, -1.0f + _alpha};
 
     // convert to type-specific array
-    TC b[2] = {(TC)bf[0], (TC)bf[1]};
-    TC a[2] = {(TC)af[0], (TC)af[1]};
-    return IIRFILT(_create)(b,2,a,2);
+    // convert to type-specific array, realized as a single
+    // (first-order) second-order section
+    TC b[3] = {(TC)bf[0], (TC)bf[1], 0};
+    TC a[3] = {(TC)af[0], (TC)af[1], 0};
+    return IIRFILT(_create_sos)(b,a,1);
 }
 
 // create phase-locked loop iirfilt object
@@ -394,34 +665,55 @@ IIRFILT() IIRFILT(_create_pll)(float _w,
 void IIRFILT(_destroy)(IIRFILT() _q)
 {
 #if LIQUID_IIRFILT_USE_DOTPROD
-    DOTPROD(_destroy)(_q->dpa);
-    DOTPROD(_destroy)(_q->dpb);
+    if (_q->type == IIRFILT_TYPE_NORM) {
+        DOTPROD(_destroy)(_q->dpa);
+        DOTPROD(_destroy)(_q->dpb);
+    }
 #endif
     free(_q->b);
     free(_q->a);
-    // if filter is comprised of cascaded second-order sections,
-    // delete sub-filters separately
-    if (_q->type == IIRFILT_TYPE_SOS) {
-        unsigned int i;
-        for (i=0; i<_q->nsos; i++)
-            IIRFILTSOS(_destroy)(_q->qsos[i]);
-        free(_q->qsos);
-    } else {
-        free(_q->v);
-    }
-
+    free(_q->v);
+    free(_q->t);
+    free(_q->c);
+    free(_q->cd);
+    free(_q->d);
     free(_q);
 }
 
 // print iirfilt object internals
 void IIRFILT(_print)(IIRFILT() _q)
 {
-    printf("iir filter [%s]:\n", _q->type == IIRFILT_TYPE_NORM ? "normal" : "sos");
+    const char * type[3] = {"normal", "sos", "parallel"};
+    printf("iir filter [%s]:\n", type[_q->type]);
     unsigned int i;
 
     if (_q->type == IIRFILT_TYPE_SOS) {
-        for (i=0; i<_q->nsos; i++)
-            IIRFILTSOS(_print)(_q->qsos[i]);
+        for (i=0; i<_q->nsos; i++) {
+            printf("  b : ");
+            PRINTVAL_TC(_q->b[3*i+0],%12.8f); printf(",");
+            PRINTVAL_TC(_q->b[3*i+1],%12.8f); printf(",");
+            PRINTVAL_TC(_q->b[3*i+2],%12.8f); printf("\n");
+
+            printf("  a : ");
+            PRINTVAL_TC(_q->a[3*i+0],%12.8f); printf(",");
+            PRINTVAL_TC(_q->a[3*i+1],%12.8f); printf(",");
+            PRINTVAL_TC(_q->a[3*i+2],%12.8f); printf("\n");
+        }
+    } else if (_q->type == IIRFILT_TYPE_PARALLEL) {
+        printf("  d :");
+        for (i=0; i<_q->nd; i++)
+            PRINTVAL_TC(_q->d[i],%12.8f);
+        printf("\n");
+        for (i=0; i<_q->npar; i++) {
+            printf("  b : ");
+            PRINTVAL_TC(_q->c[         i],%12.8f); printf(",");
+            PRINTVAL_TC(_q->c[  _q->np+i],%12.8f); printf("\n");
+
+            printf("  a : ");
+            PRINTVAL_TC(1.0f,                %12.8f); printf(",");
+            PRINTVAL_TC(_q->c[2*_q->np+i],%12.8f); printf(",");
+            PRINTVAL_TC(_q->c[3*_q->np+i],%12.8f); printf("\n");
+        }
     } else {
 
         printf("  b :");
@@ -446,18 +738,10 @@ void IIRFILT(_print)(IIRFILT() _q)
 // clear
 void IIRFILT(_clear)(IIRFILT() _q)
 {
+    // set internal buffer to zero
     unsigned int i;
-
-    if (_q->type == IIRFILT_TYPE_SOS) {
-        // clear second-order sections
-        for (i=0; i<_q->nsos; i++) {
-            IIRFILTSOS(_clear)(_q->qsos[i]);
-        }
-    } else {
-        // set internal buffer to zero
-        for (i=0; i<_q->n; i++)
-            _q->v[i] = 0;
-    }
+    for (i=0; i<_q->v_len; i++)
+        _q->v[i] = 0;
 }
 
 // execute normal iir filter using traditional numerator/denominator
@@ -510,16 +794,53 @@ void IIRFILT(_execute_sos)(IIRFILT() _q,
                            TO *_y)
 {
     TI t0 = _x;     // intermediate input
-    TO t1 = 0.;     // intermediate output
     unsigned int i;
     for (i=0; i<_q->nsos; i++) {
-        // run each filter separately
-        IIRFILTSOS(_execute)(_q->qsos[i], t0, &t1);
+        // direct form II, output for section n becomes
+        // input to section n+1
+        TC * b = _q->b + 3*i;
+        TC * a = _q->a + 3*i;
+        TI * v = _q->v + 2*i;
+        TI v0 = t0 - a[1]*v[0] - a[2]*v[1];
+        t0 = b[0]*v0 + b[1]*v[0] + b[2]*v[1];
+        v[1] = v[0];
+        v[0] = v0;
+    }
+    *_y = t0;
+}
 
-        // output for filter n becomes input to filter n+1
-        t0 = t1;
+// execute iir filter using parallel form
+//  _q      :   iirfilt object
+//  _x      :   input sample
+//  _y      :   output sample
+void IIRFILT(_execute_parallel)(IIRFILT() _q,
+                                TI _x,
+                                TO *_y)
+{
+    unsigned int i;
+    unsigned int np = _q->np;
+    TI * w1 = _q->v;
+    TI * w2 = _q->v + np;
+    TI * xh = _q->v + 2*np;
+
+    // direct path
+    TO y0 = 0;
+    if (_q->nd > 0) {
+        for (i=_q->nd-1; i>0; i--)
+            xh[i] = xh[i-1];
+        xh[0] = _x;
+        for (i=0; i<_q->nd; i++)
+            y0 += _q->d[i] * xh[i];
     }
-    *_y = t1;
+
+    // sum of sections (direct form II)
+    for (i=0; i<_q->npar; i++) {
+        TI w0 = _x - _q->c[2*np+i]*w1[i] - _q->c[3*np+i]*w2[i];
+        y0 += _q->c[i]*w0 + _q->c[np+i]*w1[i];
+        w2[i] = w1[i];
+        w1[i] = w0;
+    }
+    *_y = y0;
 }
 
 // execute iir filter, switching to type-specific function
@@ -532,8 +853,133 @@ void IIRFILT(_execute)(IIRFILT() _q,
 {
     if (_q->type == IIRFILT_TYPE_NORM)
         IIRFILT(_execute_norm)(_q,_x,_y);
-    else
+    else if (_q->type == IIRFILT_TYPE_SOS)
         IIRFILT(_execute_sos)(_q,_x,_y);
+    else
+        IIRFILT(_execute_parallel)(_q,_x,_y);
+}
+
+// execute second-order sections on block of samples; each section
+// runs over the entire block before the next
+void IIRFILT(_execute_block_sos)(IIRFILT()    _q,
+                                 TI *         _x,
+                                 unsigned int _n,
+                                 TO *         _y)
+{
+    unsigned int i, k;
+    for (i=0; i<_q->nsos; i++) {
+        TC * b = _q->b + 3*i;
+        TC * a = _q->a + 3*i;
+        TI * v = _q->v + 2*i;
+        TI * x = (i == 0) ? _x : _y;
+
+        k = 0;
+#if IIRFILT_USE_SIMD
+        float * t = _q->t + IIRFILT_SOS_BLOCK_LEN*i;
+#  if TI_COMPLEX
+        if (_q->simd >= LIQUID_SIMD_AVX2)
+            k = iirfilt_crcf_sos_block_avx2(t, v, x, _n, _y);
+        else if (_q->simd == LIQUID_SIMD_SSE)
+            k = iirfilt_crcf_sos_block_sse(t, v, x, _n, _y);
+#  else
+        if (_q->simd >= LIQUID_SIMD_AVX2)
+            k = iirfilt_rrrf_sos_block_avx2(t, v, x, _n, _y);
+        else if (_q->simd == LIQUID_SIMD_SSE)
+            k = iirfilt_rrrf_sos_block_sse(t, v, x, _n, _y);
+#  endif
+#endif
+
+        // direct form II for remaining samples
+        TI v1 = v[0];
+        TI v2 = v[1];
+        for ( ; k<_n; k++) {
+            TI v0 = x[k] - a[1]*v1 - a[2]*v2;
+            _y[k] = b[0]*v0 + b[1]*v1 + b[2]*v2;
+            v2 = v1;
+            v1 = v0;
+        }
+        v[0] = v1;
+        v[1] = v2;
+    }
+}
+
+// execute parallel-form sections on block of samples
+void IIRFILT(_execute_block_parallel)(IIRFILT()    _q,
+                                      TI *         _x,
+                                      unsigned int _n,
+                                      TO *         _y)
+{
+#if IIRFILT_USE_SIMD
+    if (_q->simd >= LIQUID_SIMD_SSE) {
+        unsigned int i, k, n;
+        TI * xh = _q->v + 2*_q->np;
+        TI xc[IIRFILT_PARALLEL_CHUNK];
+        for (k=0; k<_n; k+=n) {
+            n = _n - k < IIRFILT_PARALLEL_CHUNK ? _n - k : IIRFILT_PARALLEL_CHUNK;
+
+            // retain copy of input, as output may overwrite it,
+            // and compute direct path
+            memmove(xc, _x + k, n*sizeof(TI));
+            for (i=0; i<n; i++) {
+                TO y0 = 0;
+                if (_q->nd > 0) {
+                    unsigned int j;
+                    for (j=_q->nd-1; j>0; j--)
+                        xh[j] = xh[j-1];
+                    xh[0] = xc[i];
+                    for (j=0; j<_q->nd; j++)
+                        y0 += _q->d[j] * xh[j];
+                }
+                _y[k+i] = y0;
+            }
+
+            // accumulate output of all sections
+#  if TI_COMPLEX
+            if (_q->simd >= LIQUID_SIMD_AVX2)
+                iirfilt_crcf_parallel_avx2(_q->cd, _q->v, _q->np, xc, n, _y + k);
+            else
+                iirfilt_crcf_parallel_sse(_q->cd, _q->v, _q->np, xc, n, _y + k);
+#  else
+            if (_q->simd >= LIQUID_SIMD_AVX2)
+                iirfilt_rrrf_parallel_avx2(_q->c, _q->v, _q->np, xc, n, _y + k);
+            else
+                iirfilt_rrrf_parallel_sse(_q->c, _q->v, _q->np, xc, n, _y + k);
+#  endif
+        }
+        return;
+    }
+#endif
+
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        IIRFILT(_execute_parallel)(_q, _x[i], &_y[i]);
+}
+
+// execute iir filter on block of input samples; second-order
+// sections are computed one at a time over the whole block
+// (several samples at once on hosts with SIMD extensions), and
+// parallel-form sections are computed side by side
+//  _q      :   iirfilt object
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of input, output samples
+//  _y      :   output array [size: _n x 1], may be the same as _x
+void IIRFILT(_execute_block)(IIRFILT()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int i;
+    switch (_q->type) {
+    case IIRFILT_TYPE_SOS:
+        IIRFILT(_execute_block_sos)(_q, _x, _n, _y);
+        break;
+    case IIRFILT_TYPE_PARALLEL:
+        IIRFILT(_execute_block_parallel)(_q, _x, _n, _y);
+        break;
+    default:
+        for (i=0; i<_n; i++)
+            IIRFILT(_execute_norm)(_q, _x[i], &_y[i]);
+    }
 }
 
 // get filter length (order + 1)
@@ -608,9 +1054,18 @@ float IIRFILT(_groupdelay)(IIRFILT() _q,
         for (i=0; i<_q->na; i++) a[i] = crealf(_q->a[i]);
         groupdelay = iir_group_delay(b, _q->nb, a, _q->na, _fc);
     } else {
-        // accumulate group delay from second-order sections
-        for (i=0; i<_q->nsos; i++)
-            groupdelay += IIRFILTSOS(_groupdelay)(_q->qsos[i], _fc) - 2;
+        // accumulate group delay from second-order sections (also
+        // retained by parallel-form filters)
+        for (i=0; i<_q->nsos; i++) {
+            float b[3];
+            float a[3];
+            unsigned int k;
+            for (k=0; k<3; k++) {
+                b[k] = crealf(_q->b[3*i+k]);
+                a[k] = crealf(_q->a[3*i+k]);
+            }
+            groupdelay += iir_group_delay(b, 3, a, 3, _fc);
+        }
     }
 
     return groupdelay;
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// iirfilt.mmx.c : infinite impulse response filter kernels (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// run second-order section over blocks of four samples using its
+// look-ahead coefficients (see iirfilt_rrrf_create_sos()); returns
+// number of samples processed
+__attribute__((target("sse2")))
+unsigned int iirfilt_rrrf_sos_block_sse(float *      _t,
+                                        float *      _v,
+                                        float *      _x,
+                                        unsigned int _n,
+                                        float *      _y)
+{
+    // state {w[-1], w[-2], 0, 0}
+    __m128 s  = _mm_setr_ps(_v[0], _v[1], 0.0f, 0.0f);
+
+    unsigned int i;
+    for (i=0; i+4 <= _n; i+=4) {
+        __m128 x0 = _mm_set1_ps(_x[i+0]);
+        __m128 x1 = _mm_set1_ps(_x[i+1]);
+        __m128 x2 = _mm_set1_ps(_x[i+2]);
+        __m128 x3 = _mm_set1_ps(_x[i+3]);
+
+        // input contribution to outputs and state
+        __m128 y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+ 0), x0),
+                                         _mm_mul_ps(_mm_loadu_ps(_t+ 8), x1)),
+                              _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+16), x2),
+                                         _mm_mul_ps(_mm_loadu_ps(_t+24), x3)));
+        __m128 w = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+ 4), x0),
+                                         _mm_mul_ps(_mm_loadu_ps(_t+12), x1)),
+                              _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+20), x2),
+                                         _mm_mul_ps(_mm_loadu_ps(_t+28), x3)));
+
+        // state contribution
+        __m128 s1 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(0,0,0,0));
+        __m128 s2 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(1,1,1,1));
+        y = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+32), s1),
+                                     _mm_mul_ps(_mm_loadu_ps(_t+40), s2)));
+        s = _mm_add_ps(w, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+36), s1),
+                                     _mm_mul_ps(_mm_loadu_ps(_t+44), s2)));
+
+        _mm_storeu_ps(_y + i, y);
+    }
+
+    float v[4];
+    _mm_storeu_ps(v, s);
+    _v[0] = v[0];
+    _v[1] = v[1];
+    return i;
+}
+
+// run second-order section over blocks of two complex samples; real
+// and imaginary components are filtered as separate channels
+__attribute__((target("sse2")))
+unsigned int iirfilt_crcf_sos_block_sse(float *         _t,
+                                        float complex * _v,
+                                        float complex * _x,
+                                        unsigned int    _n,
+                                        float complex * _y)
+{
+    // state {w[-1], w[-2]}
+    __m128 s = _mm_loadu_ps((float*)_v);
+
+    unsigned int i;
+    for (i=0; i+2 <= _n; i+=2) {
+        __m128 x0 = _mm_castpd_ps(_mm_load1_pd((double*)(_x + i + 0)));
+        __m128 x1 = _mm_castpd_ps(_mm_load1_pd((double*)(_x + i + 1)));
+
+        // input contribution to outputs and state
+        __m128 y = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+ 0), x0),
+                              _mm_mul_ps(_mm_loadu_ps(_t+ 8), x1));
+        __m128 w = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+ 4), x0),
+                              _mm_mul_ps(_mm_loadu_ps(_t+12), x1));
+
+        // state contribution
+        __m128 s1 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(1,0,1,0));
+        __m128 s2 = _mm_shuffle_ps(s, s, _MM_SHUFFLE(3,2,3,2));
+        y = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+16), s1),
+                                     _mm_mul_ps(_mm_loadu_ps(_t+24), s2)));
+        s = _mm_add_ps(w, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(_t+20), s1),
+                                     _mm_mul_ps(_mm_loadu_ps(_t+28), s2)));
+
+        _mm_storeu_ps((float*)(_y + i), y);
+    }
+
+    _mm_storeu_ps((float*)_v, s);
+    return i;
+}
+
+// accumulate output of parallel-form sections, four at a time, into
+// _y; coefficient rows b0, b1, a1, a2 [size: 4 x _np] and state rows
+// w[n-1], w[n-2] [size: 2 x _np], _np a multiple of 4
+__attribute__((target("sse2")))
+void iirfilt_rrrf_parallel_sse(float *      _c,
+                               float *      _w,
+                               unsigned int _np,
+                               float *      _x,
+                               unsigned int _n,
+                               float *      _y)
+{
+    unsigned int g, i;
+    for (g=0; g<_np; g+=4) {
+        __m128 b0 = _mm_loadu_ps(_c +       g);
+        __m128 b1 = _mm_loadu_ps(_c +   _np+g);
+        __m128 a1 = _mm_loadu_ps(_c + 2*_np+g);
+        __m128 a2 = _mm_loadu_ps(_c + 3*_np+g);
+        __m128 w1 = _mm_loadu_ps(_w +       g);
+        __m128 w2 = _mm_loadu_ps(_w +   _np+g);
+        for (i=0; i<_n; i++) {
+            __m128 x  = _mm_set1_ps(_x[i]);
+            __m128 w0 = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(a2, w2)), _mm_mul_ps(a1, w1));
+            __m128 t  = _mm_add_ps(_mm_mul_ps(b0, w0), _mm_mul_ps(b1, w1));
+            w2 = w1;
+            w1 = w0;
+
+            // horizontal sum
+            t = _mm_add_ps(t, _mm_movehl_ps(t, t));
+            t = _mm_add_ss(t, _mm_shuffle_ps(t, t, _MM_SHUFFLE(1,1,1,1)));
+            _y[i] += _mm_cvtss_f32(t);
+        }
+        _mm_storeu_ps(_w +     g, w1);
+        _mm_storeu_ps(_w + _np+g, w2);
+    }
+}
+
+// accumulate output of parallel-form sections, two at a time, into
+// _y; coefficients repeated for real and imaginary channels
+// [size: 4 x 2*_np] and state rows w[n-1], w[n-2] [size: 2 x _np]
+__attribute__((target("sse2")))
+void iirfilt_crcf_parallel_sse(float *         _c,
+                               float complex * _w,
+                               unsigned int    _np,
+                               float complex * _x,
+                               unsigned int    _n,
+                               float complex * _y)
+{
+    unsigned int g, i;
+    for (g=0; g<_np; g+=2) {
+        __m128 b0 = _mm_loadu_ps(_c +       2*g);
+        __m128 b1 = _mm_loadu_ps(_c + 2*_np+2*g);
+        __m128 a1 = _mm_loadu_ps(_c + 4*_np+2*g);
+        __m128 a2 = _mm_loadu_ps(_c + 6*_np+2*g);
+        __m128 w1 = _mm_loadu_ps((float*)(_w +     g));
+        __m128 w2 = _mm_loadu_ps((float*)(_w + _np+g));
+        for (i=0; i<_n; i++) {
+            __m128 x  = _mm_castpd_ps(_mm_load1_pd((double*)(_x + i)));
+            __m128 w0 = _mm_sub_ps(_mm_sub_ps(x, _mm_mul_ps(a2, w2)), _mm_mul_ps(a1, w1));
+            __m128 t  = _mm_add_ps(_mm_mul_ps(b0, w0), _mm_mul_ps(b1, w1));
+            w2 = w1;
+            w1 = w0;
+
+            // sum sections, accumulate complex output
+            t = _mm_add_ps(t, _mm_movehl_ps(t, t));
+            float * y = (float*)(_y + i);
+            _mm_storel_pi((__m64*)y, _mm_add_ps(t, _mm_loadl_pi(_mm_setzero_ps(), (__m64*)y)));
+        }
+        _mm_storeu_ps((float*)(_w +     g), w1);
+        _mm_storeu_ps((float*)(_w + _np+g), w2);
+    }
+}
+
+#endif // LIQUID_CPU_X86
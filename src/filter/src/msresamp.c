@@ -46,6 +46,10 @@ void MSRESAMP(_decim_execute)(MSRESAMP()     _q,
                               TO *           _y,
                               unsigned int * _num_written);
 
+// number of input samples (interpolator) or output samples of the
+// half-band stages (decimator) processed by each pass of the stages
+#define MSRESAMP_BLOCK_LEN  (64)
+
 
 struct MSRESAMP(_s) {
     // user-defined parameters
@@ -65,7 +69,8 @@ struct MSRESAMP(_s) {
     RESAMP() arbitrary_resamp;          // arbitrary resampling object
     float rate_arbitrary;               // clean-up resampling rate, in (0.5, 2.0)
 
-    // internal buffers (ping-pong)
+    // internal buffers (ping-pong), each stage running over an
+    // entire block at once
     unsigned int buffer_len;            // length of each buffer
     T * buffer0;                        // buffer[0]
     T * buffer1;                        // buffer[1]
@@ -119,8 +124,14 @@ MSRESAMP() MSRESAMP(_create)(float _r,
         default:;
     }
 
-    // allocate memory for buffers
-    q->buffer_len = 1<<q->num_halfband_stages;
+    // allocate memory for buffers: the decimator accumulates up to
+    // MSRESAMP_BLOCK_LEN frames of 2^num_halfband_stages input samples;
+    // the interpolator's arbitrary resampler (rate at most 2) produces
+    // at most 2*MSRESAMP_BLOCK_LEN+1 samples from each block of input
+    if (q->halfband_type == MSRESAMP_HALFBAND_DECIM)
+        q->buffer_len = MSRESAMP_BLOCK_LEN << q->num_halfband_stages;
+    else
+        q->buffer_len = (2*MSRESAMP_BLOCK_LEN+2) << q->num_halfband_stages;
     q->buffer0 = (T*) malloc( q->buffer_len*sizeof(T) );
     q->buffer1 = (T*) malloc( q->buffer_len*sizeof(T) );
 
@@ -282,6 +293,22 @@ void MSRESAMP(_execute)(MSRESAMP()     _q,
                         unsigned int   _nx,
                         TO *           _y,
                         unsigned int * _ny)
+{
+    MSRESAMP(_execute_block)(_q, _x, _nx, _y, _ny);
+}
+
+// execute multi-stage resampler on a block of samples, running each
+// stage over (up to) MSRESAMP_BLOCK_LEN samples at a time
+//  _q      :   msresamp object
+//  _x      :   input sample array
+//  _nx     :   input sample array size
+//  _y      :   output sample array
+//  _ny     :   number of samples written to _y
+void MSRESAMP(_execute_block)(MSRESAMP()     _q,
+                              TI *           _x,
+                              unsigned int   _nx,
+                              TO *           _y,
+                              unsigned int * _ny)
 {
     switch(_q->halfband_type) {
     case MSRESAMP_HALFBAND_INTERP:
@@ -309,58 +336,42 @@ void MSRESAMP(_interp_execute)(MSRESAMP()     _q,
                                TO *           _y,
                                unsigned int * _ny)
 {
-    // set output size to zero
-    *_ny = 0;
-    
     unsigned int k;     // number of inputs for this stage
-    unsigned int s;     // half-band decimator stage counter
-    unsigned int n;     // input counter
-    //unsigned int g;     // half-band resampler stage index (reversed)
+    unsigned int s;     // half-band interpolator stage counter
+    unsigned int i;
 
-    // buffer pointers (initialize BOTH to _q->buffer0);
-    T * b0 = _q->buffer0;   // input buffer pointer
-    T * b1 = _q->buffer0;   // output buffer pointer
-    
-    unsigned int nw;
-    unsigned int nw_total=0;
+    // buffer pointers
+    T * b0;             // input buffer pointer
+    T * b1;             // output buffer pointer
 
-    unsigned int j;     // 
-    T resamp_buffer[4]; // arbitrary resampling buffer
+    unsigned int nw_total=0;
+    while (_nx > 0) {
+        unsigned int n = _nx < MSRESAMP_BLOCK_LEN ? _nx : MSRESAMP_BLOCK_LEN;
+
+        // scale input and execute arbitrary resampler
+        for (i=0; i<n; i++)
+            _q->buffer1[i] = _x[i]*_q->zeta;
+        RESAMP(_execute_block)(_q->arbitrary_resamp, _q->buffer1, n, _q->buffer0, &k);
+
+        // run half-band interpolation stages; length doubles with
+        // each stage
+        b1 = _q->buffer0;
+        for (s=0; s<_q->num_halfband_stages; s++) {
+            // set buffer pointers
+            b0 = (s%2) == 0 ? _q->buffer0 : _q->buffer1;    // input buffer
+            b1 = (s%2) == 1 ? _q->buffer0 : _q->buffer1;    // output buffer
+
+            // execute half-band interpolator
+            RESAMP2(_interp_execute_block)(_q->halfband_resamp[s], b0, k, b1);
+            k <<= 1;
+        }
 
-    // write samples to buffer until full
-    unsigned int i;
-    for (i=0; i<_nx; i++) {
-        // execute arbitrary resampler
-        RESAMP(_execute)(_q->arbitrary_resamp, _x[i]*_q->zeta, resamp_buffer, &nw);
-
-        // check if buffer is full
-        for (j=0; j<nw; j++) {
-            // set initial buffer value
-            _q->buffer0[0] = resamp_buffer[j];
-    
-            // number of inputs for this stage
-            k = 1;
-
-            // run half-band decimation stage
-            for (s=0; s<_q->num_halfband_stages; s++) {
-                // set buffer pointers
-                b0 = (s%2) == 0 ? _q->buffer0 : _q->buffer1;    // input buffer
-                b1 = (s%2) == 1 ? _q->buffer0 : _q->buffer1;    // output buffer
-
-                // execute half-band interpolator
-                //g = _q->num_halfband_stages - s - 1;
-                for (n=0; n<k; n++)
-                    RESAMP2(_interp_execute)(_q->halfband_resamp[s], b0[n], &b1[2*n]);
-
-                // length doubles with each iteration
-                k <<= 1;
-            }
+        // copy output data and increment counter
+        memmove(&_y[nw_total], b1, k*sizeof(TO));
+        nw_total += k;
 
-            // copy output data and increment counter
-            // NOTE : k = 2^(num_halfband_stages)
-            memmove(&_y[nw_total], b1, k*sizeof(TO));
-            nw_total += k;
-        }
+        _x  += n;
+        _nx -= n;
     }
 
     *_ny = nw_total;
@@ -377,56 +388,58 @@ void MSRESAMP(_decim_execute)(MSRESAMP()     _q,
                               TO *           _y,
                               unsigned int * _ny)
 {
-    // set output size to zero
-    *_ny = 0;
-    
     unsigned int k;     // number of inputs for this stage
     unsigned int s;     // half-band decimator stage counter
-    unsigned int n;     // input counter
     unsigned int g;     // half-band resampler stage index (reversed)
+    unsigned int i;
 
-    // buffer pointers (initialize BOTH to _q->buffer0);
-    T * b0 = _q->buffer0;   // input buffer pointer
-    T * b1 = _q->buffer0;   // output buffer pointer
-    
-    unsigned int nw;    // 
+    // buffer pointers
+    T * b0;             // input buffer pointer
+    T * b1;             // output buffer pointer
+
+    unsigned int frame_len = 1 << _q->num_halfband_stages;
+    unsigned int nw;
     unsigned int nw_total=0;
+    while (_nx > 0) {
+        // write samples to buffer until full
+        unsigned int n = _q->buffer_len - _q->buffer_index;
+        if (n > _nx) n = _nx;
+        memmove(&_q->buffer0[_q->buffer_index], _x, n*sizeof(TI));
+        _q->buffer_index += n;
+        _x  += n;
+        _nx -= n;
+
+        // number of complete frames in buffer
+        unsigned int num_frames = _q->buffer_index / frame_len;
+        if (num_frames == 0)
+            break;
 
-    // write samples to buffer until full
-    unsigned int i;
-    for (i=0; i<_nx; i++) {
-        // push sample into buffer
-        _q->buffer0[_q->buffer_index++] = _x[i];
-
-        // check if buffer is full
-        if (_q->buffer_index == _q->buffer_len) {
-            // reset counter and run half-band decimators
-            _q->buffer_index = 0;
-    
-            // number of inputs for this stage
-            k = 1 << _q->num_halfband_stages;
-
-            // run half-band decimation stage
-            for (s=0; s<_q->num_halfband_stages; s++) {
-                // length halves with each iteration
-                k >>= 1;
-
-                // set buffer pointers
-                b0 = (s%2) == 0 ? _q->buffer0 : _q->buffer1;    // input buffer
-                b1 = (s%2) == 1 ? _q->buffer0 : _q->buffer1;    // output buffer
-
-                // execute half-band decimator
-                g = _q->num_halfband_stages - s - 1;
-                for (n=0; n<k; n++)
-                    RESAMP2(_decim_execute)(_q->halfband_resamp[g], &b0[2*n], &b1[n]);
-            }
+        // run half-band decimation stages; length halves with each stage
+        k  = num_frames * frame_len;
+        b1 = _q->buffer0;
+        for (s=0; s<_q->num_halfband_stages; s++) {
+            k >>= 1;
 
-            // execute arbitrary resampler
-            RESAMP(_execute)(_q->arbitrary_resamp, b1[0]*_q->zeta, &_y[nw_total], &nw);
-            nw_total += nw;
+            // set buffer pointers
+            b0 = (s%2) == 0 ? _q->buffer0 : _q->buffer1;    // input buffer
+            b1 = (s%2) == 1 ? _q->buffer0 : _q->buffer1;    // output buffer
+
+            // execute half-band decimator
+            g = _q->num_halfband_stages - s - 1;
+            RESAMP2(_decim_execute_block)(_q->halfband_resamp[g], b0, k, b1);
         }
+
+        // scale and execute arbitrary resampler
+        for (i=0; i<num_frames; i++)
+            b1[i] *= _q->zeta;
+        RESAMP(_execute_block)(_q->arbitrary_resamp, b1, num_frames, &_y[nw_total], &nw);
+        nw_total += nw;
+
+        // move incomplete frame to front of buffer
+        unsigned int r = _q->buffer_index - num_frames*frame_len;
+        memmove(_q->buffer0, &_q->buffer0[num_frames*frame_len], r*sizeof(TI));
+        _q->buffer_index = r;
     }
 
     *_ny = nw_total;
 }
-
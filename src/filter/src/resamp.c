@@ -31,11 +31,14 @@
 //  TC          coefficient data type
 //  TI          input data type
 //  RESAMP()    name-mangling macro
-//  FIRPFB()    firpfb macro
+//  DOTPROD()   dotprod macro
 
 // enable run-time debug printing of resampler
 #define DEBUG_RESAMP_PRINT              0
 
+// number of input samples held in buffer before it is shifted
+#define RESAMP_BUFFER_LEN               (1024)
+
 // internal: update timing
 void RESAMP(_update_timing_state)(RESAMP() _q);
 
@@ -59,7 +62,14 @@ struct RESAMP(_s) {
 
     // polyphase filterbank properties/object
     unsigned int npfb;  // number of filters in the bank
-    FIRPFB() f;         // filterbank object (interpolator)
+    unsigned int h_sub_len; // length of each filter in the bank
+    DOTPROD() * dp;     // filterbank dot products [size: npfb x 1]
+
+    // linear input buffer; each filter reads the h_sub_len samples
+    // preceding buffer_index
+    TI * buffer;                // input buffer
+    unsigned int buffer_len;    // buffer length
+    unsigned int buffer_index;  // index following most recent sample
 
     enum {
         STATE_BOUNDARY, // boundary between input samples
@@ -126,7 +136,22 @@ RESAMP() RESAMP(_create)(float        _rate,
     // copy to type-specific array, applying gain
     for (i=0; i<n; i++)
         h[i] = hf[i]*gain;
-    q->f = FIRPFB(_create)(q->npfb,h,n-1);
+
+    // generate bank of sub-sampled filters, each realized as a dot
+    // product with coefficients loaded in reverse order
+    q->h_sub_len = 2*q->m;
+    q->dp = (DOTPROD()*) malloc((q->npfb)*sizeof(DOTPROD()));
+    TC h_sub[q->h_sub_len];
+    unsigned int j;
+    for (i=0; i<q->npfb; i++) {
+        for (j=0; j<q->h_sub_len; j++)
+            h_sub[q->h_sub_len-j-1] = h[i + j*q->npfb];
+        q->dp[i] = DOTPROD(_create)(h_sub, q->h_sub_len);
+    }
+
+    // allocate input buffer
+    q->buffer_len = q->h_sub_len + RESAMP_BUFFER_LEN;
+    q->buffer     = (TI*) malloc((q->buffer_len)*sizeof(TI));
 
     // reset object and return
     RESAMP(_reset)(q);
@@ -137,7 +162,13 @@ RESAMP() RESAMP(_create)(float        _rate,
 void RESAMP(_destroy)(RESAMP() _q)
 {
     // free polyphase filterbank
-    FIRPFB(_destroy)(_q->f);
+    unsigned int i;
+    for (i=0; i<_q->npfb; i++)
+        DOTPROD(_destroy)(_q->dp[i]);
+    free(_q->dp);
+
+    // free input buffer
+    free(_q->buffer);
 
     // free main object memory
     free(_q);
@@ -147,14 +178,20 @@ void RESAMP(_destroy)(RESAMP() _q)
 void RESAMP(_print)(RESAMP() _q)
 {
     printf("resampler [rate: %f]\n", _q->rate);
-    FIRPFB(_print)(_q->f);
+    printf("    filter semi-length  :   %u\n", _q->m);
+    printf("    filter cutoff       :   %f\n", _q->fc);
+    printf("    stop-band atten.    :   %f dB\n", _q->As);
+    printf("    filters in bank     :   %u\n", _q->npfb);
 }
 
 // reset resampler object
 void RESAMP(_reset)(RESAMP() _q)
 {
-    // clear filterbank
-    FIRPFB(_clear)(_q->f);
+    // clear input buffer
+    unsigned int i;
+    for (i=0; i<_q->buffer_len; i++)
+        _q->buffer[i] = 0;
+    _q->buffer_index = _q->h_sub_len;
 
     // reset states
     _q->state = STATE_INTERP;   // input/output sample state
@@ -200,67 +237,95 @@ void RESAMP(_execute)(RESAMP()       _q,
                       TO *           _y,
                       unsigned int * _num_written)
 {
-    // push input sample into filterbank
-    FIRPFB(_push)(_q->f, _x);
+    RESAMP(_execute_block)(_q, &_x, 1, _y, _num_written);
+}
+
+// run arbitrary resampler on a block of input samples; the output
+// array must hold at least ceil(rate*_nx)+1 samples
+//  _q          :   resampling object
+//  _x          :   input array [size: _nx x 1]
+//  _nx         :   input array size
+//  _y          :   output array
+//  _ny         :   number of samples written to output
+void RESAMP(_execute_block)(RESAMP()       _q,
+                            TI *           _x,
+                            unsigned int   _nx,
+                            TO *           _y,
+                            unsigned int * _ny)
+{
     unsigned int n=0;
-    
-    while (_q->b < _q->npfb) {
+    unsigned int i;
+    for (i=0; i<_nx; i++) {
+        // push input sample into buffer, moving most recent samples
+        // to the front when full
+        if (_q->buffer_index == _q->buffer_len) {
+            memmove(_q->buffer, _q->buffer + _q->buffer_len - _q->h_sub_len + 1,
+                    (_q->h_sub_len-1)*sizeof(TI));
+            _q->buffer_index = _q->h_sub_len - 1;
+        }
+        _q->buffer[_q->buffer_index++] = _x[i];
+
+        // buffer read pointer for filterbank
+        TI * r = _q->buffer + _q->buffer_index - _q->h_sub_len;
+
+        while (_q->b < _q->npfb) {
 
 #if DEBUG_RESAMP_PRINT
-        printf("  [%2u] : s=%1u, tau=%12.8f, b : %12.8f (%4d + %8.6f)\n", n+1, _q->state, _q->tau, _q->bf, _q->b, _q->mu);
+            printf("  [%2u] : s=%1u, tau=%12.8f, b : %12.8f (%4d + %8.6f)\n", n+1, _q->state, _q->tau, _q->bf, _q->b, _q->mu);
 #endif
-        switch (_q->state) {
-        case STATE_BOUNDARY:
-            // compute filterbank output
-            FIRPFB(_execute)(_q->f, 0, &_q->y1);
-
-            // interpolate
-            _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
-        
-            // update timing state
-            RESAMP(_update_timing_state)(_q);
-
-            _q->state = STATE_INTERP;
-            break;
-
-        case STATE_INTERP:
-            // compute output at base index
-            FIRPFB(_execute)(_q->f, _q->b, &_q->y0);
-
-            // check to see if base index is last filter in the bank, in
-            // which case the resampler needs an additional input sample
-            // to finish the linear interpolation process
-            if (_q->b == _q->npfb-1) {
-                // last filter: need additional input sample
-                _q->state = STATE_BOUNDARY;
-            
-                // set index to indicate new sample is needed
-                _q->b = _q->npfb;
-            } else {
-                // do not need additional input sample; compute
-                // output at incremented base index
-                FIRPFB(_execute)(_q->f, _q->b+1, &_q->y1);
-
-                // perform linear interpolation between filterbank outputs
-                _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
+            switch (_q->state) {
+            case STATE_BOUNDARY:
+                // compute filterbank output
+                DOTPROD(_execute)(_q->dp[0], r, &_q->y1);
 
+                // interpolate
+                _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
+            
                 // update timing state
                 RESAMP(_update_timing_state)(_q);
+
+                _q->state = STATE_INTERP;
+                break;
+
+            case STATE_INTERP:
+                // compute output at base index
+                DOTPROD(_execute)(_q->dp[_q->b], r, &_q->y0);
+
+                // check to see if base index is last filter in the bank, in
+                // which case the resampler needs an additional input sample
+                // to finish the linear interpolation process
+                if (_q->b == _q->npfb-1) {
+                    // last filter: need additional input sample
+                    _q->state = STATE_BOUNDARY;
+                
+                    // set index to indicate new sample is needed
+                    _q->b = _q->npfb;
+                } else {
+                    // do not need additional input sample; compute
+                    // output at incremented base index
+                    DOTPROD(_execute)(_q->dp[_q->b+1], r, &_q->y1);
+
+                    // perform linear interpolation between filterbank outputs
+                    _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
+
+                    // update timing state
+                    RESAMP(_update_timing_state)(_q);
+                }
+                break;
+            default:
+                fprintf(stderr,"error: resamp_%s_execute(), invalid/unknown state\n", EXTENSION_FULL);
+                exit(1);
             }
-            break;
-        default:
-            fprintf(stderr,"error: resamp_%s_execute(), invalid/unknown state\n", EXTENSION_FULL);
-            exit(1);
         }
-    }
 
-    // decrement timing phase by one sample
-    _q->tau -= 1.0f;
-    _q->bf  -= (float)(_q->npfb);
-    _q->b   -= _q->npfb;
+        // decrement timing phase by one sample
+        _q->tau -= 1.0f;
+        _q->bf  -= (float)(_q->npfb);
+        _q->b   -= _q->npfb;
+    }
 
     // specify number of samples written
-    *_num_written = n;
+    *_ny = n;
 }
 
 //
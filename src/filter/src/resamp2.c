@@ -35,6 +35,9 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// maximum number of samples per branch in each pass of block methods
+#define RESAMP2_BLOCK_LEN   (256)
+
 struct RESAMP2(_s) {
     TC * h;                 // filter prototype
     unsigned int m;         // primitive filter length
@@ -51,6 +54,11 @@ struct RESAMP2(_s) {
     WINDOW() w0;            // input buffer (even samples)
     WINDOW() w1;            // input buffer (odd samples)
 
+    // linear buffers for block execution: window contents followed
+    // by up to RESAMP2_BLOCK_LEN new samples per branch
+    TI * b0;                // delay branch
+    TI * b1;                // filter branch
+
     // halfband filter operation
     unsigned int toggle;
 };
@@ -113,6 +121,8 @@ RESAMP2() RESAMP2(_create)(unsigned int _m,
     // create window buffers
     q->w0 = WINDOW(_create)(2*(q->m));
     q->w1 = WINDOW(_create)(2*(q->m));
+    q->b0 = (TI*) malloc((2*q->m + RESAMP2_BLOCK_LEN)*sizeof(TI));
+    q->b1 = (TI*) malloc((2*q->m + RESAMP2_BLOCK_LEN)*sizeof(TI));
 
     RESAMP2(_clear)(q);
 
@@ -173,6 +183,8 @@ void RESAMP2(_destroy)(RESAMP2() _q)
     // destroy window buffers
     WINDOW(_destroy)(_q->w0);
     WINDOW(_destroy)(_q->w1);
+    free(_q->b0);
+    free(_q->b1);
 
     // free arrays
     free(_q->h);
@@ -355,3 +367,93 @@ void RESAMP2(_interp_execute)(RESAMP2() _q,
     DOTPROD(_execute)(_q->dp, r, &_y[1]);
 }
 
+// load window contents into front of linear buffers for block
+// execution of (up to) RESAMP2_BLOCK_LEN samples per branch
+void RESAMP2(_block_load)(RESAMP2() _q)
+{
+    TI * r;
+    WINDOW(_read)(_q->w0, &r);
+    memmove(_q->b0, r, 2*_q->m*sizeof(TI));
+    WINDOW(_read)(_q->w1, &r);
+    memmove(_q->b1, r, 2*_q->m*sizeof(TI));
+}
+
+// store most recent samples of linear buffers back into windows
+// after _n samples have been appended to each branch
+void RESAMP2(_block_store)(RESAMP2()    _q,
+                           unsigned int _n)
+{
+    WINDOW(_write)(_q->w0, _q->b0 + _n, 2*_q->m);
+    WINDOW(_write)(_q->w1, _q->b1 + _n, 2*_q->m);
+}
+
+// execute half-band decimation on a block of samples
+//  _q      :   resamp2 object
+//  _x      :   input array [size: 2*_n x 1]
+//  _n      :   number of output samples
+//  _y      :   output array [size: _n x 1]
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,
+                                   TI *         _x,
+                                   unsigned int _n,
+                                   TO *         _y)
+{
+    unsigned int m = _q->m;
+    unsigned int i;
+    TO y1;
+
+    while (_n > 0) {
+        unsigned int k = _n < RESAMP2_BLOCK_LEN ? _n : RESAMP2_BLOCK_LEN;
+
+        // de-interleave input into filter (even) and delay (odd) branches
+        RESAMP2(_block_load)(_q);
+        for (i=0; i<k; i++) {
+            _q->b1[2*m+i] = _x[2*i+0];
+            _q->b0[2*m+i] = _x[2*i+1];
+        }
+
+        // filter branch output plus delay branch
+        for (i=0; i<k; i++) {
+            DOTPROD(_execute)(_q->dp, _q->b1 + i + 1, &y1);
+            _y[i] = _q->b0[i + m] + y1;
+        }
+
+        RESAMP2(_block_store)(_q, k);
+        _x += 2*k;
+        _y += k;
+        _n -= k;
+    }
+}
+
+// execute half-band interpolation on a block of samples
+//  _q      :   resamp2 object
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   output array [size: 2*_n x 1]
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,
+                                    TI *         _x,
+                                    unsigned int _n,
+                                    TO *         _y)
+{
+    unsigned int m = _q->m;
+    unsigned int i;
+
+    while (_n > 0) {
+        unsigned int k = _n < RESAMP2_BLOCK_LEN ? _n : RESAMP2_BLOCK_LEN;
+
+        // push input into both branches
+        RESAMP2(_block_load)(_q);
+        memmove(_q->b0 + 2*m, _x, k*sizeof(TI));
+        memmove(_q->b1 + 2*m, _x, k*sizeof(TI));
+
+        // delay branch and filter branch outputs
+        for (i=0; i<k; i++) {
+            _y[2*i+0] = _q->b0[i + m];
+            DOTPROD(_execute)(_q->dp, _q->b1 + i + 1, &_y[2*i+1]);
+        }
+
+        RESAMP2(_block_store)(_q, k);
+        _x += k;
+        _y += 2*k;
+        _n -= k;
+    }
+}
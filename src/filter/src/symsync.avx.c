@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// symsync.avx.c : fused matched/derivative-matched filter kernel (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// sum interleaved complex accumulator {re, im, re, im, ...}
+__attribute__((target("avx2,fma"), always_inline))
+static inline float complex symsync_hsum_avx2(__m256 _v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(_v), _mm256_extractf128_ps(_v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    return _mm_cvtss_f32(s) + _Complex_I*_mm_cvtss_f32(_mm_shuffle_ps(s, s, _MM_SHUFFLE(1,1,1,1)));
+}
+
+// compute matched and derivative matched filter outputs from a single
+// pass over the input; derivative is skipped when _dh is NULL
+__attribute__((target("avx2,fma")))
+unsigned int symsync_crcf_dotprod2_avx2(float *         _h,
+                                        float *         _dh,
+                                        float complex * _x,
+                                        unsigned int    _n,
+                                        float complex * _mf,
+                                        float complex * _dmf)
+{
+    // coefficient duplication: {h0,h0,h1,h1,h2,h2,h3,h3}, {h4,h4,...}
+    const __m256i lo = _mm256_setr_epi32(0,0,1,1,2,2,3,3);
+    const __m256i hi = _mm256_setr_epi32(4,4,5,5,6,6,7,7);
+
+    __m256 a0 = _mm256_setzero_ps();
+    __m256 a1 = _mm256_setzero_ps();
+    __m256 d0 = _mm256_setzero_ps();
+    __m256 d1 = _mm256_setzero_ps();
+
+    unsigned int i;
+    if (_dh == NULL) {
+        for (i=0; i+8 <= _n; i+=8) {
+            __m256 x0 = _mm256_loadu_ps((float*)(_x + i));
+            __m256 x1 = _mm256_loadu_ps((float*)(_x + i + 4));
+            __m256 h  = _mm256_loadu_ps(_h + i);
+            a0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(h, lo), x0, a0);
+            a1 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(h, hi), x1, a1);
+        }
+    } else {
+        for (i=0; i+8 <= _n; i+=8) {
+            __m256 x0 = _mm256_loadu_ps((float*)(_x + i));
+            __m256 x1 = _mm256_loadu_ps((float*)(_x + i + 4));
+            __m256 h  = _mm256_loadu_ps(_h  + i);
+            __m256 dh = _mm256_loadu_ps(_dh + i);
+            a0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(h,  lo), x0, a0);
+            a1 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(h,  hi), x1, a1);
+            d0 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(dh, lo), x0, d0);
+            d1 = _mm256_fmadd_ps(_mm256_permutevar8x32_ps(dh, hi), x1, d1);
+        }
+        *_dmf = symsync_hsum_avx2(_mm256_add_ps(d0, d1));
+    }
+    *_mf = symsync_hsum_avx2(_mm256_add_ps(a0, a1));
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
@@ -41,15 +41,25 @@
 #define DEBUG_SYMSYNC_FILENAME  "symsync_internal_debug.m"
 #define DEBUG_BUFFER_LEN        (1024)
 
+// number of input samples held in buffer before it is shifted
+#define SYMSYNC_BUFFER_LEN      (1024)
+
 // 
 // forward declaration of internal methods
 //
 
-// step synchronizer
-void SYMSYNC(_step)(SYMSYNC()      _q,
-                    TI             _x,
-                    TO *           _y,
-                    unsigned int * _ny);
+// compute matched-filter output and, if _dmf is not NULL, the
+// derivative matched-filter output from a single pass over the input
+//  _q      :   synchronizer object
+//  _r      :   input buffer read pointer [size: h_sub_len x 1]
+//  _b      :   filterbank index
+//  _mf     :   matched-filter output
+//  _dmf    :   derivative matched-filter output (ignored if NULL)
+void SYMSYNC(_execute_filters)(SYMSYNC()    _q,
+                               TI *         _r,
+                               unsigned int _b,
+                               TO *         _mf,
+                               TO *         _dmf);
 
 // advance internal timing loop
 void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
@@ -62,7 +72,6 @@ void SYMSYNC(_output_debug_file)(SYMSYNC()    _q,
 
 // internal structure
 struct SYMSYNC(_s) {
-    unsigned int h_len;         // matched filter length
     unsigned int k;             // samples/symbol (input)
     unsigned int k_out;         // samples/symbol (output)
 
@@ -85,9 +94,20 @@ struct SYMSYNC(_s) {
     float A[3];                 // loop filter feed-back coefficients
     iirfiltsos_rrrf pll;        // loop filter object (iir filter)
 
-    unsigned int npfb;
-    FIRPFB()  mf;               // matched filter
-    FIRPFB() dmf;               // derivative matched filter
+    // polyphase filterbanks; the matched filter and its derivative
+    // share one input buffer and are evaluated in the same pass
+    unsigned int npfb;          // number of filters in each bank
+    unsigned int h_sub_len;     // length of each filter in the bank
+    TC * h;                     // matched filters, each loaded in reverse
+                                // order [size: npfb x h_sub_len]
+    TC * dh;                    // derivative matched filters, as above
+    liquid_simd_level simd;     // SIMD kernels, chosen at run time
+
+    // linear input buffer; each filter reads the h_sub_len samples
+    // preceding buffer_index
+    TI * buffer;                // input buffer
+    unsigned int buffer_len;    // buffer length
+    unsigned int buffer_index;  // index following most recent sample
 
 #if DEBUG_SYMSYNC
     windowf debug_del;
@@ -119,6 +139,9 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
     } else if (_npfb == 0) {
         fprintf(stderr,"error: symsync_%s_create(), number of filter banks must be greater than zero\n", EXTENSION_FULL);
         exit(1);
+    } else if (_h_len < _npfb) {
+        fprintf(stderr,"error: symsync_%s_create(), filter length must be at least the number of filter banks\n", EXTENSION_FULL);
+        exit(1);
     }
 
     SYMSYNC() q = (SYMSYNC()) malloc(sizeof(struct SYMSYNC(_s)));
@@ -132,9 +155,6 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
     // set output rate (nominally 1, full decimation)
     SYMSYNC(_set_output_rate)(q, 1);
 
-    // TODO: validate length
-    q->h_len = (_h_len-1)/q->npfb;
-    
     // compute derivative filter
     TC dh[_h_len];
     float hdh_max = 0.0f;
@@ -158,8 +178,23 @@ SYMSYNC() SYMSYNC(_create)(unsigned int _k,
     for (i=0; i<_h_len; i++)
         dh[i] *= 0.06f / hdh_max;
     
-    q->mf  = FIRPFB(_create)(q->npfb, _h, _h_len);
-    q->dmf = FIRPFB(_create)(q->npfb, dh, _h_len);
+    // generate matched and derivative matched filterbanks, storing
+    // the coefficients of each sub-sampled filter in reverse order
+    q->h_sub_len = _h_len / q->npfb;
+    q->h  = (TC*) malloc(q->npfb*q->h_sub_len*sizeof(TC));
+    q->dh = (TC*) malloc(q->npfb*q->h_sub_len*sizeof(TC));
+    unsigned int j;
+    for (i=0; i<q->npfb; i++) {
+        for (j=0; j<q->h_sub_len; j++) {
+            q->h [i*q->h_sub_len + q->h_sub_len-j-1] = _h[i + j*q->npfb];
+            q->dh[i*q->h_sub_len + q->h_sub_len-j-1] =  dh[i + j*q->npfb];
+        }
+    }
+    q->simd = liquid_cpu_get_simd_level();
+
+    // allocate input buffer
+    q->buffer_len = q->h_sub_len + SYMSYNC_BUFFER_LEN;
+    q->buffer     = (TI*) malloc(q->buffer_len*sizeof(TI));
 
     // reset state and initialize loop filter
     q->A[0] = 1.0f;     q->B[0] = 0.0f;
@@ -242,9 +277,10 @@ void SYMSYNC(_destroy)(SYMSYNC() _q)
     windowf_destroy(_q->debug_q_hat);
 #endif
 
-    // destroy filterbank objects
-    FIRPFB(_destroy)(_q->mf);
-    FIRPFB(_destroy)(_q->dmf);
+    // free filterbank coefficients and input buffer
+    free(_q->h);
+    free(_q->dh);
+    free(_q->buffer);
 
     iirfiltsos_rrrf_destroy(_q->pll);
 
@@ -255,12 +291,17 @@ void SYMSYNC(_destroy)(SYMSYNC() _q)
 void SYMSYNC(_print)(SYMSYNC() _q)
 {
     printf("symsync [rate: %f]\n", _q->r);
-    FIRPFB(_print)(_q->mf);
+    printf("    filters in bank     :   %u\n", _q->npfb);
+    printf("    filter length       :   %u\n", _q->h_sub_len);
 }
 
 void SYMSYNC(_reset)(SYMSYNC() _q)
 {
-    FIRPFB(_clear)(_q->mf);
+    // clear input buffer
+    unsigned int i;
+    for (i=0; i<_q->buffer_len; i++)
+        _q->buffer[i] = 0;
+    _q->buffer_index = _q->h_sub_len;
 
     _q->b       = 0;
     _q->tau     = 0.0f;
@@ -349,7 +390,8 @@ float SYMSYNC(_get_tau)(SYMSYNC() _q)
     return _q->tau_decim;
 }
 
-// execute synchronizer on input data array
+// execute synchronizer on input data array; the output array
+// must hold at least ceil(_nx*k_out/k)+1 samples
 //  _q      :   synchronizer object
 //  _x      :   input data array
 //  _nx     :   number of input samples
@@ -361,13 +403,77 @@ void SYMSYNC(_execute)(SYMSYNC() _q,
                        TO * _y,
                        unsigned int *_ny)
 {
-    unsigned int i, ny=0, k=0;
+    // matched and derivative matched-filter outputs
+    TO  mf;
+    TO dmf;
+
+    unsigned int n=0;
+    unsigned int i;
     for (i=0; i<_nx; i++) {
-        SYMSYNC(_step)(_q, _x[i], &_y[ny], &k);
-        ny += k;
-        //printf("%u\n",k);
+        // push input sample into buffer, moving most recent samples
+        // to the front when full
+        if (_q->buffer_index == _q->buffer_len) {
+            memmove(_q->buffer, _q->buffer + _q->buffer_len - _q->h_sub_len + 1,
+                    (_q->h_sub_len-1)*sizeof(TI));
+            _q->buffer_index = _q->h_sub_len - 1;
+        }
+        _q->buffer[_q->buffer_index++] = _x[i];
+
+        // buffer read pointer for filterbanks
+        TI * r = _q->buffer + _q->buffer_index - _q->h_sub_len;
+
+        //while (_q->tau < 1.0f) {
+        while (_q->b < _q->npfb) {
+
+#if DEBUG_SYMSYNC_PRINT
+            printf("  [%2u] : tau : %12.8f, b : %4u (%12.8f)\n", n, _q->tau, _q->b, _q->bf);
+#endif
+
+            // check output count and determine if this is 'ideal'
+            // timing output, in which case the derivative matched
+            // filter is computed in the same pass
+            int decim = _q->decim_counter == _q->k_out;
+            int update = decim && !_q->is_locked;
+
+            // compute filterbank output(s)
+            SYMSYNC(_execute_filters)(_q, r, _q->b, &mf, update ? &dmf : NULL);
+
+            // scale output by samples/symbol
+            _y[n++] = mf / (float)(_q->k);
+
+            if (decim) {
+                // reset counter
+                _q->decim_counter = 0;
+
+#if DEBUG_SYMSYNC
+                // save debugging variables
+                windowf_push(_q->debug_del,    _q->del);
+                windowf_push(_q->debug_tau,    _q->tau);
+                windowf_push(_q->debug_bsoft,  _q->bf);
+                windowf_push(_q->debug_b,      _q->b);
+                windowf_push(_q->debug_q_hat,  _q->q_hat);
+#endif
+
+                if (update) {
+                    // update internal state
+                    SYMSYNC(_advance_internal_loop)(_q, mf, dmf);
+                    _q->tau_decim = _q->tau;
+                }
+            }
+            _q->decim_counter++;
+
+            _q->tau += _q->del;
+            _q->bf = _q->tau * (float)(_q->npfb);
+            _q->b  = (int)roundf(_q->bf);
+        }
+
+        // decrement timing phase by one sample
+        _q->tau -= 1.0f;
+        _q->bf  -= (float)(_q->npfb);
+        _q->b   -= _q->npfb;
     }
-    *_ny = ny;
+
+    *_ny = n;
 }
 
 // advance synchronizer's internal loop filter
@@ -399,70 +505,39 @@ void SYMSYNC(_advance_internal_loop)(SYMSYNC() _q,
 #endif
 }
 
-void SYMSYNC(_step)(SYMSYNC() _q,
-                    TI _x,
-                    TO * _y,
-                    unsigned int *_num_written)
+// compute matched-filter output and, if _dmf is not NULL, the
+// derivative matched-filter output from a single pass over the input
+void SYMSYNC(_execute_filters)(SYMSYNC()    _q,
+                               TI *         _r,
+                               unsigned int _b,
+                               TO *         _mf,
+                               TO *         _dmf)
 {
-    // push sample into MF and dMF filterbanks
-    FIRPFB(_push)(_q->mf,  _x);
-    FIRPFB(_push)(_q->dmf, _x);
-    
-    // matched and derivative matched-filter outputs
-    TO  mf;
-    TO dmf;
-
-    unsigned int n=0;
-    
-    //while (_q->tau < 1.0f) {
-    while (_q->b < _q->npfb) {
-
-#if DEBUG_SYMSYNC_PRINT
-        printf("  [%2u] : tau : %12.8f, b : %4u (%12.8f)\n", n, _q->tau, _q->b, _q->bf);
-#endif
-
-        // compute filterbank output
-        FIRPFB(_execute)(_q->mf, _q->b, &mf);
-
-        // scale output by samples/symbol
-        _y[n] = mf / (float)(_q->k);
-
-        // check output count and determine if this is 'ideal' timing output
-        if (_q->decim_counter == _q->k_out) {
-            // reset counter
-            _q->decim_counter = 0;
-
-#if DEBUG_SYMSYNC
-        // save debugging variables
-        windowf_push(_q->debug_del,    _q->del);
-        windowf_push(_q->debug_tau,    _q->tau);
-        windowf_push(_q->debug_bsoft,  _q->bf);
-        windowf_push(_q->debug_b,      _q->b);
-        windowf_push(_q->debug_q_hat,  _q->q_hat);
+    unsigned int n = _q->h_sub_len;
+    TC * h  = _q->h + _b*n;
+    TC * dh = _dmf != NULL ? _q->dh + _b*n : NULL;
+
+    TO mf  = 0;
+    TO dmf = 0;
+    unsigned int i = 0;
+#if LIQUID_CPU_X86 && TI_COMPLEX && !TC_COMPLEX
+    if (_q->simd >= LIQUID_SIMD_AVX2)
+        i = symsync_crcf_dotprod2_avx2(h, dh, _r, n, &mf, &dmf);
+    else if (_q->simd == LIQUID_SIMD_SSE)
+        i = symsync_crcf_dotprod2_sse(h, dh, _r, n, &mf, &dmf);
 #endif
 
-            if (_q->is_locked) continue;
-
-            // compute dMF output
-            FIRPFB(_execute)(_q->dmf, _q->b, &dmf);
-            
-            // update internal state
-            SYMSYNC(_advance_internal_loop)(_q, mf, dmf);
-            _q->tau_decim = _q->tau;
+    if (dh == NULL) {
+        for ( ; i<n; i++)
+            mf += h[i]*_r[i];
+    } else {
+        for ( ; i<n; i++) {
+            mf  +=  h[i]*_r[i];
+            dmf += dh[i]*_r[i];
         }
-        _q->decim_counter++;
-
-        _q->tau += _q->del;
-        _q->bf = _q->tau * (float)(_q->npfb);
-        _q->b  = (int)roundf(_q->bf);
-        n++;
+        *_dmf = dmf;
     }
-
-    _q->tau -= 1.0f;
-    _q->bf  -= (float)(_q->npfb);
-    _q->b   -= _q->npfb;
-
-    *_num_written = n;
+    *_mf = mf;
 }
 
 // print results to output debugging file
@@ -488,32 +563,15 @@ void SYMSYNC(_output_debug_file)(SYMSYNC() _q,
     float * r;
     unsigned int i;
 
-    // save filter responses
-    FIRPFB(_clear)(_q->mf);
-    FIRPFB(_clear)(_q->dmf);
+    // save filter responses (coefficients are stored in reverse order)
     fprintf(fid,"h = [];\n");
     fprintf(fid,"dh = [];\n");
-    fprintf(fid,"h_len = %u;\n", _q->h_len);
-    for (i=0; i<_q->h_len; i++) {
-        // push impulse
-        if (i==0) {
-            FIRPFB(_push)(_q->mf,  1.0f);
-            FIRPFB(_push)(_q->dmf, 1.0f);
-        } else {
-            FIRPFB(_push)(_q->mf,  0.0f);
-            FIRPFB(_push)(_q->dmf, 0.0f);
-        }
-
-        // compute output for all filters
-        TO  mf;     // matched filter output
-        TO dmf;     // derivative matched filter output
-
+    fprintf(fid,"h_len = %u;\n", _q->h_sub_len);
+    for (i=0; i<_q->h_sub_len; i++) {
         unsigned int n;
         for (n=0; n<_q->npfb; n++) {
-            FIRPFB(_execute)(_q->mf,  n, &mf);
-            FIRPFB(_execute)(_q->dmf, n, &dmf);
-
-            fprintf(fid,"h(%4u) = %12.8f; dh(%4u) = %12.8f;\n", i*_q->npfb+n+1, crealf(mf), i*_q->npfb+n+1, crealf(dmf));
+            unsigned int j = n*_q->h_sub_len + _q->h_sub_len - i - 1;
+            fprintf(fid,"h(%4u) = %12.8f; dh(%4u) = %12.8f;\n", i*_q->npfb+n+1, crealf(_q->h[j]), i*_q->npfb+n+1, crealf(_q->dh[j]));
         }
     }
     // plot response
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// symsync.mmx.c : fused matched/derivative-matched filter kernel (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// sum interleaved complex accumulator {re, im, re, im}
+__attribute__((target("sse2"), always_inline))
+static inline float complex symsync_hsum_sse(__m128 _v)
+{
+    float s[4];
+    _mm_storeu_ps(s, _v);
+    return (s[0] + s[2]) + _Complex_I*(s[1] + s[3]);
+}
+
+// compute matched and derivative matched filter outputs from a single
+// pass over the input; derivative is skipped when _dh is NULL
+__attribute__((target("sse2")))
+unsigned int symsync_crcf_dotprod2_sse(float *         _h,
+                                       float *         _dh,
+                                       float complex * _x,
+                                       unsigned int    _n,
+                                       float complex * _mf,
+                                       float complex * _dmf)
+{
+    __m128 a0 = _mm_setzero_ps();
+    __m128 a1 = _mm_setzero_ps();
+    __m128 d0 = _mm_setzero_ps();
+    __m128 d1 = _mm_setzero_ps();
+
+    unsigned int i;
+    if (_dh == NULL) {
+        for (i=0; i+4 <= _n; i+=4) {
+            __m128 x0 = _mm_loadu_ps((float*)(_x + i));
+            __m128 x1 = _mm_loadu_ps((float*)(_x + i + 2));
+            __m128 h  = _mm_loadu_ps(_h + i);
+            a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_unpacklo_ps(h,h), x0));
+            a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_unpackhi_ps(h,h), x1));
+        }
+    } else {
+        for (i=0; i+4 <= _n; i+=4) {
+            __m128 x0 = _mm_loadu_ps((float*)(_x + i));
+            __m128 x1 = _mm_loadu_ps((float*)(_x + i + 2));
+            __m128 h  = _mm_loadu_ps(_h  + i);
+            __m128 dh = _mm_loadu_ps(_dh + i);
+            a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_unpacklo_ps(h,h), x0));
+            a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_unpackhi_ps(h,h), x1));
+            d0 = _mm_add_ps(d0, _mm_mul_ps(_mm_unpacklo_ps(dh,dh), x0));
+            d1 = _mm_add_ps(d1, _mm_mul_ps(_mm_unpackhi_ps(dh,dh), x1));
+        }
+        *_dmf = symsync_hsum_sse(_mm_add_ps(d0, d1));
+    }
+    *_mf = symsync_hsum_sse(_mm_add_ps(a0, a1));
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
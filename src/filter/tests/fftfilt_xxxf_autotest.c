@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// fftfilt_xxxf_autotest.c : test FFT-based filters against firfilt
+//
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST: fftfilt_rrrf matches firfilt_rrrf
+//
+void autotest_fftfilt_rrrf()
+{
+    float tol = 1e-4f;
+    unsigned int h_len = 57;    // filter length
+    unsigned int n     = 64;    // block size
+    unsigned int num_blocks = 8;
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    // create filter objects
+    firfilt_rrrf q0 = firfilt_rrrf_create(h, h_len);
+    fftfilt_rrrf q1 = fftfilt_rrrf_create(h, h_len, n);
+
+    float x[n*num_blocks];
+    float y0[n*num_blocks];
+    float y1[n*num_blocks];
+    for (i=0; i<n*num_blocks; i++) {
+        x[i] = randnf();
+        firfilt_rrrf_push(q0, x[i]);
+        firfilt_rrrf_execute(q0, &y0[i]);
+    }
+
+    for (i=0; i<num_blocks; i++)
+        fftfilt_rrrf_execute(q1, &x[i*n], &y1[i*n]);
+
+    for (i=0; i<n*num_blocks; i++)
+        CONTEND_DELTA( y1[i], y0[i], tol );
+
+    // destroy filter objects
+    firfilt_rrrf_destroy(q0);
+    fftfilt_rrrf_destroy(q1);
+}
+
+// 
+// AUTOTEST: fftfilt_crcf matches firfilt_crcf
+//
+void autotest_fftfilt_crcf()
+{
+    float tol = 1e-4f;
+    unsigned int h_len = 65;    // filter length (maximum for block size)
+    unsigned int n     = 64;    // block size
+    unsigned int num_blocks = 8;
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    // create filter objects
+    firfilt_crcf q0 = firfilt_crcf_create(h, h_len);
+    fftfilt_crcf q1 = fftfilt_crcf_create(h, h_len, n);
+
+    float complex x[n*num_blocks];
+    float complex y0[n*num_blocks];
+    float complex y1[n*num_blocks];
+    for (i=0; i<n*num_blocks; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    for (i=0; i<num_blocks; i++)
+        fftfilt_crcf_execute(q1, &x[i*n], &y1[i*n]);
+
+    for (i=0; i<n*num_blocks; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    // destroy filter objects
+    firfilt_crcf_destroy(q0);
+    fftfilt_crcf_destroy(q1);
+}
+
+// 
+// AUTOTEST: fftfilt_cccf matches firfilt_cccf (non-power-of-two block)
+//
+void autotest_fftfilt_cccf()
+{
+    float tol = 1e-4f;
+    unsigned int h_len = 23;    // filter length
+    unsigned int n     = 30;    // block size
+    unsigned int num_blocks = 8;
+
+    float complex h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf() + _Complex_I*randnf();
+
+    // create filter objects
+    firfilt_cccf q0 = firfilt_cccf_create(h, h_len);
+    fftfilt_cccf q1 = fftfilt_cccf_create(h, h_len, n);
+
+    float complex x[n*num_blocks];
+    float complex y0[n*num_blocks];
+    float complex y1[n*num_blocks];
+    for (i=0; i<n*num_blocks; i++) {
+        x[i] = randnf() + _Complex_I*randnf();
+        firfilt_cccf_push(q0, x[i]);
+        firfilt_cccf_execute(q0, &y0[i]);
+    }
+
+    for (i=0; i<num_blocks; i++)
+        fftfilt_cccf_execute(q1, &x[i*n], &y1[i*n]);
+
+    for (i=0; i<n*num_blocks; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    // destroy filter objects
+    firfilt_cccf_destroy(q0);
+    fftfilt_cccf_destroy(q1);
+}
@@ -52,6 +52,12 @@ void firfilt_rrrf_test(float *      _h,
         CONTEND_DELTA( y_test[i], _y[i], tol );
     }
 
+    // run block execution on the same data
+    firfilt_rrrf_clear(q);
+    firfilt_rrrf_execute_block(q, _x, _x_len, y_test);
+    for (i=0; i<_x_len; i++)
+        CONTEND_DELTA( y_test[i], _y[i], tol );
+
     // destroy filter object
     firfilt_rrrf_destroy(q);
 }
@@ -87,6 +93,14 @@ void firfilt_crcf_test(float *         _h,
         CONTEND_DELTA( crealf(y_test[i]), crealf(_y[i]), tol );
         CONTEND_DELTA( cimagf(y_test[i]), cimagf(_y[i]), tol );
     }
+
+    // run block execution on the same data
+    firfilt_crcf_clear(q);
+    firfilt_crcf_execute_block(q, _x, _x_len, y_test);
+    for (i=0; i<_x_len; i++) {
+        CONTEND_DELTA( crealf(y_test[i]), crealf(_y[i]), tol );
+        CONTEND_DELTA( cimagf(y_test[i]), cimagf(_y[i]), tol );
+    }
     
     // destroy filter object
     firfilt_crcf_destroy(q);
@@ -123,6 +137,14 @@ void firfilt_cccf_test(float complex * _h,
         CONTEND_DELTA( crealf(y_test[i]), crealf(_y[i]), tol );
         CONTEND_DELTA( cimagf(y_test[i]), cimagf(_y[i]), tol );
     }
+
+    // run block execution on the same data
+    firfilt_cccf_clear(q);
+    firfilt_cccf_execute_block(q, _x, _x_len, y_test);
+    for (i=0; i<_x_len; i++) {
+        CONTEND_DELTA( crealf(y_test[i]), crealf(_y[i]), tol );
+        CONTEND_DELTA( cimagf(y_test[i]), cimagf(_y[i]), tol );
+    }
     
     // destroy filter object
     firfilt_cccf_destroy(q);
@@ -22,6 +22,9 @@
 // firfilt_xxxf_autotest.c : test floating-point filters
 //
 
+#include <stdlib.h>
+#include <string.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -115,3 +118,118 @@ void autotest_firfilt_cccf_data_h23x64()
 }
 
 
+
+// 
+// AUTOTEST: block execution matches sample-by-sample execution
+//
+void autotest_firfilt_crcf_execute_block()
+{
+    float tol = 1e-5f;
+    unsigned int h_len = 37;    // filter length
+    unsigned int num_samples = 1000;
+
+    float h[h_len];
+    unsigned int i;
+    for (i=0; i<h_len; i++)
+        h[i] = randnf();
+
+    // create filter objects
+    firfilt_crcf q0 = firfilt_crcf_create(h, h_len);
+    firfilt_crcf q1 = firfilt_crcf_create(h, h_len);
+
+    float complex x[num_samples];
+    float complex y0[num_samples];
+    float complex y1[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // run sample-by-sample
+    for (i=0; i<num_samples; i++) {
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    // run in blocks of varying size (in place), crossing
+    // internal buffer boundaries at different offsets
+    memmove(y1, x, num_samples*sizeof(float complex));
+    unsigned int n = 0;
+    unsigned int block_size = 1;
+    while (n < num_samples) {
+        unsigned int k = n + block_size > num_samples ? num_samples - n : block_size;
+        firfilt_crcf_execute_block(q1, &y1[n], k, &y1[n]);
+        n += k;
+        block_size = (block_size * 7) % 83 + 1;
+    }
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy filter objects
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+}
+
+// 
+// AUTOTEST: block execution of long filters (overlap-save path for
+// large blocks, direct path otherwise) matches sample-by-sample
+// execution to within transform rounding error
+//
+void firfilt_crcf_test_execute_block_long(unsigned int _h_len)
+{
+    float tol = 1e-4f;
+    unsigned int num_samples = 12000;
+
+    // normalize filter so output has approximately unit variance
+    float h[_h_len];
+    unsigned int i;
+    for (i=0; i<_h_len; i++)
+        h[i] = randnf() / sqrtf(_h_len);
+
+    // create filter objects
+    firfilt_crcf q0 = firfilt_crcf_create(h, _h_len);
+    firfilt_crcf q1 = firfilt_crcf_create(h, _h_len);
+
+    float complex * x  = (float complex*) malloc(num_samples*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(num_samples*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(num_samples*sizeof(float complex));
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // run sample-by-sample
+    for (i=0; i<num_samples; i++) {
+        firfilt_crcf_push(q0, x[i]);
+        firfilt_crcf_execute(q0, &y0[i]);
+    }
+
+    // run in blocks of small and large sizes (in place), switching
+    // between direct and overlap-save paths
+    unsigned int block_sizes[6] = {1, 37, 2900, 7, 4100, 613};
+    memmove(y1, x, num_samples*sizeof(float complex));
+    unsigned int n = 0;
+    unsigned int k = 0;
+    while (n < num_samples) {
+        unsigned int b = block_sizes[k++ % 6];
+        if (n + b > num_samples) b = num_samples - n;
+        firfilt_crcf_execute_block(q1, &y1[n], b, &y1[n]);
+        n += b;
+    }
+
+    for (i=0; i<num_samples; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), tol );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), tol );
+    }
+
+    // destroy objects
+    firfilt_crcf_destroy(q0);
+    firfilt_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_firfilt_crcf_execute_block_255()  { firfilt_crcf_test_execute_block_long(255);  }
+void autotest_firfilt_crcf_execute_block_256()  { firfilt_crcf_test_execute_block_long(256);  }
+void autotest_firfilt_crcf_execute_block_301()  { firfilt_crcf_test_execute_block_long(301);  }
+void autotest_firfilt_crcf_execute_block_1024() { firfilt_crcf_test_execute_block_long(1024); }
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// iirfilt_block_autotest.c : block execution and parallel form
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// design filter in second-order sections form
+//  _btype  :   band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _order  :   filter order
+//  _B      :   output numerator [size: 3 x nsos]
+//  _A      :   output denominator [size: 3 x nsos]
+unsigned int iirfilt_block_autotest_design(liquid_iirdes_bandtype _btype,
+                                           unsigned int           _order,
+                                           float *                _B,
+                                           float *                _A)
+{
+    unsigned int N = _order;
+    if (_btype == LIQUID_IIRDES_BANDPASS || _btype == LIQUID_IIRDES_BANDSTOP)
+        N *= 2;
+    liquid_iirdes(LIQUID_IIRDES_CHEBY2, _btype, LIQUID_IIRDES_SOS,
+                  _order, 0.15f, 0.25f, 1.0f, 60.0f, _B, _A);
+    return (N + 1) / 2;
+}
+
+// compare block execution (irregular block sizes) to sample-wise
+// execution for each SIMD kernel
+void iirfilt_rrrf_block_test(liquid_iirdes_bandtype _btype,
+                             unsigned int           _order,
+                             int                    _parallel)
+{
+    float tol = 1e-4f;
+    unsigned int n = 800;
+    unsigned int masks[3] = {
+        ~0U,                                    // all extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    float B[3*_order], A[3*_order];
+    unsigned int nsos = iirfilt_block_autotest_design(_btype, _order, B, A);
+
+    float x[n], y0[n], y1[n];
+    unsigned int i, k;
+    for (i=0; i<n; i++)
+        x[i] = randnf();
+
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        iirfilt_rrrf q0 = _parallel ? iirfilt_rrrf_create_parallel(B, A, nsos) :
+                                      iirfilt_rrrf_create_sos(B, A, nsos);
+        iirfilt_rrrf q1 = _parallel ? iirfilt_rrrf_create_parallel(B, A, nsos) :
+                                      iirfilt_rrrf_create_sos(B, A, nsos);
+
+        for (i=0; i<n; i++)
+            iirfilt_rrrf_execute(q0, x[i], &y0[i]);
+
+        // blocks of irregular size, executed in place
+        memmove(y1, x, n*sizeof(float));
+        unsigned int t=0, b=1;
+        while (t < n) {
+            unsigned int nb = t + b > n ? n - t : b;
+            iirfilt_rrrf_execute_block(q1, &y1[t], nb, &y1[t]);
+            t += nb;
+            b = 2*b + 1;
+        }
+
+        // state is consistent after block execution
+        float z0, z1;
+        iirfilt_rrrf_execute(q0, 1.0f, &z0);
+        iirfilt_rrrf_execute(q1, 1.0f, &z1);
+
+        iirfilt_rrrf_destroy(q0);
+        iirfilt_rrrf_destroy(q1);
+
+        for (i=0; i<n; i++)
+            CONTEND_DELTA( y1[i], y0[i], tol );
+        CONTEND_DELTA( z1, z0, tol );
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+// compare block execution to sample-wise execution (complex input)
+void iirfilt_crcf_block_test(liquid_iirdes_bandtype _btype,
+                             unsigned int           _order,
+                             int                    _parallel)
+{
+    float tol = 1e-4f;
+    unsigned int n = 800;
+    unsigned int masks[3] = {
+        ~0U,                                    // all extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    float B[3*_order], A[3*_order];
+    unsigned int nsos = iirfilt_block_autotest_design(_btype, _order, B, A);
+
+    float complex x[n], y0[n], y1[n];
+    unsigned int i, k;
+    for (i=0; i<n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        iirfilt_crcf q0 = _parallel ? iirfilt_crcf_create_parallel(B, A, nsos) :
+                                      iirfilt_crcf_create_sos(B, A, nsos);
+        iirfilt_crcf q1 = _parallel ? iirfilt_crcf_create_parallel(B, A, nsos) :
+                                      iirfilt_crcf_create_sos(B, A, nsos);
+
+        for (i=0; i<n; i++)
+            iirfilt_crcf_execute(q0, x[i], &y0[i]);
+
+        unsigned int t=0, b=1;
+        while (t < n) {
+            unsigned int nb = t + b > n ? n - t : b;
+            iirfilt_crcf_execute_block(q1, &x[t], nb, &y1[t]);
+            t += nb;
+            b = 2*b + 1;
+        }
+
+        iirfilt_crcf_destroy(q0);
+        iirfilt_crcf_destroy(q1);
+
+        for (i=0; i<n; i++) {
+            CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+            CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+        }
+    }
+    liquid_cpu_set_mask(~0U);
+}
+
+void autotest_iirfilt_rrrf_block_sos_lowpass()  { iirfilt_rrrf_block_test(LIQUID_IIRDES_LOWPASS,  7, 0); }
+void autotest_iirfilt_rrrf_block_sos_bandpass() { iirfilt_rrrf_block_test(LIQUID_IIRDES_BANDPASS, 4, 0); }
+void autotest_iirfilt_rrrf_block_parallel()     { iirfilt_rrrf_block_test(LIQUID_IIRDES_LOWPASS,  7, 1); }
+void autotest_iirfilt_crcf_block_sos_lowpass()  { iirfilt_crcf_block_test(LIQUID_IIRDES_LOWPASS,  7, 0); }
+void autotest_iirfilt_crcf_block_sos_bandpass() { iirfilt_crcf_block_test(LIQUID_IIRDES_BANDPASS, 4, 0); }
+void autotest_iirfilt_crcf_block_parallel()     { iirfilt_crcf_block_test(LIQUID_IIRDES_LOWPASS,  7, 1); }
+
+// 
+// AUTOTEST: parallel form has same response as cascaded form
+//
+void iirfilt_rrrf_parallel_test(liquid_iirdes_bandtype _btype,
+                                unsigned int           _order)
+{
+    float tol = 1e-4f;
+    unsigned int n = 400;
+
+    float B[3*_order], A[3*_order];
+    unsigned int nsos = iirfilt_block_autotest_design(_btype, _order, B, A);
+
+    iirfilt_rrrf q0 = iirfilt_rrrf_create_sos(B, A, nsos);
+    iirfilt_rrrf q1 = iirfilt_rrrf_create_parallel(B, A, nsos);
+
+    // impulse response
+    unsigned int i;
+    for (i=0; i<n; i++) {
+        float y0, y1;
+        iirfilt_rrrf_execute(q0, i==0 ? 1.0f : 0.0f, &y0);
+        iirfilt_rrrf_execute(q1, i==0 ? 1.0f : 0.0f, &y1);
+        CONTEND_DELTA( y1, y0, tol );
+    }
+
+    // frequency response and group delay
+    float complex H0, H1;
+    iirfilt_rrrf_freqresponse(q0, 0.1f, &H0);
+    iirfilt_rrrf_freqresponse(q1, 0.1f, &H1);
+    CONTEND_DELTA( crealf(H1), crealf(H0), tol );
+    CONTEND_DELTA( cimagf(H1), cimagf(H0), tol );
+    CONTEND_DELTA( iirfilt_rrrf_groupdelay(q1, 0.1f),
+                   iirfilt_rrrf_groupdelay(q0, 0.1f), tol );
+
+    iirfilt_rrrf_destroy(q0);
+    iirfilt_rrrf_destroy(q1);
+}
+void autotest_iirfilt_rrrf_parallel_lowpass()  { iirfilt_rrrf_parallel_test(LIQUID_IIRDES_LOWPASS,  5); }
+void autotest_iirfilt_rrrf_parallel_highpass() { iirfilt_rrrf_parallel_test(LIQUID_IIRDES_HIGHPASS, 6); }
+void autotest_iirfilt_rrrf_parallel_bandpass() { iirfilt_rrrf_parallel_test(LIQUID_IIRDES_BANDPASS, 3); }
+
+// 
+// AUTOTEST: parallel form with direct path longer than one tap
+//
+void autotest_iirfilt_rrrf_parallel_direct()
+{
+    // (1 + z^-1)^2 / (1 - 0.5 z^-1): single pole, two-tap direct path
+    float B[3] = {1.0f, 2.0f, 1.0f};
+    float A[3] = {1.0f,-0.5f, 0.0f};
+    iirfilt_rrrf q0 = iirfilt_rrrf_create_sos(B, A, 1);
+    iirfilt_rrrf q1 = iirfilt_rrrf_create_parallel(B, A, 1);
+
+    unsigned int i;
+    float x[64], y0[64], y1[64];
+    for (i=0; i<64; i++) {
+        x[i] = randnf();
+        iirfilt_rrrf_execute(q0, x[i], &y0[i]);
+    }
+    iirfilt_rrrf_execute_block(q1, x, 64, y1);
+    for (i=0; i<64; i++)
+        CONTEND_DELTA( y1[i], y0[i], 1e-4f );
+
+    iirfilt_rrrf_destroy(q0);
+    iirfilt_rrrf_destroy(q1);
+}
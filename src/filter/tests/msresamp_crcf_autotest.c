@@ -17,6 +17,7 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -162,3 +163,49 @@ void autotest_msresamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// test block execution: one call over the entire input must give the
+// same output as many calls of irregular size
+void msresamp_crcf_block_test(float _r)
+{
+    unsigned int nx = 2500;
+    unsigned int i;
+
+    float complex * x  = (float complex*) malloc(nx*sizeof(float complex));
+    unsigned int y_len = (unsigned int)(ceilf(nx*_r)) + 64;
+    float complex * y0 = (float complex*) malloc(y_len*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(y_len*sizeof(float complex));
+    for (i=0; i<nx; i++)
+        x[i] = (rand() % 1000 - 500)*2e-3f + _Complex_I*(rand() % 1000 - 500)*2e-3f;
+
+    // single block
+    msresamp_crcf q0 = msresamp_crcf_create(_r,60.0f);
+    unsigned int ny0;
+    msresamp_crcf_execute_block(q0, x, nx, y0, &ny0);
+
+    // blocks of irregular size
+    msresamp_crcf q1 = msresamp_crcf_create(_r,60.0f);
+    unsigned int ny1 = 0;
+    unsigned int k=0, b=1, nw;
+    while (k < nx) {
+        unsigned int nb = k + b > nx ? nx - k : b;
+        msresamp_crcf_execute_block(q1, &x[k], nb, &y1[ny1], &nw);
+        ny1 += nw;
+        k += nb;
+        b = (7*b + 3) % 97;
+    }
+
+    CONTEND_EQUALITY(ny0, ny1);
+    CONTEND_SAME_DATA(y0, y1, ny0*sizeof(float complex));
+
+    msresamp_crcf_destroy(q0);
+    msresamp_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_msresamp_crcf_block_decim()   { msresamp_crcf_block_test(0.0137f); }
+void autotest_msresamp_crcf_block_arb()     { msresamp_crcf_block_test(0.7813f); }
+void autotest_msresamp_crcf_block_interp()  { msresamp_crcf_block_test(9.1700f); }
+
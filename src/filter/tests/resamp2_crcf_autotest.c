@@ -18,6 +18,7 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -171,3 +172,51 @@ void autotest_resamp2_synthesis()
     printf("results written to '%s'\n","resamp2_test.m");
 #endif
 }
+
+// 
+// AUTOTEST : block decimation/interpolation matches single-sample
+//            methods exactly
+//
+void autotest_resamp2_block()
+{
+    unsigned int m=5;       // filter semi-length (actual length: 4*m+1)
+    unsigned int n=700;     // number of output (decim) samples
+    unsigned int i;
+
+    // generate pseudo-random input
+    float complex x[2*n];
+    for (i=0; i<2*n; i++)
+        x[i] = (rand() % 1000 - 500)*2e-3f + _Complex_I*(rand() % 1000 - 500)*2e-3f;
+
+    // run decimator sample-by-sample and in blocks of irregular size
+    float complex y0[2*n];
+    float complex y1[2*n];
+    resamp2_crcf q0 = resamp2_crcf_create(m,0.1f,60.0f);
+    resamp2_crcf q1 = resamp2_crcf_create(m,0.1f,60.0f);
+    for (i=0; i<n; i++)
+        resamp2_crcf_decim_execute(q0, &x[2*i], &y0[i]);
+    unsigned int k=0, b=1;
+    while (k < n) {
+        unsigned int nb = k + b > n ? n - k : b;
+        resamp2_crcf_decim_execute_block(q1, &x[2*k], nb, &y1[k]);
+        k += nb;
+        b = 2*b + 1;
+    }
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+
+    // continue with interpolator (state carries over)
+    for (i=0; i<n; i++)
+        resamp2_crcf_interp_execute(q0, x[i], &y0[2*i]);
+    k=0, b=1;
+    while (k < n) {
+        unsigned int nb = k + b > n ? n - k : b;
+        resamp2_crcf_interp_execute_block(q1, &x[k], nb, &y1[2*k]);
+        k += nb;
+        b = 2*b + 1;
+    }
+    CONTEND_SAME_DATA(y0, y1, 2*n*sizeof(float complex));
+
+    resamp2_crcf_destroy(q0);
+    resamp2_crcf_destroy(q1);
+}
+
@@ -17,6 +17,7 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -162,3 +163,47 @@ void autotest_resamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// 
+// AUTOTEST: block execution matches single-sample execution
+//
+void autotest_resamp_crcf_block()
+{
+    unsigned int nx = 3000;
+    float r = 1.37f;
+    unsigned int i;
+
+    float complex x[nx];
+    float complex y0[2*nx];
+    float complex y1[2*nx];
+    for (i=0; i<nx; i++)
+        x[i] = (rand() % 1000 - 500)*2e-3f + _Complex_I*(rand() % 1000 - 500)*2e-3f;
+
+    resamp_crcf q0 = resamp_crcf_create(r,7,0.4f,60.0f,64);
+    resamp_crcf q1 = resamp_crcf_create(r,7,0.4f,60.0f,64);
+
+    // one sample at a time
+    unsigned int ny0 = 0, nw;
+    for (i=0; i<nx; i++) {
+        resamp_crcf_execute(q0, x[i], &y0[ny0], &nw);
+        ny0 += nw;
+    }
+
+    // blocks of irregular size (longer than internal buffer)
+    unsigned int ny1 = 0;
+    unsigned int k=0, b=1;
+    while (k < nx) {
+        unsigned int nb = k + b > nx ? nx - k : b;
+        resamp_crcf_execute_block(q1, &x[k], nb, &y1[ny1], &nw);
+        ny1 += nw;
+        k += nb;
+        b = 3*b + 1;
+    }
+
+    CONTEND_EQUALITY(ny0, ny1);
+    CONTEND_SAME_DATA(y0, y1, ny0*sizeof(float complex));
+
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+}
+
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// generate QPSK signal with _k samples/symbol and fractional delay _dt
+void symsync_crcf_autotest_gen(unsigned int    _k,
+                               unsigned int    _m,
+                               float           _beta,
+                               float           _dt,
+                               float complex * _x,
+                               unsigned int    _num_symbols)
+{
+    firinterp_crcf interp = firinterp_crcf_create_rnyquist(LIQUID_RNYQUIST_RRC,
+                                                           _k, _m, _beta, _dt);
+    unsigned int i;
+    for (i=0; i<_num_symbols; i++) {
+        float complex s = ((rand() % 2) ? M_SQRT1_2 : -M_SQRT1_2) +
+                          ((rand() % 2) ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+        firinterp_crcf_execute(interp, s, &_x[i*_k]);
+    }
+    firinterp_crcf_destroy(interp);
+}
+
+// 
+// AUTOTEST: block execution is independent of input block size
+//
+void autotest_symsync_crcf_block()
+{
+    unsigned int k  = 8;
+    unsigned int m  = 3;
+    unsigned int num_symbols = 400;
+    unsigned int nx = k*num_symbols;
+
+    float complex x[nx];
+    float complex y0[nx];
+    float complex y1[nx];
+    symsync_crcf_autotest_gen(k, m, 0.3f, -0.3f, x, num_symbols);
+
+    symsync_crcf q0 = symsync_crcf_create_rnyquist(LIQUID_RNYQUIST_RRC, k, m, 0.3f, 32);
+    symsync_crcf q1 = symsync_crcf_create_rnyquist(LIQUID_RNYQUIST_RRC, k, m, 0.3f, 32);
+    symsync_crcf_set_output_rate(q0, 2);
+    symsync_crcf_set_output_rate(q1, 2);
+
+    // one sample at a time
+    unsigned int i, ny0 = 0, nw;
+    for (i=0; i<nx; i++) {
+        symsync_crcf_execute(q0, &x[i], 1, &y0[ny0], &nw);
+        ny0 += nw;
+    }
+
+    // blocks of irregular size (longer than internal buffer)
+    unsigned int ny1 = 0;
+    unsigned int n=0, b=1;
+    while (n < nx) {
+        unsigned int nb = n + b > nx ? nx - n : b;
+        symsync_crcf_execute(q1, &x[n], nb, &y1[ny1], &nw);
+        ny1 += nw;
+        n += nb;
+        b = 3*b + 1;
+    }
+
+    symsync_crcf_destroy(q0);
+    symsync_crcf_destroy(q1);
+
+    CONTEND_EQUALITY( ny0, ny1 );
+    for (i=0; i<ny0 && i<ny1; i++) {
+        CONTEND_DELTA( crealf(y0[i]), crealf(y1[i]), 1e-6f );
+        CONTEND_DELTA( cimagf(y0[i]), cimagf(y1[i]), 1e-6f );
+    }
+}
+
+// 
+// AUTOTEST: each kernel gives the same output and timing phase
+//
+void autotest_symsync_crcf_simd()
+{
+    float tol = 1e-4f;
+    unsigned int k  = 8;
+    unsigned int m  = 5;
+    unsigned int num_symbols = 300;
+    unsigned int nx = k*num_symbols;
+    unsigned int masks[3] = {
+        ~0U,                                    // all extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        0,                                      // no extensions
+    };
+
+    float complex x[nx];
+    float complex y[3][nx];
+    unsigned int  ny[3];
+    float         tau[3];
+    symsync_crcf_autotest_gen(k, m, 0.3f, 0.2f, x, num_symbols);
+
+    unsigned int i;
+    for (i=0; i<3; i++) {
+        liquid_cpu_set_mask(masks[i]);
+        symsync_crcf q = symsync_crcf_create_rnyquist(LIQUID_RNYQUIST_RRC, k, m, 0.3f, 32);
+        symsync_crcf_execute(q, x, nx, y[i], &ny[i]);
+        tau[i] = symsync_crcf_get_tau(q);
+        symsync_crcf_destroy(q);
+    }
+    liquid_cpu_set_mask(~0U);
+
+    for (i=1; i<3; i++) {
+        CONTEND_EQUALITY( ny[i], ny[0] );
+        CONTEND_DELTA( tau[i], tau[0], tol );
+
+        unsigned int j;
+        for (j=0; j<ny[0] && j<ny[i]; j++) {
+            CONTEND_DELTA( crealf(y[i][j]), crealf(y[0][j]), tol );
+            CONTEND_DELTA( cimagf(y[i][j]), cimagf(y[0][j]), tol );
+        }
+    }
+}
+
+// 
+// AUTOTEST: timing recovery at 8 samples/symbol
+//
+void autotest_symsync_crcf_timing()
+{
+    unsigned int k  = 8;
+    unsigned int m  = 3;
+    float beta      = 0.3f;
+    unsigned int num_symbols = 800;
+    unsigned int nx = k*num_symbols;
+
+    // offset signal by 3/8 of a symbol
+    unsigned int d = 3;
+    float complex x[nx];
+    float complex y[num_symbols + 4];
+    unsigned int i;
+    for (i=0; i<d; i++)
+        x[i] = 0.0f;
+    symsync_crcf_autotest_gen(k, m, beta, -0.4f, &x[d], num_symbols-1);
+
+    symsync_crcf q = symsync_crcf_create_rnyquist(LIQUID_RNYQUIST_RRC, k, m, beta, 32);
+    symsync_crcf_set_lf_bw(q, 0.02f);
+    unsigned int ny;
+    symsync_crcf_execute(q, x, d + k*(num_symbols-1), y, &ny);
+    symsync_crcf_destroy(q);
+
+    // measure error vector magnitude of second half of symbols,
+    // normalizing by the average signal level
+    unsigned int n0 = ny / 2;
+    float g = 0.0f;
+    for (i=n0; i<ny; i++)
+        g += fabsf(crealf(y[i])) + fabsf(cimagf(y[i]));
+    g = 2.0f*M_SQRT1_2*(ny-n0) / g;
+
+    float e = 0.0f;
+    for (i=n0; i<ny; i++) {
+        float complex v = y[i]*g;
+        float complex s = (crealf(v) > 0 ? M_SQRT1_2 : -M_SQRT1_2) +
+                          (cimagf(v) > 0 ? M_SQRT1_2 : -M_SQRT1_2) * _Complex_I;
+        e += crealf( (v-s)*conjf(v-s) );
+    }
+    float evm = 10*log10f(e / (float)(ny-n0));
+
+    if (liquid_autotest_verbose)
+        printf("  symsync_crcf timing: %u symbols, evm = %8.2f dB\n", ny, evm);
+
+    CONTEND_DELTA( (float)ny, (float)num_symbols, 2.0f );
+    CONTEND_LESS_THAN( evm, -20.0f );
+}
@@ -90,3 +90,70 @@ void benchmark_detector_cccf_64   DETECTOR_CCCF_BENCHMARK_API(64);
 void benchmark_detector_cccf_128  DETECTOR_CCCF_BENCHMARK_API(128);
 void benchmark_detector_cccf_256  DETECTOR_CCCF_BENCHMARK_API(256);
 
+
+// Helper function to keep code base small (block correlator)
+void detector_cccf_bench_block(struct rusage *     _start,
+                               struct rusage *     _finish,
+                               unsigned long int * _num_iterations,
+                               unsigned int        _n)
+{
+    // adjust number of iterations
+    *_num_iterations *= 4;
+    *_num_iterations /= _n;
+
+    // generate sequence (random)
+    float complex h[_n];
+    unsigned long int i;
+    for (i=0; i<_n; i++) {
+        h[i] = (rand() % 2 ? 1.0f : -1.0f) +
+               (rand() % 2 ? 1.0f : -1.0f)*_Complex_I;
+    }
+
+    // generate synchronizer
+    float threshold = 0.5f;
+    float dphi_max  = 0.07f;
+    detector_cccf q = detector_cccf_create(h, _n, threshold, dphi_max);
+
+    // input sequence (random)
+    unsigned int block_len = 256;
+    float complex x[block_len];
+    for (i=0; i<block_len; i++) {
+        x[i] = (rand() % 2 ? 1.0f : -1.0f) +
+               (rand() % 2 ? 1.0f : -1.0f)*_Complex_I;
+    }
+
+    float tau_hat;
+    float dphi_hat;
+    float gamma_hat;
+    unsigned int num_read;
+
+    // start trials
+    unsigned long int num_blocks = *_num_iterations / 16 + 1;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_blocks; i++) {
+        // push input block through synchronizer
+        unsigned int n = 0;
+        while (n < block_len) {
+            detector_cccf_correlate_block(q, &x[n], block_len - n, &num_read,
+                                          &tau_hat, &dphi_hat, &gamma_hat);
+            n += num_read;
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_blocks * block_len;
+
+    // clean up allocated objects
+    detector_cccf_destroy(q);
+}
+
+#define DETECTOR_CCCF_BLOCK_BENCHMARK_API(N)\
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ detector_cccf_bench_block(_start, _finish, _num_iterations, N); }
+
+void benchmark_detector_cccf_block_16   DETECTOR_CCCF_BLOCK_BENCHMARK_API(16);
+void benchmark_detector_cccf_block_32   DETECTOR_CCCF_BLOCK_BENCHMARK_API(32);
+void benchmark_detector_cccf_block_64   DETECTOR_CCCF_BLOCK_BENCHMARK_API(64);
+void benchmark_detector_cccf_block_128  DETECTOR_CCCF_BLOCK_BENCHMARK_API(128);
+void benchmark_detector_cccf_block_256  DETECTOR_CCCF_BLOCK_BENCHMARK_API(256);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <math.h>
+#include "liquid.h"
+
+// Helper function to keep code base small: idle-listening (noise
+// only) on all channels, either with a framesyncbank object or with
+// one framesync64 object per channel fed by a channelizer
+void framesyncbank_bench(struct rusage *     _start,
+                         struct rusage *     _finish,
+                         unsigned long int * _num_iterations,
+                         unsigned int        _num_channels,
+                         int                 _bank)
+{
+    // adjust number of iterations
+    *_num_iterations /= 4;
+
+    unsigned long int i;
+    unsigned int c;
+    unsigned int m  = 4;        // channelizer filter semi-length
+    float        As = 60.0f;    // channelizer stop-band attenuation [dB]
+
+    // input: noise
+    unsigned int num_samples = 64*_num_channels;
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = (randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    framesyncbank q = NULL;
+    firpfbch_crcf channelizer = NULL;
+    framesync64 fs[_num_channels];
+    float complex y[num_samples];
+    float complex yc[64];
+    if (_bank) {
+        q = framesyncbank_create(LIQUID_FRAMESYNCBANK_FRAMESYNC64,
+                                 _num_channels, m, As, NULL, NULL);
+    } else {
+        channelizer = firpfbch_crcf_create_kaiser(LIQUID_ANALYZER, _num_channels, m, As);
+        for (c=0; c<_num_channels; c++)
+            fs[c] = framesync64_create(NULL, NULL);
+    }
+
+    // start trials
+    unsigned long int num_blocks = *_num_iterations / num_samples + 1;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_blocks; i++) {
+        if (_bank) {
+            framesyncbank_execute(q, x, num_samples);
+        } else {
+            // channelize and run each channel through its synchronizer
+            firpfbch_crcf_analyzer_execute_block(channelizer, x, 64, y);
+            for (c=0; c<_num_channels; c++) {
+                unsigned int j;
+                for (j=0; j<64; j++)
+                    yc[j] = y[j*_num_channels + c];
+                framesync64_execute(fs[c], yc, 64);
+            }
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_blocks * num_samples;
+
+    // clean up allocated objects
+    if (_bank) {
+        framesyncbank_destroy(q);
+    } else {
+        firpfbch_crcf_destroy(channelizer);
+        for (c=0; c<_num_channels; c++)
+            framesync64_destroy(fs[c]);
+    }
+}
+
+#define FRAMESYNCBANK_BENCHMARK_API(M,BANK) \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ framesyncbank_bench(_start, _finish, _num_iterations, M, BANK); }
+
+void benchmark_framesyncbank_M16        FRAMESYNCBANK_BENCHMARK_API(16,  1);
+void benchmark_framesyncbank_M64        FRAMESYNCBANK_BENCHMARK_API(64,  1);
+void benchmark_framesyncbank_M128       FRAMESYNCBANK_BENCHMARK_API(128, 1);
+void benchmark_framesyncbank_M16_indep  FRAMESYNCBANK_BENCHMARK_API(16,  0);
+void benchmark_framesyncbank_M64_indep  FRAMESYNCBANK_BENCHMARK_API(64,  0);
+void benchmark_framesyncbank_M128_indep FRAMESYNCBANK_BENCHMARK_API(128, 0);
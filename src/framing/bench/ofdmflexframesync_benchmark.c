@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define OFDMFLEXFRAMESYNC_BENCH_API(M,FEC,NUM_THREADS)  \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ ofdmflexframesync_bench(_start, _finish, _num_iterations, M, FEC, NUM_THREADS); }
+
+// count frames received
+static int ofdmflexframesync_bench_callback(unsigned char *  _header,
+                                            int              _header_valid,
+                                            unsigned char *  _payload,
+                                            unsigned int     _payload_len,
+                                            int              _payload_valid,
+                                            framesyncstats_s _stats,
+                                            void *           _userdata)
+{
+    unsigned int * num_frames = (unsigned int*) _userdata;
+    if (_header_valid && _payload_valid)
+        (*num_frames)++;
+    return 0;
+}
+
+// Helper function to keep code base small
+void ofdmflexframesync_bench(struct rusage *     _start,
+                             struct rusage *     _finish,
+                             unsigned long int * _num_iterations,
+                             unsigned int        _M,
+                             fec_scheme          _fec,
+                             unsigned int        _num_threads)
+{
+    unsigned int M           = _M;          // number of subcarriers
+    unsigned int cp_len      = _M / 4;      // cyclic prefix length
+    unsigned int payload_len = 1000;        // payload length [bytes]
+
+    // generate frame
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check      = LIQUID_CRC_32;
+    fgprops.fec0       = _fec;
+    fgprops.fec1       = LIQUID_FEC_NONE;
+    fgprops.mod_scheme = LIQUID_MODEM_QAM16;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, 0, NULL, &fgprops);
+
+    unsigned long int i;
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[payload_len];
+    for (i=0; i<payload_len; i++)
+        payload[i] = rand() & 0xff;
+    ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+    // frame followed by a gap of one symbol
+    unsigned int num_symbols = ofdmflexframegen_getframelen(fg) + 1;
+    unsigned int num_samples = num_symbols*(M + cp_len);
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    int last_symbol = 0;
+    for (i=0; !last_symbol; i++)
+        last_symbol = ofdmflexframegen_writesymbol(fg, &x[i*(M+cp_len)]);
+    for (i *= M+cp_len; i<num_samples; i++)
+        x[i] = 0.0f;
+    for (i=0; i<num_samples; i++)
+        x[i] += 0.01f*randnf()*cexpf(_Complex_I*2*M_PI*randf());
+
+    // create synchronizer
+    unsigned int num_frames = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, 0, NULL,
+            ofdmflexframesync_bench_callback, (void*)&num_frames);
+    ofdmflexframesync_set_num_threads(fs, _num_threads);
+
+    // normalize number of iterations
+    *_num_iterations /= num_samples;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        ofdmflexframesync_execute(fs, x, num_samples);
+    ofdmflexframesync_flush(fs);
+    getrusage(RUSAGE_SELF, _finish);
+
+    if (num_frames != *_num_iterations)
+        fprintf(stderr,"warning: ofdmflexframesync_bench(), received %u of %lu frames\n", num_frames, *_num_iterations);
+
+    // destroy objects
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+    free(x);
+}
+
+// frames of 1000 bytes, 16-QAM; 1, 2 and 3 threads
+void benchmark_ofdmflexframesync_n256_h128_t1 OFDMFLEXFRAMESYNC_BENCH_API(256, LIQUID_FEC_HAMMING128, 1)
+void benchmark_ofdmflexframesync_n256_h128_t2 OFDMFLEXFRAMESYNC_BENCH_API(256, LIQUID_FEC_HAMMING128, 2)
+void benchmark_ofdmflexframesync_n256_h128_t3 OFDMFLEXFRAMESYNC_BENCH_API(256, LIQUID_FEC_HAMMING128, 3)
+void benchmark_ofdmflexframesync_n256_v27_t1  OFDMFLEXFRAMESYNC_BENCH_API(256, LIQUID_FEC_CONV_V27,   1)
+void benchmark_ofdmflexframesync_n256_v27_t2  OFDMFLEXFRAMESYNC_BENCH_API(256, LIQUID_FEC_CONV_V27,   2)
+void benchmark_ofdmflexframesync_n256_v27_t3  OFDMFLEXFRAMESYNC_BENCH_API(256, LIQUID_FEC_CONV_V27,   3)
+
@@ -44,9 +44,27 @@
 void detector_cccf_update_sumsq(detector_cccf _q,
                                 float complex _x);
 
+// push sample into buffers and update timer; returns '1' if
+// correlator outputs are needed for this sample, '0' otherwise
+int detector_cccf_push(detector_cccf _q,
+                       float complex _x);
+
 // compute all dot product outputs
 void detector_cccf_compute_dotprods(detector_cccf _q);
 
+// compute magnitude of all correlator outputs for a block of input
+// samples using overlap-save fast convolution
+void detector_cccf_compute_block(detector_cccf   _q,
+                                 float complex * _x,
+                                 unsigned int    _n);
+
+// update detection state from current correlator outputs; returns
+// '1' if signal was detected, '0' otherwise
+int detector_cccf_update_state(detector_cccf _q,
+                               float *       _tau_hat,
+                               float *       _dphi_hat,
+                               float *       _gamma_hat);
+
 // estimate carrier and timing offsets
 void detector_cccf_estimate_offsets(detector_cccf _q,
                                     float *       _tau_hat,
@@ -72,12 +90,27 @@ struct detector_cccf_s {
     float   dphi_step;      // step size for each correlator
     float   dphi_max;       // maximum carrier offset
     float * dphi;           // correlator frequencies [size: m x 1]
+    float * rxy_mem;        // memory for correlator outputs [size: 3m x 1]
     float * rxy;            // correlator outputs [size: m x 1]
     float * rxy0;           // buffered correlator outputs [size: m x 1]
     float * rxy1;           // buffered correlator outputs [size: m x 1]
     unsigned int imax;      // index of maximum
     unsigned int idetect;   // index of detection
 
+    // block correlators (overlap-save)
+    unsigned int nfft;      // transform size
+    unsigned int block_len; // number of outputs per transform: nfft-n+1
+    float complex * H;      // spectra of reversed, pre-spun sequences
+                            // scaled by 1/nfft [size: m x nfft]
+    float complex * buf_time;   // fft input [size: nfft x 1]
+    float complex * buf_freq;   // fft output [size: nfft x 1]
+    float complex * buf_prod;   // ifft input [size: nfft x 1]
+    float complex * buf_out;    // ifft output [size: nfft x 1]
+    FFT_PLAN fft;           // forward transform (buf_time -> buf_freq)
+    FFT_PLAN ifft;          // inverse transform (buf_prod -> buf_out)
+    float * rxy_block;      // scaled correlator magnitudes for block
+                            // [size: m x block_len]
+
     // estimation of E{|x|^2}
     wdelayf x2;             // buffer of |x|^2 values
     float x2_sum;           // sum{ |x|^2 }
@@ -150,9 +183,10 @@ detector_cccf detector_cccf_create(float complex * _s,
     // create internal correlators (dot products)
     q->dp   = (dotprod_cccf*) malloc((q->m)*sizeof(dotprod_cccf));
     q->dphi = (float*)        malloc((q->m)*sizeof(float));
-    q->rxy0 = (float*)        malloc((q->m)*sizeof(float));
-    q->rxy1 = (float*)        malloc((q->m)*sizeof(float));
-    q->rxy  = (float*)        malloc((q->m)*sizeof(float));
+    q->rxy_mem = (float*)     malloc((3*q->m)*sizeof(float));
+    q->rxy0 = q->rxy_mem;
+    q->rxy1 = q->rxy_mem + q->m;
+    q->rxy  = q->rxy_mem + 2*q->m;
     unsigned int k;
     float complex sconj[q->n];
     for (k=0; k<q->m; k++) {
@@ -163,6 +197,33 @@ detector_cccf detector_cccf_create(float complex * _s,
         q->dp[k] = dotprod_cccf_create(sconj, q->n);
     }
 
+    // create block correlators: transform size is at least four times
+    // the sequence length so that each transform yields about 3n outputs
+    q->nfft      = 1 << liquid_nextpow2(4*q->n);
+    q->block_len = q->nfft - q->n + 1;
+    q->H         = (float complex*) malloc((q->m)*(q->nfft)*sizeof(float complex));
+    q->buf_time  = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->buf_freq  = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->buf_prod  = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->buf_out   = (float complex*) malloc((q->nfft)*sizeof(float complex));
+    q->rxy_block = (float*)         malloc((q->m)*(q->block_len)*sizeof(float));
+    q->fft  = FFT_CREATE_PLAN(q->nfft, q->buf_time, q->buf_freq, FFT_DIR_FORWARD,  FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN(q->nfft, q->buf_prod, q->buf_out,  FFT_DIR_BACKWARD, FFT_METHOD);
+    for (k=0; k<q->m; k++) {
+        // reverse pre-spun sequence so that convolution yields
+        // correlation, and compute its (scaled) transform
+        for (i=0; i<q->nfft; i++) {
+            if (i < q->n) {
+                unsigned int j = q->n - i - 1;
+                q->buf_time[i] = conjf(q->s[j]) * cexpf(-_Complex_I*q->dphi[k]*j) / (float)(q->nfft);
+            } else {
+                q->buf_time[i] = 0.0f;
+            }
+        }
+        FFT_EXECUTE(q->fft);
+        memmove(&q->H[k*q->nfft], q->buf_freq, q->nfft*sizeof(float complex));
+    }
+
     // reset state
     detector_cccf_reset(q);
 
@@ -192,9 +253,17 @@ void detector_cccf_destroy(detector_cccf _q)
         dotprod_cccf_destroy(_q->dp[k]);
     free(_q->dp);
     free(_q->dphi);
-    free(_q->rxy);
-    free(_q->rxy0);
-    free(_q->rxy1);
+    free(_q->rxy_mem);
+
+    // destroy block correlators
+    FFT_DESTROY_PLAN(_q->fft);
+    FFT_DESTROY_PLAN(_q->ifft);
+    free(_q->H);
+    free(_q->buf_time);
+    free(_q->buf_freq);
+    free(_q->buf_prod);
+    free(_q->buf_out);
+    free(_q->rxy_block);
 
     // destroy |x|^2 buffer
     wdelayf_destroy(_q->x2);
@@ -213,6 +282,7 @@ void detector_cccf_print(detector_cccf _q)
     printf("    threshold           :   %8.4f\n", _q->threshold);
     printf("    maximum carrier     :   %8.4f rad/sample\n", _q->dphi_max);
     printf("    num. correlators    :   %u\n", _q->m);
+    printf("    block fft size      :   %u\n", _q->nfft);
 }
 
 void detector_cccf_reset(detector_cccf _q)
@@ -232,6 +302,7 @@ void detector_cccf_reset(detector_cccf _q)
     //memset(_q->rxy, 0x00, sizeof(_q->rxy));
     memset(_q->rxy0, 0x00, _q->m*sizeof(float));
     memset(_q->rxy1, 0x00, _q->m*sizeof(float));
+    memset(_q->rxy,  0x00, _q->m*sizeof(float));
 }
 
 // Run sample through pre-demod detector's correlator.
@@ -247,82 +318,126 @@ int detector_cccf_correlate(detector_cccf _q,
                             float *       _dphi_hat,
                             float *       _gamma_hat)
 {
-    // push sample into buffer
-    windowcf_push(_q->buffer, _x);
-
-    // update sum{|x|^2}
-    detector_cccf_update_sumsq(_q, _x);
-
-#if DEBUG_DETECTOR
-    windowcf_push(_q->debug_x, _x);
-    windowf_push(_q->debug_x2, _q->x2_hat);
-#endif
-    // return if no timeout
-    if (_q->timer) {
-        // hasn't timed out yet
-        //printf("timer = %u\n", _q->timer);
-        _q->timer--;
-#if DEBUG_DETECTOR
-        windowf_push(_q->debug_rxy, 0.0f);
-#endif
+    // push sample into buffers; return if no timeout
+    if (!detector_cccf_push(_q, _x))
         return 0;
-    }
 
-    // save previous correlator outputs
-    memmove(_q->rxy0, _q->rxy1, _q->m*sizeof(float));
-    memmove(_q->rxy1, _q->rxy,  _q->m*sizeof(float));
+    // save previous correlator outputs (rotate buffers)
+    float * rxy = _q->rxy0;
+    _q->rxy0 = _q->rxy1;
+    _q->rxy1 = _q->rxy;
+    _q->rxy  = rxy;
 
     // compute vector dot products
     detector_cccf_compute_dotprods(_q);
 
-    // find max{rxy}
-    float rxy_abs = _q->rxy[ _q->imax ];
+    // update detection state
+    return detector_cccf_update_state(_q, _tau_hat, _dphi_hat, _gamma_hat);
+}
+
+// Run block of samples through pre-demod detector's correlator,
+// stopping once a signal is detected. The result is the same as
+// running each sample through detector_cccf_correlate(), but the
+// correlator outputs are computed for many samples at once with
+// fast (overlap-save) convolution.
+// Returns '1' if signal was detected, '0' otherwise
+//  _q          :   pre-demod detector
+//  _x          :   input samples [size: _n x 1]
+//  _n          :   number of input samples
+//  _num_read   :   number of samples consumed; when a signal is
+//                  detected this includes the detection sample
+//  _tau_hat    :   fractional sample offset estimate (set when detected)
+//  _dphi_hat   :   carrier frequency offset estimate (set when detected)
+//  _gamma_hat  :   channel gain estimate (set when detected)
+int detector_cccf_correlate_block(detector_cccf   _q,
+                                  float complex * _x,
+                                  unsigned int    _n,
+                                  unsigned int *  _num_read,
+                                  float *         _tau_hat,
+                                  float *         _dphi_hat,
+                                  float *         _gamma_hat)
+{
+    unsigned int i, k, n;
+    for (k=0; k<_n; k+=n) {
+        n = _n - k < _q->block_len ? _n - k : _q->block_len;
+
+        // skip computing correlators while timer covers block
+        if (_q->timer >= n) {
+            for (i=0; i<n; i++)
+                detector_cccf_push(_q, _x[k+i]);
+            continue;
+        }
+
+        // compute correlator outputs for entire block
+        detector_cccf_compute_block(_q, _x+k, n);
+
+        // Run detector over block; the buffers are not updated for
+        // each sample: the sample leaving the window is read from the
+        // overlap-save input frame (previous n-1 samples followed by
+        // block) and the buffers are re-filled once the block is done.
+        float complex * r;
+        windowcf_read(_q->buffer, &r);
+        float complex * f = _q->buf_time;
+        int detected = 0;
+        for (i=0; i<n && !detected; i++) {
+            // update sum{|x|^2}
+            float complex x_n = _x[k+i];            // input sample
+            float complex x_0 = i==0 ? r[0] : f[i-1];   // oldest sample
+            float x2_n = crealf(x_n * conjf(x_n));
+            float x2_0 = crealf(x_0 * conjf(x_0));
+            _q->x2_sum = _q->x2_sum + x2_n - x2_0;
+            _q->x2_hat = _q->x2_sum * _q->n_inv;
 
 #if DEBUG_DETECTOR
-    windowf_push(_q->debug_rxy, rxy_abs);
+            windowcf_push(_q->debug_x, x_n);
+            windowf_push(_q->debug_x2, _q->x2_hat);
 #endif
-    
-    if (_q->state == DETECTOR_STATE_SEEK) {
-        // check to see if value exceeds threshold
-        if (rxy_abs > _q->threshold) {
-#if DEBUG_DETECTOR_PRINT
-            printf("threshold exceeded:      rxy = %8.4f\n", rxy_abs);
+            // continue if no timeout
+            if (_q->timer) {
+                _q->timer--;
+#if DEBUG_DETECTOR
+                windowf_push(_q->debug_rxy, 0.0f);
 #endif
-            _q->idetect = _q->imax;
-            _q->state = DETECTOR_STATE_FINDMAX;
+                continue;
+            }
+
+            // save previous correlator outputs (rotate buffers)
+            float * rxy = _q->rxy0;
+            _q->rxy0 = _q->rxy1;
+            _q->rxy1 = _q->rxy;
+            _q->rxy  = rxy;
+
+            // scale correlator outputs and find index of maximum
+            unsigned int j;
+            float g = 1.0f / sqrtf(_q->x2_hat);
+            float rxy_max = 0;
+            for (j=0; j<_q->m; j++) {
+                _q->rxy[j] = _q->rxy_block[j*_q->block_len + i] * g;
+                if (_q->rxy[j] > rxy_max) {
+                    rxy_max = _q->rxy[j];
+                    _q->imax = j;
+                }
+            }
+
+            // update detection state
+            detected = detector_cccf_update_state(_q, _tau_hat, _dphi_hat, _gamma_hat);
         }
-    } else if (_q->state == DETECTOR_STATE_FINDMAX) {
-        // see if this new value exceeds maximum
-        if ( _q->rxy[_q->imax] > _q->rxy1[_q->idetect] ) {
-#if DEBUG_DETECTOR_PRINT
-            printf("maximum not yet reached: rxy = %8.4f\n", rxy_abs);
-#endif
-            // set new index of maximum
-            _q->idetect = _q->imax;
-        } else {
-            // peak was found last time; run estimates, reset values,
-            // and return
-#if DEBUG_DETECTOR_PRINT
-            printf("maximum found:           rxy = %8.4f\n", rxy_abs);
-#endif
-            
-            // estimate timing and carrier offsets
-            detector_cccf_estimate_offsets(_q, _tau_hat, _dphi_hat);
-
-            *_gamma_hat = sqrtf(_q->x2_hat);
 
-            // soft state reset
-            _q->state = DETECTOR_STATE_SEEK;
-            // set timer to allow signal to settle
-            _q->timer = _q->n/4;
+        // re-fill buffers with the last (at most n) samples consumed
+        unsigned int j;
+        for (j = i > _q->n ? i - _q->n : 0; j<i; j++) {
+            float complex v = _x[k+j];
+            windowcf_push(_q->buffer, v);
+            wdelayf_push(_q->x2, crealf(v * conjf(v)));
+        }
 
+        if (detected) {
+            *_num_read = k + i;
             return 1;
         }
-    } else {
-        fprintf(stderr,"error: detector_cccf_correlate(), unknown/unsupported internal state\n");
-        exit(1);
     }
 
+    *_num_read = _n;
     return 0;
 }
 
@@ -350,6 +465,33 @@ void detector_cccf_update_sumsq(detector_cccf _q,
 
 }
 
+// push sample into buffers and update timer; returns '1' if
+// correlator outputs are needed for this sample, '0' otherwise
+int detector_cccf_push(detector_cccf _q,
+                       float complex _x)
+{
+    // push sample into buffer
+    windowcf_push(_q->buffer, _x);
+
+    // update sum{|x|^2}
+    detector_cccf_update_sumsq(_q, _x);
+
+#if DEBUG_DETECTOR
+    windowcf_push(_q->debug_x, _x);
+    windowf_push(_q->debug_x2, _q->x2_hat);
+#endif
+    // return if no timeout
+    if (_q->timer) {
+        // hasn't timed out yet
+        _q->timer--;
+#if DEBUG_DETECTOR
+        windowf_push(_q->debug_rxy, 0.0f);
+#endif
+        return 0;
+    }
+    return 1;
+}
+
 // compute all dot product outputs
 void detector_cccf_compute_dotprods(detector_cccf _q)
 {
@@ -389,6 +531,101 @@ void detector_cccf_compute_dotprods(detector_cccf _q)
 #endif
 }
 
+// compute magnitude of all correlator outputs for a block of input
+// samples using overlap-save fast convolution; output i corresponds
+// to the buffer state after pushing sample _x[i]
+void detector_cccf_compute_block(detector_cccf   _q,
+                                 float complex * _x,
+                                 unsigned int    _n)
+{
+    // read buffer: last n-1 samples precede new input
+    float complex * r;
+    windowcf_read(_q->buffer, &r);
+    memmove(_q->buf_time, r+1, (_q->n-1)*sizeof(float complex));
+    memmove(_q->buf_time + _q->n - 1, _x, _n*sizeof(float complex));
+    memset(_q->buf_time + _q->n - 1 + _n, 0x00, (_q->block_len - _n)*sizeof(float complex));
+
+    // compute transform of input
+    FFT_EXECUTE(_q->fft);
+
+    unsigned int i, k;
+    for (k=0; k<_q->m; k++) {
+        // multiply by correlator spectrum and compute inverse transform
+        float complex * H = &_q->H[k*_q->nfft];
+        for (i=0; i<_q->nfft; i++) {
+            float xr = crealf(_q->buf_freq[i]), xi = cimagf(_q->buf_freq[i]);
+            float hr = crealf(H[i]),            hi = cimagf(H[i]);
+            _q->buf_prod[i] = (xr*hr - xi*hi) + _Complex_I*(xr*hi + xi*hr);
+        }
+        FFT_EXECUTE(_q->ifft);
+
+        // save scaled magnitude of valid outputs
+        float * rxy = &_q->rxy_block[k*_q->block_len];
+        for (i=0; i<_n; i++) {
+            float complex v = _q->buf_out[_q->n-1+i];
+            rxy[i] = sqrtf(crealf(v)*crealf(v) + cimagf(v)*cimagf(v)) * _q->n_inv;
+        }
+    }
+}
+
+// update detection state from current correlator outputs; returns
+// '1' if signal was detected, '0' otherwise
+int detector_cccf_update_state(detector_cccf _q,
+                               float *       _tau_hat,
+                               float *       _dphi_hat,
+                               float *       _gamma_hat)
+{
+    // find max{rxy}
+    float rxy_abs = _q->rxy[ _q->imax ];
+
+#if DEBUG_DETECTOR
+    windowf_push(_q->debug_rxy, rxy_abs);
+#endif
+    
+    if (_q->state == DETECTOR_STATE_SEEK) {
+        // check to see if value exceeds threshold
+        if (rxy_abs > _q->threshold) {
+#if DEBUG_DETECTOR_PRINT
+            printf("threshold exceeded:      rxy = %8.4f\n", rxy_abs);
+#endif
+            _q->idetect = _q->imax;
+            _q->state = DETECTOR_STATE_FINDMAX;
+        }
+    } else if (_q->state == DETECTOR_STATE_FINDMAX) {
+        // see if this new value exceeds maximum
+        if ( _q->rxy[_q->imax] > _q->rxy1[_q->idetect] ) {
+#if DEBUG_DETECTOR_PRINT
+            printf("maximum not yet reached: rxy = %8.4f\n", rxy_abs);
+#endif
+            // set new index of maximum
+            _q->idetect = _q->imax;
+        } else {
+            // peak was found last time; run estimates, reset values,
+            // and return
+#if DEBUG_DETECTOR_PRINT
+            printf("maximum found:           rxy = %8.4f\n", rxy_abs);
+#endif
+            
+            // estimate timing and carrier offsets
+            detector_cccf_estimate_offsets(_q, _tau_hat, _dphi_hat);
+
+            *_gamma_hat = sqrtf(_q->x2_hat);
+
+            // soft state reset
+            _q->state = DETECTOR_STATE_SEEK;
+            // set timer to allow signal to settle
+            _q->timer = _q->n/4;
+
+            return 1;
+        }
+    } else {
+        fprintf(stderr,"error: detector_cccf_correlate(), unknown/unsupported internal state\n");
+        exit(1);
+    }
+
+    return 0;
+}
+
 // estimate carrier and timing offsets
 void detector_cccf_estimate_offsets(detector_cccf _q,
                                     float *       _tau_hat,
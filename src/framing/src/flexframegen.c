@@ -74,14 +74,14 @@ struct flexframegen_s {
     packetizer p_header;                // header packetizer
     unsigned char header[FLEXFRAME_H_DEC];      // header data (uncoded)
     unsigned char header_enc[FLEXFRAME_H_ENC];  // header data (encoded)
-    unsigned char header_sym[FLEXFRAME_H_SYM];  // header symbols
+    float complex header_mod[FLEXFRAME_H_SYM];  // modulated header symbols
 
     // payload
     packetizer p_payload;               // payload packetizer
     unsigned int payload_dec_len;       // payload length (num un-encoded bytes)
     modem mod_payload;                  // payload modulator
     unsigned char * payload_enc;        // payload data (encoded bytes)
-    unsigned char * payload_mod;        // payload symbols (modem input)
+    float complex * payload_mod;        // modulated payload symbols
     unsigned int payload_enc_len;       // length of encoded payload
     unsigned int payload_mod_len;       // length of encoded payload
 
@@ -133,10 +133,10 @@ flexframegen flexframegen_create(flexframegenprops_s * _fgprops)
                                      LIQUID_FEC_NONE,
                                      LIQUID_FEC_NONE);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) malloc((q->payload_enc_len+1)*sizeof(unsigned char));
 
     q->payload_mod_len = 1;
-    q->payload_mod = (unsigned char*) malloc(1*sizeof(unsigned char));
+    q->payload_mod = (float complex*) malloc(1*sizeof(float complex));
 
     // create payload modem (initially QPSK, overridden by properties)
     q->mod_payload = modem_create(LIQUID_MODEM_QPSK);
@@ -305,22 +305,10 @@ void flexframegen_assemble(flexframegen    _q,
     packetizer_encode(_q->p_payload, _payload, _q->payload_enc);
     scramble_data(_q->payload_enc, _q->payload_enc_len);
 
-    // 
-    // pack modem symbols
-    //
-
-    // clear payload
-    memset(_q->payload_mod, 0x00, _q->payload_mod_len);
-
-    // repack 8-bit payload bytes into 'bps'-bit payload symbols
-    unsigned int bps = modulation_types[_q->props.mod_scheme].bps;
-    unsigned int num_written;
-    liquid_repack_bytes(_q->payload_enc,  8,  _q->payload_enc_len,
-                        _q->payload_mod, bps, _q->payload_mod_len,
-                        &num_written);
+    // modulate payload
+    flexframegen_modulate_payload(_q);
 
 #if DEBUG_FLEXFRAMEGEN
-    printf("wrote %u symbols (expected %u)\n", num_written, _q->payload_mod_len);
     flexframegen_print(_q);
 #endif
 }
@@ -382,10 +370,11 @@ void flexframegen_reconfigure(flexframegen _q)
                                         _q->props.fec0,
                                         _q->props.fec1);
 
-    // re-allocate memory for encoded message
+    // re-allocate memory for encoded message (with an extra byte for
+    // padding the final modulation symbol)
     _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
     _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
-                                               _q->payload_enc_len*sizeof(unsigned char));
+                                               (_q->payload_enc_len+1)*sizeof(unsigned char));
 #if DEBUG_FLEXFRAMEGEN
     printf(">>>> payload : %u (%u encoded)\n", _q->payload_dec_len, _q->payload_enc_len);
 #endif
@@ -398,8 +387,8 @@ void flexframegen_reconfigure(flexframegen _q)
     unsigned int bps = modulation_types[_q->props.mod_scheme].bps;
     div_t d = div(8*_q->payload_enc_len, bps);
     _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
-    _q->payload_mod = (unsigned char*)realloc(_q->payload_mod,
-                                              _q->payload_mod_len*sizeof(unsigned char));
+    _q->payload_mod = (float complex*)realloc(_q->payload_mod,
+                                              _q->payload_mod_len*sizeof(float complex));
 #if DEBUG_FLEXFRAMEGEN
     printf(">>>> payload mod length : %u\n", _q->payload_mod_len);
 #endif
@@ -454,24 +443,16 @@ void flexframegen_encode_header(flexframegen _q)
 // modulate header into BPSK symbols
 void flexframegen_modulate_header(flexframegen _q)
 {
-    unsigned int i;
-
-    // unpack header symbols
-    for (i=0; i<FLEXFRAME_H_ENC; i++) {
-        _q->header_sym[8*i+0] = (_q->header_enc[i] >> 7) & 0x01;
-        _q->header_sym[8*i+1] = (_q->header_enc[i] >> 6) & 0x01;
-        _q->header_sym[8*i+2] = (_q->header_enc[i] >> 5) & 0x01;
-        _q->header_sym[8*i+3] = (_q->header_enc[i] >> 4) & 0x01;
-        _q->header_sym[8*i+4] = (_q->header_enc[i] >> 3) & 0x01;
-        _q->header_sym[8*i+5] = (_q->header_enc[i] >> 2) & 0x01;
-        _q->header_sym[8*i+6] = (_q->header_enc[i] >> 1) & 0x01;
-        _q->header_sym[8*i+7] = (_q->header_enc[i]     ) & 0x01;
-    }
+    modem_modulate_block(_q->mod_header, _q->header_enc, FLEXFRAME_H_SYM, _q->header_mod);
 }
 
-// modulate payload
+// modulate payload directly from encoded bytes; the final symbol is
+// padded with zeros when the encoded length is not a multiple of the
+// modulation depth
 void flexframegen_modulate_payload(flexframegen _q)
 {
+    _q->payload_enc[_q->payload_enc_len] = 0x00;
+    modem_modulate_block(_q->mod_payload, _q->payload_enc, _q->payload_mod_len, _q->payload_mod);
 }
 
 // write preamble
@@ -504,11 +485,8 @@ void flexframegen_write_header(flexframegen    _q,
     //printf("writing header symbol %u\n", _q->symbol_counter);
 #endif
 
-    float complex s;
-    modem_modulate(_q->mod_header, _q->header_sym[_q->symbol_counter], &s);
-
     // interpolate symbol
-    firinterp_crcf_execute(_q->interp, s, _buffer);
+    firinterp_crcf_execute(_q->interp, _q->header_mod[_q->symbol_counter], _buffer);
 
     // increment symbol counter
     _q->symbol_counter++;
@@ -528,11 +506,8 @@ void flexframegen_write_payload(flexframegen    _q,
     //printf("writing payload symbol %u\n", _q->symbol_counter);
 #endif
 
-    float complex s;
-    modem_modulate(_q->mod_payload, _q->payload_mod[_q->symbol_counter], &s);
-
     // interpolate symbol
-    firinterp_crcf_execute(_q->interp, s, _buffer);
+    firinterp_crcf_execute(_q->interp, _q->payload_mod[_q->symbol_counter], _buffer);
 
     // increment symbol counter
     _q->symbol_counter++;
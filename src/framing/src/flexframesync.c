@@ -39,9 +39,16 @@
 
 #define DEMOD_HEADER_SOFT           1
 
-// push samples through detection stage
-void flexframesync_execute_seekpn(flexframesync _q,
-                                  float complex _x);
+// preamble interpolation properties
+#define FLEXFRAMESYNC_K             (2)     // samples/symbol
+#define FLEXFRAMESYNC_M             (7)     // filter delay (symbols)
+#define FLEXFRAMESYNC_BETA          (0.25f) // excess bandwidth factor
+
+// push samples through detection stage, returning the number
+// of samples consumed
+unsigned int flexframesync_execute_seekpn(flexframesync   _q,
+                                          float complex * _x,
+                                          unsigned int    _n);
 
 // update symbol synchronizer internal state (filtered error, index, etc.)
 //  _q      :   frame synchronizer
@@ -164,26 +171,12 @@ flexframesync flexframesync_create(framesync_callback _callback,
     q->callback = _callback;
     q->userdata = _userdata;
 
-    unsigned int i;
-
-    // generate p/n sequence
-    msequence ms = msequence_create(6, 0x005b, 1);
-    for (i=0; i<64; i++)
-        q->preamble_pn[i] = (msequence_advance(ms)) ? 1.0f : -1.0f;
-    msequence_destroy(ms);
-
-    // interpolate p/n sequence with matched filter
-    q->k    = 2;        // samples/symbol
-    q->m    = 7;        // filter delay (symbols)
-    q->beta = 0.25f;    // excess bandwidth factor
+    // generate p/n sequence and interpolate with matched filter
+    q->k    = FLEXFRAMESYNC_K;      // samples/symbol
+    q->m    = FLEXFRAMESYNC_M;      // filter delay (symbols)
+    q->beta = FLEXFRAMESYNC_BETA;   // excess bandwidth factor
     float complex seq[q->k*64];
-    firinterp_crcf interp = firinterp_crcf_create_rnyquist(LIQUID_RNYQUIST_ARKAISER,q->k,q->m,q->beta,0);
-    for (i=0; i<64+q->m; i++) {
-        // compensate for filter delay
-        if (i < q->m) firinterp_crcf_execute(interp, q->preamble_pn[i],    &seq[0]);
-        else          firinterp_crcf_execute(interp, q->preamble_pn[i%64], &seq[q->k*(i-q->m)]);
-    }
-    firinterp_crcf_destroy(interp);
+    flexframesync_gen_preamble(q->preamble_pn, seq);
 
     // create frame detector
     float threshold = 0.4f;     // detection threshold
@@ -306,6 +299,13 @@ void flexframesync_reset(flexframesync _q)
     _q->framestats.evm = 0.0f;
 }
 
+// is frame synchronizer currently receiving a frame (preamble
+// detected, frame not yet decoded)?
+int flexframesync_is_frame_open(flexframesync _q)
+{
+    return _q->state != STATE_DETECTFRAME;
+}
+
 // execute frame synchronizer
 //  _q     :   frame synchronizer object
 //  _x      :   input sample array [size: _n x 1]
@@ -314,17 +314,19 @@ void flexframesync_execute(flexframesync   _q,
                            float complex * _x,
                            unsigned int    _n)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
+    unsigned int i = 0;
+    while (i < _n) {
+        if (_q->state == STATE_DETECTFRAME) {
+            // detect frame (look for p/n sequence) over as many
+            // samples as possible
+            i += flexframesync_execute_seekpn(_q, &_x[i], _n - i);
+            continue;
+        }
 #if DEBUG_FLEXFRAMESYNC
         if (_q->debug_enabled)
             windowcf_push(_q->debug_x, _x[i]);
 #endif
         switch (_q->state) {
-        case STATE_DETECTFRAME:
-            // detect frame (look for p/n sequence)
-            flexframesync_execute_seekpn(_q, _x[i]);
-            break;
         case STATE_RXPN:
             // receive p/n sequence symbols
             flexframesync_execute_rxpn(_q, _x[i]);
@@ -341,6 +343,7 @@ void flexframesync_execute(flexframesync   _q,
             fprintf(stderr,"error: flexframesync_exeucte(), unknown/unsupported state\n");
             exit(1);
         }
+        i++;
     }
 }
 
@@ -349,21 +352,28 @@ void flexframesync_execute(flexframesync   _q,
 //
 
 // execute synchronizer, seeking p/n sequence
-//  _q     :   frame synchronizer object
-//  _x      :   input sample
-//  _sym    :   demodulated symbol
-void flexframesync_execute_seekpn(flexframesync _q,
-                                  float complex _x)
+//  _q      :   frame synchronizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   number of input samples
+unsigned int flexframesync_execute_seekpn(flexframesync   _q,
+                                          float complex * _x,
+                                          unsigned int    _n)
 {
-    // push sample into pre-demod p/n sequence buffer
-    windowcf_push(_q->buffer, _x);
-
-    // push through pre-demod synchronizer
-    int detected = detector_cccf_correlate(_q->frame_detector,
-                                           _x,
-                                           &_q->tau_hat,
-                                           &_q->dphi_hat,
-                                           &_q->gamma_hat);
+    // push through pre-demod synchronizer, stopping at detection
+    unsigned int num_read = 0;
+    int detected = detector_cccf_correlate_block(_q->frame_detector,
+                                                 _x, _n,
+                                                 &num_read,
+                                                 &_q->tau_hat,
+                                                 &_q->dphi_hat,
+                                                 &_q->gamma_hat);
+
+    // push samples consumed into pre-demod p/n sequence buffer
+    windowcf_write(_q->buffer, _x, num_read);
+#if DEBUG_FLEXFRAMESYNC
+    if (_q->debug_enabled)
+        windowcf_write(_q->debug_x, _x, num_read);
+#endif
 
     // check if frame has been detected
     if (detected) {
@@ -375,6 +385,8 @@ void flexframesync_execute_seekpn(flexframesync _q,
         //       to STATE_DETECTFRAME
         flexframesync_pushpn(_q);
     }
+
+    return num_read;
 }
 
 // update symbol synchronizer internal state (filtered error, index, etc.)
@@ -1026,3 +1038,30 @@ void flexframesync_debug_print(flexframesync  _q,
     fprintf(stderr,"flexframesync_debug_print(): compile-time debugging disabled\n");
 #endif
 }
+
+// generate p/n preamble symbols and the matched-filter interpolated
+// samples the frame detector looks for
+//  _pn     :   p/n symbols [size: 64 x 1]
+//  _seq    :   preamble samples [size: FLEXFRAMESYNC_PREAMBLE_LEN x 1]
+void flexframesync_gen_preamble(float *         _pn,
+                                float complex * _seq)
+{
+    unsigned int i;
+
+    // generate p/n sequence
+    msequence ms = msequence_create(6, 0x005b, 1);
+    for (i=0; i<64; i++)
+        _pn[i] = (msequence_advance(ms)) ? 1.0f : -1.0f;
+    msequence_destroy(ms);
+
+    // interpolate p/n sequence with matched filter
+    unsigned int k = FLEXFRAMESYNC_K;
+    unsigned int m = FLEXFRAMESYNC_M;
+    firinterp_crcf interp = firinterp_crcf_create_rnyquist(LIQUID_RNYQUIST_ARKAISER,k,m,FLEXFRAMESYNC_BETA,0);
+    for (i=0; i<64+m; i++) {
+        // compensate for filter delay
+        if (i < m) firinterp_crcf_execute(interp, _pn[i],    &_seq[0]);
+        else       firinterp_crcf_execute(interp, _pn[i%64], &_seq[k*(i-m)]);
+    }
+    firinterp_crcf_destroy(interp);
+}
@@ -37,9 +37,11 @@
 #define DEBUG_FILENAME              "framesync64_internal_debug.m"
 #define DEBUG_BUFFER_LEN            (1600)
 
-// push samples through detection stage
-void framesync64_execute_seekpn(framesync64   _q,
-                                float complex _x);
+// push samples through detection stage, returning the number
+// of samples consumed
+unsigned int framesync64_execute_seekpn(framesync64     _q,
+                                        float complex * _x,
+                                        unsigned int    _n);
 
 // update symbol synchronizer internal state (filtered error, index, etc.)
 //  _q      :   frame synchronizer
@@ -138,26 +140,12 @@ framesync64 framesync64_create(framesync_callback _callback,
     q->callback = _callback;
     q->userdata = _userdata;
 
-    unsigned int i;
-
-    // generate p/n sequence
-    msequence ms = msequence_create(6, 0x0043, 1);
-    for (i=0; i<64; i++)
-        q->preamble_pn[i] = (msequence_advance(ms)) ? 1.0f : -1.0f;
-    msequence_destroy(ms);
-
-    // interpolate p/n sequence with matched filter
+    // generate p/n sequence and interpolate with matched filter
     unsigned int k  = 2;    // samples/symbol
     unsigned int m  = 3;    // filter delay (symbols)
     float beta      = 0.5f; // excess bandwidth factor
     float complex seq[k*64];
-    firinterp_crcf interp = firinterp_crcf_create_rnyquist(LIQUID_RNYQUIST_ARKAISER,k,m,beta,0);
-    for (i=0; i<64+m; i++) {
-        // compensate for filter delay
-        if (i < m) firinterp_crcf_execute(interp, q->preamble_pn[i],    &seq[0]);
-        else       firinterp_crcf_execute(interp, q->preamble_pn[i%64], &seq[2*(i-m)]);
-    }
-    firinterp_crcf_destroy(interp);
+    framesync64_gen_preamble(q->preamble_pn, seq);
 
     // create frame detector
     float threshold = 0.4f;     // detection threshold
@@ -281,6 +269,13 @@ void framesync64_reset(framesync64 _q)
     _q->framestats.evm = 0.0f;
 }
 
+// is frame synchronizer currently receiving a frame (preamble
+// detected, frame not yet decoded)?
+int framesync64_is_frame_open(framesync64 _q)
+{
+    return _q->state != STATE_DETECTFRAME;
+}
+
 // execute frame synchronizer
 //  _q     :   frame synchronizer object
 //  _x      :   input sample array [size: _n x 1]
@@ -289,17 +284,19 @@ void framesync64_execute(framesync64     _q,
                          float complex * _x,
                          unsigned int    _n)
 {
-    unsigned int i;
-    for (i=0; i<_n; i++) {
+    unsigned int i = 0;
+    while (i < _n) {
+        if (_q->state == STATE_DETECTFRAME) {
+            // detect frame (look for p/n sequence) over as many
+            // samples as possible
+            i += framesync64_execute_seekpn(_q, &_x[i], _n - i);
+            continue;
+        }
 #if DEBUG_FRAMESYNC64
         if (_q->debug_enabled)
             windowcf_push(_q->debug_x, _x[i]);
 #endif
         switch (_q->state) {
-        case STATE_DETECTFRAME:
-            // detect frame (look for p/n sequence)
-            framesync64_execute_seekpn(_q, _x[i]);
-            break;
         case STATE_RXPREAMBLE:
             // receive p/n sequence symbols
             framesync64_execute_rxpreamble(_q, _x[i]);
@@ -312,6 +309,7 @@ void framesync64_execute(framesync64     _q,
             fprintf(stderr,"error: framesync64_exeucte(), unknown/unsupported state\n");
             exit(1);
         }
+        i++;
     }
 }
 
@@ -320,21 +318,28 @@ void framesync64_execute(framesync64     _q,
 //
 
 // execute synchronizer, seeking p/n sequence
-//  _q     :   frame synchronizer object
-//  _x      :   input sample
-//  _sym    :   demodulated symbol
-void framesync64_execute_seekpn(framesync64   _q,
-                                float complex _x)
+//  _q      :   frame synchronizer object
+//  _x      :   input sample array [size: _n x 1]
+//  _n      :   number of input samples
+unsigned int framesync64_execute_seekpn(framesync64     _q,
+                                        float complex * _x,
+                                        unsigned int    _n)
 {
-    // push sample into pre-demod p/n sequence buffer
-    windowcf_push(_q->buffer, _x);
-
-    // push through pre-demod synchronizer
-    int detected = detector_cccf_correlate(_q->frame_detector,
-                                           _x,
-                                           &_q->tau_hat,
-                                           &_q->dphi_hat,
-                                           &_q->gamma_hat);
+    // push through pre-demod synchronizer, stopping at detection
+    unsigned int num_read = 0;
+    int detected = detector_cccf_correlate_block(_q->frame_detector,
+                                                 _x, _n,
+                                                 &num_read,
+                                                 &_q->tau_hat,
+                                                 &_q->dphi_hat,
+                                                 &_q->gamma_hat);
+
+    // push samples consumed into pre-demod p/n sequence buffer
+    windowcf_write(_q->buffer, _x, num_read);
+#if DEBUG_FRAMESYNC64
+    if (_q->debug_enabled)
+        windowcf_write(_q->debug_x, _x, num_read);
+#endif
 
     // check if frame has been detected
     if (detected) {
@@ -346,6 +351,8 @@ void framesync64_execute_seekpn(framesync64   _q,
         //       to STATE_SEEKPN
         framesync64_pushpn(_q);
     }
+
+    return num_read;
 }
 
 // update symbol synchronizer internal state (filtered error, index, etc.)
@@ -768,3 +775,31 @@ void framesync64_debug_print(framesync64  _q,
     fprintf(stderr,"framesync64_debug_print(): compile-time debugging disabled\n");
 #endif
 }
+
+// generate p/n preamble symbols and the matched-filter interpolated
+// samples the frame detector looks for (k=2, m=3, beta=0.5)
+//  _pn     :   p/n symbols [size: 64 x 1]
+//  _seq    :   preamble samples [size: FRAMESYNC64_PREAMBLE_LEN x 1]
+void framesync64_gen_preamble(float *         _pn,
+                              float complex * _seq)
+{
+    unsigned int i;
+
+    // generate p/n sequence
+    msequence ms = msequence_create(6, 0x0043, 1);
+    for (i=0; i<64; i++)
+        _pn[i] = (msequence_advance(ms)) ? 1.0f : -1.0f;
+    msequence_destroy(ms);
+
+    // interpolate p/n sequence with matched filter
+    unsigned int k  = 2;    // samples/symbol
+    unsigned int m  = 3;    // filter delay (symbols)
+    float beta      = 0.5f; // excess bandwidth factor
+    firinterp_crcf interp = firinterp_crcf_create_rnyquist(LIQUID_RNYQUIST_ARKAISER,k,m,beta,0);
+    for (i=0; i<64+m; i++) {
+        // compensate for filter delay
+        if (i < m) firinterp_crcf_execute(interp, _pn[i],    &_seq[0]);
+        else       firinterp_crcf_execute(interp, _pn[i%64], &_seq[k*(i-m)]);
+    }
+    firinterp_crcf_destroy(interp);
+}
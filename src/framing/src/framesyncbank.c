@@ -0,0 +1,561 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// framesyncbank.c
+//
+// Multi-channel frame synchronizer bank
+//
+// The input is channelized with a critically-sampled polyphase
+// filterbank. Channelized samples are accumulated into blocks and the
+// frame preamble is correlated against all channels at once with
+// overlap-save fast convolution: one batch of interleaved transforms
+// computes the spectra of all channels, which are multiplied by the
+// spectrum of each pre-spun preamble (carrier offset hypothesis) and
+// transformed back. A frame synchronizer is only attached to a
+// channel once its correlator output crosses the threshold; it is
+// handed the recent history of the channel and then receives the
+// channel's samples until it is no longer receiving a frame, after
+// which it is returned to a pool for re-use by any channel.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <complex.h>
+
+#include "liquid.internal.h"
+
+// detection threshold, slightly below that of the frame
+// synchronizers' own detectors so as not to miss frames
+#define FRAMESYNCBANK_THRESHOLD     (0.35f)
+
+// maximum carrier offset (same as frame synchronizers)
+#define FRAMESYNCBANK_DPHI_MAX      (0.05f)
+
+// frame synchronizer which may be attached to a channel
+struct framesyncbank_sync_s {
+    framesyncbank q;            // parent object
+    unsigned int  channel;      // channel index
+    void *        sync;         // frame synchronizer object
+};
+
+// create/destroy/reset frame synchronizer of appropriate type
+struct framesyncbank_sync_s * framesyncbank_sync_create(framesyncbank _q);
+void framesyncbank_sync_destroy(struct framesyncbank_sync_s * _s);
+void framesyncbank_sync_reset(struct framesyncbank_sync_s * _s);
+
+// run samples through frame synchronizer
+void framesyncbank_sync_execute(struct framesyncbank_sync_s * _s,
+                                float complex *               _x,
+                                unsigned int                  _n);
+
+// is frame synchronizer receiving a frame?
+int framesyncbank_sync_is_frame_open(struct framesyncbank_sync_s * _s);
+
+// callback passed to each frame synchronizer; invokes user callback
+// with channel's user data
+int framesyncbank_callback(unsigned char *  _header,
+                           int              _header_valid,
+                           unsigned char *  _payload,
+                           unsigned int     _payload_len,
+                           int              _payload_valid,
+                           framesyncstats_s _stats,
+                           void *           _userdata);
+
+// correlate block of channelized samples, attach and run frame
+// synchronizers
+void framesyncbank_process_block(framesyncbank _q);
+
+struct framesyncbank_s {
+    int type;                       // synchronizer type
+    unsigned int num_channels;      // number of channels
+    framesync_callback callback;    // user-defined callback function
+    void ** userdata;               // user-defined data, one per channel
+
+    // channelizer
+    firpfbch_crcf channelizer;      // polyphase filterbank analyzer
+    float complex * x;              // partial input [size: num_channels x 1]
+    unsigned int x_len;             // number of samples in partial input
+
+    // preamble correlators (overlap-save, all channels at once)
+    unsigned int n;                 // preamble length
+    unsigned int m;                 // number of carrier offset hypotheses
+    float threshold;                // detection threshold
+    unsigned int nfft;              // transform size
+    unsigned int block_len;         // new samples per block: nfft-n+1
+    unsigned int hist_len;          // history retained for each channel
+    float complex * buf;            // channelized samples, one row per time
+                                    // step [size: (hist_len+block_len) x num_channels]
+    unsigned int num_rows;          // number of new rows in block
+    float complex * H;              // spectra of reversed, pre-spun preambles
+                                    // scaled by 1/nfft [size: m x nfft]
+    float complex * X;              // channel spectra [size: nfft x num_channels]
+    float complex * P;              // spectral products [size: nfft x num_channels]
+    float complex * Y;              // correlator outputs [size: nfft x num_channels]
+    FFT_PLAN fft;                   // forward transforms (buf -> X)
+    FFT_PLAN ifft;                  // inverse transforms (P -> Y)
+    float * rxy2;                   // max. squared correlator magnitude
+                                    // [size: block_len x num_channels]
+    float * x2_sum;                 // sum{ |x|^2 } over last n samples of each channel
+    unsigned long int   num_samples;// number of samples processed in each channel
+    unsigned long int * t_detect;   // time of last threshold crossing in each channel
+
+    // frame synchronizers
+    struct framesyncbank_sync_s ** active;  // synchronizer attached to each channel
+    struct framesyncbank_sync_s ** pool;    // idle synchronizers
+    unsigned int pool_len;                  // number of idle synchronizers
+    unsigned int num_created;               // number of synchronizers created
+    float complex * tmp;                    // channel samples [size: hist_len+block_len]
+};
+
+// create multi-channel frame synchronizer bank
+//  _type           :   synchronizer type (e.g. LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+//  _num_channels   :   number of channels
+//  _m              :   channelizer prototype filter semi-length
+//  _As             :   channelizer prototype filter stop-band attenuation [dB]
+//  _callback       :   callback function invoked when frame is received
+//  _userdata       :   user data pointers passed to callback, one for
+//                      each channel [size: _num_channels x 1]
+framesyncbank framesyncbank_create(int                _type,
+                                   unsigned int       _num_channels,
+                                   unsigned int       _m,
+                                   float              _As,
+                                   framesync_callback _callback,
+                                   void **            _userdata)
+{
+    // validate input
+    if (_type != LIQUID_FRAMESYNCBANK_FRAMESYNC64 &&
+        _type != LIQUID_FRAMESYNCBANK_FLEXFRAMESYNC)
+    {
+        fprintf(stderr,"error: framesyncbank_create(), unknown/unsupported synchronizer type\n");
+        exit(1);
+    } else if (_num_channels == 0) {
+        fprintf(stderr,"error: framesyncbank_create(), number of channels must be greater than zero\n");
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: framesyncbank_create(), filter semi-length must be greater than zero\n");
+        exit(1);
+    }
+
+    // allocate memory for main object
+    framesyncbank q = (framesyncbank) malloc(sizeof(struct framesyncbank_s));
+    q->type         = _type;
+    q->num_channels = _num_channels;
+    q->callback     = _callback;
+    unsigned int i, k;
+    unsigned int M = q->num_channels;
+
+    // copy user data pointers
+    q->userdata = (void**) malloc(M*sizeof(void*));
+    for (i=0; i<M; i++)
+        q->userdata[i] = _userdata == NULL ? NULL : _userdata[i];
+
+    // create channelizer
+    q->channelizer = firpfbch_crcf_create_kaiser(LIQUID_ANALYZER, M, _m, _As);
+    q->x = (float complex*) malloc(M*sizeof(float complex));
+
+    // generate preamble
+    float pn[64];
+    float complex seq[FRAMESYNC64_PREAMBLE_LEN > FLEXFRAMESYNC_PREAMBLE_LEN ?
+                      FRAMESYNC64_PREAMBLE_LEN : FLEXFRAMESYNC_PREAMBLE_LEN];
+    if (q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64) {
+        q->n = FRAMESYNC64_PREAMBLE_LEN;
+        framesync64_gen_preamble(pn, seq);
+    } else {
+        q->n = FLEXFRAMESYNC_PREAMBLE_LEN;
+        flexframesync_gen_preamble(pn, seq);
+    }
+
+    // carrier offset hypotheses (as in detector_cccf)
+    float dphi_step = 0.8f * M_PI / (float)(q->n);
+    q->m = (unsigned int) ceilf( FRAMESYNCBANK_DPHI_MAX / dphi_step );
+    if (q->m < 2)
+        q->m = 2;
+    q->threshold = FRAMESYNCBANK_THRESHOLD;
+
+    // block sizes: transform size is at least four times the preamble
+    // length; keep enough history for synchronizer to see preamble and
+    // the samples preceding it
+    q->nfft      = 1 << liquid_nextpow2(4*q->n);
+    q->block_len = q->nfft - q->n + 1;
+    q->hist_len  = 2*q->n;
+
+    // allocate memory for correlators
+    q->buf    = (float complex*) malloc((q->hist_len+q->block_len)*M*sizeof(float complex));
+    q->H      = (float complex*) malloc(q->m*q->nfft*sizeof(float complex));
+    q->X      = (float complex*) malloc(q->nfft*M*sizeof(float complex));
+    q->P      = (float complex*) malloc(q->nfft*M*sizeof(float complex));
+    q->Y      = (float complex*) malloc(q->nfft*M*sizeof(float complex));
+    q->rxy2   = (float*)         malloc(q->block_len*M*sizeof(float));
+    q->x2_sum = (float*)         malloc(M*sizeof(float));
+    q->t_detect = (unsigned long int*) malloc(M*sizeof(unsigned long int));
+
+    // compute spectra of reversed, pre-spun preambles
+    float complex * h = (float complex*) malloc(q->nfft*sizeof(float complex));
+    float complex * H = (float complex*) malloc(q->nfft*sizeof(float complex));
+    FFT_PLAN fft = FFT_CREATE_PLAN(q->nfft, h, H, FFT_DIR_FORWARD, FFT_METHOD);
+    for (k=0; k<q->m; k++) {
+        float dphi = ((float)k - (float)(q->m-1)/2) * dphi_step;
+        for (i=0; i<q->nfft; i++) {
+            if (i < q->n) {
+                unsigned int j = q->n - i - 1;
+                h[i] = conjf(seq[j]) * cexpf(-_Complex_I*dphi*j) / (float)(q->nfft);
+            } else {
+                h[i] = 0.0f;
+            }
+        }
+        FFT_EXECUTE(fft);
+        memmove(&q->H[k*q->nfft], H, q->nfft*sizeof(float complex));
+    }
+    FFT_DESTROY_PLAN(fft);
+    free(h);
+    free(H);
+
+    // create transforms for all channels at once: channel c of row i
+    // is element i of transform c (interleaved)
+    q->fft  = FFT_CREATE_PLAN_MANY(q->nfft, M,
+                                   q->buf + (q->hist_len - q->n + 1)*M, M, 1,
+                                   q->X, M, 1,
+                                   FFT_DIR_FORWARD, FFT_METHOD);
+    q->ifft = FFT_CREATE_PLAN_MANY(q->nfft, M,
+                                   q->P, M, 1,
+                                   q->Y, M, 1,
+                                   FFT_DIR_BACKWARD, FFT_METHOD);
+
+    // frame synchronizers (created as needed)
+    q->active      = (struct framesyncbank_sync_s**) malloc(M*sizeof(struct framesyncbank_sync_s*));
+    q->pool        = (struct framesyncbank_sync_s**) malloc(M*sizeof(struct framesyncbank_sync_s*));
+    q->pool_len    = 0;
+    q->num_created = 0;
+    q->tmp = (float complex*) malloc((q->hist_len+q->block_len)*sizeof(float complex));
+    for (i=0; i<M; i++)
+        q->active[i] = NULL;
+
+    // reset object
+    framesyncbank_reset(q);
+
+    // return object
+    return q;
+}
+
+// destroy frame synchronizer bank
+void framesyncbank_destroy(framesyncbank _q)
+{
+    unsigned int i;
+
+    // destroy frame synchronizers
+    for (i=0; i<_q->num_channels; i++) {
+        if (_q->active[i] != NULL)
+            framesyncbank_sync_destroy(_q->active[i]);
+    }
+    for (i=0; i<_q->pool_len; i++)
+        framesyncbank_sync_destroy(_q->pool[i]);
+    free(_q->active);
+    free(_q->pool);
+    free(_q->tmp);
+
+    // destroy correlators
+    FFT_DESTROY_PLAN(_q->fft);
+    FFT_DESTROY_PLAN(_q->ifft);
+    free(_q->buf);
+    free(_q->H);
+    free(_q->X);
+    free(_q->P);
+    free(_q->Y);
+    free(_q->rxy2);
+    free(_q->x2_sum);
+    free(_q->t_detect);
+
+    // destroy channelizer
+    firpfbch_crcf_destroy(_q->channelizer);
+    free(_q->x);
+
+    // free main object memory
+    free(_q->userdata);
+    free(_q);
+}
+
+// print frame synchronizer bank internal properties
+void framesyncbank_print(framesyncbank _q)
+{
+    printf("framesyncbank:\n");
+    printf("    synchronizer        :   %s\n",
+            _q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64 ? "framesync64" : "flexframesync");
+    printf("    num. channels       :   %u\n", _q->num_channels);
+    printf("    preamble length     :   %u\n", _q->n);
+    printf("    num. correlators    :   %u\n", _q->m);
+    printf("    block length        :   %u\n", _q->block_len);
+    printf("    synchronizers       :   %u active, %u created\n",
+            framesyncbank_get_num_active(_q), _q->num_created);
+}
+
+// reset frame synchronizer bank internal state
+void framesyncbank_reset(framesyncbank _q)
+{
+    unsigned int i;
+    unsigned int M = _q->num_channels;
+
+    // reset channelizer
+    firpfbch_crcf_clear(_q->channelizer);
+    _q->x_len = 0;
+
+    // reset correlators
+    memset(_q->buf, 0x00, (_q->hist_len+_q->block_len)*M*sizeof(float complex));
+    _q->num_rows    = 0;
+    _q->num_samples = 0;
+    for (i=0; i<M; i++) {
+        _q->x2_sum[i]   = 0.0f;
+        _q->t_detect[i] = 0;
+    }
+
+    // detach all frame synchronizers
+    for (i=0; i<M; i++) {
+        if (_q->active[i] != NULL) {
+            framesyncbank_sync_reset(_q->active[i]);
+            _q->pool[_q->pool_len++] = _q->active[i];
+            _q->active[i] = NULL;
+        }
+    }
+}
+
+// get number of channels with an active frame synchronizer
+unsigned int framesyncbank_get_num_active(framesyncbank _q)
+{
+    return _q->num_created - _q->pool_len;
+}
+
+// push samples through frame synchronizer bank
+//  _q      :   frame synchronizer bank object
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of input samples
+void framesyncbank_execute(framesyncbank   _q,
+                           float complex * _x,
+                           unsigned int    _n)
+{
+    unsigned int M = _q->num_channels;
+    unsigned int i = 0;
+    while (i < _n) {
+        float complex * row = _q->buf + (_q->hist_len + _q->num_rows)*M;
+        if (_q->x_len > 0 || _n - i < M) {
+            // fill partial input
+            unsigned int num_copy = M - _q->x_len < _n - i ? M - _q->x_len : _n - i;
+            memmove(&_q->x[_q->x_len], &_x[i], num_copy*sizeof(float complex));
+            _q->x_len += num_copy;
+            i         += num_copy;
+            if (_q->x_len < M)
+                break;
+
+            // channelize
+            firpfbch_crcf_analyzer_execute(_q->channelizer, _q->x, row);
+            _q->x_len = 0;
+            _q->num_rows++;
+        } else {
+            // channelize as many full input blocks as fit in block
+            unsigned int num_blocks = (_n - i) / M;
+            if (num_blocks > _q->block_len - _q->num_rows)
+                num_blocks = _q->block_len - _q->num_rows;
+            firpfbch_crcf_analyzer_execute_block(_q->channelizer, &_x[i], num_blocks, row);
+            i            += num_blocks*M;
+            _q->num_rows += num_blocks;
+        }
+
+        // process full block
+        if (_q->num_rows == _q->block_len)
+            framesyncbank_process_block(_q);
+    }
+}
+
+//
+// internal methods
+//
+
+// correlate block of channelized samples, attach and run frame
+// synchronizers
+void framesyncbank_process_block(framesyncbank _q)
+{
+    unsigned int M = _q->num_channels;
+    unsigned int n = _q->n;
+    unsigned int i, k, t, c;
+
+    // compute spectra of all channels
+    FFT_EXECUTE(_q->fft);
+
+    // compute all correlators, retaining maximum squared magnitude
+    // over carrier offset hypotheses
+    for (k=0; k<_q->m; k++) {
+        float complex * H = &_q->H[k*_q->nfft];
+        for (i=0; i<_q->nfft; i++) {
+            float hr = crealf(H[i]), hi = cimagf(H[i]);
+            float complex * X = &_q->X[i*M];
+            float complex * P = &_q->P[i*M];
+            for (c=0; c<M; c++) {
+                float xr = crealf(X[c]), xi = cimagf(X[c]);
+                P[c] = (xr*hr - xi*hi) + _Complex_I*(xr*hi + xi*hr);
+            }
+        }
+        FFT_EXECUTE(_q->ifft);
+
+        for (t=0; t<_q->block_len; t++) {
+            float complex * Y = &_q->Y[(n-1+t)*M];
+            float * rxy2 = &_q->rxy2[t*M];
+            for (c=0; c<M; c++) {
+                float r2 = crealf(Y[c])*crealf(Y[c]) + cimagf(Y[c])*cimagf(Y[c]);
+                if (k == 0 || r2 > rxy2[c])
+                    rxy2[c] = r2;
+            }
+        }
+    }
+
+    // detect threshold crossing in each channel:
+    //   |rxy|/n > threshold * sqrt( sum{|x|^2}/n )
+    float g = _q->threshold * _q->threshold * (float)n;
+    for (c=0; c<M; c++) {
+        // re-compute sum{ |x|^2 } of last n samples (no accumulated error)
+        float x2_sum = 0.0f;
+        for (i=_q->hist_len-n; i<_q->hist_len; i++) {
+            float complex v = _q->buf[i*M + c];
+            x2_sum += crealf(v)*crealf(v) + cimagf(v)*cimagf(v);
+        }
+
+        // first row to be pushed to synchronizer
+        unsigned int r0 = _q->active[c] != NULL ? _q->hist_len : _q->hist_len + _q->block_len;
+        for (t=0; t<_q->block_len; t++) {
+            float complex x_n = _q->buf[(_q->hist_len+t  )*M + c];   // new sample
+            float complex x_0 = _q->buf[(_q->hist_len+t-n)*M + c];   // oldest sample
+            x2_sum += crealf(x_n)*crealf(x_n) + cimagf(x_n)*cimagf(x_n)
+                    - crealf(x_0)*crealf(x_0) - cimagf(x_0)*cimagf(x_0);
+
+            // wait until correlator window is full
+            if (_q->num_samples + t + 1 < n)
+                continue;
+
+            if (x2_sum > 0.0f && _q->rxy2[t*M + c] > g*x2_sum) {
+                _q->t_detect[c] = _q->num_samples + t + 1;
+
+                // attach synchronizer to channel, starting with history
+                if (_q->active[c] == NULL) {
+                    _q->active[c] = _q->pool_len > 0 ? _q->pool[--_q->pool_len] :
+                                                       framesyncbank_sync_create(_q);
+                    _q->active[c]->channel = c;
+                    r0 = t + 1;
+                }
+            }
+        }
+        _q->x2_sum[c] = x2_sum;
+
+        if (_q->active[c] == NULL)
+            continue;
+
+        // run channel samples through frame synchronizer
+        unsigned int num_rows = _q->hist_len + _q->block_len - r0;
+        for (i=0; i<num_rows; i++)
+            _q->tmp[i] = _q->buf[(r0+i)*M + c];
+        framesyncbank_sync_execute(_q->active[c], _q->tmp, num_rows);
+
+        // detach synchronizer when it is not receiving a frame and no
+        // preamble has been seen recently
+        unsigned long int num_samples = _q->num_samples + _q->block_len;
+        if (!framesyncbank_sync_is_frame_open(_q->active[c]) &&
+            num_samples - _q->t_detect[c] > n)
+        {
+            framesyncbank_sync_reset(_q->active[c]);
+            _q->pool[_q->pool_len++] = _q->active[c];
+            _q->active[c] = NULL;
+        }
+    }
+
+    // retain history for next block
+    memmove(_q->buf,
+            _q->buf + _q->block_len*M,
+            _q->hist_len*M*sizeof(float complex));
+    _q->num_rows = 0;
+    _q->num_samples += _q->block_len;
+}
+
+// create frame synchronizer of appropriate type
+struct framesyncbank_sync_s * framesyncbank_sync_create(framesyncbank _q)
+{
+    struct framesyncbank_sync_s * s = (struct framesyncbank_sync_s*) malloc(sizeof(struct framesyncbank_sync_s));
+    s->q       = _q;
+    s->channel = 0;
+    if (_q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+        s->sync = framesync64_create(framesyncbank_callback, s);
+    else
+        s->sync = flexframesync_create(framesyncbank_callback, s);
+    _q->num_created++;
+    return s;
+}
+
+// destroy frame synchronizer
+void framesyncbank_sync_destroy(struct framesyncbank_sync_s * _s)
+{
+    if (_s->q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+        framesync64_destroy((framesync64)_s->sync);
+    else
+        flexframesync_destroy((flexframesync)_s->sync);
+    free(_s);
+}
+
+// reset frame synchronizer
+void framesyncbank_sync_reset(struct framesyncbank_sync_s * _s)
+{
+    if (_s->q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+        framesync64_reset((framesync64)_s->sync);
+    else
+        flexframesync_reset((flexframesync)_s->sync);
+}
+
+// run samples through frame synchronizer
+void framesyncbank_sync_execute(struct framesyncbank_sync_s * _s,
+                                float complex *               _x,
+                                unsigned int                  _n)
+{
+    if (_s->q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+        framesync64_execute((framesync64)_s->sync, _x, _n);
+    else
+        flexframesync_execute((flexframesync)_s->sync, _x, _n);
+}
+
+// is frame synchronizer receiving a frame?
+int framesyncbank_sync_is_frame_open(struct framesyncbank_sync_s * _s)
+{
+    if (_s->q->type == LIQUID_FRAMESYNCBANK_FRAMESYNC64)
+        return framesync64_is_frame_open((framesync64)_s->sync);
+    else
+        return flexframesync_is_frame_open((flexframesync)_s->sync);
+}
+
+// callback passed to each frame synchronizer; invokes user callback
+// with channel's user data
+int framesyncbank_callback(unsigned char *  _header,
+                           int              _header_valid,
+                           unsigned char *  _payload,
+                           unsigned int     _payload_len,
+                           int              _payload_valid,
+                           framesyncstats_s _stats,
+                           void *           _userdata)
+{
+    struct framesyncbank_sync_s * s = (struct framesyncbank_sync_s*) _userdata;
+    if (s->q->callback == NULL)
+        return 0;
+    return s->q->callback(_header, _header_valid, _payload, _payload_len,
+                          _payload_valid, _stats, s->q->userdata[s->channel]);
+}
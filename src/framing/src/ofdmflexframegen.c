@@ -76,14 +76,14 @@ struct ofdmflexframegen_s {
     packetizer p_header;                // header packetizer
     unsigned char header[OFDMFLEXFRAME_H_DEC];      // header data (uncoded)
     unsigned char header_enc[OFDMFLEXFRAME_H_ENC];  // header data (encoded)
-    unsigned char header_mod[OFDMFLEXFRAME_H_SYM];  // header symbols
+    float complex header_mod[OFDMFLEXFRAME_H_SYM];  // modulated header symbols
 
     // payload
     packetizer p_payload;               // payload packetizer
     unsigned int payload_dec_len;       // payload length (num un-encoded bytes)
     modem mod_payload;                  // payload modulator
     unsigned char * payload_enc;        // payload data (encoded bytes)
-    unsigned char * payload_mod;        // payload data (modulated symbols)
+    float complex * payload_mod;        // payload data (modulated symbols)
     unsigned int payload_enc_len;       // length of encoded payload
     unsigned int payload_mod_len;       // number of modulated symbols in payload
 
@@ -169,10 +169,10 @@ ofdmflexframegen ofdmflexframegen_create(unsigned int              _M,
                                      LIQUID_FEC_NONE,
                                      LIQUID_FEC_NONE);
     q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
+    q->payload_enc = (unsigned char*) malloc((q->payload_enc_len+1)*sizeof(unsigned char));
 
     q->payload_mod_len = 1;
-    q->payload_mod = (unsigned char*) malloc(q->payload_mod_len*sizeof(unsigned char));
+    q->payload_mod = (float complex*) malloc(q->payload_mod_len*sizeof(float complex));
 
     // create payload modem (initially QPSK, overridden by properties)
     q->mod_payload = modem_create(LIQUID_MODEM_QPSK);
@@ -345,22 +345,11 @@ void ofdmflexframegen_assemble(ofdmflexframegen _q,
     // encode payload
     packetizer_encode(_q->p_payload, _payload, _q->payload_enc);
 
-    // 
-    // pack modem symbols
-    //
-
-    // clear payload
-    memset(_q->payload_mod, 0x00, _q->payload_mod_len);
-
-    // repack 8-bit payload bytes into 'bps'-bit payload symbols
-    unsigned int bps = modulation_types[_q->props.mod_scheme].bps;
-    unsigned int num_written;
-    liquid_repack_bytes(_q->payload_enc,  8,  _q->payload_enc_len,
-                        _q->payload_mod, bps, _q->payload_mod_len,
-                        &num_written);
-#if DEBUG_OFDMFLEXFRAMEGEN
-    printf("wrote %u symbols (expected %u)\n", num_written, _q->payload_mod_len);
-#endif
+    // modulate payload directly from encoded bytes; the final symbol is
+    // padded with zeros when the encoded length is not a multiple of
+    // the modulation depth
+    _q->payload_enc[_q->payload_enc_len] = 0x00;
+    modem_modulate_block(_q->mod_payload, _q->payload_enc, _q->payload_mod_len, _q->payload_mod);
 }
 
 // write symbols of assembled frame
@@ -437,10 +426,11 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
                                         _q->props.fec0,
                                         _q->props.fec1);
 
-    // re-allocate memory for encoded message
+    // re-allocate memory for encoded message (with an extra byte for
+    // padding the final modulation symbol)
     _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
     _q->payload_enc = (unsigned char*) realloc(_q->payload_enc,
-                                               _q->payload_enc_len*sizeof(unsigned char));
+                                               (_q->payload_enc_len+1)*sizeof(unsigned char));
 #if DEBUG_OFDMFLEXFRAMEGEN
     printf(">>>> payload : %u (%u encoded)\n", _q->props.payload_len, _q->payload_enc_len);
 #endif
@@ -453,8 +443,8 @@ void ofdmflexframegen_reconfigure(ofdmflexframegen _q)
     unsigned int bps = modulation_types[_q->props.mod_scheme].bps;
     div_t d = div(8*_q->payload_enc_len, bps);
     _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
-    _q->payload_mod = (unsigned char*)realloc(_q->payload_mod,
-                                              _q->payload_mod_len*sizeof(unsigned char));
+    _q->payload_mod = (float complex*)realloc(_q->payload_mod,
+                                              _q->payload_mod_len*sizeof(float complex));
 
     // re-compute number of payload OFDM symbols
     d = div(_q->payload_mod_len, _q->M_data);
@@ -510,12 +500,7 @@ void ofdmflexframegen_encode_header(ofdmflexframegen _q)
 // modulate header
 void ofdmflexframegen_modulate_header(ofdmflexframegen _q)
 {
-    // repack 8-bit header bytes into 'bps'-bit payload symbols
-    unsigned int bps = modulation_types[OFDMFLEXFRAME_H_MOD].bps;
-    unsigned int num_written;
-    liquid_repack_bytes(_q->header_enc, 8,   OFDMFLEXFRAME_H_ENC,
-                        _q->header_mod, bps, OFDMFLEXFRAME_H_SYM,
-                        &num_written);
+    modem_modulate_block(_q->mod_header, _q->header_enc, OFDMFLEXFRAME_H_SYM, _q->header_mod);
 }
 
 // write first S0 symbol
@@ -583,8 +568,8 @@ void ofdmflexframegen_write_header(ofdmflexframegen _q,
         if (sctype == OFDMFRAME_SCTYPE_DATA) {
             // load...
             if (_q->header_symbol_index < OFDMFLEXFRAME_H_SYM) {
-                // modulate header symbol onto data subcarrier
-                modem_modulate(_q->mod_header, _q->header_mod[_q->header_symbol_index++], &_q->X[i]);
+                // load modulated header symbol onto data subcarrier
+                _q->X[i] = _q->header_mod[_q->header_symbol_index++];
                 //printf("  writing symbol %3u / %3u (x = %8.5f + j%8.5f)\n", _q->header_symbol_index, OFDMFLEXFRAME_H_SYM, crealf(_q->X[i]), cimagf(_q->X[i]));
             } else {
                 //printf("  random header symbol\n");
@@ -627,8 +612,8 @@ void ofdmflexframegen_write_payload(ofdmflexframegen _q,
         if (sctype == OFDMFRAME_SCTYPE_DATA) {
             // load...
             if (_q->payload_symbol_index < _q->payload_mod_len) {
-                // modulate payload symbol onto data subcarrier
-                modem_modulate(_q->mod_payload, _q->payload_mod[_q->payload_symbol_index++], &_q->X[i]);
+                // load modulated payload symbol onto data subcarrier
+                _q->X[i] = _q->payload_mod[_q->payload_symbol_index++];
             } else {
                 //printf("  random payload symbol\n");
                 // load random symbol
@@ -17,24 +17,87 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+
 //
 // ofdmflexframesync.c
 //
 // OFDM frame synchronizer
 //
+// Frames pass through three stages: acquisition (timing, carrier and
+// gain estimation, header), payload recovery (transform, equalization
+// and demodulation of payload symbols) and payload decoding (FEC,
+// validity check and callback).  By default all stages run on the
+// thread calling execute().  With set_num_threads() the stages after
+// acquisition are moved to worker threads: payload symbols are handed
+// over in the time domain through a lock-free queue together with a
+// copy of the equalizer state, so acquisition of the next frame
+// proceeds while earlier frames are still being recovered and decoded.
+// Each stage processes frames one at a time, so frames are always
+// delivered in order.
+//
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 #include <assert.h>
 
 #include "liquid.internal.h"
 
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#   include <pthread.h>
+#   define OFDMFLEXFRAMESYNC_PTHREAD 1
+#else
+#   define OFDMFLEXFRAMESYNC_PTHREAD 0
+#endif
+
 #define DEBUG_OFDMFLEXFRAMESYNC 0
 
 #define OFDMFLEXFRAME_H_SOFT (0)
 
+// number of frames in flight and payload symbols queued when pipelined
+#define OFDMFLEXFRAMESYNC_NUM_FRAMES    (4)
+#define OFDMFLEXFRAMESYNC_NUM_SYMBOLS   (64)
+
+// frame in flight
+struct ofdmflexframesync_frame_s {
+    ofdmframesync eq;                   // equalizer state (pipelined only)
+
+    // header
+    unsigned char header[OFDMFLEXFRAME_H_DEC];  // header data (decoded)
+    int header_valid;                   // valid header flag
+    framesyncstats_s framestats;        // frame statistics
+
+    // payload
+    unsigned int payload_len;           // payload length (number of bytes)
+    unsigned char * payload_enc;        // payload data (encoded bytes)
+    unsigned char * payload_dec;        // payload data (decoded bytes)
+    unsigned int payload_enc_len;       // length of encoded payload
+    unsigned int payload_mod_len;       // number of payload modem symbols
+    unsigned int payload_symbol_index;  // number of payload symbols received
+    unsigned int payload_buffer_index;  // bit-level index of payload (pack array)
+    int payload_valid;                  // valid payload flag
+    int aborted;                        // frame dropped by reset (no callback)
+
+    // time stamps [s]
+    double t_start;                     // first header symbol received
+    double t_sync;                      // last payload symbol received
+    double t_demod;                     // payload demodulated
+};
+
+// message from acquisition to payload recovery stage
+struct ofdmflexframesync_msg_s {
+    enum {
+        OFDMFLEXFRAMESYNC_MSG_SYMBOL=0, // payload symbol (time domain)
+        OFDMFLEXFRAMESYNC_MSG_FRAME,    // frame without payload symbols
+        OFDMFLEXFRAMESYNC_MSG_ABORT,    // frame dropped by reset
+        OFDMFLEXFRAMESYNC_MSG_STOP      // shut down worker threads
+    } type;
+    unsigned int frame;                 // frame index
+    float complex x[];                  // symbol [size: M x 1]
+};
+
 struct ofdmflexframesync_s {
     unsigned int M;         // number of subcarriers
     unsigned int cp_len;    // cyclic prefix length
@@ -68,15 +131,14 @@ struct ofdmflexframesync_s {
     crc_scheme check;                   // payload validity check
     fec_scheme fec0;                    // payload FEC (inner)
     fec_scheme fec1;                    // payload FEC (outer)
-
-    // payload
-    packetizer p_payload;               // payload packetizer
-    modem mod_payload;                  // payload demodulator
-    unsigned char * payload_enc;        // payload data (encoded bytes)
-    unsigned char * payload_dec;        // payload data (decoded bytes)
     unsigned int payload_enc_len;       // length of encoded payload
     unsigned int payload_mod_len;       // number of payload modem symbols
-    int payload_valid;                  // valid payload flag
+
+    // payload (recovery, decoding stages)
+    modem mod_payload;                  // payload demodulator
+    modulation_scheme ms_demod;         // payload demodulator scheme
+    packetizer p_payload;               // payload packetizer
+    float complex * X;                  // recovered payload symbol
 
     // callback
     framesync_callback callback;        // user-defined callback function
@@ -94,10 +156,38 @@ struct ofdmflexframesync_s {
         OFDMFLEXFRAMESYNC_STATE_PAYLOAD // extract payload symbols
     } state;
     unsigned int header_symbol_index;   // number of header symbols received
-    unsigned int payload_symbol_index;  // number of payload symbols received
-    unsigned int payload_buffer_index;  // bit-level index of payload (pack array)
+    unsigned int payload_num_symbols;   // payload OFDM symbols remaining
+    double t_start;                     // time of first header symbol [s]
+
+    // frames in flight
+    unsigned int num_threads;           // number of threads (stages)
+    unsigned int num_frames;            // number of frame descriptors
+    struct ofdmflexframesync_frame_s * frames;
+    unsigned int * frames_free;         // free frame indices (stack)
+    unsigned int num_free;              // number of free frames
+    unsigned int frame;                 // frame being received
+    int frame_open;                     // payload of frame being received
+
+    // latency of most recently delivered frame [s]
+    float latency[3];
+
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    // pipeline
+    liquid_spscqueue q_symbol;          // acquisition -> recovery
+    liquid_spscqueue q_decode;          // recovery -> decoding
+    liquid_spscqueue q_free;            // last stage -> acquisition
+    pthread_t threads[2];               // worker threads
+#endif
 };
 
+// current time [s]
+static double ofdmflexframesync_time(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (double)t.tv_sec + 1e-9*(double)t.tv_nsec;
+}
+
 // create ofdmflexframesync object
 //  _M          :   number of subcarriers
 //  _cp_len     :   length of cyclic prefix [samples]
@@ -164,14 +254,22 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
     q->check        = LIQUID_CRC_NONE;
     q->fec0         = LIQUID_FEC_NONE;
     q->fec1         = LIQUID_FEC_NONE;
+    q->payload_enc_len = 0;
+    q->payload_mod_len = 0;
 
     // create payload objects (initally QPSK, etc but overridden by received properties)
     q->mod_payload = modem_create(q->ms_payload);
+    q->ms_demod    = q->ms_payload;
     q->p_payload   = packetizer_create(q->payload_len, q->check, q->fec0, q->fec1);
-    q->payload_enc_len = packetizer_get_enc_msg_len(q->p_payload);
-    q->payload_enc = (unsigned char*) malloc(q->payload_enc_len*sizeof(unsigned char));
-    q->payload_dec = (unsigned char*) malloc(q->payload_len*sizeof(unsigned char));
-    q->payload_mod_len = 0;
+    q->X = (float complex*) malloc((q->M)*sizeof(float complex));
+
+    // frames in flight (all stages on calling thread)
+    q->num_threads = 1;
+    q->frame_open  = 0;
+    ofdmflexframesync_create_frames(q, 1);
+    q->latency[0] = 0.0f;
+    q->latency[1] = 0.0f;
+    q->latency[2] = 0.0f;
 
     // reset state
     ofdmflexframesync_reset(q);
@@ -182,6 +280,11 @@ ofdmflexframesync ofdmflexframesync_create(unsigned int       _M,
 
 void ofdmflexframesync_destroy(ofdmflexframesync _q)
 {
+    // deliver frames in flight and stop worker threads
+    ofdmflexframesync_reset(_q);
+    ofdmflexframesync_stop_pipeline(_q);
+    ofdmflexframesync_destroy_frames(_q);
+
     // destroy internal objects
     ofdmframesync_destroy(_q->fs);
     packetizer_destroy(_q->p_header);
@@ -191,8 +294,7 @@ void ofdmflexframesync_destroy(ofdmflexframesync _q)
 
     // free internal buffers/arrays
     free(_q->p);
-    free(_q->payload_enc);
-    free(_q->payload_dec);
+    free(_q->X);
 
     // free main object memory
     free(_q);
@@ -207,18 +309,22 @@ void ofdmflexframesync_print(ofdmflexframesync _q)
     printf("      * data            :   %-u\n", _q->M_data);
     printf("    cyclic prefix len   :   %-u\n", _q->cp_len);
     printf("    taper len           :   %-u\n", _q->taper_len);
+    printf("    num threads         :   %-u\n", _q->num_threads);
 }
 
 void ofdmflexframesync_reset(ofdmflexframesync _q)
 {
+    // drop partially received frame still in flight
+    if (_q->frame_open)
+        ofdmflexframesync_close_frame(_q, 1);
+
     // reset internal state
     _q->state = OFDMFLEXFRAMESYNC_STATE_HEADER;
 
     // reset internal counters
     _q->symbol_counter=0;
     _q->header_symbol_index=0;
-    _q->payload_symbol_index=0;
-    _q->payload_buffer_index=0;
+    _q->payload_num_symbols=0;
     
     // reset error vector magnitude estimate
     _q->evm_hat = 1e-12f;   // slight offset to ensure no log(0)
@@ -239,6 +345,61 @@ void ofdmflexframesync_execute(ofdmflexframesync _q,
     ofdmframesync_execute(_q->fs, _x, _n);
 }
 
+// set number of threads: 1 runs all stages on the calling thread, 2
+// moves payload recovery and decoding to one worker thread, and 3 (or
+// more) gives each a worker thread of its own; resets the receiver,
+// dropping a partially received frame
+void ofdmflexframesync_set_num_threads(ofdmflexframesync _q,
+                                       unsigned int      _num_threads)
+{
+    if (_num_threads == 0) {
+        fprintf(stderr,"error: ofdmflexframesync_set_num_threads(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    unsigned int num_threads = _num_threads < 3 ? _num_threads : 3;
+#else
+    unsigned int num_threads = 1;
+#endif
+    if (num_threads == _q->num_threads)
+        return;
+
+    ofdmflexframesync_reset(_q);
+    ofdmflexframesync_stop_pipeline(_q);
+    ofdmflexframesync_destroy_frames(_q);
+
+    _q->num_threads = num_threads;
+    ofdmflexframesync_create_frames(_q, num_threads == 1 ? 1 : OFDMFLEXFRAMESYNC_NUM_FRAMES);
+    ofdmflexframesync_start_pipeline(_q);
+}
+
+// get number of threads
+unsigned int ofdmflexframesync_get_num_threads(ofdmflexframesync _q)
+{
+    return _q->num_threads;
+}
+
+// wait until every frame received so far has been delivered
+void ofdmflexframesync_flush(ofdmflexframesync _q)
+{
+    while (_q->num_free < _q->num_frames)
+        ofdmflexframesync_wait_frame(_q);
+}
+
+// get latency [s] of the most recently delivered frame in each stage:
+// acquisition (first header symbol to last payload symbol received),
+// payload recovery (until payload demodulated) and decoding (until
+// callback invoked); valid within the callback or after flush()
+void ofdmflexframesync_get_latency(ofdmflexframesync _q,
+                                   float *           _sync,
+                                   float *           _demod,
+                                   float *           _decode)
+{
+    *_sync   = _q->latency[0];
+    *_demod  = _q->latency[1];
+    *_decode = _q->latency[2];
+}
+
 // 
 // query methods
 //
@@ -284,7 +445,7 @@ void ofdmflexframesync_debug_print(ofdmflexframesync _q,
 //
 
 // internal callback
-//  _X          :   subcarrier symbols
+//  _X          :   subcarrier symbols (time-domain symbol if deferred)
 //  _p          :   subcarrier allocation
 //  _M          :   number of subcarriers
 //  _userdata   :   user-defined data structure
@@ -329,6 +490,8 @@ void ofdmflexframesync_rxheader(ofdmflexframesync _q,
 #if DEBUG_OFDMFLEXFRAMESYNC
     printf("  ofdmflexframesync extracting header...\n");
 #endif
+    if (_q->header_symbol_index == 0)
+        _q->t_start = ofdmflexframesync_time();
 
     // demodulate header symbols
     unsigned int i;
@@ -363,31 +526,13 @@ void ofdmflexframesync_rxheader(ofdmflexframesync _q,
                 // compute error vector magnitude estimate
                 _q->framestats.evm = 10*log10f( _q->evm_hat/OFDMFLEXFRAME_H_SYM );
 
-                // invoke callback if header is invalid
-                if (_q->header_valid)
+                // hand frame to payload stages
+                ofdmflexframesync_open_frame(_q);
+                if (_q->header_valid) {
                     _q->state = OFDMFLEXFRAMESYNC_STATE_PAYLOAD;
-                else {
+                } else {
                     //printf("**** header invalid!\n");
-                    // set framestats internals
-                    _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
-                    _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
-                    _q->framestats.framesyms        = NULL;
-                    _q->framestats.num_framesyms    = 0;
-                    _q->framestats.mod_scheme       = LIQUID_MODEM_UNKNOWN;
-                    _q->framestats.mod_bps          = 0;
-                    _q->framestats.check            = LIQUID_CRC_UNKNOWN;
-                    _q->framestats.fec0             = LIQUID_FEC_UNKNOWN;
-                    _q->framestats.fec1             = LIQUID_FEC_UNKNOWN;
-
-                    // invoke callback method
-                    _q->callback(_q->header,
-                                 _q->header_valid,
-                                 NULL,
-                                 0,
-                                 0,
-                                 _q->framestats,
-                                 _q->userdata);
-
+                    ofdmflexframesync_close_frame(_q, 0);
                     ofdmflexframesync_reset(_q);
                 }
                 break;
@@ -504,41 +649,25 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q)
     printf("      * payload length  :   %u bytes\n", payload_len);
 #endif
 
-    // configure payload receiver
+    // set payload properties; the payload demodulator and packetizer
+    // are re-configured by the stages which use them
     if (_q->header_valid) {
-        // configure modem
-        if (mod_scheme != _q->ms_payload) {
-            // set new properties
-            _q->ms_payload  = mod_scheme;
-            _q->bps_payload = modulation_types[mod_scheme].bps;
-
-            // recreate modem (destroy/create)
-            _q->mod_payload = modem_recreate(_q->mod_payload, _q->ms_payload);
-        }
-
-        // set new packetizer properties
+        _q->ms_payload  = mod_scheme;
+        _q->bps_payload = modulation_types[mod_scheme].bps;
         _q->payload_len = payload_len;
         _q->check       = check;
         _q->fec0        = fec0;
         _q->fec1        = fec1;
-        
-        // recreate packetizer object
-        _q->p_payload = packetizer_recreate(_q->p_payload,
-                                            _q->payload_len,
-                                            _q->check,
-                                            _q->fec0,
-                                            _q->fec1);
 
-        // re-compute payload encoded message length
-        _q->payload_enc_len = packetizer_get_enc_msg_len(_q->p_payload);
+        // compute payload encoded message length
+        _q->payload_enc_len = packetizer_compute_enc_msg_len(_q->payload_len,
+                                                             _q->check,
+                                                             _q->fec0,
+                                                             _q->fec1);
 #if DEBUG_OFDMFLEXFRAMESYNC
         printf("      * payload encoded :   %u bytes\n", _q->payload_enc_len);
 #endif
 
-        // re-allocate buffers accordingly
-        _q->payload_enc = (unsigned char*) realloc(_q->payload_enc, _q->payload_enc_len*sizeof(unsigned char));
-        _q->payload_dec = (unsigned char*) realloc(_q->payload_dec, _q->payload_len*sizeof(unsigned char));
-
         // re-compute number of modulated payload symbols
         div_t d = div(8*_q->payload_enc_len, _q->bps_payload);
         _q->payload_mod_len = d.quot + (d.rem ? 1 : 0);
@@ -548,79 +677,377 @@ void ofdmflexframesync_decode_header(ofdmflexframesync _q)
     }
 }
 
-// receive payload data
+// receive payload symbol: recover it here, or hand it over in the time
+// domain when pipelined
 void ofdmflexframesync_rxpayload(ofdmflexframesync _q,
                                  float complex * _X)
 {
+    struct ofdmflexframesync_frame_s * f = &_q->frames[_q->frame];
+    _q->payload_num_symbols--;
+    int last_symbol = (_q->payload_num_symbols == 0);
+    if (last_symbol) {
+        f->t_sync = ofdmflexframesync_time();
+        f->framestats.rssi = ofdmframesync_get_rssi(_q->fs);
+        f->framestats.cfo  = ofdmframesync_get_cfo(_q->fs);
+    }
+
+    if (_q->num_threads == 1) {
+        // recover and decode on calling thread
+        if (ofdmflexframesync_demod_symbol(_q, f, _X)) {
+            _q->frame_open = 0;
+            ofdmflexframesync_decode_frame(_q, f);
+            ofdmflexframesync_release_frame(_q, _q->frame);
+            ofdmflexframesync_reset(_q);
+        }
+        return;
+    }
+
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    struct ofdmflexframesync_msg_s * msg =
+        (struct ofdmflexframesync_msg_s *) liquid_spscqueue_write_begin(_q->q_symbol);
+    msg->type  = OFDMFLEXFRAMESYNC_MSG_SYMBOL;
+    msg->frame = _q->frame;
+    memmove(msg->x, _X, _q->M*sizeof(float complex));
+    liquid_spscqueue_write_end(_q->q_symbol);
+#endif
+
+    if (last_symbol) {
+        _q->frame_open = 0;
+        ofdmflexframesync_reset(_q);
+    }
+}
+
+// start frame for decoded header, waiting for a free frame descriptor
+void ofdmflexframesync_open_frame(ofdmflexframesync _q)
+{
+    while (_q->num_free == 0)
+        ofdmflexframesync_wait_frame(_q);
+    _q->frame = _q->frames_free[--_q->num_free];
+    _q->frame_open = 1;
+
+    struct ofdmflexframesync_frame_s * f = &_q->frames[_q->frame];
+    memmove(f->header, _q->header, OFDMFLEXFRAME_H_DEC);
+    f->header_valid = _q->header_valid;
+    f->framestats   = _q->framestats;
+    f->framestats.rssi          = ofdmframesync_get_rssi(_q->fs);
+    f->framestats.cfo           = ofdmframesync_get_cfo(_q->fs);
+    f->framestats.framesyms     = NULL;
+    f->framestats.num_framesyms = 0;
+    f->payload_symbol_index = 0;
+    f->payload_buffer_index = 0;
+    f->payload_valid        = 0;
+    f->aborted              = 0;
+    f->t_start = _q->t_start;
+    f->t_sync  = ofdmflexframesync_time();
+
+    if (!f->header_valid) {
+        f->framestats.mod_scheme = LIQUID_MODEM_UNKNOWN;
+        f->framestats.mod_bps    = 0;
+        f->framestats.check      = LIQUID_CRC_UNKNOWN;
+        f->framestats.fec0       = LIQUID_FEC_UNKNOWN;
+        f->framestats.fec1       = LIQUID_FEC_UNKNOWN;
+        return;
+    }
+
+    f->framestats.mod_scheme = _q->ms_payload;
+    f->framestats.mod_bps    = _q->bps_payload;
+    f->framestats.check      = _q->check;
+    f->framestats.fec0       = _q->fec0;
+    f->framestats.fec1       = _q->fec1;
+
+    // re-allocate buffers accordingly
+    f->payload_len     = _q->payload_len;
+    f->payload_enc_len = _q->payload_enc_len;
+    f->payload_mod_len = _q->payload_mod_len;
+    f->payload_enc = (unsigned char*) realloc(f->payload_enc, f->payload_enc_len*sizeof(unsigned char));
+    f->payload_dec = (unsigned char*) realloc(f->payload_dec, f->payload_len*sizeof(unsigned char));
+
+    // number of OFDM symbols carrying payload
+    div_t d = div(_q->payload_mod_len, _q->M_data);
+    _q->payload_num_symbols = d.quot + (d.rem ? 1 : 0);
+
+    // hand remaining symbols over in the time domain when pipelined,
+    // with equalizer state as of the end of the header
+    if (_q->num_threads > 1) {
+        ofdmframesync_copy_eqstate(f->eq, _q->fs);
+        ofdmframesync_set_defer(_q->fs, 1);
+    }
+}
+
+// close frame without (remaining) payload symbols: deliver it (invalid
+// header) or drop it (_abort)
+void ofdmflexframesync_close_frame(ofdmflexframesync _q,
+                                   int               _abort)
+{
+    _q->frame_open = 0;
+    struct ofdmflexframesync_frame_s * f = &_q->frames[_q->frame];
+    if (_q->num_threads == 1) {
+        f->aborted = _abort;
+        f->t_demod = ofdmflexframesync_time();
+        ofdmflexframesync_decode_frame(_q, f);
+        ofdmflexframesync_release_frame(_q, _q->frame);
+        return;
+    }
+
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    struct ofdmflexframesync_msg_s * msg =
+        (struct ofdmflexframesync_msg_s *) liquid_spscqueue_write_begin(_q->q_symbol);
+    msg->type  = _abort ? OFDMFLEXFRAMESYNC_MSG_ABORT : OFDMFLEXFRAMESYNC_MSG_FRAME;
+    msg->frame = _q->frame;
+    liquid_spscqueue_write_end(_q->q_symbol);
+#endif
+}
+
+// demodulate payload symbol into frame, returning 1 when the payload
+// is complete
+int ofdmflexframesync_demod_symbol(ofdmflexframesync                  _q,
+                                   struct ofdmflexframesync_frame_s * _f,
+                                   float complex *                    _X)
+{
+    // configure demodulator at start of frame
+    if (_f->payload_symbol_index == 0 && _f->framestats.mod_scheme != _q->ms_demod) {
+        _q->ms_demod    = _f->framestats.mod_scheme;
+        _q->mod_payload = modem_recreate(_q->mod_payload, _q->ms_demod);
+    }
+    unsigned int bps = _f->framestats.mod_bps;
+
     // demodulate paylod symbols
     unsigned int i;
-    int sctype;
     for (i=0; i<_q->M; i++) {
-        // subcarrier type (PILOT/NULL/DATA)
-        sctype = _q->p[i];
-
         // ignore pilot and null subcarriers
-        if (sctype == OFDMFRAME_SCTYPE_DATA) {
-            // unload payload symbols
-            unsigned int sym;
-            modem_demodulate(_q->mod_payload, _X[i], &sym);
+        if (_q->p[i] != OFDMFRAME_SCTYPE_DATA)
+            continue;
+
+        // unload payload symbols
+        unsigned int sym;
+        modem_demodulate(_q->mod_payload, _X[i], &sym);
+
+        // pack decoded symbol into array
+        liquid_pack_array(_f->payload_enc,
+                          _f->payload_enc_len,
+                          _f->payload_buffer_index,
+                          bps,
+                          sym);
+        _f->payload_buffer_index += bps;
+
+        // increment symbol counter
+        _f->payload_symbol_index++;
+        if (_f->payload_symbol_index == _f->payload_mod_len) {
+            _f->t_demod = ofdmflexframesync_time();
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// decode payload of frame and invoke callback
+void ofdmflexframesync_decode_frame(ofdmflexframesync                  _q,
+                                    struct ofdmflexframesync_frame_s * _f)
+{
+    if (_f->aborted)
+        return;
 
-            // pack decoded symbol into array
-            liquid_pack_array(_q->payload_enc,
-                              _q->payload_enc_len,
-                              _q->payload_buffer_index,
-                              _q->bps_payload,
-                              sym);
+    if (_f->header_valid) {
+        // re-configure packetizer and decode payload
+        _q->p_payload = packetizer_recreate(_q->p_payload,
+                                            _f->payload_len,
+                                            _f->framestats.check,
+                                            _f->framestats.fec0,
+                                            _f->framestats.fec1);
+        _f->payload_valid = packetizer_decode(_q->p_payload, _f->payload_enc, _f->payload_dec);
+#if DEBUG_OFDMFLEXFRAMESYNC
+        printf("****** payload extracted [%s]\n", _f->payload_valid ? "valid" : "INVALID!");
+#endif
+    }
 
-            // increment...
-            _q->payload_buffer_index += _q->bps_payload;
+    // record latency
+    _q->latency[0] = (float)(_f->t_sync  - _f->t_start);
+    _q->latency[1] = (float)(_f->t_demod - _f->t_sync);
+    _q->latency[2] = (float)(ofdmflexframesync_time() - _f->t_demod);
 
-            // increment symbol counter
-            _q->payload_symbol_index++;
+    // ignore callback if set to NULL
+    if (_q->callback == NULL)
+        return;
 
-            if (_q->payload_symbol_index == _q->payload_mod_len) {
-                // payload extracted
+    // invoke callback method
+    _q->callback(_f->header,
+                 _f->header_valid,
+                 _f->header_valid ? _f->payload_dec : NULL,
+                 _f->header_valid ? _f->payload_len : 0,
+                 _f->payload_valid,
+                 _f->framestats,
+                 _q->userdata);
+}
 
-                // decode payload
-                _q->payload_valid = packetizer_decode(_q->p_payload, _q->payload_enc, _q->payload_dec);
-#if DEBUG_OFDMFLEXFRAMESYNC
-                printf("****** payload extracted [%s]\n", _q->payload_valid ? "valid" : "INVALID!");
+// return frame descriptor to acquisition stage
+void ofdmflexframesync_release_frame(ofdmflexframesync _q,
+                                     unsigned int      _frame)
+{
+    if (_q->num_threads == 1) {
+        _q->frames_free[_q->num_free++] = _frame;
+        return;
+    }
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    unsigned int * v = (unsigned int*) liquid_spscqueue_write_begin(_q->q_free);
+    *v = _frame;
+    liquid_spscqueue_write_end(_q->q_free);
 #endif
+}
 
-                // ignore callback if set to NULL
-                if (_q->callback == NULL) {
-                    ofdmflexframesync_reset(_q);
-                    break;
-                }
+// wait for a frame descriptor to be returned to acquisition stage
+void ofdmflexframesync_wait_frame(ofdmflexframesync _q)
+{
+    assert(_q->num_threads > 1);
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    unsigned int * v = (unsigned int*) liquid_spscqueue_read_begin(_q->q_free);
+    _q->frames_free[_q->num_free++] = *v;
+    liquid_spscqueue_read_end(_q->q_free);
+#endif
+}
 
-                // set framestats internals
-                _q->framestats.rssi             = ofdmframesync_get_rssi(_q->fs);
-                _q->framestats.cfo              = ofdmframesync_get_cfo(_q->fs);
-                _q->framestats.framesyms        = NULL;
-                _q->framestats.num_framesyms    = 0;
-                _q->framestats.mod_scheme       = _q->ms_payload;
-                _q->framestats.mod_bps          = _q->bps_payload;
-                _q->framestats.check            = _q->check;
-                _q->framestats.fec0             = _q->fec0;
-                _q->framestats.fec1             = _q->fec1;
-
-                // invoke callback method
-                _q->callback(_q->header,
-                             _q->header_valid,
-                             _q->payload_dec,
-                             _q->payload_len,
-                             _q->payload_valid,
-                             _q->framestats,
-                             _q->userdata);
-
-
-                // reset object
-                ofdmflexframesync_reset(_q);
-                break;
-            }
+// allocate _num_frames frame descriptors
+void ofdmflexframesync_create_frames(ofdmflexframesync _q,
+                                     unsigned int      _num_frames)
+{
+    _q->num_frames  = _num_frames;
+    _q->frames      = (struct ofdmflexframesync_frame_s*) malloc(_num_frames*sizeof(struct ofdmflexframesync_frame_s));
+    _q->frames_free = (unsigned int*) malloc(_num_frames*sizeof(unsigned int));
+    _q->num_free    = _num_frames;
+
+    unsigned int i;
+    for (i=0; i<_num_frames; i++) {
+        struct ofdmflexframesync_frame_s * f = &_q->frames[i];
+        f->eq = (_num_frames > 1) ?
+            ofdmframesync_create(_q->M, _q->cp_len, _q->taper_len, _q->p, NULL, NULL) : NULL;
+        f->payload_enc = NULL;
+        f->payload_dec = NULL;
+        _q->frames_free[i] = _num_frames - 1 - i;
+    }
+    _q->frame = 0;
+}
+
+// free frame descriptors
+void ofdmflexframesync_destroy_frames(ofdmflexframesync _q)
+{
+    unsigned int i;
+    for (i=0; i<_q->num_frames; i++) {
+        struct ofdmflexframesync_frame_s * f = &_q->frames[i];
+        if (f->eq != NULL)
+            ofdmframesync_destroy(f->eq);
+        free(f->payload_enc);
+        free(f->payload_dec);
+    }
+    free(_q->frames);
+    free(_q->frames_free);
+}
+
+#if OFDMFLEXFRAMESYNC_PTHREAD
+// payload recovery stage: transform, equalize and demodulate symbols,
+// then decode (two threads) or pass frames on to decoding stage
+static void * ofdmflexframesync_demod_thread(void * _arg)
+{
+    ofdmflexframesync q = (ofdmflexframesync) _arg;
+    while (1) {
+        struct ofdmflexframesync_msg_s * msg =
+            (struct ofdmflexframesync_msg_s *) liquid_spscqueue_read_begin(q->q_symbol);
+        int          type  = msg->type;
+        unsigned int frame = msg->frame;
+        if (type == OFDMFLEXFRAMESYNC_MSG_STOP) {
+            liquid_spscqueue_read_end(q->q_symbol);
+            break;
+        }
+
+        struct ofdmflexframesync_frame_s * f = &q->frames[frame];
+        int done = 1;
+        f->aborted = (type == OFDMFLEXFRAMESYNC_MSG_ABORT);
+        if (type == OFDMFLEXFRAMESYNC_MSG_SYMBOL) {
+            ofdmframesync_rxsymbol_deferred(f->eq, msg->x, q->X);
+            done = ofdmflexframesync_demod_symbol(q, f, q->X);
+        } else {
+            f->t_demod = ofdmflexframesync_time();
         }
+        liquid_spscqueue_read_end(q->q_symbol);
+        if (!done)
+            continue;
+
+        if (q->num_threads == 2) {
+            ofdmflexframesync_decode_frame(q, f);
+            ofdmflexframesync_release_frame(q, frame);
+        } else {
+            unsigned int * v = (unsigned int*) liquid_spscqueue_write_begin(q->q_decode);
+            *v = frame;
+            liquid_spscqueue_write_end(q->q_decode);
+        }
+    }
+
+    // stop decoding stage
+    if (q->num_threads > 2) {
+        unsigned int * v = (unsigned int*) liquid_spscqueue_write_begin(q->q_decode);
+        *v = q->num_frames;
+        liquid_spscqueue_write_end(q->q_decode);
     }
+    return NULL;
 }
 
+// payload decoding stage: decode frames and invoke callback, in order
+static void * ofdmflexframesync_decode_thread(void * _arg)
+{
+    ofdmflexframesync q = (ofdmflexframesync) _arg;
+    while (1) {
+        unsigned int * v = (unsigned int*) liquid_spscqueue_read_begin(q->q_decode);
+        unsigned int frame = *v;
+        liquid_spscqueue_read_end(q->q_decode);
+        if (frame == q->num_frames)
+            break;
+
+        ofdmflexframesync_decode_frame(q, &q->frames[frame]);
+        ofdmflexframesync_release_frame(q, frame);
+    }
+    return NULL;
+}
+#endif
 
+// create queues and start worker threads
+void ofdmflexframesync_start_pipeline(ofdmflexframesync _q)
+{
+    if (_q->num_threads == 1)
+        return;
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    // queues returning frames hold every frame (and stop message) so
+    // that only the acquisition stage ever waits for space
+    _q->q_symbol = liquid_spscqueue_create(OFDMFLEXFRAMESYNC_NUM_SYMBOLS,
+        sizeof(struct ofdmflexframesync_msg_s) + _q->M*sizeof(float complex));
+    _q->q_decode = liquid_spscqueue_create(_q->num_frames+1, sizeof(unsigned int));
+    _q->q_free   = liquid_spscqueue_create(_q->num_frames,   sizeof(unsigned int));
+
+    if (pthread_create(&_q->threads[0], NULL, ofdmflexframesync_demod_thread, _q) != 0 ||
+        (_q->num_threads > 2 &&
+         pthread_create(&_q->threads[1], NULL, ofdmflexframesync_decode_thread, _q) != 0))
+    {
+        fprintf(stderr,"error: ofdmflexframesync_set_num_threads(), could not create thread\n");
+        exit(1);
+    }
+#endif
+}
 
+// deliver frames in flight, stop worker threads and destroy queues
+void ofdmflexframesync_stop_pipeline(ofdmflexframesync _q)
+{
+    if (_q->num_threads == 1)
+        return;
+#if OFDMFLEXFRAMESYNC_PTHREAD
+    struct ofdmflexframesync_msg_s * msg =
+        (struct ofdmflexframesync_msg_s *) liquid_spscqueue_write_begin(_q->q_symbol);
+    msg->type = OFDMFLEXFRAMESYNC_MSG_STOP;
+    liquid_spscqueue_write_end(_q->q_symbol);
+
+    pthread_join(_q->threads[0], NULL);
+    if (_q->num_threads > 2)
+        pthread_join(_q->threads[1], NULL);
+    ofdmflexframesync_flush(_q);
+
+    liquid_spscqueue_destroy(_q->q_symbol);
+    liquid_spscqueue_destroy(_q->q_decode);
+    liquid_spscqueue_destroy(_q->q_free);
+#endif
+}
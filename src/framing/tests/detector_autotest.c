@@ -17,6 +17,8 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -169,3 +171,86 @@ void detector_cccf_runtest(unsigned int _n,
 }
 
 
+
+// autotest helper function: run the same signal through the detector
+// sample by sample and in irregular blocks, and ensure both report the
+// same detections and estimates
+//  _n      :   sequence length
+void detector_cccf_block_runtest(unsigned int _n)
+{
+    unsigned int i;
+
+    // options
+    unsigned int num_samples = 40*_n;   // total number of samples
+    float threshold   = 0.7f;           // detection threshold (low false-alarm rate)
+    float dphi_max    = 0.05f;          // maximum carrier offset
+    float nstd        = 0.1f;           // noise standard deviation
+
+    // generate synchronization pattern (random QPSK)
+    float complex s[_n];
+    for (i=0; i<_n; i++) {
+        s[i] = (rand() % 2 ? 1.0f : -1.0f) +
+               (rand() % 2 ? 1.0f : -1.0f)*_Complex_I;
+    }
+
+    // generate noise with sequence inserted at regular intervals
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = nstd * ( randnf() + _Complex_I*randnf() ) * M_SQRT1_2;
+    unsigned int p, num_frames = 0;
+    for (p=_n/2; p+_n<num_samples; p+=3*_n+17) {
+        for (i=0; i<_n; i++)
+            x[p+i] += s[i] * cexpf(_Complex_I*0.02f*i);
+        num_frames++;
+    }
+
+    // create detectors
+    detector_cccf q0 = detector_cccf_create(s, _n, threshold, dphi_max);
+    detector_cccf q1 = detector_cccf_create(s, _n, threshold, dphi_max);
+
+    float tau0, dphi0, gamma0;  // estimates (sample by sample)
+    float tau1, dphi1, gamma1;  // estimates (block)
+    unsigned int num_detected = 0;
+    unsigned int num_mismatch = 0;
+    unsigned int n = 0;
+    while (n < num_samples) {
+        // run block of irregular size through detector
+        unsigned int block_len = 1 + (rand() % (3*_n));
+        if (block_len > num_samples - n)
+            block_len = num_samples - n;
+        unsigned int num_read = 0;
+        int detected1 = detector_cccf_correlate_block(q1, &x[n], block_len,
+                                                      &num_read, &tau1, &dphi1, &gamma1);
+
+        // compare with running samples one at a time
+        for (i=0; i<num_read; i++) {
+            int detected0 = detector_cccf_correlate(q0, x[n+i], &tau0, &dphi0, &gamma0);
+            if (detected0 != (detected1 && i == num_read-1))
+                num_mismatch++;
+            num_detected += detected0;
+        }
+
+        if (detected1) {
+            CONTEND_DELTA( tau1,   tau0,   1e-3f );
+            CONTEND_DELTA( dphi1,  dphi0,  1e-4f );
+            CONTEND_DELTA( gamma1, gamma0, 1e-3f*gamma0 );
+        }
+        n += num_read;
+    }
+
+    if (liquid_autotest_verbose)
+        printf("detector block [%4u]: %u / %u detected, %u mismatched\n",
+                _n, num_detected, num_frames, num_mismatch);
+
+    // destroy objects
+    detector_cccf_destroy(q0);
+    detector_cccf_destroy(q1);
+
+    CONTEND_EQUALITY( num_detected, num_frames );
+    CONTEND_EQUALITY( num_mismatch, 0 );
+}
+
+void autotest_detector_cccf_block_n64()  { detector_cccf_block_runtest(  64); }
+void autotest_detector_cccf_block_n83()  { detector_cccf_block_runtest(  83); }
+void autotest_detector_cccf_block_n256() { detector_cccf_block_runtest( 256); }
+void autotest_detector_cccf_block_n335() { detector_cccf_block_runtest( 335); }
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// count valid frames received on each channel
+static int framesyncbank_autotest_callback(unsigned char *  _header,
+                                           int              _header_valid,
+                                           unsigned char *  _payload,
+                                           unsigned int     _payload_len,
+                                           int              _payload_valid,
+                                           framesyncstats_s _stats,
+                                           void *           _userdata)
+{
+    unsigned int * num_frames = (unsigned int*) _userdata;
+    if (_header_valid && _payload_valid)
+        (*num_frames)++;
+    return 0;
+}
+
+// autotest helper function: transmit frames on some channels of a
+// multi-channel signal and ensure they are received on exactly those
+// channels
+//  _type           :   synchronizer type
+//  _num_channels   :   number of channels
+void framesyncbank_runtest(int          _type,
+                           unsigned int _num_channels)
+{
+    unsigned int i, c;
+
+    // options
+    unsigned int m        = 4;      // channelizer filter semi-length
+    float        As       = 60.0f;  // channelizer stop-band attenuation [dB]
+    unsigned int num_rows = 6000;   // channelized samples per channel
+    float        nstd     = 0.01f;  // noise standard deviation
+
+    // generate frame samples
+    unsigned char header[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+    unsigned char payload[64];
+    for (i=0; i<64; i++)
+        payload[i] = rand() & 0xff;
+    unsigned int frame_len;
+    float complex * frame;
+    if (_type == LIQUID_FRAMESYNCBANK_FRAMESYNC64) {
+        frame_len = FRAME64_LEN;
+        frame = (float complex*) malloc(frame_len*sizeof(float complex));
+        framegen64 fg = framegen64_create();
+        framegen64_execute(fg, header, payload, frame);
+        framegen64_destroy(fg);
+    } else {
+        flexframegenprops_s fgprops;
+        flexframegenprops_init_default(&fgprops);
+        flexframegen fg = flexframegen_create(&fgprops);
+        flexframegen_assemble(fg, header, payload, 64);
+        frame_len = flexframegen_getframelen(fg);
+        frame = (float complex*) malloc(frame_len*sizeof(float complex));
+        int frame_complete = 0;
+        for (i=0; !frame_complete; i+=2)
+            frame_complete = flexframegen_write_samples(fg, &frame[i]);
+        flexframegen_destroy(fg);
+    }
+
+    // frames start at different times in every third channel; channels
+    // 0 and 3 carry two frames
+    int frame_start[_num_channels][2];
+    unsigned int num_frames_tx[_num_channels];
+    for (c=0; c<_num_channels; c++) {
+        frame_start[c][0] = (c % 3 == 0) ? (int)(200 + 151*c) : -1;
+        frame_start[c][1] = (c == 0 || c == 3) ? frame_start[c][0] + (int)frame_len + 100 : -1;
+        num_frames_tx[c]  = (frame_start[c][0] >= 0) + (frame_start[c][1] >= 0);
+    }
+
+    // generate multi-channel signal
+    unsigned int num_samples = num_rows * _num_channels;
+    float complex * y = (float complex*) malloc(num_samples*sizeof(float complex));
+    firpfbch_crcf synth = firpfbch_crcf_create_kaiser(LIQUID_SYNTHESIZER, _num_channels, m, As);
+    float complex X[_num_channels];
+    for (i=0; i<num_rows; i++) {
+        for (c=0; c<_num_channels; c++) {
+            X[c] = 0.0f;
+            unsigned int j;
+            for (j=0; j<2; j++) {
+                int t = (int)i - frame_start[c][j];
+                if (frame_start[c][j] >= 0 && t >= 0 && t < (int)frame_len)
+                    X[c] = frame[t] * cexpf(_Complex_I*0.002f*c*t);
+            }
+        }
+        firpfbch_crcf_synthesizer_execute(synth, X, &y[i*_num_channels]);
+    }
+    firpfbch_crcf_destroy(synth);
+    for (i=0; i<num_samples; i++)
+        y[i] += nstd * (randnf() + _Complex_I*randnf()) * M_SQRT1_2;
+
+    // create frame synchronizer bank
+    unsigned int num_frames_rx[_num_channels];
+    void * userdata[_num_channels];
+    for (c=0; c<_num_channels; c++) {
+        num_frames_rx[c] = 0;
+        userdata[c] = (void*) &num_frames_rx[c];
+    }
+    framesyncbank q = framesyncbank_create(_type, _num_channels, m, As,
+                                           framesyncbank_autotest_callback,
+                                           userdata);
+
+    // run signal through bank in blocks of irregular size
+    unsigned int n = 0;
+    while (n < num_samples) {
+        unsigned int block_len = 1 + rand() % (7*_num_channels);
+        if (block_len > num_samples - n)
+            block_len = num_samples - n;
+        framesyncbank_execute(q, &y[n], block_len);
+        n += block_len;
+    }
+
+    if (liquid_autotest_verbose) {
+        framesyncbank_print(q);
+        for (c=0; c<_num_channels; c++)
+            printf("  channel %3u : %u / %u frames\n", c, num_frames_rx[c], num_frames_tx[c]);
+    }
+
+    // check frames were received on appropriate channels
+    for (c=0; c<_num_channels; c++)
+        CONTEND_EQUALITY( num_frames_rx[c], num_frames_tx[c] );
+
+    // no synchronizer should be left running
+    CONTEND_EQUALITY( framesyncbank_get_num_active(q), 0 );
+
+    // destroy objects
+    framesyncbank_destroy(q);
+    free(frame);
+    free(y);
+}
+
+void autotest_framesyncbank_framesync64_M8()    { framesyncbank_runtest(LIQUID_FRAMESYNCBANK_FRAMESYNC64,    8); }
+void autotest_framesyncbank_framesync64_M16()   { framesyncbank_runtest(LIQUID_FRAMESYNCBANK_FRAMESYNC64,   16); }
+void autotest_framesyncbank_flexframesync_M8()  { framesyncbank_runtest(LIQUID_FRAMESYNCBANK_FLEXFRAMESYNC,  8); }
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+#define OFDMFLEXFRAMESYNC_AUTOTEST_NUM_FRAMES (8)
+
+// frames received, in order of delivery
+struct ofdmflexframesync_autotest_s {
+    unsigned int num_frames;
+    unsigned int id[OFDMFLEXFRAMESYNC_AUTOTEST_NUM_FRAMES];
+    int          valid[OFDMFLEXFRAMESYNC_AUTOTEST_NUM_FRAMES];
+};
+
+static int ofdmflexframesync_autotest_callback(unsigned char *  _header,
+                                               int              _header_valid,
+                                               unsigned char *  _payload,
+                                               unsigned int     _payload_len,
+                                               int              _payload_valid,
+                                               framesyncstats_s _stats,
+                                               void *           _userdata)
+{
+    struct ofdmflexframesync_autotest_s * r = (struct ofdmflexframesync_autotest_s *) _userdata;
+    if (r->num_frames == OFDMFLEXFRAMESYNC_AUTOTEST_NUM_FRAMES)
+        return 0;
+
+    // payload byte i of frame k is (k + 3*i) & 0xff
+    int valid = _header_valid && _payload_valid;
+    unsigned int i;
+    for (i=0; valid && i<_payload_len; i++)
+        valid = (_payload[i] == ((_header[0] + 3*i) & 0xff));
+
+    r->id[r->num_frames]    = _header[0];
+    r->valid[r->num_frames] = valid;
+    r->num_frames++;
+    return 0;
+}
+
+// autotest helper function: receive a burst of frames with different
+// modulation and coding schemes, separated by short gaps, and ensure
+// all are delivered in order
+//  _num_threads    :   number of synchronizer threads
+void ofdmflexframesync_runtest(unsigned int _num_threads)
+{
+    unsigned int M      = 64;   // number of subcarriers
+    unsigned int cp_len = 16;   // cyclic prefix length
+    unsigned int num_frames = OFDMFLEXFRAMESYNC_AUTOTEST_NUM_FRAMES;
+    modulation_scheme ms[4] = {LIQUID_MODEM_QPSK, LIQUID_MODEM_QAM16,
+                               LIQUID_MODEM_PSK8, LIQUID_MODEM_QAM64};
+    fec_scheme fec[4] = {LIQUID_FEC_NONE, LIQUID_FEC_HAMMING128,
+                         LIQUID_FEC_CONV_V27, LIQUID_FEC_GOLAY2412};
+
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+
+    struct ofdmflexframesync_autotest_s r;
+    r.num_frames = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, 0, p,
+            ofdmflexframesync_autotest_callback, (void*)&r);
+    ofdmflexframesync_set_num_threads(fs, _num_threads);
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, 0, p, &fgprops);
+
+    unsigned int i, k;
+    float complex buffer[M + cp_len];
+    for (k=0; k<num_frames; k++) {
+        // assemble frame
+        unsigned char header[8] = {k, 0, 0, 0, 0, 0, 0, 0};
+        unsigned int payload_len = 40 + 37*k;
+        unsigned char payload[payload_len];
+        for (i=0; i<payload_len; i++)
+            payload[i] = (k + 3*i) & 0xff;
+        fgprops.check      = LIQUID_CRC_32;
+        fgprops.fec0       = fec[k % 4];
+        fgprops.fec1       = LIQUID_FEC_NONE;
+        fgprops.mod_scheme = ms[(k/2) % 4];
+        ofdmflexframegen_setprops(fg, &fgprops);
+        ofdmflexframegen_assemble(fg, header, payload, payload_len);
+
+        // gap, then frame
+        for (i=0; i<M+cp_len; i++)
+            buffer[i] = 0.001f*randnf()*cexpf(_Complex_I*2*M_PI*randf());
+        ofdmflexframesync_execute(fs, buffer, M+cp_len);
+
+        int last_symbol = 0;
+        while (!last_symbol) {
+            last_symbol = ofdmflexframegen_writesymbol(fg, buffer);
+            ofdmflexframesync_execute(fs, buffer, M+cp_len);
+        }
+    }
+    for (i=0; i<M+cp_len; i++)
+        buffer[i] = 0.0f;
+    ofdmflexframesync_execute(fs, buffer, M+cp_len);
+    ofdmflexframesync_flush(fs);
+
+    // check frames
+    CONTEND_EQUALITY(r.num_frames, num_frames);
+    for (k=0; k<r.num_frames; k++) {
+        CONTEND_EQUALITY(r.id[k], k);
+        CONTEND_EQUALITY(r.valid[k], 1);
+    }
+
+    // stage latencies are available
+    float latency[3];
+    ofdmflexframesync_get_latency(fs, &latency[0], &latency[1], &latency[2]);
+    for (k=0; k<3; k++)
+        CONTEND_GREATER_THAN(latency[k], -1e-6f);
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
+void autotest_ofdmflexframesync_threads1() { ofdmflexframesync_runtest(1); }
+void autotest_ofdmflexframesync_threads2() { ofdmflexframesync_runtest(2); }
+void autotest_ofdmflexframesync_threads3() { ofdmflexframesync_runtest(3); }
+
+// frame interrupted by reset is dropped without stalling the pipeline
+void autotest_ofdmflexframesync_reset()
+{
+    unsigned int M      = 64;   // number of subcarriers
+    unsigned int cp_len = 16;   // cyclic prefix length
+
+    struct ofdmflexframesync_autotest_s r;
+    r.num_frames = 0;
+    ofdmflexframesync fs = ofdmflexframesync_create(M, cp_len, 0, NULL,
+            ofdmflexframesync_autotest_callback, (void*)&r);
+    ofdmflexframesync_set_num_threads(fs, 3);
+
+    ofdmflexframegenprops_s fgprops;
+    ofdmflexframegenprops_init_default(&fgprops);
+    fgprops.check = LIQUID_CRC_32;
+    ofdmflexframegen fg = ofdmflexframegen_create(M, cp_len, 0, NULL, &fgprops);
+
+    unsigned int i, k;
+    unsigned char header[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    unsigned char payload[800];
+    for (i=0; i<800; i++)
+        payload[i] = (3*i) & 0xff;
+    float complex buffer[M + cp_len];
+
+    for (k=0; k<2; k++) {
+        ofdmflexframegen_assemble(fg, header, payload, 800);
+        unsigned int num_symbols = ofdmflexframegen_getframelen(fg);
+        int last_symbol = 0;
+        for (i=0; !last_symbol; i++) {
+            last_symbol = ofdmflexframegen_writesymbol(fg, buffer);
+            ofdmflexframesync_execute(fs, buffer, M+cp_len);
+
+            // interrupt first frame half-way through payload
+            if (k == 0 && i == num_symbols/2) {
+                ofdmflexframesync_reset(fs);
+                ofdmflexframegen_reset(fg);
+                break;
+            }
+        }
+    }
+    for (i=0; i<M+cp_len; i++)
+        buffer[i] = 0.0f;
+    ofdmflexframesync_execute(fs, buffer, M+cp_len);
+    ofdmflexframesync_flush(fs);
+
+    // only second frame is delivered
+    CONTEND_EQUALITY(r.num_frames, 1);
+    CONTEND_EQUALITY(r.valid[0], 1);
+
+    ofdmflexframegen_destroy(fg);
+    ofdmflexframesync_destroy(fs);
+}
+
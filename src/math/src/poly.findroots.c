@@ -298,8 +298,8 @@ void POLY(_findroots_bairstow_recursion)(T *          _p,
         printf("  step : %12.4e + j*%12.4e\n", crealf(du+dv), cimagf(du+dv));
 #endif
 
-        // adjust u, v
-        if (isnan(du) || isnan(dv)) {
+        // adjust u, v (x != x only holds for NaN, valid for real and complex T)
+        if (du != du || dv != dv) {
             u *= 0.5f;
             v *= 0.5f;
         } else {
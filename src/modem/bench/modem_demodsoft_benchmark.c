@@ -157,3 +157,53 @@ void benchmark_demodsoft_arb128opt MODEM_DEMODSOFT_BENCH_API(LIQUID_MODEM_ARB128
 void benchmark_demodsoft_arb256opt MODEM_DEMODSOFT_BENCH_API(LIQUID_MODEM_ARB256OPT)
 void benchmark_demodsoft_arb64vt   MODEM_DEMODSOFT_BENCH_API(LIQUID_MODEM_ARB64VT)
 
+
+#define MODEM_DEMODSOFT_BLOCK_BENCH_API(MS) \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ modem_demodulate_soft_block_bench(_start, _finish, _num_iterations, MS); }
+
+// Helper function to keep code base small
+void modem_demodulate_soft_block_bench(struct rusage *_start,
+                                       struct rusage *_finish,
+                                       unsigned long int *_num_iterations,
+                                       modulation_scheme _ms)
+{
+    // block size
+    unsigned int n = 240;
+
+    // normalize number of iterations
+    *_num_iterations /= n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // initialize demodulator
+    modem demod = modem_create(_ms);
+    unsigned int bps = modem_get_bps(demod);
+
+    unsigned long int i;
+
+    // generate input vector to demodulate (spiral)
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = 0.07 * (i%20) * cexpf(_Complex_I*2*M_PI*0.1*i);
+
+    unsigned char soft_bits[n*bps];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        modem_demodulate_soft_block(demod, x, n, soft_bits);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    modem_destroy(demod);
+}
+
+// block soft demodulation
+void benchmark_demodsoft_block_psk8    MODEM_DEMODSOFT_BLOCK_BENCH_API(LIQUID_MODEM_PSK8)
+void benchmark_demodsoft_block_qam16   MODEM_DEMODSOFT_BLOCK_BENCH_API(LIQUID_MODEM_QAM16)
+void benchmark_demodsoft_block_qam64   MODEM_DEMODSOFT_BLOCK_BENCH_API(LIQUID_MODEM_QAM64)
+void benchmark_demodsoft_block_qam128  MODEM_DEMODSOFT_BLOCK_BENCH_API(LIQUID_MODEM_QAM128)
+void benchmark_demodsoft_block_qam256  MODEM_DEMODSOFT_BLOCK_BENCH_API(LIQUID_MODEM_QAM256)
+void benchmark_demodsoft_block_apsk16  MODEM_DEMODSOFT_BLOCK_BENCH_API(LIQUID_MODEM_APSK16)
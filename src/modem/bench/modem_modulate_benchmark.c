@@ -138,3 +138,56 @@ void benchmark_modulate_arb128opt MODEM_MODULATE_BENCH_API(LIQUID_MODEM_ARB128OP
 void benchmark_modulate_arb256opt MODEM_MODULATE_BENCH_API(LIQUID_MODEM_ARB256OPT)
 void benchmark_modulate_arb64vt   MODEM_MODULATE_BENCH_API(LIQUID_MODEM_ARB64VT)
 
+
+#define MODEM_MODULATE_BLOCK_BENCH_API(MS)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ modem_modulate_block_bench(_start, _finish, _num_iterations, MS); }
+
+// Helper function to keep code base small
+void modem_modulate_block_bench(struct rusage *_start,
+                                struct rusage *_finish,
+                                unsigned long int *_num_iterations,
+                                modulation_scheme _ms)
+{
+    // block size
+    unsigned int n = 240;
+
+    // normalize number of iterations
+    *_num_iterations /= 2;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // initialize modulator
+    modem mod = modem_create(_ms);
+    unsigned int bps = modem_get_bps(mod);
+
+    unsigned int i;
+    unsigned char bytes[n];
+    for (i=0; i<n; i++)
+        bytes[i] = rand() & 0xff;
+    float complex y[n];
+
+    // start trials
+    unsigned long int j;
+    getrusage(RUSAGE_SELF, _start);
+    for (j=0; j<(*_num_iterations); j++) {
+        modem_modulate_block(mod, bytes, n, y);
+        bytes[j % ((n*bps)/8)] ^= (unsigned char)crealf(y[0]);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    modem_destroy(mod);
+}
+
+// block modulation
+void benchmark_modulate_block_bpsk    MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_BPSK)
+void benchmark_modulate_block_qpsk    MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_QPSK)
+void benchmark_modulate_block_psk8    MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_PSK8)
+void benchmark_modulate_block_dpsk4   MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_DPSK4)
+void benchmark_modulate_block_qam16   MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_QAM16)
+void benchmark_modulate_block_qam64   MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_QAM64)
+void benchmark_modulate_block_qam256  MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_QAM256)
+void benchmark_modulate_block_apsk32  MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_APSK32)
+void benchmark_modulate_block_arb64vt MODEM_MODULATE_BLOCK_BENCH_API(LIQUID_MODEM_ARB64VT)
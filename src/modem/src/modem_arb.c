@@ -60,6 +60,13 @@ MODEM() MODEM(_create_arb)(unsigned int _bits_per_symbol)
     q->modulate_func   = &MODEM(_modulate_arb);
     q->demodulate_func = &MODEM(_demodulate_arb);
 
+    // nearest-point search index (built once constellation is set)
+    q->data.arb.n        = 0;
+    q->data.arb.cand_ptr = NULL;
+    q->data.arb.cand     = NULL;
+    q->data.arb.bin_ptr  = NULL;
+    q->data.arb.bin      = NULL;
+
     return q;
 }
 
@@ -82,27 +89,9 @@ void MODEM(_demodulate_arb)(MODEM()        _q,
                             TC             _x,
                             unsigned int * _sym_out)
 {
-    //printf("modem_demodulate_arb() invoked with I=%d, Q=%d\n", x);
-    
     // search for symbol nearest to received sample
-    unsigned int i;
-    unsigned int s=0;
-    T d;            // distance
-    T d_min = 0.0f; // minimum distance
-
-    for (i=0; i<_q->M; i++) {
-        // compute distance from received symbol to constellation point
-        d = cabsf(_x - _q->symbol_map[i]);
-
-        // retain symbol with minimum distance
-        if ( i==0 || d < d_min ) {
-            d_min = d;
-            s = i;
-        }
-    }
-
-    // set output symbol
-    *_sym_out = s;
+    T d;
+    MODEM(_arb_search)(_q, _x, _sym_out, &d);
 
     // re-modulate symbol and store state
     MODEM(_modulate_arb)(_q, *_sym_out, &_q->x_hat);
@@ -208,6 +197,8 @@ void MODEM(_arb_init)(MODEM()      _q,
     // scale modem to have unity energy
     MODEM(_arb_scale)(_q);
 
+    // build nearest-point search index
+    MODEM(_arb_init_index)(_q);
 }
 
 // initialize an arbitrary modem object on a file
@@ -249,6 +240,9 @@ void MODEM(_arb_init_file)(MODEM() _q,
 
     // scale modem to have unity energy
     MODEM(_arb_scale)(_q);
+
+    // build nearest-point search index
+    MODEM(_arb_init_index)(_q);
 }
 
 // scale arbitrary modem constellation points
@@ -270,6 +264,173 @@ void MODEM(_arb_scale)(MODEM() _q)
     }
 }
 
+// build grid index for nearest-point search
+//
+// The constellation's bounding square, extended by a quarter of its
+// width on each side, is divided into n x n cells with n = 3 sqrt(M)
+// (about two cells per symbol spacing for a uniform constellation).
+// Each cell lists the symbols which may be nearest to some point in
+// the cell: symbol i is excluded when its minimum distance to the
+// cell exceeds the smallest maximum distance from any symbol to the
+// cell.  Each cell also lists the symbols lying within it.
+void MODEM(_arb_init_index)(MODEM() _q)
+{
+    // clear existing index
+    MODEM(_arb_free_index)(_q);
+
+    unsigned int M = _q->M;
+    unsigned int i;
+    unsigned int k;
+
+    // bounding square
+    T xmin = crealf(_q->symbol_map[0]), xmax = xmin;
+    T ymin = cimagf(_q->symbol_map[0]), ymax = ymin;
+    for (i=1; i<M; i++) {
+        T xi = crealf(_q->symbol_map[i]);
+        T yi = cimagf(_q->symbol_map[i]);
+        if (xi < xmin) xmin = xi;
+        if (xi > xmax) xmax = xi;
+        if (yi < ymin) ymin = yi;
+        if (yi > ymax) ymax = yi;
+    }
+    T w = (xmax - xmin) > (ymax - ymin) ? (xmax - xmin) : (ymax - ymin);
+    if (w <= 0.0f)
+        w = 1.0f;
+    w *= 1.5f;
+
+    unsigned int n = (unsigned int) ceilf(3.0f*sqrtf((float)M));
+    T cell = w / (T)n;
+    T x0 = 0.5f*(xmin + xmax - w);
+    T y0 = 0.5f*(ymin + ymax - w);
+    _q->data.arb.n        = n;
+    _q->data.arb.x0       = x0;
+    _q->data.arb.y0       = y0;
+    _q->data.arb.cell_inv = 1.0f / cell;
+
+    unsigned int num_cells = n*n;
+
+    // bin symbols by cell (counting sort)
+    unsigned int c[M];
+    _q->data.arb.bin_ptr = (unsigned int*)   calloc(num_cells+1, sizeof(unsigned int));
+    _q->data.arb.bin     = (unsigned short*) malloc(M*sizeof(unsigned short));
+    for (i=0; i<M; i++) {
+        int ix = (int)((crealf(_q->symbol_map[i]) - x0) * _q->data.arb.cell_inv);
+        int iy = (int)((cimagf(_q->symbol_map[i]) - y0) * _q->data.arb.cell_inv);
+        ix = ix < 0 ? 0 : (ix > (int)n-1 ? (int)n-1 : ix);
+        iy = iy < 0 ? 0 : (iy > (int)n-1 ? (int)n-1 : iy);
+        c[i] = iy*n + ix;
+        _q->data.arb.bin_ptr[c[i]+1]++;
+    }
+    for (k=0; k<num_cells; k++)
+        _q->data.arb.bin_ptr[k+1] += _q->data.arb.bin_ptr[k];
+    for (i=0; i<M; i++)
+        _q->data.arb.bin[ _q->data.arb.bin_ptr[c[i]]++ ] = i;
+    for (k=num_cells; k>0; k--)
+        _q->data.arb.bin_ptr[k] = _q->data.arb.bin_ptr[k-1];
+    _q->data.arb.bin_ptr[0] = 0;
+
+    // candidate lists
+    unsigned int num_alloc = 4*num_cells;
+    _q->data.arb.cand_ptr = (unsigned int*)   malloc((num_cells+1)*sizeof(unsigned int));
+    _q->data.arb.cand     = (unsigned short*) malloc(num_alloc*sizeof(unsigned short));
+    _q->data.arb.cand_ptr[0] = 0;
+    T dmin[M];
+    for (k=0; k<num_cells; k++) {
+        T rx0 = x0 + (k % n)*cell, rx1 = rx0 + cell;
+        T ry0 = y0 + (k / n)*cell, ry1 = ry0 + cell;
+
+        // minimum and maximum squared distance from each symbol to cell
+        T dmax_min = 0.0f;
+        for (i=0; i<M; i++) {
+            T xi = crealf(_q->symbol_map[i]);
+            T yi = cimagf(_q->symbol_map[i]);
+            T dx = xi < rx0 ? rx0 - xi : (xi > rx1 ? xi - rx1 : 0.0f);
+            T dy = yi < ry0 ? ry0 - yi : (yi > ry1 ? yi - ry1 : 0.0f);
+            dmin[i] = dx*dx + dy*dy;
+
+            dx = fabsf(xi - rx0) > fabsf(xi - rx1) ? fabsf(xi - rx0) : fabsf(xi - rx1);
+            dy = fabsf(yi - ry0) > fabsf(yi - ry1) ? fabsf(yi - ry0) : fabsf(yi - ry1);
+            T dmax = dx*dx + dy*dy;
+            if (i==0 || dmax < dmax_min)
+                dmax_min = dmax;
+        }
+
+        // retain candidates (allowing for round-off)
+        unsigned int p = _q->data.arb.cand_ptr[k];
+        dmax_min *= 1.0f + 1e-5f;
+        for (i=0; i<M; i++) {
+            if (dmin[i] > dmax_min)
+                continue;
+            if (p == num_alloc) {
+                num_alloc *= 2;
+                _q->data.arb.cand = (unsigned short*) realloc(_q->data.arb.cand, num_alloc*sizeof(unsigned short));
+            }
+            _q->data.arb.cand[p++] = i;
+        }
+        _q->data.arb.cand_ptr[k+1] = p;
+    }
+}
+
+// free grid index
+void MODEM(_arb_free_index)(MODEM() _q)
+{
+    free(_q->data.arb.cand_ptr);
+    free(_q->data.arb.cand);
+    free(_q->data.arb.bin_ptr);
+    free(_q->data.arb.bin);
+
+    _q->data.arb.n        = 0;
+    _q->data.arb.cand_ptr = NULL;
+    _q->data.arb.cand     = NULL;
+    _q->data.arb.bin_ptr  = NULL;
+    _q->data.arb.bin      = NULL;
+}
+
+// find constellation point nearest to received sample, comparing
+// squared distances; samples outside the grid (or before the index is
+// built) search the entire constellation
+//  _q      :   modem object
+//  _x      :   received sample
+//  _s      :   nearest symbol
+//  _d      :   squared distance to nearest symbol
+void MODEM(_arb_search)(MODEM()        _q,
+                        TC             _x,
+                        unsigned int * _s,
+                        T *            _d)
+{
+    unsigned int n = _q->data.arb.n;
+    T fx = (crealf(_x) - _q->data.arb.x0) * _q->data.arb.cell_inv;
+    T fy = (cimagf(_x) - _q->data.arb.y0) * _q->data.arb.cell_inv;
+
+    // candidate symbols
+    unsigned int     num_cand = _q->M;
+    unsigned short * cand     = NULL;
+    if (fx >= 0.0f && fx < (T)n && fy >= 0.0f && fy < (T)n) {
+        unsigned int k = (unsigned int)fy * n + (unsigned int)fx;
+        cand     = &_q->data.arb.cand[ _q->data.arb.cand_ptr[k] ];
+        num_cand = _q->data.arb.cand_ptr[k+1] - _q->data.arb.cand_ptr[k];
+    }
+
+    unsigned int j;
+    unsigned int s = 0;
+    T d_min = 0.0f;
+    for (j=0; j<num_cand; j++) {
+        unsigned int i = cand == NULL ? j : cand[j];
+
+        TC e = _x - _q->symbol_map[i];
+        T  d = crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+
+        // retain symbol with minimum distance (lowest index on a tie)
+        if ( j==0 || d < d_min || (d == d_min && i < s) ) {
+            d_min = d;
+            s = i;
+        }
+    }
+
+    *_s = s;
+    *_d = d_min;
+}
+
 // balance an arbitrary modem's I/Q points
 void MODEM(_arb_balance_iq)(MODEM() _q)
 {
@@ -295,16 +456,18 @@ void MODEM(_demodulate_soft_arb)(MODEM()         _q,
                                  unsigned char * _soft_bits)
 {
     unsigned int bps = _q->m;
-    unsigned int M   = _q->M;
 
     // gamma = 1/(2*sigma^2), approximate for constellation size
     T gamma = 1.2f*_q->M;
 
-    unsigned int s=0;       // hard decision output
     unsigned int k;         // bit index
     unsigned int i;         // symbol index
-    T d;                // distance for this symbol
-    TC x_hat;    // re-modulated symbol
+    T d;                    // distance for this symbol
+
+    // hard decision
+    unsigned int s;
+    T dmin;
+    MODEM(_arb_search)(_q, _r, &s, &dmin);
 
     T dmin_0[bps];
     T dmin_1[bps];
@@ -312,25 +475,52 @@ void MODEM(_demodulate_soft_arb)(MODEM()         _q,
         dmin_0[k] = 4.0f;
         dmin_1[k] = 4.0f;
     }
-    T dmin = 0.0f;
 
-    for (i=0; i<M; i++) {
-        // compute distance from received symbol
-        x_hat = _q->symbol_map[i];
-        d = crealf( (_r-x_hat)*conjf(_r-x_hat) );
+    // Only symbols within this (squared) distance need be considered:
+    // any bit whose nearest opposing symbol is farther away saturates
+    // its soft value, and distances are otherwise limited to 4.
+    T r2 = dmin + 8.0f/gamma;
+    if (r2 > 4.0f) r2 = 4.0f;
+
+    // range of grid cells covering the search radius
+    unsigned int n = _q->data.arb.n;
+    unsigned int ix0=0, ix1=0, iy0=0, iy1=0;
+    if (n > 0) {
+        T r   = sqrtf(r2);
+        T ci  = _q->data.arb.cell_inv;
+        T fx0 = (crealf(_r) - r - _q->data.arb.x0) * ci;
+        T fx1 = (crealf(_r) + r - _q->data.arb.x0) * ci;
+        T fy0 = (cimagf(_r) - r - _q->data.arb.y0) * ci;
+        T fy1 = (cimagf(_r) + r - _q->data.arb.y0) * ci;
+        ix0 = fx0 >= 0.0f ? (fx0 < (T)n ? (unsigned int)fx0 : n-1) : 0;
+        ix1 = fx1 >= 0.0f ? (fx1 < (T)n ? (unsigned int)fx1 : n-1) : 0;
+        iy0 = fy0 >= 0.0f ? (fy0 < (T)n ? (unsigned int)fy0 : n-1) : 0;
+        iy1 = fy1 >= 0.0f ? (fy1 < (T)n ? (unsigned int)fy1 : n-1) : 0;
+    }
 
-        // set hard-decision...
-        if (d < dmin || i==0) {
-            s = i;
-            dmin = d;
+    unsigned int iy, j;
+    for (iy=iy0; iy<=iy1; iy++) {
+        // symbols in row of cells (entire constellation without index)
+        unsigned int j0 = 0, j1 = _q->M;
+        if (n > 0) {
+            j0 = _q->data.arb.bin_ptr[iy*n + ix0];
+            j1 = _q->data.arb.bin_ptr[iy*n + ix1 + 1];
         }
 
-        for (k=0; k<bps; k++) {
-            // strip bit
-            if ( (s >> (bps-k-1)) & 0x01 ) {
-                if (d < dmin_1[k]) dmin_1[k] = d;
-            } else {
-                if (d < dmin_0[k]) dmin_0[k] = d;
+        for (j=j0; j<j1; j++) {
+            i = n > 0 ? _q->data.arb.bin[j] : j;
+
+            // compute distance from received symbol
+            TC e = _r - _q->symbol_map[i];
+            d = crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+
+            for (k=0; k<bps; k++) {
+                // strip bit
+                if ( (i >> (bps-k-1)) & 0x01 ) {
+                    if (d < dmin_1[k]) dmin_1[k] = d;
+                } else {
+                    if (d < dmin_0[k]) dmin_0[k] = d;
+                }
             }
         }
     }
@@ -343,8 +533,6 @@ void MODEM(_demodulate_soft_arb)(MODEM()         _q,
         _soft_bits[k] = (unsigned char)soft_bit;
     }
 
-    // hard decision
-
     // set hard output symbol
     *_s = s;
 
@@ -352,4 +540,3 @@ void MODEM(_demodulate_soft_arb)(MODEM()         _q,
     MODEM(_modulate_arb)(_q, *_s, &_q->x_hat);
     _q->r = _r;
 }
-
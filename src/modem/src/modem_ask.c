@@ -54,6 +54,11 @@ MODEM() MODEM(_create_ask)(unsigned int _bits_per_symbol)
     q->modulate_func = &MODEM(_modulate_ask);
     q->demodulate_func = &MODEM(_demodulate_ask);
 
+    // initialize symbol map
+    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
+    MODEM(_init_map)(q);
+    q->modulate_using_map = 1;
+
     // initialize soft-demodulation look-up table
     if (q->m >= 2 && q->m < 8)
         MODEM(_demodsoft_gentab)(q, 2);
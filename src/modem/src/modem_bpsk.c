@@ -40,6 +40,11 @@ MODEM() MODEM(_create_bpsk)()
     q->modulate_func   = &MODEM(_modulate_bpsk);
     q->demodulate_func = &MODEM(_demodulate_bpsk);
 
+    // initialize symbol map
+    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
+    MODEM(_init_map)(q);
+    q->modulate_using_map = 1;
+
     // reset and return
     MODEM(_reset)(q);
     return q;
@@ -110,6 +110,19 @@ struct MODEM(_s)
         struct {
             TC * map;           // 32-sample sub-map (first quadrant)
         } sqam128;
+
+        // arbitrary modem: uniform grid of n x n cells over the
+        // constellation for nearest-point search
+        struct {
+            T x0;                       // grid origin (in-phase)
+            T y0;                       // grid origin (quadrature)
+            T cell_inv;                 // inverse of cell width
+            unsigned int n;             // grid dimension
+            unsigned int *   cand_ptr;  // candidate list offsets [size: n*n+1]
+            unsigned short * cand;      // possible nearest symbols, per cell
+            unsigned int *   bin_ptr;   // bin offsets [size: n*n+1]
+            unsigned short * bin;       // symbols lying in each cell
+        } arb;
     } data;
 
     // modulate function pointer
@@ -127,6 +140,8 @@ struct MODEM(_s)
     // neighbors array
     unsigned char * demod_soft_neighbors;   // array of nearest neighbors
     unsigned int demod_soft_p;              // number of neighbors in array
+
+    liquid_simd_level simd; // SIMD kernel, chosen at run time
 };
 
 // create digital modem of a specific scheme and bits/symbol
@@ -245,6 +260,8 @@ void MODEM(_destroy)(MODEM() _q)
         free(_q->data.sqam128.map);
     } else if (liquid_modem_is_apsk(_q->scheme)) {
         free(_q->data.apsk.map);
+    } else if (_q->scheme == LIQUID_MODEM_ARB) {
+        MODEM(_arb_free_index)(_q);
     }
 
     // free main object memory
@@ -296,6 +313,8 @@ void MODEM(_init)(MODEM() _q,
     // soft demodulation
     _q->demod_soft_neighbors = NULL;
     _q->demod_soft_p = 0;
+
+    _q->simd = liquid_cpu_get_simd_level();
 }
 
 // initialize symbol map for fast modulation
@@ -370,6 +389,54 @@ void MODEM(_modulate_map)(MODEM() _q,
     *_y = _q->symbol_map[_symbol_in]; 
 }
 
+// modulate a block of symbols packed into bytes
+//  _q      :   modem object
+//  _bytes  :   input bits, packed most-significant bit first, bps bits
+//              per symbol [size: ceil(_n*bps/8) x 1]
+//  _n      :   number of output samples
+//  _y      :   output samples [size: _n x 1]
+void MODEM(_modulate_block)(MODEM()         _q,
+                            unsigned char * _bytes,
+                            unsigned int    _n,
+                            TC *            _y)
+{
+    unsigned int i = 0;
+    unsigned int m = _q->m;
+    unsigned char * b = _bytes;     // input byte pointer
+
+    // differential modems carry state from one symbol to the next
+    TC * map = liquid_modem_is_dpsk(_q->scheme) ? NULL : _q->symbol_map;
+
+    // whole symbols per byte: index table directly
+    if (map != NULL && (m==1 || m==2 || m==4 || m==8)) {
+        unsigned int n = 8 / m;             // symbols per byte
+        unsigned int mask = (1 << m) - 1;   // symbol mask
+        unsigned int k;
+        for ( ; i + n <= _n; i += n) {
+            unsigned int byte = *b++;
+            for (k=0; k<n; k++)
+                _y[i+k] = map[ (byte >> (8 - m*(k+1))) & mask ];
+        }
+    }
+
+    // general case: shift bytes through bit buffer
+    unsigned int buffer = 0;    // bit buffer
+    unsigned int num_bits = 0;  // number of bits in buffer
+    for ( ; i<_n; i++) {
+        if (num_bits < m) {
+            buffer = (buffer << 8) | *b++;
+            num_bits += 8;
+        }
+        num_bits -= m;
+        unsigned int s = (buffer >> num_bits) & ((1 << m) - 1);
+
+        if (map != NULL)
+            _y[i] = map[s];
+        else
+            _q->modulate_func(_q, s, &_y[i]);
+    }
+}
+
 // generic demodulation
 void MODEM(_demodulate)(MODEM() _q,
                         TC x,
@@ -412,6 +479,56 @@ void MODEM(_demodulate_soft)(MODEM() _q,
     liquid_unpack_soft_bits(symbol_out, _q->m, _soft_bits);
 }
 
+// generic soft demodulation of a block of samples
+//  _q          :   modem object
+//  _x          :   input samples [size: _n x 1]
+//  _n          :   number of input samples
+//  _soft_bits  :   output soft bits [size: _n*bps x 1]
+void MODEM(_demodulate_soft_block)(MODEM()         _q,
+                                   TC *            _x,
+                                   unsigned int    _n,
+                                   unsigned char * _soft_bits)
+{
+    if (_n == 0)
+        return;
+
+    unsigned int i;
+    unsigned int s;
+
+    // QAM: closed-form max-log LLRs on each axis
+    if (liquid_modem_is_qam(_q->scheme)) {
+        MODEM(_demodulate_soft_block_qam)(_q, _x, _n, _soft_bits);
+
+        // leave demodulator state as though the last sample were
+        // demodulated on its own
+        MODEM(_demodulate)(_q, _x[_n-1], &s);
+        return;
+    }
+
+    // resolve soft demodulation method once for the entire block
+    void (*demodulate_soft)(MODEM(), TC, unsigned int *, unsigned char *) = NULL;
+    switch (_q->scheme) {
+    case LIQUID_MODEM_ARB:  demodulate_soft = MODEM(_demodulate_soft_arb);  break;
+    case LIQUID_MODEM_BPSK: demodulate_soft = MODEM(_demodulate_soft_bpsk); break;
+    case LIQUID_MODEM_QPSK: demodulate_soft = MODEM(_demodulate_soft_qpsk); break;
+    default:
+        if (_q->demod_soft_neighbors != NULL && _q->demod_soft_p != 0)
+            demodulate_soft = MODEM(_demodulate_soft_table);
+    }
+
+    if (demodulate_soft != NULL) {
+        for (i=0; i<_n; i++)
+            demodulate_soft(_q, _x[i], &s, &_soft_bits[i*_q->m]);
+        return;
+    }
+
+    // demodulate normally and unpack hard-demodulated bits
+    for (i=0; i<_n; i++) {
+        _q->demodulate_func(_q, _x[i], &s);
+        liquid_unpack_soft_bits(s, _q->m, &_soft_bits[i*_q->m]);
+    }
+}
+
 #if DEBUG_DEMODULATE_SOFT
 // print a string of bits to the standard output
 void print_bitstring_demod_soft(unsigned int _x,
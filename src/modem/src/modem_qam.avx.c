@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// modem_qam.avx.c : QAM soft demodulation (AVX2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// soft demodulation of square QAM, four samples (eight axes) at a
+// time; see modem_demodulate_soft_qam_sse()
+__attribute__((target("avx2,fma")))
+unsigned int modem_demodulate_soft_qam_avx2(float complex * _x,
+                                            unsigned int    _n,
+                                            unsigned int    _m,
+                                            float           _alpha_inv,
+                                            float           _g,
+                                            unsigned char * _soft_bits)
+{
+    const __m256  sign  = _mm256_set1_ps(-0.0f);
+    const __m256  half  = _mm256_set1_ps(0.5f);
+    const __m256  one   = _mm256_set1_ps(1.0f);
+    const __m256i onei  = _mm256_set1_epi32(1);
+    const __m256  c127  = _mm256_set1_ps(127.0f);
+    const __m256  c255  = _mm256_set1_ps(255.0f);
+    const __m256  zero  = _mm256_setzero_ps();
+    const __m256  ainv  = _mm256_set1_ps(_alpha_inv);
+    const __m256  g     = _mm256_set1_ps(_g);
+
+    // compaction of _m bytes from each lane: within each 128-bit half,
+    // then across halves, and store mask for the 2*_m resulting words
+    char         shuf[32];
+    int          perm[8];
+    int          mask[8];
+    unsigned int j;
+    for (j=0; j<32; j++)
+        shuf[j] = (j%16) < 4*_m ? (char)(((j%16)/_m)*4 + (j%16)%_m) : (char)0x80;
+    for (j=0; j<8; j++) {
+        perm[j] = j < _m ? j : (j < 2*_m ? j - _m + 4 : 0);
+        mask[j] = j < 2*_m ? -1 : 0;
+    }
+    const __m256i vshuf = _mm256_loadu_si256((__m256i*)shuf);
+    const __m256i vperm = _mm256_loadu_si256((__m256i*)perm);
+    const __m256i vmask = _mm256_loadu_si256((__m256i*)mask);
+
+    unsigned int i;
+    for (i=0; i+4 <= _n; i+=4) {
+        __m256  y = _mm256_mul_ps(_mm256_loadu_ps((float*)(_x + i)), ainv);
+        __m256i w = _mm256_setzero_si256();
+        float   L = (float)(1 << _m);
+
+        unsigned int k;
+        for (k=0; k<_m; k++) {
+            __m256 t = _mm256_min_ps(_mm256_andnot_ps(sign, y), _mm256_set1_ps(L));
+
+            __m256i q = _mm256_cvttps_epi32(_mm256_mul_ps(t, half));
+            __m256  h = _mm256_cvtepi32_ps(_mm256_add_epi32(_mm256_slli_epi32(q, 1), onei));
+            h = _mm256_min_ps(h, _mm256_set1_ps(L-1));
+
+            __m256 llr = _mm256_mul_ps(_mm256_add_ps(one, h),
+                                       _mm256_add_ps(_mm256_sub_ps(_mm256_add_ps(t, t), h), one));
+            llr = _mm256_xor_ps(llr, _mm256_and_ps(y, sign));
+            if (k > 0)
+                llr = _mm256_xor_ps(llr, sign);
+
+            __m256 v = _mm256_add_ps(_mm256_mul_ps(llr, g), c127);
+            v = _mm256_min_ps(_mm256_max_ps(v, zero), c255);
+            w = _mm256_or_si256(w, _mm256_sll_epi32(_mm256_cvttps_epi32(v), _mm_cvtsi32_si128(8*k)));
+
+            y = _mm256_sub_ps(t, _mm256_set1_ps(0.5f*L));
+            L *= 0.5f;
+        }
+
+        // store 8*_m bytes
+        int * b = (int*)&_soft_bits[2*i*_m];
+        if (_m == 4) {
+            _mm256_storeu_si256((__m256i*)b, w);
+        } else {
+            w = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(w, vshuf), vperm);
+            _mm256_maskstore_epi32(b, vmask, w);
+        }
+    }
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -140,3 +140,90 @@ void MODEM(_demodulate_qam)(MODEM()      _q,
     _q->r = _x;
 }
 
+
+// soft demodulation of a block of QAM samples
+//
+// Each bit's log-likelihood ratio is approximated by the difference
+// in squared distance to the nearest constellation points having that
+// bit cleared and set (max-log).  With Gray-coded in-phase and
+// quadrature components the distances separate, so each bit depends
+// only on its own axis; see MODEM(_demodulate_soft_pam)().
+//  _q          :   demodulator object
+//  _x          :   input samples [size: _n x 1]
+//  _n          :   number of input samples
+//  _soft_bits  :   output soft bits [size: _n*m x 1]
+void MODEM(_demodulate_soft_block_qam)(MODEM()         _q,
+                                       TC *            _x,
+                                       unsigned int    _n,
+                                       unsigned char * _soft_bits)
+{
+    unsigned int m_i = _q->data.qam.m_i;
+    unsigned int m_q = _q->data.qam.m_q;
+    T alpha_inv = 1.0f / _q->data.qam.alpha;
+
+    // gamma = 1/(2*sigma^2), approximate for constellation size (same
+    // as MODEM(_demodulate_soft_table)()), and scaled to soft-bit units
+    // with distances normalized to alpha
+    T gamma = 1.2f*_q->M;
+    T g = _q->data.qam.alpha * _q->data.qam.alpha * gamma * 16;
+
+    unsigned int i = 0;
+#if LIQUID_CPU_X86
+    // square constellations: both axes processed in parallel
+    if (m_i == m_q) {
+        if (_q->simd >= LIQUID_SIMD_AVX2)
+            i = modem_demodulate_soft_qam_avx2(_x, _n, m_i, alpha_inv, g, _soft_bits);
+        else if (_q->simd == LIQUID_SIMD_SSE)
+            i = modem_demodulate_soft_qam_sse(_x, _n, m_i, alpha_inv, g, _soft_bits);
+    }
+#endif
+
+    for ( ; i<_n; i++) {
+        unsigned char * b = &_soft_bits[i*_q->m];
+        MODEM(_demodulate_soft_pam)(crealf(_x[i])*alpha_inv, m_i, g, b);
+        MODEM(_demodulate_soft_pam)(cimagf(_x[i])*alpha_inv, m_q, g, b + m_i);
+    }
+}
+
+// max-log soft demodulation of one Gray-coded QAM axis having 2^_m
+// levels at odd integers, ..., -3, -1, 1, 3, ...
+//
+// The most-significant bit splits the levels by sign; with t = |y|
+// and h the level nearest to t, the squared-distance difference to
+// the nearest level on either side is (1+h)(2t+1-h).  The remaining
+// bits are symmetric about zero, so the axis is folded about zero and
+// re-centered (y <- |y| - L/2) and the same expression applies to the
+// next bit, with the bit set on the inner half.
+//  _y          :   received value, normalized by alpha
+//  _m          :   bits per axis
+//  _g          :   soft-bit scaling
+//  _soft_bits  :   output soft bits [size: _m x 1]
+void MODEM(_demodulate_soft_pam)(T               _y,
+                                 unsigned int    _m,
+                                 T               _g,
+                                 unsigned char * _soft_bits)
+{
+    T L = (T)(1 << _m);     // number of levels
+    unsigned int k;
+    for (k=0; k<_m; k++) {
+        // limit distance; beyond the outer level soft bits saturate
+        T t = fabsf(_y) < L ? fabsf(_y) : L;
+
+        // nearest level
+        T h = (T)(2*(int)(0.5f*t) + 1);
+        if (h > L-1) h = L-1;
+
+        T llr = (1+h)*((t+t)-h+1);
+        if ( (k==0) == (_y < 0) )
+            llr = -llr;
+
+        T v = llr*_g + 127;
+        if (v <   0) v = 0;
+        if (v > 255) v = 255;
+        _soft_bits[k] = (unsigned char)v;
+
+        // fold and re-center for next bit
+        _y = t - 0.5f*L;
+        L *= 0.5f;
+    }
+}
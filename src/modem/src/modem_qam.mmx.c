@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// modem_qam.mmx.c : QAM soft demodulation (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// soft demodulation of square QAM, two samples (four axes) at a time;
+// see modem_demodulate_soft_pam()
+__attribute__((target("sse2")))
+unsigned int modem_demodulate_soft_qam_sse(float complex * _x,
+                                           unsigned int    _n,
+                                           unsigned int    _m,
+                                           float           _alpha_inv,
+                                           float           _g,
+                                           unsigned char * _soft_bits)
+{
+    const __m128  sign  = _mm_set1_ps(-0.0f);
+    const __m128  half  = _mm_set1_ps(0.5f);
+    const __m128  one   = _mm_set1_ps(1.0f);
+    const __m128i onei  = _mm_set1_epi32(1);
+    const __m128  c127  = _mm_set1_ps(127.0f);
+    const __m128  c255  = _mm_set1_ps(255.0f);
+    const __m128  zero  = _mm_setzero_ps();
+    const __m128  ainv  = _mm_set1_ps(_alpha_inv);
+    const __m128  g     = _mm_set1_ps(_g);
+
+    unsigned int i;
+    for (i=0; i+2 <= _n; i+=2) {
+        __m128  y = _mm_mul_ps(_mm_loadu_ps((float*)(_x + i)), ainv);
+        __m128i w = _mm_setzero_si128();
+        float   L = (float)(1 << _m);
+
+        // soft bits of each axis are packed into bytes of its lane
+        unsigned int k;
+        for (k=0; k<_m; k++) {
+            __m128 t = _mm_min_ps(_mm_andnot_ps(sign, y), _mm_set1_ps(L));
+
+            // nearest level, h = min(2 floor(t/2) + 1, L-1)
+            __m128i q = _mm_cvttps_epi32(_mm_mul_ps(t, half));
+            __m128  h = _mm_cvtepi32_ps(_mm_add_epi32(_mm_slli_epi32(q, 1), onei));
+            h = _mm_min_ps(h, _mm_set1_ps(L-1));
+
+            // (1+h)(2t+1-h), signed
+            __m128 llr = _mm_mul_ps(_mm_add_ps(one, h),
+                                    _mm_add_ps(_mm_sub_ps(_mm_add_ps(t, t), h), one));
+            llr = _mm_xor_ps(llr, _mm_and_ps(y, sign));
+            if (k > 0)
+                llr = _mm_xor_ps(llr, sign);
+
+            __m128 v = _mm_add_ps(_mm_mul_ps(llr, g), c127);
+            v = _mm_min_ps(_mm_max_ps(v, zero), c255);
+            w = _mm_or_si128(w, _mm_sll_epi32(_mm_cvttps_epi32(v), _mm_cvtsi32_si128(8*k)));
+
+            // fold and re-center
+            y = _mm_sub_ps(t, _mm_set1_ps(0.5f*L));
+            L *= 0.5f;
+        }
+
+        // store 4*_m bytes
+        unsigned char * b = &_soft_bits[2*i*_m];
+        if (_m == 4) {
+            _mm_storeu_si128((__m128i*)b, w);
+        } else if (_m == 2) {
+            // sign-extend so that 32-to-16 bit saturation is exact
+            w = _mm_srai_epi32(_mm_slli_epi32(w, 16), 16);
+            _mm_storel_epi64((__m128i*)b, _mm_packs_epi32(w, w));
+        } else if (_m == 1) {
+            w = _mm_packs_epi32(w, w);
+            int b4 = _mm_cvtsi128_si32(_mm_packus_epi16(w, w));
+            memcpy(b, &b4, 4);
+        } else {
+            unsigned int v[4];
+            _mm_storeu_si128((__m128i*)v, w);
+            for (k=0; k<4; k++)
+                memcpy(&b[k*_m], &v[k], _m);
+        }
+    }
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -39,6 +39,11 @@ MODEM() MODEM(_create_sqam32)()
     q->modulate_func   = &MODEM(_modulate_sqam32);
     q->demodulate_func = &MODEM(_demodulate_sqam32);
 
+    // initialize symbol map
+    q->symbol_map = (TC*)malloc(q->M*sizeof(TC));
+    MODEM(_init_map)(q);
+    q->modulate_using_map = 1;
+
     // reset and return
     MODEM(_reset)(q);
     return q;
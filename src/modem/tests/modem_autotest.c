@@ -19,6 +19,8 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -115,3 +117,143 @@ void autotest_mod_demod_arb128opt() { modem_test_mod_demod(LIQUID_MODEM_ARB128OP
 void autotest_mod_demod_arb256opt() { modem_test_mod_demod(LIQUID_MODEM_ARB256OPT); }
 void autotest_mod_demod_arb64vt()   { modem_test_mod_demod(LIQUID_MODEM_ARB64VT);   }
 
+
+// Help function to keep code base small: compare hard and soft
+// demodulation of arbitrary modem against exhaustive search over
+// constellation, including samples far outside of it
+void modem_test_arb_search(modem _q)
+{
+    unsigned int bps = modem_get_bps(_q);
+    unsigned int M   = 1 << bps;
+    unsigned int i, j, k, s, s_soft;
+    unsigned char soft_bits[bps];
+
+    float complex c[M];
+    for (i=0; i<M; i++)
+        modem_modulate(_q, i, &c[i]);
+
+    for (i=0; i<2000; i++) {
+        float sigma = (i % 10) == 0 ? 3.0f : 0.8f;
+        float complex x = sigma*(randnf() + _Complex_I*randnf());
+
+        // exhaustive search: nearest symbol and nearest symbol with each
+        // bit cleared/set (distances limited to 4)
+        unsigned int s_test = 0;
+        float dmin = 0.0f;
+        float dmin_bit[bps][2];
+        for (k=0; k<bps; k++)
+            dmin_bit[k][0] = dmin_bit[k][1] = 4.0f;
+        for (j=0; j<M; j++) {
+            float complex e = x - c[j];
+            float d = crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+            if (j==0 || d < dmin) {
+                dmin = d;
+                s_test = j;
+            }
+            for (k=0; k<bps; k++) {
+                unsigned int bit = (j >> (bps-k-1)) & 1;
+                if (d < dmin_bit[k][bit]) dmin_bit[k][bit] = d;
+            }
+        }
+
+        modem_demodulate(_q, x, &s);
+        CONTEND_EQUALITY(s, s_test);
+
+        modem_demodulate_soft(_q, x, &s_soft, soft_bits);
+        CONTEND_EQUALITY(s_soft, s_test);
+        for (k=0; k<bps; k++) {
+            int soft_bit = ((dmin_bit[k][0] - dmin_bit[k][1])*1.2f*M)*16 + 127;
+            if (soft_bit > 255) soft_bit = 255;
+            if (soft_bit <   0) soft_bit = 0;
+            CONTEND_EQUALITY(soft_bits[k], soft_bit);
+        }
+    }
+}
+
+// AUTOTESTS: arbitrary modem nearest-point search
+void autotest_modem_arb_search_arb256opt()
+{
+    modem q = modem_create(LIQUID_MODEM_ARB256OPT);
+    modem_test_arb_search(q);
+    modem_destroy(q);
+}
+
+void autotest_modem_arb_search_arb64vt()
+{
+    modem q = modem_create(LIQUID_MODEM_ARB64VT);
+    modem_test_arb_search(q);
+    modem_destroy(q);
+}
+
+// irregular (spiral) constellation
+void autotest_modem_arb_search_spiral()
+{
+    unsigned int i, M = 128;
+    float complex c[M];
+    for (i=0; i<M; i++)
+        c[i] = (0.1f + 0.01f*i) * cexpf(_Complex_I*0.31f*i);
+
+    modem q = modem_create_arbitrary(c, M);
+    modem_test_arb_search(q);
+    modem_destroy(q);
+}
+
+// all points on the real axis (degenerate bounding box)
+void autotest_modem_arb_search_line()
+{
+    unsigned int i, M = 16;
+    float complex c[M];
+    for (i=0; i<M; i++)
+        c[i] = (float)i;
+
+    modem q = modem_create_arbitrary(c, M);
+    modem_test_arb_search(q);
+    modem_destroy(q);
+}
+
+// Help function to keep code base small
+void modem_test_modulate_block(modulation_scheme _ms,
+                               unsigned int      _n)
+{
+    // generate modulators; block and symbol-by-symbol
+    modem mod_block  = modem_create(_ms);
+    modem mod_symbol = modem_create(_ms);
+
+    unsigned int bps = modem_get_bps(mod_block);
+    unsigned int num_bytes = (_n*bps + 7) / 8;
+
+    // generate random packed input bits
+    unsigned int i;
+    unsigned char bytes[num_bytes];
+    for (i=0; i<num_bytes; i++)
+        bytes[i] = rand() & 0xff;
+
+    // modulate block
+    float complex y[_n];
+    modem_modulate_block(mod_block, bytes, _n, y);
+
+    // modulate one symbol at a time and compare
+    float complex x;
+    unsigned char s;
+    for (i=0; i<_n; i++) {
+        liquid_unpack_array(bytes, num_bytes, i*bps, bps, &s);
+        modem_modulate(mod_symbol, s, &x);
+        CONTEND_EQUALITY(crealf(y[i]), crealf(x));
+        CONTEND_EQUALITY(cimagf(y[i]), cimagf(x));
+    }
+
+    // clean it up
+    modem_destroy(mod_block);
+    modem_destroy(mod_symbol);
+}
+
+// AUTOTEST: block modulation from packed bytes, all schemes
+void autotest_modem_modulate_block()
+{
+    unsigned int i;
+    for (i=LIQUID_MODEM_UNKNOWN+1; i<LIQUID_MODEM_ARB; i++) {
+        // whole bytes and a partial final byte
+        modem_test_modulate_block(i, 64);
+        modem_test_modulate_block(i, 37);
+    }
+}
@@ -22,8 +22,10 @@
 // soft demodulation tests
 //
 
+#include <stdlib.h>
+
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 // Help function to keep code base small
 void modem_test_demodsoft(modulation_scheme _ms)
@@ -126,3 +128,99 @@ void autotest_demodsoft_arb128opt() { modem_test_demodsoft(LIQUID_MODEM_ARB128OP
 void autotest_demodsoft_arb256opt() { modem_test_demodsoft(LIQUID_MODEM_ARB256OPT); }
 void autotest_demodsoft_arb64vt()   { modem_test_demodsoft(LIQUID_MODEM_ARB64VT);   }
 
+
+// Help function to keep code base small: compare block soft
+// demodulation against per-sample soft demodulation or, for QAM,
+// against max-log ratios from an exhaustive search over the entire
+// constellation for each SIMD kernel
+void modem_test_demodsoft_block(modulation_scheme _ms)
+{
+    unsigned int n = 67;    // number of samples (not a multiple of 8)
+
+    unsigned int masks[3] = {
+        0,                                      // no extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        ~(LIQUID_CPU_AVX512F),                  // AVX2/FMA
+    };
+
+    // noisy input samples, some well beyond the constellation
+    unsigned int i, j, k;
+    float complex x[n];
+    for (i=0; i<n; i++)
+        x[i] = 1.5f*randnf() + _Complex_I*1.5f*randnf();
+
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        modem q = modem_create(_ms);
+        unsigned int bps = modem_get_bps(q);
+        unsigned int M   = 1 << bps;
+
+        unsigned char soft_bits[n*bps];
+        modem_demodulate_soft_block(q, x, n, soft_bits);
+
+        unsigned int s;
+        unsigned char soft_bits_test[bps];
+        float complex c[M];
+        for (j=0; j<M; j++)
+            modem_modulate(q, j, &c[j]);
+
+        for (i=0; i<n; i++) {
+            if (!liquid_modem_is_qam(_ms)) {
+                modem_demodulate_soft(q, x[i], &s, soft_bits_test);
+                for (j=0; j<bps; j++)
+                    CONTEND_EQUALITY(soft_bits[i*bps+j], soft_bits_test[j]);
+                continue;
+            }
+
+            // minimum distance to symbols with each bit cleared, set
+            float dmin[bps][2];
+            unsigned int b;
+            for (b=0; b<bps; b++)
+                dmin[b][0] = dmin[b][1] = 1e9f;
+            for (j=0; j<M; j++) {
+                float complex e = x[i] - c[j];
+                float d = crealf(e)*crealf(e) + cimagf(e)*cimagf(e);
+                for (b=0; b<bps; b++) {
+                    unsigned int bit = (j >> (bps-b-1)) & 1;
+                    if (d < dmin[b][bit]) dmin[b][bit] = d;
+                }
+            }
+
+            // same scaling as modem_demodulate_soft_table()
+            for (b=0; b<bps; b++) {
+                float v = (dmin[b][0] - dmin[b][1])*1.2f*M*16 + 127;
+                if (v <   0) v = 0;
+                if (v > 255) v = 255;
+                CONTEND_DELTA((float)soft_bits[i*bps+b], floorf(v), 1.0f);
+            }
+        }
+
+        // demodulator state follows the last sample
+        float complex x_hat_block, x_hat;
+        modem_demodulate_soft_block(q, x, n, soft_bits);
+        modem_get_demodulator_sample(q, &x_hat_block);
+        modem_demodulate(q, x[n-1], &s);
+        modem_get_demodulator_sample(q, &x_hat);
+        CONTEND_EQUALITY(x_hat_block, x_hat);
+
+        modem_destroy(q);
+    }
+
+    // restore processor features
+    liquid_cpu_set_mask(~0U);
+}
+
+// AUTOTESTS: block soft demodulation
+void autotest_demodsoft_block_psk8()    { modem_test_demodsoft_block(LIQUID_MODEM_PSK8);    }
+void autotest_demodsoft_block_ask4()    { modem_test_demodsoft_block(LIQUID_MODEM_ASK4);    }
+void autotest_demodsoft_block_qam4()    { modem_test_demodsoft_block(LIQUID_MODEM_QAM4);    }
+void autotest_demodsoft_block_qam8()    { modem_test_demodsoft_block(LIQUID_MODEM_QAM8);    }
+void autotest_demodsoft_block_qam16()   { modem_test_demodsoft_block(LIQUID_MODEM_QAM16);   }
+void autotest_demodsoft_block_qam32()   { modem_test_demodsoft_block(LIQUID_MODEM_QAM32);   }
+void autotest_demodsoft_block_qam64()   { modem_test_demodsoft_block(LIQUID_MODEM_QAM64);   }
+void autotest_demodsoft_block_qam128()  { modem_test_demodsoft_block(LIQUID_MODEM_QAM128);  }
+void autotest_demodsoft_block_qam256()  { modem_test_demodsoft_block(LIQUID_MODEM_QAM256);  }
+void autotest_demodsoft_block_apsk16()  { modem_test_demodsoft_block(LIQUID_MODEM_APSK16);  }
+void autotest_demodsoft_block_bpsk()    { modem_test_demodsoft_block(LIQUID_MODEM_BPSK);    }
+void autotest_demodsoft_block_qpsk()    { modem_test_demodsoft_block(LIQUID_MODEM_QPSK);    }
+void autotest_demodsoft_block_arb64vt() { modem_test_demodsoft_block(LIQUID_MODEM_ARB64VT); }
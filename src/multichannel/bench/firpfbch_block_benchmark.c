@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define FIRPFBCH_BLOCK_BENCH_API(NUM_CHANNELS,TYPE,NUM_THREADS) \
+(   struct rusage *_start,                                      \
+    struct rusage *_finish,                                     \
+    unsigned long int *_num_iterations)                         \
+{ firpfbch_crcf_block_bench(_start, _finish, _num_iterations, NUM_CHANNELS, TYPE, NUM_THREADS); }
+
+#define FIRPFBCH2_BLOCK_BENCH_API(NUM_CHANNELS,TYPE,NUM_THREADS)\
+(   struct rusage *_start,                                      \
+    struct rusage *_finish,                                     \
+    unsigned long int *_num_iterations)                         \
+{ firpfbch2_crcf_block_bench(_start, _finish, _num_iterations, NUM_CHANNELS, TYPE, NUM_THREADS); }
+
+// number of blocks per call
+#define FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS (32)
+
+// Helper function to keep code base small
+void firpfbch_crcf_block_bench(struct rusage *     _start,
+                               struct rusage *     _finish,
+                               unsigned long int * _num_iterations,
+                               unsigned int        _num_channels,
+                               int                 _type,
+                               unsigned int        _num_threads)
+{
+    // initialize channelizer
+    firpfbch_crcf q = firpfbch_crcf_create_kaiser(_type,_num_channels,4,60.0f);
+    firpfbch_crcf_set_num_threads(q, _num_threads);
+
+    unsigned long int i;
+    unsigned int n = _num_channels * FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS;
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = 1.0f + _Complex_I*1.0f;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_type == LIQUID_SYNTHESIZER)
+            firpfbch_crcf_synthesizer_execute_block(q, x, FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS, y);
+        else
+            firpfbch_crcf_analyzer_execute_block(q, x, FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS, y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS;
+
+    firpfbch_crcf_destroy(q);
+}
+
+// Helper function to keep code base small
+void firpfbch2_crcf_block_bench(struct rusage *     _start,
+                                struct rusage *     _finish,
+                                unsigned long int * _num_iterations,
+                                unsigned int        _num_channels,
+                                int                 _type,
+                                unsigned int        _num_threads)
+{
+    // initialize channelizer
+    firpfbch2_crcf q = firpfbch2_crcf_create_kaiser(_type,_num_channels,4,60.0f);
+    firpfbch2_crcf_set_num_threads(q, _num_threads);
+
+    unsigned long int i;
+    unsigned int n = _num_channels * FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS;
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = 1.0f + _Complex_I*1.0f;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firpfbch2_crcf_execute_block(q, x, FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= FIRPFBCH_BLOCK_BENCH_NUM_BLOCKS;
+
+    firpfbch2_crcf_destroy(q);
+}
+
+// firpfbch analysis/synthesis, 1, 2, and 4 threads
+void benchmark_firpfbch_crcf_block_a256_t1  FIRPFBCH_BLOCK_BENCH_API(256, LIQUID_ANALYZER,    1)
+void benchmark_firpfbch_crcf_block_a256_t2  FIRPFBCH_BLOCK_BENCH_API(256, LIQUID_ANALYZER,    2)
+void benchmark_firpfbch_crcf_block_a256_t4  FIRPFBCH_BLOCK_BENCH_API(256, LIQUID_ANALYZER,    4)
+void benchmark_firpfbch_crcf_block_s256_t1  FIRPFBCH_BLOCK_BENCH_API(256, LIQUID_SYNTHESIZER, 1)
+void benchmark_firpfbch_crcf_block_s256_t2  FIRPFBCH_BLOCK_BENCH_API(256, LIQUID_SYNTHESIZER, 2)
+void benchmark_firpfbch_crcf_block_s256_t4  FIRPFBCH_BLOCK_BENCH_API(256, LIQUID_SYNTHESIZER, 4)
+
+// firpfbch2 analysis/synthesis, 1, 2, and 4 threads
+void benchmark_firpfbch2_crcf_block_a256_t1 FIRPFBCH2_BLOCK_BENCH_API(256, LIQUID_ANALYZER,    1)
+void benchmark_firpfbch2_crcf_block_a256_t2 FIRPFBCH2_BLOCK_BENCH_API(256, LIQUID_ANALYZER,    2)
+void benchmark_firpfbch2_crcf_block_a256_t4 FIRPFBCH2_BLOCK_BENCH_API(256, LIQUID_ANALYZER,    4)
+void benchmark_firpfbch2_crcf_block_s256_t1 FIRPFBCH2_BLOCK_BENCH_API(256, LIQUID_SYNTHESIZER, 1)
+void benchmark_firpfbch2_crcf_block_s256_t2 FIRPFBCH2_BLOCK_BENCH_API(256, LIQUID_SYNTHESIZER, 2)
+void benchmark_firpfbch2_crcf_block_s256_t4 FIRPFBCH2_BLOCK_BENCH_API(256, LIQUID_SYNTHESIZER, 4)
+
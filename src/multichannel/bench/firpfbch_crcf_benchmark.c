@@ -82,3 +82,13 @@ void benchmark_firpfbch_crcf_a512    FIRPFBCH_EXECUTE_BENCH_API(512,  2,  LIQUID
 void benchmark_firpfbch_crcf_a1024   FIRPFBCH_EXECUTE_BENCH_API(1024, 2,  LIQUID_ANALYZER)
 
 
+
+// longer prototype filters
+void benchmark_firpfbch_crcf_a64_m8    FIRPFBCH_EXECUTE_BENCH_API(64,   8,  LIQUID_ANALYZER)
+void benchmark_firpfbch_crcf_a256_m8   FIRPFBCH_EXECUTE_BENCH_API(256,  8,  LIQUID_ANALYZER)
+void benchmark_firpfbch_crcf_a1024_m8  FIRPFBCH_EXECUTE_BENCH_API(1024, 8,  LIQUID_ANALYZER)
+
+// synthesis
+void benchmark_firpfbch_crcf_s64     FIRPFBCH_EXECUTE_BENCH_API(64,   2,  LIQUID_SYNTHESIZER)
+void benchmark_firpfbch_crcf_s256    FIRPFBCH_EXECUTE_BENCH_API(256,  2,  LIQUID_SYNTHESIZER)
+void benchmark_firpfbch_crcf_s1024   FIRPFBCH_EXECUTE_BENCH_API(1024, 2,  LIQUID_SYNTHESIZER)
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// firpfbch.avx.c : polyphase filterbank matrix-vector product (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// compute polyphase matrix-vector product for branches [0,k) for the
+// returned k, eight branches (two registers) at a time; see
+// firpfbch_matvec_sse()
+__attribute__((target("avx2,fma")))
+unsigned int firpfbch_matvec_avx2(unsigned int    _p,
+                                  unsigned int    _hs,
+                                 unsigned int    _xs,
+                                  float *         _hi,
+                                  float *         _hq,
+                                  float complex * _x,
+                                  float complex * _y,
+                                  unsigned int    _n)
+{
+    unsigned int i, t;
+    for (i=0; i+8 <= _n; i+=8) {
+        __m256 yi0 = _mm256_setzero_ps();
+        __m256 yi1 = _mm256_setzero_ps();
+        __m256 yq0 = _mm256_setzero_ps();
+        __m256 yq1 = _mm256_setzero_ps();
+        float * h = _hi + 2*i;
+        float * x = (float*)(_x + i);
+        for (t=0; t<_p; t++) {
+            __m256 x0 = _mm256_loadu_ps(x);
+            __m256 x1 = _mm256_loadu_ps(x+8);
+            yi0 = _mm256_fmadd_ps(_mm256_loadu_ps(h),   x0, yi0);
+            yi1 = _mm256_fmadd_ps(_mm256_loadu_ps(h+8), x1, yi1);
+            if (_hq != NULL) {
+                float * g = _hq + 2*i + 2*t*_hs;
+                yq0 = _mm256_fmadd_ps(_mm256_loadu_ps(g),   x0, yq0);
+                yq1 = _mm256_fmadd_ps(_mm256_loadu_ps(g+8), x1, yq1);
+            }
+            h += 2*_hs;
+            x -= 2*_xs;
+        }
+
+        // (a + jb)(c + jd) = (ac - bd) + j(ad + bc)
+        if (_hq != NULL) {
+            yi0 = _mm256_addsub_ps(yi0, _mm256_permute_ps(yq0, _MM_SHUFFLE(2,3,0,1)));
+            yi1 = _mm256_addsub_ps(yi1, _mm256_permute_ps(yq1, _MM_SHUFFLE(2,3,0,1)));
+        }
+        _mm256_storeu_ps((float*)(_y + i),     yi0);
+        _mm256_storeu_ps((float*)(_y + i) + 8, yi1);
+    }
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -33,6 +33,14 @@
 #include "liquid.internal.h"
 
 // firpfbch object structure definition
+//
+// The polyphase branches are stored as a single contiguous matrix of
+// coefficients H[t][i] (row t holds the t-th tap of every branch) and
+// all branches share one linear buffer of input samples (analyzer) or
+// transform outputs (synthesizer).  Row t of the matrix multiplies
+// the samples t*num_channels before the most recent block element by
+// element, so every branch is computed together in a single pass
+// over contiguous memory rather than one dot product per branch.
 struct FIRPFBCH(_s) {
     int type;                   // synthesis/analysis
     unsigned int num_channels;  // number of channels
@@ -41,18 +49,145 @@ struct FIRPFBCH(_s) {
     // filter
     unsigned int h_len;         // filter length
     TC * h;                     // filter coefficients
-    
-    // create separate bank of dotprod and window objects
-    DOTPROD() * dp;             // dot product object array
-    WINDOW() * w;               // window buffer object array
+
+    // polyphase coefficient matrix, [size: p x num_channels], with
+    // each coefficient repeated for the real and imaginary parts of
+    // the input
+    float * hi;                 // in-phase
+    float * hq;                 // quadrature (complex coefficients only)
+    liquid_simd_level simd;     // SIMD kernel, chosen at run time
+
+    // shared state buffer
+    T * buffer;                 // linear buffer of samples
+    unsigned int buffer_len;    // buffer length
+    unsigned int buffer_index;  // index following most recent sample
     unsigned int filter_index;  // running filter index (analysis)
 
     // fft plan
     FFT_PLAN fft;               // fft|ifft object
     TO * x;                     // fft|ifft transform input array
     TO * X;                     // fft|ifft transform output array
+
+    // worker threads for block execution (see set_num_threads());
+    // worker 0 is the calling thread and uses the plan and arrays above
+    liquid_threadpool pool;     // thread pool (NULL if single-threaded)
+    unsigned int num_workers;   // number of workers
+    FFT_PLAN * fft_w;           // per-worker transform plans
+    TO ** x_w;                  // per-worker transform output arrays
+    TO ** X_w;                  // per-worker transform input arrays
+};
+
+// maximum number of blocks processed by each parallel loop; the state
+// buffer holds this many blocks beyond the filter history
+#define FIRPFBCH_MAX_BLOCKS (32)
+
+// arguments for block tasks
+struct FIRPFBCH(_task_s) {
+    FIRPFBCH() q;               // filterbank object
+    TI * x;                     // input for block 0
+    TO * y;                     // output for block 0
+    unsigned int index;         // buffer index preceding block 0
+    unsigned int s;             // analyzer alignment offset
 };
 
+// make room for _n samples in state buffer, moving the most recent
+// samples to the front of the buffer when it is full
+static void FIRPFBCH(_buffer_reserve)(FIRPFBCH() _q,
+                                      unsigned int _n)
+{
+    if (_q->buffer_index + _n > _q->buffer_len) {
+        memmove(_q->buffer, _q->buffer + _q->buffer_index - _q->h_len, _q->h_len*sizeof(T));
+        _q->buffer_index = _q->h_len;
+    }
+}
+
+// append _n samples to state buffer
+static void FIRPFBCH(_buffer_append)(FIRPFBCH() _q,
+                                     T *        _x,
+                                     unsigned int _n)
+{
+    FIRPFBCH(_buffer_reserve)(_q, _n);
+    memmove(_q->buffer + _q->buffer_index, _x, _n*sizeof(T));
+    _q->buffer_index += _n;
+}
+
+// run analysis filters with the state buffer ending at index _e and
+// alignment offset _s, storing the result in _X
+//
+// Branch i of the filterbank (operating on every num_channels-th
+// input sample) produces transform input X[num_channels-i-1]; with
+// the coefficient matrix rows reversed, X[v] for v >= s reads the
+// num_channels samples ending s samples before the most recent one,
+// and X[v] for v < s one block later.
+static void FIRPFBCH(_analyzer_filter)(FIRPFBCH()   _q,
+                                       unsigned int _e,
+                                       unsigned int _s,
+                                       TO *         _X)
+{
+    unsigned int M = _q->num_channels;
+    T * r = _q->buffer + _e - M - _s;
+    firpfbch_matvec(_q->simd, _q->p, M, M, _q->hi + 2*_s,
+                    _q->hq == NULL ? NULL : _q->hq + 2*_s, r+_s, _X+_s, M-_s);
+    firpfbch_matvec(_q->simd, _q->p, M, M, _q->hi, _q->hq, r+M, _X, _s);
+}
+
+// analyzer task: filter and transform block _j on worker _w
+static void FIRPFBCH(_analyzer_task)(void *       _arg,
+                                     unsigned int _j,
+                                     unsigned int _w)
+{
+    struct FIRPFBCH(_task_s) * a = (struct FIRPFBCH(_task_s) *) _arg;
+    FIRPFBCH() q = a->q;
+    unsigned int M = q->num_channels;
+
+    FIRPFBCH(_analyzer_filter)(q, a->index + (_j+1)*M, a->s, q->X_w[_w]);
+    FFT_EXECUTE(q->fft_w[_w]);
+    memmove(a->y + _j*M, q->x_w[_w], M*sizeof(TO));
+}
+
+// synthesizer task: transform block _j on worker _w, storing result
+// in state buffer
+static void FIRPFBCH(_synthesizer_fft_task)(void *       _arg,
+                                            unsigned int _j,
+                                            unsigned int _w)
+{
+    struct FIRPFBCH(_task_s) * a = (struct FIRPFBCH(_task_s) *) _arg;
+    FIRPFBCH() q = a->q;
+    unsigned int M = q->num_channels;
+
+    memmove(q->X_w[_w], a->x + _j*M, M*sizeof(TI));
+    FFT_EXECUTE(q->fft_w[_w]);
+    memmove(q->buffer + a->index + _j*M, q->x_w[_w], M*sizeof(T));
+}
+
+// synthesizer task: run synthesis filters for block _j
+static void FIRPFBCH(_synthesizer_filter_task)(void *       _arg,
+                                               unsigned int _j,
+                                               unsigned int _w)
+{
+    struct FIRPFBCH(_task_s) * a = (struct FIRPFBCH(_task_s) *) _arg;
+    FIRPFBCH() q = a->q;
+    unsigned int M = q->num_channels;
+
+    T * r = q->buffer + a->index + _j*M;
+    firpfbch_matvec(q->simd, q->p, M, M, q->hi, q->hq, r, a->y + _j*M, M);
+}
+
+// run block task on all workers (or calling thread)
+static void FIRPFBCH(_execute_tasks)(FIRPFBCH()             _q,
+                                     liquid_threadpool_task _func,
+                                     void *                 _arg,
+                                     unsigned int           _num_blocks)
+{
+    if (_q->pool != NULL) {
+        liquid_threadpool_execute(_q->pool, _func, _arg, _num_blocks);
+    } else {
+        unsigned int j;
+        for (j=0; j<_num_blocks; j++)
+            _func(_arg, j, 0);
+    }
+}
+
 // create FIR polyphase filterbank channelizer object
 //  _type           :   channelizer type (LIQUID_ANALYZER | LIQUID_SYNTHESIZER)
 //  _num_channels   :   number of channels
@@ -84,30 +219,44 @@ FIRPFBCH() FIRPFBCH(_create)(int _type,
     // derived values
     q->h_len = q->num_channels * q->p;
 
-    // create bank of filters
-    q->dp   = (DOTPROD()*) malloc((q->num_channels)*sizeof(DOTPROD()));
-    q->w    = (WINDOW()*) malloc((q->num_channels)*sizeof(WINDOW()));
-
     // copy filter coefficients
     q->h = (TC*) malloc((q->h_len)*sizeof(TC));
     unsigned int i;
     for (i=0; i<q->h_len; i++)
         q->h[i] = _h[i];
 
-    // generate bank of sub-samped filters
-    unsigned int n;
-    unsigned int h_sub_len = q->p;
-    TC h_sub[h_sub_len];
-    for (i=0; i<q->num_channels; i++) {
-        // sub-sample prototype filter, loading coefficients in reverse order
-        for (n=0; n<h_sub_len; n++) {
-            h_sub[h_sub_len-n-1] = q->h[i + n*(q->num_channels)];
+    // load polyphase coefficient matrix, 64-byte aligned; the analyzer
+    // loads each row in reverse order (see analyzer_run())
+    if (posix_memalign((void**)&q->hi, 64, 2*q->h_len*sizeof(float)) != 0) {
+        fprintf(stderr,"error: firpfbch_%s_create(), could not allocate memory\n", EXTENSION_FULL);
+        exit(1);
+    }
+    q->hq = NULL;
+#if TC_COMPLEX
+    if (posix_memalign((void**)&q->hq, 64, 2*q->h_len*sizeof(float)) != 0) {
+        fprintf(stderr,"error: firpfbch_%s_create(), could not allocate memory\n", EXTENSION_FULL);
+        exit(1);
+    }
+#endif
+    unsigned int M = q->num_channels;
+    unsigned int t;
+    for (t=0; t<q->p; t++) {
+        for (i=0; i<M; i++) {
+            TC h = q->type == LIQUID_ANALYZER ? q->h[(t+1)*M-1-i] : q->h[t*M+i];
+            q->hi[2*(t*M+i)+0] = crealf(h);
+            q->hi[2*(t*M+i)+1] = crealf(h);
+#if TC_COMPLEX
+            q->hq[2*(t*M+i)+0] = cimagf(h);
+            q->hq[2*(t*M+i)+1] = cimagf(h);
+#endif
         }
-        // create window buffer and dotprod object (coefficients
-        // loaded in reverse order)
-        q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
-        q->w[i]  = WINDOW(_create)(h_sub_len);
     }
+    q->simd = liquid_cpu_get_simd_level();
+
+    // allocate shared state buffer, holding h_len samples of history
+    // plus room to append several blocks
+    q->buffer_len = q->h_len + FIRPFBCH_MAX_BLOCKS*q->num_channels;
+    q->buffer = (T*) malloc((q->buffer_len)*sizeof(T));
 
     // allocate memory for buffers
     // TODO : use fftw_malloc if HAVE_FFTW3_H
@@ -120,6 +269,14 @@ FIRPFBCH() FIRPFBCH(_create)(int _type,
     else
         q->fft = FFT_CREATE_PLAN(q->num_channels, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
+    // single-threaded by default
+    q->pool        = NULL;
+    q->num_workers = 0;
+    q->fft_w       = NULL;
+    q->x_w         = NULL;
+    q->X_w         = NULL;
+    FIRPFBCH(_set_num_threads)(q, 1);
+
     // clear filterbank object
     FIRPFBCH(_clear)(q);
 
@@ -244,15 +401,13 @@ FIRPFBCH() FIRPFBCH(_create_rnyquist)(int _type,
 // destroy firpfbch object
 void FIRPFBCH(_destroy)(FIRPFBCH() _q)
 {
-    unsigned int i;
+    // destroy thread pool and per-worker transforms
+    FIRPFBCH(_set_num_threads)(_q, 0);
 
-    // free dot product, window objects and arrays
-    for (i=0; i<_q->num_channels; i++) {
-        DOTPROD(_destroy)(_q->dp[i]);
-        WINDOW(_destroy)(_q->w[i]);
-    }
-    free(_q->dp);
-    free(_q->w);
+    // free coefficient matrix and state buffer
+    free(_q->hi);
+    free(_q->hq);
+    free(_q->buffer);
 
     // free transform object
     FFT_DESTROY_PLAN(_q->fft);
@@ -271,10 +426,14 @@ void FIRPFBCH(_clear)(FIRPFBCH() _q)
 {
     unsigned int i;
     for (i=0; i<_q->num_channels; i++) {
-        WINDOW(_clear)(_q->w[i]);
         _q->x[i] = 0;
         _q->X[i] = 0;
     }
+
+    // clear state buffer; reads extend h_len samples into the past
+    for (i=0; i<_q->buffer_len; i++)
+        _q->buffer[i] = 0;
+    _q->buffer_index = _q->h_len;
     _q->filter_index = _q->num_channels-1;
 }
 
@@ -289,6 +448,61 @@ void FIRPFBCH(_print)(FIRPFBCH() _q)
         printf("  h[%3u] = %12.8f + %12.8f*j\n", i, crealf(_q->h[i]), cimagf(_q->h[i]));
 }
 
+// set number of threads used by execute_block() methods, splitting
+// blocks across workers, each with its own transform; the output is
+// identical for any number of threads
+//  _q              :   filterbank channelizer object
+//  _num_threads    :   number of threads (including calling thread)
+void FIRPFBCH(_set_num_threads)(FIRPFBCH()   _q,
+                                unsigned int _num_threads)
+{
+    unsigned int i;
+
+    // destroy existing workers (worker 0 shares the object's plan)
+    if (_q->pool != NULL)
+        liquid_threadpool_destroy(_q->pool);
+    for (i=1; i<_q->num_workers; i++) {
+        FFT_DESTROY_PLAN(_q->fft_w[i]);
+        free(_q->x_w[i]);
+        free(_q->X_w[i]);
+    }
+    free(_q->fft_w);
+    free(_q->x_w);
+    free(_q->X_w);
+    _q->pool        = NULL;
+    _q->num_workers = 0;
+    _q->fft_w       = NULL;
+    _q->x_w         = NULL;
+    _q->X_w         = NULL;
+
+    // destroying object
+    if (_num_threads == 0)
+        return;
+
+    // create thread pool; the number of workers may be smaller than
+    // requested if threads are unsupported
+    if (_num_threads > 1) {
+        _q->pool = liquid_threadpool_create(_num_threads);
+        _q->num_workers = liquid_threadpool_get_num_threads(_q->pool);
+    } else {
+        _q->num_workers = 1;
+    }
+
+    // create per-worker transforms
+    int dir = _q->type == LIQUID_ANALYZER ? FFT_DIR_FORWARD : FFT_DIR_BACKWARD;
+    _q->fft_w = (FFT_PLAN*) malloc(_q->num_workers*sizeof(FFT_PLAN));
+    _q->x_w   = (TO**)      malloc(_q->num_workers*sizeof(TO*));
+    _q->X_w   = (TO**)      malloc(_q->num_workers*sizeof(TO*));
+    _q->fft_w[0] = _q->fft;
+    _q->x_w[0]   = _q->x;
+    _q->X_w[0]   = _q->X;
+    for (i=1; i<_q->num_workers; i++) {
+        _q->x_w[i]   = (TO*) malloc(_q->num_channels*sizeof(TO));
+        _q->X_w[i]   = (TO*) malloc(_q->num_channels*sizeof(TO));
+        _q->fft_w[i] = FFT_CREATE_PLAN(_q->num_channels, _q->X_w[i], _q->x_w[i], dir, FFT_METHOD);
+    }
+}
+
 // 
 // SYNTHESIZER
 //
@@ -301,23 +515,41 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,
                                     TI * _x,
                                     TO * _y)
 {
-    unsigned int i;
-
-    // copy channelized symbols to transform input
-    memmove(_q->X, _x, _q->num_channels*sizeof(TI));
-
-    // execute inverse DFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->fft);
-
-    // push samples into filter bank and execute
-    T * r;      // read pointer
-    for (i=0; i<_q->num_channels; i++) {
-        WINDOW(_push)(_q->w[i], _q->x[i]);
-        WINDOW(_read)(_q->w[i], &r);
-        DOTPROD(_execute)(_q->dp[i], r, &_y[i]);
+    FIRPFBCH(_synthesizer_execute_block)(_q, _x, 1, _y);
+}
 
-        // normalize by DFT scaling factor
-        //_y[i] /= (float) (_q->num_channels);
+// execute filterbank as synthesizer on several blocks of samples,
+// split across threads (see set_num_threads())
+//  _q          :   filterbank channelizer object
+//  _x          :   channelized input, [size: num_channels x _num_blocks]
+//  _num_blocks :   number of blocks
+//  _y          :   output time series, [size: num_channels x _num_blocks]
+void FIRPFBCH(_synthesizer_execute_block)(FIRPFBCH()   _q,
+                                          TI *         _x,
+                                          unsigned int _num_blocks,
+                                          TO *         _y)
+{
+    unsigned int M = _q->num_channels;
+    struct FIRPFBCH(_task_s) a;
+    a.q = _q;
+    a.s = 0;
+    while (_num_blocks > 0) {
+        unsigned int n = _num_blocks < FIRPFBCH_MAX_BLOCKS ? _num_blocks : FIRPFBCH_MAX_BLOCKS;
+
+        // inverse transforms, appending results to state buffer
+        FIRPFBCH(_buffer_reserve)(_q, n*M);
+        a.x     = _x;
+        a.y     = _y;
+        a.index = _q->buffer_index;
+        FIRPFBCH(_execute_tasks)(_q, FIRPFBCH(_synthesizer_fft_task), &a, n);
+        _q->buffer_index += n*M;
+
+        // run synthesis filters for each block
+        FIRPFBCH(_execute_tasks)(_q, FIRPFBCH(_synthesizer_filter_task), &a, n);
+
+        _x += n*M;
+        _y += n*M;
+        _num_blocks -= n;
     }
 }
 
@@ -333,15 +565,43 @@ void FIRPFBCH(_analyzer_execute)(FIRPFBCH() _q,
                                  TI * _x,
                                  TO * _y)
 {
-    unsigned int i;
-
-    // push samples into buffers
-    for (i=0; i<_q->num_channels; i++)
-        FIRPFBCH(_analyzer_push)(_q, _x[i]);
+    FIRPFBCH(_analyzer_execute_block)(_q, _x, 1, _y);
+}
 
-    // execute analysis filters on the given input starting
-    // with filterbank at index zero
-    FIRPFBCH(_analyzer_run)(_q, 0, _y);
+// execute filterbank as analyzer on several blocks of samples, split
+// across threads (see set_num_threads())
+//  _q          :   filterbank channelizer object
+//  _x          :   input time series, [size: num_channels x _num_blocks]
+//  _num_blocks :   number of blocks
+//  _y          :   channelized output, [size: num_channels x _num_blocks]
+void FIRPFBCH(_analyzer_execute_block)(FIRPFBCH()   _q,
+                                       TI *         _x,
+                                       unsigned int _num_blocks,
+                                       TO *         _y)
+{
+    unsigned int M = _q->num_channels;
+    struct FIRPFBCH(_task_s) a;
+    a.q = _q;
+
+    // alignment offset (filter index is unchanged after complete
+    // blocks)
+    a.s = (M - 1 - _q->filter_index) % M;
+    while (_num_blocks > 0) {
+        unsigned int n = _num_blocks < FIRPFBCH_MAX_BLOCKS ? _num_blocks : FIRPFBCH_MAX_BLOCKS;
+
+        // push samples into buffer and run each block
+        FIRPFBCH(_buffer_reserve)(_q, n*M);
+        a.x     = _x;
+        a.y     = _y;
+        a.index = _q->buffer_index;
+        memmove(_q->buffer + _q->buffer_index, _x, n*M*sizeof(T));
+        _q->buffer_index += n*M;
+        FIRPFBCH(_execute_tasks)(_q, FIRPFBCH(_analyzer_task), &a, n);
+
+        _x += n*M;
+        _y += n*M;
+        _num_blocks -= n;
+    }
 }
 
 // push single sample into analysis filterbank, updating index
@@ -351,8 +611,8 @@ void FIRPFBCH(_analyzer_execute)(FIRPFBCH() _q,
 void FIRPFBCH(_analyzer_push)(FIRPFBCH() _q,
                               TI _x)
 {
-    // push sample into filter
-    WINDOW(_push)(_q->w[_q->filter_index], _x);
+    // push sample into buffer
+    FIRPFBCH(_buffer_append)(_q, &_x, 1);
 
     // decrement filter index
     _q->filter_index = (_q->filter_index + _q->num_channels - 1) % _q->num_channels;
@@ -366,22 +626,14 @@ void FIRPFBCH(_analyzer_run)(FIRPFBCH() _q,
                              unsigned int _k,
                              TO * _y)
 {
-    unsigned int i;
+    unsigned int M = _q->num_channels;
 
-    // execute filter outputs, reversing order of output (not
-    // sure why this is necessary)
-    T * r;  // read pointer
-    unsigned int index;
-    for (i=0; i<_q->num_channels; i++) {
-        // compute appropriate index
-        index = (i+_k) % _q->num_channels;
+    // alignment offset: number of samples pushed since block
+    // boundary, plus filter alignment index
+    unsigned int s = (_k + M - 1 - _q->filter_index) % M;
 
-        // read buffer at specified index
-        WINDOW(_read)(_q->w[index], &r);
-
-        // compute dot product
-        DOTPROD(_execute)(_q->dp[i], r, &_q->X[_q->num_channels-i-1]);
-    }
+    // compute all filter outputs directly into transform input
+    FIRPFBCH(_analyzer_filter)(_q, _q->buffer_index, s, _q->X);
 
     // execute DFT, store result in buffer 'x'
     FFT_EXECUTE(_q->fft);
@@ -389,5 +641,3 @@ void FIRPFBCH(_analyzer_run)(FIRPFBCH() _q,
     // move to output array
     memmove(_y, _q->x, _q->num_channels*sizeof(TO));
 }
-
-
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// firpfbch.common.c
+//
+// polyphase filterbank methods common to firpfbch and firpfbch2
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+// polyphase filterbank matrix-vector product
+//   _y[i] = sum_{t=0}^{_p-1} H[t][i] * _x[i - t*_xs],  i in [0,_n)
+//  _simd   :   SIMD extensions to use (liquid_simd_level)
+//  _p      :   number of matrix rows (taps per branch)
+//  _hs     :   coefficient row stride
+//  _xs     :   input row stride
+//  _hi     :   in-phase coefficients, H[t][i] at _hi[2*(t*_hs+i)+{0,1}]
+//  _hq     :   quadrature coefficients (NULL if real)
+//  _x      :   input for row 0, _x[i - t*_xs] for row t
+//  _y      :   output, [size: _n x 1]
+//  _n      :   number of outputs (branches)
+void firpfbch_matvec(int               _simd,
+                     unsigned int      _p,
+                     unsigned int      _hs,
+                     unsigned int      _xs,
+                     float *           _hi,
+                     float *           _hq,
+                     float complex *   _x,
+                     float complex *   _y,
+                     unsigned int      _n)
+{
+    unsigned int i = 0;
+#if LIQUID_CPU_X86
+    if (_simd >= LIQUID_SIMD_AVX2)
+        i = firpfbch_matvec_avx2(_p, _hs, _xs, _hi, _hq, _x, _y, _n);
+    else if (_simd == LIQUID_SIMD_SSE)
+        i = firpfbch_matvec_sse(_p, _hs, _xs, _hi, _hq, _x, _y, _n);
+#endif
+    unsigned int t;
+    for ( ; i<_n; i++) {
+        float yi = 0.0f;
+        float yq = 0.0f;
+        for (t=0; t<_p; t++) {
+            float complex * r = _x - t*_xs;     // read pointer for row t
+            float * h = _hi + 2*(t*_hs + i);
+            float xi = crealf(r[i]);
+            float xq = cimagf(r[i]);
+            yi += h[0] * xi;
+            yq += h[1] * xq;
+            if (_hq != NULL) {
+                float * g = _hq + 2*(t*_hs + i);
+                yi -= g[0] * xq;
+                yq += g[1] * xi;
+            }
+        }
+        _y[i] = yi + _Complex_I*yq;
+    }
+}
+
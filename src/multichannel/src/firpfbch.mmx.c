@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// firpfbch.mmx.c : polyphase filterbank matrix-vector product (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// compute polyphase matrix-vector product for branches [0,k) for the
+// returned k, four branches (two registers) at a time
+//   _y[i] = sum_{t=0}^{_p-1} H[t][i] * _x[i - t*_xs]
+// where H[t][i] is stored at _hi[2*(t*_hs+i)] (repeated for real and
+// imaginary parts) and _hq, if not NULL, holds imaginary components
+__attribute__((target("sse2")))
+unsigned int firpfbch_matvec_sse(unsigned int    _p,
+                                 unsigned int    _hs,
+                                 unsigned int    _xs,
+                                 float *         _hi,
+                                 float *         _hq,
+                                 float complex * _x,
+                                 float complex * _y,
+                                 unsigned int    _n)
+{
+    const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    unsigned int i, t;
+    for (i=0; i+4 <= _n; i+=4) {
+        __m128 yi0 = _mm_setzero_ps();
+        __m128 yi1 = _mm_setzero_ps();
+        __m128 yq0 = _mm_setzero_ps();
+        __m128 yq1 = _mm_setzero_ps();
+        float * h = _hi + 2*i;
+        float * x = (float*)(_x + i);
+        for (t=0; t<_p; t++) {
+            __m128 x0 = _mm_loadu_ps(x);
+            __m128 x1 = _mm_loadu_ps(x+4);
+            yi0 = _mm_add_ps(yi0, _mm_mul_ps(_mm_loadu_ps(h),   x0));
+            yi1 = _mm_add_ps(yi1, _mm_mul_ps(_mm_loadu_ps(h+4), x1));
+            if (_hq != NULL) {
+                float * g = _hq + 2*i + 2*t*_hs;
+                yq0 = _mm_add_ps(yq0, _mm_mul_ps(_mm_loadu_ps(g),   x0));
+                yq1 = _mm_add_ps(yq1, _mm_mul_ps(_mm_loadu_ps(g+4), x1));
+            }
+            h += 2*_hs;
+            x -= 2*_xs;
+        }
+
+        // (a + jb)(c + jd) = (ac - bd) + j(ad + bc): swap real and
+        // imaginary parts of quadrature accumulators and negate real
+        if (_hq != NULL) {
+            yq0 = _mm_xor_ps(_mm_shuffle_ps(yq0, yq0, _MM_SHUFFLE(2,3,0,1)), sign);
+            yq1 = _mm_xor_ps(_mm_shuffle_ps(yq1, yq1, _MM_SHUFFLE(2,3,0,1)), sign);
+            yi0 = _mm_add_ps(yi0, yq0);
+            yi1 = _mm_add_ps(yi1, yq1);
+        }
+        _mm_storeu_ps((float*)(_y + i),     yi0);
+        _mm_storeu_ps((float*)(_y + i) + 4, yi1);
+    }
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -30,6 +30,11 @@
 #include <math.h>
 
 // firpfbch2 object structure definition
+//
+// As with firpfbch, the polyphase branches are stored as a single
+// contiguous coefficient matrix and share one linear buffer of input
+// samples (analyzer) or transform outputs (synthesizer); see
+// firpfbch_matvec().
 struct FIRPFBCH2(_s) {
     int type;           // synthesis/analysis
     unsigned int M;     // number of channels
@@ -38,22 +43,148 @@ struct FIRPFBCH2(_s) {
 
     // filter
     unsigned int h_len; // prototype filter length: 2*M*m
-    
-    // create separate bank of dotprod and window objects
-    DOTPROD() * dp;     // dot product object array
+
+    // polyphase coefficient matrix, each coefficient repeated for the
+    // real and imaginary parts of the input
+    //  analyzer    : [size: 2*m x M],   rows loaded in reverse order
+    //  synthesizer : [size: 4*m x M/2], prototype in original order
+    float * hi;         // in-phase
+    float * hq;         // quadrature (complex coefficients only)
+    liquid_simd_level simd; // SIMD kernel, chosen at run time
 
     // inverse FFT plan
     FFT_PLAN ifft;      // inverse FFT object
     TO * X;             // IFFT input array  [size: M x 1]
     TO * x;             // IFFT output array [size: M x 1]
 
-    // common data structures shared between analysis and
-    // synthesis algorithms
-    WINDOW() * w0;      // window buffer object array
-    WINDOW() * w1;      // window buffer object array (synthesizer only)
+    // shared state buffer
+    T * buffer;                 // linear buffer of samples
+    unsigned int buffer_hist;   // history required by filters
+    unsigned int buffer_len;    // buffer length
+    unsigned int buffer_index;  // index following most recent sample
     int flag;           // flag indicating filter/buffer alignment
+
+    // worker threads for block execution (see set_num_threads());
+    // worker 0 is the calling thread and uses the plan and arrays above
+    liquid_threadpool pool;     // thread pool (NULL if single-threaded)
+    unsigned int num_workers;   // number of workers
+    FFT_PLAN * ifft_w;          // per-worker transform plans
+    TO ** x_w;                  // per-worker transform output arrays
+    TO ** X_w;                  // per-worker transform input arrays
+    TO ** W_w;                  // per-worker filter output arrays (analyzer)
 };
 
+// maximum number of blocks processed by each parallel loop
+#define FIRPFBCH2_MAX_BLOCKS (32)
+
+// arguments for block tasks
+struct FIRPFBCH2(_task_s) {
+    FIRPFBCH2() q;              // filterbank object
+    TI * x;                     // input for block 0
+    TO * y;                     // output for block 0
+    unsigned int index;         // buffer index preceding block 0
+    int flag;                   // alignment flag for block 0
+};
+
+// make room for _n samples in state buffer, moving the most recent
+// samples to the front of the buffer when it is full
+static void FIRPFBCH2(_buffer_reserve)(FIRPFBCH2() _q,
+                                       unsigned int _n)
+{
+    if (_q->buffer_index + _n > _q->buffer_len) {
+        memmove(_q->buffer, _q->buffer + _q->buffer_index - _q->buffer_hist,
+                _q->buffer_hist*sizeof(T));
+        _q->buffer_index = _q->buffer_hist;
+    }
+}
+
+// analyzer task: filter and transform block _j on worker _w
+//
+// Input samples are loaded into the filter bank in blocks of M/2
+// starting in the middle and moving in the negative direction, so
+// that the branch operating on a sample of age a (relative to the
+// most recent) is (offset + a) mod M.  Row-reversed coefficients
+// give W[v] for the samples of age M-1-v, which is routed to
+// transform input X[(offset + M-1-v) mod M].
+static void FIRPFBCH2(_analyzer_task)(void *       _arg,
+                                      unsigned int _j,
+                                      unsigned int _w)
+{
+    struct FIRPFBCH2(_task_s) * a = (struct FIRPFBCH2(_task_s) *) _arg;
+    FIRPFBCH2() q = a->q;
+    unsigned int M = q->M;
+    unsigned int i;
+
+    // run filters for all branches
+    unsigned int e = a->index + (_j+1)*q->M2;
+    TO * W = q->W_w[_w];
+    TO * X = q->X_w[_w];
+    firpfbch_matvec(q->simd, 2*q->m, M, M, q->hi, q->hq, q->buffer + e - M, W, M);
+
+    // route to transform input
+    unsigned int offset = ((a->flag + _j) % 2) ? q->M2 : 0;
+    for (i=0; i<M; i++)
+        X[(offset + M - 1 - i) % M] = W[i];
+
+    // execute IFFT and scale result by 1/num_channels (C transform)
+    FFT_EXECUTE(q->ifft_w[_w]);
+    TO * y = a->y + _j*M;
+    for (i=0; i<M; i++)
+        y[i] = q->x_w[_w][i] / (float)(M);
+}
+
+// synthesizer task: transform block _j on worker _w, storing result
+// in state buffer
+static void FIRPFBCH2(_synthesizer_fft_task)(void *       _arg,
+                                             unsigned int _j,
+                                             unsigned int _w)
+{
+    struct FIRPFBCH2(_task_s) * a = (struct FIRPFBCH2(_task_s) *) _arg;
+    FIRPFBCH2() q = a->q;
+    unsigned int i;
+
+    memmove(q->X_w[_w], a->x + _j*q->M, q->M*sizeof(TI));
+    FFT_EXECUTE(q->ifft_w[_w]);
+
+    // TODO: ignore this scaling
+    // scale result by 1/num_channels (C transform) and num_channels/2
+    TO * x = q->x_w[_w];
+    T *  r = q->buffer + a->index + _j*q->M;
+    for (i=0; i<q->M; i++)
+        r[i] = (x[i] * (1.0f / (float)(q->M))) * (float)(q->M2);
+}
+
+// synthesizer task: run synthesis filters for block _j
+//
+// Output i combines tap q of the prototype, h[i + q*M/2], with
+// element i+offset of the transform output q blocks in the past.
+static void FIRPFBCH2(_synthesizer_filter_task)(void *       _arg,
+                                                unsigned int _j,
+                                                unsigned int _w)
+{
+    struct FIRPFBCH2(_task_s) * a = (struct FIRPFBCH2(_task_s) *) _arg;
+    FIRPFBCH2() q = a->q;
+
+    unsigned int offset = ((a->flag + _j) % 2) ? q->M2 : 0;
+    T * r = q->buffer + a->index + _j*q->M + offset;
+    firpfbch_matvec(q->simd, 4*q->m, q->M2, q->M, q->hi, q->hq, r, a->y + _j*q->M2, q->M2);
+}
+
+// run block task on all workers (or calling thread)
+static void FIRPFBCH2(_execute_tasks)(FIRPFBCH2()            _q,
+                                      liquid_threadpool_task _func,
+                                      void *                 _arg,
+                                      unsigned int           _num_blocks)
+{
+    if (_q->pool != NULL) {
+        liquid_threadpool_execute(_q->pool, _func, _arg, _num_blocks);
+    } else {
+        unsigned int j;
+        for (j=0; j<_num_blocks; j++)
+            _func(_arg, j, 0);
+    }
+}
+
 // create firpfbch2 object
 //  _type   :   channelizer type (e.g. LIQUID_ANALYZER)
 //  _M      :   number of channels (must be even)
@@ -89,21 +220,33 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
     q->h_len    = 2*q->M*q->m;  // prototype filter length
     q->M2       = q->M / 2;     // number of channels / 2
 
-    // generate bank of sub-samped filters
-    q->dp = (DOTPROD()*) malloc((q->M)*sizeof(DOTPROD()));
+    // load polyphase coefficient matrix, 64-byte aligned
+    if (posix_memalign((void**)&q->hi, 64, 2*q->h_len*sizeof(float)) != 0) {
+        fprintf(stderr,"error: firpfbch2_%s_create(), could not allocate memory\n", EXTENSION_FULL);
+        exit(1);
+    }
+    q->hq = NULL;
+#if TC_COMPLEX
+    if (posix_memalign((void**)&q->hq, 64, 2*q->h_len*sizeof(float)) != 0) {
+        fprintf(stderr,"error: firpfbch2_%s_create(), could not allocate memory\n", EXTENSION_FULL);
+        exit(1);
+    }
+#endif
     unsigned int i;
-    unsigned int n;
-    unsigned int h_sub_len = 2 * q->m;
-    TC h_sub[h_sub_len];
-    for (i=0; i<q->M; i++) {
-        // sub-sample prototype filter, loading coefficients
-        // in reverse order
-        for (n=0; n<h_sub_len; n++)
-            h_sub[h_sub_len-n-1] = _h[i + n*(q->M)];
-
-        // create dotprod object
-        q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
+    unsigned int t;
+    for (t=0; t<2*q->m; t++) {
+        for (i=0; i<q->M; i++) {
+            unsigned int n = t*q->M + i;
+            TC h = q->type == LIQUID_ANALYZER ? _h[(t+1)*q->M-1-i] : _h[n];
+            q->hi[2*n+0] = crealf(h);
+            q->hi[2*n+1] = crealf(h);
+#if TC_COMPLEX
+            q->hq[2*n+0] = cimagf(h);
+            q->hq[2*n+1] = cimagf(h);
+#endif
+        }
     }
+    q->simd = liquid_cpu_get_simd_level();
 
     // create FFT plan (inverse transform)
     // TODO : use fftw_malloc if HAVE_FFTW3_H
@@ -111,13 +254,20 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
     q->x = (T*) malloc((q->M)*sizeof(T));   // IFFT output
     q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
-    // create buffer objects
-    q->w0 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
-    q->w1 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
-    for (i=0; i<q->M; i++) {
-        q->w0[i] = WINDOW(_create)(h_sub_len);
-        q->w1[i] = WINDOW(_create)(h_sub_len);
-    }
+    // allocate shared state buffer: the analyzer reads h_len input
+    // samples and the synthesizer 4*m transform outputs of length M
+    q->buffer_hist  = q->type == LIQUID_ANALYZER ? q->h_len : 2*q->h_len;
+    q->buffer_len   = q->buffer_hist + FIRPFBCH2_MAX_BLOCKS*q->M;
+    q->buffer       = (T*) malloc((q->buffer_len)*sizeof(T));
+
+    // single-threaded by default
+    q->pool        = NULL;
+    q->num_workers = 0;
+    q->ifft_w      = NULL;
+    q->x_w         = NULL;
+    q->X_w         = NULL;
+    q->W_w         = NULL;
+    FIRPFBCH2(_set_num_threads)(q, 1);
 
     // reset filterbank object and return
     FIRPFBCH2(_reset)(q);
@@ -182,25 +332,18 @@ FIRPFBCH2() FIRPFBCH2(_create_kaiser)(int          _type,
 // destroy firpfbch2 object, freeing internal memory
 void FIRPFBCH2(_destroy)(FIRPFBCH2() _q)
 {
-    unsigned int i;
+    // destroy thread pool and per-worker transforms
+    FIRPFBCH2(_set_num_threads)(_q, 0);
 
-    // free dotprod objects
-    for (i=0; i<_q->M; i++)
-        DOTPROD(_destroy)(_q->dp[i]);
-    free(_q->dp);
+    // free coefficient matrix and state buffer
+    free(_q->hi);
+    free(_q->hq);
+    free(_q->buffer);
 
     // free transform object and arrays
     FFT_DESTROY_PLAN(_q->ifft);
     free(_q->X);
     free(_q->x);
-    
-    // free window objects (buffers)
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_destroy)(_q->w0[i]);
-        WINDOW(_destroy)(_q->w1[i]);
-    }
-    free(_q->w0);
-    free(_q->w1);
 
     // free main object memory
     free(_q);
@@ -211,11 +354,10 @@ void FIRPFBCH2(_reset)(FIRPFBCH2() _q)
 {
     unsigned int i;
 
-    // clear window buffers
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_clear)(_q->w0[i]);
-        WINDOW(_clear)(_q->w1[i]);
-    }
+    // clear state buffer; reads extend buffer_hist samples into the past
+    for (i=0; i<_q->buffer_len; i++)
+        _q->buffer[i] = 0;
+    _q->buffer_index = _q->buffer_hist;
 
     // reset filter/buffer alignment flag
     _q->flag = 0;
@@ -228,11 +370,70 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q)
     printf("    channels    :   %u\n", _q->M);
     printf("    h_len       :   %u\n", _q->h_len);
     printf("    semi-length :   %u\n", _q->m);
+    printf("    threads     :   %u\n", _q->num_workers);
+}
 
-    // TODO: print filter coefficients...
+// set number of threads used by execute_block(), splitting blocks
+// across workers, each with its own transform; the output is
+// identical for any number of threads
+//  _q              :   filterbank channelizer object
+//  _num_threads    :   number of threads (including calling thread)
+void FIRPFBCH2(_set_num_threads)(FIRPFBCH2()  _q,
+                                 unsigned int _num_threads)
+{
     unsigned int i;
-    for (i=0; i<_q->M; i++)
-        DOTPROD(_print)(_q->dp[i]);
+
+    // destroy existing workers (worker 0 shares the object's plan)
+    if (_q->pool != NULL)
+        liquid_threadpool_destroy(_q->pool);
+    for (i=0; i<_q->num_workers; i++) {
+        if (i > 0) {
+            FFT_DESTROY_PLAN(_q->ifft_w[i]);
+            free(_q->x_w[i]);
+            free(_q->X_w[i]);
+        }
+        free(_q->W_w[i]);
+    }
+    free(_q->ifft_w);
+    free(_q->x_w);
+    free(_q->X_w);
+    free(_q->W_w);
+    _q->pool        = NULL;
+    _q->num_workers = 0;
+    _q->ifft_w      = NULL;
+    _q->x_w         = NULL;
+    _q->X_w         = NULL;
+    _q->W_w         = NULL;
+
+    // destroying object
+    if (_num_threads == 0)
+        return;
+
+    // create thread pool; the number of workers may be smaller than
+    // requested if threads are unsupported
+    if (_num_threads > 1) {
+        _q->pool = liquid_threadpool_create(_num_threads);
+        _q->num_workers = liquid_threadpool_get_num_threads(_q->pool);
+    } else {
+        _q->num_workers = 1;
+    }
+
+    // create per-worker transforms and scratch arrays
+    _q->ifft_w = (FFT_PLAN*) malloc(_q->num_workers*sizeof(FFT_PLAN));
+    _q->x_w    = (TO**)      malloc(_q->num_workers*sizeof(TO*));
+    _q->X_w    = (TO**)      malloc(_q->num_workers*sizeof(TO*));
+    _q->W_w    = (TO**)      malloc(_q->num_workers*sizeof(TO*));
+    _q->ifft_w[0] = _q->ifft;
+    _q->x_w[0]    = _q->x;
+    _q->X_w[0]    = _q->X;
+    for (i=0; i<_q->num_workers; i++) {
+        if (i > 0) {
+            _q->x_w[i]    = (TO*) malloc(_q->M*sizeof(TO));
+            _q->X_w[i]    = (TO*) malloc(_q->M*sizeof(TO));
+            _q->ifft_w[i] = FFT_CREATE_PLAN(_q->M, _q->X_w[i], _q->x_w[i], FFT_DIR_BACKWARD, FFT_METHOD);
+        }
+        _q->W_w[i] = (TO*) malloc(_q->M*sizeof(TO));
+    }
 }
 
 // execute filterbank channelizer (analyzer)
@@ -242,40 +443,7 @@ void FIRPFBCH2(_execute_analyzer)(FIRPFBCH2() _q,
                                   TI *        _x,
                                   TO *        _y)
 {
-    unsigned int i;
-
-    // load buffers in blocks of num_channels/2 starting
-    // in the middle of the filter bank and moving in the
-    // negative direction
-    unsigned int base_index = _q->flag ? _q->M : _q->M2;
-    for (i=0; i<_q->M2; i++) {
-        // push sample into buffer at filter index
-        WINDOW(_push)(_q->w0[base_index-i-1], _x[i]);
-    }
-
-    // execute filter outputs
-    unsigned int offset = _q->flag ? _q->M2 : 0;
-    TI * r;      // buffer read pointer
-    for (i=0; i<_q->M; i++) {
-        // compute buffer index
-        unsigned int buffer_index  = (offset+i)%(_q->M);
-
-        // read buffer at index
-        WINDOW(_read)(_q->w0[buffer_index], &r);
-
-        // run dot product storing result in IFFT input buffer
-        DOTPROD(_execute)(_q->dp[i], r, &_q->X[buffer_index]);
-    }
-
-    // execute IFFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->ifft);
-
-    // scale result by 1/num_channels (C transform)
-    for (i=0; i<_q->M; i++)
-        _y[i] = _q->x[i] / (float)(_q->M);
-
-    // update flag
-    _q->flag = 1 - _q->flag;
+    FIRPFBCH2(_execute_block)(_q, _x, 1, _y);
 }
 
 // execute filterbank channelizer (synthesizer)
@@ -285,50 +453,52 @@ void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2() _q,
                                      TI *        _x,
                                      TO *        _y)
 {
-    unsigned int i;
-
-    // copy input array to internal IFFT input buffer
-    memmove(_q->X, _x, _q->M * sizeof(TI));
-
-    // execute IFFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->ifft);
+    FIRPFBCH2(_execute_block)(_q, _x, 1, _y);
+}
 
-    // TODO: ignore this scaling
-    // scale result by 1/num_channels (C transform)
-    for (i=0; i<_q->M; i++)
-        _q->x[i] *= 1.0f / (float)(_q->M);
-    // scale result by num_channels/2
-    for (i=0; i<_q->M; i++)
-        _q->x[i] *= (float)(_q->M2);
-
-    // push samples into appropriate buffer
-    WINDOW() * buffer = (_q->flag == 0 ? _q->w1 : _q->w0);
-    for (i=0; i<_q->M; i++)
-        WINDOW(_push)(buffer[i], _q->x[i]);
-
-    // compute filter outputs
-    TO * r0, * r1;  // buffer read pointers
-    TO   y0,   y1;  // dotprod outputs
-    for (i=0; i<_q->M2; i++) {
-        // buffer index
-        unsigned int b = (_q->flag == 0) ? i : i+_q->M2;
-
-        // read buffer with index offset
-        WINDOW(_read)(_q->w0[b], &r0);
-        WINDOW(_read)(_q->w1[b], &r1);
-
-        // swap buffer outputs on alternating runs
-        TO * p0 = _q->flag ? r0 : r1;
-        TO * p1 = _q->flag ? r1 : r0;
-
-        // run dot products
-        DOTPROD(_execute)(_q->dp[i],        p0, &y0);
-        DOTPROD(_execute)(_q->dp[i+_q->M2], p1, &y1);
-
-        // save output
-        _y[i] = y0 + y1;
+// execute filterbank channelizer on several blocks of samples,
+// split across threads (see set_num_threads())
+// LIQUID_ANALYZER:     input: M/2 x _num_blocks, output: M   x _num_blocks
+// LIQUID_SYNTHESIZER:  input: M   x _num_blocks, output: M/2 x _num_blocks
+//  _x          :   channelizer input
+//  _num_blocks :   number of blocks
+//  _y          :   channelizer output
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,
+                               TI *         _x,
+                               unsigned int _num_blocks,
+                               TO *         _y)
+{
+    unsigned int nx = _q->type == LIQUID_ANALYZER ? _q->M2 : _q->M;
+    unsigned int ny = _q->type == LIQUID_ANALYZER ? _q->M  : _q->M2;
+
+    struct FIRPFBCH2(_task_s) a;
+    a.q = _q;
+    while (_num_blocks > 0) {
+        unsigned int n = _num_blocks < FIRPFBCH2_MAX_BLOCKS ? _num_blocks : FIRPFBCH2_MAX_BLOCKS;
+
+        FIRPFBCH2(_buffer_reserve)(_q, n*_q->M);
+        a.x     = _x;
+        a.y     = _y;
+        a.index = _q->buffer_index;
+        a.flag  = _q->flag;
+        if (_q->type == LIQUID_ANALYZER) {
+            // push samples into buffer and run each block
+            memmove(_q->buffer + _q->buffer_index, _x, n*_q->M2*sizeof(T));
+            _q->buffer_index += n*_q->M2;
+            FIRPFBCH2(_execute_tasks)(_q, FIRPFBCH2(_analyzer_task), &a, n);
+        } else {
+            // inverse transforms, appending results to state buffer,
+            // then synthesis filters for each block
+            FIRPFBCH2(_execute_tasks)(_q, FIRPFBCH2(_synthesizer_fft_task), &a, n);
+            _q->buffer_index += n*_q->M;
+            FIRPFBCH2(_execute_tasks)(_q, FIRPFBCH2(_synthesizer_filter_task), &a, n);
+        }
+        _q->flag = (_q->flag + n) % 2;
+
+        _x += n*nx;
+        _y += n*ny;
+        _num_blocks -= n;
     }
-    _q->flag = 1 - _q->flag;
 }
 
 // execute filterbank channelizer
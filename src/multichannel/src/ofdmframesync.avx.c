@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// ofdmframesync.avx.c : subcarrier equalization (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// complex multiply of four interleaved pairs, given the real and
+// imaginary parts of _b duplicated in _br and _bi
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 ofdmframesync_cmul_avx2(__m256 _a,
+                                             __m256 _br,
+                                             __m256 _bi)
+{
+    __m256 as = _mm256_permute_ps(_a, _MM_SHUFFLE(2,3,0,1));
+    return _mm256_fmaddsub_ps(_a, _br, _mm256_mul_ps(as, _bi));
+}
+
+// complex multiply of four interleaved pairs
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 ofdmframesync_cmul2_avx2(__m256 _a,
+                                              __m256 _b)
+{
+    return ofdmframesync_cmul_avx2(_a, _mm256_moveldup_ps(_b), _mm256_movehdup_ps(_b));
+}
+
+// X[i] <- X[i] R[i] p[i%8] with eight lane phasors (two registers);
+// see ofdmframesync_equalize_sse()
+__attribute__((target("avx2,fma")))
+unsigned int ofdmframesync_equalize_avx2(float complex * _p,
+                                         float complex   _r,
+                                         float complex * _R,
+                                         float complex * _X,
+                                         unsigned int    _n)
+{
+    float * p = (float*)_p;
+    __m256 p0 = _mm256_loadu_ps(p);
+    __m256 p1 = _mm256_loadu_ps(p+8);
+    __m256 rr = _mm256_set1_ps(crealf(_r));
+    __m256 ri = _mm256_set1_ps(cimagf(_r));
+
+    unsigned int i;
+    for (i=0; i+8 <= _n; i+=8) {
+        float * R = (float*)(_R + i);
+        float * X = (float*)(_X + i);
+
+        // X *= R * p
+        _mm256_storeu_ps(X,   ofdmframesync_cmul2_avx2(_mm256_loadu_ps(X),   ofdmframesync_cmul2_avx2(_mm256_loadu_ps(R),   p0)));
+        _mm256_storeu_ps(X+8, ofdmframesync_cmul2_avx2(_mm256_loadu_ps(X+8), ofdmframesync_cmul2_avx2(_mm256_loadu_ps(R+8), p1)));
+
+        // p *= r
+        p0 = ofdmframesync_cmul_avx2(p0, rr, ri);
+        p1 = ofdmframesync_cmul_avx2(p1, rr, ri);
+    }
+
+    _mm256_storeu_ps(p,   p0);
+    _mm256_storeu_ps(p+8, p1);
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -40,6 +40,10 @@
 
 #define OFDMFRAMESYNC_ENABLE_SQUELCH    0
 
+// number of subcarriers between exact re-computation of the phase
+// correction ramp (multiple of 8)
+#define OFDMFRAMESYNC_EQ_BLOCK_LEN      (64)
+
 struct ofdmframesync_s {
     unsigned int M;         // number of subcarriers
     unsigned int M2;        // number of subcarriers (divided by 2)
@@ -53,6 +57,10 @@ struct ofdmframesync_s {
     unsigned int M_S0;      // number of enabled subcarriers in S0
     unsigned int M_S1;      // number of enabled subcarriers in S1
 
+    // pilot subcarriers
+    unsigned int * pilot_index; // pilot subcarrier indices (fftshift order)
+    float * pilot_fx;           // pilot subcarrier frequency index
+
     // scaling factors
     float g_data;           // data symbols gain
     float g_S0;             // S0 training symbols gain
@@ -76,7 +84,8 @@ struct ofdmframesync_s {
     float complex * G1;     // complex subcarrier gain estimate, S0[1]
     float complex * G;      // complex subcarrier gain estimate
     float complex * B;      // subcarrier phase rotation due to backoff
-    float complex * R;      // 
+    float complex * R;      // composite gain (zero on null subcarriers)
+    liquid_simd_level simd; // SIMD kernel, chosen at run time
 
     // receiver state
     enum {
@@ -92,6 +101,7 @@ struct ofdmframesync_s {
     msequence ms_pilot;     // pilot sequence generator
     float phi_prime;        // ...
     float p1_prime;         // filtered pilot phase slope
+    int defer;              // pass symbols to callback in time domain
 
 #if OFDMFRAMESYNC_ENABLE_SQUELCH
     // coarse signal detection
@@ -182,6 +192,22 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
         exit(1);
     }
 
+    // pilot subcarrier index list, starting at mid-point (effective
+    // fftshift) to match order of pilot sequence
+    q->pilot_index = (unsigned int*) malloc((q->M_pilot)*sizeof(unsigned int));
+    q->pilot_fx    = (float*)        malloc((q->M_pilot)*sizeof(float));
+    unsigned int i;
+    unsigned int n=0;
+    for (i=0; i<q->M; i++) {
+        unsigned int k = (i + q->M2) % q->M;
+        if (q->p[k] == OFDMFRAME_SCTYPE_PILOT) {
+            q->pilot_index[n] = k;
+            q->pilot_fx[n]    = (k > q->M2) ? (float)k - (float)(q->M) : (float)k;
+            n++;
+        }
+    }
+    assert(n == q->M_pilot);
+
     // create transform object
     q->X = (float complex*) malloc((q->M)*sizeof(float complex));
     q->x = (float complex*) malloc((q->M)*sizeof(float complex));
@@ -210,6 +236,7 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     q->G  = (float complex*) malloc((q->M)*sizeof(float complex));
     q->B  = (float complex*) malloc((q->M)*sizeof(float complex));
     q->R  = (float complex*) malloc((q->M)*sizeof(float complex));
+    q->simd = liquid_cpu_get_simd_level();
 
 #if 1
     memset(q->G0, 0x00, q->M*sizeof(float complex));
@@ -221,7 +248,6 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     // timing backoff
     q->backoff = q->cp_len < 2 ? q->cp_len : 2;
     float phi = (float)(q->backoff)*2.0f*M_PI/(float)(q->M);
-    unsigned int i;
     for (i=0; i<q->M; i++)
         q->B[i] = liquid_cexpjf(i*phi);
 
@@ -284,6 +310,8 @@ void ofdmframesync_destroy(ofdmframesync _q)
 
     // free subcarrier type array memory
     free(_q->p);
+    free(_q->pilot_index);
+    free(_q->pilot_fx);
 
     // free transform object
     windowcf_destroy(_q->input_buffer);
@@ -340,6 +368,7 @@ void ofdmframesync_reset(ofdmframesync _q)
     _q->s_hat_1 = 0.0f;
     _q->phi_prime = 0.0f;
     _q->p1_prime = 0.0f;
+    _q->defer = 0;
 
     // set thresholds (increase for small number of subcarriers)
     _q->plcp_detect_thresh = (_q->M > 44) ? 0.35f : 0.35f + 0.01f*(44 - _q->M);
@@ -686,8 +715,10 @@ void ofdmframesync_execute_S1(ofdmframesync _q)
 #if 1
         // compute composite gain
         unsigned int i;
-        for (i=0; i<_q->M; i++)
-            _q->R[i] = _q->B[i] / _q->G[i];
+        for (i=0; i<_q->M; i++) {
+            _q->R[i] = (_q->p[i] == OFDMFRAME_SCTYPE_NULL) ?
+                0.0f : _q->B[i] / _q->G[i];
+        }
 #endif
 
         return;
@@ -717,9 +748,21 @@ void ofdmframesync_execute_rxsymbols(ofdmframesync _q)
 
     if (_q->timer == 0) {
 
-        // run fft
         float complex * rc;
         windowcf_read(_q->input_buffer, &rc);
+        if (_q->defer) {
+            // hand time-domain symbol to callback; transform and
+            // equalization are left to ofdmframesync_rxsymbol_deferred()
+            _q->timer = _q->M + _q->cp_len;
+            if (_q->callback != NULL) {
+                int retval = _q->callback(&rc[_q->cp_len-_q->backoff], _q->p, _q->M, _q->userdata);
+                if (retval != 0)
+                    ofdmframesync_reset(_q);
+            }
+            return;
+        }
+
+        // run fft
         memmove(_q->x, &rc[_q->cp_len-_q->backoff], (_q->M)*sizeof(float complex));
         FFT_EXECUTE(_q->fft);
 
@@ -987,49 +1030,23 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 void ofdmframesync_rxsymbol(ofdmframesync _q)
 {
-    // apply gain
-    unsigned int i;
-    for (i=0; i<_q->M; i++)
-        _q->X[i] *= _q->R[i];
-
     // polynomial curve-fit
-    float x_phase[_q->M_pilot];
     float y_phase[_q->M_pilot];
     float p_phase[2];
 
-    unsigned int n=0;
-    unsigned int k;
+    // gather pilots, applying gain
+    unsigned int i;
     float complex pilot = 1.0f;
-    for (i=0; i<_q->M; i++) {
-
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M2) % _q->M;
-
-        if (_q->p[k]==OFDMFRAME_SCTYPE_PILOT) {
-            if (n == _q->M_pilot) {
-                fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-                return;
-            }
-            pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
+    for (i=0; i<_q->M_pilot; i++) {
+        unsigned int k = _q->pilot_index[i];
+        pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
 #if 0
-            printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
-                    k,
-                    crealf(_q->X[k]), cimagf(_q->X[k]),
-                    crealf(pilot),    cimagf(pilot));
+        printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
+                k,
+                crealf(_q->X[k]*_q->R[k]), cimagf(_q->X[k]*_q->R[k]),
+                crealf(pilot),             cimagf(pilot));
 #endif
-            // store resulting...
-            x_phase[n] = (k > _q->M2) ? (float)k - (float)(_q->M) : (float)k;
-            y_phase[n] = cargf(_q->X[k]*conjf(pilot));
-
-            // update counter
-            n++;
-
-        }
-    }
-
-    if (n != _q->M_pilot) {
-        fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-        return;
+        y_phase[i] = cargf(_q->X[k]*_q->R[k]*conjf(pilot));
     }
 
     // try to unwrap phase
@@ -1041,7 +1058,7 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 
     // fit phase to 1st-order polynomial (2 coefficients)
-    polyf_fit(x_phase, y_phase, _q->M_pilot, p_phase, 2);
+    polyf_fit(_q->pilot_fx, y_phase, _q->M_pilot, p_phase, 2);
 
     // filter slope estimate (timing offset)
     float alpha = 0.3f;
@@ -1051,7 +1068,7 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
 #if DEBUG_OFDMFRAMESYNC
     if (_q->debug_enabled) {
         // save pilots
-        memmove(_q->px, x_phase, _q->M_pilot*sizeof(float));
+        memmove(_q->px, _q->pilot_fx, _q->M_pilot*sizeof(float));
         memmove(_q->py, y_phase, _q->M_pilot*sizeof(float));
 
         // NOTE : swapping values for octave
@@ -1063,18 +1080,8 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 #endif
 
-    // compensate for phase offset
-    // TODO : find more computationally efficient way to do this
-    for (i=0; i<_q->M; i++) {
-        // only apply to data/pilot subcarriers
-        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL) {
-            _q->X[i] = 0.0f;
-        } else {
-            float fx    = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-            float theta = polyf_val(p_phase, 2, fx);
-            _q->X[i] *= liquid_cexpjf(-theta);
-        }
-    }
+    // apply gain and compensate for phase offset
+    ofdmframesync_equalize(_q, p_phase[0], p_phase[1]);
 
     // adjust NCO frequency based on differential phase
     if (_q->num_symbols > 0) {
@@ -1095,11 +1102,107 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
 
 #if 0
     for (i=0; i<_q->M_pilot; i++)
-        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, x_phase[i], i+1, y_phase[i]);
+        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, _q->pilot_fx[i], i+1, y_phase[i]);
     printf("poly : p0=%12.8f, p1=%12.8f\n", p_phase[0], p_phase[1]);
 #endif
 }
 
+// defer recovery of received symbols: when enabled, the callback is
+// given each symbol in the time domain (after cyclic prefix removal,
+// [size: M x 1]) and the symbol is neither transformed nor equalized,
+// leaving carrier tracking frozen; cleared on reset
+void ofdmframesync_set_defer(ofdmframesync _q,
+                             int           _defer)
+{
+    _q->defer = _defer;
+}
+
+// copy equalizer state (subcarrier gain, pilot phase tracking and
+// pilot sequence) from _src to _dst so that _dst can recover the
+// symbols which follow in _src; both objects must have the same
+// number of subcarriers and subcarrier allocation
+void ofdmframesync_copy_eqstate(ofdmframesync _dst,
+                                ofdmframesync _src)
+{
+    assert(_dst->M == _src->M);
+    memmove(_dst->R, _src->R, _src->M*sizeof(float complex));
+    _dst->ms_pilot->v = _src->ms_pilot->v;
+    _dst->phi_prime   = _src->phi_prime;
+    _dst->p1_prime    = _src->p1_prime;
+    _dst->num_symbols = _src->num_symbols;
+}
+
+// recover deferred symbol: transform, apply gain and pilot phase
+// correction
+//  _q      :   ofdmframesync object (equalizer state)
+//  _x      :   time-domain symbol from callback [size: M x 1]
+//  _X      :   recovered subcarriers [size: M x 1]
+void ofdmframesync_rxsymbol_deferred(ofdmframesync   _q,
+                                     float complex * _x,
+                                     float complex * _X)
+{
+    memmove(_q->x, _x, (_q->M)*sizeof(float complex));
+    FFT_EXECUTE(_q->fft);
+    ofdmframesync_rxsymbol(_q);
+    memmove(_X, _q->X, (_q->M)*sizeof(float complex));
+}
+
+// apply equalizer gain and pilot phase correction to all subcarriers,
+//   X[i] <- X[i] R[i] exp{-j(_p0 + _p1 i)}
+// generating the phase ramp recursively with eight lane phasors which
+// are re-computed exactly every OFDMFRAMESYNC_EQ_BLOCK_LEN subcarriers;
+// R is zero on null subcarriers
+//  _q      :   ofdmframesync object
+//  _p0     :   phase offset
+//  _p1     :   phase slope
+void ofdmframesync_equalize(ofdmframesync _q,
+                            float         _p0,
+                            float         _p1)
+{
+    float complex p[8];     // lane phasors
+    float complex r = liquid_cexpjf(-8.0f*_p1);
+
+    // positive frequencies [0,M/2] followed by negative [-M/2+1,-1]
+    unsigned int s;
+    for (s=0; s<2; s++) {
+        unsigned int i0 = (s == 0) ? 0 : _q->M2 + 1;
+        unsigned int i1 = (s == 0) ? _q->M2 + 1 : _q->M;
+        int          f0 = (s == 0) ? 0 : (int)(_q->M2 + 1) - (int)(_q->M);
+
+        unsigned int i;
+        for (i=i0; i<i1; i+=OFDMFRAMESYNC_EQ_BLOCK_LEN) {
+            unsigned int n = i1-i < OFDMFRAMESYNC_EQ_BLOCK_LEN ? i1-i : OFDMFRAMESYNC_EQ_BLOCK_LEN;
+            float complex * R = _q->R + i;
+            float complex * X = _q->X + i;
+
+            // re-compute phasors
+            unsigned int l;
+            float fx = (float)(f0 + (int)(i - i0));
+            for (l=0; l<8; l++)
+                p[l] = liquid_cexpjf(-(_p0 + _p1*(fx + (float)l)));
+
+            // run kernel over multiple of 8 subcarriers
+            unsigned int k = 0;
+#if LIQUID_CPU_X86
+            if (_q->simd >= LIQUID_SIMD_AVX2)
+                k = ofdmframesync_equalize_avx2(p, r, R, X, n);
+            else if (_q->simd == LIQUID_SIMD_SSE)
+                k = ofdmframesync_equalize_sse(p, r, R, X, n);
+#endif
+            for ( ; k+8 <= n; k+=8) {
+                for (l=0; l<8; l++) {
+                    X[k+l] *= R[k+l] * p[l];
+                    p[l] *= r;
+                }
+            }
+
+            // remaining subcarriers use current phasors
+            for (l=0; k<n; k++, l++)
+                X[k] *= R[k] * p[l];
+        }
+    }
+}
+
 // enable debugging
 void ofdmframesync_debug_enable(ofdmframesync _q)
 {
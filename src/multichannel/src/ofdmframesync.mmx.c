@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// ofdmframesync.mmx.c : subcarrier equalization (SSE2)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <emmintrin.h>
+
+// complex multiply of two interleaved pairs, given the real and
+// imaginary parts of _b duplicated in _br and _bi
+__attribute__((target("sse2"), always_inline))
+static inline __m128 ofdmframesync_cmul_sse(__m128 _a,
+                                            __m128 _br,
+                                            __m128 _bi)
+{
+    const __m128 sign = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+    __m128 as = _mm_shuffle_ps(_a, _a, _MM_SHUFFLE(2,3,0,1));
+    return _mm_add_ps(_mm_mul_ps(_a, _br),
+                      _mm_xor_ps(_mm_mul_ps(as, _bi), sign));
+}
+
+// complex multiply of two interleaved pairs
+__attribute__((target("sse2"), always_inline))
+static inline __m128 ofdmframesync_cmul2_sse(__m128 _a,
+                                             __m128 _b)
+{
+    return ofdmframesync_cmul_sse(_a,
+                                  _mm_shuffle_ps(_b,_b,_MM_SHUFFLE(2,2,0,0)),
+                                  _mm_shuffle_ps(_b,_b,_MM_SHUFFLE(3,3,1,1)));
+}
+
+// X[i] <- X[i] R[i] p[i%8] with eight lane phasors (four registers),
+// advancing the phasors by _r every eight subcarriers
+__attribute__((target("sse2")))
+unsigned int ofdmframesync_equalize_sse(float complex * _p,
+                                        float complex   _r,
+                                        float complex * _R,
+                                        float complex * _X,
+                                        unsigned int    _n)
+{
+    float * p = (float*)_p;
+    __m128 p0 = _mm_loadu_ps(p);
+    __m128 p1 = _mm_loadu_ps(p+4);
+    __m128 p2 = _mm_loadu_ps(p+8);
+    __m128 p3 = _mm_loadu_ps(p+12);
+    __m128 rr = _mm_set1_ps(crealf(_r));
+    __m128 ri = _mm_set1_ps(cimagf(_r));
+
+    unsigned int i;
+    for (i=0; i+8 <= _n; i+=8) {
+        float * R = (float*)(_R + i);
+        float * X = (float*)(_X + i);
+
+        // X *= R * p
+        _mm_storeu_ps(X,    ofdmframesync_cmul2_sse(_mm_loadu_ps(X),    ofdmframesync_cmul2_sse(_mm_loadu_ps(R),    p0)));
+        _mm_storeu_ps(X+4,  ofdmframesync_cmul2_sse(_mm_loadu_ps(X+4),  ofdmframesync_cmul2_sse(_mm_loadu_ps(R+4),  p1)));
+        _mm_storeu_ps(X+8,  ofdmframesync_cmul2_sse(_mm_loadu_ps(X+8),  ofdmframesync_cmul2_sse(_mm_loadu_ps(R+8),  p2)));
+        _mm_storeu_ps(X+12, ofdmframesync_cmul2_sse(_mm_loadu_ps(X+12), ofdmframesync_cmul2_sse(_mm_loadu_ps(R+12), p3)));
+
+        // p *= r
+        p0 = ofdmframesync_cmul_sse(p0, rr, ri);
+        p1 = ofdmframesync_cmul_sse(p1, rr, ri);
+        p2 = ofdmframesync_cmul_sse(p2, rr, ri);
+        p3 = ofdmframesync_cmul_sse(p3, rr, ri);
+    }
+
+    _mm_storeu_ps(p,    p0);
+    _mm_storeu_ps(p+4,  p1);
+    _mm_storeu_ps(p+8,  p2);
+    _mm_storeu_ps(p+12, p3);
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// firpfbch_block_autotest.c : test block execution of polyphase
+// filterbank channelizers against single-block execution for
+// several numbers of threads
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// generate random complex samples
+static void firpfbch_block_autotest_gen(float complex * _x,
+                                        unsigned int    _n)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _x[i] = (rand() % 1024 - 512) / 512.0f + _Complex_I*(rand() % 1024 - 512) / 512.0f;
+}
+
+// firpfbch_crcf: run _num_blocks blocks one at a time and in groups
+// of irregular size with _num_threads threads; outputs must be
+// bit-identical
+void firpfbch_crcf_block_test(int          _type,
+                              unsigned int _M,
+                              unsigned int _num_threads)
+{
+    unsigned int m          = 4;
+    unsigned int num_blocks = 80;   // spans several internal passes
+    unsigned int n          = _M*num_blocks;
+
+    float complex * x  = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(n*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(n*sizeof(float complex));
+    firpfbch_block_autotest_gen(x, n);
+
+    firpfbch_crcf q0 = firpfbch_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch_crcf q1 = firpfbch_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch_crcf_set_num_threads(q1, _num_threads);
+
+    unsigned int i;
+    for (i=0; i<num_blocks; i++) {
+        if (_type == LIQUID_ANALYZER)
+            firpfbch_crcf_analyzer_execute(q0, &x[i*_M], &y0[i*_M]);
+        else
+            firpfbch_crcf_synthesizer_execute(q0, &x[i*_M], &y0[i*_M]);
+    }
+
+    unsigned int k = 0;
+    unsigned int b = 1;
+    while (k < num_blocks) {
+        unsigned int nb = k + b > num_blocks ? num_blocks - k : b;
+        if (_type == LIQUID_ANALYZER)
+            firpfbch_crcf_analyzer_execute_block(q1, &x[k*_M], nb, &y1[k*_M]);
+        else
+            firpfbch_crcf_synthesizer_execute_block(q1, &x[k*_M], nb, &y1[k*_M]);
+        k += nb;
+        b = 2*b + 1;
+    }
+
+    CONTEND_SAME_DATA(y0, y1, n*sizeof(float complex));
+
+    firpfbch_crcf_destroy(q0);
+    firpfbch_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+// firpfbch2_crcf: as above
+void firpfbch2_crcf_block_test(int          _type,
+                               unsigned int _M,
+                               unsigned int _num_threads)
+{
+    unsigned int m          = 3;
+    unsigned int num_blocks = 80;
+    unsigned int nx = _type == LIQUID_ANALYZER ? _M/2 : _M;
+    unsigned int ny = _type == LIQUID_ANALYZER ? _M   : _M/2;
+
+    float complex * x  = (float complex*) malloc(nx*num_blocks*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(ny*num_blocks*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(ny*num_blocks*sizeof(float complex));
+    firpfbch_block_autotest_gen(x, nx*num_blocks);
+
+    firpfbch2_crcf q0 = firpfbch2_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch2_crcf q1 = firpfbch2_crcf_create_kaiser(_type, _M, m, 60.0f);
+    firpfbch2_crcf_set_num_threads(q1, _num_threads);
+
+    unsigned int i;
+    for (i=0; i<num_blocks; i++)
+        firpfbch2_crcf_execute(q0, &x[i*nx], &y0[i*ny]);
+
+    unsigned int k = 0;
+    unsigned int b = 1;
+    while (k < num_blocks) {
+        unsigned int nb = k + b > num_blocks ? num_blocks - k : b;
+        firpfbch2_crcf_execute_block(q1, &x[k*nx], nb, &y1[k*ny]);
+        k += nb;
+        b = 2*b + 1;
+    }
+
+    CONTEND_SAME_DATA(y0, y1, ny*num_blocks*sizeof(float complex));
+
+    firpfbch2_crcf_destroy(q0);
+    firpfbch2_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_firpfbch_crcf_analyzer_block_t1()     { firpfbch_crcf_block_test (LIQUID_ANALYZER,    64, 1); }
+void autotest_firpfbch_crcf_analyzer_block_t4()     { firpfbch_crcf_block_test (LIQUID_ANALYZER,    64, 4); }
+void autotest_firpfbch_crcf_synthesizer_block_t1()  { firpfbch_crcf_block_test (LIQUID_SYNTHESIZER, 64, 1); }
+void autotest_firpfbch_crcf_synthesizer_block_t4()  { firpfbch_crcf_block_test (LIQUID_SYNTHESIZER, 64, 4); }
+void autotest_firpfbch2_crcf_analyzer_block_t1()    { firpfbch2_crcf_block_test(LIQUID_ANALYZER,    30, 1); }
+void autotest_firpfbch2_crcf_analyzer_block_t4()    { firpfbch2_crcf_block_test(LIQUID_ANALYZER,    30, 4); }
+void autotest_firpfbch2_crcf_synthesizer_block_t1() { firpfbch2_crcf_block_test(LIQUID_SYNTHESIZER, 30, 1); }
+void autotest_firpfbch2_crcf_synthesizer_block_t4() { firpfbch2_crcf_block_test(LIQUID_SYNTHESIZER, 30, 4); }
+
+// firpfbch_cccf with complex prototype: analyzer with 3 threads
+void autotest_firpfbch_cccf_analyzer_block_t3()
+{
+    unsigned int M = 16, p = 6, num_blocks = 50;
+    float complex h[M*p];
+    float complex x[M*num_blocks], y0[M*num_blocks], y1[M*num_blocks];
+    firpfbch_block_autotest_gen(h, M*p);
+    firpfbch_block_autotest_gen(x, M*num_blocks);
+
+    firpfbch_cccf q0 = firpfbch_cccf_create(LIQUID_ANALYZER, M, p, h);
+    firpfbch_cccf q1 = firpfbch_cccf_create(LIQUID_ANALYZER, M, p, h);
+    firpfbch_cccf_set_num_threads(q1, 3);
+
+    unsigned int i;
+    for (i=0; i<num_blocks; i++)
+        firpfbch_cccf_analyzer_execute(q0, &x[i*M], &y0[i*M]);
+    firpfbch_cccf_analyzer_execute_block(q1, x, num_blocks, y1);
+
+    CONTEND_SAME_DATA(y0, y1, sizeof(y0));
+
+    firpfbch_cccf_destroy(q0);
+    firpfbch_cccf_destroy(q1);
+}
+
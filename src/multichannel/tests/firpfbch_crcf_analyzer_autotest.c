@@ -17,9 +17,10 @@
  * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdlib.h>
 #include <assert.h>
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 //
 // AUTOTEST: validate analysis correctness
@@ -147,3 +148,87 @@ void autotest_firpfbch_crcf_analysis()
 }
 
 
+
+// compare analyzer with arbitrary push/run alignment against direct
+// evaluation of each polyphase branch followed by a DFT
+//  _M          :   number of channels
+//  _p          :   filter length (symbols)
+//  _complex    :   use complex coefficients (cccf)?
+//  _cpu_mask   :   run-time processor feature mask
+void firpfbch_analysis_alignment_test(unsigned int _M,
+                                      unsigned int _p,
+                                      int          _complex,
+                                      unsigned int _cpu_mask)
+{
+    float tol = 1e-4f;
+    unsigned int num_samples = 40*_M;
+    unsigned int i, j, t;
+
+    // random filter and input
+    unsigned int h_len = _p*_M;
+    float complex h[h_len];
+    float hr[h_len];
+    for (i=0; i<h_len; i++) {
+        h[i]  = randnf() + (_complex ? randnf()*_Complex_I : 0.0f);
+        hr[i] = crealf(h[i]);
+    }
+    float complex x[num_samples];
+    for (i=0; i<num_samples; i++)
+        x[i] = randnf() + randnf()*_Complex_I;
+
+    liquid_cpu_set_mask(_cpu_mask);
+    firpfbch_crcf qr = _complex ? NULL : firpfbch_crcf_create(LIQUID_ANALYZER, _M, _p, hr);
+    firpfbch_cccf qc = _complex ? firpfbch_cccf_create(LIQUID_ANALYZER, _M, _p, h) : NULL;
+    liquid_cpu_set_mask(~0U);
+
+    float complex Y[_M];
+    float complex v[_M];
+    unsigned int n = 0;
+    while (n < num_samples) {
+        // push a pseudo-random number of samples
+        unsigned int num_push = 1 + rand() % (2*_M);
+        for (i=0; i<num_push && n < num_samples; i++, n++) {
+            if (_complex) firpfbch_cccf_analyzer_push(qc, x[n]);
+            else          firpfbch_crcf_analyzer_push(qr, x[n]);
+        }
+
+        // run with pseudo-random alignment
+        unsigned int k = rand() % _M;
+        if (_complex) firpfbch_cccf_analyzer_run(qc, k, Y);
+        else          firpfbch_crcf_analyzer_run(qr, k, Y);
+
+        // direct evaluation: sample j is pushed to branch (M-1-j) mod M
+        for (i=0; i<_M; i++) {
+            unsigned int b = (i + k) % _M;
+            float complex y = 0.0f;
+            int jb = (int)n - 1;
+            while (jb >= 0 && (_M-1 - (unsigned int)jb % _M) % _M != b)
+                jb--;
+            for (t=0; t<_p && jb >= 0; t++, jb -= (int)_M)
+                y += h[i + t*_M] * x[jb];
+            v[_M-i-1] = y;
+        }
+        for (i=0; i<_M; i++) {
+            float complex Yd = 0.0f;
+            for (j=0; j<_M; j++)
+                Yd += v[j] * cexpf(-_Complex_I*2*M_PI*(float)(i*j)/(float)_M);
+            CONTEND_DELTA( crealf(Y[i]), crealf(Yd), tol*_M*_p );
+            CONTEND_DELTA( cimagf(Y[i]), cimagf(Yd), tol*_M*_p );
+        }
+    }
+
+    if (_complex) firpfbch_cccf_destroy(qc);
+    else          firpfbch_crcf_destroy(qr);
+}
+
+// AUTOTESTS: analyzer alignment, portable and SIMD kernels
+void autotest_firpfbch_crcf_analysis_alignment_M4()    { firpfbch_analysis_alignment_test( 4, 5, 0, ~0U); }
+void autotest_firpfbch_crcf_analysis_alignment_M13()   { firpfbch_analysis_alignment_test(13, 4, 0, ~0U); }
+void autotest_firpfbch_crcf_analysis_alignment_M64()   { firpfbch_analysis_alignment_test(64, 6, 0, ~0U); }
+void autotest_firpfbch_crcf_analysis_alignment_sse()   { firpfbch_analysis_alignment_test(30, 4, 0, ~(LIQUID_CPU_AVX512F|LIQUID_CPU_AVX2)); }
+void autotest_firpfbch_crcf_analysis_alignment_port()  { firpfbch_analysis_alignment_test(30, 4, 0, 0); }
+void autotest_firpfbch_cccf_analysis_alignment_M13()   { firpfbch_analysis_alignment_test(13, 4, 1, ~0U); }
+void autotest_firpfbch_cccf_analysis_alignment_M64()   { firpfbch_analysis_alignment_test(64, 6, 1, ~0U); }
+void autotest_firpfbch_cccf_analysis_alignment_sse()   { firpfbch_analysis_alignment_test(30, 4, 1, ~(LIQUID_CPU_AVX512F|LIQUID_CPU_AVX2)); }
+void autotest_firpfbch_cccf_analysis_alignment_port()  { firpfbch_analysis_alignment_test(30, 4, 1, 0); }
+
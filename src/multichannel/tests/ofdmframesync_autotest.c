@@ -26,7 +26,7 @@
 #include <assert.h>
 
 #include "autotest/autotest.h"
-#include "liquid.h"
+#include "liquid.internal.h"
 
 
 // internal callback
@@ -140,4 +140,75 @@ void autotest_ofdmframesync_acquire_n64()   { ofdmframesync_acquire_test(64,  8,
 void autotest_ofdmframesync_acquire_n128()  { ofdmframesync_acquire_test(128, 16, 0); }
 void autotest_ofdmframesync_acquire_n256()  { ofdmframesync_acquire_test(256, 32, 0); }
 void autotest_ofdmframesync_acquire_n512()  { ofdmframesync_acquire_test(512, 64, 0); }
+void autotest_ofdmframesync_acquire_n1024() { ofdmframesync_acquire_test(1024,128,0); }
+
+// receive the same frame with each run-time selected equalization
+// kernel and compare the recovered subcarriers to those of the
+// portable implementation
+void autotest_ofdmframesync_equalize_simd()
+{
+    unsigned int M      = 1024;     // number of subcarriers
+    unsigned int cp_len = 128;      // cyclic prefix length
+    float dphi          = 0.7f / (float)M;  // carrier frequency offset
+    float tol           = 1e-4f;    // error tolerance
+
+    unsigned int masks[3] = {
+        0,                                      // no extensions
+        ~(LIQUID_CPU_AVX512F | LIQUID_CPU_AVX2),// SSE
+        ~(LIQUID_CPU_AVX512F),                  // AVX2/FMA
+    };
+
+    // subcarrier allocation with an odd number of enabled subcarriers
+    // on either side of the mid-point
+    unsigned char p[M];
+    ofdmframe_init_default_sctype(M, p);
+    p[3]   = OFDMFRAME_SCTYPE_NULL;
+    p[M-5] = OFDMFRAME_SCTYPE_NULL;
+
+    // assemble frame: S0a, S0b, S1 and two data symbols
+    unsigned int num_samples = 5*(M + cp_len);
+    float complex y[num_samples];
+    float complex X[M];
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, 0, p);
+    unsigned int i, k, n=0;
+    ofdmframegen_write_S0a(fg, &y[n]); n += M + cp_len;
+    ofdmframegen_write_S0b(fg, &y[n]); n += M + cp_len;
+    ofdmframegen_write_S1( fg, &y[n]); n += M + cp_len;
+    for (k=0; k<2; k++) {
+        for (i=0; i<M; i++)
+            X[i] = cexpf(_Complex_I*2*M_PI*randf());
+        ofdmframegen_writesymbol(fg, X, &y[n]);
+        n += M + cp_len;
+    }
+    assert(n == num_samples);
+    ofdmframegen_destroy(fg);
+
+    // add carrier offset
+    for (i=0; i<num_samples; i++)
+        y[i] *= cexpf(_Complex_I*dphi*i);
+
+    // run receivers
+    float complex X_test[3][M];
+    for (k=0; k<3; k++) {
+        liquid_cpu_set_mask(masks[k]);
+        ofdmframesync fs = ofdmframesync_create(M,cp_len,0,p,ofdmframesync_autotest_callback,(void*)X_test[k]);
+        ofdmframesync_execute(fs,y,num_samples);
+        ofdmframesync_destroy(fs);
+    }
+
+    // restore processor features
+    liquid_cpu_set_mask(~0U);
+
+    // check output
+    for (i=0; i<M; i++) {
+        if (p[i] == OFDMFRAME_SCTYPE_NULL) {
+            for (k=0; k<3; k++)
+                CONTEND_EQUALITY(cabsf(X_test[k][i]), 0.0f);
+        } else {
+            CONTEND_DELTA(cabsf(X_test[0][i]), 1.0f, 1e-2f);
+            for (k=1; k<3; k++)
+                CONTEND_DELTA(cabsf(X_test[k][i] - X_test[0][i]), 0.0f, tol);
+        }
+    }
+}
 
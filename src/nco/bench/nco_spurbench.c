@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// nco_spurbench.c : oscillator spur level measurement for benchmarks
+//
+
+#include <stdio.h>
+#include <math.h>
+
+#include "liquid.h"
+#include "src/nco/bench/nco_spurbench.h"
+
+// measure worst spur level [dBc] of oscillator output: the ideal
+// tone (computed in double precision) is subtracted and the spectrum
+// of the remaining phase/amplitude error is compared to the carrier
+//  _type   :   oscillator type (LIQUID_NCO, LIQUID_VCO)
+//  _block  :   use mix_block_up() (otherwise cexpf()/step())
+float nco_crcf_bench_spur_level(int _type,
+                                int _block)
+{
+    unsigned int nfft = 4096;
+    unsigned int i;
+    float complex x[nfft];
+    float complex y[nfft];
+    float phi = 0.7f;       // initial phase
+    float f   = 0.5077f;    // frequency
+
+    nco_crcf q = nco_crcf_create(_type);
+    nco_crcf_set_phase(q, phi);
+    nco_crcf_set_frequency(q, f);
+    if (_block) {
+        for (i=0; i<nfft; i++)
+            x[i] = 1.0f;
+        nco_crcf_mix_block_up(q, x, y, nfft);
+    } else {
+        for (i=0; i<nfft; i++) {
+            nco_crcf_cexpf(q, &y[i]);
+            nco_crcf_step(q);
+        }
+    }
+    nco_crcf_destroy(q);
+
+    // remove ideal tone and find largest error component
+    for (i=0; i<nfft; i++) {
+        double theta = (double)phi + (double)f*i;
+        y[i] -= cos(theta) + _Complex_I*sin(theta);
+    }
+    fft_run(nfft, y, x, LIQUID_FFT_FORWARD, 0);
+    float spur = 0.0f;
+    for (i=0; i<nfft; i++)
+        spur = cabsf(x[i]) > spur ? cabsf(x[i]) : spur;
+    return 20*log10f(spur / (float)nfft + 1e-12f);
+}
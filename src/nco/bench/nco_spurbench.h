@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// nco_spurbench.h : oscillator spur level measurement for benchmarks
+//
+
+#ifndef __NCO_SPURBENCH_H__
+#define __NCO_SPURBENCH_H__
+
+// measure worst spur level [dBc] of oscillator output
+//  _type   :   oscillator type (LIQUID_NCO, LIQUID_VCO)
+//  _block  :   use mix_block_up() (otherwise cexpf()/step())
+float nco_crcf_bench_spur_level(int _type,
+                                int _block);
+
+#endif // __NCO_SPURBENCH_H__
@@ -20,9 +20,11 @@
  */
 
 #include <sys/resource.h>
+#include <stdio.h>
 #include <string.h>
 
 #include "liquid.h"
+#include "src/nco/bench/nco_spurbench.h"
 
 void benchmark_vco_sincos(struct rusage *_start,
                           struct rusage *_finish,
@@ -95,3 +97,36 @@ void benchmark_vco_mix_block_up(struct rusage *_start,
     nco_crcf_destroy(p);
 }
 
+void benchmark_vco_mix_block_up_1024(struct rusage *_start,
+                                     struct rusage *_finish,
+                                     unsigned long int *_num_iterations)
+{
+    // report spur level once
+    static int spur_reported = 0;
+    if (!spur_reported) {
+        printf("    vco spur level : %6.1f dBc (cexpf), %6.1f dBc (mix_block)\n",
+                nco_crcf_bench_spur_level(LIQUID_VCO, 0),
+                nco_crcf_bench_spur_level(LIQUID_VCO, 1));
+        spur_reported = 1;
+    }
+
+    float complex x[1024], y[1024];
+    memset(x, 0, 1024*sizeof(float complex));
+
+    nco_crcf p = nco_crcf_create(LIQUID_VCO);
+    nco_crcf_set_phase(p, 0.0f);
+    nco_crcf_set_frequency(p, 0.1f);
+
+    unsigned int i;
+
+    *_num_iterations /= 64;
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        nco_crcf_mix_block_up(p, x, y, 1024);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    *_num_iterations *= 1024;
+    nco_crcf_destroy(p);
+}
+
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// nco.avx.c : block mixing with lane phasors (AVX2/FMA)
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+
+#include <immintrin.h>
+
+// complex multiply of four interleaved pairs, given the real and
+// imaginary parts of _b duplicated in _br and _bi
+__attribute__((target("avx2,fma"), always_inline))
+static inline __m256 nco_cmul_avx2(__m256 _a,
+                                   __m256 _br,
+                                   __m256 _bi)
+{
+    __m256 as = _mm256_permute_ps(_a, _MM_SHUFFLE(2,3,0,1));
+    return _mm256_fmaddsub_ps(_a, _br, _mm256_mul_ps(as, _bi));
+}
+
+// mix samples with eight lane phasors (two registers), advancing the
+// phasors by _r every eight samples; see nco_mix_block_sse()
+__attribute__((target("avx2,fma")))
+unsigned int nco_mix_block_avx2(float complex * _p,
+                                float complex   _r,
+                                float complex * _x,
+                                float complex * _y,
+                                unsigned int    _n)
+{
+    float * p = (float*)_p;
+    __m256 p0 = _mm256_loadu_ps(p);
+    __m256 p1 = _mm256_loadu_ps(p+8);
+    __m256 rr = _mm256_set1_ps(crealf(_r));
+    __m256 ri = _mm256_set1_ps(cimagf(_r));
+
+    unsigned int i;
+    for (i=0; i+8 <= _n; i+=8) {
+        float * x = (float*)(_x + i);
+        float * y = (float*)(_y + i);
+
+        // y = x * p
+        _mm256_storeu_ps(y,   nco_cmul_avx2(_mm256_loadu_ps(x),   _mm256_moveldup_ps(p0), _mm256_movehdup_ps(p0)));
+        _mm256_storeu_ps(y+8, nco_cmul_avx2(_mm256_loadu_ps(x+8), _mm256_moveldup_ps(p1), _mm256_movehdup_ps(p1)));
+
+        // p *= r
+        p0 = nco_cmul_avx2(p0, rr, ri);
+        p1 = nco_cmul_avx2(p1, rr, ri);
+    }
+
+    _mm256_storeu_ps(p,   p0);
+    _mm256_storeu_ps(p+8, p1);
+    return i;
+}
+
+#endif // LIQUID_CPU_X86
+
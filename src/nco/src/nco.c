@@ -32,17 +32,30 @@
 #define NCO_PLL_BANDWIDTH_DEFAULT   (0.1)
 #define NCO_PLL_GAIN_DEFAULT        (1000)
 
+// sine table length (LIQUID_NCO), linearly interpolated
+#define NCO_SINTAB_LEN              (1024)
+#define NCO_SINTAB_BITS             (10)
+
+// number of samples between exact re-computation of phasors in
+// block mixing methods
+#define NCO_MIX_BLOCK_LEN           (128)
+
 #define LIQUID_DEBUG_NCO            (0)
 
 struct NCO(_s) {
     liquid_ncotype type;
-    T theta;            // NCO phase
-    T d_theta;          // NCO frequency
-    T sintab[256];      // sine table
-    unsigned int index; // table index
+
+    // fixed-point phase and frequency: 2^64 corresponds to 2*pi and
+    // wrap-around is implicit in unsigned arithmetic
+    uint64_t theta;     // NCO phase
+    uint64_t d_theta;   // NCO frequency
+    T frequency;        // NCO frequency as set/adjusted (not wrapped)
+
+    T sintab[NCO_SINTAB_LEN+1]; // sine table (with guard sample)
     T sine;
     T cosine;
     void (*compute_sincos)(NCO() _q);
+    liquid_simd_level simd;     // SIMD kernel for block mixing
 
     // phase-locked loop
     T bandwidth;
@@ -60,8 +73,9 @@ NCO() NCO(_create)(liquid_ncotype _type)
 
     // initialize sine table
     unsigned int i;
-    for (i=0; i<256; i++)
-        q->sintab[i] = SIN(2.0f*M_PI*(float)(i)/256.0f);
+    for (i=0; i<=NCO_SINTAB_LEN; i++)
+        q->sintab[i] = SIN(2.0*M_PI*(double)(i)/(double)NCO_SINTAB_LEN);
+    q->simd = liquid_cpu_get_simd_level();
 
     // set default pll bandwidth
     q->a[0] = 1.0f;     q->b[0] = 0.0f;
@@ -91,14 +105,20 @@ void NCO(_destroy)(NCO() _q)
     free(_q);
 }
 
+// print nco object internals
+void NCO(_print)(NCO() _q)
+{
+    printf("nco [%s] :\n", _q->type == LIQUID_NCO ? "nco" : "vco");
+    printf("    phase       :   %12.8f\n", NCO(_get_phase)(_q));
+    printf("    frequency   :   %12.8f\n", NCO(_get_frequency)(_q));
+}
+
 // reset internal state of nco object
 void NCO(_reset)(NCO() _q)
 {
     _q->theta = 0;
     _q->d_theta = 0;
-
-    // reset sine table index
-    _q->index = 0;
+    _q->frequency = 0;
 
     // set internal sine, cosine values
     _q->sine = 0;
@@ -112,49 +132,47 @@ void NCO(_reset)(NCO() _q)
 void NCO(_set_frequency)(NCO() _q,
                          T _f)
 {
-    _q->d_theta = _f;
+    _q->d_theta = NCO(_fixed_from_phase)(_f);
+    _q->frequency = _f;
 }
 
 // adjust frequency of nco object
 void NCO(_adjust_frequency)(NCO() _q,
                             T _df)
 {
-    _q->d_theta += _df;
+    _q->d_theta += NCO(_fixed_from_phase)(_df);
+    _q->frequency += _df;
 }
 
-// set phase of nco object, constraining phase
+// set phase of nco object
 void NCO(_set_phase)(NCO() _q, T _phi)
 {
-    _q->theta = _phi;
-    NCO(_constrain_phase)(_q);
+    _q->theta = NCO(_fixed_from_phase)(_phi);
 }
 
-// adjust phase of nco object, constraining phase
+// adjust phase of nco object
 void NCO(_adjust_phase)(NCO() _q, T _dphi)
 {
-    _q->theta += _dphi;
-    NCO(_constrain_phase)(_q);
+    _q->theta += NCO(_fixed_from_phase)(_dphi);
 }
 
 // increment internal phase of nco object
 void NCO(_step)(NCO() _q)
 {
     _q->theta += _q->d_theta;
-    NCO(_constrain_phase)(_q);
 }
 
-// get phase
+// get phase, constrained to be in [-pi,pi)
 T NCO(_get_phase)(NCO() _q)
 {
-    return _q->theta;
+    return NCO(_phase_from_fixed)(_q->theta);
 }
 
-// ge frequency
+// get frequency (not constrained; the fixed-point phase step used
+// internally is equivalent modulo 2*pi)
 T NCO(_get_frequency)(NCO() _q)
 {
-    // return both internal NCO phase step as well
-    // as PLL phase step
-    return _q->d_theta;
+    return _q->frequency;
 }
 
 
@@ -297,7 +315,6 @@ void NCO(_mix_down)(NCO() _q,
 
 // Rotate input vector array up by NCO angle:
 //      y(t) = x(t) exp{+j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -307,23 +324,12 @@ void NCO(_mix_block_up)(NCO() _q,
                         TC *_y,
                         unsigned int _n)
 {
-    unsigned int i;
-
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(theta) + _Complex_I*sin(theta)]
-        _y[i] = _x[i] * liquid_cexpjf(theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
+    NCO(_mix_block)(_q, _q->theta, _q->d_theta, _x, _y, _n);
+    _q->theta += (uint64_t)_n * _q->d_theta;
 }
 
 // Rotate input vector array down by NCO angle:
 //      y(t) = x(t) exp{-j (f*t + theta)}
-// TODO : implement NCO/VCO-specific versions
 //  _q      :   nco object
 //  _x      :   input array [size: _n x 1]
 //  _y      :   output sample [size: _n x 1]
@@ -333,62 +339,105 @@ void NCO(_mix_block_down)(NCO() _q,
                           TC *_y,
                           unsigned int _n)
 {
-    unsigned int i;
-
-    T theta =   _q->theta;
-    T d_theta = _q->d_theta;
-    for (i=0; i<_n; i++) {
-        // multiply _x[i] by [cos(-theta) + _Complex_I*sin(-theta)]
-        _y[i] = _x[i] * liquid_cexpjf(-theta);
-        
-        theta += d_theta;
-    }
-
-    NCO(_set_phase)(_q, theta);
+    NCO(_mix_block)(_q, -_q->theta, -_q->d_theta, _x, _y, _n);
+    _q->theta += (uint64_t)_n * _q->d_theta;
 }
 
 //
 // internal methods
 //
 
-// constrain frequency of NCO object to be in (-pi,pi)
-void NCO(_constrain_frequency)(NCO() _q)
+// convert phase [radians] to fixed-point phase (2^64 = 2*pi)
+uint64_t NCO(_fixed_from_phase)(T _phi)
 {
-    if (_q->d_theta > M_PI)
-        _q->d_theta -= 2*M_PI;
-    else if (_q->d_theta < -M_PI)
-        _q->d_theta += 2*M_PI;
+    // convert to cycles in [-0.5,0.5) in double precision so that
+    // small negative values retain their resolution
+    double c = (double)_phi / (2.0*M_PI);
+    c -= floor(c + 0.5);
+    if (c >= 0.5) c -= 1.0;
+    return (uint64_t)(int64_t)(c * 18446744073709551616.0);
 }
 
-// constrain phase of NCO object to be in (-pi,pi)
-void NCO(_constrain_phase)(NCO() _q)
+// convert fixed-point phase to radians in [-pi,pi)
+T NCO(_phase_from_fixed)(uint64_t _theta)
 {
-    if (_q->theta > M_PI)
-        _q->theta -= 2*M_PI;
-    else if (_q->theta < -M_PI)
-        _q->theta += 2*M_PI;
+    return (T)((double)(int64_t)_theta * (2.0*M_PI / 18446744073709551616.0));
 }
 
-// compute sin, cos of internal phase of nco
+// compute sin, cos of internal phase of nco from sine table,
+// interpolating linearly between entries
 void NCO(_compute_sincos_nco)(NCO() _q)
 {
-    // assume phase is constrained to be in (-pi,pi)
-
-    // compute index
-    // NOTE : 40.743665 ~ 256 / (2*pi)
-    // NOTE : add 512 to ensure positive value, add 0.5 for rounding precision
-    // TODO : move away from floating-point specific code
-    _q->index = ((unsigned int)((_q->theta)*40.743665f + 512.0f + 0.5f))&0xff;
-    assert(_q->index < 256);
-    
-    _q->sine = _q->sintab[_q->index];
-    _q->cosine = _q->sintab[(_q->index+64)&0xff];
+    // table index (upper bits) and fractional part (next 32 bits)
+    unsigned int index = (unsigned int)(_q->theta >> (64-NCO_SINTAB_BITS));
+    T mu = (T)((uint32_t)(_q->theta >> (32-NCO_SINTAB_BITS))) * (1.0f/4294967296.0f);
+    unsigned int qindex = (index + NCO_SINTAB_LEN/4) & (NCO_SINTAB_LEN-1);
+    assert(index < NCO_SINTAB_LEN);
+
+    _q->sine   = _q->sintab[index]  + mu*(_q->sintab[index+1]  - _q->sintab[index]);
+    _q->cosine = _q->sintab[qindex] + mu*(_q->sintab[qindex+1] - _q->sintab[qindex]);
 }
 
 // compute sin, cos of internal phase of vco
 void NCO(_compute_sincos_vco)(NCO() _q)
 {
-    _q->sine   = SIN(_q->theta);
-    _q->cosine = COS(_q->theta);
+    T theta = NCO(_phase_from_fixed)(_q->theta);
+    _q->sine   = SIN(theta);
+    _q->cosine = COS(theta);
 }
 
+// mix block of samples with complex exponential of starting phase
+// _theta and frequency _d_theta (fixed-point)
+//
+// Eight phasors exp{j(theta + l*d_theta)}, l in [0,8), are computed
+// exactly at the start of every NCO_MIX_BLOCK_LEN samples and
+// advanced by complex multiplication with exp{j 8 d_theta}, so
+// round-off never accumulates over more than a short run of samples.
+void NCO(_mix_block)(NCO()        _q,
+                     uint64_t     _theta,
+                     uint64_t     _d_theta,
+                     TC *         _x,
+                     TC *         _y,
+                     unsigned int _n)
+{
+    TC p[8];    // lane phasors
+    TC r;       // phasor rotation over 8 samples
+    T  phi = NCO(_phase_from_fixed)(8*_d_theta);
+    r = COS(phi) + _Complex_I*SIN(phi);
+
+    unsigned int i;
+    unsigned int l;
+    while (_n > 0) {
+        unsigned int k = _n < NCO_MIX_BLOCK_LEN ? _n : NCO_MIX_BLOCK_LEN;
+
+        // re-compute phasors from phase accumulator
+        for (l=0; l<8; l++) {
+            phi = NCO(_phase_from_fixed)(_theta + l*_d_theta);
+            p[l] = COS(phi) + _Complex_I*SIN(phi);
+        }
+
+        // run kernel over multiple of 8 samples
+        i = 0;
+#if LIQUID_CPU_X86
+        if (_q->simd >= LIQUID_SIMD_AVX2)
+            i = nco_mix_block_avx2(p, r, _x, _y, k);
+        else if (_q->simd == LIQUID_SIMD_SSE)
+            i = nco_mix_block_sse(p, r, _x, _y, k);
+#endif
+        for ( ; i+8 <= k; i+=8) {
+            for (l=0; l<8; l++) {
+                _y[i+l] = _x[i+l] * p[l];
+                p[l] *= r;
+            }
+        }
+
+        // remaining samples use current phasors
+        for (l=0; i<k; i++, l++)
+            _y[i] = _x[i] * p[l];
+
+        _theta += (uint64_t)k * _d_theta;
+        _x += k;
+        _y += k;
+        _n -= k;
+    }
+}
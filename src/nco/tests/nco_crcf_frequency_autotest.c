@@ -98,3 +98,35 @@ void autotest_vco_crcf_frequency()
     nco_crcf_frequency_test(LIQUID_VCO, 0.0f, 0.377964473009227, nco_sincos_fsqrt1_7, 256, tol); // 1/sqrt(7)
 }
 
+
+// frequency is reported as set/adjusted (not wrapped to [-pi,pi))
+void autotest_nco_crcf_get_frequency()
+{
+    nco_crcf nco = nco_crcf_create(LIQUID_NCO);
+
+    nco_crcf_set_frequency(nco, 4.0f);
+    CONTEND_DELTA( nco_crcf_get_frequency(nco), 4.0f, 1e-6f );
+
+    nco_crcf_adjust_frequency(nco, 3.0f);
+    CONTEND_DELTA( nco_crcf_get_frequency(nco), 7.0f, 1e-6f );
+
+    nco_crcf_set_frequency(nco, -3.5f);
+    CONTEND_DELTA( nco_crcf_get_frequency(nco), -3.5f, 1e-6f );
+
+    nco_crcf_reset(nco);
+    CONTEND_EQUALITY( nco_crcf_get_frequency(nco), 0.0f );
+
+    // internal phase step is equivalent modulo 2*pi
+    nco_crcf nco_ref = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_frequency(nco,     0.3f + 2*M_PI);
+    nco_crcf_set_frequency(nco_ref, 0.3f);
+    unsigned int i;
+    for (i=0; i<64; i++) {
+        nco_crcf_step(nco);
+        nco_crcf_step(nco_ref);
+    }
+    CONTEND_DELTA( nco_crcf_get_phase(nco), nco_crcf_get_phase(nco_ref), 1e-5f );
+
+    nco_crcf_destroy(nco);
+    nco_crcf_destroy(nco_ref);
+}
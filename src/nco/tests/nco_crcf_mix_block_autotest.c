@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <complex.h>
+#include <math.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+// autotest helper function: mix block up/down and compare against
+// complex exponential computed in double precision
+//  _type       :   NCO type (e.g. LIQUID_NCO)
+//  _phase      :   initial phase
+//  _frequency  :   frequency
+//  _mask       :   cpu feature mask (SIMD kernels)
+void nco_crcf_mix_block_test(int          _type,
+                             float        _phase,
+                             float        _frequency,
+                             unsigned int _mask)
+{
+    unsigned int n = 1000;      // samples per block (not a multiple of 8)
+    float tol = 2e-5f;          // error tolerance
+    unsigned int i;
+
+    liquid_cpu_set_mask(_mask);
+    nco_crcf q = nco_crcf_create(_type);
+    nco_crcf_set_phase(q, _phase);
+    nco_crcf_set_frequency(q, _frequency);
+
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = cexpf(_Complex_I*0.1f*i) * (1.0f + 0.5f*cosf(0.03f*i));
+
+    // first block up, second block down
+    nco_crcf_mix_block_up(q, x, y, n);
+    for (i=0; i<n; i++) {
+        double theta = (double)_phase + (double)_frequency*i;
+        float complex v = x[i] * (cos(theta) + _Complex_I*sin(theta));
+        CONTEND_DELTA( crealf(y[i]), crealf(v), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(v), tol );
+    }
+    nco_crcf_mix_block_down(q, x, y, n);
+    for (i=0; i<n; i++) {
+        double theta = (double)_phase + (double)_frequency*(i+n);
+        float complex v = x[i] * (cos(theta) - _Complex_I*sin(theta));
+        CONTEND_DELTA( crealf(y[i]), crealf(v), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(v), tol );
+    }
+
+    // phase must have advanced by exactly 2n steps
+    double theta = fmod((double)_phase + (double)_frequency*2*n, 2*M_PI);
+    float dphi = nco_crcf_get_phase(q) - (float)theta;
+    if (dphi >  M_PI) dphi -= 2*M_PI;
+    if (dphi < -M_PI) dphi += 2*M_PI;
+    CONTEND_DELTA( dphi, 0.0f, 1e-4f );
+
+    nco_crcf_destroy(q);
+    liquid_cpu_set_mask(~0U);
+}
+
+void autotest_nco_crcf_mix_block()
+{
+    unsigned int masks[3] = {~0U, ~(LIQUID_CPU_AVX512F|LIQUID_CPU_AVX2), 0};
+    unsigned int i;
+    for (i=0; i<3; i++) {
+        nco_crcf_mix_block_test(LIQUID_NCO,  0.3f,  0.1234f,   masks[i]);
+        nco_crcf_mix_block_test(LIQUID_VCO, -2.9f, -2.7000f,   masks[i]);
+        nco_crcf_mix_block_test(LIQUID_VCO,  1.0f,  1.3e-4f,   masks[i]);
+    }
+}
+
+// sine table interpolation must be accurate for arbitrary phase
+void autotest_nco_crcf_sincos_accuracy()
+{
+    nco_crcf q = nco_crcf_create(LIQUID_NCO);
+    nco_crcf_set_frequency(q, 0.01234567f);
+    unsigned int i;
+    float s, c;
+    for (i=0; i<1000; i++) {
+        float theta = nco_crcf_get_phase(q);
+        nco_crcf_sincos(q, &s, &c);
+        CONTEND_DELTA( s, sinf(theta), 1e-5f );
+        CONTEND_DELTA( c, cosf(theta), 1e-5f );
+        nco_crcf_step(q);
+    }
+    nco_crcf_destroy(q);
+}
+
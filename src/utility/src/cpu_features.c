@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Run-time processor feature detection
+//
+// SIMD kernels (e.g. dotprod, sumsq) are compiled for every x86 instruction
+// set extension the compiler supports and chosen at run time from the
+// features reported here, so a single library binary runs at full speed
+// on any host.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#if LIQUID_CPU_X86
+#  include <cpuid.h>
+#endif
+
+// detected features (computed once), and user-imposed mask
+static int          liquid_cpu_detected = 0;
+static unsigned int liquid_cpu_features = 0;
+static unsigned int liquid_cpu_mask     = ~0U;
+
+#if LIQUID_CPU_X86
+// read extended control register (OS-enabled register state); encoded
+// directly so that no -mxsave compiler option is needed
+static unsigned long long liquid_cpu_xgetbv(unsigned int _index)
+{
+    unsigned int eax, edx;
+    __asm__ __volatile__(".byte 0x0f, 0x01, 0xd0"
+                         : "=a"(eax), "=d"(edx) : "c"(_index));
+    return ((unsigned long long)edx << 32) | eax;
+}
+#endif
+
+// query processor with cpuid instruction
+static unsigned int liquid_cpu_detect(void)
+{
+    unsigned int features = 0;
+#if LIQUID_CPU_X86
+    unsigned int eax, ebx, ecx, edx;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+        return 0;
+
+    if (edx & (1<<26)) features |= LIQUID_CPU_SSE2;
+    if (ecx & (1<< 0)) features |= LIQUID_CPU_SSE3;
+    if (ecx & (1<< 9)) features |= LIQUID_CPU_SSSE3;
+    if (ecx & (1<<19)) features |= LIQUID_CPU_SSE41;
+    if (ecx & (1<<20)) features |= LIQUID_CPU_SSE42;
+    if (ecx & (1<< 1)) features |= LIQUID_CPU_PCLMUL;
+
+    // AVX state (xmm/ymm registers) must be enabled by the operating system
+    int osxsave = (ecx & (1<<27)) ? 1 : 0;
+    unsigned long long xcr0 = osxsave ? liquid_cpu_xgetbv(0) : 0;
+    int os_avx    = (xcr0 & 0x06) == 0x06;  // xmm, ymm
+    int os_avx512 = (xcr0 & 0xe6) == 0xe6;  // xmm, ymm, opmask, zmm
+
+    if (os_avx && (ecx & (1<<28))) features |= LIQUID_CPU_AVX;
+    if (os_avx && (ecx & (1<<12))) features |= LIQUID_CPU_FMA;
+
+    // extended features
+    unsigned int max_leaf = __get_cpuid_max(0, NULL);
+    if (max_leaf >= 7) {
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if (os_avx    && (ebx & (1<< 5))) features |= LIQUID_CPU_AVX2;
+        if (os_avx512 && (ebx & (1<<16))) features |= LIQUID_CPU_AVX512F;
+        if (os_avx512 && (ebx & (1<<30))) features |= LIQUID_CPU_AVX512BW;
+    }
+#endif
+    return features;
+}
+
+// get processor features supported by host, masked by liquid_cpu_set_mask()
+unsigned int liquid_cpu_get_features(void)
+{
+    // detection is idempotent; a race between threads on first
+    // use simply stores the same value twice
+    if (!liquid_cpu_detected) {
+        liquid_cpu_features = liquid_cpu_detect();
+        liquid_cpu_detected = 1;
+    }
+    return liquid_cpu_features & liquid_cpu_mask;
+}
+
+// restrict run-time feature detection to _mask
+void liquid_cpu_set_mask(unsigned int _mask)
+{
+    liquid_cpu_mask = _mask;
+}
+
+// get widest usable floating-point SIMD extension
+liquid_simd_level liquid_cpu_get_simd_level(void)
+{
+    unsigned int f = liquid_cpu_get_features();
+
+    if ( (f & LIQUID_CPU_AVX512F) && (f & LIQUID_CPU_AVX2) && (f & LIQUID_CPU_FMA) )
+        return LIQUID_SIMD_AVX512;
+    if ( (f & LIQUID_CPU_AVX2) && (f & LIQUID_CPU_FMA) )
+        return LIQUID_SIMD_AVX2;
+    if ( f & LIQUID_CPU_SSE2 )
+        return LIQUID_SIMD_SSE;
+
+    return LIQUID_SIMD_NONE;
+}
+
+// print processor features to stdout
+void liquid_cpu_print_features(void)
+{
+    unsigned int f = liquid_cpu_get_features();
+    printf("processor features:");
+    if (f & LIQUID_CPU_SSE2)     printf(" sse2");
+    if (f & LIQUID_CPU_SSE3)     printf(" sse3");
+    if (f & LIQUID_CPU_SSSE3)    printf(" ssse3");
+    if (f & LIQUID_CPU_SSE41)    printf(" sse4.1");
+    if (f & LIQUID_CPU_SSE42)    printf(" sse4.2");
+    if (f & LIQUID_CPU_PCLMUL)   printf(" pclmul");
+    if (f & LIQUID_CPU_AVX)      printf(" avx");
+    if (f & LIQUID_CPU_FMA)      printf(" fma");
+    if (f & LIQUID_CPU_AVX2)     printf(" avx2");
+    if (f & LIQUID_CPU_AVX512F)  printf(" avx512f");
+    if (f & LIQUID_CPU_AVX512BW) printf(" avx512bw");
+    printf("\n");
+}
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Single-producer, single-consumer queue
+//
+// A ring of fixed-size slots shared between one producer thread and
+// one consumer thread.  Slots are filled and drained in place: the
+// producer obtains the next free slot with write_begin(), fills it and
+// hands it over with write_end(); the consumer obtains the oldest slot
+// with read_begin() and returns it with read_end().  The hand-over
+// itself is lock-free (one counter per side); a thread which finds the
+// queue full (producer) or empty (consumer) spins briefly and then
+// sleeps until the other side makes progress.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#   include <pthread.h>
+#   include <sched.h>
+#   define LIQUID_SPSCQUEUE_PTHREAD 1
+#else
+#   define LIQUID_SPSCQUEUE_PTHREAD 0
+#endif
+
+// number of polls before sleeping
+#define LIQUID_SPSCQUEUE_SPIN (256)
+
+struct liquid_spscqueue_s {
+    unsigned int    num_slots;      // number of slots (power of two)
+    unsigned int    slot_size;      // slot size [bytes]
+    unsigned char * mem;            // slot memory
+
+    // free-running counters, on separate cache lines
+    unsigned int    head;           // slots read (consumer)
+    unsigned char   pad0[60];
+    unsigned int    tail;           // slots written (producer)
+    unsigned char   pad1[60];
+
+#if LIQUID_SPSCQUEUE_PTHREAD
+    unsigned int    num_waiting;    // threads sleeping on cond
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond;
+#endif
+};
+
+// can the producer write another slot?
+static int liquid_spscqueue_writable(liquid_spscqueue _q)
+{
+    return _q->tail - __atomic_load_n(&_q->head, __ATOMIC_SEQ_CST) < _q->num_slots;
+}
+
+// can the consumer read another slot?
+static int liquid_spscqueue_readable(liquid_spscqueue _q)
+{
+    return __atomic_load_n(&_q->tail, __ATOMIC_SEQ_CST) != _q->head;
+}
+
+// wait until _ready(_q) holds, first polling and then sleeping
+static void liquid_spscqueue_wait(liquid_spscqueue _q,
+                                  int (*_ready)(liquid_spscqueue))
+{
+    unsigned int i;
+    for (i=0; i<LIQUID_SPSCQUEUE_SPIN; i++) {
+        if (_ready(_q))
+            return;
+#if LIQUID_SPSCQUEUE_PTHREAD
+        sched_yield();
+#endif
+    }
+
+#if LIQUID_SPSCQUEUE_PTHREAD
+    // announce sleeper before re-checking so that a notification
+    // after the check cannot be missed
+    pthread_mutex_lock(&_q->mutex);
+    __atomic_add_fetch(&_q->num_waiting, 1, __ATOMIC_SEQ_CST);
+    while (!_ready(_q))
+        pthread_cond_wait(&_q->cond, &_q->mutex);
+    __atomic_sub_fetch(&_q->num_waiting, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&_q->mutex);
+#else
+    while (!_ready(_q)) ;
+#endif
+}
+
+// wake other side if sleeping
+static void liquid_spscqueue_notify(liquid_spscqueue _q)
+{
+#if LIQUID_SPSCQUEUE_PTHREAD
+    if (__atomic_load_n(&_q->num_waiting, __ATOMIC_SEQ_CST) > 0) {
+        pthread_mutex_lock(&_q->mutex);
+        pthread_cond_broadcast(&_q->cond);
+        pthread_mutex_unlock(&_q->mutex);
+    }
+#endif
+}
+
+// create queue of at least _num_slots slots of _slot_size bytes each
+liquid_spscqueue liquid_spscqueue_create(unsigned int _num_slots,
+                                         unsigned int _slot_size)
+{
+    if (_num_slots == 0) {
+        fprintf(stderr,"error: liquid_spscqueue_create(), number of slots must be greater than zero\n");
+        exit(1);
+    } else if (_slot_size == 0) {
+        fprintf(stderr,"error: liquid_spscqueue_create(), slot size must be greater than zero\n");
+        exit(1);
+    }
+
+    liquid_spscqueue q = (liquid_spscqueue) malloc(sizeof(struct liquid_spscqueue_s));
+    q->num_slots = 1;
+    while (q->num_slots < _num_slots)
+        q->num_slots <<= 1;
+    q->slot_size = (_slot_size + 15) & ~15U;
+    q->mem  = (unsigned char*) malloc(q->num_slots*q->slot_size);
+    q->head = 0;
+    q->tail = 0;
+#if LIQUID_SPSCQUEUE_PTHREAD
+    q->num_waiting = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->cond, NULL);
+#endif
+    return q;
+}
+
+// destroy queue (neither side may be using it)
+void liquid_spscqueue_destroy(liquid_spscqueue _q)
+{
+#if LIQUID_SPSCQUEUE_PTHREAD
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy(&_q->cond);
+#endif
+    free(_q->mem);
+    free(_q);
+}
+
+// producer: wait for free slot and return pointer to it
+void * liquid_spscqueue_write_begin(liquid_spscqueue _q)
+{
+    if (!liquid_spscqueue_writable(_q))
+        liquid_spscqueue_wait(_q, liquid_spscqueue_writable);
+    return _q->mem + (_q->tail & (_q->num_slots-1))*_q->slot_size;
+}
+
+// producer: hand slot obtained with write_begin() to consumer
+void liquid_spscqueue_write_end(liquid_spscqueue _q)
+{
+    __atomic_store_n(&_q->tail, _q->tail+1, __ATOMIC_SEQ_CST);
+    liquid_spscqueue_notify(_q);
+}
+
+// consumer: wait for oldest slot and return pointer to it
+void * liquid_spscqueue_read_begin(liquid_spscqueue _q)
+{
+    if (!liquid_spscqueue_readable(_q))
+        liquid_spscqueue_wait(_q, liquid_spscqueue_readable);
+    return _q->mem + (_q->head & (_q->num_slots-1))*_q->slot_size;
+}
+
+// consumer: return slot obtained with read_begin() to producer
+void liquid_spscqueue_read_end(liquid_spscqueue _q)
+{
+    __atomic_store_n(&_q->head, _q->head+1, __ATOMIC_SEQ_CST);
+    liquid_spscqueue_notify(_q);
+}
+
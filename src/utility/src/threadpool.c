@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2013 Joseph Gaeddert
+ *
+ * This file is part of liquid.
+ *
+ * liquid is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * liquid is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with liquid.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//
+// Fork-join thread pool
+//
+// A fixed set of worker threads executes the tasks of one parallel
+// loop at a time; the calling thread participates as worker 0 and
+// returns once every task is complete.  Tasks are claimed in order
+// from a shared counter, so the assignment of tasks to workers varies
+// between runs and each task must only write its own outputs.
+// Objects use the worker index to select private scratch memory.
+// Without POSIX threads all tasks run on the calling thread.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+#   include <pthread.h>
+#   define LIQUID_THREADPOOL_PTHREAD 1
+#else
+#   define LIQUID_THREADPOOL_PTHREAD 0
+#endif
+
+struct liquid_threadpool_s {
+    unsigned int num_threads;       // number of workers (including caller)
+
+#if LIQUID_THREADPOOL_PTHREAD
+    pthread_t *     threads;        // worker threads [size: num_threads-1]
+    pthread_mutex_t mutex;          // protects all fields below
+    pthread_cond_t  cond_start;     // signals new loop (or shutdown)
+    pthread_cond_t  cond_done;      // signals loop completion
+    unsigned int    generation;     // loop counter
+    int             shutdown;       // workers exit when set
+
+    // current loop
+    liquid_threadpool_task func;    // task function
+    void *          arg;            // user argument
+    unsigned int    num_tasks;      // total number of tasks
+    unsigned int    next_task;      // next unclaimed task
+    unsigned int    num_active;     // workers still running this loop
+#endif
+};
+
+#if LIQUID_THREADPOOL_PTHREAD
+// claim and execute tasks of current loop until none remain
+static void liquid_threadpool_run_tasks(liquid_threadpool _q,
+                                        unsigned int      _worker)
+{
+    while (1) {
+        pthread_mutex_lock(&_q->mutex);
+        unsigned int task = _q->next_task;
+        if (task < _q->num_tasks)
+            _q->next_task++;
+        pthread_mutex_unlock(&_q->mutex);
+
+        if (task >= _q->num_tasks)
+            break;
+        _q->func(_q->arg, task, _worker);
+    }
+}
+
+// worker thread entry point
+struct liquid_threadpool_worker_s {
+    liquid_threadpool q;
+    unsigned int      worker;
+};
+
+static void * liquid_threadpool_worker(void * _arg)
+{
+    struct liquid_threadpool_worker_s * w = (struct liquid_threadpool_worker_s*)_arg;
+    liquid_threadpool q      = w->q;
+    unsigned int      worker = w->worker;
+    free(w);
+
+    unsigned int generation = 0;
+    while (1) {
+        // wait for next loop
+        pthread_mutex_lock(&q->mutex);
+        while (!q->shutdown && q->generation == generation)
+            pthread_cond_wait(&q->cond_start, &q->mutex);
+        if (q->shutdown) {
+            pthread_mutex_unlock(&q->mutex);
+            break;
+        }
+        generation = q->generation;
+        pthread_mutex_unlock(&q->mutex);
+
+        liquid_threadpool_run_tasks(q, worker);
+
+        // signal completion
+        pthread_mutex_lock(&q->mutex);
+        q->num_active--;
+        if (q->num_active == 0)
+            pthread_cond_signal(&q->cond_done);
+        pthread_mutex_unlock(&q->mutex);
+    }
+    return NULL;
+}
+#endif
+
+// create thread pool with _num_threads workers (including the
+// calling thread)
+liquid_threadpool liquid_threadpool_create(unsigned int _num_threads)
+{
+    if (_num_threads == 0) {
+        fprintf(stderr,"error: liquid_threadpool_create(), number of threads must be greater than zero\n");
+        exit(1);
+    }
+
+    liquid_threadpool q = (liquid_threadpool) malloc(sizeof(struct liquid_threadpool_s));
+#if LIQUID_THREADPOOL_PTHREAD
+    q->num_threads = _num_threads;
+    q->generation  = 0;
+    q->shutdown    = 0;
+    q->func        = NULL;
+    q->arg         = NULL;
+    q->num_tasks   = 0;
+    q->next_task   = 0;
+    q->num_active  = 0;
+    pthread_mutex_init(&q->mutex, NULL);
+    pthread_cond_init(&q->cond_start, NULL);
+    pthread_cond_init(&q->cond_done, NULL);
+
+    q->threads = (pthread_t*) malloc((q->num_threads-1)*sizeof(pthread_t));
+    unsigned int i;
+    for (i=1; i<q->num_threads; i++) {
+        struct liquid_threadpool_worker_s * w = (struct liquid_threadpool_worker_s*)
+            malloc(sizeof(struct liquid_threadpool_worker_s));
+        w->q      = q;
+        w->worker = i;
+        if (pthread_create(&q->threads[i-1], NULL, liquid_threadpool_worker, w) != 0) {
+            fprintf(stderr,"error: liquid_threadpool_create(), could not create thread\n");
+            exit(1);
+        }
+    }
+#else
+    // no thread support; run everything on calling thread
+    q->num_threads = 1;
+#endif
+    return q;
+}
+
+// destroy thread pool, joining all worker threads
+void liquid_threadpool_destroy(liquid_threadpool _q)
+{
+#if LIQUID_THREADPOOL_PTHREAD
+    pthread_mutex_lock(&_q->mutex);
+    _q->shutdown = 1;
+    pthread_cond_broadcast(&_q->cond_start);
+    pthread_mutex_unlock(&_q->mutex);
+
+    unsigned int i;
+    for (i=1; i<_q->num_threads; i++)
+        pthread_join(_q->threads[i-1], NULL);
+    free(_q->threads);
+
+    pthread_mutex_destroy(&_q->mutex);
+    pthread_cond_destroy(&_q->cond_start);
+    pthread_cond_destroy(&_q->cond_done);
+#endif
+    free(_q);
+}
+
+// get number of workers (including the calling thread)
+unsigned int liquid_threadpool_get_num_threads(liquid_threadpool _q)
+{
+    return _q->num_threads;
+}
+
+// execute _func(_arg, task, worker) for every task in [0,_num_tasks)
+// and wait for completion
+void liquid_threadpool_execute(liquid_threadpool      _q,
+                               liquid_threadpool_task _func,
+                               void *                 _arg,
+                               unsigned int           _num_tasks)
+{
+    unsigned int i;
+#if LIQUID_THREADPOOL_PTHREAD
+    if (_q->num_threads > 1 && _num_tasks > 1) {
+        // start loop on all workers
+        pthread_mutex_lock(&_q->mutex);
+        _q->func       = _func;
+        _q->arg        = _arg;
+        _q->num_tasks  = _num_tasks;
+        _q->next_task  = 0;
+        _q->num_active = _q->num_threads - 1;
+        _q->generation++;
+        pthread_cond_broadcast(&_q->cond_start);
+        pthread_mutex_unlock(&_q->mutex);
+
+        // participate as worker 0
+        liquid_threadpool_run_tasks(_q, 0);
+
+        // wait for remaining workers
+        pthread_mutex_lock(&_q->mutex);
+        while (_q->num_active > 0)
+            pthread_cond_wait(&_q->cond_done, &_q->mutex);
+        pthread_mutex_unlock(&_q->mutex);
+        return;
+    }
+#endif
+    for (i=0; i<_num_tasks; i++)
+        _func(_arg, i, 0);
+}
+